@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Streams a few hundred WAV files at once through BufferingAudioReaders, reading
+    from all of them in blocks paced like an audio callback, with no read timeout.
+
+    It runs once with every reader refilling its own blocks on a shared thread, and
+    once with the readers sharing a BufferingAudioReaderScheduler and a memory budget
+    that's smaller than the readers would use on their own. The results are written
+    to the Logger: the proportion of reads that found all their samples buffered, the
+    number of reads that returned silence, and the memory used by the buffers.
+
+    The files are freshly written, so they're likely to be in the OS's file cache. Point
+    the readers at real multitrack stems to measure a cold disk.
+*/
+class BufferingReaderBenchmark
+{
+public:
+    static void run()
+    {
+        Logger::writeToLog ("Buffering reader benchmark");
+        Logger::writeToLog (String (numStreams) + " streams, " + String (numFiles) + " files, "
+                            + String (blockSize) + " sample blocks at " + String (sampleRate) + " Hz");
+        Logger::writeToLog ("");
+
+        OwnedArray<TemporaryFile> files;
+
+        for (int i = 0; i < numFiles; ++i)
+        {
+            files.add (new TemporaryFile (".wav"));
+
+            if (! writeNoise (files.getLast()->getFile()))
+            {
+                Logger::writeToLog ("Couldn't write the test files");
+                return;
+            }
+        }
+
+        Logger::writeToLog ("scheduling       hit rate   silent reads   buffer memory");
+
+        for (const auto shared : { false, true })
+        {
+            const auto result = measure (files, shared);
+
+            Logger::writeToLog (String (shared ? "shared" : "independent").paddedRight (' ', 17)
+                                + (String (result.hitRate * 100.0, 1) + "%").paddedRight (' ', 11)
+                                + String (result.numSilentReads).paddedRight (' ', 15)
+                                + String ((double) result.peakBytesBuffered / (1024.0 * 1024.0), 1) + " MB");
+        }
+
+        Logger::writeToLog ("");
+    }
+
+private:
+    static constexpr int numStreams = 300, numFiles = 16, numChannels = 2, blockSize = 512;
+    static constexpr int samplesToBuffer = 88200;
+    static constexpr size_t sharedMemoryBudget = (size_t) 160 * 1024 * 1024;
+    static constexpr double sampleRate = 44100.0, fileLengthSeconds = 30.0, runLengthSeconds = 10.0;
+
+    struct Result
+    {
+        double hitRate = 0.0;
+        int64 numSilentReads = 0;
+        size_t peakBytesBuffered = 0;
+    };
+
+    //==============================================================================
+    static bool writeNoise (const File& file)
+    {
+        std::unique_ptr<AudioFormatWriter> writer (WavAudioFormat().createWriterFor (file.createOutputStream().release(),
+                                                                                      sampleRate, numChannels, 24, {}, 0));
+
+        if (writer == nullptr)
+            return false;
+
+        AudioBuffer<float> noise (numChannels, 65536);
+        Random random;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < noise.getNumSamples(); ++i)
+                noise.setSample (channel, i, random.nextFloat() * 0.5f - 0.25f);
+
+        for (auto remaining = (int64) (fileLengthSeconds * sampleRate); remaining > 0; remaining -= noise.getNumSamples())
+            if (! writer->writeFromAudioSampleBuffer (noise, 0, (int) jmin (remaining, (int64) noise.getNumSamples())))
+                return false;
+
+        return true;
+    }
+
+    static Result measure (const OwnedArray<TemporaryFile>& files, bool shared)
+    {
+        TimeSliceThread thread ("Buffering reader benchmark");
+        thread.startThread (Thread::Priority::high);
+
+        BufferingAudioReaderScheduler scheduler (thread, BufferingAudioReaderScheduler::Options{}.withMaxMemoryBytes (sharedMemoryBudget));
+        Result result;
+
+        {
+            std::vector<std::unique_ptr<BufferingAudioReader>> readers;
+            std::vector<int64> positions;
+            Random random (0x1234);
+
+            for (int i = 0; i < numStreams; ++i)
+            {
+                auto* source = WavAudioFormat().createReaderFor (files[i % numFiles]->getFile().createInputStream().release(), true);
+
+                if (shared)
+                    readers.push_back (std::make_unique<BufferingAudioReader> (source, scheduler, samplesToBuffer));
+                else
+                    readers.push_back (std::make_unique<BufferingAudioReader> (source, thread, samplesToBuffer));
+
+                // Stagger the streams, so that they don't all need the same blocks of the same files
+                positions.push_back (random.nextInt ((int) (fileLengthSeconds * sampleRate / 2)));
+            }
+
+            AudioBuffer<float> output (numChannels, blockSize);
+
+            const auto numBlocks = (int) (runLengthSeconds * sampleRate / blockSize);
+            const auto blockLengthMs = 1000.0 * blockSize / sampleRate;
+            int64 numReads = 0;
+
+            // Move the readers to their start positions, and give them a moment to fill up
+            for (size_t i = 0; i < readers.size(); ++i)
+                readers[i]->read (&output, 0, blockSize, positions[i], true, true);
+
+            Thread::sleep (2000);
+            scheduler.resetStatistics();
+
+            const auto start = Time::getMillisecondCounterHiRes();
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                for (size_t i = 0; i < readers.size(); ++i)
+                {
+                    if (! readers[i]->read (&output, 0, blockSize, positions[i], true, true))
+                        ++result.numSilentReads;
+
+                    positions[i] += blockSize;
+                    ++numReads;
+                }
+
+                if (shared)
+                    result.peakBytesBuffered = jmax (result.peakBytesBuffered, scheduler.getStatistics().numBytesBuffered);
+
+                const auto deadline = start + (block + 1) * blockLengthMs;
+
+                while (Time::getMillisecondCounterHiRes() < deadline)
+                    Thread::sleep (1);
+            }
+
+            // With no read timeout, any read that had to wait for a block returns silence
+            result.hitRate = 1.0 - (double) result.numSilentReads / (double) numReads;
+
+            if (! shared)
+            {
+                // Each independent reader buffers a fixed number of whole blocks
+                const auto blocksPerReader = 1 + samplesToBuffer / 32768;
+                result.peakBytesBuffered = (size_t) numStreams * (size_t) blocksPerReader * 32768 * numChannels * sizeof (float);
+            }
+        }
+
+        return result;
+    }
+};
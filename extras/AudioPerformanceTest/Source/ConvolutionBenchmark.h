@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Measures how much time dsp::Convolution spends on the audio thread for each block, for
+    long IRs, with uniform and non-uniform partitioning, and with the tail of the IR
+    processed on the audio thread or on a background thread.
+
+    The blocks are processed from a real-time thread and paced in real time, so that a
+    background tail thread has the same amount of time to work as it would with a real
+    audio device. The results are written to the Logger: the mean and maximum time spent
+    in process() per block, and the total CPU time per block used by the whole process,
+    which includes the work done on the background thread.
+*/
+class ConvolutionBenchmark
+{
+public:
+    static void run()
+    {
+        Logger::writeToLog ("Convolution benchmark");
+        Logger::writeToLog (String (blockSize) + " sample blocks, stereo, " + String (sampleRate / 1000.0) + " kHz, "
+                            + String (SystemStats::getNumCpus()) + " cores");
+        Logger::writeToLog ("");
+        Logger::writeToLog ("IR    config                    mean      max        total");
+
+        for (const auto irSeconds : { 1, 5, 20 })
+        {
+            const auto ir = createImpulseResponse (irSeconds);
+
+            for (const auto& config : getConfigs())
+            {
+                const auto result = measure (ir, config.headSize, config.background);
+
+                Logger::writeToLog ((String (irSeconds) + "s").paddedRight (' ', 6)
+                                    + config.name.paddedRight (' ', 26)
+                                    + (String (roundToInt (result.meanUs)) + " us").paddedRight (' ', 10)
+                                    + (String (roundToInt (result.maxUs)) + " us").paddedRight (' ', 11)
+                                    + String (roundToInt (result.totalUs)) + " us");
+            }
+        }
+
+        Logger::writeToLog ("");
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+    static constexpr int numWarmupBlocks = 200;
+    static constexpr int numMeasuredBlocks = 750;
+
+    struct Config
+    {
+        String name;
+        int headSize;
+        bool background;
+    };
+
+    struct Result
+    {
+        double meanUs, maxUs, totalUs;
+    };
+
+    //==============================================================================
+    static std::vector<Config> getConfigs()
+    {
+        return { { "uniform",                0,    false },
+                 { "head 1024",              1024, false },
+                 { "head 1024 + background", 1024, true },
+                 { "head 4096",              4096, false },
+                 { "head 4096 + background", 4096, true } };
+    }
+
+    // Decaying noise, like a reverb tail
+    static AudioBuffer<float> createImpulseResponse (int seconds)
+    {
+        const auto length = roundToInt (seconds * sampleRate);
+        AudioBuffer<float> ir (2, length);
+        Random random (0x1234);
+
+        for (auto channel = 0; channel < ir.getNumChannels(); ++channel)
+            for (auto i = 0; i < length; ++i)
+                ir.setSample (channel, i, (random.nextFloat() * 2.0f - 1.0f) * std::exp (-6.0f * (float) i / (float) length));
+
+        return ir;
+    }
+
+    static Result measure (const AudioBuffer<float>& ir, int headSize, bool background)
+    {
+        struct ProcessThread final : public Thread
+        {
+            explicit ProcessThread (std::function<void()> fn) : Thread ("Convolution benchmark"), function (std::move (fn)) {}
+            void run() override { function(); }
+            std::function<void()> function;
+        };
+
+        auto convolution = headSize > 0 ? std::make_unique<dsp::Convolution> (dsp::Convolution::NonUniform { headSize, background })
+                                         : std::make_unique<dsp::Convolution>();
+
+        // When the IR is loaded before prepare() is called, the engine is built straight away
+        convolution->loadImpulseResponse (AudioBuffer<float> (ir), sampleRate,
+                                          dsp::Convolution::Stereo::yes,
+                                          dsp::Convolution::Trim::no,
+                                          dsp::Convolution::Normalise::no);
+        convolution->prepare ({ sampleRate, (uint32) blockSize, 2 });
+        jassert (convolution->getCurrentIRSize() == ir.getNumSamples());
+
+        Result result {};
+        ProcessThread thread ([&] { result = processBlocks (*convolution); });
+
+        if (! thread.startRealtimeThread (Thread::RealtimeOptions{}.withApproximateAudioProcessingTime (blockSize, sampleRate)
+                                                                    .withPeriodMs (1000.0 * blockSize / sampleRate)))
+            thread.startThread (Thread::Priority::highest);
+
+        thread.waitForThreadToExit (-1);
+        return result;
+    }
+
+    static Result processBlocks (dsp::Convolution& convolution)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        AudioBuffer<float> buffer (2, blockSize);
+        Random random;
+
+        const auto blockPeriod = std::chrono::duration_cast<Clock::duration> (std::chrono::duration<double> (blockSize / sampleRate));
+        auto nextBlock = Clock::now();
+        auto total = 0.0, maximum = 0.0;
+        std::clock_t cpuStart = 0;
+
+        for (auto i = 0; i < numWarmupBlocks + numMeasuredBlocks; ++i)
+        {
+            if (i == numWarmupBlocks)
+                cpuStart = std::clock();
+
+            for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+                for (auto sample = 0; sample < blockSize; ++sample)
+                    buffer.setSample (channel, sample, random.nextFloat() * 0.2f - 0.1f);
+
+            dsp::AudioBlock<float> block (buffer);
+            const auto start = Time::getHighResolutionTicks();
+            convolution.process (dsp::ProcessContextReplacing<float> (block));
+            const auto elapsed = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+
+            if (i >= numWarmupBlocks)
+            {
+                total += elapsed;
+                maximum = jmax (maximum, elapsed);
+            }
+
+            nextBlock += blockPeriod;
+            std::this_thread::sleep_until (nextBlock);
+        }
+
+        const auto cpuSeconds = (double) (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+        return { 1.0e6 * total / numMeasuredBlocks,
+                 1.0e6 * maximum,
+                 1.0e6 * cpuSeconds / numMeasuredBlocks };
+    }
+};
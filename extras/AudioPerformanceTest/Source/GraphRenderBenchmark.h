@@ -0,0 +1,232 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Measures how long an AudioProcessorGraph takes to render a block, for a range of node counts
+    and render thread counts.
+
+    Each graph is made of several parallel branches of processors that do a fixed amount of work
+    per block, all summed into the graph's output. The results are written to the Logger.
+*/
+class GraphRenderBenchmark
+{
+public:
+    static void run (double sampleRate, int blockSize)
+    {
+        const auto maxThreads = jmax (0, SystemStats::getNumCpus() - 1);
+
+        Logger::writeToLog ("AudioProcessorGraph render benchmark");
+        Logger::writeToLog ("block size = " + String (blockSize) + " samples, "
+                            + String (SystemStats::getNumCpus()) + " cores");
+        Logger::writeToLog ("");
+
+        String header ("nodes    ");
+
+        for (const auto numThreads : getThreadCounts (maxThreads))
+            header << (String (numThreads) + " threads").paddedRight (' ', 14);
+
+        Logger::writeToLog (header);
+
+        for (const auto numNodes : { 4, 8, 16, 32, 60, 120 })
+        {
+            String line (String (numNodes).paddedRight (' ', 9));
+
+            for (const auto numThreads : getThreadCounts (maxThreads))
+                line << (String (measureBlockTimeMs (numNodes, numThreads, sampleRate, blockSize), 3) + " ms").paddedRight (' ', 14);
+
+            Logger::writeToLog (line);
+        }
+
+        Logger::writeToLog ("");
+    }
+
+private:
+    //==============================================================================
+    class CrunchProcessor final : public AudioProcessor
+    {
+    public:
+        CrunchProcessor()
+            : AudioProcessor (BusesProperties().withInput  ("in",  AudioChannelSet::stereo())
+                                               .withOutput ("out", AudioChannelSet::stereo())) {}
+
+        const String getName() const override                         { return "Crunch"; }
+        double getTailLengthSeconds() const override                  { return 0.0; }
+        bool acceptsMidi() const override                             { return false; }
+        bool producesMidi() const override                            { return false; }
+        AudioProcessorEditor* createEditor() override                 { return nullptr; }
+        bool hasEditor() const override                               { return false; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return 0; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (MemoryBlock&) override              {}
+        void setStateInformation (const void*, int) override          {}
+        void releaseResources() override                              {}
+
+        void prepareToPlay (double, int samplesPerBlock) override
+        {
+            scratch.setSize (1, samplesPerBlock);
+        }
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            const auto numSamples = buffer.getNumSamples();
+            auto* temp = scratch.getWritePointer (0);
+
+            for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+            {
+                auto* data = buffer.getWritePointer (channel);
+
+                for (auto i = 0; i < numLoopsPerBlock; ++i)
+                {
+                    FloatVectorOperations::multiply (temp, data, 0.999f, numSamples);
+                    FloatVectorOperations::addWithMultiply (data, temp, 0.001f, numSamples);
+                }
+            }
+        }
+
+        using AudioProcessor::processBlock;
+
+    private:
+        static constexpr auto numLoopsPerBlock = 200;
+        AudioBuffer<float> scratch;
+    };
+
+    //==============================================================================
+    static std::vector<int> getThreadCounts (int maxThreads)
+    {
+        std::vector<int> result { 0 };
+
+        for (auto numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+            result.push_back (numThreads);
+
+        if (result.back() != maxThreads)
+            result.push_back (maxThreads);
+
+        return result;
+    }
+
+    /*  The graph's worker threads are real-time threads, so the blocks are rendered from a
+        real-time thread too, in the same way that they would be in an audio callback.
+    */
+    static double measureBlockTimeMs (int numNodes, int numThreads, double sampleRate, int blockSize)
+    {
+        struct RenderThread final : public Thread
+        {
+            explicit RenderThread (std::function<void()> fn) : Thread ("Graph benchmark"), function (std::move (fn)) {}
+            void run() override { function(); }
+            std::function<void()> function;
+        };
+
+        double result = 0.0;
+        RenderThread thread ([&] { result = renderGraph (numNodes, numThreads, sampleRate, blockSize); });
+
+        if (! thread.startRealtimeThread (Thread::RealtimeOptions{}.withApproximateAudioProcessingTime (blockSize, sampleRate)))
+            thread.startThread (Thread::Priority::highest);
+
+        thread.waitForThreadToExit (-1);
+        return result;
+    }
+
+    static double renderGraph (int numNodes, int numThreads, double sampleRate, int blockSize)
+    {
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+        constexpr auto nodesPerBranch = 4;
+        constexpr auto numWarmupBlocks = 20;
+        constexpr auto numMeasuredBlocks = 200;
+
+        AudioProcessorGraph graph;
+        graph.setPlayConfigDetails (2, 2, sampleRate, blockSize);
+        graph.setNumRenderThreads (numThreads);
+
+        const auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode))->nodeID;
+        const auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode))->nodeID;
+
+        for (auto first = 0; first < numNodes; first += nodesPerBranch)
+        {
+            auto previous = input;
+
+            for (auto i = first; i < jmin (numNodes, first + nodesPerBranch); ++i)
+            {
+                const auto node = graph.addNode (std::make_unique<CrunchProcessor>())->nodeID;
+
+                for (auto channel = 0; channel < 2; ++channel)
+                    graph.addConnection ({ { previous, channel }, { node, channel } });
+
+                previous = node;
+            }
+
+            for (auto channel = 0; channel < 2; ++channel)
+                graph.addConnection ({ { previous, channel }, { output, channel } });
+        }
+
+        // The graph is rebuilt asynchronously on the message thread. In non-realtime mode,
+        // processBlock() waits for the new render sequence, instead of outputting silence.
+        graph.setNonRealtime (true);
+        graph.prepareToPlay (sampleRate, blockSize);
+
+        AudioBuffer<float> buffer (2, blockSize);
+        MidiBuffer midi;
+
+        const auto processBlock = [&]
+        {
+            for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+                FloatVectorOperations::fill (buffer.getWritePointer (channel), 0.1f, blockSize);
+
+            graph.processBlock (buffer, midi);
+        };
+
+        processBlock();
+        graph.setNonRealtime (false);
+
+        for (auto i = 0; i < numWarmupBlocks; ++i)
+            processBlock();
+
+        const auto start = Time::getHighResolutionTicks();
+
+        for (auto i = 0; i < numMeasuredBlocks; ++i)
+            processBlock();
+
+        const auto elapsed = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+
+        graph.releaseResources();
+        return 1000.0 * elapsed / numMeasuredBlocks;
+    }
+};
@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Compares the speed of HashMap, FlatHashMap and std::unordered_map.
+
+    Each map is filled with int or String keys, then searched for keys that it
+    contains and keys that it doesn't. The String maps are searched with a StringRef
+    where the map allows it. A final test measures how long it takes to create an
+    Identifier from a string, which looks the string up in the global StringPool.
+    The fastest of a few runs is written to the Logger, in nanoseconds per operation.
+*/
+class HashMapBenchmark
+{
+public:
+    static void run()
+    {
+        Logger::writeToLog ("Hash map benchmark");
+        Logger::writeToLog ("");
+
+        constexpr int numKeys = 100000;
+
+        Array<int> intKeys, missingIntKeys;
+        StringArray stringKeys, missingStringKeys;
+        Random random (1234);
+
+        for (int i = 0; i < numKeys; ++i)
+        {
+            intKeys.add (random.nextInt());
+            missingIntKeys.add (random.nextInt());
+            stringKeys.add ("parameter_" + String::toHexString (random.nextInt64()));
+            missingStringKeys.add ("parameter_" + String::toHexString (random.nextInt64()));
+        }
+
+        Logger::writeToLog ("int keys                 insert     find     miss");
+        logResults ("HashMap", measureJuceHashMap<HashMap<int, int>> (intKeys, missingIntKeys));
+        logResults ("FlatHashMap", measureFlatHashMap<FlatHashMap<int, int>> (intKeys, missingIntKeys));
+        logResults ("std::unordered_map", measureStdMap<std::unordered_map<int, int>> (intKeys, missingIntKeys));
+        Logger::writeToLog ("");
+
+        Logger::writeToLog ("String keys              insert     find     miss");
+        logResults ("HashMap", measureJuceHashMap<HashMap<String, int>> (stringKeys, missingStringKeys));
+        logResults ("FlatHashMap", measureFlatHashMap<FlatHashMap<String, int>> (stringKeys, missingStringKeys));
+        logResults ("std::unordered_map", measureStdMap<std::unordered_map<String, int>> (stringKeys, missingStringKeys));
+        Logger::writeToLog ("");
+
+        const auto identifiers = measure (numKeys, [&]
+        {
+            int check = 0;
+
+            for (auto& key : stringKeys)
+                check += Identifier (key.toRawUTF8()).isValid() ? 1 : 0;
+
+            return check;
+        });
+
+        Logger::writeToLog ("Identifier from a string: " + String (identifiers, 1) + " ns");
+        Logger::writeToLog ("");
+    }
+
+private:
+    struct Results { double insert, find, miss; };
+
+    static void logResults (const String& name, Results r)
+    {
+        Logger::writeToLog (name.paddedRight (' ', 20)
+                             + String (r.insert, 1).paddedLeft (' ', 9)
+                             + String (r.find, 1).paddedLeft (' ', 9)
+                             + String (r.miss, 1).paddedLeft (' ', 9) + " ns");
+    }
+
+    template <typename Fn>
+    static double measure (int numOperations, Fn&& fn)
+    {
+        constexpr int numRuns = 5;
+        auto fastest = std::numeric_limits<double>::max();
+
+        for (int i = 0; i < numRuns; ++i)
+        {
+            const auto start = Time::getHighResolutionTicks();
+            resultSink += fn();  // stops the compiler from optimising the work away
+            fastest = jmin (fastest, Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start));
+        }
+
+        return fastest * 1.0e9 / numOperations;
+    }
+
+    template <typename MapType, typename KeyArray, typename InsertFn, typename FindFn>
+    static Results measureMap (const KeyArray& keys, const KeyArray& missingKeys, InsertFn&& insert, FindFn&& find)
+    {
+        const auto numKeys = keys.size();
+
+        const auto insertTime = measure (numKeys, [&]
+        {
+            MapType map;
+            int i = 0;
+
+            for (auto& key : keys)
+                insert (map, key, i++);
+
+            return i;
+        });
+
+        MapType map;
+        int i = 0;
+
+        for (auto& key : keys)
+            insert (map, key, i++);
+
+        // Searching in the order the keys were added would favour maps that allocate
+        // their items one at a time, as those items would be next to each other. The
+        // keys are copied so that String comparisons can't just compare their pointers.
+        KeyArray shuffledKeys;
+        Random random (4321);
+
+        for (auto& key : keys)
+            shuffledKeys.add (copyKey (key));
+
+        for (auto n = shuffledKeys.size(); --n > 0;)
+            std::swap (shuffledKeys.getReference (n), shuffledKeys.getReference (random.nextInt (n + 1)));
+
+        KeyArray shuffledMissingKeys;
+
+        for (auto& key : missingKeys)
+            shuffledMissingKeys.add (copyKey (key));
+
+        const auto findTime = measure (numKeys, [&]
+        {
+            int check = 0;
+
+            for (auto& key : shuffledKeys)
+                check += find (map, key);
+
+            return check;
+        });
+
+        const auto missTime = measure (numKeys, [&]
+        {
+            int check = 0;
+
+            for (auto& key : shuffledMissingKeys)
+                check += find (map, key);
+
+            return check;
+        });
+
+        return { insertTime, findTime, missTime };
+    }
+
+    template <typename MapType, typename KeyArray>
+    static Results measureJuceHashMap (const KeyArray& keys, const KeyArray& missingKeys)
+    {
+        return measureMap<MapType> (keys, missingKeys,
+                                    [] (auto& map, const auto& key, int value) { map.set (key, value); },
+                                    [] (auto& map, const auto& key) { return map.contains (key) ? 1 : 0; });
+    }
+
+    template <typename MapType, typename KeyArray>
+    static Results measureFlatHashMap (const KeyArray& keys, const KeyArray& missingKeys)
+    {
+        return measureMap<MapType> (keys, missingKeys,
+                                    [] (auto& map, const auto& key, int value) { map.set (key, value); },
+                                    [] (auto& map, const auto& key) { return map.contains (lookupKey (key)) ? 1 : 0; });
+    }
+
+    template <typename MapType, typename KeyArray>
+    static Results measureStdMap (const KeyArray& keys, const KeyArray& missingKeys)
+    {
+        return measureMap<MapType> (keys, missingKeys,
+                                    [] (auto& map, const auto& key, int value) { map[key] = value; },
+                                    [] (auto& map, const auto& key) { return map.find (key) != map.end() ? 1 : 0; });
+    }
+
+    static int lookupKey (int key)                      { return key; }
+    static StringRef lookupKey (const String& key)      { return key; }
+
+    static int copyKey (int key)                        { return key; }
+    static String copyKey (const String& key)           { return String (key.toRawUTF8()); }
+
+    static inline std::atomic<int> resultSink { 0 };
+};
@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Compares the throughput of JSON::parse() with JSONEventParser, both when it builds
+    a var and when it only reports events to a Listener.
+
+    Three kinds of generated document are parsed: a preset catalogue made of many small
+    objects, long arrays of numbers, and long strings with escape sequences. Each parse is
+    repeated a few times and the fastest is written to the Logger, in MB per second.
+*/
+class JSONParserBenchmark
+{
+public:
+    static void run()
+    {
+        Logger::writeToLog ("JSON parser benchmark");
+        Logger::writeToLog ("");
+        Logger::writeToLog ("document     size       JSON::parse   JSONEventParser (var)   JSONEventParser (Listener)");
+
+        Random random (1234);
+
+        for (const auto& [name, text] : { std::pair { String ("catalogue"), createCatalogue (random) },
+                                          std::pair { String ("numbers"),   createNumbers (random) },
+                                          std::pair { String ("strings"),   createStrings (random) } })
+        {
+            const auto numBytes = text.getNumBytesAsUTF8();
+
+            const auto original = measure (numBytes, [&] { return JSON::parse (text).isVoid() ? 0 : 1; });
+
+            JSONEventParser parser;
+
+            const auto toVar = measure (numBytes, [&]
+            {
+                var result;
+                parser.parse (text, result);
+                return result.isVoid() ? 0 : 1;
+            });
+
+            const auto events = measure (numBytes, [&]
+            {
+                CountingListener listener;
+                parser.parse (text, listener);
+                return listener.numEvents;
+            });
+
+            Logger::writeToLog (name.paddedRight (' ', 13)
+                                + (String ((double) numBytes / 1.0e6, 1) + " MB").paddedRight (' ', 11)
+                                + (String (original, 1) + " MB/s").paddedRight (' ', 14)
+                                + (String (toVar, 1) + " MB/s").paddedRight (' ', 24)
+                                + String (events, 1) + " MB/s");
+        }
+
+        Logger::writeToLog ("");
+    }
+
+private:
+    //==============================================================================
+    struct CountingListener final : public JSONEventParser::Listener
+    {
+        void objectStarted() override           { ++numEvents; }
+        void arrayStarted() override            { ++numEvents; }
+        void propertyName (StringRef) override  { ++numEvents; }
+        void stringValue (StringRef) override   { ++numEvents; }
+        void intValue (int64) override          { ++numEvents; }
+        void doubleValue (double) override      { ++numEvents; }
+        void boolValue (bool) override          { ++numEvents; }
+        void nullValue() override               { ++numEvents; }
+
+        int numEvents = 0;
+    };
+
+    template <typename ParseFn>
+    static double measure (size_t numBytes, ParseFn&& parse)
+    {
+        constexpr int numRuns = 3;
+        auto fastest = std::numeric_limits<double>::max();
+        int check = 0;
+
+        for (int i = 0; i < numRuns; ++i)
+        {
+            const auto start = Time::getHighResolutionTicks();
+            check += parse();
+            fastest = jmin (fastest, Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start));
+        }
+
+        jassert (check > 0);
+        return (double) numBytes / fastest / 1.0e6;
+    }
+
+    //==============================================================================
+    static String createCatalogue (Random& random)
+    {
+        Array<var> presets;
+
+        for (int i = 0; i < 50000; ++i)
+        {
+            auto* preset = new DynamicObject();
+            preset->setProperty ("id", i);
+            preset->setProperty ("uuid", Uuid().toString());
+            preset->setProperty ("name", "Preset " + String (i));
+            preset->setProperty ("author", "Sound Designer " + String (random.nextInt (100)));
+            preset->setProperty ("favourite", random.nextBool());
+            preset->setProperty ("rating", random.nextInt (6));
+            preset->setProperty ("modified", Time::getCurrentTime().toMilliseconds() - random.nextInt64() % 100000000);
+
+            Array<var> tags;
+
+            for (int t = random.nextInt (5); --t >= 0;)
+                tags.add ("tag" + String (random.nextInt (40)));
+
+            preset->setProperty ("tags", tags);
+
+            Array<var> parameters;
+
+            for (int p = 0; p < 16; ++p)
+                parameters.add (random.nextDouble());
+
+            preset->setProperty ("parameters", parameters);
+            presets.add (var (preset));
+        }
+
+        return JSON::toString (presets, false);
+    }
+
+    static String createNumbers (Random& random)
+    {
+        Array<var> rows;
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            Array<var> row;
+
+            for (int j = 0; j < 256; ++j)
+                row.add (random.nextBool() ? var (random.nextInt (100000) - 50000)
+                                           : var ((random.nextDouble() - 0.5) * 1000.0));
+
+            rows.add (row);
+        }
+
+        return JSON::toString (rows, true);
+    }
+
+    static String createStrings (Random& random)
+    {
+        Array<var> strings;
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            String s;
+
+            for (int j = 0; j < 100; ++j)
+                s << "Line " << random.nextInt (1000) << " of some \"quoted\" text\t with a path C:\\Presets\\" << j << "\n";
+
+            strings.add (s);
+        }
+
+        return JSON::toString (strings, false);
+    }
+};
@@ -0,0 +1,177 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Compares the throughput of writing JSON with JSON::writeToStream() and with JSONWriter.
+
+    Two kinds of document are written to a MemoryOutputStream: a preset catalogue made of
+    many small objects, and long arrays of doubles. Each is written from a var using both
+    writers, and then directly from the C++ types using ToVar, either through a var or
+    streaming into a JSONWriter. Each write is repeated a few times and the fastest is written
+    to the Logger, in MB of output per second.
+*/
+class JSONWriterBenchmark
+{
+public:
+    static void run()
+    {
+        Logger::writeToLog ("JSON writer benchmark");
+        Logger::writeToLog ("");
+        Logger::writeToLog ("document     size       JSON::writeToStream   JSONWriter (var)   ToVar + writeToStream   ToVar + JSONWriter");
+
+        Random random (1234);
+
+        const auto catalogue = createCatalogue (random);
+        const auto numbers = createNumbers (random);
+
+        report ("catalogue", catalogue);
+        report ("numbers", numbers);
+
+        Logger::writeToLog ("");
+    }
+
+private:
+    //==============================================================================
+    struct Preset
+    {
+        int id = 0;
+        String name, author;
+        bool favourite = false;
+        int64 modified = 0;
+        std::vector<String> tags;
+        std::vector<double> parameters;
+
+        static constexpr auto marshallingVersion = std::nullopt;
+
+        template <typename Archive, typename T>
+        static void serialise (Archive& archive, T& t)
+        {
+            archive (named ("id", t.id),
+                     named ("name", t.name),
+                     named ("author", t.author),
+                     named ("favourite", t.favourite),
+                     named ("modified", t.modified),
+                     named ("tags", t.tags),
+                     named ("parameters", t.parameters));
+        }
+    };
+
+    template <typename T>
+    static void report (const String& name, const T& document)
+    {
+        const auto asVar = *ToVar::convert (document);
+
+        MemoryOutputStream stream;
+        const auto measure = [&stream] (auto&& write)
+        {
+            constexpr int numRuns = 3;
+            auto fastest = std::numeric_limits<double>::max();
+
+            for (int i = 0; i < numRuns; ++i)
+            {
+                stream.reset();
+                const auto start = Time::getHighResolutionTicks();
+                write();
+                fastest = jmin (fastest, Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start));
+            }
+
+            return (double) stream.getDataSize() / fastest / 1.0e6;
+        };
+
+        const auto format = JSON::FormatOptions{}.withSpacing (JSON::Spacing::none);
+
+        const auto original = measure ([&] { JSON::writeToStream (stream, asVar, format); });
+        const auto numBytes = stream.getDataSize();
+
+        const auto writerFromVar = measure ([&]
+        {
+            JSONWriter writer (stream, format);
+            writer.writeVar (asVar);
+        });
+
+        const auto viaVar = measure ([&] { JSON::writeToStream (stream, *ToVar::convert (document), format); });
+
+        const auto streamed = measure ([&]
+        {
+            JSONWriter writer (stream, format);
+            ToVar::convert (document, writer);
+        });
+
+        Logger::writeToLog (name.paddedRight (' ', 13)
+                            + (String ((double) numBytes / 1.0e6, 1) + " MB").paddedRight (' ', 11)
+                            + (String (original, 1) + " MB/s").paddedRight (' ', 22)
+                            + (String (writerFromVar, 1) + " MB/s").paddedRight (' ', 19)
+                            + (String (viaVar, 1) + " MB/s").paddedRight (' ', 24)
+                            + String (streamed, 1) + " MB/s");
+    }
+
+    //==============================================================================
+    static std::vector<Preset> createCatalogue (Random& random)
+    {
+        std::vector<Preset> presets (50000);
+
+        for (size_t i = 0; i < presets.size(); ++i)
+        {
+            auto& preset = presets[i];
+            preset.id = (int) i;
+            preset.name = "Preset " + String ((int) i);
+            preset.author = "Sound Designer " + String (random.nextInt (100));
+            preset.favourite = random.nextBool();
+            preset.modified = Time::getCurrentTime().toMilliseconds() - random.nextInt64() % 100000000;
+
+            for (int t = random.nextInt (5); --t >= 0;)
+                preset.tags.push_back ("tag" + String (random.nextInt (40)));
+
+            for (int p = 0; p < 16; ++p)
+                preset.parameters.push_back (random.nextDouble());
+        }
+
+        return presets;
+    }
+
+    static std::vector<std::vector<double>> createNumbers (Random& random)
+    {
+        std::vector<std::vector<double>> rows (2000);
+
+        for (auto& row : rows)
+            for (int j = 0; j < 256; ++j)
+                row.push_back ((random.nextDouble() - 0.5) * 1000.0);
+
+        return rows;
+    }
+};
@@ -36,6 +36,21 @@
 
 #include <JuceHeader.h>
 #include <mutex>
+#include "BufferingReaderBenchmark.h"
+#include "ConvolutionBenchmark.h"
+#include "GraphRenderBenchmark.h"
+#include "HashMapBenchmark.h"
+#include "JSONParserBenchmark.h"
+#include "JSONWriterBenchmark.h"
+#include "MidiEventBufferBenchmark.h"
+#include "Mp3SeekBenchmark.h"
+#include "QueueBenchmark.h"
+#include "StreamingSamplerBenchmark.h"
+#include "ThreadPoolBenchmark.h"
+#include "ThumbnailBenchmark.h"
+#include "TranscodeBenchmark.h"
+#include "ValueTreePropertyBenchmark.h"
+#include "XmlParserBenchmark.h"
 
 //==============================================================================
 class MainContentComponent final : public AudioAppComponent,
@@ -45,16 +60,19 @@ public:
     //==============================================================================
     MainContentComponent()
     {
-        setSize (400, 400);
+        initGui();
+        setSize (600, 500);
         setAudioChannels (0, 2);
 
-        initGui();
         Desktop::getInstance().setScreenSaverEnabled (false);
         startTimer (1000);
     }
 
     ~MainContentComponent() override
     {
+        if (benchmarkThread.joinable())
+            benchmarkThread.join();
+
         shutdownAudio();
     }
 
@@ -63,6 +81,8 @@ public:
     {
         currentSampleRate = sampleRate;
         allocateBuffers (static_cast<size_t> (bufferSize));
+        preparedSampleRate = sampleRate;
+        preparedBlockSize = bufferSize;
         printHeader();
     }
 
@@ -72,6 +92,8 @@ public:
         b.clear();
         c.clear();
         currentSampleRate = 0.0;
+        preparedSampleRate = 0.0;
+        preparedBlockSize = 0;
     }
 
     //==============================================================================
@@ -120,13 +142,24 @@ public:
         g.setFont (FontOptions (16.0f));
         g.setColour (Colours::white);
         g.drawText ("loop iterations / audio callback",
-                    getLocalBounds().withY (loopIterationsSlider.getHeight()), Justification::centred, true);
+                    loopIterationsSlider.getBounds().translated (0, loopIterationsSlider.getHeight()), Justification::centred, true);
     }
 
     //==============================================================================
     void resized() override
     {
-        loopIterationsSlider.setBounds (getLocalBounds().withSizeKeepingCentre (proportionOfWidth (0.9f), 50));
+        auto bounds = getLocalBounds();
+        loopIterationsSlider.setBounds (bounds.removeFromTop (150).withSizeKeepingCentre (proportionOfWidth (0.9f), 50));
+
+        Grid grid;
+
+        grid.templateColumns = { Grid::TrackInfo (Grid::Fr (1)), Grid::TrackInfo (Grid::Fr (1)) };
+        grid.autoRows = Grid::TrackInfo (Grid::Px (40));
+
+        for (auto* button : benchmarkButtons)
+            grid.items.add (GridItem (*button).withMargin ({ 5 }));
+
+        grid.performLayout (bounds.withSizeKeepingCentre (proportionOfWidth (0.9f), bounds.getHeight()));
     }
 
 private:
@@ -140,6 +173,64 @@ private:
         loopIterationsSlider.setColour (Slider::textBoxTextColourId, Colours::grey);
         updateNumLoopIterationsPerCallback();
         addAndMakeVisible (loopIterationsSlider);
+
+        const std::pair<const char*, std::function<void()>> benchmarks[]
+        {
+            { "Run graph render benchmark",         [this] { GraphRenderBenchmark::run (benchmarkSampleRate, benchmarkBlockSize); } },
+            { "Run lock-free queue benchmark",      [] { QueueBenchmark::run(); } },
+            { "Run thread pool benchmark",          [] { ThreadPoolBenchmark::run(); } },
+            { "Run streaming sampler benchmark",    [] { StreamingSamplerBenchmark::run(); } },
+            { "Run thumbnail benchmark",            [] { ThumbnailBenchmark::run(); } },
+            { "Run transcode benchmark",            [] { TranscodeBenchmark::run(); } },
+            { "Run MP3 seek benchmark",             [] { Mp3SeekBenchmark::run(); } },
+            { "Run buffering reader benchmark",     [] { BufferingReaderBenchmark::run(); } },
+            { "Run MIDI event buffer benchmark",    [] { MidiEventBufferBenchmark::run(); } },
+            { "Run JSON parser benchmark",          [] { JSONParserBenchmark::run(); } },
+            { "Run JSON writer benchmark",          [] { JSONWriterBenchmark::run(); } },
+            { "Run XML parser benchmark",           [] { XmlParserBenchmark::run(); } },
+            { "Run hash map benchmark",             [] { HashMapBenchmark::run(); } },
+            { "Run ValueTree property benchmark",   [] { ValueTreePropertyBenchmark::run(); } },
+            { "Run convolution benchmark",          [] { ConvolutionBenchmark::run(); } }
+        };
+
+        for (const auto& [name, run] : benchmarks)
+        {
+            auto* button = benchmarkButtons.add (new TextButton (name));
+            button->onClick = [this, run] { runBenchmark (run); };
+            addAndMakeVisible (button);
+        }
+    }
+
+    //==============================================================================
+    void runBenchmark (std::function<void()> benchmark)
+    {
+        if (benchmarkThread.joinable())
+            benchmarkThread.join();
+
+        const auto sampleRate = preparedSampleRate.load();
+        const auto blockSize = preparedBlockSize.load();
+
+        benchmarkSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
+        benchmarkBlockSize = blockSize > 0 ? blockSize : 256;
+
+        setBenchmarkButtonsEnabled (false);
+
+        benchmarkThread = std::thread ([benchmark, safeThis = SafePointer<MainContentComponent> (this)]
+        {
+            benchmark();
+
+            MessageManager::callAsync ([safeThis]
+            {
+                if (safeThis != nullptr)
+                    safeThis->setBenchmarkButtonsEnabled (true);
+            });
+        });
+    }
+
+    void setBenchmarkButtonsEnabled (bool shouldBeEnabled)
+    {
+        for (auto* button : benchmarkButtons)
+            button->setEnabled (shouldBeEnabled);
     }
 
     //==============================================================================
@@ -267,6 +358,10 @@ private:
     std::vector<float> a, b, c; // must always be of size == current bufferSize
     double currentSampleRate = 0.0;
 
+    // The audio settings, for the message thread to read while the device is running
+    std::atomic<double> preparedSampleRate { 0.0 };
+    std::atomic<int> preparedBlockSize { 0 };
+
     StatisticsAccumulator<double> audioCallbackRuntimeMs;
     StatisticsAccumulator<double> audioCallbackGapMs;
     double lastCallbackStartTimeMs = 0.0;
@@ -275,6 +370,10 @@ private:
     int numLoopIterationsPerCallback;
 
     Slider loopIterationsSlider;
+    OwnedArray<TextButton> benchmarkButtons;
+    double benchmarkSampleRate = 44100.0;
+    int benchmarkBlockSize = 256;
+    std::thread benchmarkThread;
     std::mutex metricMutex;
 
     //==============================================================================
@@ -0,0 +1,187 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <juce_audio_basics/midi/juce_MidiDataConcatenator.h>
+#include <juce_audio_basics/midi/ump/juce_UMP.h>
+
+//==============================================================================
+/*  Builds blocks of dense controller automation and reads them back, the way a
+    plugin host would when several automation lanes are merged into one block.
+
+    Each lane adds its events in time order, but the lanes are added one after the
+    other, so the block as a whole arrives out of order. The events are collected
+    in a MidiBuffer, in a ump::EventBuffer, and in a ump::EventBuffer which is then
+    copied to a MidiBuffer. The average time per block is written to the Logger.
+*/
+class MidiEventBufferBenchmark
+{
+public:
+    static void run()
+    {
+        Logger::writeToLog ("MIDI event buffer benchmark");
+        Logger::writeToLog (String (blockSize) + " sample blocks, " + String (numBlocks) + " blocks per run");
+        Logger::writeToLog ("");
+        Logger::writeToLog ("events/block   MidiBuffer   EventBuffer   EventBuffer -> MidiBuffer");
+
+        for (const auto eventsPerLane : { 4, 32, 128, 512 })
+        {
+            const auto lanes = makeLanes (eventsPerLane);
+
+            Logger::writeToLog (String (numLanes * eventsPerLane).paddedRight (' ', 15)
+                                + formatMicroseconds (measureMidiBuffer (lanes)).paddedRight (' ', 13)
+                                + formatMicroseconds (measureEventBuffer (lanes, false)).paddedRight (' ', 14)
+                                + formatMicroseconds (measureEventBuffer (lanes, true)));
+        }
+
+        Logger::writeToLog ("");
+    }
+
+private:
+    static constexpr int blockSize = 512, numLanes = 16, numBlocks = 200;
+
+    struct CC
+    {
+        int time;
+        uint8 channel, controller, value;
+    };
+
+    using Lanes = std::vector<std::vector<CC>>;
+
+    static Lanes makeLanes (int eventsPerLane)
+    {
+        Random random (0x5eed);
+        Lanes lanes (numLanes);
+
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            for (int i = 0; i < eventsPerLane; ++i)
+            {
+                lanes[(size_t) lane].push_back ({ i * blockSize / eventsPerLane,
+                                                  (uint8) (lane % 16),
+                                                  (uint8) (lane / 16 + 1),
+                                                  (uint8) random.nextInt (128) });
+            }
+        }
+
+        return lanes;
+    }
+
+    static String formatMicroseconds (double us)
+    {
+        return String (us, 1) + " us";
+    }
+
+    template <typename Fn>
+    static double timePerBlock (Fn&& processBlock)
+    {
+        // Warm up the caches and let the buffers reach their working size
+        for (int i = 0; i < 10; ++i)
+            processBlock();
+
+        const auto start = Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numBlocks; ++i)
+            processBlock();
+
+        const auto seconds = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+        return seconds * 1.0e6 / numBlocks;
+    }
+
+    static double measureMidiBuffer (const Lanes& lanes)
+    {
+        MidiBuffer buffer;
+        int64 checksum = 0;
+
+        const auto result = timePerBlock ([&]
+        {
+            buffer.clear();
+
+            for (const auto& lane : lanes)
+            {
+                for (const auto& cc : lane)
+                {
+                    const uint8 bytes[] { (uint8) (0xb0 | cc.channel), cc.controller, cc.value };
+                    buffer.addEvent (bytes, 3, cc.time);
+                }
+            }
+
+            for (const auto metadata : buffer)
+                checksum += metadata.samplePosition + metadata.data[2];
+        });
+
+        jassertquiet (checksum != 0);
+        return result;
+    }
+
+    static double measureEventBuffer (const Lanes& lanes, bool copyToMidiBuffer)
+    {
+        const auto maxNumEvents = (size_t) numLanes * lanes.front().size();
+        ump::EventBuffer events (maxNumEvents, maxNumEvents);
+        MidiBuffer output;
+        output.ensureSize (maxNumEvents * 16);
+        int64 checksum = 0;
+
+        const auto result = timePerBlock ([&]
+        {
+            events.clear();
+
+            for (const auto& lane : lanes)
+                for (const auto& cc : lane)
+                    events.add (ump::Factory::makeControlChangeV1 (0, cc.channel, cc.controller, cc.value), cc.time);
+
+            events.sort();
+
+            if (copyToMidiBuffer)
+            {
+                events.copyTo (output);
+
+                for (const auto metadata : output)
+                    checksum += metadata.samplePosition + metadata.data[2];
+            }
+            else
+            {
+                for (const auto& event : events)
+                    checksum += event.samplePosition + (int) (event.packet[0] & 0x7f);
+            }
+        });
+
+        jassertquiet (checksum != 0);
+        return result;
+    }
+};
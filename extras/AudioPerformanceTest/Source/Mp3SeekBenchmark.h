@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Makes a two-hour MP3 file, and measures how long it takes to open it and read from
+    random positions in it, with a frame cache directory set. The first time the file is
+    opened, the reader scans every frame and saves the index; the second time, it loads
+    the index that was cached on disk.
+
+    The file's frames are all silent, which doesn't affect the seeking, and avoids
+    needing an encoder.
+*/
+class Mp3SeekBenchmark
+{
+public:
+    static void run()
+    {
+       #if JUCE_USE_MP3AUDIOFORMAT
+        Logger::writeToLog ("MP3 seek benchmark");
+        Logger::writeToLog (String (lengthSeconds / 3600.0) + " hour, 128kbps stereo MP3, reading "
+                            + String (samplesPerRead) + " samples at a time");
+        Logger::writeToLog ("");
+
+        const TemporaryFile file (".mp3");
+        const TemporaryFile cacheDirectory;
+
+        if (! writeSilence (file.getFile()))
+        {
+            Logger::writeToLog ("Couldn't write the test file");
+            return;
+        }
+
+        MP3AudioFormat format;
+        format.setFrameIndexCacheDirectory (cacheDirectory.getFile());
+        Random random;
+
+        for (auto* name : { "no cached index", "cached index" })
+        {
+            std::unique_ptr<AudioFormatReader> reader;
+
+            const auto openTime = measure ([&]
+            {
+                reader.reset (format.createReaderFor (file.getFile().createInputStream().release(), true));
+            });
+
+            if (reader == nullptr)
+            {
+                Logger::writeToLog ("Couldn't open the test file");
+                return;
+            }
+
+            AudioBuffer<float> buffer ((int) reader->numChannels, samplesPerRead);
+            const auto readAtRandom = [&]
+            {
+                const auto start = (int64) (random.nextDouble() * (double) (reader->lengthInSamples - samplesPerRead));
+                reader->read (&buffer, 0, samplesPerRead, start, true, true);
+            };
+
+            const auto firstReadTime = measure (readAtRandom);
+
+            const auto laterReadsTime = measure ([&]
+            {
+                for (int i = 0; i < numReads; ++i)
+                    readAtRandom();
+            });
+
+            Logger::writeToLog (String (name) + ": open " + String (openTime * 1000.0, 2) + " ms, first read "
+                                + String (firstReadTime * 1000.0, 2) + " ms, later reads "
+                                + String (laterReadsTime * 1000.0 / numReads, 3) + " ms each");
+        }
+
+        cacheDirectory.getFile().deleteRecursively();
+        Logger::writeToLog ("");
+       #else
+        Logger::writeToLog ("MP3 seek benchmark: JUCE_USE_MP3AUDIOFORMAT is disabled");
+       #endif
+    }
+
+private:
+    static constexpr int numReads = 1000, samplesPerRead = 4096;
+    static constexpr double lengthSeconds = 2.0 * 60.0 * 60.0;
+
+    // MPEG-1 Layer III frames at 48kHz and 128kbps are all 384 bytes long. With all-zero
+    // side info, each one decodes to 1152 samples of silence.
+    static bool writeSilence (const File& file)
+    {
+        const auto numFrames = (int) (lengthSeconds * 48000.0 / 1152.0);
+
+        MemoryBlock frame (384, true);
+        const uint8 header[] = { 0xff, 0xfb, 0x94, 0x00 };
+        frame.copyFrom (header, 0, sizeof (header));
+
+        FileOutputStream out (file);
+
+        if (! out.openedOk())
+            return false;
+
+        for (int i = 0; i < numFrames; ++i)
+            if (! out.write (frame.getData(), frame.getSize()))
+                return false;
+
+        return true;
+    }
+
+    // Returns the time taken, in seconds
+    template <typename Fn>
+    static double measure (Fn&& fn)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+        fn();
+        return (Time::getMillisecondCounterHiRes() - start) / 1000.0;
+    }
+};
@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Measures the throughput of the lock-free queues in juce_core, compared with an
+    AbstractFifo whose producers and consumers are serialised with SpinLocks.
+
+    A number of producer threads push small integers into a queue, in batches of a
+    fixed size, while a number of consumer threads pop them. The results are written
+    to the Logger, in millions of items per second.
+*/
+class QueueBenchmark
+{
+public:
+    static void run()
+    {
+        Logger::writeToLog ("Lock-free queue benchmark");
+        Logger::writeToLog (String (SystemStats::getNumCpus()) + " cores");
+        Logger::writeToLog ("");
+        Logger::writeToLog ("producers  consumers  batch     lock-free queue     AbstractFifo + SpinLock");
+
+        for (const auto& [numProducers, numConsumers] : { std::pair { 1, 1 }, { 2, 1 }, { 4, 1 }, { 2, 2 }, { 4, 4 } })
+        {
+            for (const auto batchSize : { 1, 32 })
+            {
+                const auto lockFree = [&]
+                {
+                    if (numProducers == 1 && numConsumers == 1)
+                        return measure<SPSCQueue<int>> (numProducers, numConsumers, batchSize);
+
+                    if (numConsumers == 1)
+                        return measure<MPSCQueue<int>> (numProducers, numConsumers, batchSize);
+
+                    return measure<MPMCQueue<int>> (numProducers, numConsumers, batchSize);
+                }();
+
+                const auto locked = measure<LockedFifo> (numProducers, numConsumers, batchSize);
+
+                Logger::writeToLog (String (numProducers).paddedRight (' ', 11)
+                                    + String (numConsumers).paddedRight (' ', 11)
+                                    + String (batchSize).paddedRight (' ', 10)
+                                    + (String (lockFree, 1) + " M/s").paddedRight (' ', 20)
+                                    + String (locked, 1) + " M/s");
+            }
+        }
+
+        Logger::writeToLog ("");
+    }
+
+private:
+    //==============================================================================
+    class LockedFifo
+    {
+    public:
+        explicit LockedFifo (int capacity)
+            : fifo (capacity), storage ((size_t) capacity) {}
+
+        size_t push (Span<const int> items)
+        {
+            const SpinLock::ScopedLockType sl (writeLock);
+            const auto writer = fifo.write ((int) items.size());
+            size_t i = 0;
+            writer.forEach ([&] (int index) { storage[(size_t) index] = items[i++]; });
+            return i;
+        }
+
+        size_t pop (Span<int> destination)
+        {
+            const SpinLock::ScopedLockType sl (readLock);
+            const auto reader = fifo.read ((int) destination.size());
+            size_t i = 0;
+            reader.forEach ([&] (int index) { destination[i++] = storage[(size_t) index]; });
+            return i;
+        }
+
+    private:
+        AbstractFifo fifo;
+        std::vector<int> storage;
+        SpinLock writeLock, readLock;
+    };
+
+    //==============================================================================
+    template <typename Queue>
+    static double measure (int numProducers, int numConsumers, int batchSize)
+    {
+        constexpr int itemsPerProducer = 1 << 21;
+
+        Queue queue (1024);
+        std::atomic<int> numPopped { 0 };
+        std::vector<std::thread> threads;
+        const auto totalItems = itemsPerProducer * numProducers;
+        const auto start = Time::getHighResolutionTicks();
+
+        for (auto i = 0; i < numProducers; ++i)
+        {
+            threads.emplace_back ([&]
+            {
+                std::vector<int> batch ((size_t) batchSize, 1);
+
+                for (auto remaining = itemsPerProducer; remaining > 0;)
+                {
+                    const auto numPushed = (int) queue.push (Span<const int> (batch.data(), (size_t) jmin (batchSize, remaining)));
+                    remaining -= numPushed;
+
+                    if (numPushed == 0)
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        for (auto i = 0; i < numConsumers; ++i)
+        {
+            threads.emplace_back ([&]
+            {
+                std::vector<int> batch ((size_t) batchSize);
+
+                while (numPopped.load (std::memory_order_relaxed) < totalItems)
+                {
+                    const auto num = (int) queue.pop (Span<int> (batch));
+                    numPopped += num;
+
+                    if (num == 0)
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        const auto elapsed = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+        return (double) totalItems / elapsed / 1.0e6;
+    }
+};
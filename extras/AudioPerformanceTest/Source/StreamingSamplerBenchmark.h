@@ -0,0 +1,192 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Plays a large number of StreamingSamplerVoices at once, streaming from WAV files
+    on disk, and paces the rendering as if it was running in an audio callback.
+
+    It runs once with buffered file readers and once with memory-mapped readers. The
+    results are written to the Logger: the throughput of the background threads, the
+    number of times a voice ran out of data, and the proportion of each block's time
+    that the rendering took.
+
+    The files are freshly written, so they're likely to be in the OS's file cache. Point
+    the streamer at a real sample library to measure a cold disk.
+*/
+class StreamingSamplerBenchmark
+{
+public:
+    static void run()
+    {
+        Logger::writeToLog ("Streaming sampler benchmark");
+        Logger::writeToLog (String (numVoices) + " voices, " + String (numFiles) + " files, "
+                            + String (blockSize) + " sample blocks at " + String (sampleRate) + " Hz");
+        Logger::writeToLog ("");
+
+        OwnedArray<TemporaryFile> files;
+
+        for (int i = 0; i < numFiles; ++i)
+        {
+            files.add (new TemporaryFile (".wav"));
+
+            if (! writeNoise (files.getLast()->getFile()))
+            {
+                Logger::writeToLog ("Couldn't write the test files");
+                return;
+            }
+        }
+
+        Logger::writeToLog ("readers          read rate        underruns  audio load");
+
+        for (const auto memoryMapped : { false, true })
+        {
+            const auto result = measure (files, memoryMapped);
+
+            Logger::writeToLog (String (memoryMapped ? "memory-mapped" : "buffered").paddedRight (' ', 17)
+                                + (String (result.megabytesPerSecond, 1) + " MB/s").paddedRight (' ', 17)
+                                + String (result.numUnderruns).paddedRight (' ', 11)
+                                + String (result.audioLoad * 100.0, 1) + "%");
+        }
+
+        Logger::writeToLog ("");
+    }
+
+private:
+    static constexpr int numVoices = 512, numFiles = 8, numChannels = 2, blockSize = 512;
+    static constexpr double sampleRate = 44100.0, fileLengthSeconds = 20.0, runLengthSeconds = 5.0;
+
+    struct Result
+    {
+        double megabytesPerSecond = 0.0;
+        int64 numUnderruns = 0;
+        double audioLoad = 0.0;
+    };
+
+    //==============================================================================
+    static bool writeNoise (const File& file)
+    {
+        std::unique_ptr<AudioFormatWriter> writer (WavAudioFormat().createWriterFor (file.createOutputStream().release(),
+                                                                                      sampleRate, numChannels, 24, {}, 0));
+
+        if (writer == nullptr)
+            return false;
+
+        AudioBuffer<float> noise (numChannels, 65536);
+        Random random;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < noise.getNumSamples(); ++i)
+                noise.setSample (channel, i, random.nextFloat() * 0.5f - 0.25f);
+
+        for (auto remaining = (int64) (fileLengthSeconds * sampleRate); remaining > 0; remaining -= noise.getNumSamples())
+            if (! writer->writeFromAudioSampleBuffer (noise, 0, (int) jmin (remaining, (int64) noise.getNumSamples())))
+                return false;
+
+        return true;
+    }
+
+    static std::unique_ptr<AudioFormatReader> createReader (const File& file, bool memoryMapped)
+    {
+        if (memoryMapped)
+            return std::unique_ptr<AudioFormatReader> (WavAudioFormat().createMemoryMappedReader (file));
+
+        return std::unique_ptr<AudioFormatReader> (WavAudioFormat().createReaderFor (file.createInputStream().release(), true));
+    }
+
+    static Result measure (const OwnedArray<TemporaryFile>& files, bool memoryMapped)
+    {
+        SamplerDiskStreamer streamer (numVoices, 4);
+        Result result;
+
+        {
+            Synthesiser synth;
+            synth.setCurrentPlaybackSampleRate (sampleRate);
+
+            for (int i = 0; i < numVoices; ++i)
+                synth.addVoice (new StreamingSamplerVoice (streamer));
+
+            // One sound per note, each at its natural pitch
+            for (int note = 0; note < 128; ++note)
+            {
+                BigInteger notes;
+                notes.setBit (note);
+
+                synth.addSound (new StreamingSamplerSound ("sound " + String (note),
+                                                           createReader (files[note % numFiles]->getFile(), memoryMapped),
+                                                           notes, note, 0.0, 0.1, 0.1));
+            }
+
+            for (int i = 0; i < numVoices; ++i)
+                synth.noteOn (1 + i / 128, i % 128, 0.1f);
+
+            AudioBuffer<float> output (numChannels, blockSize);
+            MidiBuffer midi;
+
+            const auto numBlocks = (int) (runLengthSeconds * sampleRate / blockSize);
+            const auto blockLengthMs = 1000.0 * blockSize / sampleRate;
+            double renderTicks = 0.0;
+
+            streamer.resetStatistics();
+            const auto start = Time::getMillisecondCounterHiRes();
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                const auto renderStart = Time::getHighResolutionTicks();
+                output.clear();
+                synth.renderNextBlock (output, midi, 0, blockSize);
+                renderTicks += (double) (Time::getHighResolutionTicks() - renderStart);
+
+                const auto deadline = start + (block + 1) * blockLengthMs;
+
+                while (Time::getMillisecondCounterHiRes() < deadline)
+                    Thread::sleep (1);
+            }
+
+            const auto elapsedSeconds = (Time::getMillisecondCounterHiRes() - start) / 1000.0;
+            const auto bytesPerFrame = (double) (numChannels * sizeof (float));
+
+            result.megabytesPerSecond = (double) streamer.getNumSamplesRead() * bytesPerFrame / elapsedSeconds / (1024.0 * 1024.0);
+            result.numUnderruns = streamer.getNumUnderruns();
+            result.audioLoad = Time::highResolutionTicksToSeconds ((int64) renderTicks) / (numBlocks * blockLengthMs / 1000.0);
+
+            synth.allNotesOff (0, false);
+        }
+
+        return result;
+    }
+};
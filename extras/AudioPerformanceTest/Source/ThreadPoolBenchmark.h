@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Measures how quickly a ThreadPool can run a large number of small lambda jobs, with
+    each of its job scheduling modes, and when the jobs are added to a ThreadPoolTaskGroup.
+
+    All the jobs are added from a single thread, and the time is measured from adding the
+    first job until the last one has finished. The results are written to the Logger, in
+    thousands of jobs per second.
+*/
+class ThreadPoolBenchmark
+{
+public:
+    static void run()
+    {
+        Logger::writeToLog ("ThreadPool benchmark");
+        Logger::writeToLog (String (SystemStats::getNumCpus()) + " cores, " + String (numJobs) + " jobs");
+        Logger::writeToLog ("");
+        Logger::writeToLog ("threads   shared queue     work stealing    task group");
+
+        for (const auto numThreads : { 1, 8, 64 })
+        {
+            using JobScheduling = ThreadPoolOptions::JobScheduling;
+
+            const auto shared = measure (numThreads, JobScheduling::sharedQueue, addJob);
+            const auto stealing = measure (numThreads, JobScheduling::workStealing, addJob);
+            const auto taskGroup = measure (numThreads, JobScheduling::workStealing, addToTaskGroup);
+
+            Logger::writeToLog (String (numThreads).paddedRight (' ', 10)
+                                + (String (shared, 1) + " k/s").paddedRight (' ', 17)
+                                + (String (stealing, 1) + " k/s").paddedRight (' ', 17)
+                                + String (taskGroup, 1) + " k/s");
+        }
+
+        Logger::writeToLog ("");
+    }
+
+private:
+    static constexpr int numJobs = 20000;
+
+    //==============================================================================
+    static void addJob (ThreadPool& pool, const std::function<void()>& job)
+    {
+        for (int i = 0; i < numJobs; ++i)
+            pool.addJob (job);
+    }
+
+    static void addToTaskGroup (ThreadPool& pool, const std::function<void()>& job)
+    {
+        ThreadPoolTaskGroup group (pool);
+
+        for (int i = 0; i < numJobs; ++i)
+            group.run (job);
+    }
+
+    template <typename AddJobs>
+    static double measure (int numThreads, ThreadPoolOptions::JobScheduling scheduling, AddJobs&& addJobs)
+    {
+        ThreadPool pool { ThreadPoolOptions{}.withNumberOfThreads (numThreads)
+                                             .withJobScheduling (scheduling) };
+
+        std::atomic<int> numFinished { 0 };
+        WaitableEvent allFinished;
+
+        // A small amount of work, roughly the size of a block of peak analysis
+        const auto job = [&]
+        {
+            float data[256];
+
+            for (int i = 0; i < 256; ++i)
+                data[i] = (float) i;
+
+            [[maybe_unused]] const auto range = FloatVectorOperations::findMinAndMax (data, 256);
+
+            if (++numFinished == numJobs)
+                allFinished.signal();
+        };
+
+        const auto start = Time::getHighResolutionTicks();
+        addJobs (pool, job);
+        allFinished.wait (-1);
+        const auto elapsed = Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start);
+
+        return (double) numJobs / elapsed / 1.0e3;
+    }
+};
@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Measures how long an AudioThumbnail takes to draw very long recordings.
+
+    For each length, a thumbnail is generated from noise, and then drawn into an image
+    with the whole file visible, with a tenth of it visible, and with a few seconds of it
+    visible. Each view is drawn while scrolling, so that the thumbnail has to refill its
+    cached window every time. The thumbnail is then saved to a cache directory, and the
+    time taken to load it back is measured.
+*/
+class ThumbnailBenchmark
+{
+public:
+    static void run()
+    {
+        Logger::writeToLog ("Thumbnail benchmark");
+        Logger::writeToLog (String (numChannels) + " channels at " + String (sampleRate) + " Hz, "
+                            + String (samplesPerThumbSample) + " samples per thumbnail sample, drawn "
+                            + String (imageWidth) + " pixels wide");
+        Logger::writeToLog ("");
+        Logger::writeToLog ("length   whole file    1/10 of file  10 seconds    load from disk");
+
+        for (const auto hours : { 1, 10 })
+        {
+            AudioFormatManager formatManager;
+            AudioThumbnailCache cache (4);
+            AudioThumbnail thumbnail (samplesPerThumbSample, formatManager, cache);
+
+            const auto lengthInSeconds = hours * 3600.0;
+            fillWithNoise (thumbnail, (int64) (lengthInSeconds * sampleRate));
+
+            auto line = (String (hours) + " h").paddedRight (' ', 9);
+
+            for (const auto visibleSeconds : { lengthInSeconds, lengthInSeconds / 10.0, 10.0 })
+                line << (String (measureDrawTime (thumbnail, visibleSeconds), 3) + " ms").paddedRight (' ', 14);
+
+            line << String (measureLoadTime (thumbnail, cache), 3) + " ms";
+            Logger::writeToLog (line);
+        }
+
+        Logger::writeToLog ("");
+    }
+
+private:
+    static constexpr int numChannels = 2, samplesPerThumbSample = 512, imageWidth = 1200, imageHeight = 300;
+    static constexpr double sampleRate = 44100.0;
+
+    static void fillWithNoise (AudioThumbnail& thumbnail, int64 numSamples)
+    {
+        thumbnail.reset (numChannels, sampleRate, numSamples);
+
+        AudioBuffer<float> noise (numChannels, samplesPerThumbSample * 256);
+        Random random;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < noise.getNumSamples(); ++i)
+                noise.setSample (channel, i, random.nextFloat() * 0.5f - 0.25f);
+
+        for (int64 pos = 0; pos < numSamples; pos += noise.getNumSamples())
+            thumbnail.addBlock (pos, noise, 0, (int) jmin ((int64) noise.getNumSamples(), numSamples - pos));
+    }
+
+    // Returns the average time taken to draw a frame, in milliseconds
+    static double measureDrawTime (AudioThumbnail& thumbnail, double visibleSeconds)
+    {
+        constexpr int numFrames = 50;
+
+        Image image (Image::ARGB, imageWidth, imageHeight, true);
+        Graphics g (image);
+        g.setColour (Colours::white);
+
+        const auto maxStart = thumbnail.getTotalLength() - visibleSeconds;
+        const auto start = Time::getHighResolutionTicks();
+
+        for (int frame = 0; frame < numFrames; ++frame)
+        {
+            const auto startTime = maxStart * frame / numFrames;
+            thumbnail.drawChannels (g, image.getBounds(), startTime, startTime + visibleSeconds, 1.0f);
+        }
+
+        return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start) * 1000.0 / numFrames;
+    }
+
+    // Returns the time taken to load the thumbnail back from a cache directory, in milliseconds
+    static double measureLoadTime (AudioThumbnail& thumbnail, AudioThumbnailCache& cache)
+    {
+        const TemporaryFile directory;
+        constexpr int64 hash = 0x7b5;
+
+        cache.setCacheDirectory (directory.getFile());
+        cache.storeThumb (thumbnail, hash);
+        cache.clear();
+
+        const auto start = Time::getHighResolutionTicks();
+        const auto loaded = cache.loadThumb (thumbnail, hash);
+        const auto elapsed = Time::getHighResolutionTicks() - start;
+
+        directory.getFile().deleteRecursively();
+
+        if (! loaded)
+            Logger::writeToLog ("Couldn't load the thumbnail from disk");
+
+        return Time::highResolutionTicksToSeconds (elapsed) * 1000.0;
+    }
+};
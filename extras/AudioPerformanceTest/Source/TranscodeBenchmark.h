@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Converts a batch of WAV files to FLAC, first one file at a time using
+    AudioFormatWriter::writeFromAudioReader(), and then with an AudioFormatPipeline
+    using different numbers of threads.
+
+    The throughput is reported in files per second, and in megabytes of source
+    audio per second.
+*/
+class TranscodeBenchmark
+{
+public:
+    static void run()
+    {
+        Logger::writeToLog ("Transcode benchmark");
+        Logger::writeToLog (String (numFiles) + " stereo 24-bit WAV files of " + String (fileLengthSeconds)
+                            + " seconds, converted to FLAC");
+        Logger::writeToLog ("");
+
+        const TemporaryFile directory;
+        std::vector<AudioFormatPipeline::Job> jobs;
+        int64 totalBytes = 0;
+
+        for (int i = 0; i < numFiles; ++i)
+        {
+            const auto source = directory.getFile().getChildFile ("source" + String (i) + ".wav");
+
+            if (! writeNoise (source))
+            {
+                Logger::writeToLog ("Couldn't write the test files");
+                return;
+            }
+
+            totalBytes += source.getSize();
+            jobs.push_back ({ source, source.withFileExtension ("flac") });
+        }
+
+        AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        Logger::writeToLog ("method               files/sec     MB/sec");
+
+        logResult ("one at a time", measure ([&] { convertSerially (formatManager, jobs); }), totalBytes);
+
+        for (int numThreads = 1;; numThreads = jmin (numThreads * 2, SystemStats::getNumCpus()))
+        {
+            AudioFormatPipeline pipeline (formatManager, AudioFormatPipeline::Options{}.withNumberOfThreads (numThreads));
+            logResult ("pipeline, " + String (numThreads) + " threads", measure ([&] { pipeline.process (jobs); }), totalBytes);
+
+            if (numThreads >= SystemStats::getNumCpus())
+                break;
+        }
+
+        directory.getFile().deleteRecursively();
+        Logger::writeToLog ("");
+    }
+
+private:
+    static constexpr int numFiles = 32, numChannels = 2;
+    static constexpr double sampleRate = 44100.0, fileLengthSeconds = 10.0;
+
+    static bool writeNoise (const File& file)
+    {
+        file.getParentDirectory().createDirectory();
+
+        std::unique_ptr<AudioFormatWriter> writer (WavAudioFormat().createWriterFor (file.createOutputStream().release(),
+                                                                                      sampleRate, numChannels, 24, {}, 0));
+
+        if (writer == nullptr)
+            return false;
+
+        AudioBuffer<float> noise (numChannels, 65536);
+        Random random;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < noise.getNumSamples(); ++i)
+                noise.setSample (channel, i, random.nextFloat() * 0.5f - 0.25f);
+
+        for (auto remaining = (int64) (fileLengthSeconds * sampleRate); remaining > 0; remaining -= noise.getNumSamples())
+            if (! writer->writeFromAudioSampleBuffer (noise, 0, (int) jmin (remaining, (int64) noise.getNumSamples())))
+                return false;
+
+        return true;
+    }
+
+    static void convertSerially (AudioFormatManager& formatManager, const std::vector<AudioFormatPipeline::Job>& jobs)
+    {
+        FlacAudioFormat flac;
+
+        for (auto& job : jobs)
+        {
+            std::unique_ptr<AudioFormatReader> reader (formatManager.createReaderFor (job.sourceFile));
+            job.destinationFile.deleteFile();
+            std::unique_ptr<AudioFormatWriter> writer (flac.createWriterFor (job.destinationFile.createOutputStream().release(),
+                                                                             reader->sampleRate, reader->numChannels,
+                                                                             24, {}, 0));
+            writer->writeFromAudioReader (*reader, 0, -1);
+        }
+    }
+
+    // Returns the time taken, in seconds
+    template <typename Fn>
+    static double measure (Fn&& convert)
+    {
+        const auto start = Time::getMillisecondCounterHiRes();
+        convert();
+        return (Time::getMillisecondCounterHiRes() - start) / 1000.0;
+    }
+
+    static void logResult (const String& name, double seconds, int64 totalBytes)
+    {
+        Logger::writeToLog (name.paddedRight (' ', 21)
+                            + String (numFiles / seconds, 1).paddedRight (' ', 14)
+                            + String ((double) totalBytes / seconds / (1024.0 * 1024.0), 1));
+    }
+};
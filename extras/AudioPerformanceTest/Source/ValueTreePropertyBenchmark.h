@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Measures the speed of ValueTree property access as the number of properties grows.
+
+    For each size, a tree is filled with properties, then every property is read
+    with getProperty() and overwritten with setProperty(), in a shuffled order. The
+    fastest of a few runs is written to the Logger, in nanoseconds per operation.
+*/
+class ValueTreePropertyBenchmark
+{
+public:
+    static void run()
+    {
+        Logger::writeToLog ("ValueTree property benchmark");
+        Logger::writeToLog ("");
+        Logger::writeToLog ("Properties       add      get      set");
+
+        for (auto numProperties : { 10, 100, 1000 })
+        {
+            Array<Identifier> names;
+
+            for (int i = 0; i < numProperties; ++i)
+                names.add ("property_" + String (i));
+
+            auto shuffledNames = names;
+            Random random (1234);
+
+            for (auto n = shuffledNames.size(); --n > 0;)
+                std::swap (shuffledNames.getReference (n), shuffledNames.getReference (random.nextInt (n + 1)));
+
+            // Small trees are measured many times over, so that every size does a similar
+            // amount of work.
+            const auto numRepeats = 100000 / numProperties;
+            const auto numOperations = numRepeats * numProperties;
+
+            const auto addTime = measure (numOperations, [&]
+            {
+                int check = 0;
+
+                for (int r = 0; r < numRepeats; ++r)
+                {
+                    ValueTree tree ("TREE");
+
+                    for (auto& name : names)
+                        tree.setProperty (name, r, nullptr);
+
+                    check += tree.getNumProperties();
+                }
+
+                return check;
+            });
+
+            ValueTree tree ("TREE");
+
+            for (auto& name : names)
+                tree.setProperty (name, 0, nullptr);
+
+            const auto getTime = measure (numOperations, [&]
+            {
+                int check = 0;
+
+                for (int r = 0; r < numRepeats; ++r)
+                    for (auto& name : shuffledNames)
+                        check += (int) tree.getProperty (name);
+
+                return check;
+            });
+
+            const auto setTime = measure (numOperations, [&]
+            {
+                for (int r = 0; r < numRepeats; ++r)
+                    for (auto& name : shuffledNames)
+                        tree.setProperty (name, r, nullptr);
+
+                return tree.getNumProperties();
+            });
+
+            Logger::writeToLog (String (numProperties).paddedLeft (' ', 10)
+                                 + String (addTime, 1).paddedLeft (' ', 9)
+                                 + String (getTime, 1).paddedLeft (' ', 9)
+                                 + String (setTime, 1).paddedLeft (' ', 9) + " ns");
+        }
+
+        Logger::writeToLog ("");
+    }
+
+private:
+    template <typename Fn>
+    static double measure (int numOperations, Fn&& fn)
+    {
+        constexpr int numRuns = 5;
+        auto fastest = std::numeric_limits<double>::max();
+
+        for (int i = 0; i < numRuns; ++i)
+        {
+            const auto start = Time::getHighResolutionTicks();
+            resultSink += fn();  // stops the compiler from optimising the work away
+            fastest = jmin (fastest, Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start));
+        }
+
+        return fastest * 1.0e9 / numOperations;
+    }
+
+    static inline std::atomic<int> resultSink { 0 };
+};
@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*  Compares the throughput of XmlDocument with XmlStreamReader.
+
+    A generated session document, made of tracks containing clips and automation points,
+    is parsed from memory in three ways: by XmlDocument, by an XmlStreamReader that only
+    visits each item, and by an XmlStreamReader that builds the same XmlElement tree with
+    readElement(). Each parse is repeated a few times and the fastest is written to the
+    Logger, in MB per second.
+*/
+class XmlParserBenchmark
+{
+public:
+    static void run()
+    {
+        Logger::writeToLog ("XML parser benchmark");
+        Logger::writeToLog ("");
+
+        Random random (1234);
+        const auto text = createSession (random);
+        const auto numBytes = text.getSize();
+
+        const auto original = measure (numBytes, [&]
+        {
+            return XmlDocument (String::fromUTF8 (static_cast<const char*> (text.getData()), (int) numBytes)).getDocumentElement() != nullptr ? 1 : 0;
+        });
+
+        const auto events = measure (numBytes, [&]
+        {
+            MemoryInputStream stream (text, false);
+            XmlStreamReader reader (stream);
+            int numEvents = 0;
+
+            while (reader.next() != XmlStreamReader::Event::endOfDocument)
+            {
+                if (reader.getEvent() == XmlStreamReader::Event::error)
+                    return 0;
+
+                ++numEvents;
+            }
+
+            return numEvents;
+        });
+
+        const auto elements = measure (numBytes, [&]
+        {
+            MemoryInputStream stream (text, false);
+            XmlStreamReader reader (stream);
+            return reader.next() == XmlStreamReader::Event::startElement && reader.readElement() != nullptr ? 1 : 0;
+        });
+
+        Logger::writeToLog ("Document size:                        " + String ((double) numBytes / 1.0e6, 1) + " MB");
+        Logger::writeToLog ("XmlDocument:                          " + String (original, 1) + " MB/s");
+        Logger::writeToLog ("XmlStreamReader (events only):        " + String (events, 1) + " MB/s");
+        Logger::writeToLog ("XmlStreamReader (whole XmlElement):   " + String (elements, 1) + " MB/s");
+        Logger::writeToLog ("");
+    }
+
+private:
+    template <typename ParseFn>
+    static double measure (size_t numBytes, ParseFn&& parse)
+    {
+        constexpr int numRuns = 3;
+        auto fastest = std::numeric_limits<double>::max();
+        int check = 0;
+
+        for (int i = 0; i < numRuns; ++i)
+        {
+            const auto start = Time::getHighResolutionTicks();
+            check += parse();
+            fastest = jmin (fastest, Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - start));
+        }
+
+        jassert (check > 0);
+        return (double) numBytes / fastest / 1.0e6;
+    }
+
+    static MemoryBlock createSession (Random& random)
+    {
+        XmlElement session ("SESSION");
+        session.setAttribute ("sampleRate", 48000);
+        session.setAttribute ("tempo", 120.0);
+
+        for (int t = 0; t < 200; ++t)
+        {
+            auto* track = session.createNewChildElement ("TRACK");
+            track->setAttribute ("name", "Track " + String (t) + " & \"friends\"");
+            track->setAttribute ("colour", String::toHexString (random.nextInt()));
+            track->setAttribute ("volume", random.nextDouble());
+            track->setAttribute ("pan", random.nextDouble() * 2.0 - 1.0);
+
+            for (int c = 0; c < 100; ++c)
+            {
+                auto* clip = track->createNewChildElement ("CLIP");
+                clip->setAttribute ("id", Uuid().toString());
+                clip->setAttribute ("start", random.nextDouble() * 1000.0);
+                clip->setAttribute ("length", random.nextDouble() * 10.0);
+                clip->setAttribute ("file", "Audio/Recording " + String (random.nextInt (1000)) + ".wav");
+                clip->createNewChildElement ("NOTES")->addTextElement ("Take " + String (c) + " <best>");
+            }
+
+            auto* automation = track->createNewChildElement ("AUTOMATION");
+
+            for (int p = 0; p < 500; ++p)
+            {
+                auto* point = automation->createNewChildElement ("POINT");
+                point->setAttribute ("time", p * 0.25);
+                point->setAttribute ("value", random.nextDouble());
+            }
+        }
+
+        MemoryOutputStream out;
+        session.writeTo (out);
+        return out.getMemoryBlock();
+    }
+};
@@ -462,6 +462,669 @@ void AudioDataConverters::deinterleaveSamples (const float* source, float** dest
 }
 
 //==============================================================================
+namespace AudioDataVectorisedHelpers
+{
+    // The per-sample conversions, which handle the ends of blocks and any layouts
+    // that the vector loops don't cover.
+    template <class SampleFormat>
+    static void toFloatScalar (const void* source, int sourceStride, float* dest, int numSamples) noexcept
+    {
+        SampleFormat s (const_cast<void*> (source));
+
+        for (int i = 0; i < numSamples; ++i, s.skip (sourceStride))
+            dest[i] = s.getAsFloatLE();
+    }
+
+    template <class SampleFormat>
+    static void fromFloatScalar (const float* source, void* dest, int destStride, int numSamples) noexcept
+    {
+        SampleFormat d (dest);
+
+        for (int i = 0; i < numSamples; ++i, d.skip (destStride))
+        {
+            if constexpr (SampleFormat::isFloat)
+                d.setAsFloatLE (source[i]);
+            else
+                d.setAsInt32LE (AudioData::Float32 (const_cast<float*> (source + i)).getAsInt32LE());
+        }
+    }
+
+    //==============================================================================
+   #if JUCE_USE_SSE_INTRINSICS
+    // Matches Float32::getAsInt32LE(): the clamping, scaling and rounding are done with
+    // doubles, so that every 32-bit result is exact.
+    static forcedinline __m128i floatToInt32SSE (__m128 v) noexcept
+    {
+        const auto one = _mm_set1_pd (1.0), minusOne = _mm_set1_pd (-1.0), scale = _mm_set1_pd ((double) 0x7fffffff);
+
+        auto lo = _mm_cvtps_pd (v);
+        auto hi = _mm_cvtps_pd (_mm_movehl_ps (v, v));
+        lo = _mm_mul_pd (_mm_max_pd (_mm_min_pd (lo, one), minusOne), scale);
+        hi = _mm_mul_pd (_mm_max_pd (_mm_min_pd (hi, one), minusOne), scale);
+
+        return _mm_unpacklo_epi64 (_mm_cvtpd_epi32 (lo), _mm_cvtpd_epi32 (hi));
+    }
+
+    static int int16ToFloatSSE (const void* source, float* dest, int num) noexcept
+    {
+        auto* src = static_cast<const int16*> (source);
+        const auto scale = _mm_set1_ps (1.0f / 32768.0f);
+        int i = 0;
+
+        for (; i + 8 <= num; i += 8)
+        {
+            const auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i));
+            _mm_storeu_ps (dest + i,     _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (_mm_unpacklo_epi16 (v, v), 16)), scale));
+            _mm_storeu_ps (dest + i + 4, _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (_mm_unpackhi_epi16 (v, v), 16)), scale));
+        }
+
+        return i;
+    }
+
+    static int int32ToFloatSSE (const void* source, float* dest, int num) noexcept
+    {
+        auto* src = static_cast<const int32*> (source);
+        const auto scale = _mm_set1_ps (1.0f / 2147483648.0f);
+        int i = 0;
+
+        for (; i + 4 <= num; i += 4)
+            _mm_storeu_ps (dest + i, _mm_mul_ps (_mm_cvtepi32_ps (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i))), scale));
+
+        return i;
+    }
+
+    static int floatToInt16SSE (const float* src, void* dest, int num) noexcept
+    {
+        auto* d = static_cast<int16*> (dest);
+        int i = 0;
+
+        for (; i + 8 <= num; i += 8)
+        {
+            const auto lo = _mm_srai_epi32 (floatToInt32SSE (_mm_loadu_ps (src + i)), 16);
+            const auto hi = _mm_srai_epi32 (floatToInt32SSE (_mm_loadu_ps (src + i + 4)), 16);
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (d + i), _mm_packs_epi32 (lo, hi));
+        }
+
+        return i;
+    }
+
+    static int floatToInt24SSE (const float* src, void* dest, int num) noexcept
+    {
+        // SSE2 has no byte shuffles, so the samples are packed into 3 bytes one at a time
+        auto* d = static_cast<char*> (dest);
+        int i = 0;
+
+        for (; i + 4 <= num; i += 4)
+        {
+            alignas (16) int32 values[4];
+            _mm_store_si128 (reinterpret_cast<__m128i*> (values), floatToInt32SSE (_mm_loadu_ps (src + i)));
+
+            for (int j = 0; j < 4; ++j)
+                ByteOrder::littleEndian24BitToChars (values[j] >> 8, d + 3 * (i + j));
+        }
+
+        return i;
+    }
+
+    static int floatToInt32SSE (const float* src, void* dest, int num) noexcept
+    {
+        auto* d = static_cast<int32*> (dest);
+        int i = 0;
+
+        for (; i + 4 <= num; i += 4)
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (d + i), floatToInt32SSE (_mm_loadu_ps (src + i)));
+
+        return i;
+    }
+   #endif
+
+    //==============================================================================
+   #if JUCE_USE_AVX2_INTRINSICS
+    JUCE_AVX2_TARGET static forcedinline __m256i floatToInt32AVX (__m256 v) noexcept
+    {
+        const auto one = _mm256_set1_pd (1.0), minusOne = _mm256_set1_pd (-1.0), scale = _mm256_set1_pd ((double) 0x7fffffff);
+
+        auto lo = _mm256_cvtps_pd (_mm256_castps256_ps128 (v));
+        auto hi = _mm256_cvtps_pd (_mm256_extractf128_ps (v, 1));
+        lo = _mm256_mul_pd (_mm256_max_pd (_mm256_min_pd (lo, one), minusOne), scale);
+        hi = _mm256_mul_pd (_mm256_max_pd (_mm256_min_pd (hi, one), minusOne), scale);
+
+        return _mm256_inserti128_si256 (_mm256_castsi128_si256 (_mm256_cvtpd_epi32 (lo)), _mm256_cvtpd_epi32 (hi), 1);
+    }
+
+    JUCE_AVX2_TARGET static int int16ToFloatAVX (const void* source, float* dest, int num) noexcept
+    {
+        auto* src = static_cast<const int16*> (source);
+        const auto scale = _mm256_set1_ps (1.0f / 32768.0f);
+        int i = 0;
+
+        for (; i + 8 <= num; i += 8)
+        {
+            const auto v = _mm256_cvtepi16_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + i)));
+            _mm256_storeu_ps (dest + i, _mm256_mul_ps (_mm256_cvtepi32_ps (v), scale));
+        }
+
+        return i;
+    }
+
+    JUCE_AVX2_TARGET static int int24ToFloatAVX (const void* source, float* dest, int num) noexcept
+    {
+        // Each sample's 3 bytes go into the top of a 32-bit lane, which keeps its sign
+        const auto shuffle = _mm256_setr_epi8 (-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+                                               -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+        const auto scale = _mm256_set1_ps (1.0f / 2147483648.0f);
+        auto* src = static_cast<const char*> (source);
+        int i = 0;
+
+        // The second 16-byte load reads 4 bytes past the last sample in the group,
+        // so stop while there are still at least 2 more samples
+        for (; i + 10 <= num; i += 8)
+        {
+            const auto lo = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + 3 * i));
+            const auto hi = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + 3 * i + 12));
+            const auto v = _mm256_shuffle_epi8 (_mm256_inserti128_si256 (_mm256_castsi128_si256 (lo), hi, 1), shuffle);
+            _mm256_storeu_ps (dest + i, _mm256_mul_ps (_mm256_cvtepi32_ps (v), scale));
+        }
+
+        return i;
+    }
+
+    JUCE_AVX2_TARGET static int int32ToFloatAVX (const void* source, float* dest, int num) noexcept
+    {
+        auto* src = static_cast<const int32*> (source);
+        const auto scale = _mm256_set1_ps (1.0f / 2147483648.0f);
+        int i = 0;
+
+        for (; i + 8 <= num; i += 8)
+            _mm256_storeu_ps (dest + i, _mm256_mul_ps (_mm256_cvtepi32_ps (_mm256_loadu_si256 (reinterpret_cast<const __m256i*> (src + i))), scale));
+
+        return i;
+    }
+
+    JUCE_AVX2_TARGET static int floatToInt16AVX (const float* src, void* dest, int num) noexcept
+    {
+        auto* d = static_cast<int16*> (dest);
+        int i = 0;
+
+        for (; i + 8 <= num; i += 8)
+        {
+            const auto v = _mm256_srai_epi32 (floatToInt32AVX (_mm256_loadu_ps (src + i)), 16);
+            _mm_storeu_si128 (reinterpret_cast<__m128i*> (d + i), _mm_packs_epi32 (_mm256_castsi256_si128 (v), _mm256_extracti128_si256 (v, 1)));
+        }
+
+        return i;
+    }
+
+    JUCE_AVX2_TARGET static int floatToInt24AVX (const float* src, void* dest, int num) noexcept
+    {
+        // Takes the top 3 bytes of each 32-bit lane, packed into the bottom 12 bytes of each half
+        const auto shuffle = _mm256_setr_epi8 (1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, -1, -1, -1, -1,
+                                               1, 2, 3, 5, 6, 7, 9, 10, 11, 13, 14, 15, -1, -1, -1, -1);
+        auto* d = static_cast<char*> (dest);
+        int i = 0;
+
+        for (; i + 8 <= num; i += 8)
+        {
+            const auto v = _mm256_shuffle_epi8 (floatToInt32AVX (_mm256_loadu_ps (src + i)), shuffle);
+
+            for (const auto half : { _mm256_castsi256_si128 (v), _mm256_extracti128_si256 (v, 1) })
+            {
+                _mm_storel_epi64 (reinterpret_cast<__m128i*> (d), half);
+                writeUnaligned<int32> (d + 8, _mm_cvtsi128_si32 (_mm_srli_si128 (half, 8)));
+                d += 12;
+            }
+        }
+
+        return i;
+    }
+
+    JUCE_AVX2_TARGET static int floatToInt32AVX (const float* src, void* dest, int num) noexcept
+    {
+        auto* d = static_cast<int32*> (dest);
+        int i = 0;
+
+        for (; i + 8 <= num; i += 8)
+            _mm256_storeu_si256 (reinterpret_cast<__m256i*> (d + i), floatToInt32AVX (_mm256_loadu_ps (src + i)));
+
+        return i;
+    }
+   #endif
+
+    //==============================================================================
+   #if JUCE_USE_ARM_NEON
+    static int int16ToFloatNEON (const void* source, float* dest, int num) noexcept
+    {
+        auto* src = static_cast<const int16_t*> (source);
+        int i = 0;
+
+        for (; i + 8 <= num; i += 8)
+        {
+            const auto v = vld1q_s16 (src + i);
+            vst1q_f32 (dest + i,     vmulq_n_f32 (vcvtq_f32_s32 (vmovl_s16 (vget_low_s16 (v))),  1.0f / 32768.0f));
+            vst1q_f32 (dest + i + 4, vmulq_n_f32 (vcvtq_f32_s32 (vmovl_s16 (vget_high_s16 (v))), 1.0f / 32768.0f));
+        }
+
+        return i;
+    }
+
+    static int int24ToFloatNEON (const void* source, float* dest, int num) noexcept
+    {
+        auto* src = static_cast<const uint8_t*> (source);
+        int i = 0;
+
+        for (; i + 8 <= num; i += 8)
+        {
+            // Splits 8 samples into their low, middle and high bytes, then builds each
+            // sample in the top 3 bytes of a 32-bit lane, which keeps its sign
+            const auto bytes = vld3_u8 (src + 3 * i);
+            const auto upper = vorrq_u16 (vshll_n_u8 (bytes.val[2], 8), vmovl_u8 (bytes.val[1]));
+            const auto lower = vshll_n_u8 (bytes.val[0], 8);
+
+            const auto lo = vorrq_u32 (vshll_n_u16 (vget_low_u16 (upper), 16),  vmovl_u16 (vget_low_u16 (lower)));
+            const auto hi = vorrq_u32 (vshll_n_u16 (vget_high_u16 (upper), 16), vmovl_u16 (vget_high_u16 (lower)));
+
+            vst1q_f32 (dest + i,     vmulq_n_f32 (vcvtq_f32_s32 (vreinterpretq_s32_u32 (lo)), 1.0f / 2147483648.0f));
+            vst1q_f32 (dest + i + 4, vmulq_n_f32 (vcvtq_f32_s32 (vreinterpretq_s32_u32 (hi)), 1.0f / 2147483648.0f));
+        }
+
+        return i;
+    }
+
+    static int int32ToFloatNEON (const void* source, float* dest, int num) noexcept
+    {
+        auto* src = static_cast<const int32_t*> (source);
+        int i = 0;
+
+        for (; i + 4 <= num; i += 4)
+            vst1q_f32 (dest + i, vmulq_n_f32 (vcvtq_f32_s32 (vld1q_s32 (src + i)), 1.0f / 2147483648.0f));
+
+        return i;
+    }
+
+   #if JUCE_64BIT
+    // Matches Float32::getAsInt32LE() by working in doubles, which needs AArch64
+    static forcedinline int32x4_t floatToInt32NEON (float32x4_t v) noexcept
+    {
+        const auto one = vdupq_n_f64 (1.0), minusOne = vdupq_n_f64 (-1.0);
+
+        auto lo = vcvt_f64_f32 (vget_low_f32 (v));
+        auto hi = vcvt_high_f64_f32 (v);
+        lo = vmulq_n_f64 (vmaxq_f64 (vminq_f64 (lo, one), minusOne), (double) 0x7fffffff);
+        hi = vmulq_n_f64 (vmaxq_f64 (vminq_f64 (hi, one), minusOne), (double) 0x7fffffff);
+
+        return vcombine_s32 (vmovn_s64 (vcvtnq_s64_f64 (lo)), vmovn_s64 (vcvtnq_s64_f64 (hi)));
+    }
+
+    static int floatToInt16NEON (const float* src, void* dest, int num) noexcept
+    {
+        auto* d = static_cast<int16_t*> (dest);
+        int i = 0;
+
+        for (; i + 8 <= num; i += 8)
+        {
+            const auto lo = vshrq_n_s32 (floatToInt32NEON (vld1q_f32 (src + i)), 16);
+            const auto hi = vshrq_n_s32 (floatToInt32NEON (vld1q_f32 (src + i + 4)), 16);
+            vst1q_s16 (d + i, vcombine_s16 (vmovn_s32 (lo), vmovn_s32 (hi)));
+        }
+
+        return i;
+    }
+
+    static int floatToInt24NEON (const float* src, void* dest, int num) noexcept
+    {
+        auto* d = static_cast<char*> (dest);
+        int i = 0;
+
+        for (; i + 4 <= num; i += 4)
+        {
+            int32_t values[4];
+            vst1q_s32 (values, floatToInt32NEON (vld1q_f32 (src + i)));
+
+            for (int j = 0; j < 4; ++j)
+                ByteOrder::littleEndian24BitToChars (values[j] >> 8, d + 3 * (i + j));
+        }
+
+        return i;
+    }
+
+    static int floatToInt32NEON (const float* src, void* dest, int num) noexcept
+    {
+        auto* d = static_cast<int32_t*> (dest);
+        int i = 0;
+
+        for (; i + 4 <= num; i += 4)
+            vst1q_s32 (d + i, floatToInt32NEON (vld1q_f32 (src + i)));
+
+        return i;
+    }
+   #endif
+   #endif
+
+    //==============================================================================
+    static void deinterleaveFloats (const float* source, int numSourceChannels,
+                                    float* const* dest, int numDestChannels, int offset, int numSamples) noexcept
+    {
+        int i = 0;
+
+        if (numSourceChannels == 2 && numDestChannels == 2)
+        {
+            auto* left = dest[0] + offset;
+            auto* right = dest[1] + offset;
+
+           #if JUCE_USE_SSE_INTRINSICS
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                const auto a = _mm_loadu_ps (source + 2 * i);
+                const auto b = _mm_loadu_ps (source + 2 * i + 4);
+                _mm_storeu_ps (left + i,  _mm_shuffle_ps (a, b, _MM_SHUFFLE (2, 0, 2, 0)));
+                _mm_storeu_ps (right + i, _mm_shuffle_ps (a, b, _MM_SHUFFLE (3, 1, 3, 1)));
+            }
+           #elif JUCE_USE_ARM_NEON
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                const auto v = vld2q_f32 (source + 2 * i);
+                vst1q_f32 (left + i,  v.val[0]);
+                vst1q_f32 (right + i, v.val[1]);
+            }
+           #endif
+
+            for (; i < numSamples; ++i)
+            {
+                left[i]  = source[2 * i];
+                right[i] = source[2 * i + 1];
+            }
+
+            return;
+        }
+
+        for (int ch = 0; ch < numDestChannels; ++ch)
+        {
+            auto* d = dest[ch] + offset;
+
+            for (i = 0; i < numSamples; ++i)
+                d[i] = source[i * numSourceChannels + ch];
+        }
+    }
+
+    static void interleaveFloats (const float* const* source, int offset, float* dest,
+                                  int numChannels, int numSamples) noexcept
+    {
+        int i = 0;
+
+        if (numChannels == 2)
+        {
+            auto* left = source[0] + offset;
+            auto* right = source[1] + offset;
+
+           #if JUCE_USE_SSE_INTRINSICS
+            for (; i + 4 <= numSamples; i += 4)
+            {
+                const auto l = _mm_loadu_ps (left + i);
+                const auto r = _mm_loadu_ps (right + i);
+                _mm_storeu_ps (dest + 2 * i,     _mm_unpacklo_ps (l, r));
+                _mm_storeu_ps (dest + 2 * i + 4, _mm_unpackhi_ps (l, r));
+            }
+           #elif JUCE_USE_ARM_NEON
+            for (; i + 4 <= numSamples; i += 4)
+                vst2q_f32 (dest + 2 * i, float32x4x2_t { { vld1q_f32 (left + i), vld1q_f32 (right + i) } });
+           #endif
+
+            for (; i < numSamples; ++i)
+            {
+                dest[2 * i]     = left[i];
+                dest[2 * i + 1] = right[i];
+            }
+
+            return;
+        }
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* s = source[ch] + offset;
+
+            for (i = 0; i < numSamples; ++i)
+                dest[i * numChannels + ch] = s[i];
+        }
+    }
+
+    // Interleaved data is converted in blocks of this many samples, which are small enough
+    // to stay in the cache while they're being split into, or gathered from, the channels.
+    constexpr int blockSize = 1024;
+}
+
+//==============================================================================
+static int getBytesPerSample (AudioData::Vectorised::Format format) noexcept
+{
+    using Format = AudioData::Vectorised::Format;
+
+    switch (format)
+    {
+        case Format::i16:       return 2;
+        case Format::i24:       return 3;
+        case Format::i32:       return 4;
+        case Format::f32:       return 4;
+        case Format::none:      break;
+    }
+
+    jassertfalse;
+    return 0;
+}
+
+static void toFloatStrided (AudioData::Vectorised::Format format, const void* source, int sourceStride, float* dest, int numSamples) noexcept
+{
+    using namespace AudioDataVectorisedHelpers;
+    using Format = AudioData::Vectorised::Format;
+
+    switch (format)
+    {
+        case Format::i16:       toFloatScalar<AudioData::Int16>   (source, sourceStride, dest, numSamples); break;
+        case Format::i24:       toFloatScalar<AudioData::Int24>   (source, sourceStride, dest, numSamples); break;
+        case Format::i32:       toFloatScalar<AudioData::Int32>   (source, sourceStride, dest, numSamples); break;
+        case Format::f32:       toFloatScalar<AudioData::Float32> (source, sourceStride, dest, numSamples); break;
+        case Format::none:      jassertfalse; break;
+    }
+}
+
+static void fromFloatStrided (AudioData::Vectorised::Format format, const float* source, void* dest, int destStride, int numSamples) noexcept
+{
+    using namespace AudioDataVectorisedHelpers;
+    using Format = AudioData::Vectorised::Format;
+
+    switch (format)
+    {
+        case Format::i16:       fromFloatScalar<AudioData::Int16>   (source, dest, destStride, numSamples); break;
+        case Format::i24:       fromFloatScalar<AudioData::Int24>   (source, dest, destStride, numSamples); break;
+        case Format::i32:       fromFloatScalar<AudioData::Int32>   (source, dest, destStride, numSamples); break;
+        case Format::f32:       fromFloatScalar<AudioData::Float32> (source, dest, destStride, numSamples); break;
+        case Format::none:      jassertfalse; break;
+    }
+}
+
+void AudioData::Vectorised::toFloat (Format sourceFormat, const void* source, float* dest, int numSamples) noexcept
+{
+    using namespace AudioDataVectorisedHelpers;
+
+    if (numSamples <= 0)
+        return;
+
+    if (sourceFormat == Format::f32)
+    {
+        memmove (dest, source, (size_t) numSamples * sizeof (float));
+        return;
+    }
+
+    int done = 0;
+
+   #if JUCE_USE_AVX2_INTRINSICS
+    if (detail::canUseAVX2())
+    {
+        switch (sourceFormat)
+        {
+            case Format::i16:       done = int16ToFloatAVX (source, dest, numSamples); break;
+            case Format::i24:       done = int24ToFloatAVX (source, dest, numSamples); break;
+            case Format::i32:       done = int32ToFloatAVX (source, dest, numSamples); break;
+            case Format::f32:
+            case Format::none:      break;
+        }
+    }
+    else
+   #endif
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        switch (sourceFormat)
+        {
+            case Format::i16:       done = int16ToFloatSSE (source, dest, numSamples); break;
+            case Format::i32:       done = int32ToFloatSSE (source, dest, numSamples); break;
+            case Format::i24:
+            case Format::f32:
+            case Format::none:      break;
+        }
+       #elif JUCE_USE_ARM_NEON
+        switch (sourceFormat)
+        {
+            case Format::i16:       done = int16ToFloatNEON (source, dest, numSamples); break;
+            case Format::i24:       done = int24ToFloatNEON (source, dest, numSamples); break;
+            case Format::i32:       done = int32ToFloatNEON (source, dest, numSamples); break;
+            case Format::f32:
+            case Format::none:      break;
+        }
+       #endif
+    }
+
+    toFloatStrided (sourceFormat, addBytesToPointer (source, done * getBytesPerSample (sourceFormat)), 1, dest + done, numSamples - done);
+}
+
+void AudioData::Vectorised::fromFloat (Format destFormat, const float* source, void* dest, int numSamples) noexcept
+{
+    using namespace AudioDataVectorisedHelpers;
+
+    if (numSamples <= 0)
+        return;
+
+    if (destFormat == Format::f32)
+    {
+        memmove (dest, source, (size_t) numSamples * sizeof (float));
+        return;
+    }
+
+    int done = 0;
+
+   #if JUCE_USE_AVX2_INTRINSICS
+    if (detail::canUseAVX2())
+    {
+        switch (destFormat)
+        {
+            case Format::i16:       done = floatToInt16AVX (source, dest, numSamples); break;
+            case Format::i24:       done = floatToInt24AVX (source, dest, numSamples); break;
+            case Format::i32:       done = floatToInt32AVX (source, dest, numSamples); break;
+            case Format::f32:
+            case Format::none:      break;
+        }
+    }
+    else
+   #endif
+    {
+       #if JUCE_USE_SSE_INTRINSICS
+        switch (destFormat)
+        {
+            case Format::i16:       done = floatToInt16SSE (source, dest, numSamples); break;
+            case Format::i24:       done = floatToInt24SSE (source, dest, numSamples); break;
+            case Format::i32:       done = floatToInt32SSE (source, dest, numSamples); break;
+            case Format::f32:
+            case Format::none:      break;
+        }
+       #elif JUCE_USE_ARM_NEON && JUCE_64BIT
+        switch (destFormat)
+        {
+            case Format::i16:       done = floatToInt16NEON (source, dest, numSamples); break;
+            case Format::i24:       done = floatToInt24NEON (source, dest, numSamples); break;
+            case Format::i32:       done = floatToInt32NEON (source, dest, numSamples); break;
+            case Format::f32:
+            case Format::none:      break;
+        }
+       #endif
+    }
+
+    fromFloatStrided (destFormat, source + done, addBytesToPointer (dest, done * getBytesPerSample (destFormat)), 1, numSamples - done);
+}
+
+void AudioData::Vectorised::deinterleaveToFloat (Format sourceFormat, const void* source, int numSourceChannels,
+                                                 float* const* dest, int numDestChannels, int numSamples) noexcept
+{
+    using namespace AudioDataVectorisedHelpers;
+
+    jassert (numDestChannels <= numSourceChannels);
+
+    if (numSamples <= 0 || numDestChannels <= 0)
+        return;
+
+    if (numSourceChannels == 1)
+    {
+        toFloat (sourceFormat, source, dest[0], numSamples);
+        return;
+    }
+
+    const auto bytesPerSample = getBytesPerSample (sourceFormat);
+    const auto framesPerBlock = blockSize / numSourceChannels;
+
+    if (framesPerBlock < 4)
+    {
+        for (int ch = 0; ch < numDestChannels; ++ch)
+            toFloatStrided (sourceFormat, addBytesToPointer (source, ch * bytesPerSample), numSourceChannels, dest[ch], numSamples);
+
+        return;
+    }
+
+    alignas (32) float block[blockSize];
+
+    for (int start = 0; start < numSamples; start += framesPerBlock)
+    {
+        const auto numFrames = jmin (framesPerBlock, numSamples - start);
+
+        toFloat (sourceFormat, addBytesToPointer (source, start * numSourceChannels * bytesPerSample), block, numFrames * numSourceChannels);
+        deinterleaveFloats (block, numSourceChannels, dest, numDestChannels, start, numFrames);
+    }
+}
+
+void AudioData::Vectorised::interleaveFromFloat (Format destFormat, const float* const* source, int numSourceChannels,
+                                                 void* dest, int numDestChannels, int numSamples) noexcept
+{
+    using namespace AudioDataVectorisedHelpers;
+
+    jassert (numSourceChannels <= numDestChannels);
+
+    if (numSamples <= 0 || numSourceChannels <= 0)
+        return;
+
+    if (numDestChannels == 1)
+    {
+        fromFloat (destFormat, source[0], dest, numSamples);
+        return;
+    }
+
+    const auto bytesPerSample = getBytesPerSample (destFormat);
+    const auto framesPerBlock = blockSize / numDestChannels;
+
+    // Converting whole frames would overwrite any sub-channels that aren't being written to
+    if (numSourceChannels < numDestChannels || framesPerBlock < 4)
+    {
+        for (int ch = 0; ch < numSourceChannels; ++ch)
+            fromFloatStrided (destFormat, source[ch], addBytesToPointer (dest, ch * bytesPerSample), numDestChannels, numSamples);
+
+        return;
+    }
+
+    alignas (32) float block[blockSize];
+
+    for (int start = 0; start < numSamples; start += framesPerBlock)
+    {
+        const auto numFrames = jmin (framesPerBlock, numSamples - start);
+
+        interleaveFloats (source, start, block, numDestChannels, numFrames);
+        fromFloat (destFormat, block, addBytesToPointer (dest, start * numDestChannels * bytesPerSample), numFrames * numDestChannels);
+    }
+}
+
 //==============================================================================
 #if JUCE_UNIT_TESTS
 
@@ -576,6 +1239,157 @@ public:
         }
     };
 
+    //==============================================================================
+    // Interleaved pointers with a single channel never take the vectorised paths, so they
+    // give the per-sample results to compare against.
+    template <class SampleFormat>
+    struct VectorisedTest
+    {
+        using Bytes = std::vector<char>;
+        using Floats = std::vector<float>;
+
+        template <class Interleaving, class Constness>
+        using Packed = AudioData::Pointer<SampleFormat, AudioData::LittleEndian, Interleaving, Constness>;
+
+        template <class Interleaving, class Constness>
+        using Native = AudioData::Pointer<AudioData::Float32, AudioData::NativeEndian, Interleaving, Constness>;
+
+        static constexpr int bytesPerSample = SampleFormat::bytesPerSample;
+
+        static Bytes makePacked (Random& r, int numSamples)
+        {
+            Bytes result ((size_t) (numSamples * bytesPerSample));
+
+            Packed<AudioData::NonInterleaved, AudioData::NonConst> p (result.data());
+
+            for (int i = 0; i < numSamples; ++i, ++p)
+            {
+                if (SampleFormat::isFloat)
+                    p.setAsFloat (r.nextFloat() * 2.4f - 1.2f);
+                else
+                    p.setAsInt32 (r.nextInt());
+            }
+
+            return result;
+        }
+
+        static Floats makeFloats (Random& r, int numSamples)
+        {
+            Floats result ((size_t) numSamples);
+
+            for (auto& f : result)
+                f = r.nextFloat() * 2.4f - 1.2f;
+
+            // Make sure that the clipping points and the rounding boundaries are covered
+            const float specialValues[] { 1.0f, -1.0f, 0.0f, -0.0f, 1.0f / 65536.0f, -1.5f / 65536.0f, 0.5f / 8388608.0f };
+
+            for (size_t i = 0; i < std::size (specialValues) && i * 3 < result.size(); ++i)
+                result[i * 3] = specialValues[i];
+
+            return result;
+        }
+
+        static void test (UnitTest& u, Random& r)
+        {
+            for (const auto numSamples : { 0, 1, 7, 8, 9, 10, 17, 1037 })
+            {
+                {
+                    const auto source = makePacked (r, numSamples);
+                    Floats expected ((size_t) numSamples), actual ((size_t) numSamples);
+
+                    Native<AudioData::Interleaved, AudioData::NonConst> (expected.data(), 1).convertSamples (Packed<AudioData::Interleaved, AudioData::Const> (source.data(), 1), numSamples);
+                    Native<AudioData::NonInterleaved, AudioData::NonConst> (actual.data()).convertSamples (Packed<AudioData::NonInterleaved, AudioData::Const> (source.data()), numSamples);
+
+                    u.expect (expected == actual);
+                }
+
+                {
+                    const auto source = makeFloats (r, numSamples);
+                    Bytes expected ((size_t) (numSamples * bytesPerSample)), actual (expected.size());
+
+                    Packed<AudioData::Interleaved, AudioData::NonConst> (expected.data(), 1).convertSamples (Native<AudioData::Interleaved, AudioData::Const> (source.data(), 1), numSamples);
+                    Packed<AudioData::NonInterleaved, AudioData::NonConst> (actual.data()).convertSamples (Native<AudioData::NonInterleaved, AudioData::Const> (source.data()), numSamples);
+
+                    u.expect (expected == actual);
+
+                    // Converting in place only works when the samples get narrower
+                    auto inPlace = source;
+                    Packed<AudioData::NonInterleaved, AudioData::NonConst> (inPlace.data()).convertSamples (Native<AudioData::NonInterleaved, AudioData::Const> (inPlace.data()), numSamples);
+                    u.expect (std::memcmp (inPlace.data(), expected.data(), expected.size()) == 0);
+                }
+            }
+
+            for (const auto numChannels : { 1, 2, 3, 6 })
+            {
+                const auto numSamples = 2500;
+                AudioBuffer<float> expected (numChannels, numSamples), actual (numChannels, numSamples);
+
+                using Converter = AudioData::ConverterInstance<Packed<AudioData::Interleaved, AudioData::Const>,
+                                                               Native<AudioData::NonInterleaved, AudioData::NonConst>>;
+                const Converter converter (numChannels, 1);
+                const auto interleaved = makePacked (r, numSamples * numChannels);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    converter.convertSamples (expected.getWritePointer (ch), 0, interleaved.data(), ch, numSamples);
+
+                // Leave out the last channel, to check that channels can be skipped
+                actual.clear();
+                converter.deinterleaveSamples (reinterpret_cast<void* const*> (actual.getArrayOfWritePointers()), interleaved.data(), numChannels - 1, numSamples);
+
+                for (int ch = 0; ch < numChannels - 1; ++ch)
+                    u.expect (std::equal (expected.getReadPointer (ch), expected.getReadPointer (ch) + numSamples, actual.getReadPointer (ch)));
+
+                AudioData::deinterleaveSamples (AudioData::InterleavedSource<AudioData::Format<SampleFormat, AudioData::LittleEndian>> { reinterpret_cast<const typename VectorisedTest::Element*> (interleaved.data()), numChannels },
+                                                AudioData::NonInterleavedDest<AudioData::Format<AudioData::Float32, AudioData::NativeEndian>> { actual.getArrayOfWritePointers(), numChannels },
+                                                numSamples);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    u.expect (std::equal (expected.getReadPointer (ch), expected.getReadPointer (ch) + numSamples, actual.getReadPointer (ch)));
+            }
+
+            for (const auto numChannels : { 1, 2, 3, 6 })
+            {
+                const auto numSamples = 2500;
+                AudioBuffer<float> source (numChannels, numSamples);
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    const auto floats = makeFloats (r, numSamples);
+                    source.copyFrom (ch, 0, floats.data(), numSamples);
+                }
+
+                using Converter = AudioData::ConverterInstance<Native<AudioData::NonInterleaved, AudioData::Const>,
+                                                               Packed<AudioData::Interleaved, AudioData::NonConst>>;
+                const Converter converter (1, numChannels);
+                const auto original = makePacked (r, numSamples * numChannels);
+                auto expected = original, actual = original;
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    converter.convertSamples (expected.data(), ch, source.getReadPointer (ch), 0, numSamples);
+
+                converter.interleaveSamples (actual.data(), reinterpret_cast<const void* const*> (source.getArrayOfReadPointers()), numChannels, numSamples);
+                u.expect (expected == actual);
+
+                // Any sub-channels that aren't written to must be left alone
+                auto partial = original;
+                converter.interleaveSamples (partial.data(), reinterpret_cast<const void* const*> (source.getArrayOfReadPointers()), numChannels - 1, numSamples);
+
+                for (int i = 0; i < numSamples * numChannels; ++i)
+                {
+                    const auto& reference = (i % numChannels) == numChannels - 1 ? original : expected;
+                    u.expect (std::memcmp (partial.data() + i * bytesPerSample, reference.data() + i * bytesPerSample, (size_t) bytesPerSample) == 0);
+                }
+
+                AudioData::interleaveSamples (AudioData::NonInterleavedSource<AudioData::Format<AudioData::Float32, AudioData::NativeEndian>> { source.getArrayOfReadPointers(), numChannels },
+                                              AudioData::InterleavedDest<AudioData::Format<SampleFormat, AudioData::LittleEndian>> { reinterpret_cast<typename VectorisedTest::Element*> (actual.data()), numChannels },
+                                              numSamples);
+                u.expect (expected == actual);
+            }
+        }
+
+        using Element = std::remove_pointer_t<decltype (SampleFormat::data)>;
+    };
+
     void runTest() override
     {
         auto r = getRandom();
@@ -633,6 +1447,14 @@ public:
                 for (int i = 0; i < numSamples; ++i)
                     expectEquals (sourceBuffer.getSample (0, ch + (i * numChannels)), destBuffer.getSample (ch, i));
         }
+
+        beginTest ("Vectorised conversions match the per-sample conversions");
+        {
+            VectorisedTest<AudioData::Int16>::test (*this, r);
+            VectorisedTest<AudioData::Int24>::test (*this, r);
+            VectorisedTest<AudioData::Int32>::test (*this, r);
+            VectorisedTest<AudioData::Float32>::test (*this, r);
+        }
     }
 };
 
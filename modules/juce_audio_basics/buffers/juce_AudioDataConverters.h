@@ -476,6 +476,9 @@ public:
             // trying to write to a const pointer! For a writeable one, use AudioData::NonConst instead!
             static_assert (Constness::isConst == 0, "Attempt to write to a const pointer");
 
+            if (Vectorised::convert (*this, source, numSamples))
+                return;
+
             Pointer dest (*this);
 
             if (source.getRawData() != getRawData() || source.getNumBytesBetweenSamples() >= getNumBytesBetweenSamples())
@@ -613,6 +616,32 @@ public:
         */
         virtual void convertSamples (void* destSamples, int destSubChannel,
                                      const void* sourceSamples, int sourceSubChannel, int numSamples) const = 0;
+
+        /** Converts the first numChannels sub-channels of an interleaved block of source samples into
+            separate destination channels.
+
+            This does the same as calling convertSamples (destChannels[i], 0, sourceSamples, i, numSamples)
+            for each channel, but lets the converter work through the interleaved data in a single pass.
+        */
+        virtual void deinterleaveSamples (void* const* destChannels, const void* sourceSamples,
+                                          int numChannels, int numSamples) const
+        {
+            for (int i = 0; i < numChannels; ++i)
+                convertSamples (destChannels[i], 0, sourceSamples, i, numSamples);
+        }
+
+        /** Converts a number of separate source channels into the first numChannels sub-channels of an
+            interleaved block of destination samples.
+
+            This does the same as calling convertSamples (destSamples, i, sourceChannels[i], 0, numSamples)
+            for each channel, but lets the converter work through the interleaved data in a single pass.
+        */
+        virtual void interleaveSamples (void* destSamples, const void* const* sourceChannels,
+                                        int numChannels, int numSamples) const
+        {
+            for (int i = 0; i < numChannels; ++i)
+                convertSamples (destSamples, i, sourceChannels[i], 0, numSamples);
+        }
     };
 
     //==============================================================================
@@ -649,6 +678,34 @@ public:
             d.convertSamples (s, numSamples);
         }
 
+        void deinterleaveSamples (void* const* destBuffers, const void* source,
+                                  int numChannels, int numSamples) const override
+        {
+            jassert (numChannels <= sourceChannels);
+
+            using Traits = Vectorised::Traits<SourceSampleType, DestSampleType>;
+
+            if constexpr (Traits::canDeinterleave)
+                Vectorised::deinterleaveToFloat (Traits::sourceFormat, source, sourceChannels,
+                                                 reinterpret_cast<float* const*> (destBuffers), numChannels, numSamples);
+            else
+                Converter::deinterleaveSamples (destBuffers, source, numChannels, numSamples);
+        }
+
+        void interleaveSamples (void* dest, const void* const* sourceBuffers,
+                                int numChannels, int numSamples) const override
+        {
+            jassert (numChannels <= destChannels);
+
+            using Traits = Vectorised::Traits<SourceSampleType, DestSampleType>;
+
+            if constexpr (Traits::canInterleave)
+                Vectorised::interleaveFromFloat (Traits::destFormat, reinterpret_cast<const float* const*> (sourceBuffers),
+                                                 numChannels, dest, destChannels, numSamples);
+            else
+                Converter::interleaveSamples (dest, sourceBuffers, numChannels, numSamples);
+        }
+
     private:
         JUCE_DECLARE_NON_COPYABLE (ConverterInstance)
 
@@ -739,6 +796,22 @@ public:
         using SourceType = typename decltype (source)::PointerType;
         using DestType   = typename decltype (dest)  ::PointerType;
 
+        if constexpr (Vectorised::Traits<SourceType, DestType>::canInterleave)
+        {
+            const auto numToConvert = jmin (source.channels, dest.channels);
+
+            if (std::all_of (source.data, source.data + numToConvert, [] (auto* c) { return c != nullptr; }))
+            {
+                Vectorised::interleaveFromFloat (Vectorised::Traits<SourceType, DestType>::destFormat, source.data, numToConvert,
+                                                 dest.data, dest.channels, numSamples);
+
+                for (int i = numToConvert; i < dest.channels; ++i)
+                    DestType (addBytesToPointer (dest.data, i * DestType::getBytesPerSample()), dest.channels).clearSamples (numSamples);
+
+                return;
+            }
+        }
+
         for (int i = 0; i < dest.channels; ++i)
         {
             const DestType destType (addBytesToPointer (dest.data, i * DestType::getBytesPerSample()), dest.channels);
@@ -783,6 +856,23 @@ public:
         using SourceType = typename decltype (source)::PointerType;
         using DestType   = typename decltype (dest)  ::PointerType;
 
+        if constexpr (Vectorised::Traits<SourceType, DestType>::canDeinterleave)
+        {
+            const auto numToConvert = jmin (source.channels, dest.channels);
+
+            if (std::all_of (dest.data, dest.data + numToConvert, [] (auto* c) { return c != nullptr; }))
+            {
+                Vectorised::deinterleaveToFloat (Vectorised::Traits<SourceType, DestType>::sourceFormat, source.data, source.channels,
+                                                 dest.data, numToConvert, numSamples);
+
+                for (int i = numToConvert; i < dest.channels; ++i)
+                    if (auto* targetChan = dest.data[i])
+                        DestType (targetChan).clearSamples (numSamples);
+
+                return;
+            }
+        }
+
         for (int i = 0; i < dest.channels; ++i)
         {
             if (auto* targetChan = dest.data[i])
@@ -796,6 +886,108 @@ public:
             }
         }
     }
+
+   #ifndef DOXYGEN
+    //==============================================================================
+    /*  Vectorised versions of the most common conversions, between native floats and
+        little-endian Int16, Int24, Int32 and Float32 data.
+
+        Pointer::convertSamples(), interleaveSamples(), deinterleaveSamples() and ConverterInstance
+        use these whenever the formats allow it. They produce exactly the same results as the
+        per-sample conversions.
+    */
+    struct Vectorised
+    {
+        enum class Format { none, i16, i24, i32, f32 };
+
+        template <class SampleFormat, class Endianness>
+        static constexpr Format getFormat() noexcept
+        {
+           #if JUCE_BIG_ENDIAN
+            return Format::none;
+           #else
+            if constexpr (! std::is_base_of_v<LittleEndian, Endianness>)   return Format::none;
+            else if constexpr (std::is_same_v<SampleFormat, Int16>)        return Format::i16;
+            else if constexpr (std::is_same_v<SampleFormat, Int24>)        return Format::i24;
+            else if constexpr (std::is_same_v<SampleFormat, Int32>)        return Format::i32;
+            else if constexpr (std::is_same_v<SampleFormat, Float32>)      return Format::f32;
+            else                                                           return Format::none;
+           #endif
+        }
+
+        template <class PointerType>
+        struct PointerTraits;
+
+        template <class SampleFormat, class Endianness, class InterleavingType, class Constness>
+        struct PointerTraits<Pointer<SampleFormat, Endianness, InterleavingType, Constness>>
+        {
+            static constexpr auto format = getFormat<SampleFormat, Endianness>();
+            static constexpr bool isInterleaved = InterleavingType::isInterleavedType != 0;
+        };
+
+        template <class SourcePointer, class DestPointer>
+        struct Traits
+        {
+            static constexpr auto sourceFormat = PointerTraits<SourcePointer>::format;
+            static constexpr auto destFormat   = PointerTraits<DestPointer>::format;
+
+            static constexpr bool isToFloat   = destFormat   == Format::f32 && sourceFormat != Format::none;
+            static constexpr bool isFromFloat = sourceFormat == Format::f32 && destFormat   != Format::none;
+
+            static constexpr bool canConvert      = (isToFloat || isFromFloat)
+                                                     && ! PointerTraits<SourcePointer>::isInterleaved
+                                                     && ! PointerTraits<DestPointer>::isInterleaved;
+            static constexpr bool canDeinterleave = isToFloat
+                                                     && PointerTraits<SourcePointer>::isInterleaved
+                                                     && ! PointerTraits<DestPointer>::isInterleaved;
+            static constexpr bool canInterleave   = isFromFloat
+                                                     && ! PointerTraits<SourcePointer>::isInterleaved
+                                                     && PointerTraits<DestPointer>::isInterleaved;
+        };
+
+        static void toFloat (Format sourceFormat, const void* source, float* dest, int numSamples) noexcept;
+        static void fromFloat (Format destFormat, const float* source, void* dest, int numSamples) noexcept;
+
+        static void deinterleaveToFloat (Format sourceFormat, const void* source, int numSourceChannels,
+                                         float* const* dest, int numDestChannels, int numSamples) noexcept;
+        static void interleaveFromFloat (Format destFormat, const float* const* source, int numSourceChannels,
+                                         void* dest, int numDestChannels, int numSamples) noexcept;
+
+        /*  Returns true if the conversion was handled. Converting in place is only possible
+            when the samples don't get any wider, as the vectorised loops run forwards.
+        */
+        template <class DestPointer, class SourcePointer>
+        static bool convert (const DestPointer& dest, const SourcePointer& source, int numSamples) noexcept
+        {
+            using T = Traits<SourcePointer, DestPointer>;
+
+            if constexpr (T::canConvert)
+            {
+                const auto* d = static_cast<const char*> (dest.getRawData());
+                const auto* s = static_cast<const char*> (source.getRawData());
+                const auto destBytes   = DestPointer::getBytesPerSample();
+                const auto sourceBytes = SourcePointer::getBytesPerSample();
+
+                const auto overlaps = d < s + sourceBytes * numSamples && s < d + destBytes * numSamples;
+
+                if (overlaps && ! (d == s && destBytes <= sourceBytes))
+                    return false;
+
+                if constexpr (T::isToFloat)
+                    toFloat (T::sourceFormat, s, reinterpret_cast<float*> (const_cast<char*> (d)), numSamples);
+                else
+                    fromFloat (T::destFormat, reinterpret_cast<const float*> (s), const_cast<char*> (d), numSamples);
+
+                return true;
+            }
+            else
+            {
+                ignoreUnused (dest, source, numSamples);
+                return false;
+            }
+        }
+    };
+   #endif
 };
 
 //==============================================================================
@@ -37,9 +37,9 @@ namespace juce
 
 namespace FloatVectorHelpers
 {
-    #define JUCE_INCREMENT_SRC_DEST         dest += (16 / sizeof (*dest)); src += (16 / sizeof (*dest));
-    #define JUCE_INCREMENT_SRC1_SRC2_DEST   dest += (16 / sizeof (*dest)); src1 += (16 / sizeof (*dest)); src2 += (16 / sizeof (*dest));
-    #define JUCE_INCREMENT_DEST             dest += (16 / sizeof (*dest));
+    #define JUCE_INCREMENT_SRC_DEST         dest += Mode::numParallel; src += Mode::numParallel;
+    #define JUCE_INCREMENT_SRC1_SRC2_DEST   dest += Mode::numParallel; src1 += Mode::numParallel; src2 += Mode::numParallel;
+    #define JUCE_INCREMENT_DEST             dest += Mode::numParallel;
 
    #if JUCE_USE_SSE_INTRINSICS
     static bool isAligned (const void* p) noexcept
@@ -503,6 +503,306 @@ namespace FloatVectorHelpers
     };
    #endif
 
+   #if JUCE_USE_AVX2_INTRINSICS
+    //==============================================================================
+    /*  AVX2 versions of the most heavily-used operations.
+
+        Rather than requiring the whole module to be built with -mavx2, these functions are
+        individually compiled for AVX2, and are only called when the CPU that we're running on
+        reports that it supports the instruction set. The results are bit-for-bit identical to
+        the SSE versions - in particular, FMA instructions are deliberately not used, so that a
+        plugin renders exactly the same output regardless of which machine it's running on.
+    */
+    struct AVXOps32
+    {
+        using Type = float;
+        using ParallelType = __m256;
+        enum { numParallel = 8 };
+
+        JUCE_AVX2_TARGET static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm256_set1_ps (v); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_ps (v); }
+        JUCE_AVX2_TARGET static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_ps (dest, a); }
+
+        JUCE_AVX2_TARGET static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_ps (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_ps (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_ps (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_ps (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_ps (a, b); }
+
+        JUCE_AVX2_TARGET static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (jmax (v[0], v[1], v[2], v[3]), jmax (v[4], v[5], v[6], v[7])); }
+        JUCE_AVX2_TARGET static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (jmin (v[0], v[1], v[2], v[3]), jmin (v[4], v[5], v[6], v[7])); }
+    };
+
+    struct AVXOps64
+    {
+        using Type = double;
+        using ParallelType = __m256d;
+        enum { numParallel = 4 };
+
+        JUCE_AVX2_TARGET static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm256_set1_pd (v); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_pd (v); }
+        JUCE_AVX2_TARGET static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_pd (dest, a); }
+
+        JUCE_AVX2_TARGET static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_pd (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_pd (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_pd (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_pd (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_pd (a, b); }
+
+        JUCE_AVX2_TARGET static forcedinline Type max (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmax (v[0], v[1], v[2], v[3]); }
+        JUCE_AVX2_TARGET static forcedinline Type min (ParallelType a) noexcept { Type v[numParallel]; storeU (v, a); return jmin (v[0], v[1], v[2], v[3]); }
+    };
+
+    template <int typeSize> struct AVXModeType    { using Mode = AVXOps32; };
+    template <>             struct AVXModeType<8> { using Mode = AVXOps64; };
+
+    // Unaligned loads and stores are no slower than aligned ones on any CPU that supports
+    // AVX2, so unlike the SSE versions, these don't bother checking the pointer alignment.
+    #define JUCE_BEGIN_AVX_OP \
+        using Mode = FloatVectorHelpers::AVXModeType<sizeof(*dest)>::Mode; \
+        { \
+            const auto numLongOps = num / Mode::numParallel;
+
+    #define JUCE_PERFORM_AVX_OP_DEST(normalOp, vecOp, locals, setupOp) \
+        JUCE_BEGIN_AVX_OP \
+        setupOp \
+        JUCE_VEC_LOOP (vecOp, dummy, Mode::loadU, Mode::storeU, locals, JUCE_INCREMENT_DEST) \
+        JUCE_FINISH_VEC_OP (normalOp)
+
+    #define JUCE_PERFORM_AVX_OP_SRC_DEST(normalOp, vecOp, locals, increment, setupOp) \
+        JUCE_BEGIN_AVX_OP \
+        setupOp \
+        JUCE_VEC_LOOP (vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
+        JUCE_FINISH_VEC_OP (normalOp)
+
+    #define JUCE_PERFORM_AVX_OP_SRC1_SRC2_DEST(normalOp, vecOp, locals, increment, setupOp) \
+        JUCE_BEGIN_AVX_OP \
+        setupOp \
+        JUCE_VEC_LOOP_TWO_SOURCES (vecOp, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
+        JUCE_FINISH_VEC_OP (normalOp)
+
+    #define JUCE_PERFORM_AVX_OP_SRC1_SRC2_DEST_DEST(normalOp, vecOp, locals, increment, setupOp) \
+        JUCE_BEGIN_AVX_OP \
+        setupOp \
+        JUCE_VEC_LOOP_TWO_SOURCES_WITH_DEST_LOAD (vecOp, Mode::loadU, Mode::loadU, Mode::loadU, Mode::storeU, locals, increment) \
+        JUCE_FINISH_VEC_OP (normalOp)
+
+    #define JUCE_DISPATCH_TO_AVX2(functionCall) \
+        if (detail::canUseAVX2()) \
+            return FloatVectorHelpers::AVX2::functionCall;
+
+    namespace AVX2
+    {
+        template <typename Size>
+        JUCE_AVX2_TARGET void copyWithMultiply (float* dest, const float* src, float multiplier, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC_DEST (dest[i] = src[i] * multiplier,
+                                          Mode::mul (mult, s),
+                                          JUCE_LOAD_SRC,
+                                          JUCE_INCREMENT_SRC_DEST,
+                                          const Mode::ParallelType mult = Mode::load1 (multiplier);)
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void copyWithMultiply (double* dest, const double* src, double multiplier, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC_DEST (dest[i] = src[i] * multiplier,
+                                          Mode::mul (mult, s),
+                                          JUCE_LOAD_SRC,
+                                          JUCE_INCREMENT_SRC_DEST,
+                                          const Mode::ParallelType mult = Mode::load1 (multiplier);)
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void add (float* dest, const float* src, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC_DEST (dest[i] += src[i],
+                                          Mode::add (d, s),
+                                          JUCE_LOAD_SRC_DEST,
+                                          JUCE_INCREMENT_SRC_DEST, )
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void add (double* dest, const double* src, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC_DEST (dest[i] += src[i],
+                                          Mode::add (d, s),
+                                          JUCE_LOAD_SRC_DEST,
+                                          JUCE_INCREMENT_SRC_DEST, )
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void add (float* dest, const float* src1, const float* src2, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
+                                                Mode::add (s1, s2),
+                                                JUCE_LOAD_SRC1_SRC2,
+                                                JUCE_INCREMENT_SRC1_SRC2_DEST, )
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void add (double* dest, const double* src1, const double* src2, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
+                                                Mode::add (s1, s2),
+                                                JUCE_LOAD_SRC1_SRC2,
+                                                JUCE_INCREMENT_SRC1_SRC2_DEST, )
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void subtract (float* dest, const float* src, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC_DEST (dest[i] -= src[i],
+                                          Mode::sub (d, s),
+                                          JUCE_LOAD_SRC_DEST,
+                                          JUCE_INCREMENT_SRC_DEST, )
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void subtract (double* dest, const double* src, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC_DEST (dest[i] -= src[i],
+                                          Mode::sub (d, s),
+                                          JUCE_LOAD_SRC_DEST,
+                                          JUCE_INCREMENT_SRC_DEST, )
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void addWithMultiply (float* dest, const float* src, float multiplier, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC_DEST (dest[i] += src[i] * multiplier,
+                                          Mode::add (d, Mode::mul (mult, s)),
+                                          JUCE_LOAD_SRC_DEST,
+                                          JUCE_INCREMENT_SRC_DEST,
+                                          const Mode::ParallelType mult = Mode::load1 (multiplier);)
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void addWithMultiply (double* dest, const double* src, double multiplier, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC_DEST (dest[i] += src[i] * multiplier,
+                                          Mode::add (d, Mode::mul (mult, s)),
+                                          JUCE_LOAD_SRC_DEST,
+                                          JUCE_INCREMENT_SRC_DEST,
+                                          const Mode::ParallelType mult = Mode::load1 (multiplier);)
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void addWithMultiply (float* dest, const float* src1, const float* src2, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
+                                                     Mode::add (d, Mode::mul (s1, s2)),
+                                                     JUCE_LOAD_SRC1_SRC2_DEST,
+                                                     JUCE_INCREMENT_SRC1_SRC2_DEST, )
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void addWithMultiply (double* dest, const double* src1, const double* src2, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
+                                                     Mode::add (d, Mode::mul (s1, s2)),
+                                                     JUCE_LOAD_SRC1_SRC2_DEST,
+                                                     JUCE_INCREMENT_SRC1_SRC2_DEST, )
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void multiply (float* dest, const float* src, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC_DEST (dest[i] *= src[i],
+                                          Mode::mul (d, s),
+                                          JUCE_LOAD_SRC_DEST,
+                                          JUCE_INCREMENT_SRC_DEST, )
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void multiply (double* dest, const double* src, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC_DEST (dest[i] *= src[i],
+                                          Mode::mul (d, s),
+                                          JUCE_LOAD_SRC_DEST,
+                                          JUCE_INCREMENT_SRC_DEST, )
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void multiply (float* dest, float multiplier, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_DEST (dest[i] *= multiplier,
+                                      Mode::mul (d, mult),
+                                      JUCE_LOAD_DEST,
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void multiply (double* dest, double multiplier, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_DEST (dest[i] *= multiplier,
+                                      Mode::mul (d, mult),
+                                      JUCE_LOAD_DEST,
+                                      const Mode::ParallelType mult = Mode::load1 (multiplier);)
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void clip (float* dest, const float* src, float low, float high, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
+                                          Mode::max (Mode::min (s, hi), lo),
+                                          JUCE_LOAD_SRC,
+                                          JUCE_INCREMENT_SRC_DEST,
+                                          const Mode::ParallelType lo = Mode::load1 (low);
+                                          const Mode::ParallelType hi = Mode::load1 (high);)
+        }
+
+        template <typename Size>
+        JUCE_AVX2_TARGET void clip (double* dest, const double* src, double low, double high, Size num) noexcept
+        {
+            JUCE_PERFORM_AVX_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
+                                          Mode::max (Mode::min (s, hi), lo),
+                                          JUCE_LOAD_SRC,
+                                          JUCE_INCREMENT_SRC_DEST,
+                                          const Mode::ParallelType lo = Mode::load1 (low);
+                                          const Mode::ParallelType hi = Mode::load1 (high);)
+        }
+
+        template <typename Type, typename Size>
+        JUCE_AVX2_TARGET Range<Type> findMinAndMax (const Type* src, Size num) noexcept
+        {
+            using Mode = typename AVXModeType<sizeof (Type)>::Mode;
+            using ParallelType = typename Mode::ParallelType;
+
+            auto numLongOps = num / Mode::numParallel;
+
+            if (numLongOps > 1)
+            {
+                ParallelType mn = Mode::loadU (src);
+                ParallelType mx = mn;
+
+                while (--numLongOps > 0)
+                {
+                    src += Mode::numParallel;
+                    const ParallelType v = Mode::loadU (src);
+                    mn = Mode::min (mn, v);
+                    mx = Mode::max (mx, v);
+                }
+
+                Range<Type> result (Mode::min (mn),
+                                    Mode::max (mx));
+
+                num &= (Mode::numParallel - 1);
+                src += Mode::numParallel;
+
+                for (auto i = (decltype (num)) 0; i < num; ++i)
+                    result = result.getUnionWith (src[i]);
+
+                return result;
+            }
+
+            return Range<Type>::findMinAndMax (src, num);
+        }
+    }
+   #else
+    #define JUCE_DISPATCH_TO_AVX2(functionCall)
+   #endif
+
 //==============================================================================
 namespace
 {
@@ -558,6 +858,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmul (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (copyWithMultiply (dest, src, multiplier, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
                                       Mode::mul (mult, s),
                                       JUCE_LOAD_SRC,
@@ -572,6 +874,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmulD (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (copyWithMultiply (dest, src, multiplier, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier,
                                       Mode::mul (mult, s),
                                       JUCE_LOAD_SRC,
@@ -636,6 +940,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vadd (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (add (dest, src, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i],
                                       Mode::add (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -649,6 +955,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vaddD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (add (dest, src, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i],
                                       Mode::add (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -662,6 +970,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vadd (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (add (dest, src1, src2, num))
+
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
                                             Mode::add (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -675,6 +985,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vaddD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (add (dest, src1, src2, num))
+
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i],
                                             Mode::add (s1, s2),
                                             JUCE_LOAD_SRC1_SRC2,
@@ -688,6 +1000,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsub (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (subtract (dest, src, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i],
                                       Mode::sub (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -701,6 +1015,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsubD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (subtract (dest, src, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i],
                                       Mode::sub (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -740,6 +1056,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsma (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (addWithMultiply (dest, src, multiplier, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier,
                                       Mode::add (d, Mode::mul (mult, s)),
                                       JUCE_LOAD_SRC_DEST,
@@ -754,6 +1072,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmaD (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (addWithMultiply (dest, src, multiplier, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier,
                                       Mode::add (d, Mode::mul (mult, s)),
                                       JUCE_LOAD_SRC_DEST,
@@ -768,6 +1088,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vma ((float*) src1, 1, (float*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (addWithMultiply (dest, src1, src2, num))
+
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
                                                  Mode::add (d, Mode::mul (s1, s2)),
                                                  JUCE_LOAD_SRC1_SRC2_DEST,
@@ -781,6 +1103,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmaD ((double*) src1, 1, (double*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (addWithMultiply (dest, src1, src2, num))
+
         JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i],
                                                  Mode::add (d, Mode::mul (s1, s2)),
                                                  JUCE_LOAD_SRC1_SRC2_DEST,
@@ -832,6 +1156,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmul (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (multiply (dest, src, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i],
                                       Mode::mul (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -845,6 +1171,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vmulD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (multiply (dest, src, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i],
                                       Mode::mul (d, s),
                                       JUCE_LOAD_SRC_DEST,
@@ -884,6 +1212,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmul (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (multiply (dest, multiplier, num))
+
         JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier,
                                   Mode::mul (d, mult),
                                   JUCE_LOAD_DEST,
@@ -897,6 +1227,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vsmulD (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (multiply (dest, multiplier, num))
+
         JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier,
                                   Mode::mul (d, mult),
                                   JUCE_LOAD_DEST,
@@ -1077,6 +1409,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vclip ((float*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (clip (dest, src, low, high, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
                                       Mode::max (Mode::min (s, hi), lo),
                                       JUCE_LOAD_SRC,
@@ -1094,6 +1428,8 @@ namespace
        #if JUCE_USE_VDSP_FRAMEWORK
         vDSP_vclipD ((double*) src, 1, &low, &high, dest, 1, (vDSP_Length) num);
        #else
+        JUCE_DISPATCH_TO_AVX2 (clip (dest, src, low, high, num))
+
         JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = jmax (jmin (src[i], high), low),
                                       Mode::max (Mode::min (s, hi), lo),
                                       JUCE_LOAD_SRC,
@@ -1107,6 +1443,8 @@ namespace
     Range<float> findMinAndMax (const float* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_DISPATCH_TO_AVX2 (findMinAndMax (src, num))
+
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinAndMax (src, num);
        #else
         return Range<float>::findMinAndMax (src, num);
@@ -1117,6 +1455,8 @@ namespace
     Range<double> findMinAndMax (const double* src, Size num) noexcept
     {
        #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+        JUCE_DISPATCH_TO_AVX2 (findMinAndMax (src, num))
+
         return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinAndMax (src, num);
        #else
         return Range<double>::findMinAndMax (src, num);
@@ -1656,6 +1996,79 @@ public:
             FloatVectorOperations::fill (data2, (ValueType) 3, num);
             FloatVectorOperations::addWithMultiply (data1, data1, data2, num);
             u.expect (areAllValuesEqual (data1, num, (ValueType) 8));
+
+            fillRandomly (random, data1, num);
+            FloatVectorOperations::clip (data2, data1, (ValueType) 250, (ValueType) 750, num);
+
+            for (int i = 0; i < num; ++i)
+                u.expect (exactlyEqual (data2[i], jlimit ((ValueType) 250, (ValueType) 750, data1[i])));
+
+            fillRandomly (random, data1, num);
+            fillRandomly (random, data2, num);
+            HeapBlock<ValueType> expected (num);
+
+            for (int i = 0; i < num; ++i)
+                expected[i] = data2[i] + data1[i] * (ValueType) 0.3;
+
+            FloatVectorOperations::addWithMultiply (data2, data1, (ValueType) 0.3, num);
+            u.expect (buffersMatch (data2, expected, num));
+
+            compareWithScalarReference (u, random, data1, num);
+        }
+
+        // Checks each of the operations that have separate SIMD kernels against a plain loop
+        static void compareWithScalarReference (UnitTest& u, Random& random, ValueType* data1, int num)
+        {
+            HeapBlock<ValueType> src1 (num), src2 (num), expected (num);
+            fillRandomly (random, src1, num);
+            fillRandomly (random, src2, num);
+
+            const auto multiplier = (ValueType) (random.nextDouble() * 2.0 - 1.0);
+
+            const auto check = [&] (auto&& operation, auto&& reference)
+            {
+                FloatVectorOperations::copy (data1, src2, num);
+
+                for (int i = 0; i < num; ++i)
+                    expected[i] = reference (i, src2[i]);
+
+                operation();
+                u.expect (buffersMatch (data1, expected, num));
+            };
+
+            check ([&] { FloatVectorOperations::copyWithMultiply (data1, src1, multiplier, num); },
+                   [&] (int i, ValueType) { return src1[i] * multiplier; });
+
+            check ([&] { FloatVectorOperations::add (data1, src1, num); },
+                   [&] (int i, ValueType d) { return d + src1[i]; });
+
+            check ([&] { FloatVectorOperations::add (data1, src1, src2, num); },
+                   [&] (int i, ValueType) { return src1[i] + src2[i]; });
+
+            check ([&] { FloatVectorOperations::subtract (data1, src1, num); },
+                   [&] (int i, ValueType d) { return d - src1[i]; });
+
+            check ([&] { FloatVectorOperations::addWithMultiply (data1, src1, multiplier, num); },
+                   [&] (int i, ValueType d) { return d + src1[i] * multiplier; });
+
+            check ([&] { FloatVectorOperations::addWithMultiply (data1, src1, src2, num); },
+                   [&] (int i, ValueType d) { return d + src1[i] * src2[i]; });
+
+            check ([&] { FloatVectorOperations::multiply (data1, src1, num); },
+                   [&] (int i, ValueType d) { return d * src1[i]; });
+
+            check ([&] { FloatVectorOperations::multiply (data1, multiplier, num); },
+                   [&] (int, ValueType d) { return d * multiplier; });
+
+            check ([&] { FloatVectorOperations::clip (data1, src1, (ValueType) 250, (ValueType) 750, num); },
+                   [&] (int i, ValueType) { return jlimit ((ValueType) 250, (ValueType) 750, src1[i]); });
+
+            auto expectedRange = Range<ValueType>::emptyRange (src1[0]);
+
+            for (int i = 1; i < num; ++i)
+                expectedRange = expectedRange.getUnionWith (src1[i]);
+
+            u.expect (FloatVectorOperations::findMinAndMax (src1.get(), num) == expectedRange);
         }
 
         static void doConversionTest (UnitTest& u, float* data1, float* data2, int* const int1, int num)
@@ -1712,7 +2125,22 @@ public:
     void runTest() override
     {
         beginTest ("FloatVectorOperations");
+        runAllTests();
 
+       #if JUCE_USE_AVX2_INTRINSICS
+        // The test above will have used the AVX2 kernels if the CPU supports them, so
+        // run everything again to check that the fallback paths give the same results
+        if (detail::canUseAVX2())
+        {
+            beginTest ("FloatVectorOperations without AVX2");
+            const detail::ScopedAVX2Disabler disabler;
+            runAllTests();
+        }
+       #endif
+    }
+
+    void runAllTests()
+    {
         for (int i = 1000; --i >= 0;)
         {
             TestRunner<float>::runTest (*this, getRandom());
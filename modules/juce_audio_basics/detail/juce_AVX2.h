@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#if JUCE_USE_AVX2_INTRINSICS
+
+/*  Functions marked with this are compiled for AVX2 on their own, rather than requiring the
+    whole module to be built with -mavx2. They must only be called when canUseAVX2() is true.
+*/
+#if JUCE_MSVC
+ #define JUCE_AVX2_TARGET
+#else
+ #define JUCE_AVX2_TARGET __attribute__ ((target ("avx2")))
+#endif
+
+namespace juce::detail
+{
+
+#if JUCE_UNIT_TESTS
+ inline std::atomic<bool> isAVX2DisabledForTesting { false };
+ inline bool isAVX2Disabled() noexcept       { return isAVX2DisabledForTesting.load (std::memory_order_relaxed); }
+#else
+ constexpr bool isAVX2Disabled() noexcept    { return false; }
+#endif
+
+#if defined (__AVX2__)
+ inline bool canUseAVX2() noexcept   { return ! isAVX2Disabled(); }
+#else
+ // This is queried during static initialisation so that the first call on the audio thread
+ // doesn't end up interrogating the system about its CPU.
+ inline const bool isAVX2Available = SystemStats::hasAVX2();
+ inline bool canUseAVX2() noexcept   { return isAVX2Available && ! isAVX2Disabled(); }
+#endif
+
+#if JUCE_UNIT_TESTS
+ /*  While one of these exists, canUseAVX2() returns false, so that the unit tests can
+     exercise the fallback code paths on a machine that supports AVX2.
+ */
+ struct ScopedAVX2Disabler
+ {
+     ScopedAVX2Disabler() noexcept   : previous (isAVX2DisabledForTesting.exchange (true)) {}
+     ~ScopedAVX2Disabler() noexcept  { isAVX2DisabledForTesting = previous; }
+
+     const bool previous;
+
+     JUCE_DECLARE_NON_COPYABLE (ScopedAVX2Disabler)
+ };
+#endif
+
+} // namespace juce::detail
+
+#endif
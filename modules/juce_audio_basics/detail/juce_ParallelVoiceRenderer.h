@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::detail
+{
+
+//==============================================================================
+/*  Renders the active voices of a synthesiser on a RealtimeRenderThreadPool.
+
+    The audio thread and each worker claim a scratch buffer, and then take voices one
+    at a time from a shared counter, adding them to that scratch buffer, until there are
+    none left. The scratch buffers that were used are then summed into the output on
+    the audio thread.
+
+    All the storage is allocated up-front, so render() never allocates. If the buffer or
+    the number of active voices is larger than that storage, render() returns false and
+    the caller should render the voices itself.
+*/
+class ParallelVoiceRenderer
+{
+public:
+    ParallelVoiceRenderer (int numThreads, int maxNumChannels, int maxBlockSize, double sampleRate)
+        : pool (numThreads, maxBlockSize, sampleRate > 0.0 ? sampleRate : 44100.0),
+          maxChannels (jmin (maxNumChannels, maxChannelsWithoutAllocating)),
+          maxSamples (maxBlockSize),
+          partitionUsed ((size_t) numThreads + 1)
+    {
+        for (int i = 0; i <= numThreads; ++i)
+        {
+            floatScratch .emplace_back (maxChannels, maxSamples);
+            doubleScratch.emplace_back (maxChannels, maxSamples);
+        }
+
+        reserveVoices (64);
+    }
+
+    int getNumThreads() const noexcept          { return pool.getNumThreads(); }
+
+    /*  Makes sure that there's room to render this many voices. Must not be called
+        at the same time as render().
+    */
+    void reserveVoices (int numVoices)
+    {
+        if ((size_t) numVoices > activeVoices.capacity())
+            activeVoices.reserve ((size_t) numVoices);
+    }
+
+    /*  Adds the output of every voice for which isActive() returns true to the given range
+        of the output buffer, sharing the voices between the threads. If renderInactiveVoices is
+        true, the remaining voices are rendered too, directly on the calling thread.
+
+        Returns false without rendering anything if the buffer is too large for the scratch
+        buffers, or there are too many voices.
+    */
+    template <typename FloatType, typename VoiceType, typename IsActive>
+    bool render (AudioBuffer<FloatType>& output, int startSample, int numSamples,
+                 const OwnedArray<VoiceType>& voices, IsActive&& isActive, bool renderInactiveVoices)
+    {
+        if (output.getNumChannels() > maxChannels
+            || output.getNumSamples() > maxSamples
+            || voices.size() > (int) activeVoices.capacity())
+            return false;
+
+        activeVoices.clear();
+
+        for (auto* voice : voices)
+        {
+            if (isActive (*voice))
+                activeVoices.push_back (voice);
+            else if (renderInactiveVoices)
+                voice->renderNextBlock (output, startSample, numSamples);
+        }
+
+        // With a single voice there's nothing to share out
+        if (activeVoices.size() <= 1)
+        {
+            for (auto* voice : activeVoices)
+                static_cast<VoiceType*> (voice)->renderNextBlock (output, startSample, numSamples);
+
+            return true;
+        }
+
+        auto& scratch = getScratch<FloatType>();
+        const auto numPartitions = (int) jmin (scratch.size(), activeVoices.size());
+
+        VoiceRenderJob<FloatType, VoiceType> job (*this, scratch, numPartitions, output.getNumChannels(),
+                                                  output.getNumSamples(), startSample, numSamples);
+        pool.perform (job);
+
+        for (int partition = 0; partition < numPartitions; ++partition)
+        {
+            if (partitionUsed[(size_t) partition] == 0)
+                continue;
+
+            for (int channel = 0; channel < output.getNumChannels(); ++channel)
+                FloatVectorOperations::add (output.getWritePointer (channel, startSample),
+                                            scratch[(size_t) partition].getReadPointer (channel, startSample),
+                                            numSamples);
+        }
+
+        return true;
+    }
+
+private:
+    //==============================================================================
+    template <typename FloatType, typename VoiceType>
+    class VoiceRenderJob final : public RealtimeRenderJob
+    {
+    public:
+        VoiceRenderJob (ParallelVoiceRenderer& o, std::vector<AudioBuffer<FloatType>>& scratchIn,
+                        int numPartitionsIn, int numChannelsIn, int bufferLengthIn, int startSampleIn, int numSamplesIn)
+            : owner (o), scratch (scratchIn), numPartitions (numPartitionsIn), numChannels (numChannelsIn),
+              bufferLength (bufferLengthIn), startSample (startSampleIn), numSamples (numSamplesIn)
+        {
+        }
+
+        bool runNextTask() override
+        {
+            const auto partition = nextPartition.fetch_add (1);
+
+            if (partition >= numPartitions)
+                return false;
+
+            // A view with the same shape as the output buffer, so that voices see the channel
+            // count they expect
+            auto& storage = scratch[(size_t) partition];
+            AudioBuffer<FloatType> buffer (storage.getArrayOfWritePointers(), numChannels, bufferLength);
+            auto used = false;
+
+            for (auto index = nextVoice.fetch_add (1); index < (int) owner.activeVoices.size(); index = nextVoice.fetch_add (1))
+            {
+                if (! used)
+                {
+                    buffer.clear (startSample, numSamples);
+                    used = true;
+                }
+
+                static_cast<VoiceType*> (owner.activeVoices[(size_t) index])->renderNextBlock (buffer, startSample, numSamples);
+            }
+
+            owner.partitionUsed[(size_t) partition] = used ? 1 : 0;
+            numFinished.fetch_add (1);
+            return true;
+        }
+
+        bool isFinished() const override
+        {
+            return numFinished.load() == numPartitions;
+        }
+
+    private:
+        ParallelVoiceRenderer& owner;
+        std::vector<AudioBuffer<FloatType>>& scratch;
+        const int numPartitions, numChannels, bufferLength, startSample, numSamples;
+        std::atomic<int> nextPartition { 0 }, nextVoice { 0 }, numFinished { 0 };
+    };
+
+    template <typename FloatType>
+    std::vector<AudioBuffer<FloatType>>& getScratch() noexcept
+    {
+        if constexpr (std::is_same_v<FloatType, float>)
+            return floatScratch;
+        else
+            return doubleScratch;
+    }
+
+    // AudioBuffer can refer to this many channels without allocating
+    static constexpr int maxChannelsWithoutAllocating = 31;
+
+    RealtimeRenderThreadPool pool;
+    const int maxChannels, maxSamples;
+    std::vector<AudioBuffer<float>> floatScratch;
+    std::vector<AudioBuffer<double>> doubleScratch;
+    std::vector<void*> activeVoices;
+    std::vector<char> partitionUsed;
+};
+
+} // namespace juce::detail
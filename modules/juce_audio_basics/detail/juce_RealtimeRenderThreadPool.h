@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::detail
+{
+
+//==============================================================================
+/*  A set of tasks that can be shared between the threads of a RealtimeRenderThreadPool. */
+struct RealtimeRenderJob
+{
+    virtual ~RealtimeRenderJob() = default;
+
+    /*  Attempts to run a single task that is ready to run.
+        Returns false if there was nothing to do at the moment.
+    */
+    virtual bool runNextTask() = 0;
+
+    /*  Returns true once every task in the job has completed. */
+    virtual bool isFinished() const = 0;
+};
+
+//==============================================================================
+/*  A set of real-time worker threads that help the audio thread to finish a RealtimeRenderJob.
+
+    The audio thread hands over a job without locking or allocating. Workers spin for a short
+    while after finishing a job so that they're ready to pick up the next block; after that they
+    go to sleep, and will be woken by the next call to perform().
+*/
+class RealtimeRenderThreadPool
+{
+public:
+    RealtimeRenderThreadPool (int numThreads, int blockSize, double sampleRate)
+    {
+        const auto options = Thread::RealtimeOptions{}.withApproximateAudioProcessingTime (blockSize, sampleRate);
+
+        for (auto i = 0; i < numThreads; ++i)
+        {
+            auto& worker = *workers.emplace_back (std::make_unique<Worker> (*this, i));
+
+            if (! worker.startRealtimeThread (options))
+                worker.startThread (Thread::Priority::highest);
+        }
+    }
+
+    ~RealtimeRenderThreadPool()
+    {
+        for (auto& worker : workers)
+            worker->signalThreadShouldExit();
+
+        for (auto& worker : workers)
+        {
+            worker->notify();
+            worker->stopThread (-1);
+        }
+    }
+
+    int getNumThreads() const noexcept { return (int) workers.size(); }
+
+    /*  Runs the job to completion, using the calling thread and any available workers.
+        Call from the audio thread only.
+    */
+    void perform (RealtimeRenderJob& job)
+    {
+        // The workers flush denormals, so the tasks that run here must too, or the result
+        // would depend on which thread happened to run each one
+        const ScopedNoDenormals noDenormals;
+
+        currentJob.store (&job);
+
+        for (auto& worker : workers)
+            if (worker->isSleeping())
+                worker->notify();
+
+        while (! job.isFinished())
+            if (! job.runNextTask())
+                Thread::yield();
+
+        currentJob.store (nullptr);
+
+        // The job may be reused or destroyed as soon as we return, so wait for any workers that
+        // are still looking at it
+        while (numActiveWorkers.load() != 0)
+            Thread::yield();
+    }
+
+    void setWorkgroup (const AudioWorkgroup& newWorkgroup)
+    {
+        const std::scoped_lock lock (workgroupMutex);
+        workgroup = newWorkgroup;
+        ++workgroupGeneration;
+    }
+
+private:
+    class Worker final : public Thread
+    {
+    public:
+        Worker (RealtimeRenderThreadPool& p, int index)
+            : Thread ("Render Thread " + String (index + 1)), pool (p) {}
+
+        bool isSleeping() const noexcept { return sleeping.load(); }
+
+        void run() override
+        {
+            const ScopedNoDenormals noDenormals;
+            WorkgroupToken token;
+            auto localWorkgroupGeneration = -1;
+            auto numIdleSpins = 0;
+
+            while (! threadShouldExit())
+            {
+                if (localWorkgroupGeneration != pool.workgroupGeneration.load())
+                {
+                    const std::scoped_lock lock (pool.workgroupMutex);
+                    localWorkgroupGeneration = pool.workgroupGeneration.load();
+                    pool.workgroup.join (token);
+                }
+
+                if (pool.helpWithCurrentJob())
+                {
+                    numIdleSpins = 0;
+                    continue;
+                }
+
+                if (++numIdleSpins < maxIdleSpins)
+                {
+                    Thread::yield();
+                    continue;
+                }
+
+                sleeping.store (true);
+
+                if (pool.currentJob.load() == nullptr)
+                    wait (-1);
+
+                sleeping.store (false);
+                numIdleSpins = 0;
+            }
+        }
+
+    private:
+        static constexpr auto maxIdleSpins = 100;
+
+        RealtimeRenderThreadPool& pool;
+        std::atomic<bool> sleeping { false };
+    };
+
+    bool helpWithCurrentJob()
+    {
+        ++numActiveWorkers;
+
+        auto* job = currentJob.load();
+        const auto foundJob = job != nullptr && ! job->isFinished();
+
+        // If nothing becomes ready for a while, the rest of the job is probably a chain of tasks
+        // that the audio thread can finish by itself, so stop competing with it for the CPU
+        for (auto numFailedAttempts = 0; foundJob && ! job->isFinished() && numFailedAttempts < maxFailedAttempts;)
+        {
+            if (job->runNextTask())
+            {
+                numFailedAttempts = 0;
+            }
+            else
+            {
+                ++numFailedAttempts;
+                Thread::yield();
+            }
+        }
+
+        --numActiveWorkers;
+        return foundJob;
+    }
+
+    static constexpr auto maxFailedAttempts = 100;
+
+    std::atomic<RealtimeRenderJob*> currentJob { nullptr };
+    std::atomic<int> numActiveWorkers { 0 };
+
+    std::mutex workgroupMutex;
+    AudioWorkgroup workgroup;
+    std::atomic<int> workgroupGeneration { 0 };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+};
+
+} // namespace juce::detail
@@ -47,6 +47,10 @@
  #include <emmintrin.h>
 #endif
 
+#if JUCE_USE_AVX2_INTRINSICS
+ #include <immintrin.h>
+#endif
+
 #if JUCE_MAC || JUCE_IOS
  #ifndef JUCE_USE_VDSP_FRAMEWORK
   #define JUCE_USE_VDSP_FRAMEWORK 1
@@ -66,6 +70,7 @@
  #include <arm_neon.h>
 #endif
 
+#include "detail/juce_AVX2.h"
 #include "buffers/juce_AudioDataConverters.cpp"
 #include "buffers/juce_FloatVectorOperations.cpp"
 #include "buffers/juce_AudioChannelSet.cpp"
@@ -74,6 +79,7 @@
 #include "utilities/juce_LagrangeInterpolator.cpp"
 #include "utilities/juce_WindowedSincInterpolator.cpp"
 #include "utilities/juce_Interpolators.cpp"
+#include "utilities/juce_PolyphaseResampler.cpp"
 #include "utilities/juce_SmoothedValue.cpp"
 #include "midi/juce_MidiBuffer.cpp"
 #include "midi/juce_MidiFile.cpp"
@@ -81,6 +87,8 @@
 #include "midi/juce_MidiMessage.cpp"
 #include "midi/juce_MidiMessageSequence.cpp"
 #include "midi/juce_MidiRPN.cpp"
+#include "detail/juce_RealtimeRenderThreadPool.h"
+#include "detail/juce_ParallelVoiceRenderer.h"
 #include "mpe/juce_MPEValue.cpp"
 #include "mpe/juce_MPENote.cpp"
 #include "mpe/juce_MPEZoneLayout.cpp"
@@ -112,5 +120,8 @@
 
 #if JUCE_UNIT_TESTS
  #include "utilities/juce_ADSR_test.cpp"
+ #include "utilities/juce_PolyphaseResampler_test.cpp"
+ #include "synthesisers/juce_Synthesiser_test.cpp"
  #include "midi/ump/juce_UMP_test.cpp"
+ #include "midi/ump/juce_UMPEventBuffer_test.cpp"
 #endif
@@ -78,6 +78,14 @@
  #undef JUCE_USE_SSE_INTRINSICS
 #endif
 
+#ifndef JUCE_USE_AVX2_INTRINSICS
+ #define JUCE_USE_AVX2_INTRINSICS 1
+#endif
+
+#if ! JUCE_USE_SSE_INTRINSICS
+ #undef JUCE_USE_AVX2_INTRINSICS
+#endif
+
 #if __ARM_NEON__ && ! (JUCE_USE_VDSP_FRAMEWORK || defined (JUCE_USE_ARM_NEON))
  #define JUCE_USE_ARM_NEON 1
 #endif
@@ -101,6 +109,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "utilities/juce_IIRFilter.h"
 #include "utilities/juce_GenericInterpolator.h"
 #include "utilities/juce_Interpolators.h"
+#include "utilities/juce_PolyphaseResampler.h"
 #include "utilities/juce_SmoothedValue.h"
 #include "utilities/juce_Reverb.h"
 #include "utilities/juce_ADSR.h"
@@ -0,0 +1,293 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+#ifndef DOXYGEN
+
+namespace juce::universal_midi_packets
+{
+
+/**
+    A fixed-capacity collection of timestamped Universal MIDI Packets.
+
+    All of the storage is allocated by the constructor. Adding events, sorting
+    and clearing never allocate, so an EventBuffer can be filled and consumed on
+    the audio thread.
+
+    Adding an event is O(1), regardless of its timestamp. Once all of the events
+    for a block have been added, call sort() to put them into timestamp order.
+    Events with equal timestamps stay in the order in which they were added, and
+    sort() does nothing at all if the events were added in order.
+
+    Events can be added straight from a range of MidiBufferIterators, and written
+    back to a MidiBuffer, without creating any intermediate MidiMessage objects.
+
+    @tags{Audio}
+*/
+class EventBuffer
+{
+public:
+    /** A single packet along with its position in the block. */
+    struct Event
+    {
+        int samplePosition = 0;
+        View packet;
+    };
+
+    /** Creates a buffer that can hold up to `maxNumEvents` packets, with a total
+        size of up to `maxNumWords` 32-bit words.
+    */
+    EventBuffer (size_t maxNumEvents, size_t maxNumWords)
+        : events (maxNumEvents), words (maxNumWords)
+    {
+    }
+
+    /** Creates a buffer that can hold up to `maxNumEvents` packets of any size. */
+    explicit EventBuffer (size_t maxNumEvents)
+        : EventBuffer (maxNumEvents, maxNumEvents * 4)
+    {
+    }
+
+    EventBuffer (EventBuffer&&) noexcept = default;
+    EventBuffer& operator= (EventBuffer&&) noexcept = default;
+
+    //==============================================================================
+    /** Adds a single packet to the buffer.
+
+        The View must point to a well-formed packet. Returns false, leaving the
+        buffer unchanged, if there isn't enough room left for the packet.
+    */
+    bool add (const View& packet, int samplePosition) noexcept
+    {
+        return addWords (packet.data(), packet.size(), samplePosition);
+    }
+
+    template <size_t numWords>
+    bool add (const Packet<numWords>& packet, int samplePosition) noexcept
+    {
+        jassert (Utils::getNumWordsForMessageType (packet[0]) == numWords);
+        return addWords (packet.data(), numWords, samplePosition);
+    }
+
+    /** Converts a range of bytestream events to MIDI 1.0 packets on group 0, and
+        adds them to this buffer.
+
+        The bytes are read directly from the MidiBuffer that the iterators refer to.
+        Returns false if the buffer filled up before all of the events were added.
+    */
+    bool addEvents (MidiBufferIterator first, MidiBufferIterator last, int sampleDeltaToAdd = 0) noexcept
+    {
+        auto allAdded = true;
+
+        for (; first != last; ++first)
+        {
+            const auto metadata = *first;
+            const auto time = metadata.samplePosition + sampleDeltaToAdd;
+
+            Conversion::toMidi1 (BytestreamMidiView (metadata), [&] (const View& view)
+            {
+                allAdded = add (view, time) && allAdded;
+            });
+        }
+
+        return allAdded;
+    }
+
+    /** Adds the events from a MidiBuffer which lie in the range
+        [startSample, startSample + numSamples), optionally offsetting their times.
+
+        If numSamples is less than 0, all events after startSample are added.
+
+        @see MidiBuffer::addEvents
+    */
+    bool addEvents (const MidiBuffer& source, int startSample, int numSamples, int sampleDeltaToAdd) noexcept
+    {
+        auto first = source.findNextSamplePosition (startSample);
+        auto last = numSamples < 0 ? source.cend()
+                                   : source.findNextSamplePosition (startSample + numSamples);
+
+        return addEvents (first, last, sampleDeltaToAdd);
+    }
+
+    /** Puts the events into timestamp order.
+
+        This is a stable sort: events which share a timestamp keep the order in
+        which they were added.
+    */
+    void sort() noexcept
+    {
+        if (sorted)
+            return;
+
+        // Packets are stored in the order they were added, so using the packet
+        // address as a tie-break makes an in-place sort stable.
+        std::sort (events.begin(), events.begin() + (ptrdiff_t) numEvents, [] (const Event& a, const Event& b)
+        {
+            if (a.samplePosition != b.samplePosition)
+                return a.samplePosition < b.samplePosition;
+
+            return a.packet.data() < b.packet.data();
+        });
+
+        sorted = true;
+    }
+
+    /** Returns true if the events are currently in timestamp order. */
+    bool isSorted() const noexcept                  { return sorted; }
+
+    /** Removes all events, without freeing any storage. */
+    void clear() noexcept
+    {
+        numEvents = 0;
+        numWords = 0;
+        sorted = true;
+    }
+
+    //==============================================================================
+    /** Replaces the contents of a MidiBuffer with the events in this buffer.
+
+        MIDI 2.0 channel voice messages are translated to their MIDI 1.0
+        equivalents, and SysEx7 packets are reassembled into complete messages.
+        Utility messages and packets with no bytestream equivalent are skipped.
+
+        The events must have been sorted. Call MidiBuffer::ensureSize() on the
+        destination beforehand to avoid allocating.
+    */
+    void copyTo (MidiBuffer& dest) const
+    {
+        // Call sort() before reading the events!
+        jassert (sorted);
+
+        dest.clear();
+        auto lastTime = std::numeric_limits<int>::min();
+
+        const auto append = [&] (const void* bytes, int numBytes, int time)
+        {
+            // Events normally arrive in order and can go straight onto the end of the
+            // buffer. A SysEx message whose packets were interleaved with other events
+            // may complete after a later event, so it needs to be inserted instead.
+            if (time < lastTime)
+            {
+                dest.addEvent (bytes, numBytes, time);
+                return;
+            }
+
+            lastTime = time;
+            const auto headerSize = (int) (sizeof (int32) + sizeof (uint16));
+            const auto offset = dest.data.size();
+            dest.data.insertMultiple (offset, 0, headerSize + numBytes);
+
+            auto* d = dest.data.begin() + offset;
+            writeUnaligned<int32>  (d, time);
+            writeUnaligned<uint16> (d + sizeof (int32), (uint16) numBytes);
+            memcpy (d + headerSize, bytes, (size_t) numBytes);
+        };
+
+        Midi1ToBytestreamTranslator translator (0);
+
+        for (const auto& event : *this)
+        {
+            const auto firstWord = event.packet[0];
+            const auto type = Utils::getMessageType (firstWord);
+
+            if (type == 0x1 || type == 0x2)
+            {
+                // MIDI 1.0 channel voice and system messages map directly onto bytes
+                const uint8 bytes[] { (uint8) (firstWord >> 0x10),
+                                      (uint8) (firstWord >> 0x08),
+                                      (uint8) (firstWord >> 0x00) };
+                append (bytes, MidiMessage::getMessageLengthFromFirstByte (bytes[0]), event.samplePosition);
+                continue;
+            }
+
+            Conversion::midi2ToMidi1DefaultTranslation (event.packet, [&] (const View& midi1)
+            {
+                translator.dispatch (midi1, event.samplePosition, [&] (const BytestreamMidiView& m)
+                {
+                    append (m.bytes.data(), (int) m.bytes.size(), (int) m.timestamp);
+                });
+            });
+        }
+    }
+
+    //==============================================================================
+    /** Returns a pointer to the first event. */
+    const Event* begin() const noexcept             { return events.data(); }
+
+    /** Returns a pointer one past the last event. */
+    const Event* end() const noexcept               { return events.data() + numEvents; }
+
+    /** Returns the number of events in the buffer. */
+    int getNumEvents() const noexcept               { return (int) numEvents; }
+
+    /** Returns true if the buffer contains no events. */
+    bool isEmpty() const noexcept                   { return numEvents == 0; }
+
+    /** Returns the number of 32-bit words used by the packets in the buffer. */
+    size_t getNumWords() const noexcept             { return numWords; }
+
+    /** Returns the maximum number of events that the buffer can hold. */
+    size_t getMaxNumEvents() const noexcept         { return events.size(); }
+
+    /** Returns the maximum number of 32-bit words that the buffer can hold. */
+    size_t getMaxNumWords() const noexcept          { return words.size(); }
+
+private:
+    bool addWords (const uint32_t* source, size_t size, int samplePosition) noexcept
+    {
+        if (numEvents >= events.size() || words.size() - numWords < size)
+            return false;
+
+        auto* dest = words.data() + numWords;
+        std::copy (source, source + size, dest);
+
+        if (numEvents > 0 && samplePosition < events[numEvents - 1].samplePosition)
+            sorted = false;
+
+        events[numEvents++] = { samplePosition, View (dest) };
+        numWords += size;
+        return true;
+    }
+
+    std::vector<Event> events;
+    std::vector<uint32_t> words;
+    size_t numEvents = 0, numWords = 0;
+    bool sorted = true;
+
+    JUCE_DECLARE_NON_COPYABLE (EventBuffer)
+};
+
+} // namespace juce::universal_midi_packets
+
+#endif
@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce::universal_midi_packets
+{
+
+class UMPEventBufferTests final : public UnitTest
+{
+public:
+    UMPEventBufferTests()
+        : UnitTest ("UMP EventBuffer", UnitTestCategories::midi)
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("Events added in order are already sorted");
+        {
+            EventBuffer buffer (16);
+
+            for (int i = 0; i < 8; ++i)
+                expect (buffer.add (Factory::makeControlChangeV1 (0, 0, 1, (uint8_t) i), i * 2));
+
+            expect (buffer.isSorted());
+            expectEquals (buffer.getNumEvents(), 8);
+            expectEquals (buffer.getNumWords(), (size_t) 8);
+
+            int index = 0;
+
+            for (const auto& event : buffer)
+            {
+                expectEquals (event.samplePosition, index * 2);
+                expectEquals ((int) (event.packet[0] & 0xff), index);
+                ++index;
+            }
+        }
+
+        beginTest ("Sorting keeps events with equal timestamps in the order they were added");
+        {
+            EventBuffer buffer (32);
+            const int times[] { 5, 3, 5, 0, 3, 5, 1, 0 };
+
+            for (size_t i = 0; i < std::size (times); ++i)
+                buffer.add (Factory::makeControlChangeV1 (0, 0, 7, (uint8_t) i), times[i]);
+
+            expect (! buffer.isSorted());
+            buffer.sort();
+            expect (buffer.isSorted());
+
+            const uint8_t expectedOrder[] { 3, 7, 6, 1, 4, 0, 2, 5 };
+            size_t index = 0;
+
+            for (const auto& event : buffer)
+            {
+                const auto value = (uint8_t) (event.packet[0] & 0xff);
+                expectEquals ((int) value, (int) expectedOrder[index]);
+                expectEquals (event.samplePosition, times[value]);
+                ++index;
+            }
+        }
+
+        beginTest ("Adding fails once the buffer is full");
+        {
+            EventBuffer buffer (4, 5);
+
+            expect (buffer.add (Factory::makeNoteOnV2 (0, 0, 60, Factory::NoteAttributeKind::none, 0xffff, 0), 0));
+            expect (buffer.add (Factory::makeNoteOnV2 (0, 0, 62, Factory::NoteAttributeKind::none, 0xffff, 0), 0));
+            expect (! buffer.add (Factory::makeNoteOnV2 (0, 0, 64, Factory::NoteAttributeKind::none, 0xffff, 0), 0));
+            expect (buffer.add (Factory::makeNoteOnV1 (0, 0, 64, 100), 0));
+            expect (! buffer.add (Factory::makeNoteOnV1 (0, 0, 65, 100), 0));
+            expectEquals (buffer.getNumEvents(), 3);
+
+            buffer.clear();
+            expect (buffer.isEmpty());
+            expectEquals (buffer.getMaxNumEvents(), (size_t) 4);
+            expectEquals (buffer.getMaxNumWords(), (size_t) 5);
+
+            for (int i = 0; i < 4; ++i)
+                expect (buffer.add (Factory::makeNoteOnV1 (0, 0, 64, 100), 0));
+
+            expect (! buffer.add (Factory::makeNoteOnV1 (0, 0, 64, 100), 0));
+        }
+
+        beginTest ("MidiBuffer contents can be round-tripped");
+        {
+            auto random = getRandom();
+            MidiBuffer source;
+
+            for (int i = 0; i < 200; ++i)
+            {
+                const auto time = random.nextInt (512);
+                const auto channel = random.nextInt ({ 1, 17 });
+
+                switch (random.nextInt (4))
+                {
+                    case 0:  source.addEvent (MidiMessage::noteOn (channel, random.nextInt (128), (uint8) random.nextInt ({ 1, 128 })), time); break;
+                    case 1:  source.addEvent (MidiMessage::controllerEvent (channel, random.nextInt (128), random.nextInt (128)), time); break;
+                    case 2:  source.addEvent (MidiMessage::pitchWheel (channel, random.nextInt (0x4000)), time); break;
+                    default: source.addEvent (MidiMessage::programChange (channel, random.nextInt (128)), time); break;
+                }
+            }
+
+            std::vector<uint8> sysExData (40);
+
+            for (auto& byte : sysExData)
+                byte = (uint8) random.nextInt (128);
+
+            source.addEvent (MidiMessage::createSysExMessage (sysExData.data(), (int) sysExData.size()), 100);
+
+            EventBuffer buffer (256);
+            expect (buffer.addEvents (source.cbegin(), source.cend()));
+            expect (buffer.isSorted());
+
+            MidiBuffer result;
+            buffer.copyTo (result);
+            expect (result.data == source.data);
+
+            buffer.clear();
+            expect (buffer.addEvents (source, 100, 50, -100));
+
+            MidiBuffer expected;
+            expected.addEvents (source, 100, 50, -100);
+
+            buffer.copyTo (result);
+            expect (result.data == expected.data);
+        }
+
+        beginTest ("Out-of-order events match a MidiBuffer built with addEvent");
+        {
+            auto random = getRandom();
+            EventBuffer buffer (128);
+            MidiBuffer expected;
+
+            for (int i = 0; i < 100; ++i)
+            {
+                const auto time = random.nextInt (64);
+                const auto packet = Factory::makeControlChangeV1 (0, (uint8_t) (i % 16), 1, (uint8_t) random.nextInt (128));
+                buffer.add (packet, time);
+                expected.addEvent (Midi1ToBytestreamTranslator::fromUmp (packet), time);
+            }
+
+            buffer.sort();
+
+            MidiBuffer result;
+            buffer.copyTo (result);
+            expect (result.data == expected.data);
+        }
+
+        beginTest ("MIDI 2.0 packets are translated when copied to a MidiBuffer");
+        {
+            EventBuffer buffer (4);
+            buffer.add (Factory::makeNoteOnV2 (0, 2, 60, Factory::NoteAttributeKind::none, 0xffff, 0), 10);
+            buffer.add (PacketX1{}, 12);
+
+            MidiBuffer result;
+            buffer.copyTo (result);
+
+            expectEquals (result.getNumEvents(), 1);
+
+            for (const auto metadata : result)
+            {
+                expectEquals (metadata.samplePosition, 10);
+                expect (metadata.getMessage().isNoteOn());
+                expectEquals (metadata.getMessage().getChannel(), 3);
+                expectEquals (metadata.getMessage().getNoteNumber(), 60);
+                expectEquals ((int) metadata.getMessage().getVelocity(), 127);
+            }
+        }
+    }
+};
+
+static UMPEventBufferTests umpEventBufferTests;
+
+} // namespace juce::universal_midi_packets
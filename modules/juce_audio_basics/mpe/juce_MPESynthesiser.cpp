@@ -276,6 +276,9 @@ void MPESynthesiser::addVoice (MPESynthesiserVoice* const newVoice)
         const ScopedLock sl (voicesLock);
         newVoice->setCurrentSampleRate (getSampleRate());
         voices.add (newVoice);
+
+        if (parallelRenderer != nullptr)
+            parallelRenderer->reserveVoices (voices.size());
     }
 
     {
@@ -339,10 +342,16 @@ void MPESynthesiser::turnOffAllVoices (bool allowTailOff)
 }
 
 //==============================================================================
-void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
+template <typename floatType>
+void MPESynthesiser::renderActiveVoices (AudioBuffer<floatType>& buffer, int startSample, int numSamples)
 {
     const ScopedLock sl (voicesLock);
 
+    if (parallelRenderer != nullptr
+         && parallelRenderer->render (buffer, startSample, numSamples, voices,
+                                      [] (MPESynthesiserVoice& v) { return v.isActive(); }, false))
+        return;
+
     for (auto* voice : voices)
     {
         if (voice->isActive())
@@ -350,15 +359,38 @@ void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSa
     }
 }
 
+void MPESynthesiser::renderNextSubBlock (AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    renderActiveVoices (buffer, startSample, numSamples);
+}
+
 void MPESynthesiser::renderNextSubBlock (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
-    const ScopedLock sl (voicesLock);
+    renderActiveVoices (buffer, startSample, numSamples);
+}
+
+//==============================================================================
+void MPESynthesiser::setNumRenderThreads (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize)
+{
+    std::unique_ptr<detail::ParallelVoiceRenderer> newRenderer;
+
+    if (numWorkerThreads > 0)
+        newRenderer = std::make_unique<detail::ParallelVoiceRenderer> (numWorkerThreads, maximumNumChannels,
+                                                                        maximumBlockSize, getSampleRate());
 
-    for (auto* voice : voices)
     {
-        if (voice->isActive())
-            voice->renderNextBlock (buffer, startSample, numSamples);
+        const ScopedLock sl (voicesLock);
+
+        if (newRenderer != nullptr)
+            newRenderer->reserveVoices (voices.size());
+
+        std::swap (parallelRenderer, newRenderer);
     }
 }
 
+int MPESynthesiser::getNumRenderThreads() const noexcept
+{
+    return parallelRenderer != nullptr ? parallelRenderer->getNumThreads() : 0;
+}
+
 } // namespace juce
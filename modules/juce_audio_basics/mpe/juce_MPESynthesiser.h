@@ -35,6 +35,8 @@
 namespace juce
 {
 
+namespace detail { class ParallelVoiceRenderer; }
+
 //==============================================================================
 /**
     Base class for an MPE-compatible musical device that can play sounds.
@@ -138,6 +140,25 @@ public:
     /** Returns true if note-stealing is enabled. */
     bool isVoiceStealingEnabled() const noexcept                { return shouldStealVoices; }
 
+    //==============================================================================
+    /** Allows the active voices to be rendered in parallel on a set of real-time worker threads.
+
+        Pass 0 (the default) to render each voice in turn on the calling thread. Otherwise, the
+        given number of worker threads is started, and each sub-block's active voices are shared
+        out between them and the calling thread. Only enable this if your voices can safely render
+        at the same time as each other.
+
+        Sub-blocks with more than maximumNumChannels channels or maximumBlockSize samples are
+        rendered serially. This will block while the synth is rendering, so don't call it from
+        the audio thread.
+
+        @see Synthesiser::setNumRenderThreads
+    */
+    void setNumRenderThreads (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize);
+
+    /** Returns the number of worker threads set by setNumRenderThreads(). */
+    int getNumRenderThreads() const noexcept;
+
     //==============================================================================
     /** Tells the synthesiser what the sample rate is for the audio it's being used to render.
 
@@ -318,6 +339,10 @@ private:
     uint32 lastNoteOnCounter = 0;
     mutable CriticalSection stealLock;
     mutable Array<MPESynthesiserVoice*> usableVoicesToStealArray;
+    std::unique_ptr<detail::ParallelVoiceRenderer> parallelRenderer;
+
+    template <typename floatType>
+    void renderActiveVoices (AudioBuffer<floatType>&, int startSample, int numSamples);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiser)
 };
@@ -51,8 +51,69 @@ void ResamplingAudioSource::setResamplingRatio (const double samplesInPerOutputS
 {
     jassert (samplesInPerOutputSample > 0);
 
-    const SpinLock::ScopedLockType sl (ratioLock);
-    ratio = jmax (0.0, samplesInPerOutputSample);
+    Optional<PolyphaseResampler::Quality> quality;
+    auto previousFilterBankRatio = 0.0;
+
+    {
+        const SpinLock::ScopedLockType sl (ratioLock);
+        ratio = jmax (0.0, samplesInPerOutputSample);
+        quality = polyphaseQuality;
+        previousFilterBankRatio = filterBankRatio;
+    }
+
+    if (! quality.hasValue()
+         || samplesInPerOutputSample <= 0
+         || ! PolyphaseResampler::needsNewFilterBank (previousFilterBankRatio, samplesInPerOutputSample))
+        return;
+
+    // Designing the filter for a new down-sampling ratio allocates memory, so it's done here
+    // rather than on the audio thread, which keeps using its current filter until it picks
+    // this one up at the start of its next block
+    auto newFilterBank = PolyphaseResampler::createFilterBank (*quality, samplesInPerOutputSample);
+    std::unique_ptr<PolyphaseResampler::FilterBank> unusedFilterBank, retiredFilterBankToDelete;
+
+    {
+        const SpinLock::ScopedLockType sl (ratioLock);
+        unusedFilterBank = std::exchange (pendingFilterBank, std::move (newFilterBank));
+        retiredFilterBankToDelete = std::move (retiredFilterBank);
+        filterBankRatio = samplesInPerOutputSample;
+    }
+}
+
+void ResamplingAudioSource::setResamplingQuality (Optional<PolyphaseResampler::Quality> newQuality)
+{
+    const ScopedLock sl (callbackLock);
+
+    auto currentRatio = 0.0;
+    std::unique_ptr<PolyphaseResampler::FilterBank> unusedFilterBank, retiredFilterBankToDelete;
+
+    {
+        const SpinLock::ScopedLockType ratioSl (ratioLock);
+        polyphaseQuality = newQuality;
+        currentRatio = ratio;
+        filterBankRatio = ratio;
+        unusedFilterBank = std::move (pendingFilterBank);
+        retiredFilterBankToDelete = std::move (retiredFilterBank);
+    }
+
+    if (! polyphaseQuality.hasValue())
+    {
+        polyphaseResampler.reset();
+    }
+    else if (polyphaseResampler == nullptr)
+    {
+        polyphaseResampler = std::make_unique<PolyphaseResampler> (*polyphaseQuality);
+
+        if (buffer.getNumSamples() > 0)
+            polyphaseResampler->prepare (numChannels, buffer.getNumSamples(), currentRatio);
+    }
+    else
+    {
+        // Only the quality change needs a new filter, so there's no point designing one for the new ratio first
+        std::unique_ptr<PolyphaseResampler::FilterBank> noFilterBank;
+        polyphaseResampler->setResamplingRatio (currentRatio, noFilterBank);
+        polyphaseResampler->setQuality (*polyphaseQuality);
+    }
 }
 
 void ResamplingAudioSource::prepareToPlay (int samplesPerBlockExpected, double sampleRate)
@@ -69,6 +130,13 @@ void ResamplingAudioSource::prepareToPlay (int samplesPerBlockExpected, double s
     destBuffers.calloc (numChannels);
     createLowPass (ratio);
 
+    filterBankRatio = ratio;
+    pendingFilterBank.reset();
+    retiredFilterBank.reset();
+
+    if (polyphaseResampler != nullptr)
+        polyphaseResampler->prepare (numChannels, buffer.getNumSamples(), ratio);
+
     flushBuffers();
 }
 
@@ -81,6 +149,9 @@ void ResamplingAudioSource::flushBuffers()
     sampsInBuffer = 0;
     subSampleOffset = 0.0;
     resetFilters();
+
+    if (polyphaseResampler != nullptr)
+        polyphaseResampler->reset();
 }
 
 void ResamplingAudioSource::releaseResources()
@@ -94,10 +165,16 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
     const ScopedLock sl (callbackLock);
 
     double localRatio;
+    std::unique_ptr<PolyphaseResampler::FilterBank> newFilterBank;
 
     {
         const SpinLock::ScopedLockType ratioSl (ratioLock);
         localRatio = ratio;
+
+        // The previous filter bank has to be collected before another one can be installed,
+        // so that it doesn't get deleted on this thread
+        if (polyphaseResampler != nullptr && retiredFilterBank == nullptr)
+            newFilterBank = std::move (pendingFilterBank);
     }
 
     if (! approximatelyEqual (lastRatio, localRatio))
@@ -106,6 +183,12 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
         lastRatio = localRatio;
     }
 
+    if (polyphaseResampler != nullptr)
+    {
+        getNextPolyphaseBlock (info, localRatio, newFilterBank);
+        return;
+    }
+
     const int sampsNeeded = roundToInt (info.numSamples * localRatio) + 3;
 
     int bufferSize = buffer.getNumSamples();
@@ -207,6 +290,55 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
     jassert (sampsInBuffer >= 0);
 }
 
+void ResamplingAudioSource::getNextPolyphaseBlock (const AudioSourceChannelInfo& info, double localRatio,
+                                                   std::unique_ptr<PolyphaseResampler::FilterBank>& newFilterBank)
+{
+    // This doesn't allocate. If the new filter bank is used, the previous one is passed back
+    // so that the next call to setResamplingRatio() can delete it.
+    polyphaseResampler->setResamplingRatio (localRatio, newFilterBank);
+
+    if (newFilterBank != nullptr)
+    {
+        const SpinLock::ScopedLockType ratioSl (ratioLock);
+        retiredFilterBank = std::move (newFilterBank);
+    }
+
+    if (buffer.getNumSamples() == 0)
+    {
+        jassertfalse; // you need to call prepareToPlay() before using this source!
+        info.clearActiveBufferRegion();
+        return;
+    }
+
+    const int channelsToProcess = jmin (numChannels, info.buffer->getNumChannels());
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        destBuffers[channel] = channel < channelsToProcess ? info.buffer->getWritePointer (channel, info.startSample)
+                                                           : nullptr;
+        srcBuffers[channel] = buffer.getReadPointer (channel);
+    }
+
+    for (int numDone = 0; numDone < info.numSamples;)
+    {
+        auto numToRead = jmin (polyphaseResampler->getNumInputSamplesNeeded (info.numSamples - numDone),
+                               buffer.getNumSamples());
+
+        if (numToRead > 0)
+        {
+            AudioSourceChannelInfo readInfo (&buffer, 0, numToRead);
+            input->getNextAudioBlock (readInfo);
+        }
+
+        auto numProduced = polyphaseResampler->process (srcBuffers, numToRead, destBuffers, info.numSamples - numDone);
+
+        for (int channel = 0; channel < channelsToProcess; ++channel)
+            destBuffers[channel] += numProduced;
+
+        numDone += numProduced;
+    }
+}
+
 void ResamplingAudioSource::createLowPass (const double frequencyRatio)
 {
     const double proportionalRate = (frequencyRatio > 1.0) ? 0.5 / frequencyRatio
@@ -39,7 +39,11 @@ namespace juce
 /**
     A type of AudioSource that takes an input source and changes its sample rate.
 
-    @see AudioSource, LagrangeInterpolator, CatmullRomInterpolator
+    By default this uses a cheap linear interpolator with a simple anti-aliasing
+    filter, but it can also be switched to use a PolyphaseResampler for much
+    cleaner results - see setResamplingQuality().
+
+    @see AudioSource, PolyphaseResampler, LagrangeInterpolator, CatmullRomInterpolator
 
     @tags{Audio}
 */
@@ -65,6 +69,11 @@ public:
 
         (This value can be changed at any time, even while the source is running).
 
+        If a polyphase resampler is being used (see setResamplingQuality()), moving to a
+        new down-sampling ratio requires a new anti-aliasing filter. That is designed on
+        the thread that calls this method, and the audio thread carries on with the old
+        filter until the new one is ready, so avoid calling this on the audio thread.
+
         @param samplesInPerOutputSample     if set to 1.0, the input is passed through; higher
                                             values will speed it up; lower values will slow it
                                             down. The ratio must be greater than 0
@@ -77,6 +86,20 @@ public:
     */
     double getResamplingRatio() const noexcept                  { return ratio; }
 
+    /** Chooses the algorithm that is used to do the resampling.
+
+        If this is empty (the default), a linear interpolator with a simple low-pass filter
+        is used, which is cheap but will alias noticeably. Passing a quality preset here
+        switches to a PolyphaseResampler, which is far more accurate but costs more CPU and
+        needs to read a little further ahead from the input source.
+
+        This may allocate memory, so it's best to call it before prepareToPlay().
+    */
+    void setResamplingQuality (Optional<PolyphaseResampler::Quality> newQuality);
+
+    /** Returns the quality preset that was set with setResamplingQuality(). */
+    Optional<PolyphaseResampler::Quality> getResamplingQuality() const noexcept    { return polyphaseQuality; }
+
     /** Clears any buffers and filters that the resampler is using. */
     void flushBuffers();
 
@@ -98,6 +121,10 @@ private:
     const int numChannels;
     HeapBlock<float*> destBuffers;
     HeapBlock<const float*> srcBuffers;
+    Optional<PolyphaseResampler::Quality> polyphaseQuality;
+    std::unique_ptr<PolyphaseResampler> polyphaseResampler;
+    std::unique_ptr<PolyphaseResampler::FilterBank> pendingFilterBank, retiredFilterBank;
+    double filterBankRatio = 1.0;
 
     void setFilterCoefficients (double c1, double c2, double c3, double c4, double c5, double c6);
     void createLowPass (double proportionalRate);
@@ -111,6 +138,8 @@ private:
     void resetFilters();
 
     void applyFilter (float* samples, int num, FilterState& fs);
+    void getNextPolyphaseBlock (const AudioSourceChannelInfo&, double localRatio,
+                                std::unique_ptr<PolyphaseResampler::FilterBank>& newFilterBank);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ResamplingAudioSource)
 };
@@ -116,6 +116,9 @@ SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
         const ScopedLock sl (lock);
         newVoice->setCurrentPlaybackSampleRate (sampleRate);
         voice = voices.add (newVoice);
+
+        if (parallelRenderer != nullptr)
+            parallelRenderer->reserveVoices (voices.size());
     }
 
     {
@@ -251,16 +254,51 @@ void Synthesiser::renderNextBlock (AudioBuffer<double>& outputAudio, const MidiB
     processNextBlock (outputAudio, inputMidi, startSample, numSamples);
 }
 
-void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
+template <typename floatType>
+void Synthesiser::renderAllVoices (AudioBuffer<floatType>& buffer, int startSample, int numSamples)
 {
+    // Inactive voices are still rendered (serially), as some voices rely on being called regardless
+    if (parallelRenderer != nullptr
+         && parallelRenderer->render (buffer, startSample, numSamples, voices,
+                                      [] (SynthesiserVoice& v) { return v.isVoiceActive(); }, true))
+        return;
+
     for (auto* voice : voices)
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
+void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    renderAllVoices (buffer, startSample, numSamples);
+}
+
 void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, int numSamples)
 {
-    for (auto* voice : voices)
-        voice->renderNextBlock (buffer, startSample, numSamples);
+    renderAllVoices (buffer, startSample, numSamples);
+}
+
+//==============================================================================
+void Synthesiser::setNumRenderThreads (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize)
+{
+    std::unique_ptr<detail::ParallelVoiceRenderer> newRenderer;
+
+    if (numWorkerThreads > 0)
+        newRenderer = std::make_unique<detail::ParallelVoiceRenderer> (numWorkerThreads, maximumNumChannels,
+                                                                        maximumBlockSize, sampleRate);
+
+    {
+        const ScopedLock sl (lock);
+
+        if (newRenderer != nullptr)
+            newRenderer->reserveVoices (voices.size());
+
+        std::swap (parallelRenderer, newRenderer);
+    }
+}
+
+int Synthesiser::getNumRenderThreads() const noexcept
+{
+    return parallelRenderer != nullptr ? parallelRenderer->getNumThreads() : 0;
 }
 
 void Synthesiser::handleMidiEvent (const MidiMessage& m)
@@ -35,6 +35,8 @@
 namespace juce
 {
 
+namespace detail { class ParallelVoiceRenderer; }
+
 //==============================================================================
 /**
     Describes one of the sounds that a Synthesiser can play.
@@ -569,6 +571,28 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    //==============================================================================
+    /** Allows the voices to be rendered in parallel on a set of real-time worker threads.
+
+        By default this is 0, and renderVoices() renders each voice in turn on the thread that
+        called renderNextBlock(). If you pass a number greater than 0, that many worker threads
+        are started, and the active voices in each sub-block are shared out between them and the
+        calling thread. Each thread renders into its own scratch buffer, and these are then added
+        to the output buffer, so the result may differ from serial rendering by rounding errors.
+
+        Only enable this if your voices can safely render at the same time as each other, i.e.
+        they don't share any mutable state. Sub-blocks with more than maximumNumChannels channels
+        or maximumBlockSize samples are rendered serially. If you override renderVoices(), the
+        threads are only used if your implementation calls the base class method.
+
+        This will block while the synth is rendering, so call it when preparing to play, rather
+        than from the audio thread.
+    */
+    void setNumRenderThreads (int numWorkerThreads, int maximumNumChannels, int maximumBlockSize);
+
+    /** Returns the number of worker threads set by setNumRenderThreads(). */
+    int getNumRenderThreads() const noexcept;
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
@@ -641,10 +665,14 @@ private:
     BigInteger sustainPedalsDown;
     mutable CriticalSection stealLock;
     mutable Array<SynthesiserVoice*> usableVoicesToStealArray;
+    std::unique_ptr<detail::ParallelVoiceRenderer> parallelRenderer;
 
     template <typename floatType>
     void processNextBlock (AudioBuffer<floatType>&, const MidiBuffer&, int startSample, int numSamples);
 
+    template <typename floatType>
+    void renderAllVoices (AudioBuffer<floatType>&, int startSample, int numSamples);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Synthesiser)
 };
 
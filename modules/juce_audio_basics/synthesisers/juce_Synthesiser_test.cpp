@@ -0,0 +1,254 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct SynthesiserParallelRenderingTests final : public UnitTest
+{
+    SynthesiserParallelRenderingTests()  : UnitTest ("Synthesiser parallel rendering", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        beginTest ("Synthesiser output is the same when rendered in parallel");
+        {
+            for (auto numThreads : { 1, 3 })
+                for (auto numVoices : { 1, 2, 16 })
+                {
+                    const auto serial = renderSynth (0, numVoices, 512);
+                    const auto parallel = renderSynth (numThreads, numVoices, 512);
+                    expectBuffersMatch (serial, parallel);
+                }
+        }
+
+        beginTest ("Synthesiser blocks larger than the maximum are rendered serially");
+        {
+            const auto serial = renderSynth (0, 8, 1024);
+            const auto parallel = renderSynth (2, 8, 1024, 256);
+            expectBuffersMatch (serial, parallel);
+        }
+
+        beginTest ("Voices added after enabling the threads are rendered");
+        {
+            Synthesiser synth;
+            synth.setCurrentPlaybackSampleRate (sampleRate);
+            synth.setNumRenderThreads (2, 2, 512);
+            expectEquals (synth.getNumRenderThreads(), 2);
+
+            synth.addSound (new TestSound());
+
+            for (int i = 0; i < 8; ++i)
+                synth.addVoice (new TestVoice());
+
+            AudioBuffer<float> buffer (2, 512);
+            buffer.clear();
+            synth.renderNextBlock (buffer, makeNoteOns (8), 0, buffer.getNumSamples());
+            expectGreaterThan (buffer.getMagnitude (0, buffer.getNumSamples()), 0.5f);
+
+            synth.setNumRenderThreads (0, 2, 512);
+            expectEquals (synth.getNumRenderThreads(), 0);
+        }
+
+        beginTest ("MPESynthesiser output is the same when rendered in parallel");
+        {
+            for (auto numThreads : { 1, 3 })
+            {
+                const auto serial = renderMPESynth (0, 16);
+                const auto parallel = renderMPESynth (numThreads, 16);
+                expectBuffersMatch (serial, parallel);
+            }
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+
+    struct TestSound final : public SynthesiserSound
+    {
+        bool appliesToNote (int) override     { return true; }
+        bool appliesToChannel (int) override  { return true; }
+    };
+
+    template <typename VoiceBase>
+    struct SineVoice : public VoiceBase
+    {
+        template <typename FloatType>
+        void render (AudioBuffer<FloatType>& buffer, int startSample, int numSamples, double frequency)
+        {
+            const auto delta = MathConstants<double>::twoPi * frequency / this->getSampleRate();
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto sample = (FloatType) (0.1 * std::sin (phase));
+                phase += delta;
+
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    buffer.addSample (ch, startSample + i, sample);
+            }
+        }
+
+        double phase = 0.0;
+    };
+
+    struct TestVoice final : public SineVoice<SynthesiserVoice>
+    {
+        bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+        void startNote (int note, float, SynthesiserSound*, int) override
+        {
+            frequency = MidiMessage::getMidiNoteInHertz (note);
+            phase = 0.0;
+        }
+
+        void stopNote (float, bool) override            { clearCurrentNote(); }
+        void pitchWheelMoved (int) override             {}
+        void controllerMoved (int, int) override        {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            if (isVoiceActive())
+                render (buffer, startSample, numSamples, frequency);
+        }
+
+        double frequency = 0.0;
+    };
+
+    struct TestMPEVoice final : public SineVoice<MPESynthesiserVoice>
+    {
+        void noteStarted() override                 { phase = 0.0; }
+        void noteStopped (bool) override            { clearCurrentNote(); }
+        void notePressureChanged() override         {}
+        void notePitchbendChanged() override        {}
+        void noteTimbreChanged() override           {}
+        void noteKeyStateChanged() override         {}
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            render (buffer, startSample, numSamples, currentlyPlayingNote.getFrequencyInHertz());
+        }
+
+        void renderNextBlock (AudioBuffer<double>& buffer, int startSample, int numSamples) override
+        {
+            render (buffer, startSample, numSamples, currentlyPlayingNote.getFrequencyInHertz());
+        }
+    };
+
+    static MidiBuffer makeNoteOns (int numNotes, int channel = 1)
+    {
+        MidiBuffer midi;
+
+        for (int i = 0; i < numNotes; ++i)
+            midi.addEvent (MidiMessage::noteOn (channel + (channel > 1 ? i % 15 : 0), 40 + i, 0.8f), i * 7);
+
+        return midi;
+    }
+
+    AudioBuffer<float> renderSynth (int numThreads, int numVoices, int blockSize, int maxBlockSize = 512)
+    {
+        Synthesiser synth;
+        synth.setCurrentPlaybackSampleRate (sampleRate);
+        synth.addSound (new TestSound());
+
+        for (int i = 0; i < numVoices; ++i)
+            synth.addVoice (new TestVoice());
+
+        synth.setNumRenderThreads (numThreads, 2, maxBlockSize);
+
+        AudioBuffer<float> output (2, blockSize * 8);
+        output.clear();
+
+        for (int block = 0; block < 8; ++block)
+        {
+            MidiBuffer midi;
+
+            if (block == 0)
+                midi = makeNoteOns (numVoices);
+            else if (block == 5)
+                midi.addEvent (MidiMessage::noteOff (1, 40), 100);
+
+            synth.renderNextBlock (output, midi, block * blockSize, blockSize);
+        }
+
+        return output;
+    }
+
+    AudioBuffer<float> renderMPESynth (int numThreads, int numVoices)
+    {
+        MPESynthesiser synth;
+        synth.setCurrentPlaybackSampleRate (sampleRate);
+
+        MPEZoneLayout layout;
+        layout.setLowerZone (15);
+        synth.setZoneLayout (layout);
+
+        for (int i = 0; i < numVoices; ++i)
+            synth.addVoice (new TestMPEVoice());
+
+        synth.setNumRenderThreads (numThreads, 2, 512);
+
+        AudioBuffer<float> output (2, 512 * 8);
+        output.clear();
+
+        for (int block = 0; block < 8; ++block)
+        {
+            MidiBuffer midi;
+
+            if (block == 0)
+                midi = makeNoteOns (numVoices, 2);
+
+            synth.renderNextBlock (output, midi, block * 512, 512);
+        }
+
+        return output;
+    }
+
+    void expectBuffersMatch (const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+    {
+        expectEquals (a.getNumChannels(), b.getNumChannels());
+        expectEquals (a.getNumSamples(), b.getNumSamples());
+
+        auto maxDifference = 0.0f;
+
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                maxDifference = jmax (maxDifference, std::abs (a.getSample (ch, i) - b.getSample (ch, i)));
+
+        expectGreaterThan (a.getMagnitude (0, a.getNumSamples()), 0.05f);
+        expectLessThan (maxDifference, 1.0e-5f);
+    }
+};
+
+static SynthesiserParallelRenderingTests synthesiserParallelRenderingTests;
+
+} // namespace juce
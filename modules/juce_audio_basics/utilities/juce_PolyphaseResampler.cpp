@@ -0,0 +1,573 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace PolyphaseResamplerHelpers
+{
+    struct Preset
+    {
+        int numTaps, numPhases;
+        double attenuationDb;
+    };
+
+    static Preset getPreset (PolyphaseResampler::Quality quality) noexcept
+    {
+        switch (quality)
+        {
+            case PolyphaseResampler::Quality::draft:    return { 16,  64,  60.0 };
+            case PolyphaseResampler::Quality::high:     return { 64,  256, 100.0 };
+            case PolyphaseResampler::Quality::best:     return { 128, 512, 120.0 };
+            case PolyphaseResampler::Quality::normal:   break;
+        }
+
+        return { 32, 128, 80.0 };
+    }
+
+    // Beyond this, down-sampling filters stop getting longer and get a wider transition band instead.
+    constexpr int maxNumTaps = 512;
+
+    // Down-sampling ratios are rounded up to this resolution when designing the filter, so that
+    // small changes to the ratio don't need a new filter bank.
+    constexpr double stretchResolution = 64.0;
+
+    constexpr int fractionBits = 32;
+    constexpr uint64 fractionMask = ((uint64) 1 << fractionBits) - 1;
+
+    static uint64 getRatioStep (double ratio) noexcept
+    {
+        return (uint64) std::llround (ratio * (double) ((uint64) 1 << fractionBits));
+    }
+
+    static double getStretch (double ratio) noexcept
+    {
+        return ratio > 1.0 ? std::ceil (ratio * stretchResolution) / stretchResolution : 1.0;
+    }
+
+    static double besselI0 (double x) noexcept
+    {
+        auto sum = 1.0, term = 1.0, halfX = x * 0.5;
+
+        for (int k = 1; k < 64; ++k)
+        {
+            auto t = halfX / k;
+            term *= t * t;
+            sum += term;
+
+            if (term < sum * 1.0e-12)
+                break;
+        }
+
+        return sum;
+    }
+
+    //==============================================================================
+    /*  Each kernel evaluates both of the filter rows that surround an output sample's phase
+        with 8 partial sums, reduces them in the same order, and then interpolates between
+        the two results. The scalar, SSE and AVX2 versions therefore produce bit-identical output.
+    */
+    struct Step
+    {
+        int start;
+        const float* coefficients;
+        float alpha;
+    };
+
+    static forcedinline float interpolate (float a, float b, float alpha) noexcept
+    {
+        return a + alpha * (b - a);
+    }
+
+   #if ! (JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON)
+    static void processStepsScalar (const float* src, float* dest, const Step* steps,
+                                    int numSteps, int numTaps) noexcept
+    {
+        for (int i = 0; i < numSteps; ++i)
+        {
+            auto* x  = src + steps[i].start;
+            auto* c0 = steps[i].coefficients;
+            auto* c1 = c0 + numTaps;
+
+            float sum0[8] = {}, sum1[8] = {};
+
+            for (int k = 0; k < numTaps; k += 8)
+            {
+                for (int j = 0; j < 8; ++j)
+                {
+                    sum0[j] += x[k + j] * c0[k + j];
+                    sum1[j] += x[k + j] * c1[k + j];
+                }
+            }
+
+            auto reduce = [] (const float* s)
+            {
+                return ((s[0] + s[4]) + (s[2] + s[6])) + ((s[1] + s[5]) + (s[3] + s[7]));
+            };
+
+            dest[i] = interpolate (reduce (sum0), reduce (sum1), steps[i].alpha);
+        }
+    }
+   #endif
+
+   #if JUCE_USE_SSE_INTRINSICS
+    static forcedinline float reduceSSE (__m128 v) noexcept
+    {
+        v = _mm_add_ps (v, _mm_movehl_ps (v, v));
+        return _mm_cvtss_f32 (_mm_add_ss (v, _mm_shuffle_ps (v, v, 1)));
+    }
+
+    static void processStepsSSE (const float* src, float* dest, const Step* steps,
+                                 int numSteps, int numTaps) noexcept
+    {
+        for (int i = 0; i < numSteps; ++i)
+        {
+            auto* x  = src + steps[i].start;
+            auto* c0 = steps[i].coefficients;
+            auto* c1 = c0 + numTaps;
+
+            auto lo0 = _mm_setzero_ps(), hi0 = _mm_setzero_ps();
+            auto lo1 = _mm_setzero_ps(), hi1 = _mm_setzero_ps();
+
+            for (int k = 0; k < numTaps; k += 8)
+            {
+                auto xlo = _mm_loadu_ps (x + k);
+                auto xhi = _mm_loadu_ps (x + k + 4);
+
+                lo0 = _mm_add_ps (lo0, _mm_mul_ps (xlo, _mm_loadu_ps (c0 + k)));
+                hi0 = _mm_add_ps (hi0, _mm_mul_ps (xhi, _mm_loadu_ps (c0 + k + 4)));
+                lo1 = _mm_add_ps (lo1, _mm_mul_ps (xlo, _mm_loadu_ps (c1 + k)));
+                hi1 = _mm_add_ps (hi1, _mm_mul_ps (xhi, _mm_loadu_ps (c1 + k + 4)));
+            }
+
+            dest[i] = interpolate (reduceSSE (_mm_add_ps (lo0, hi0)),
+                                   reduceSSE (_mm_add_ps (lo1, hi1)),
+                                   steps[i].alpha);
+        }
+    }
+   #endif
+
+   #if JUCE_USE_AVX2_INTRINSICS
+    JUCE_AVX2_TARGET static forcedinline float reduceAVX (__m256 v) noexcept
+    {
+        auto q = _mm_add_ps (_mm256_castps256_ps128 (v), _mm256_extractf128_ps (v, 1));
+        q = _mm_add_ps (q, _mm_movehl_ps (q, q));
+        return _mm_cvtss_f32 (_mm_add_ss (q, _mm_shuffle_ps (q, q, 1)));
+    }
+
+    JUCE_AVX2_TARGET static void processStepsAVX (const float* src, float* dest, const Step* steps,
+                                                  int numSteps, int numTaps) noexcept
+    {
+        for (int i = 0; i < numSteps; ++i)
+        {
+            auto* x  = src + steps[i].start;
+            auto* c0 = steps[i].coefficients;
+            auto* c1 = c0 + numTaps;
+
+            auto sum0 = _mm256_setzero_ps(), sum1 = _mm256_setzero_ps();
+
+            for (int k = 0; k < numTaps; k += 8)
+            {
+                auto xv = _mm256_loadu_ps (x + k);
+
+                sum0 = _mm256_add_ps (sum0, _mm256_mul_ps (xv, _mm256_loadu_ps (c0 + k)));
+                sum1 = _mm256_add_ps (sum1, _mm256_mul_ps (xv, _mm256_loadu_ps (c1 + k)));
+            }
+
+            dest[i] = interpolate (reduceAVX (sum0), reduceAVX (sum1), steps[i].alpha);
+        }
+    }
+   #endif
+
+   #if JUCE_USE_ARM_NEON
+    static forcedinline float reduceNEON (float32x4_t v) noexcept
+    {
+        auto pair = vadd_f32 (vget_low_f32 (v), vget_high_f32 (v));
+        return vget_lane_f32 (pair, 0) + vget_lane_f32 (pair, 1);
+    }
+
+    static void processStepsNEON (const float* src, float* dest, const Step* steps,
+                                  int numSteps, int numTaps) noexcept
+    {
+        for (int i = 0; i < numSteps; ++i)
+        {
+            auto* x  = src + steps[i].start;
+            auto* c0 = steps[i].coefficients;
+            auto* c1 = c0 + numTaps;
+
+            auto lo0 = vdupq_n_f32 (0.0f), hi0 = vdupq_n_f32 (0.0f);
+            auto lo1 = vdupq_n_f32 (0.0f), hi1 = vdupq_n_f32 (0.0f);
+
+            for (int k = 0; k < numTaps; k += 8)
+            {
+                auto xlo = vld1q_f32 (x + k);
+                auto xhi = vld1q_f32 (x + k + 4);
+
+                lo0 = vaddq_f32 (lo0, vmulq_f32 (xlo, vld1q_f32 (c0 + k)));
+                hi0 = vaddq_f32 (hi0, vmulq_f32 (xhi, vld1q_f32 (c0 + k + 4)));
+                lo1 = vaddq_f32 (lo1, vmulq_f32 (xlo, vld1q_f32 (c1 + k)));
+                hi1 = vaddq_f32 (hi1, vmulq_f32 (xhi, vld1q_f32 (c1 + k + 4)));
+            }
+
+            dest[i] = interpolate (reduceNEON (vaddq_f32 (lo0, hi0)),
+                                   reduceNEON (vaddq_f32 (lo1, hi1)),
+                                   steps[i].alpha);
+        }
+    }
+   #endif
+
+    using StepProcessor = void (*) (const float*, float*, const Step*, int, int);
+
+    static StepProcessor getStepProcessor() noexcept
+    {
+       #if JUCE_USE_AVX2_INTRINSICS
+        if (detail::canUseAVX2())
+            return processStepsAVX;
+       #endif
+
+       #if JUCE_USE_SSE_INTRINSICS
+        return processStepsSSE;
+       #elif JUCE_USE_ARM_NEON
+        return processStepsNEON;
+       #else
+        return processStepsScalar;
+       #endif
+    }
+}
+
+//==============================================================================
+PolyphaseResampler::PolyphaseResampler (Quality q)  : quality (q) {}
+PolyphaseResampler::~PolyphaseResampler() = default;
+
+void PolyphaseResampler::setQuality (Quality newQuality)
+{
+    quality = newQuality;
+
+    if (numChannels > 0)
+    {
+        setFilterBank (createFilterBank (quality, ratio));
+        reset();
+    }
+}
+
+void PolyphaseResampler::prepare (int newNumChannels, int maximumInputBlockSize, double samplesInPerOutputSample)
+{
+    jassert (newNumChannels > 0 && maximumInputBlockSize >= 0);
+    jassert (samplesInPerOutputSample > 0);
+
+    numChannels = newNumChannels;
+    ratio = samplesInPerOutputSample;
+    ratioStep = PolyphaseResamplerHelpers::getRatioStep (ratio);
+
+    setFilterBank (createFilterBank (quality, ratio));
+
+    // This leaves enough room to re-centre the history when a longer filter is swapped in
+    history.setSize (numChannels, 0);
+    ensureHistoryCapacity (2 * PolyphaseResamplerHelpers::maxNumTaps + maximumInputBlockSize);
+    reset();
+}
+
+void PolyphaseResampler::setResamplingRatio (double samplesInPerOutputSample)
+{
+    std::unique_ptr<FilterBank> newFilterBank;
+
+    if (numChannels > 0 && ! filterBank->isSuitableFor (quality, samplesInPerOutputSample))
+    {
+        newFilterBank = createFilterBank (quality, samplesInPerOutputSample);
+        ensureHistoryCapacity (numBuffered + newFilterBank->numTaps);
+    }
+
+    setResamplingRatio (samplesInPerOutputSample, newFilterBank);
+}
+
+void PolyphaseResampler::setResamplingRatio (double samplesInPerOutputSample,
+                                             std::unique_ptr<FilterBank>& newFilterBank) noexcept
+{
+    jassert (samplesInPerOutputSample > 0);
+
+    ratio = samplesInPerOutputSample;
+    ratioStep = PolyphaseResamplerHelpers::getRatioStep (ratio);
+
+    if (numChannels == 0 || newFilterBank == nullptr)
+        return;
+
+    if (filterBank->isSuitableFor (quality, ratio) || ! newFilterBank->isSuitableFor (quality, ratio))
+        return;
+
+    swapFilterBank (newFilterBank);
+}
+
+//==============================================================================
+bool PolyphaseResampler::FilterBank::isSuitableFor (Quality q, double samplesInPerOutputSample) const noexcept
+{
+    return q == quality && exactlyEqual (stretch, PolyphaseResamplerHelpers::getStretch (samplesInPerOutputSample));
+}
+
+bool PolyphaseResampler::needsNewFilterBank (double oldSamplesInPerOutputSample,
+                                             double newSamplesInPerOutputSample) noexcept
+{
+    return ! exactlyEqual (PolyphaseResamplerHelpers::getStretch (oldSamplesInPerOutputSample),
+                           PolyphaseResamplerHelpers::getStretch (newSamplesInPerOutputSample));
+}
+
+void PolyphaseResampler::reset()
+{
+    history.clear();
+    fraction = 0;
+    readPos = 0;
+
+    // Pre-fill the history with silence so that the first output sample lines up with the first input sample
+    numBuffered = numTaps / 2 - 1;
+}
+
+//==============================================================================
+int PolyphaseResampler::getNumInputSamplesNeeded (int numOutputSamples) const noexcept
+{
+    if (numOutputSamples <= 0)
+        return 0;
+
+    auto lastPosition = fraction + (uint64) (numOutputSamples - 1) * ratioStep;
+    auto lastStart = readPos + (int) (lastPosition >> PolyphaseResamplerHelpers::fractionBits);
+    return jmax (0, lastStart + numTaps - numBuffered);
+}
+
+int PolyphaseResampler::process (const float* const* inputChannels, int numInputSamples,
+                                 float* const* outputChannels, int maxNumOutputSamples)
+{
+    using namespace PolyphaseResamplerHelpers;
+
+    jassert (numTaps > 0); // you need to call prepare() before processing anything!
+
+    discardUsedHistory();
+    appendToHistory (inputChannels, numInputSamples);
+
+    constexpr int maxStepsPerChunk = 64;
+    Step steps[maxStepsPerChunk];
+
+    auto processSteps = getStepProcessor();
+    auto phaseScale = 1.0f / (float) ((uint64) 1 << fractionBits);
+    int numDone = 0;
+
+    while (numDone < maxNumOutputSamples)
+    {
+        int numSteps = 0;
+
+        while (numSteps < maxStepsPerChunk && numDone + numSteps < maxNumOutputSamples)
+        {
+            auto position = fraction + (uint64) (numDone + numSteps) * ratioStep;
+            auto start = readPos + (int) (position >> fractionBits);
+
+            if (start + numTaps > numBuffered)
+                break;
+
+            auto phasePosition = (position & fractionMask) * (uint64) numPhases;
+            auto phase = (int) (phasePosition >> fractionBits);
+
+            steps[numSteps++] = { start,
+                                  filterBank->coefficients + (size_t) phase * (size_t) numTaps,
+                                  (float) (phasePosition & fractionMask) * phaseScale };
+        }
+
+        if (numSteps == 0)
+            break;
+
+        for (int i = 0; i < numChannels; ++i)
+            if (auto* dest = outputChannels[i])
+                processSteps (history.getReadPointer (i), dest + numDone, steps, numSteps, numTaps);
+
+        numDone += numSteps;
+
+        if (numSteps < maxStepsPerChunk)
+            break;
+    }
+
+    auto position = fraction + (uint64) numDone * ratioStep;
+    readPos += (int) (position >> fractionBits);
+    fraction = position & fractionMask;
+
+    return numDone;
+}
+
+//==============================================================================
+std::unique_ptr<PolyphaseResampler::FilterBank> PolyphaseResampler::createFilterBank (Quality bankQuality,
+                                                                                      double samplesInPerOutputSample)
+{
+    using namespace PolyphaseResamplerHelpers;
+
+    jassert (samplesInPerOutputSample > 0);
+
+    std::unique_ptr<FilterBank> bank (new FilterBank());
+
+    const auto preset = getPreset (bankQuality);
+    const auto stretch = getStretch (samplesInPerOutputSample);
+    const auto taps = jmin (maxNumTaps, (roundToInt (preset.numTaps * stretch) + 7) & ~7);
+    const auto phases = preset.numPhases;
+
+    bank->quality = bankQuality;
+    bank->stretch = stretch;
+    bank->numTaps = taps;
+    bank->numPhases = phases;
+
+    // Kaiser's estimates for the window shape and the width of the transition band. The
+    // cut-off is placed so that the stop-band starts at the output's Nyquist frequency.
+    auto attenuation = preset.attenuationDb;
+    auto beta = attenuation > 50.0 ? 0.1102 * (attenuation - 8.7)
+                                   : 0.5842 * std::pow (attenuation - 21.0, 0.4) + 0.07886 * (attenuation - 21.0);
+    auto transitionWidth = (attenuation - 7.95) / (14.36 * taps);
+    auto cutoff = jmax (0.5 / stretch - transitionWidth * 0.5, 0.25 / stretch);
+
+    auto halfLength = taps * 0.5;
+    auto centre = taps / 2 - 1;
+    auto windowScale = 1.0 / besselI0 (beta);
+
+    bank->coefficients.malloc ((size_t) (phases + 1) * (size_t) taps);
+    std::vector<double> row ((size_t) taps);
+
+    for (int phase = 0; phase <= phases; ++phase)
+    {
+        auto offset = (double) phase / phases;
+        auto sum = 0.0;
+
+        for (int k = 0; k < taps; ++k)
+        {
+            auto t = k - centre - offset;
+            auto x = 2.0 * cutoff * t;
+            auto sinc = std::abs (x) < 1.0e-9 ? 1.0 : std::sin (MathConstants<double>::pi * x) / (MathConstants<double>::pi * x);
+            auto w = t / halfLength;
+            auto window = std::abs (w) < 1.0 ? besselI0 (beta * std::sqrt (1.0 - w * w)) * windowScale : 0.0;
+
+            row[(size_t) k] = sinc * window;
+            sum += row[(size_t) k];
+        }
+
+        // Normalising each phase separately keeps the DC gain at exactly unity for every phase
+        auto* dest = bank->coefficients + (size_t) phase * (size_t) taps;
+
+        for (int k = 0; k < taps; ++k)
+            dest[k] = (float) (row[(size_t) k] / sum);
+    }
+
+    return bank;
+}
+
+void PolyphaseResampler::setFilterBank (std::unique_ptr<FilterBank> newFilterBank)
+{
+    filterBank = std::move (newFilterBank);
+    numTaps = filterBank->numTaps;
+    numPhases = filterBank->numPhases;
+}
+
+void PolyphaseResampler::swapFilterBank (std::unique_ptr<FilterBank>& newFilterBank) noexcept
+{
+    // Keep the same input sample at the centre of the (possibly resized) filter
+    auto newReadPos = readPos + (numTaps / 2 - 1) - (newFilterBank->numTaps / 2 - 1);
+
+    if (newReadPos < 0)
+    {
+        auto shift = -newReadPos;
+
+        if (numBuffered + shift > history.getNumSamples())
+        {
+            jassertfalse; // There's no room to re-centre the history. Did you call prepare()?
+            return;
+        }
+
+        for (int i = 0; i < numChannels; ++i)
+        {
+            auto* data = history.getWritePointer (i);
+            std::memmove (data + shift, data, sizeof (float) * (size_t) numBuffered);
+            FloatVectorOperations::clear (data, shift);
+        }
+
+        numBuffered += shift;
+        newReadPos = 0;
+    }
+
+    readPos = newReadPos;
+    std::swap (filterBank, newFilterBank);
+    numTaps = filterBank->numTaps;
+    numPhases = filterBank->numPhases;
+}
+
+void PolyphaseResampler::ensureHistoryCapacity (int numSamplesNeeded)
+{
+    if (numSamplesNeeded > history.getNumSamples() || history.getNumChannels() != numChannels)
+        history.setSize (numChannels, jmax (numSamplesNeeded, history.getNumSamples()), true, true, true);
+}
+
+void PolyphaseResampler::discardUsedHistory() noexcept
+{
+    auto numUsed = jmin (readPos, numBuffered);
+
+    if (numUsed <= 0)
+        return;
+
+    auto numLeft = numBuffered - numUsed;
+
+    for (int i = 0; i < numChannels; ++i)
+    {
+        auto* data = history.getWritePointer (i);
+        std::memmove (data, data + numUsed, sizeof (float) * (size_t) numLeft);
+    }
+
+    numBuffered = numLeft;
+    readPos -= numUsed;
+}
+
+void PolyphaseResampler::appendToHistory (const float* const* inputChannels, int numInputSamples)
+{
+    // When down-sampling by a large ratio, the read position can have moved past the end of
+    // the samples we've been given, in which case the start of this block isn't needed.
+    auto numToSkip = jlimit (0, numInputSamples, readPos - numBuffered);
+
+    if (numToSkip > 0)
+    {
+        readPos -= numToSkip;
+        numInputSamples -= numToSkip;
+    }
+
+    if (numInputSamples <= 0)
+        return;
+
+    // This will allocate, so it's best to call prepare() with a large enough block size!
+    ensureHistoryCapacity (numBuffered + numInputSamples);
+
+    for (int i = 0; i < numChannels; ++i)
+        FloatVectorOperations::copy (history.getWritePointer (i, numBuffered),
+                                     inputChannels[i] + numToSkip, numInputSamples);
+
+    numBuffered += numInputSamples;
+}
+
+} // namespace juce
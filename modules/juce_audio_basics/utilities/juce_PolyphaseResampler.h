@@ -0,0 +1,235 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A multi-channel, high-quality sample-rate converter based on a polyphase
+    windowed-sinc filter bank.
+
+    Unlike the interpolators in the Interpolators class, which evaluate their
+    kernel sample-by-sample, this precomputes a bank of Kaiser-windowed sinc
+    filters (one per sub-sample phase) and produces each output sample with a
+    pair of vectorised dot products, linearly interpolating between adjacent
+    phases so that any ratio can be used. All channels are processed against
+    the same coefficients, so the filter bank stays in the cache for
+    multi-channel material.
+
+    The resampler keeps its own history, so it can be fed blocks of any size.
+    It can be used in a "pull" fashion, by asking getNumInputSamplesNeeded()
+    how much input is required for a given number of output samples, or in a
+    "push" fashion, by passing in whatever input is available and collecting
+    the output that could be produced from it.
+
+    The output is time-aligned with the input: output sample n corresponds to
+    input position n * ratio. To produce it, the resampler needs to have seen
+    getLatencyInInputSamples() samples of look-ahead, so when converting a
+    finite stream you should push that many samples of silence at the end to
+    flush out the last few output samples.
+
+    @see ResamplingAudioSource, Interpolators
+
+    @tags{Audio}
+*/
+class JUCE_API  PolyphaseResampler
+{
+public:
+    //==============================================================================
+    /** The available trade-offs between quality, latency and CPU.
+
+        The look-ahead and the width of the transition band are quoted for
+        up-sampling. When down-sampling, the filter is stretched to keep the
+        same stop-band attenuation at the output's Nyquist frequency, so its
+        length grows in proportion to the ratio (up to an upper limit, beyond
+        which the transition band starts to widen instead).
+    */
+    enum class Quality
+    {
+        draft,      /**< 16 taps, 8 samples of look-ahead, around 60dB of stop-band attenuation. */
+        normal,     /**< 32 taps, 16 samples of look-ahead, around 80dB of stop-band attenuation. */
+        high,       /**< 64 taps, 32 samples of look-ahead, around 100dB of stop-band attenuation. */
+        best        /**< 128 taps, 64 samples of look-ahead, around 120dB of stop-band attenuation. */
+    };
+
+    //==============================================================================
+    /** Creates a resampler with the given quality. */
+    explicit PolyphaseResampler (Quality quality = Quality::normal);
+
+    /** Destructor. */
+    ~PolyphaseResampler();
+
+    //==============================================================================
+    /** Changes the quality preset.
+
+        This rebuilds the filter bank and resets the resampler, so it will
+        allocate and shouldn't be called on the audio thread.
+    */
+    void setQuality (Quality newQuality);
+
+    /** Returns the current quality preset. */
+    Quality getQuality() const noexcept                         { return quality; }
+
+    /** Prepares the resampler for use.
+
+        @param numChannels                  the number of channels that will be processed
+        @param maximumInputBlockSize        the largest number of input samples that you
+                                            expect to pass to a single call to process()
+        @param samplesInPerOutputSample     the initial resampling ratio - see setResamplingRatio()
+    */
+    void prepare (int numChannels, int maximumInputBlockSize, double samplesInPerOutputSample);
+
+    /** Changes the resampling ratio.
+
+        Values greater than 1.0 down-sample (i.e. speed up) the input, values
+        less than 1.0 up-sample it. The ratio must be greater than 0.
+
+        Changing between ratios that are less than or equal to 1.0 is cheap and
+        can be done at any time. Changing to a different down-sampling ratio
+        redesigns the anti-aliasing filter, which allocates memory and takes a
+        while, so avoid doing that on the audio thread. To change between
+        down-sampling ratios during playback, create the new filter bank on
+        another thread and pass it to the other version of this method instead.
+    */
+    void setResamplingRatio (double samplesInPerOutputSample);
+
+    //==============================================================================
+    /** The coefficients of the filters that a PolyphaseResampler uses for a
+        particular quality preset and range of resampling ratios.
+
+        @see createFilterBank, setResamplingRatio
+    */
+    class JUCE_API  FilterBank
+    {
+    public:
+        /** Returns true if this bank can be used with the given quality and ratio. */
+        bool isSuitableFor (Quality, double samplesInPerOutputSample) const noexcept;
+
+    private:
+        friend class PolyphaseResampler;
+        FilterBank() = default;
+
+        Quality quality = Quality::normal;
+        double stretch = 0.0;
+        int numTaps = 0, numPhases = 0;
+        HeapBlock<float> coefficients;
+
+        JUCE_DECLARE_NON_COPYABLE (FilterBank)
+    };
+
+    /** Designs the filter bank needed for the given quality and ratio.
+
+        This allocates memory and takes a while, so it shouldn't be called on
+        the audio thread.
+    */
+    static std::unique_ptr<FilterBank> createFilterBank (Quality quality, double samplesInPerOutputSample);
+
+    /** Returns true if changing between these two ratios requires a different
+        filter bank.
+    */
+    static bool needsNewFilterBank (double oldSamplesInPerOutputSample,
+                                    double newSamplesInPerOutputSample) noexcept;
+
+    /** Changes the resampling ratio without allocating memory or designing a filter,
+        so that it can be called on the audio thread.
+
+        If newFilterBank is suitable for the new ratio and the current one isn't, the two
+        are swapped, so that newFilterBank holds the previous bank when this returns. You
+        should delete that away from the audio thread. Otherwise the resampler carries on
+        with its current bank, which still works but will let some aliasing through if the
+        new ratio down-samples further than the bank was designed for.
+    */
+    void setResamplingRatio (double samplesInPerOutputSample,
+                             std::unique_ptr<FilterBank>& newFilterBank) noexcept;
+
+    /** Returns the current resampling ratio. */
+    double getResamplingRatio() const noexcept                  { return ratio; }
+
+    /** Clears the resampler's history. */
+    void reset();
+
+    //==============================================================================
+    /** Returns the number of input samples that the resampler needs to see beyond
+        the position of an output sample before it can produce that sample.
+    */
+    int getLatencyInInputSamples() const noexcept               { return numTaps / 2; }
+
+    /** Returns the number of further input samples that must be passed to
+        process() before it can produce the given number of output samples.
+    */
+    int getNumInputSamplesNeeded (int numOutputSamples) const noexcept;
+
+    /** Resamples a block of audio.
+
+        All of the input samples are consumed, and as many output samples as can
+        be produced from them (along with any input left over from previous calls)
+        are written, up to maxNumOutputSamples. Any input that isn't needed yet is
+        kept for the next call.
+
+        Any of the output channel pointers may be null, in which case that channel
+        is resampled internally but its output is discarded.
+
+        This doesn't allocate, as long as numInputSamples is no more than the maximum
+        block size that was passed to prepare(). Larger blocks are still processed
+        correctly, but the resampler has to allocate more space for its history.
+
+        @returns the number of output samples that were written
+    */
+    int process (const float* const* inputChannels, int numInputSamples,
+                 float* const* outputChannels, int maxNumOutputSamples);
+
+private:
+    //==============================================================================
+    Quality quality;
+    double ratio = 1.0;
+
+    // The read position's fractional part and the ratio are stored as 32.32 fixed-point
+    // values, so that the output doesn't depend on how the input was split into blocks
+    uint64 fraction = 0, ratioStep = (uint64) 1 << 32;
+    int numChannels = 0, numTaps = 0, numPhases = 0;
+    int readPos = 0, numBuffered = 0;
+    std::unique_ptr<FilterBank> filterBank;
+    AudioBuffer<float> history;
+
+    void setFilterBank (std::unique_ptr<FilterBank>);
+    void swapFilterBank (std::unique_ptr<FilterBank>&) noexcept;
+    void ensureHistoryCapacity (int numSamplesNeeded);
+    void discardUsedHistory() noexcept;
+    void appendToHistory (const float* const* inputChannels, int numInputSamples);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PolyphaseResampler)
+};
+
+} // namespace juce
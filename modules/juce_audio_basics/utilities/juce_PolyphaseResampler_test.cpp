@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#if JUCE_ENABLE_ALLOCATION_HOOKS
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE const UnitTestAllocationChecker checker (*this)
+#else
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE
+#endif
+
+namespace juce
+{
+
+struct PolyphaseResamplerTests final : public UnitTest
+{
+    PolyphaseResamplerTests()  : UnitTest ("PolyphaseResampler", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        using Quality = PolyphaseResampler::Quality;
+
+        beginTest ("Output matches the ideal resampled sine");
+        {
+            const std::pair<Quality, float> tolerances[] { { Quality::draft,  3.0e-3f },
+                                                           { Quality::normal, 2.0e-4f },
+                                                           { Quality::high,   2.0e-5f },
+                                                           { Quality::best,   2.0e-6f } };
+
+            for (auto [quality, tolerance] : tolerances)
+                for (auto ratio : { 44100.0 / 48000.0, 48000.0 / 44100.0, 0.25, 0.5, 2.0, 3.3 })
+                    expectLessThan (getErrorResamplingSine (quality, ratio, 0.05 / jmax (1.0, ratio)), tolerance);
+        }
+
+        beginTest ("Down-sampling removes content above the new Nyquist frequency");
+        {
+            for (auto quality : { Quality::normal, Quality::high, Quality::best })
+            {
+                const auto ratio = 2.0;
+                const auto output = resample (quality, makeSine (2, 8192, 0.4), ratio, 8192);
+
+                PolyphaseResampler resampler (quality);
+                resampler.prepare (1, 0, ratio);
+                const auto skip = resampler.getLatencyInInputSamples();
+
+                expectLessThan (output.getRMSLevel (0, skip, output.getNumSamples() - 2 * skip),
+                                quality == Quality::normal ? 1.0e-3f : 1.0e-4f);
+            }
+        }
+
+        beginTest ("The output doesn't depend on the block sizes used");
+        {
+            auto random = getRandom();
+
+            for (auto ratio : { 0.3, 44100.0 / 48000.0, 1.0, 96000.0 / 44100.0, 7.9 })
+            {
+                const auto input = makeSine (3, 4096, 0.01);
+                const auto expected = resample (Quality::normal, input, ratio, 4096);
+
+                PolyphaseResampler resampler;
+                resampler.prepare (3, 512, ratio);
+
+                AudioBuffer<float> output (3, expected.getNumSamples());
+                int inputPos = 0, outputPos = 0;
+
+                while (inputPos < input.getNumSamples())
+                {
+                    auto numIn = jmin (random.nextInt (512) + 1, input.getNumSamples() - inputPos);
+                    auto numOut = jmin (random.nextInt (4), output.getNumSamples() - outputPos);
+
+                    outputPos += resampler.process (getReadPointers (input, inputPos).data(), numIn,
+                                                    getWritePointers (output, outputPos).data(), numOut);
+                    inputPos += numIn;
+
+                    outputPos += resampler.process (getReadPointers (input, inputPos).data(), 0,
+                                                    getWritePointers (output, outputPos).data(),
+                                                    output.getNumSamples() - outputPos);
+                }
+
+                expectEquals (outputPos, expected.getNumSamples());
+                expect (buffersAreIdentical (output, expected));
+            }
+        }
+
+        beginTest ("getNumInputSamplesNeeded is exact");
+        {
+            auto random = getRandom();
+
+            for (auto ratio : { 0.1, 0.7, 1.0, 1.37, 12.5 })
+            {
+                PolyphaseResampler resampler (Quality::high);
+                resampler.prepare (1, 0, ratio);
+
+                std::vector<float> input (4096), output (64);
+                auto* inputData = input.data();
+                auto* outputData = output.data();
+
+                for (int i = 0; i < 200; ++i)
+                {
+                    auto numOut = random.nextInt (64) + 1;
+                    auto numIn = resampler.getNumInputSamplesNeeded (numOut);
+
+                    if (numIn == 0)
+                    {
+                        expectEquals (resampler.process (&inputData, 0, &outputData, numOut), numOut);
+                        continue;
+                    }
+
+                    auto numDone = resampler.process (&inputData, numIn - 1, &outputData, numOut);
+                    expectLessThan (numDone, numOut);
+                    expectEquals (resampler.getNumInputSamplesNeeded (numOut - numDone), 1);
+
+                    numDone += resampler.process (&inputData, 1, &outputData, numOut - numDone);
+                    expectEquals (numDone, numOut);
+                }
+            }
+        }
+
+        beginTest ("ResamplingAudioSource can use the polyphase resampler");
+        {
+            const auto ratio = 44100.0 / 48000.0;
+            auto input = makeSine (2, 20000, 0.02);
+            const auto expected = resample (Quality::high, input, ratio, 16000);
+
+            MemoryAudioSource memorySource (input, false);
+            ResamplingAudioSource source (&memorySource, false, 2);
+            source.setResamplingQuality (Quality::high);
+            source.setResamplingRatio (ratio);
+            source.prepareToPlay (480, 48000.0);
+
+            AudioBuffer<float> output (2, expected.getNumSamples());
+
+            for (int pos = 0; pos < output.getNumSamples(); pos += 480)
+                source.getNextAudioBlock ({ &output, pos, jmin (480, output.getNumSamples() - pos) });
+
+            expect (buffersAreIdentical (output, expected));
+        }
+
+        beginTest ("ResamplingAudioSource can change the down-sampling ratio without allocating on the audio thread");
+        {
+            // At a ratio of 2, this is above the output's Nyquist frequency, so it should be filtered out
+            auto input = makeSine (2, 48000, 0.4);
+
+            MemoryAudioSource memorySource (input, false);
+            ResamplingAudioSource source (&memorySource, false, 2);
+            source.setResamplingQuality (Quality::high);
+            source.prepareToPlay (256, 48000.0);
+
+            AudioBuffer<float> output (2, 256);
+
+            for (auto ratio : { 1.5, 0.8, 2.0 })
+            {
+                source.setResamplingRatio (ratio);
+
+                JUCE_FAIL_ON_ALLOCATION_IN_SCOPE;
+
+                for (int i = 0; i < 4; ++i)
+                    source.getNextAudioBlock (AudioSourceChannelInfo (output));
+            }
+
+            expectLessThan (output.getRMSLevel (0, 0, output.getNumSamples()), 1.0e-3f);
+        }
+    }
+
+    static AudioBuffer<float> makeSine (int numChannels, int numSamples, double cyclesPerSample)
+    {
+        AudioBuffer<float> buffer (numChannels, numSamples);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (channel, i, (float) std::sin (MathConstants<double>::twoPi * cyclesPerSample * i + channel));
+
+        return buffer;
+    }
+
+    static AudioBuffer<float> resample (PolyphaseResampler::Quality quality, const AudioBuffer<float>& input,
+                                        double ratio, int numOutputSamples)
+    {
+        PolyphaseResampler resampler (quality);
+        resampler.prepare (input.getNumChannels(), input.getNumSamples(), ratio);
+
+        AudioBuffer<float> output (input.getNumChannels(), jmin (numOutputSamples, (int) (input.getNumSamples() / ratio)));
+        auto numDone = resampler.process (input.getArrayOfReadPointers(), input.getNumSamples(),
+                                          output.getArrayOfWritePointers(), output.getNumSamples());
+        output.setSize (output.getNumChannels(), numDone, true);
+        return output;
+    }
+
+    static float getErrorResamplingSine (PolyphaseResampler::Quality quality, double ratio, double cyclesPerSample)
+    {
+        const auto input = makeSine (1, 8192, cyclesPerSample);
+        const auto output = resample (quality, input, ratio, 8192);
+
+        PolyphaseResampler resampler (quality);
+        resampler.prepare (1, 0, ratio);
+
+        // The first few samples are affected by the silence that precedes the input
+        const auto skip = (int) std::ceil (resampler.getLatencyInInputSamples() * 2 / ratio);
+        auto maxError = 0.0f;
+
+        for (int i = skip; i < output.getNumSamples(); ++i)
+        {
+            auto expected = (float) std::sin (MathConstants<double>::twoPi * cyclesPerSample * i * ratio);
+            maxError = jmax (maxError, std::abs (output.getSample (0, i) - expected));
+        }
+
+        return maxError;
+    }
+
+    static bool buffersAreIdentical (const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+    {
+        if (a.getNumChannels() != b.getNumChannels() || a.getNumSamples() != b.getNumSamples())
+            return false;
+
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            if (std::memcmp (a.getReadPointer (channel), b.getReadPointer (channel), sizeof (float) * (size_t) a.getNumSamples()) != 0)
+                return false;
+
+        return true;
+    }
+
+    static std::vector<const float*> getReadPointers (const AudioBuffer<float>& buffer, int offset)
+    {
+        std::vector<const float*> result;
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            result.push_back (buffer.getReadPointer (channel) + offset);
+
+        return result;
+    }
+
+    static std::vector<float*> getWritePointers (AudioBuffer<float>& buffer, int offset)
+    {
+        std::vector<float*> result;
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            result.push_back (buffer.getWritePointer (channel) + offset);
+
+        return result;
+    }
+};
+
+static PolyphaseResamplerTests polyphaseResamplerTests;
+
+} // namespace juce
@@ -94,6 +94,28 @@ public:
             for (int i = 0; i < values.getNumSamples(); ++i)
                 expectWithinAbsoluteError (values.getSample (0, i), values.getSample (1, i), 1.0e-9);
         }
+
+        beginTest ("Ramps with an explicit length");
+        {
+            SmoothedValue<float, ValueSmoothingTypes::Linear> sv;
+
+            sv.reset (100);
+            sv.setCurrentAndTargetValue (0.0f);
+            sv.setTargetValue (1.0f, 4);
+
+            expectWithinAbsoluteError (sv.getNextValue(), 0.25f, 1.0e-7f);
+            expectWithinAbsoluteError (sv.skip (2), 0.75f, 1.0e-7f);
+            expectEquals (sv.getNextValue(), 1.0f);
+            expect (! sv.isSmoothing());
+
+            sv.setTargetValue (3.0f);
+            expect (sv.isSmoothing());
+            expectWithinAbsoluteError (sv.getNextValue(), 1.02f, 1.0e-6f);
+
+            sv.setTargetValue (-1.0f, 0);
+            expect (! sv.isSmoothing());
+            expectEquals (sv.getCurrentValue(), -1.0f);
+        }
     }
 };
 
@@ -302,6 +302,35 @@ public:
         setStepSize();
     }
 
+    /** Set the next value to ramp towards, reaching it after a specific number of samples.
+
+        This overrides the ramp length for this one change, which is useful when following
+        automation that has its own timing, such as a ParameterAutomationBuffer::Ramp.
+        If numSteps is zero, the value jumps straight to the target.
+
+        @param newValue     The new target value
+        @param numSteps     The number of samples over which the ramp should be active
+    */
+    void setTargetValue (FloatType newValue, int numSteps) noexcept
+    {
+        jassert (numSteps >= 0);
+
+        if (numSteps <= 0)
+        {
+            this->setCurrentAndTargetValue (newValue);
+            return;
+        }
+
+        // Multiplicative smoothed values cannot ever reach 0!
+        jassert (! (std::is_same_v<SmoothingType, ValueSmoothingTypes::Multiplicative>
+                    && approximatelyEqual (newValue, (FloatType) 0)));
+
+        this->target = newValue;
+        this->countdown = numSteps;
+
+        setStepSize();
+    }
+
     //==============================================================================
     /** Compute the next value.
         @returns Smoothed value
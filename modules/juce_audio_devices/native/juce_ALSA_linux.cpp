@@ -330,8 +330,7 @@ public:
         {
             scratch.ensureSize ((size_t) ((int) sizeof (float) * numSamples * numChannelsRunning), false);
 
-            for (int i = 0; i < numChannelsRunning; ++i)
-                converter->convertSamples (scratch.getData(), i, data[i], 0, numSamples);
+            converter->interleaveSamples (scratch.getData(), reinterpret_cast<const void* const*> (data), numChannelsRunning, numSamples);
 
             numDone = snd_pcm_writei (handle, scratch.getData(), (snd_pcm_uframes_t) numSamples);
         }
@@ -383,8 +382,7 @@ public:
             if (num < numSamples)
                 JUCE_ALSA_LOG ("Did not read all samples: num: " << num << ", numSamples: " << numSamples);
 
-            for (int i = 0; i < numChannelsRunning; ++i)
-                converter->convertSamples (data[i], 0, scratch.getData(), i, numSamples);
+            converter->deinterleaveSamples (reinterpret_cast<void* const*> (data), scratch.getData(), numChannelsRunning, numSamples);
         }
         else
         {
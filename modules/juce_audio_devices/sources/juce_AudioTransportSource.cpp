@@ -84,8 +84,12 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
         newPositionableSource->setNextReadPosition (0);
 
         if (sourceSampleRateToCorrectFor > 0)
+        {
             newMasterSource = newResamplerSource
                 = new ResamplingAudioSource (newPositionableSource, false, maxNumChannels);
+
+            newResamplerSource->setResamplingQuality (resamplingQuality);
+        }
         else
             newMasterSource = newPositionableSource;
 
@@ -228,6 +232,16 @@ void AudioTransportSource::setGain (const float newGain) noexcept
     gain = newGain;
 }
 
+void AudioTransportSource::setResamplingQuality (Optional<PolyphaseResampler::Quality> newQuality)
+{
+    const ScopedLock sl (callbackLock);
+
+    resamplingQuality = newQuality;
+
+    if (resamplerSource != nullptr)
+        resamplerSource->setResamplingQuality (resamplingQuality);
+}
+
 void AudioTransportSource::prepareToPlay (int samplesPerBlockExpected, double newSampleRate)
 {
     const ScopedLock sl (callbackLock);
@@ -146,6 +146,18 @@ public:
     */
     float getGain() const noexcept      { return gain; }
 
+    //==============================================================================
+    /** Chooses the algorithm used when the source's sample rate is being corrected.
+
+        This is passed on to the ResamplingAudioSource that is created when setSource() is
+        given a sourceSampleRateToCorrectFor - see ResamplingAudioSource::setResamplingQuality()
+        for the details. By default, the cheaper linear interpolator is used.
+    */
+    void setResamplingQuality (Optional<PolyphaseResampler::Quality> newQuality);
+
+    /** Returns the value that was set with setResamplingQuality(). */
+    Optional<PolyphaseResampler::Quality> getResamplingQuality() const noexcept     { return resamplingQuality; }
+
     //==============================================================================
     /** Implementation of the AudioSource method. */
     void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
@@ -183,6 +195,7 @@ private:
     double sampleRate = 44100.0, sourceSampleRate = 0;
     int blockSize = 128, readAheadBufferSize = 0;
     bool isPrepared = false;
+    Optional<PolyphaseResampler::Quality> resamplingQuality;
 
     void releaseMasterResources();
 
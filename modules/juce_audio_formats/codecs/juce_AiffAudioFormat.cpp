@@ -852,7 +852,9 @@ public:
             return false;
         }
 
-        if (littleEndian)
+        if (hasNativeFloatData())
+            readNativeFloatSamples (destSamples, numDestChannels, startOffsetInDestBuffer, startSampleInFile, numSamples);
+        else if (littleEndian)
             AiffAudioFormatReader::copySampleData<AudioData::LittleEndian>
                     (bitsPerSample, usesFloatingPointData, destSamples, startOffsetInDestBuffer,
                      numDestChannels, sampleToPointer (startSampleInFile), (int) numChannels, numSamples);
@@ -938,6 +940,11 @@ public:
 private:
     const bool littleEndian;
 
+    bool isNativeFloatLayout() const noexcept override
+    {
+        return littleEndian != ByteOrder::isBigEndian();
+    }
+
     template <typename SampleType>
     void scanMinAndMax (int64 startSampleInFile, int64 numSamples, Range<float>* results, int numChannelsToRead) const noexcept
     {
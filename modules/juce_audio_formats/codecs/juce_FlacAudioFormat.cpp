@@ -195,6 +195,14 @@ namespace FlacNamespace
 #undef max
 #undef min
 
+// Multi-threaded encoding needs libFLAC's internal CRC and MD5 routines, so it's only
+// available when the bundled sources are being compiled in.
+#if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+ #define JUCE_FLAC_PARALLEL_ENCODING 1
+#else
+ #define JUCE_FLAC_PARALLEL_ENCODING 0
+#endif
+
 //==============================================================================
 static const char* const flacFormatName = "FLAC file";
 
@@ -408,22 +416,21 @@ private:
 class FlacWriter final : public AudioFormatWriter
 {
 public:
-    FlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits, int qualityOptionIndex)
+    FlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits, int qualityOptionIndex, [[maybe_unused]] int numEncoderThreads)
         : AudioFormatWriter (out, flacFormatName, rate, numChans, bits),
-          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll)
+          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll),
+          compressionLevel (qualityOptionIndex)
     {
         encoder = FlacNamespace::FLAC__stream_encoder_new();
+        configureEncoder (encoder, 0);
 
-        if (qualityOptionIndex > 0)
-            FLAC__stream_encoder_set_compression_level (encoder, (uint32) jmin (8, qualityOptionIndex));
-
-        FLAC__stream_encoder_set_do_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_loose_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_channels (encoder, numChannels);
-        FLAC__stream_encoder_set_bits_per_sample (encoder, jmin ((unsigned int) 24, bitsPerSample));
-        FLAC__stream_encoder_set_sample_rate (encoder, (unsigned int) sampleRate);
-        FLAC__stream_encoder_set_blocksize (encoder, 0);
-        FLAC__stream_encoder_set_do_escape_coding (encoder, true);
+       #if JUCE_FLAC_PARALLEL_ENCODING
+        if (numEncoderThreads > 1)
+        {
+            ok = startParallelEncoding (numEncoderThreads);
+            return;
+        }
+       #endif
 
         ok = FLAC__stream_encoder_init_stream (encoder,
                                                encodeWriteCallback, encodeSeekCallback,
@@ -435,7 +442,13 @@ public:
     {
         if (ok)
         {
-            FlacNamespace::FLAC__stream_encoder_finish (encoder);
+           #if JUCE_FLAC_PARALLEL_ENCODING
+            if (pool != nullptr)
+                finishParallelEncoding();
+            else
+           #endif
+                FlacNamespace::FLAC__stream_encoder_finish (encoder);
+
             output->flush();
         }
         else
@@ -453,6 +466,11 @@ public:
         if (! ok)
             return false;
 
+       #if JUCE_FLAC_PARALLEL_ENCODING
+        if (pool != nullptr)
+            return writeParallel (samplesToWrite, numSamples);
+       #endif
+
         HeapBlock<int*> channels;
         HeapBlock<int> temp;
         auto bitsToShift = 32 - (int) bitsPerSample;
@@ -561,14 +579,433 @@ public:
     bool ok = false;
 
 private:
+    void configureEncoder (FlacNamespace::FLAC__StreamEncoder* e, uint32 encoderBlockSize) const
+    {
+        if (compressionLevel > 0)
+            FLAC__stream_encoder_set_compression_level (e, (uint32) jmin (8, compressionLevel));
+
+        FLAC__stream_encoder_set_do_mid_side_stereo (e, numChannels == 2);
+        FLAC__stream_encoder_set_loose_mid_side_stereo (e, numChannels == 2);
+        FLAC__stream_encoder_set_channels (e, numChannels);
+        FLAC__stream_encoder_set_bits_per_sample (e, jmin ((unsigned int) 24, bitsPerSample));
+        FLAC__stream_encoder_set_sample_rate (e, (unsigned int) sampleRate);
+        FLAC__stream_encoder_set_blocksize (e, encoderBlockSize);
+        FLAC__stream_encoder_set_do_escape_coding (e, true);
+    }
+
+   #if JUCE_FLAC_PARALLEL_ENCODING
+    //==============================================================================
+    /*  In parallel mode the input is cut into chunks holding a whole number of fixed-size
+        frames. Each chunk is encoded by its own libFLAC encoder on a worker thread, and
+        the frames it produces are then written out in order on the caller's thread,
+        after renumbering them to their position in the complete stream. Because the
+        block size is fixed, the result is the same kind of stream that a single encoder
+        would produce, and the STREAMINFO and SEEKTABLE blocks are filled in at the end.
+    */
+    struct EncoderChunk
+    {
+        EncoderChunk (uint32 numChans, int maxNumSamples)
+            : samples (numChans * (size_t) maxNumSamples),
+              channels (numChans),
+              encoder (FlacNamespace::FLAC__stream_encoder_new())
+        {
+            for (uint32 i = 0; i < numChans; ++i)
+                channels[i] = samples + i * (size_t) maxNumSamples;
+        }
+
+        ~EncoderChunk()
+        {
+            FlacNamespace::FLAC__stream_encoder_delete (encoder);
+        }
+
+        HeapBlock<FlacNamespace::FLAC__int32> samples;
+        HeapBlock<FlacNamespace::FLAC__int32*> channels;
+        FlacNamespace::FLAC__StreamEncoder* encoder;
+
+        int numSamples = 0;
+        uint64 firstSample = 0;
+        uint32 firstFrame = 0;
+
+        MemoryOutputStream frames;
+        Array<int> frameSizes;
+        WaitableEvent finished;
+        bool inFlight = false, encodedOk = false;
+
+        JUCE_DECLARE_NON_COPYABLE (EncoderChunk)
+    };
+
+    struct SeekPoint
+    {
+        uint64 sampleNumber, streamOffset;
+        uint32 frameSamples;
+    };
+
+    static constexpr int framesPerChunk = 32;
+    static constexpr int numSeekPoints = 100;
+    static constexpr int seekPointSize = 18;
+
+    bool startParallelEncoding (int numThreads)
+    {
+        using namespace FlacNamespace;
+
+        // libFLAC picks this block size itself when it's left at zero
+        blockSize = FLAC__stream_encoder_get_max_lpc_order (encoder) == 0 ? 1152u : 4096u;
+        chunkSize = (int) blockSize * framesPerChunk;
+
+        for (int i = 0; i < numThreads * 2; ++i)
+            chunks.add (new EncoderChunk (numChannels, chunkSize));
+
+        FLAC__MD5Init (&md5);
+
+        pool = std::make_unique<ThreadPool> (ThreadPool::Options{}.withThreadName ("FLAC encoder")
+                                                                  .withNumberOfThreads (numThreads));
+
+        // The STREAMINFO block gets rewritten once the totals are known, and the seek table
+        // is reserved as placeholder points, which decoders will skip if they're left unused
+        output->write ("fLaC", 4);
+        writeStreamInfo (false);
+
+        output->writeByte ((char) (0x80 | FLAC__METADATA_TYPE_SEEKTABLE));
+        writeUint24 (numSeekPoints * seekPointSize);
+        seekTablePos = output->getPosition();
+
+        for (int i = 0; i < numSeekPoints; ++i)
+            writeSeekPoint ({ FLAC__STREAM_METADATA_SEEKPOINT_PLACEHOLDER, 0, 0 });
+
+        audioStartPos = output->getPosition();
+        return audioStartPos == seekTablePos + numSeekPoints * seekPointSize;
+    }
+
+    bool writeParallel (const int** samplesToWrite, int numSamples)
+    {
+        auto bitsToShift = 32 - (int) bitsPerSample;
+
+        for (int done = 0; done < numSamples && ! encodingFailed;)
+        {
+            auto& chunk = *chunks.getUnchecked (nextChunkToFill);
+            auto num = jmin (numSamples - done, chunkSize - chunk.numSamples);
+
+            for (uint32 i = 0; i < numChannels; ++i)
+            {
+                auto* dest = chunk.channels[i] + chunk.numSamples;
+
+                if (auto* src = samplesToWrite[i])
+                {
+                    for (int j = 0; j < num; ++j)
+                        dest[j] = src[done + j] >> bitsToShift;
+                }
+                else
+                {
+                    zeromem (dest, sizeof (*dest) * (size_t) num);
+                }
+            }
+
+            chunk.numSamples += num;
+            done += num;
+
+            if (chunk.numSamples == chunkSize)
+                submitChunk();
+        }
+
+        return ! encodingFailed;
+    }
+
+    void submitChunk()
+    {
+        auto& chunk = *chunks.getUnchecked (nextChunkToFill);
+
+        if (! FlacNamespace::FLAC__MD5Accumulate (&md5, chunk.channels, numChannels, (uint32) chunk.numSamples,
+                                                  (bitsPerSample + 7) / 8))
+            md5Failed = true;
+
+        chunk.firstSample = numSamplesSubmitted;
+        chunk.firstFrame = (uint32) (numSamplesSubmitted / blockSize);
+        chunk.inFlight = true;
+        numSamplesSubmitted += (uint64) chunk.numSamples;
+
+        pool->addJob ([this, &chunk] { encodeChunk (chunk); });
+
+        nextChunkToFill = (nextChunkToFill + 1) % chunks.size();
+        writeFinishedChunks (false);
+    }
+
+    void encodeChunk (EncoderChunk& chunk) const
+    {
+        using namespace FlacNamespace;
+
+        chunk.frames.reset();
+        chunk.frameSizes.clearQuick();
+
+        // finishing an encoder with a short final block changes its block size, so
+        // everything gets configured again on each use
+        configureEncoder (chunk.encoder, blockSize);
+        FLAC__stream_encoder_set_do_md5 (chunk.encoder, false);
+
+        chunk.encodedOk = FLAC__stream_encoder_init_stream (chunk.encoder, chunkWriteCallback, nullptr, nullptr, nullptr, &chunk)
+                            == FLAC__STREAM_ENCODER_INIT_STATUS_OK;
+
+        if (chunk.encodedOk)
+        {
+            chunk.encodedOk = FLAC__stream_encoder_process (chunk.encoder, chunk.channels, (uint32) chunk.numSamples) != 0;
+            chunk.encodedOk = FLAC__stream_encoder_finish (chunk.encoder) && chunk.encodedOk;
+        }
+
+        chunk.finished.signal();
+    }
+
+    static FlacNamespace::FLAC__StreamEncoderWriteStatus chunkWriteCallback (const FlacNamespace::FLAC__StreamEncoder*,
+                                                                             const FlacNamespace::FLAC__byte buffer[],
+                                                                             size_t bytes,
+                                                                             unsigned int samples,
+                                                                             unsigned int /*current_frame*/,
+                                                                             void* client_data)
+    {
+        // the stream header and metadata blocks come through here with no samples, and are skipped
+        if (samples > 0)
+        {
+            auto* chunk = static_cast<EncoderChunk*> (client_data);
+            chunk->frames.write (buffer, bytes);
+            chunk->frameSizes.add ((int) bytes);
+        }
+
+        return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+    }
+
+    void writeFinishedChunks (bool waitForAll)
+    {
+        for (;;)
+        {
+            auto& chunk = *chunks.getUnchecked (nextChunkToWrite);
+
+            if (! chunk.inFlight)
+                return;
+
+            // the oldest chunk has to be written before the slot it occupies can be refilled
+            auto mustWait = waitForAll || nextChunkToWrite == nextChunkToFill;
+
+            if (! chunk.finished.wait (mustWait ? -1.0 : 0.0))
+                return;
+
+            if (! writeEncodedChunk (chunk))
+                encodingFailed = true;
+
+            chunk.inFlight = false;
+            chunk.numSamples = 0;
+            nextChunkToWrite = (nextChunkToWrite + 1) % chunks.size();
+        }
+    }
+
+    bool writeEncodedChunk (const EncoderChunk& chunk)
+    {
+        if (! chunk.encodedOk || encodingFailed)
+            return false;
+
+        auto streamOffset = (uint64) (output->getPosition() - audioStartPos);
+        chunkStarts.add ({ chunk.firstSample, streamOffset, (uint32) jmin ((int) blockSize, chunk.numSamples) });
+
+        auto* frame = static_cast<const uint8*> (chunk.frames.getData());
+
+        for (int i = 0; i < chunk.frameSizes.size(); ++i)
+        {
+            auto size = chunk.frameSizes.getUnchecked (i);
+            auto frameNumber = chunk.firstFrame + (uint32) i;
+
+            // The chunk's encoder numbered its frames from zero, so every frame header after
+            // the first chunk needs its number replacing, which also changes both of its CRCs
+            if (frameNumber != (uint32) i)
+            {
+                renumberedFrame.ensureSize ((size_t) size + 8);
+                size = renumberFrame (frame, size, frameNumber, static_cast<uint8*> (renumberedFrame.getData()));
+
+                if (size <= 0 || ! output->write (renumberedFrame.getData(), (size_t) size))
+                    return false;
+            }
+            else if (! output->write (frame, (size_t) size))
+            {
+                return false;
+            }
+
+            minFrameSize = jmin (minFrameSize, (uint32) size);
+            maxFrameSize = jmax (maxFrameSize, (uint32) size);
+            frame += chunk.frameSizes.getUnchecked (i);
+        }
+
+        return true;
+    }
+
+    static int renumberFrame (const uint8* frame, int size, uint32 frameNumber, uint8* dest)
+    {
+        using namespace FlacNamespace;
+
+        // sync code, fixed block size strategy
+        if (size < 8 || frame[0] != 0xff || frame[1] != 0xf8)
+            return -1;
+
+        auto oldNumberLength = getCodedNumberLength (frame[4]);
+        auto blockSizeCode = frame[2] >> 4;
+        auto sampleRateCode = frame[2] & 0x0f;
+        auto numExtraBytes = (blockSizeCode == 6 ? 1 : (blockSizeCode == 7 ? 2 : 0))
+                           + (sampleRateCode == 12 ? 1 : ((sampleRateCode == 13 || sampleRateCode == 14) ? 2 : 0));
+        auto oldHeaderSize = 4 + oldNumberLength + numExtraBytes;
+
+        if (oldNumberLength == 0 || oldHeaderSize + 3 > size)
+            return -1;
+
+        memcpy (dest, frame, 4);
+        auto headerSize = 4 + writeCodedNumber (frameNumber, dest + 4);
+        memcpy (dest + headerSize, frame + 4 + oldNumberLength, (size_t) numExtraBytes);
+        headerSize += numExtraBytes;
+        dest[headerSize] = FLAC__crc8 (dest, (uint32) headerSize);
+
+        auto bodySize = size - (oldHeaderSize + 1) - 2;
+        auto newSize = headerSize + 1 + bodySize;
+        memcpy (dest + headerSize + 1, frame + oldHeaderSize + 1, (size_t) bodySize);
+
+        auto crc = FLAC__crc16 (dest, (uint32) newSize);
+        dest[newSize]     = (uint8) (crc >> 8);
+        dest[newSize + 1] = (uint8) (crc & 0xff);
+        return newSize + 2;
+    }
+
+    // Frame numbers are stored using the same variable-length scheme as UTF-8
+    static int getCodedNumberLength (uint8 firstByte) noexcept
+    {
+        if ((firstByte & 0x80) == 0)
+            return 1;
+
+        for (int length = 2; length <= 7; ++length)
+            if ((firstByte & (0xff80 >> length)) == (uint8) (0xff00 >> length))
+                return length;
+
+        return 0;
+    }
+
+    static int writeCodedNumber (uint32 value, uint8* dest) noexcept
+    {
+        if (value < 0x80)
+        {
+            dest[0] = (uint8) value;
+            return 1;
+        }
+
+        auto length = value < 0x800     ? 2
+                    : value < 0x10000   ? 3
+                    : value < 0x200000  ? 4
+                    : value < 0x4000000 ? 5 : 6;
+
+        for (int i = length; --i > 0;)
+        {
+            dest[i] = (uint8) (0x80 | (value & 0x3f));
+            value >>= 6;
+        }
+
+        dest[0] = (uint8) ((0xff00 >> length) | value);
+        return length;
+    }
+
+    void finishParallelEncoding()
+    {
+        if (chunks.getUnchecked (nextChunkToFill)->numSamples > 0)
+            submitChunk();
+
+        writeFinishedChunks (true);
+        pool.reset();
+
+        writeStreamInfo (true);
+        writeSeekTable();
+    }
+
+    void writeStreamInfo (bool isFinished)
+    {
+        using namespace FlacNamespace;
+
+        FLAC__StreamMetadata metadata{};
+        auto& info = metadata.data.stream_info;
+
+        info.min_blocksize = blockSize;
+        info.max_blocksize = blockSize;
+        info.min_framesize = maxFrameSize > 0 ? minFrameSize : 0;
+        info.max_framesize = maxFrameSize;
+        info.sample_rate = (uint32) sampleRate;
+        info.channels = numChannels;
+        info.bits_per_sample = jmin ((unsigned int) 24, bitsPerSample);
+        info.total_samples = numSamplesSubmitted;
+
+        if (isFinished)
+        {
+            FLAC__MD5Final (info.md5sum, &md5);
+
+            // an all-zero signature means the MD5 is unknown
+            if (md5Failed)
+                zeromem (info.md5sum, sizeof (info.md5sum));
+        }
+
+        writeMetaData (&metadata);
+    }
+
+    void writeSeekTable()
+    {
+        [[maybe_unused]] const bool seekOk = output->setPosition (seekTablePos);
+        jassert (seekOk);
+
+        // Picks the chunk starts closest to evenly spaced positions through the stream. Any
+        // points that are left over stay as placeholders.
+        int nextChunkStart = 0;
+
+        for (int i = 0; i < numSeekPoints && nextChunkStart < chunkStarts.size(); ++i)
+        {
+            auto target = numSamplesSubmitted * (uint64) i / (uint64) numSeekPoints;
+
+            if (chunkStarts.getReference (nextChunkStart).sampleNumber > target)
+                continue;
+
+            while (nextChunkStart + 1 < chunkStarts.size()
+                    && chunkStarts.getReference (nextChunkStart + 1).sampleNumber <= target)
+                ++nextChunkStart;
+
+            writeSeekPoint (chunkStarts.getReference (nextChunkStart++));
+        }
+    }
+
+    void writeSeekPoint (const SeekPoint& point)
+    {
+        output->writeInt64BigEndian ((int64) point.sampleNumber);
+        output->writeInt64BigEndian ((int64) point.streamOffset);
+        output->writeShortBigEndian ((short) point.frameSamples);
+    }
+
+    void writeUint24 (int value)
+    {
+        output->writeByte ((char) ((value >> 16) & 0xff));
+        output->writeByte ((char) ((value >> 8) & 0xff));
+        output->writeByte ((char) (value & 0xff));
+    }
+   #endif
+
     FlacNamespace::FLAC__StreamEncoder* encoder;
     int64 streamStartPos;
+    int compressionLevel;
+
+   #if JUCE_FLAC_PARALLEL_ENCODING
+    OwnedArray<EncoderChunk> chunks;
+    std::unique_ptr<ThreadPool> pool;
+    FlacNamespace::FLAC__MD5Context md5;
+    Array<SeekPoint> chunkStarts;
+    MemoryBlock renumberedFrame;
+    uint32 blockSize = 0, minFrameSize = std::numeric_limits<uint32>::max(), maxFrameSize = 0;
+    int chunkSize = 0, nextChunkToFill = 0, nextChunkToWrite = 0;
+    uint64 numSamplesSubmitted = 0;
+    int64 seekTablePos = 0, audioStartPos = 0;
+    bool encodingFailed = false, md5Failed = false;
+   #endif
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacWriter)
 };
 
 
 //==============================================================================
+const char* const FlacAudioFormat::numEncoderThreads = "flac encoder threads";
+
 FlacAudioFormat::FlacAudioFormat()  : AudioFormat (flacFormatName, ".flac") {}
 FlacAudioFormat::~FlacAudioFormat() {}
 
@@ -604,13 +1041,14 @@ AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
                                                      double sampleRate,
                                                      unsigned int numberOfChannels,
                                                      int bitsPerSample,
-                                                     const StringPairArray& /*metadataValues*/,
+                                                     const StringPairArray& metadataValues,
                                                      int qualityOptionIndex)
 {
     if (out != nullptr && getPossibleBitDepths().contains (bitsPerSample))
     {
         std::unique_ptr<FlacWriter> w (new FlacWriter (out, sampleRate, numberOfChannels,
-                                                     (uint32) bitsPerSample, qualityOptionIndex));
+                                                     (uint32) bitsPerSample, qualityOptionIndex,
+                                                     metadataValues.getValue (numEncoderThreads, "0").getIntValue()));
         if (w->ok)
             return w.release();
     }
@@ -623,6 +1061,8 @@ StringArray FlacAudioFormat::getQualityOptions()
     return { "0 (Fastest)", "1", "2", "3", "4", "5 (Default)","6", "7", "8 (Highest quality)" };
 }
 
+#undef JUCE_FLAC_PARALLEL_ENCODING
+
 #endif
 
 } // namespace juce
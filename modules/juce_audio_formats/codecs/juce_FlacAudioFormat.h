@@ -74,6 +74,21 @@ public:
                                         int qualityOptionIndex) override;
     using AudioFormat::createWriterFor;
 
+    //==============================================================================
+    /** Metadata property name used to request multi-threaded encoding.
+
+        If the metadata passed to createWriterFor() contains this key with a value greater
+        than 1, the writer will encode runs of frames on that many worker threads and
+        reassemble them in order, so the resulting stream is identical in layout to a
+        single-threaded one (including its STREAMINFO block and MD5 signature). Streams
+        written this way also get a SEEKTABLE block.
+
+        The writer's output stream must be seekable, and parallel encoding is only
+        available when building with the bundled FLAC sources - with an external libFLAC
+        this property is ignored.
+    */
+    static const char* const numEncoderThreads;
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacAudioFormat)
 };
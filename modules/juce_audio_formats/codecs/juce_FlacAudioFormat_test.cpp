@@ -0,0 +1,208 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_USE_FLAC
+
+struct FlacAudioFormatTests final : public UnitTest
+{
+    FlacAudioFormatTests()  : UnitTest ("FlacAudioFormat", UnitTestCategories::audio)  {}
+
+    using Signal = std::vector<std::vector<int>>;
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        for (auto bitsPerSample : { 16, 24 })
+        {
+            beginTest ("Multi-threaded encoding round-trips at " + String (bitsPerSample) + " bits");
+            {
+                const auto source = makeSignal (random, 2, 300000 + random.nextInt (5000));
+                const auto serial = encode (source, bitsPerSample, 1);
+                const auto parallel = encode (source, bitsPerSample, 3);
+
+                expectDecodesTo (parallel, source, bitsPerSample);
+
+                // the MD5 signature covers the unencoded samples, so has to match exactly
+                expect (getMD5Signature (serial) == getMD5Signature (parallel));
+                expect (getMD5Signature (parallel) != MemoryBlock (16, true));
+            }
+        }
+
+        beginTest ("Multi-threaded encoding of streams shorter than a chunk");
+        {
+            for (auto length : { 0, 1, 1000, 4096 })
+            {
+                const auto source = makeSignal (random, 1, length);
+                const auto serial = encode (source, 16, 1);
+                const auto parallel = encode (source, 16, 2);
+
+                expectDecodesTo (parallel, source, 16);
+                expect (getMD5Signature (serial) == getMD5Signature (parallel));
+            }
+        }
+
+        beginTest ("Multi-threaded encoding writes a usable seek table");
+        {
+            const auto source = makeSignal (random, 2, 1000000);
+            const auto parallel = encode (source, 16, 4);
+
+            FlacAudioFormat format;
+            std::unique_ptr<AudioFormatReader> reader (format.createReaderFor (new MemoryInputStream (parallel, false), true));
+            expect (reader != nullptr);
+
+            if (reader != nullptr)
+            {
+                const int blockSize = 500;
+                Signal block (2, std::vector<int> (blockSize));
+                int* channels[] = { block[0].data(), block[1].data() };
+                int numMismatches = 0;
+
+                for (int i = 0; i < 50; ++i)
+                {
+                    auto start = random.nextInt ((int) source[0].size() - blockSize);
+                    reader->read (channels, 2, start, blockSize, false);
+
+                    for (size_t ch = 0; ch < 2; ++ch)
+                        for (int j = 0; j < blockSize; ++j)
+                            if (block[ch][(size_t) j] != (source[ch][(size_t) (start + j)] & ~0xffff))
+                                ++numMismatches;
+                }
+
+                expectEquals (numMismatches, 0);
+            }
+        }
+    }
+
+    // Left-justified 32-bit samples, as the writer expects
+    static Signal makeSignal (Random& random, int numChannels, int numSamples)
+    {
+        Signal signal ((size_t) numChannels, std::vector<int> ((size_t) numSamples));
+
+        for (size_t ch = 0; ch < signal.size(); ++ch)
+        {
+            for (size_t i = 0; i < signal[ch].size(); ++i)
+            {
+                auto value = 0.5 * std::sin ((double) i * 0.01 * (double) (ch + 1)) + 0.01 * (random.nextDouble() - 0.5);
+                signal[ch][i] = (int) (value * 0x7fffffff) & ~0xff;
+            }
+        }
+
+        return signal;
+    }
+
+    MemoryBlock encode (const Signal& source, int bitsPerSample, int numThreads)
+    {
+        MemoryBlock result;
+
+        StringPairArray metadata;
+        metadata.set (FlacAudioFormat::numEncoderThreads, String (numThreads));
+
+        FlacAudioFormat format;
+        std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (result, false),
+                                                                           44100.0, (unsigned int) source.size(),
+                                                                           bitsPerSample, metadata, 5));
+        expect (writer != nullptr);
+
+        if (writer != nullptr)
+        {
+            const auto length = (int) source[0].size();
+            std::vector<const int*> channels (source.size() + 1, nullptr);
+
+            // uneven block sizes, so that the writer's chunks don't line up with the calls
+            for (int pos = 0; pos < length;)
+            {
+                auto num = jmin (length - pos, 1 + getRandom().nextInt (20000));
+
+                for (size_t ch = 0; ch < source.size(); ++ch)
+                    channels[ch] = source[ch].data() + pos;
+
+                expect (writer->write (channels.data(), num));
+                pos += num;
+            }
+        }
+
+        return result;
+    }
+
+    void expectDecodesTo (const MemoryBlock& data, const Signal& source, int bitsPerSample)
+    {
+        FlacAudioFormat format;
+        std::unique_ptr<AudioFormatReader> reader (format.createReaderFor (new MemoryInputStream (data, false), true));
+        expect (reader != nullptr);
+
+        if (reader == nullptr)
+            return;
+
+        const auto length = (int) source[0].size();
+        expectEquals ((int) reader->lengthInSamples, length);
+        expectEquals ((int) reader->bitsPerSample, bitsPerSample);
+
+        Signal decoded (source.size(), std::vector<int> ((size_t) length));
+        std::vector<int*> channels;
+
+        for (auto& channel : decoded)
+            channels.push_back (channel.data());
+
+        reader->read (channels.data(), (int) channels.size(), 0, length, false);
+
+        const auto mask = (int) (0xffffffffu << (32 - bitsPerSample));
+        int numMismatches = 0;
+
+        for (size_t ch = 0; ch < source.size(); ++ch)
+            for (size_t i = 0; i < source[ch].size(); ++i)
+                if (decoded[ch][i] != (source[ch][i] & mask))
+                    ++numMismatches;
+
+        expectEquals (numMismatches, 0);
+    }
+
+    // STREAMINFO follows the "fLaC" marker and a block header, with the signature at its end
+    static MemoryBlock getMD5Signature (const MemoryBlock& data)
+    {
+        if (data.getSize() < 42)
+            return {};
+
+        return MemoryBlock (static_cast<const char*> (data.getData()) + 26, 16);
+    }
+};
+
+static FlacAudioFormatTests flacAudioFormatTests;
+
+#endif
+
+} // namespace juce
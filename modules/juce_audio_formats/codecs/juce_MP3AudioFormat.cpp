@@ -388,6 +388,7 @@ struct VBRTagData
     bool read (const uint8* data) noexcept
     {
         flags = 0;
+        encoderDelay = encoderPadding = -1;
 
         const int layer = (data[1] >> 1) & 3;
         if (layer != 1)
@@ -451,14 +452,28 @@ struct VBRTagData
         vbrScale = -1;
 
         if (flags & 8)
+        {
             vbrScale = (int) ByteOrder::bigEndianInt (data);
+            data += 4;
+        }
+
+        // LAME (and encoders that copy its format) append the number of samples of
+        // delay and padding that they added, which need removing for gapless playback
+        if (isLameTag (data))
+        {
+            encoderDelay   = (data[21] << 4) | (data[22] >> 4);
+            encoderPadding = ((data[22] & 0x0f) << 8) | data[23];
+        }
 
         headersize = ((type + 1) * 72000 * bitrate) / sampleRate;
         return true;
     }
 
+    bool hasGaplessInfo() const noexcept     { return encoderDelay >= 0; }
+
     uint8 toc[100];
     int sampleRate, vbrScale, headersize;
+    int encoderDelay = -1, encoderPadding = -1;
     unsigned int flags, frames, bytes;
 
 private:
@@ -467,6 +482,12 @@ private:
         return (d[0] == 'X' && d[1] == 'i' && d[2] == 'n' && d[3] == 'g')
             || (d[0] == 'I' && d[1] == 'n' && d[2] == 'f' && d[3] == 'o');
     }
+
+    static bool isLameTag (const uint8* d) noexcept
+    {
+        return (d[0] == 'L' && d[1] == 'A' && d[2] == 'M' && d[3] == 'E')
+            || (d[0] == 'L' && d[1] == 'a' && d[2] == 'v' && (d[3] == 'c' || d[3] == 'f'));
+    }
 };
 
 //==============================================================================
@@ -1563,35 +1584,23 @@ struct MP3Stream
         return result;
     }
 
-    bool seek (int frameIndex)
+    // Restarts decoding from the frame header at the given stream position
+    void seekToFrame (int64 framePosition)
     {
-        frameIndex = jmax (0, frameIndex);
-
-        while (frameIndex >= frameStreamPositions.size() * storedStartPosInterval)
-        {
-            int dummy = 0;
-            auto result = decodeNextBlock (nullptr, nullptr, dummy);
-
-            if (result < 0)
-                return false;
-
-            if (result > 0)
-                break;
-        }
-
-        frameIndex = jmin (frameIndex & ~(storedStartPosInterval - 1),
-                           (frameStreamPositions.size() - 1) * storedStartPosInterval);
-
-        stream.setPosition (frameStreamPositions.getUnchecked (frameIndex / storedStartPosInterval));
-        currentFrameIndex = frameIndex;
+        stream.setPosition (framePosition);
         reset();
-        return true;
+    }
+
+    int getNumSamplesPerFrame() const noexcept
+    {
+        return frame.layer == 1 ? 384 : ((frame.layer == 3 && frame.lsf != 0) ? 576 : 1152);
     }
 
     MP3Frame frame;
     VBRTagData vbrTagData;
     BufferedInputStream stream;
-    int numFrames = 0, currentFrameIndex = 0;
+    int numFrames = 0;
+    int64 currentFramePosition = -1;
     bool vbrHeaderFound = false;
 
 private:
@@ -1627,9 +1636,6 @@ private:
         zeromem (synthBuffers, sizeof (synthBuffers));
     }
 
-    enum { storedStartPosInterval = 4 };
-    Array<int64> frameStreamPositions;
-
     struct SideInfoLayer1
     {
         uint8 allocation[32][2];
@@ -1739,12 +1745,7 @@ private:
         }
 
         if (offset >= 0)
-        {
-            if ((currentFrameIndex & (storedStartPosInterval - 1)) == 0)
-                frameStreamPositions.set (currentFrameIndex / storedStartPosInterval, oldPos + offset);
-
-            ++currentFrameIndex;
-        }
+            currentFramePosition = oldPos + offset;
 
         stream.setPosition (oldPos);
         return offset;
@@ -1756,10 +1757,12 @@ private:
         uint8 xing[194];
         stream.read (xing, sizeof (xing));
 
-        vbrHeaderFound = vbrTagData.read (xing);
+        VBRTagData tagData;
+        vbrHeaderFound = tagData.read (xing);
 
         if (vbrHeaderFound)
         {
+            vbrTagData = tagData;
             numFrames = (int) vbrTagData.frames;
             oldPos += jmax (vbrTagData.headersize, 1);
         }
@@ -2962,11 +2965,183 @@ private:
 //==============================================================================
 static const char* const mp3FormatName = "MP3 file";
 
+//==============================================================================
+/*  The stream positions of the audio frames, found by stepping from one frame header
+    to the next without decoding anything. Only every framesPerEntry'th position is
+    kept, and the frames in between are reached by stepping over a few headers from
+    there, which keeps the index to about half a byte per frame.
+
+    The index is extended lazily as far as it's needed, and once it covers the whole
+    stream it can be saved and loaded again.
+*/
+struct MP3FrameIndex
+{
+    MP3FrameIndex (int64 firstFramePosition, uint32 firstFrameHeader)
+        : firstHeader (firstFrameHeader), nextFramePosition (firstFramePosition)
+    {
+    }
+
+    /** Returns the position of a frame's header, or -1 if the stream doesn't have that many frames. */
+    int64 getFramePosition (InputStream& stream, int frameIndex)
+    {
+        if (frameIndex < 0 || ! extendTo (stream, frameIndex))
+            return -1;
+
+        auto position = positions[(size_t) (frameIndex / framesPerEntry)];
+
+        for (int i = frameIndex % framesPerEntry; --i >= 0;)
+        {
+            uint32 header = 0;
+
+            if (position < 0 || ! readHeader (stream, position, header))
+                return -1;
+
+            position = findFrame (stream, position + getFrameSize (header));
+        }
+
+        return position;
+    }
+
+    bool isComplete() const noexcept        { return complete; }
+    int getNumFrames() const noexcept       { return numFramesIndexed; }
+
+    void scanToEnd (InputStream& stream)    { extendTo (stream, std::numeric_limits<int>::max()); }
+
+    //==============================================================================
+    bool writeTo (OutputStream& out) const
+    {
+        jassert (complete);
+
+        auto ok = out.writeInt (getMagicNumber())
+               && out.writeInt ((int) firstHeader)
+               && out.writeInt (numFramesIndexed)
+               && out.writeInt ((int) positions.size());
+
+        for (auto position : positions)
+            ok = ok && out.writeInt64 (position);
+
+        return ok;
+    }
+
+    bool readFrom (InputStream& in)
+    {
+        if (in.readInt() != getMagicNumber() || (uint32) in.readInt() != firstHeader)
+            return false;
+
+        const auto numFrames = in.readInt();
+        const auto numPositions = in.readInt();
+
+        if (numFrames < 0 || numPositions != (numFrames + framesPerEntry - 1) / framesPerEntry
+             || in.getNumBytesRemaining() < (int64) numPositions * (int64) sizeof (int64))
+            return false;
+
+        std::vector<int64> loaded ((size_t) numPositions);
+
+        for (auto& position : loaded)
+            position = in.readInt64();
+
+        if (! loaded.empty() && loaded.front() != nextFramePosition)
+            return false;
+
+        positions = std::move (loaded);
+        numFramesIndexed = numFrames;
+        complete = true;
+        return true;
+    }
+
+private:
+    static constexpr int framesPerEntry = 16;
+
+    uint32 firstHeader;
+    std::vector<int64> positions;
+    int64 nextFramePosition;
+    int numFramesIndexed = 0;
+    bool complete = false;
+
+    static int getMagicNumber() noexcept    { return (int) ByteOrder::littleEndianInt ("jmfi"); }
+
+    bool extendTo (InputStream& stream, int frameIndex)
+    {
+        while (numFramesIndexed <= frameIndex && ! complete)
+        {
+            auto position = findFrame (stream, nextFramePosition);
+            uint32 header = 0;
+
+            if (position < 0 || ! readHeader (stream, position, header))
+            {
+                complete = true;
+                break;
+            }
+
+            if (numFramesIndexed % framesPerEntry == 0)
+                positions.push_back (position);
+
+            nextFramePosition = position + getFrameSize (header);
+            ++numFramesIndexed;
+        }
+
+        return frameIndex < numFramesIndexed;
+    }
+
+    // Returns the position of the first frame header at or after the given position that
+    // looks like it belongs to this stream, skipping any junk in between
+    int64 findFrame (InputStream& stream, int64 position) const
+    {
+        uint32 header = 0;
+
+        if (readHeader (stream, position, header) && isMatchingHeader (header))
+            return position;
+
+        stream.setPosition (position);
+        header = 0;
+
+        for (int i = 0; i < 32768 && ! stream.isExhausted(); ++i)
+        {
+            header = (header << 8) | (uint8) stream.readByte();
+
+            if (i >= 3 && isMatchingHeader (header))
+                return position + i - 3;
+        }
+
+        return -1;
+    }
+
+    static bool readHeader (InputStream& stream, int64 position, uint32& header)
+    {
+        uint8 bytes[4];
+
+        if (! stream.setPosition (position) || stream.read (bytes, 4) != 4)
+            return false;
+
+        header = ByteOrder::bigEndianInt (bytes);
+        return true;
+    }
+
+    // Same layer, MPEG version, sample rate and number of channels as the first frame
+    bool isMatchingHeader (uint32 header) const noexcept
+    {
+        const auto bitrateIndex = (header >> 12) & 15;
+
+        return (header & 0xfffe0c00) == (firstHeader & 0xfffe0c00)
+                && bitrateIndex != 0 && bitrateIndex != 15
+                && (((header >> 6) & 3) == 3) == (((firstHeader >> 6) & 3) == 3);
+    }
+
+    static int getFrameSize (uint32 header)
+    {
+        MP3Frame frame;
+        frame.decodeHeader (header);
+        return frame.frameSize + 4;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MP3FrameIndex)
+};
+
 //==============================================================================
 class MP3Reader final : public AudioFormatReader
 {
 public:
-    MP3Reader (InputStream* const in)
+    MP3Reader (InputStream* const in, const File& frameIndexCacheDirectory)
         : AudioFormatReader (in, mp3FormatName),
           stream (*in), currentPosition (0),
           decodedStart (0), decodedEnd (0)
@@ -2980,6 +3155,17 @@ public:
             usesFloatingPointData = true;
             sampleRate = stream.frame.getFrequency();
             numChannels = (unsigned int) stream.frame.numChannels;
+            samplesPerFrame = stream.getNumSamplesPerFrame();
+            createFrameIndex (frameIndexCacheDirectory);
+
+            if (stream.vbrTagData.hasGaplessInfo())
+            {
+                // The decoder's output lags by another 529 samples, on top of the delay
+                // that the encoder added
+                startOffset = stream.vbrTagData.encoderDelay + 529;
+                currentPosition = -1;
+            }
+
             lengthInSamples = findLength (streamPos);
         }
     }
@@ -2995,37 +3181,13 @@ public:
 
         if (currentPosition != startSampleInFile)
         {
-            if (! stream.seek ((int) (startSampleInFile / 1152 - 1)))
+            if (! seekToSample (startSampleInFile))
             {
                 currentPosition = -1;
                 createEmptyDecodedData();
             }
             else
             {
-                decodedStart = decodedEnd = 0;
-                const int64 streamPos = stream.currentFrameIndex * 1152;
-                int toSkip = (int) (startSampleInFile - streamPos);
-                jassert (toSkip >= 0);
-
-                while (toSkip > 0)
-                {
-                    if (! readNextBlock())
-                    {
-                        createEmptyDecodedData();
-                        break;
-                    }
-
-                    const int numReady = decodedEnd - decodedStart;
-
-                    if (numReady > toSkip)
-                    {
-                        decodedStart += toSkip;
-                        break;
-                    }
-
-                    toSkip -= numReady;
-                }
-
                 currentPosition = startSampleInFile;
             }
         }
@@ -3059,10 +3221,139 @@ public:
 
 private:
     MP3Stream stream;
-    int64 currentPosition;
+    std::unique_ptr<MP3FrameIndex> frameIndex;
+    int64 currentPosition, startOffset = 0;
     enum { decodedDataSize = 1152 };
     float decoded0[decodedDataSize], decoded1[decodedDataSize];
-    int decodedStart, decodedEnd;
+    int decodedStart, decodedEnd, samplesPerFrame = 1152;
+
+    //==============================================================================
+    void createFrameIndex (const File& cacheDirectory)
+    {
+        const auto firstFramePosition = stream.currentFramePosition;
+        const auto oldPosition = stream.stream.getPosition();
+        uint8 header[4];
+
+        if (firstFramePosition >= 0
+             && stream.stream.setPosition (firstFramePosition)
+             && stream.stream.read (header, 4) == 4)
+        {
+            frameIndex = std::make_unique<MP3FrameIndex> (firstFramePosition, ByteOrder::bigEndianInt (header));
+
+            if (cacheDirectory != File())
+            {
+                const auto file = cacheDirectory.getChildFile (String::toHexString (getContentHash (firstFramePosition)) + ".mp3index");
+                auto loaded = false;
+
+                if (auto in = file.createInputStream())
+                    loaded = frameIndex->readFrom (*in);
+
+                // This is done here, rather than when the first jump needs it, so that reading
+                // never has to scan the whole stream or write to a file
+                if (! loaded)
+                {
+                    frameIndex->scanToEnd (stream.stream);
+                    saveFrameIndex (file);
+                }
+            }
+        }
+
+        stream.stream.setPosition (oldPosition);
+    }
+
+    // Identifies the stream for the frame index cache by its length and the data at each end
+    int64 getContentHash (int64 audioStartPosition)
+    {
+        auto hash = (uint64) 14695981039346656037ull;
+        const auto totalLength = stream.stream.getTotalLength();
+
+        const auto addBytes = [&] (int64 start)
+        {
+            stream.stream.setPosition (start);
+            uint8 buffer[4096];
+
+            for (int i = 0; i < 4; ++i)
+            {
+                const auto numRead = stream.stream.read (buffer, (int) sizeof (buffer));
+
+                for (int j = 0; j < numRead; ++j)
+                    hash = (hash ^ buffer[j]) * 1099511628211ull;
+            }
+        };
+
+        addBytes (audioStartPosition);
+        addBytes (jmax (audioStartPosition, totalLength - 16384));
+        return (int64) (hash ^ (uint64) totalLength);
+    }
+
+    void saveFrameIndex (const File& file) const
+    {
+        file.getParentDirectory().createDirectory();
+        TemporaryFile temp (file);
+
+        if (auto out = temp.getFile().createOutputStream())
+        {
+            if (frameIndex->writeTo (*out))
+            {
+                out.reset();
+                temp.overwriteTargetFileWithTemporary();
+            }
+        }
+    }
+
+    // After a jump, decoding has to start early enough that the frames leading up to the
+    // target have the same state as they would if the whole stream had been decoded
+    int findFirstFrameToDecode (int targetFrame)
+    {
+        // The transform overlap and synthesis filter history only reach back one frame,
+        // apart from Layer I frames, which are too short to fill the filter on their own
+        auto frameNum = jmax (0, targetFrame - (stream.frame.layer == 1 ? 2 : 1));
+
+        if (stream.frame.layer != 3)
+            return frameNum;
+
+        // Layer III frames can also borrow data from the frames before them (up to 511 bytes,
+        // or 255 for MPEG-2), and that has to have been read in first. The side info size is
+        // subtracted from each frame, so this never underestimates how many are needed.
+        const auto maxBorrowedBytes = stream.frame.lsf != 0 ? 255 : 511;
+        auto end = frameIndex->getFramePosition (stream.stream, frameNum);
+
+        for (int64 numBytes = 0; frameNum > 0 && numBytes < maxBorrowedBytes && end >= 0;)
+        {
+            const auto start = frameIndex->getFramePosition (stream.stream, --frameNum);
+
+            if (start < 0)
+                break;
+
+            numBytes += jmax ((int64) 0, end - start - (4 + 2 + 32));
+            end = start;
+        }
+
+        return frameNum;
+    }
+
+    bool seekToSample (int64 sample)
+    {
+        if (frameIndex == nullptr)
+            return false;
+
+        const auto target = sample + startOffset;
+        const auto targetFrame = (int) jmin (target / samplesPerFrame, (int64) std::numeric_limits<int>::max() - 1);
+        const auto firstFrame = findFirstFrameToDecode (targetFrame);
+        const auto position = frameIndex->getFramePosition (stream.stream, firstFrame);
+
+        if (position < 0)
+            return false;
+
+        stream.seekToFrame (position);
+
+        for (int i = firstFrame; i <= targetFrame; ++i)
+            if (! readNextBlock())
+                return false;
+
+        decodedStart = (int) (target - (int64) targetFrame * samplesPerFrame);
+        return decodedStart < decodedEnd;
+    }
 
     void createEmptyDecodedData() noexcept
     {
@@ -3087,6 +3378,17 @@ private:
 
             if (result <= 0)
             {
+                // A frame that couldn't be decoded still has to fill its share of the
+                // stream, or everything after it would be shifted
+                const auto frameLength = stream.getNumSamplesPerFrame();
+
+                if (result == 0 && samplesDone < frameLength)
+                {
+                    zeromem (decoded0 + samplesDone, sizeof (float) * (size_t) (frameLength - samplesDone));
+                    zeromem (decoded1 + samplesDone, sizeof (float) * (size_t) (frameLength - samplesDone));
+                    samplesDone = frameLength;
+                }
+
                 decodedStart = 0;
                 decodedEnd = samplesDone;
                 return result == 0;
@@ -3124,7 +3426,8 @@ private:
 
     int64 findLength (int64 streamStartPos)
     {
-        int64 numFrames = stream.numFrames;
+        int64 numFrames = (frameIndex != nullptr && frameIndex->isComplete()) ? frameIndex->getNumFrames()
+                                                                              : stream.numFrames;
 
         if (numFrames <= 0)
         {
@@ -3141,7 +3444,12 @@ private:
             }
         }
 
-        return numFrames * 1152;
+        auto length = numFrames * samplesPerFrame;
+
+        if (stream.vbrTagData.hasGaplessInfo())
+            length -= stream.vbrTagData.encoderDelay + stream.vbrTagData.encoderPadding;
+
+        return jmax ((int64) 0, length);
     }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MP3Reader)
@@ -3160,9 +3468,12 @@ bool MP3AudioFormat::canDoMono()                    { return true; }
 bool MP3AudioFormat::isCompressed()                 { return true; }
 StringArray MP3AudioFormat::getQualityOptions()     { return {}; }
 
+void MP3AudioFormat::setFrameIndexCacheDirectory (const File& directory)    { frameIndexCacheDirectory = directory; }
+File MP3AudioFormat::getFrameIndexCacheDirectory() const                    { return frameIndexCacheDirectory; }
+
 AudioFormatReader* MP3AudioFormat::createReaderFor (InputStream* sourceStream, const bool deleteStreamIfOpeningFails)
 {
-    std::unique_ptr<MP3Decoder::MP3Reader> r (new MP3Decoder::MP3Reader (sourceStream));
+    std::unique_ptr<MP3Decoder::MP3Reader> r (new MP3Decoder::MP3Reader (sourceStream, frameIndexCacheDirectory));
 
     if (r->lengthInSamples > 0)
         return r.release();
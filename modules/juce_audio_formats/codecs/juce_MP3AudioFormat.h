@@ -75,6 +75,29 @@ public:
                                         unsigned int numberOfChannels, int bitsPerSample,
                                         const StringPairArray& metadataValues, int qualityOptionIndex) override;
     using AudioFormat::createWriterFor;
+
+    //==============================================================================
+    /** Sets a directory in which readers created by this format will store the frame
+        indexes that they build.
+
+        To jump to a position in an MP3 stream, a reader has to know where each frame
+        starts, which it finds by stepping over the headers of all the frames before it.
+        Without a cache directory this is done lazily, as far as each jump needs. With a
+        cache directory, creating a reader loads the index if one has been saved for the
+        same data. Otherwise it scans the whole stream and saves the index, which makes
+        creating the first reader for a long stream slower, so you shouldn't do that on
+        a real-time thread. After that, reading never scans the stream or writes to the
+        cache.
+
+        Pass File() to stop caching indexes.
+    */
+    void setFrameIndexCacheDirectory (const File& directory);
+
+    /** Returns the directory set with setFrameIndexCacheDirectory(). */
+    File getFrameIndexCacheDirectory() const;
+
+private:
+    File frameIndexCacheDirectory;
 };
 
 #endif
@@ -0,0 +1,267 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_USE_MP3AUDIOFORMAT
+
+struct MP3AudioFormatTests final : public UnitTest
+{
+    MP3AudioFormatTests()  : UnitTest ("MP3AudioFormat", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Reading from random positions matches a sequential read");
+        {
+            const auto data = makeStream (random, numFrames);
+            const auto reference = readAll (data);
+
+            expectEquals (reference.getNumSamples(), numFrames * samplesPerFrame);
+            expectRandomReadsMatch (random, data, reference, 0);
+        }
+
+        beginTest ("Gapless info removes the encoder delay and padding");
+        {
+            const int delay = 576, padding = 1000;
+            const auto audioFrames = makeStream (random, numFrames);
+            const auto reference = readAll (audioFrames);
+
+            auto data = makeXingFrame (numFrames, delay, padding);
+            data.append (audioFrames.getData(), audioFrames.getSize());
+
+            const auto trimmed = readAll (data);
+            expectEquals (trimmed.getNumSamples(), numFrames * samplesPerFrame - delay - padding);
+            expect (getMaxDifference (trimmed, 0, reference, delay + 529, trimmed.getNumSamples()) < 1.0e-5f);
+
+            expectRandomReadsMatch (random, data, reference, delay + 529);
+        }
+
+        beginTest ("Frame indexes are saved and reloaded");
+        {
+            const TemporaryFile directory;
+            const auto data = makeStream (random, numFrames);
+            const auto reference = readAll (data);
+
+            MP3AudioFormat format;
+            format.setFrameIndexCacheDirectory (directory.getFile());
+
+            for (int i = 0; i < 2; ++i)
+            {
+                std::unique_ptr<AudioFormatReader> reader (format.createReaderFor (new MemoryInputStream (data, false), true));
+                expect (reader != nullptr);
+
+                if (reader == nullptr)
+                    break;
+
+                expectEquals ((int) reader->lengthInSamples, reference.getNumSamples());
+
+                // The index is saved when the reader is created, rather than when it's first used
+                expectEquals (directory.getFile().findChildFiles (File::findFiles, false, "*.mp3index").size(), 1);
+
+                AudioBuffer<float> block (2, 1000);
+                const auto start = reference.getNumSamples() - 5000;
+                reader->read (&block, 0, block.getNumSamples(), start, true, true);
+                expect (getMaxDifference (block, 0, reference, start, block.getNumSamples()) < 1.0e-5f);
+
+                expectEquals (directory.getFile().findChildFiles (File::findFiles, false, "*.mp3index").size(), 1);
+            }
+
+            directory.getFile().deleteRecursively();
+        }
+    }
+
+    //==============================================================================
+    // MPEG-1 Layer I, 48kHz stereo at 192kbps, which makes every frame the same size
+    static constexpr int numFrames = 500, samplesPerFrame = 384, frameSize = 192, xingFrameSize = 384;
+
+    /*  Layer I frames can hold any mixture of bit allocations and sample values, so random
+        ones make a stream that decodes to something unpredictable, without needing an
+        encoder.
+    */
+    static MemoryBlock makeStream (Random& random, int numAudioFrames)
+    {
+        MemoryBlock block;
+        BitWriter writer { block };
+
+        for (int frame = 0; frame < numAudioFrames; ++frame)
+        {
+            const auto frameStart = (int) block.getSize();
+            writer.write (0xffff6400, 32);
+
+            int allocations[32][2] = {};
+            auto bitsLeft = (frameSize - 4) * 8 - 32 * 2 * 4;
+
+            for (int band = 0; band < 32; ++band)
+            {
+                for (int channel = 0; channel < 2; ++channel)
+                {
+                    const auto allocation = random.nextInt ({ 1, 6 });
+                    const auto bitsNeeded = 6 + 12 * (allocation + 1);
+
+                    if (bitsNeeded <= bitsLeft)
+                    {
+                        allocations[band][channel] = allocation;
+                        bitsLeft -= bitsNeeded;
+                    }
+
+                    writer.write ((uint32) allocations[band][channel], 4);
+                }
+            }
+
+            for (int band = 0; band < 32; ++band)
+                for (int channel = 0; channel < 2; ++channel)
+                    if (allocations[band][channel] != 0)
+                        writer.write ((uint32) random.nextInt (64), 6);
+
+            for (int i = 0; i < 12; ++i)
+                for (int band = 0; band < 32; ++band)
+                    for (int channel = 0; channel < 2; ++channel)
+                        if (auto allocation = allocations[band][channel])
+                            writer.write ((uint32) random.nextInt (1 << (allocation + 1)), allocation + 1);
+
+            writer.padTo (frameStart + frameSize);
+        }
+
+        return block;
+    }
+
+    // A Layer III frame at 128kbps holding a Xing tag with LAME gapless info
+    static MemoryBlock makeXingFrame (int numAudioFrames, int delay, int padding)
+    {
+        MemoryBlock block;
+        BitWriter writer { block };
+        writer.write (0xfffb9400, 32);
+
+        for (int i = 0; i < 32; ++i)
+            writer.write (0, 8);
+
+        for (auto c : String ("Xing"))
+            writer.write ((uint32) c, 8);
+
+        writer.write (1, 32);
+        writer.write ((uint32) numAudioFrames, 32);
+
+        for (auto c : String ("LAME3.100"))
+            writer.write ((uint32) c, 8);
+
+        for (int i = 0; i < 12; ++i)
+            writer.write (0, 8);
+
+        writer.write ((uint32) delay, 12);
+        writer.write ((uint32) padding, 12);
+        writer.padTo (xingFrameSize);
+        return block;
+    }
+
+    struct BitWriter
+    {
+        void write (uint32 value, int numBits)
+        {
+            for (int i = numBits; --i >= 0;)
+            {
+                if (numBitsInByte == 0)
+                    block.append ("", 1);
+
+                auto& byte = static_cast<uint8*> (block.getData())[block.getSize() - 1];
+                byte = (uint8) (byte | (((value >> i) & 1) << (7 - numBitsInByte)));
+                numBitsInByte = (numBitsInByte + 1) & 7;
+            }
+        }
+
+        void padTo (int size)
+        {
+            numBitsInByte = 0;
+
+            while ((int) block.getSize() < size)
+                block.append ("", 1);
+        }
+
+        MemoryBlock& block;
+        int numBitsInByte = 0;
+    };
+
+    //==============================================================================
+    static AudioBuffer<float> readAll (const MemoryBlock& data)
+    {
+        std::unique_ptr<AudioFormatReader> reader (MP3AudioFormat().createReaderFor (new MemoryInputStream (data, false), true));
+
+        if (reader == nullptr)
+            return {};
+
+        AudioBuffer<float> buffer ((int) reader->numChannels, (int) reader->lengthInSamples);
+        reader->read (&buffer, 0, buffer.getNumSamples(), 0, true, true);
+        return buffer;
+    }
+
+    static float getMaxDifference (const AudioBuffer<float>& a, int startA, const AudioBuffer<float>& b, int startB, int numSamples)
+    {
+        auto difference = 0.0f;
+
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                difference = jmax (difference, std::abs (a.getSample (channel, startA + i) - b.getSample (channel, startB + i)));
+
+        return difference;
+    }
+
+    void expectRandomReadsMatch (Random& random, const MemoryBlock& data, const AudioBuffer<float>& reference, int offset)
+    {
+        std::unique_ptr<AudioFormatReader> reader (MP3AudioFormat().createReaderFor (new MemoryInputStream (data, false), true));
+        expect (reader != nullptr);
+
+        if (reader == nullptr)
+            return;
+
+        AudioBuffer<float> block (2, 700);
+        auto maxDifference = 0.0f;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            const auto start = random.nextInt ((int) reader->lengthInSamples - block.getNumSamples());
+            reader->read (&block, 0, block.getNumSamples(), start, true, true);
+            maxDifference = jmax (maxDifference, getMaxDifference (block, 0, reference, start + offset, block.getNumSamples()));
+        }
+
+        expect (maxDifference < 1.0e-5f, "Maximum difference " + String (maxDifference));
+    }
+};
+
+static MP3AudioFormatTests mp3AudioFormatTests;
+
+#endif
+
+} // namespace juce
@@ -1876,9 +1876,12 @@ public:
             return false;
         }
 
-        WavAudioFormatReader::copySampleData (bitsPerSample, usesFloatingPointData,
-                                              destSamples, startOffsetInDestBuffer, numDestChannels,
-                                              sampleToPointer (startSampleInFile), (int) numChannels, numSamples);
+        if (hasNativeFloatData())
+            readNativeFloatSamples (destSamples, numDestChannels, startOffsetInDestBuffer, startSampleInFile, numSamples);
+        else
+            WavAudioFormatReader::copySampleData (bitsPerSample, usesFloatingPointData,
+                                                  destSamples, startOffsetInDestBuffer, numDestChannels,
+                                                  sampleToPointer (startSampleInFile), (int) numChannels, numSamples);
         return true;
     }
 
@@ -1938,6 +1941,11 @@ public:
     using AudioFormatReader::readMaxLevels;
 
 private:
+    bool isNativeFloatLayout() const noexcept override
+    {
+        return ! ByteOrder::isBigEndian();
+    }
+
     template <typename SampleType>
     void scanMinAndMax (int64 startSampleInFile, int64 numSamples, Range<float>* results, int numChannelsToRead) const noexcept
     {
@@ -0,0 +1,427 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct AudioFormatPipeline::Block
+{
+    AudioBuffer<float> buffer;
+    int64 startSample = 0;
+};
+
+struct AudioFormatPipeline::FileState
+{
+    explicit FileState (int index)  : jobIndex (index) {}
+
+    const int jobIndex;
+    std::unique_ptr<AudioFormatReader> reader;
+    std::unique_ptr<AudioFormatWriter> writer;
+    std::unique_ptr<TemporaryFile> destination;
+    std::vector<Block*> decodedBlocks;
+    int64 nextSampleToDecode = 0;
+    bool isDecoding = false, isEncoding = false, finishedDecoding = false;
+    Result result = Result::ok();
+
+    bool isBusy() const noexcept            { return isDecoding || isEncoding; }
+    bool isReadyToClose() const noexcept    { return finishedDecoding && ! isBusy() && decodedBlocks.empty(); }
+};
+
+//==============================================================================
+/*  The state of a call to process(). Every member is protected by the mutex.
+
+    Each worker repeatedly picks the most useful step that it can do: encoding a block that's
+    waiting, decoding a block if there's a free one, or opening the next file. A file is only
+    decoded by one thread and encoded by one thread at a time, because readers and writers
+    aren't thread-safe.
+*/
+struct AudioFormatPipeline::Session
+{
+    Session (AudioFormatPipeline& p, const std::vector<Job>& j)
+        : owner (p), jobs (j), results (j.size(), Result::fail ("Cancelled"))
+    {
+        for (auto& block : owner.blocks)
+            freeBlocks.push_back (block.get());
+
+        maxBlocksPerFile = (size_t) jmax (2, owner.options.numBlocks / jmax (1, owner.options.maxNumOpenFiles));
+    }
+
+    AudioFormatPipeline& owner;
+    const std::vector<Job>& jobs;
+    std::vector<Result> results;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::vector<std::unique_ptr<FileState>> openFiles;
+    std::vector<Block*> freeBlocks;
+    size_t nextJob = 0, maxBlocksPerFile = 2;
+    int numFilesOpening = 0;
+
+    //==============================================================================
+    template <typename Predicate>
+    FileState* findFile (Predicate&& predicate) const
+    {
+        for (auto& file : openFiles)
+            if (predicate (*file))
+                return file.get();
+
+        return nullptr;
+    }
+
+    bool isFinished() const
+    {
+        return (nextJob >= jobs.size() || owner.shouldCancel) && openFiles.empty() && numFilesOpening == 0;
+    }
+
+    void releaseBlocks (FileState& file)
+    {
+        for (auto* block : file.decodedBlocks)
+            freeBlocks.push_back (block);
+
+        file.decodedBlocks.clear();
+    }
+
+    void fail (FileState& file, const String& error)
+    {
+        if (file.result.wasOk())
+            file.result = Result::fail (error);
+
+        file.finishedDecoding = true;
+        releaseBlocks (file);
+    }
+
+    //==============================================================================
+    std::unique_ptr<FileState> openFile (int jobIndex) const
+    {
+        auto& job = jobs[(size_t) jobIndex];
+        auto file = std::make_unique<FileState> (jobIndex);
+
+        file->reader.reset (owner.formatManager.createReaderFor (job.sourceFile));
+
+        if (file->reader == nullptr)
+        {
+            file->result = Result::fail ("Couldn't read " + job.sourceFile.getFullPathName());
+            return file;
+        }
+
+        auto* format = job.destinationFormat != nullptr ? job.destinationFormat
+                                                        : owner.formatManager.findFormatForFileExtension (job.destinationFile.getFileExtension());
+
+        if (format == nullptr)
+        {
+            file->result = Result::fail ("No format for " + job.destinationFile.getFullPathName());
+            return file;
+        }
+
+        file->destination = std::make_unique<TemporaryFile> (job.destinationFile);
+        auto stream = file->destination->getFile().createOutputStream();
+
+        if (stream != nullptr)
+        {
+            auto& reader = *file->reader;
+            file->writer.reset (format->createWriterFor (stream.get(), reader.sampleRate, reader.numChannels,
+                                                         chooseBitDepth (*format, job.bitsPerSample > 0 ? job.bitsPerSample
+                                                                                                        : (int) reader.bitsPerSample),
+                                                         reader.metadataValues, job.qualityOptionIndex));
+        }
+
+        if (file->writer == nullptr)
+        {
+            file->result = Result::fail ("Couldn't write " + job.destinationFile.getFullPathName());
+            return file;
+        }
+
+        stream.release();
+        file->finishedDecoding = file->reader->lengthInSamples <= 0;
+        return file;
+    }
+
+    static int chooseBitDepth (AudioFormat& format, int requestedDepth)
+    {
+        const auto depths = format.getPossibleBitDepths();
+
+        if (depths.isEmpty() || depths.contains (requestedDepth))
+            return requestedDepth;
+
+        auto bestDepth = depths.getFirst();
+
+        for (auto depth : depths)
+        {
+            auto difference = std::abs (depth - requestedDepth);
+            auto bestDifference = std::abs (bestDepth - requestedDepth);
+
+            if (difference < bestDifference || (difference == bestDifference && depth > bestDepth))
+                bestDepth = depth;
+        }
+
+        return bestDepth;
+    }
+
+    Result decode (FileState& file, Block& block) const
+    {
+        auto& reader = *file.reader;
+        auto& buffer = block.buffer;
+        auto numSamples = (int) jmin ((int64) owner.options.blockSize, reader.lengthInSamples - block.startSample);
+
+        buffer.setSize ((int) reader.numChannels, numSamples, false, false, true);
+
+        if (! reader.read (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), block.startSample, numSamples))
+            return Result::fail ("Error reading " + jobs[(size_t) file.jobIndex].sourceFile.getFullPathName());
+
+        if (owner.processBlock != nullptr)
+            owner.processBlock (jobs[(size_t) file.jobIndex], buffer, block.startSample);
+
+        return Result::ok();
+    }
+
+    Result encode (FileState& file, const Block& block) const
+    {
+        auto& buffer = block.buffer;
+
+        if (! file.writer->writeFromAudioSampleBuffer (buffer, 0, buffer.getNumSamples()))
+            return Result::fail ("Error writing " + jobs[(size_t) file.jobIndex].destinationFile.getFullPathName());
+
+        owner.numSamplesWritten += buffer.getNumSamples();
+        return Result::ok();
+    }
+
+    void close (FileState& file)
+    {
+        file.reader.reset();
+
+        if (file.writer != nullptr)
+        {
+            file.writer.reset();
+
+            if (file.result.wasOk() && ! file.destination->overwriteTargetFileWithTemporary())
+                file.result = Result::fail ("Couldn't replace " + jobs[(size_t) file.jobIndex].destinationFile.getFullPathName());
+        }
+
+        file.destination.reset();
+
+        ++owner.numJobsFinished;
+
+        if (file.result.failed())
+            ++owner.numJobsFailed;
+
+        if (owner.onJobFinished != nullptr)
+            owner.onJobFinished (file.jobIndex, file.result);
+    }
+
+    //==============================================================================
+    // Removes and closes any files that are ready, then returns true if the lock was released
+    bool closeFinishedFiles (std::unique_lock<std::mutex>& lock)
+    {
+        for (auto iter = openFiles.begin(); iter != openFiles.end(); ++iter)
+        {
+            auto& file = **iter;
+
+            if (owner.shouldCancel && ! file.isBusy())
+                fail (file, "Cancelled");
+
+            if (file.result.failed() && ! file.isBusy())
+                fail (file, file.result.getErrorMessage());
+
+            if (file.isReadyToClose())
+            {
+                auto closing = std::move (*iter);
+                openFiles.erase (iter);
+
+                lock.unlock();
+                close (*closing);
+                lock.lock();
+
+                results[(size_t) closing->jobIndex] = closing->result;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool encodeNextBlock (std::unique_lock<std::mutex>& lock)
+    {
+        auto* file = findFile ([] (const FileState& f) { return ! f.isEncoding && ! f.decodedBlocks.empty(); });
+
+        if (file == nullptr)
+            return false;
+
+        auto* block = file->decodedBlocks.front();
+        file->decodedBlocks.erase (file->decodedBlocks.begin());
+        file->isEncoding = true;
+
+        lock.unlock();
+        auto result = encode (*file, *block);
+        lock.lock();
+
+        if (result.failed())
+            file->result = result;
+
+        freeBlocks.push_back (block);
+        file->isEncoding = false;
+        return true;
+    }
+
+    bool decodeNextBlock (std::unique_lock<std::mutex>& lock)
+    {
+        if (freeBlocks.empty() || owner.shouldCancel)
+            return false;
+
+        auto* file = findFile ([this] (const FileState& f)
+        {
+            return ! f.isDecoding && ! f.finishedDecoding && f.result.wasOk() && f.decodedBlocks.size() < maxBlocksPerFile;
+        });
+
+        if (file == nullptr)
+            return false;
+
+        auto* block = freeBlocks.back();
+        freeBlocks.pop_back();
+        block->startSample = file->nextSampleToDecode;
+        file->nextSampleToDecode += owner.options.blockSize;
+        file->isDecoding = true;
+
+        lock.unlock();
+        auto result = decode (*file, *block);
+        lock.lock();
+
+        file->isDecoding = false;
+        file->finishedDecoding = file->finishedDecoding || file->nextSampleToDecode >= file->reader->lengthInSamples;
+
+        if (result.failed() && file->result.wasOk())
+            file->result = result;
+
+        if (file->result.wasOk())
+            file->decodedBlocks.push_back (block);
+        else
+            freeBlocks.push_back (block);
+
+        return true;
+    }
+
+    bool openNextFile (std::unique_lock<std::mutex>& lock)
+    {
+        if (nextJob >= jobs.size() || owner.shouldCancel
+             || (int) openFiles.size() + numFilesOpening >= owner.options.maxNumOpenFiles)
+            return false;
+
+        auto jobIndex = (int) nextJob++;
+        ++numFilesOpening;
+
+        lock.unlock();
+        auto file = openFile (jobIndex);
+        lock.lock();
+
+        --numFilesOpening;
+        openFiles.push_back (std::move (file));
+        return true;
+    }
+};
+
+//==============================================================================
+AudioFormatPipeline::AudioFormatPipeline (AudioFormatManager& manager, const Options& optionsToUse)
+    : formatManager (manager),
+      options (optionsToUse),
+      pool (ThreadPoolOptions{}.withThreadName ("Audio format pipeline")
+                               .withNumberOfThreads (jmax (1, optionsToUse.numberOfThreads - 1)))
+{
+    jassert (options.blockSize > 0 && options.numBlocks > 0 && options.maxNumOpenFiles > 0);
+
+    for (int i = 0; i < jmax (1, options.numBlocks); ++i)
+        blocks.push_back (std::make_unique<Block>());
+}
+
+AudioFormatPipeline::AudioFormatPipeline (AudioFormatManager& manager)
+    : AudioFormatPipeline (manager, Options{})
+{
+}
+
+AudioFormatPipeline::~AudioFormatPipeline() = default;
+
+std::vector<Result> AudioFormatPipeline::process (const std::vector<Job>& jobs)
+{
+    shouldCancel = false;
+    numJobs = (int) jobs.size();
+    numJobsFinished = 0;
+    numJobsFailed = 0;
+    numSamplesWritten = 0;
+
+    Session session (*this, jobs);
+
+    {
+        ThreadPoolTaskGroup group (pool);
+
+        for (int i = 1; i < options.numberOfThreads; ++i)
+            group.run ([this, &session] { runWorker (session); });
+
+        runWorker (session);
+        group.wait();
+    }
+
+    return std::move (session.results);
+}
+
+void AudioFormatPipeline::cancel() noexcept
+{
+    shouldCancel = true;
+}
+
+AudioFormatPipeline::Progress AudioFormatPipeline::getProgress() const noexcept
+{
+    return { numJobs, numJobsFinished, numJobsFailed, numSamplesWritten };
+}
+
+void AudioFormatPipeline::runWorker (Session& session)
+{
+    std::unique_lock lock (session.mutex);
+
+    while (! session.isFinished())
+    {
+        // Encoding takes priority, as that frees up blocks for the decoders
+        if (session.closeFinishedFiles (lock)
+             || session.encodeNextBlock (lock)
+             || session.decodeNextBlock (lock)
+             || session.openNextFile (lock))
+        {
+            session.condition.notify_all();
+            continue;
+        }
+
+        session.condition.wait_for (lock, std::chrono::milliseconds (100));
+    }
+
+    session.condition.notify_all();
+}
+
+} // namespace juce
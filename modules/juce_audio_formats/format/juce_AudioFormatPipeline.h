@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Converts a batch of audio files concurrently, using the formats registered with an
+    AudioFormatManager.
+
+    Each file is decoded in blocks, optionally passed to a callback that can process the
+    audio, and encoded to its destination file. Several files are converted at once, and
+    the decoding and encoding of each file are separate steps, so they can also run at
+    the same time on different threads.
+
+    All the blocks come from a fixed-size pool, so the amount of memory used doesn't
+    depend on the number or length of the files. When all the blocks are in use, the
+    threads stop decoding and encode the blocks that are waiting instead.
+
+    @code
+    AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+
+    AudioFormatPipeline pipeline (formatManager);
+    std::vector<AudioFormatPipeline::Job> jobs;
+
+    for (auto& file : wavFiles)
+        jobs.push_back ({ file, file.withFileExtension ("flac") });
+
+    for (auto& result : pipeline.process (jobs))
+        if (result.failed())
+            DBG (result.getErrorMessage());
+    @endcode
+
+    @see AudioFormatManager
+
+    @tags{Audio}
+*/
+class JUCE_API  AudioFormatPipeline
+{
+public:
+    //==============================================================================
+    /** Describes a file to convert. */
+    struct Job
+    {
+        /** The file to read. */
+        File sourceFile;
+
+        /** The file to write. If it already exists, it will be replaced once the
+            conversion has succeeded.
+        */
+        File destinationFile;
+
+        /** The format to write. If this is nullptr, the format manager's format for
+            the destination file's extension will be used.
+        */
+        AudioFormat* destinationFormat = nullptr;
+
+        /** The bit depth to write. If this is 0, or the destination format doesn't
+            support it, the closest supported depth to the source's depth is used.
+        */
+        int bitsPerSample = 0;
+
+        /** The quality option to pass to AudioFormat::createWriterFor(). */
+        int qualityOptionIndex = 0;
+    };
+
+    //==============================================================================
+    /** Options for creating an AudioFormatPipeline. */
+    struct Options
+    {
+        /** The number of threads to use, including the thread that calls process(). */
+        [[nodiscard]] Options withNumberOfThreads (int newNumberOfThreads) const
+        {
+            return withMember (*this, &Options::numberOfThreads, newNumberOfThreads);
+        }
+
+        /** The number of samples in each block. */
+        [[nodiscard]] Options withBlockSize (int newBlockSize) const
+        {
+            return withMember (*this, &Options::blockSize, newBlockSize);
+        }
+
+        /** The number of blocks in the pool. Each block holds blockSize samples for
+            every channel of the file that is using it.
+        */
+        [[nodiscard]] Options withNumBlocks (int newNumBlocks) const
+        {
+            return withMember (*this, &Options::numBlocks, newNumBlocks);
+        }
+
+        /** The maximum number of files that may be open at the same time. */
+        [[nodiscard]] Options withMaxNumOpenFiles (int newMaxNumOpenFiles) const
+        {
+            return withMember (*this, &Options::maxNumOpenFiles, newMaxNumOpenFiles);
+        }
+
+        int numberOfThreads { SystemStats::getNumCpus() };
+        int blockSize = 32768;
+        int numBlocks = 4 * SystemStats::getNumCpus();
+        int maxNumOpenFiles = 2 * SystemStats::getNumCpus();
+    };
+
+    //==============================================================================
+    /** A snapshot of the progress of a call to process(). */
+    struct Progress
+    {
+        int numJobs = 0;
+        int numJobsFinished = 0;
+        int numJobsFailed = 0;
+        int64 numSamplesWritten = 0;
+    };
+
+    //==============================================================================
+    /** Creates a pipeline that will use the formats in the given manager.
+        The manager must not be changed or deleted while the pipeline is in use.
+    */
+    AudioFormatPipeline (AudioFormatManager& formatManager, const Options& options);
+
+    /** Creates a pipeline with the default Options. */
+    explicit AudioFormatPipeline (AudioFormatManager& formatManager);
+
+    /** Destructor. */
+    ~AudioFormatPipeline();
+
+    //==============================================================================
+    /** Converts all the files, and returns the result for each job, in the same order.
+
+        This blocks until every job has finished or failed, or cancel() is called. The
+        calling thread helps with the work. Don't call this on more than one thread at a
+        time.
+    */
+    std::vector<Result> process (const std::vector<Job>& jobs);
+
+    /** Can be called from any thread to make process() return as soon as possible.
+        Jobs that haven't finished will fail, and their destination files won't be changed.
+    */
+    void cancel() noexcept;
+
+    /** Returns the progress of the current or most recent call to process().
+        This can be called from any thread.
+    */
+    Progress getProgress() const noexcept;
+
+    //==============================================================================
+    /** If set, this is called with each block of audio after it has been decoded, and
+        can change it before it's encoded.
+
+        It's given the job, the block, and the position of the block's first sample in the
+        source file. The number of channels in the block is the same as the source file.
+
+        Blocks from the same file are passed in order, and never concurrently, but blocks
+        from different files may be passed concurrently on different threads.
+    */
+    std::function<void (const Job&, AudioBuffer<float>&, int64)> processBlock;
+
+    /** If set, this is called on one of the pipeline's threads when a job has finished,
+        with the index of the job and its result.
+    */
+    std::function<void (int, const Result&)> onJobFinished;
+
+private:
+    //==============================================================================
+    struct Block;
+    struct FileState;
+    struct Session;
+
+    AudioFormatManager& formatManager;
+    const Options options;
+    ThreadPool pool;
+    std::vector<std::unique_ptr<Block>> blocks;
+
+    std::atomic<bool> shouldCancel { false };
+    std::atomic<int> numJobs { 0 }, numJobsFinished { 0 }, numJobsFailed { 0 };
+    std::atomic<int64> numSamplesWritten { 0 };
+
+    void runWorker (Session&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatPipeline)
+};
+
+} // namespace juce
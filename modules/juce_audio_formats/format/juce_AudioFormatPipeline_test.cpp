@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct AudioFormatPipelineTests final : public UnitTest
+{
+    AudioFormatPipelineTests()  : UnitTest ("AudioFormatPipeline", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        beginTest ("Converted and processed files match their sources");
+        {
+            const TemporaryFile directory;
+            const auto sources = writeSources (directory.getFile());
+            const auto jobs = makeJobs (sources, "flac");
+
+            AudioFormatPipeline pipeline (formatManager, AudioFormatPipeline::Options{}.withNumberOfThreads (3)
+                                                                                        .withBlockSize (1000)
+                                                                                        .withNumBlocks (4)
+                                                                                        .withMaxNumOpenFiles (3));
+
+            std::atomic<int> numCallbacks { 0 };
+            pipeline.onJobFinished = [&] (int, const Result&) { ++numCallbacks; };
+            pipeline.processBlock = [] (const AudioFormatPipeline::Job&, AudioBuffer<float>& block, int64)
+            {
+                block.applyGain (0.5f);
+            };
+
+            const auto results = pipeline.process (jobs);
+
+            expectEquals ((int) results.size(), (int) jobs.size());
+            expectEquals (numCallbacks.load(), (int) jobs.size());
+
+            for (size_t i = 0; i < jobs.size(); ++i)
+            {
+                expect (results[i].wasOk(), results[i].getErrorMessage());
+                expectFileMatches (formatManager, jobs[i].destinationFile, sources[i].second, 0.5f);
+            }
+
+            const auto progress = pipeline.getProgress();
+            expectEquals (progress.numJobsFinished, (int) jobs.size());
+            expectEquals (progress.numJobsFailed, 0);
+
+            directory.getFile().deleteRecursively();
+        }
+
+        beginTest ("Jobs that can't be read fail without affecting the others");
+        {
+            const TemporaryFile directory;
+            const auto sources = writeSources (directory.getFile());
+            auto jobs = makeJobs (sources, "wav");
+
+            const auto missing = directory.getFile().getChildFile ("missing.wav");
+            jobs.insert (jobs.begin() + 1, { missing, missing.withFileExtension ("aiff") });
+
+            AudioFormatPipeline pipeline (formatManager, AudioFormatPipeline::Options{}.withNumberOfThreads (2));
+            const auto results = pipeline.process (jobs);
+
+            expect (results[1].failed());
+            expect (! jobs[1].destinationFile.exists());
+            expectEquals (pipeline.getProgress().numJobsFailed, 1);
+
+            for (size_t i = 0; i < jobs.size(); ++i)
+                if (i != 1)
+                    expectFileMatches (formatManager, jobs[i].destinationFile, sources[i > 1 ? i - 1 : i].second, 1.0f);
+
+            directory.getFile().deleteRecursively();
+        }
+
+        beginTest ("Cancelling leaves unfinished destinations untouched");
+        {
+            const TemporaryFile directory;
+            const auto sources = writeSources (directory.getFile());
+            const auto jobs = makeJobs (sources, "flac");
+
+            AudioFormatPipeline pipeline (formatManager, AudioFormatPipeline::Options{}.withNumberOfThreads (1)
+                                                                                        .withMaxNumOpenFiles (1));
+            pipeline.onJobFinished = [&pipeline] (int, const Result&) { pipeline.cancel(); };
+
+            const auto results = pipeline.process (jobs);
+
+            expect (results[0].wasOk());
+
+            for (size_t i = 1; i < jobs.size(); ++i)
+            {
+                expect (results[i].failed());
+                expect (! jobs[i].destinationFile.exists());
+            }
+
+            directory.getFile().deleteRecursively();
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+
+    using Source = std::pair<File, AudioBuffer<float>>;
+
+    static std::vector<Source> writeSources (const File& directory)
+    {
+        directory.createDirectory();
+
+        std::vector<Source> sources;
+        Random random (0x4321);
+
+        for (const auto length : { 12345, 0, 1000, 40000, 999, 2001 })
+        {
+            const auto numChannels = 1 + (int) sources.size() % 2;
+            AudioBuffer<float> buffer (numChannels, length);
+
+            for (int channel = 0; channel < numChannels; ++channel)
+                for (int i = 0; i < length; ++i)
+                    buffer.setSample (channel, i, random.nextFloat() * 1.6f - 0.8f);
+
+            const auto file = directory.getChildFile ("source" + String ((int) sources.size()) + ".wav");
+            std::unique_ptr<AudioFormatWriter> writer (WavAudioFormat().createWriterFor (file.createOutputStream().release(),
+                                                                                          sampleRate, (unsigned int) numChannels,
+                                                                                          24, {}, 0));
+            writer->writeFromAudioSampleBuffer (buffer, 0, length);
+            sources.emplace_back (file, std::move (buffer));
+        }
+
+        return sources;
+    }
+
+    static std::vector<AudioFormatPipeline::Job> makeJobs (const std::vector<Source>& sources, const String& extension)
+    {
+        std::vector<AudioFormatPipeline::Job> jobs;
+
+        for (auto& source : sources)
+            jobs.push_back ({ source.first, source.first.getSiblingFile ("converted_" + source.first.getFileName())
+                                                        .withFileExtension (extension) });
+
+        return jobs;
+    }
+
+    void expectFileMatches (AudioFormatManager& formatManager, const File& file, const AudioBuffer<float>& expected, float gain)
+    {
+        std::unique_ptr<AudioFormatReader> reader (formatManager.createReaderFor (file));
+        expect (reader != nullptr, file.getFullPathName());
+
+        if (reader == nullptr)
+            return;
+
+        expectEquals ((int) reader->numChannels, expected.getNumChannels());
+        expectEquals (reader->lengthInSamples, (int64) expected.getNumSamples());
+
+        AudioBuffer<float> actual ((int) reader->numChannels, (int) reader->lengthInSamples);
+        reader->read (&actual, 0, actual.getNumSamples(), 0, true, true);
+
+        auto maxError = 0.0f;
+
+        for (int channel = 0; channel < expected.getNumChannels(); ++channel)
+            for (int i = 0; i < expected.getNumSamples(); ++i)
+                maxError = jmax (maxError, std::abs (actual.getSample (channel, i) - expected.getSample (channel, i) * gain));
+
+        expectLessThan (maxError, 1.0e-5f);
+    }
+};
+
+static AudioFormatPipelineTests audioFormatPipelineTests;
+
+} // namespace juce
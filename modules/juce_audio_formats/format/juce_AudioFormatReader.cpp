@@ -442,4 +442,142 @@ void MemoryMappedAudioFormatReader::touchSample (int64 sample) const noexcept
         jassertfalse; // you must make sure that the window contains all the samples you're going to attempt to read.
 }
 
+void MemoryMappedAudioFormatReader::adviseAccess (Range<int64> samples, MemoryMappedFile::AccessHint hint) const noexcept
+{
+    samples = samples.getIntersectionWith (mappedSection);
+
+    if (map != nullptr && ! samples.isEmpty())
+        map->adviseAccess ({ sampleToFilePos (samples.getStart()), sampleToFilePos (samples.getEnd()) }, hint);
+}
+
+Span<const float> MemoryMappedAudioFormatReader::getMappedFloatData (Range<int64> samples) const noexcept
+{
+    if (map == nullptr || ! hasNativeFloatData() || ! mappedSection.contains (samples))
+        return {};
+
+    auto* data = sampleToPointer (samples.getStart());
+
+    if (reinterpret_cast<pointer_sized_int> (data) % (pointer_sized_int) alignof (float) != 0)
+        return {};
+
+    return { static_cast<const float*> (data), (size_t) (samples.getLength() * numChannels) };
+}
+
+static void deinterleaveStereoFloats (const float* source, float* left, float* right, int numSamples) noexcept
+{
+    int i = 0;
+
+   #if JUCE_USE_SSE_INTRINSICS
+    for (; i + 4 <= numSamples; i += 4)
+    {
+        auto a = _mm_loadu_ps (source + 2 * i);
+        auto b = _mm_loadu_ps (source + 2 * i + 4);
+
+        _mm_storeu_ps (left + i,  _mm_shuffle_ps (a, b, _MM_SHUFFLE (2, 0, 2, 0)));
+        _mm_storeu_ps (right + i, _mm_shuffle_ps (a, b, _MM_SHUFFLE (3, 1, 3, 1)));
+    }
+   #elif JUCE_USE_ARM_NEON
+    for (; i + 4 <= numSamples; i += 4)
+    {
+        auto pair = vld2q_f32 (source + 2 * i);
+
+        vst1q_f32 (left + i,  pair.val[0]);
+        vst1q_f32 (right + i, pair.val[1]);
+    }
+   #endif
+
+    for (; i < numSamples; ++i)
+    {
+        left[i]  = source[2 * i];
+        right[i] = source[2 * i + 1];
+    }
+}
+
+void MemoryMappedAudioFormatReader::readNativeFloatSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                                                            int64 startSampleInFile, int numSamples) const noexcept
+{
+    jassert (hasNativeFloatData());
+    jassert (map != nullptr && mappedSection.contains (Range<int64> (startSampleInFile, startSampleInFile + numSamples)));
+
+    auto* source = static_cast<const char*> (sampleToPointer (startSampleInFile));
+    auto numSourceChannels = (int) numChannels;
+
+    // The sample data can start at any even offset in the file, so it can only be read
+    // directly as floats if it happens to be suitably aligned
+    const auto isAligned = reinterpret_cast<pointer_sized_int> (source) % (pointer_sized_int) alignof (float) == 0;
+
+    auto getDestChannel = [&] (int channel) -> float*
+    {
+        if (auto* dest = destSamples[channel])
+            return reinterpret_cast<float*> (dest) + startOffsetInDestBuffer;
+
+        return nullptr;
+    };
+
+    for (int i = numSourceChannels; i < numDestChannels; ++i)
+        if (auto* dest = getDestChannel (i))
+            FloatVectorOperations::clear (dest, numSamples);
+
+    auto numChannelsToRead = jmin (numSourceChannels, numDestChannels);
+
+    if (numSourceChannels == 1)
+    {
+        if (numDestChannels > 0)
+            if (auto* dest = getDestChannel (0))
+                memcpy (dest, source, (size_t) numSamples * sizeof (float));
+
+        return;
+    }
+
+    if (isAligned && numSourceChannels == 2 && numDestChannels >= 2)
+    {
+        auto* left  = getDestChannel (0);
+        auto* right = getDestChannel (1);
+
+        if (left != nullptr && right != nullptr)
+        {
+            deinterleaveStereoFloats (reinterpret_cast<const float*> (source), left, right, numSamples);
+            return;
+        }
+    }
+
+    auto deinterleave = [&] (auto getSourceSample)
+    {
+        // Work through the frames in short blocks, so that the interleaved source stays
+        // in the cache while each channel picks out its samples
+        constexpr int framesPerBlock = 256;
+
+        for (int blockStart = 0; blockStart < numSamples; blockStart += framesPerBlock)
+        {
+            auto numThisTime = jmin (framesPerBlock, numSamples - blockStart);
+            auto blockIndex = (size_t) blockStart * (size_t) numSourceChannels;
+
+            for (int channel = 0; channel < numChannelsToRead; ++channel)
+            {
+                if (auto* dest = getDestChannel (channel))
+                {
+                    dest += blockStart;
+
+                    for (int i = 0; i < numThisTime; ++i)
+                        dest[i] = getSourceSample (blockIndex + (size_t) (i * numSourceChannels + channel));
+                }
+            }
+        }
+    };
+
+    if (isAligned)
+    {
+        deinterleave ([floats = reinterpret_cast<const float*> (source)] (size_t index) noexcept { return floats[index]; });
+    }
+    else
+    {
+        deinterleave ([source] (size_t index) noexcept
+        {
+            float sample;
+            memcpy (&sample, source + index * sizeof (float), sizeof (float));
+            return sample;
+        });
+    }
+}
+
 } // namespace juce
@@ -39,7 +39,12 @@ namespace juce
 /**
     A type of AudioSource that will read from an AudioFormatReader.
 
-    @see PositionableAudioSource, AudioTransportSource, BufferingAudioSource
+    The audio is produced at the reader's own sample rate. To convert it to a
+    different rate, wrap this in a ResamplingAudioSource - for high-quality
+    conversion (e.g. when importing files), give that a PolyphaseResampler
+    quality preset with ResamplingAudioSource::setResamplingQuality().
+
+    @see PositionableAudioSource, AudioTransportSource, BufferingAudioSource, ResamplingAudioSource
 
     @tags{Audio}
 */
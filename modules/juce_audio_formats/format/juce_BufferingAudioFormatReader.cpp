@@ -35,11 +35,282 @@
 namespace juce
 {
 
+//==============================================================================
+struct BufferingAudioReaderScheduler::Candidate
+{
+    BufferingAudioReader* reader = nullptr;
+    int64 position = 0;
+    double timeUntilNeeded = 0.0;
+};
+
+BufferingAudioReaderScheduler::BufferingAudioReaderScheduler (TimeSliceThread& timeSliceThread, const Options& optionsToUse)
+    : thread (timeSliceThread), options (optionsToUse)
+{
+    jassert (options.maxBlocksPerRead > 0);
+    thread.addTimeSliceClient (this);
+}
+
+BufferingAudioReaderScheduler::BufferingAudioReaderScheduler (TimeSliceThread& timeSliceThread)
+    : BufferingAudioReaderScheduler (timeSliceThread, Options{})
+{
+}
+
+BufferingAudioReaderScheduler::~BufferingAudioReaderScheduler()
+{
+    // All the readers that use this scheduler must be deleted before it is!
+    jassert (readers.isEmpty());
+
+    thread.removeTimeSliceClient (this);
+}
+
+BufferingAudioReaderScheduler::Statistics BufferingAudioReaderScheduler::getStatistics() const noexcept
+{
+    Statistics stats;
+    stats.numReads          = numReads;
+    stats.numHits           = numHits;
+    stats.numLateBlocks     = numLateBlocks;
+    stats.numBlocksLoaded   = numBlocksLoaded;
+    stats.numSourceReads    = numSourceReads;
+    stats.numBlocksDropped  = numBlocksDropped;
+    stats.numBytesBuffered  = numBytesBuffered;
+    return stats;
+}
+
+void BufferingAudioReaderScheduler::resetStatistics() noexcept
+{
+    for (auto* counter : { &numReads, &numHits, &numLateBlocks, &numBlocksLoaded, &numSourceReads, &numBlocksDropped })
+        *counter = 0;
+}
+
+void BufferingAudioReaderScheduler::addReader (BufferingAudioReader& reader)
+{
+    {
+        const ScopedLock sl (readersLock);
+        readers.add (&reader);
+    }
+
+    thread.moveToFrontOfQueue (this);
+}
+
+void BufferingAudioReaderScheduler::removeReader (BufferingAudioReader& reader)
+{
+    bool isBeingLoaded = false;
+
+    {
+        const ScopedLock sl (readersLock);
+        readers.removeFirstMatchingValue (&reader);
+        isBeingLoaded = (readerBeingLoaded == &reader);
+    }
+
+    // If the thread is reading from this reader's source, wait for it to finish
+    if (isBeingLoaded)
+    {
+        const ScopedLock loadingLock (loadLock);
+    }
+
+    for (auto* block : reader.blocks)
+        numBytesBuffered -= block->getNumBytes();
+}
+
+void BufferingAudioReaderScheduler::updateReadRate (BufferingAudioReader& reader, double now)
+{
+    const auto position = reader.nextReadPosition.load();
+    const auto elapsedMs = now - reader.lastScheduledTime;
+
+    if (reader.lastScheduledPosition < 0
+         || position < reader.lastScheduledPosition
+         || position - reader.lastScheduledPosition > (int64) reader.numBlocks * BufferingAudioReader::samplesPerBlock)
+    {
+        // The reader is new or has jumped, so start measuring again from here
+        reader.lastScheduledPosition = position;
+        reader.lastScheduledTime = now;
+    }
+    else if (elapsedMs >= 100.0)
+    {
+        const auto samplesPerMs = (double) (position - reader.lastScheduledPosition) / elapsedMs;
+        reader.samplesPerMs = 0.5 * (reader.samplesPerMs + samplesPerMs);
+        reader.lastScheduledPosition = position;
+        reader.lastScheduledTime = now;
+    }
+}
+
+double BufferingAudioReaderScheduler::getTimeUntilNeeded (const BufferingAudioReader& reader, int64 position)
+{
+    const auto readPosition = reader.nextReadPosition.load();
+
+    if (position <= readPosition)
+        return 0.0;
+
+    // A reader that has stopped moving won't need anything for a very long time
+    return (double) (position - readPosition) / jmax (reader.samplesPerMs, 1.0e-6);
+}
+
+void BufferingAudioReaderScheduler::releaseBlocksOutsideRange (BufferingAudioReader& reader)
+{
+    const auto range = reader.getRangeToBuffer();
+    OwnedArray<BufferingAudioReader::BufferedBlock> blocksToDelete;
+
+    {
+        const ScopedLock sl (reader.lock);
+
+        for (int i = reader.blocks.size(); --i >= 0;)
+            if (! reader.blocks.getUnchecked (i)->range.intersects (range))
+                blocksToDelete.add (reader.blocks.removeAndReturn (i));
+    }
+
+    for (auto* block : blocksToDelete)
+        numBytesBuffered -= block->getNumBytes();
+}
+
+bool BufferingAudioReaderScheduler::makeSpaceFor (size_t numBytes, const Candidate& candidate)
+{
+    while (numBytesBuffered + numBytes > options.maxMemoryBytes)
+    {
+        BufferingAudioReader* readerToDropFrom = nullptr;
+        int blockToDrop = -1;
+        auto latestTime = candidate.timeUntilNeeded;
+
+        for (auto* reader : readers)
+        {
+            for (int i = 0; i < reader->blocks.size(); ++i)
+            {
+                const auto time = getTimeUntilNeeded (*reader, reader->blocks.getUnchecked (i)->range.getStart());
+
+                if (time > latestTime)
+                {
+                    latestTime = time;
+                    readerToDropFrom = reader;
+                    blockToDrop = i;
+                }
+            }
+        }
+
+        // If nothing will be needed later than the candidate, it can only be loaded
+        // when it's under a reader's read position
+        if (readerToDropFrom == nullptr)
+            return candidate.timeUntilNeeded <= 0.0;
+
+        std::unique_ptr<BufferingAudioReader::BufferedBlock> block;
+
+        {
+            const ScopedLock sl (readerToDropFrom->lock);
+            block.reset (readerToDropFrom->blocks.removeAndReturn (blockToDrop));
+        }
+
+        numBytesBuffered -= block->getNumBytes();
+        ++numBlocksDropped;
+    }
+
+    return true;
+}
+
+int BufferingAudioReaderScheduler::useTimeSlice()
+{
+    const ScopedLock loadingLock (loadLock);
+    const ScopedLock sl (readersLock);
+    const auto now = Time::getMillisecondCounterHiRes();
+
+    std::optional<Candidate> best;
+
+    for (auto* reader : readers)
+    {
+        updateReadRate (*reader, now);
+        releaseBlocksOutsideRange (*reader);
+
+        // Within a reader, the first missing block is always the one needed soonest
+        const auto range = reader->getRangeToBuffer();
+
+        for (auto pos = range.getStart(); pos < range.getEnd(); pos += BufferingAudioReader::samplesPerBlock)
+        {
+            if (reader->getBlockContaining (pos) == nullptr)
+            {
+                const Candidate candidate { reader, pos, getTimeUntilNeeded (*reader, pos) };
+
+                if (! best.has_value() || candidate.timeUntilNeeded < best->timeUntilNeeded)
+                    best = candidate;
+
+                break;
+            }
+        }
+    }
+
+    if (! best.has_value())
+        return 100;
+
+    auto& reader = *best->reader;
+    const auto bytesPerBlock = (size_t) reader.numChannels * (size_t) BufferingAudioReader::samplesPerBlock * sizeof (float);
+
+    if (! makeSpaceFor (bytesPerBlock, *best))
+        return 10;
+
+    auto numBlocksToRead = 1;
+
+    // If the reader is already waiting for this block, don't make it wait for any others
+    if (best->timeUntilNeeded > 0.0)
+    {
+        const auto rangeEnd = reader.getRangeToBuffer().getEnd();
+
+        while (numBlocksToRead < options.maxBlocksPerRead)
+        {
+            const auto nextPos = best->position + (int64) numBlocksToRead * BufferingAudioReader::samplesPerBlock;
+
+            if (nextPos >= rangeEnd
+                 || reader.getBlockContaining (nextPos) != nullptr
+                 || numBytesBuffered + (size_t) (numBlocksToRead + 1) * bytesPerBlock > options.maxMemoryBytes)
+                break;
+
+            ++numBlocksToRead;
+        }
+    }
+
+    numBytesBuffered += (size_t) numBlocksToRead * bytesPerBlock;
+    readerBeingLoaded = &reader;
+
+    {
+        // Other readers can be added and removed while the source is being read
+        const ScopedUnlock ul (readersLock);
+
+        auto block = std::make_unique<BufferingAudioReader::BufferedBlock> (*reader.source, best->position,
+                                                                            numBlocksToRead * BufferingAudioReader::samplesPerBlock);
+        numBlocksLoaded += numBlocksToRead;
+        ++numSourceReads;
+
+        const ScopedLock readerLock (reader.lock);
+        reader.blocks.add (block.release());
+    }
+
+    readerBeingLoaded = nullptr;
+    return 0;
+}
+
+//==============================================================================
 BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
                                             TimeSliceThread& timeSliceThread,
                                             int samplesToBuffer)
+    : BufferingAudioReader (sourceReader, nullptr,
+                            std::make_unique<BufferingAudioReaderScheduler> (timeSliceThread,
+                                                                             BufferingAudioReaderScheduler::Options{}
+                                                                                 .withMaxMemoryBytes (std::numeric_limits<size_t>::max())
+                                                                                 .withMaxBlocksPerRead (1)),
+                            samplesToBuffer)
+{
+}
+
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
+                                            BufferingAudioReaderScheduler& sharedScheduler,
+                                            int samplesToBuffer)
+    : BufferingAudioReader (sourceReader, &sharedScheduler, nullptr, samplesToBuffer)
+{
+}
+
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
+                                            BufferingAudioReaderScheduler* sharedScheduler,
+                                            std::unique_ptr<BufferingAudioReaderScheduler> schedulerToOwn,
+                                            int samplesToBuffer)
     : AudioFormatReader (nullptr, sourceReader->getFormatName()),
-      source (sourceReader), thread (timeSliceThread),
+      source (sourceReader),
+      ownedScheduler (std::move (schedulerToOwn)),
+      scheduler (sharedScheduler != nullptr ? *sharedScheduler : *ownedScheduler),
       numBlocks (1 + (samplesToBuffer / samplesPerBlock))
 {
     sampleRate            = source->sampleRate;
@@ -49,12 +320,15 @@ BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
     bitsPerSample         = 32;
     usesFloatingPointData = true;
 
-    timeSliceThread.addTimeSliceClient (this);
+    // Until the reader has been used, assume it'll be played at normal speed
+    samplesPerMs = sampleRate / 1000.0;
+
+    scheduler.addReader (*this);
 }
 
 BufferingAudioReader::~BufferingAudioReader()
 {
-    thread.removeTimeSliceClient (this);
+    scheduler.removeReader (*this);
 }
 
 void BufferingAudioReader::setReadTimeout (int timeoutMilliseconds) noexcept
@@ -73,6 +347,12 @@ bool BufferingAudioReader::readSamples (int* const* destSamples, int numDestChan
     nextReadPosition = startSampleInFile;
 
     bool allSamplesRead = true;
+    int64 lastMissingPosition = -1;
+
+    const auto numSamplesRequested = numSamples;
+
+    if (numSamplesRequested > 0)
+        ++scheduler.numReads;
 
     while (numSamples > 0)
     {
@@ -102,6 +382,9 @@ bool BufferingAudioReader::readSamples (int* const* destSamples, int numDestChan
         }
         else
         {
+            if (std::exchange (lastMissingPosition, startSampleInFile) != startSampleInFile)
+                ++scheduler.numLateBlocks;
+
             if (timeoutMs >= 0 && Time::getMillisecondCounter() >= startTime + (uint32) timeoutMs)
             {
                 for (int j = 0; j < numDestChannels; ++j)
@@ -119,6 +402,9 @@ bool BufferingAudioReader::readSamples (int* const* destSamples, int numDestChan
         }
     }
 
+    if (numSamplesRequested > 0 && lastMissingPosition < 0)
+        ++scheduler.numHits;
+
     return allSamplesRead;
 }
 
@@ -138,49 +424,12 @@ BufferingAudioReader::BufferedBlock* BufferingAudioReader::getBlockContaining (i
     return nullptr;
 }
 
-int BufferingAudioReader::useTimeSlice()
-{
-    return readNextBufferChunk() ? 1 : 100;
-}
-
-bool BufferingAudioReader::readNextBufferChunk()
+Range<int64> BufferingAudioReader::getRangeToBuffer() const noexcept
 {
     auto pos = (nextReadPosition.load() / samplesPerBlock) * samplesPerBlock;
-    auto endPos = jmin (lengthInSamples, pos + numBlocks * samplesPerBlock);
-
-    OwnedArray<BufferedBlock> newBlocks;
-
-    for (int i = blocks.size(); --i >= 0;)
-        if (blocks.getUnchecked (i)->range.intersects (Range<int64> (pos, endPos)))
-            newBlocks.add (blocks.getUnchecked (i));
-
-    if (newBlocks.size() == numBlocks)
-    {
-        newBlocks.clear (false);
-        return false;
-    }
-
-    for (auto p = pos; p < endPos; p += samplesPerBlock)
-    {
-        if (getBlockContaining (p) == nullptr)
-        {
-            newBlocks.add (new BufferedBlock (*source, p, samplesPerBlock));
-            break; // just do one block
-        }
-    }
-
-    {
-        const ScopedLock sl (lock);
-        newBlocks.swapWith (blocks);
-    }
-
-    for (int i = blocks.size(); --i >= 0;)
-        newBlocks.removeObject (blocks.getUnchecked (i), false);
-
-    return true;
+    return { pos, jmin (lengthInSamples, pos + numBlocks * samplesPerBlock) };
 }
 
-
 //==============================================================================
 //==============================================================================
 #if JUCE_UNIT_TESTS
@@ -239,6 +488,23 @@ struct TestAudioFormatReader : public AudioFormatReader
     const AudioBuffer<float>* buffer;
 };
 
+// Blocks in readSamples() until the gate is signalled
+struct GatedTestAudioFormatReader final : public TestAudioFormatReader
+{
+    using TestAudioFormatReader::TestAudioFormatReader;
+
+    bool readSamples (int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                      int64 startSampleInFile, int numSamples) override
+    {
+        isWaiting = true;
+        gate.wait();
+        return TestAudioFormatReader::readSamples (destChannels, numDestChannels, startOffsetInDestBuffer, startSampleInFile, numSamples);
+    }
+
+    WaitableEvent gate { true };
+    std::atomic<bool> isWaiting { false };
+};
+
 static AudioBuffer<float> generateTestBuffer (Random& random, int bufferSize)
 {
     AudioBuffer<float> buffer { 2, bufferSize };
@@ -321,9 +587,254 @@ public:
                 expect (source == destination);
             }
         }
+
+        beginTest ("Readers sharing a scheduler should produce the same samples as their sources");
+        {
+            Random random { getRandom() };
+            BufferingAudioReaderScheduler scheduler (thread);
+
+            std::vector<AudioBuffer<float>> sources, destinations;
+            std::vector<std::unique_ptr<BufferingAudioReader>> readers;
+
+            for (int i = 0; i < 8; ++i)
+                sources.push_back (generateTestBuffer (random, 50000 + random.nextInt (200000)));
+
+            for (auto& source : sources)
+            {
+                readers.push_back (std::make_unique<BufferingAudioReader> (new TestAudioFormatReader (&source), scheduler, 100000));
+                readers.back()->setReadTimeout (-1);
+                destinations.emplace_back (source.getNumChannels(), source.getNumSamples());
+            }
+
+            readInterleaved (readers, destinations);
+
+            for (size_t i = 0; i < sources.size(); ++i)
+                expect (sources[i] == destinations[i]);
+        }
+
+        beginTest ("A scheduler should keep its readers within its memory budget");
+        {
+            Random random { getRandom() };
+            constexpr auto bytesPerBlock = (size_t) 2 * 32768 * sizeof (float);
+            constexpr auto maxMemoryBytes = 6 * bytesPerBlock;
+
+            BufferingAudioReaderScheduler scheduler (thread, BufferingAudioReaderScheduler::Options{}.withMaxMemoryBytes (maxMemoryBytes));
+
+            std::vector<AudioBuffer<float>> sources, destinations;
+            std::vector<std::unique_ptr<BufferingAudioReader>> readers;
+
+            for (int i = 0; i < 4; ++i)
+                sources.push_back (generateTestBuffer (random, 10 * 32768));
+
+            for (auto& source : sources)
+            {
+                readers.push_back (std::make_unique<BufferingAudioReader> (new TestAudioFormatReader (&source), scheduler, 3 * 32768));
+                readers.back()->setReadTimeout (-1);
+                destinations.emplace_back (source.getNumChannels(), source.getNumSamples());
+            }
+
+            size_t maxBytesBuffered = 0;
+
+            readInterleaved (readers, destinations, [&]
+            {
+                maxBytesBuffered = jmax (maxBytesBuffered, scheduler.getStatistics().numBytesBuffered);
+            });
+
+            for (size_t i = 0; i < sources.size(); ++i)
+                expect (sources[i] == destinations[i]);
+
+            expectLessOrEqual (maxBytesBuffered, maxMemoryBytes);
+
+            // A reader that fills the whole budget has to give up blocks to one that needs them sooner
+            readers.clear();
+            readers.push_back (std::make_unique<BufferingAudioReader> (new TestAudioFormatReader (&sources[0]), scheduler, 9 * 32768));
+            expect (waitFor ([&] { return scheduler.getStatistics().numBytesBuffered == maxMemoryBytes; }));
+
+            scheduler.resetStatistics();
+            BufferingAudioReader otherReader (new TestAudioFormatReader (&sources[1]), scheduler, 32768);
+            otherReader.setReadTimeout (-1);
+
+            AudioBuffer<float> destination (2, 1000);
+            otherReader.read (&destination, 0, 1000, 50000, true, true);
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < 1000; ++i)
+                    expectEquals (destination.getSample (channel, i), sources[1].getSample (channel, 50000 + i));
+
+            const auto stats = scheduler.getStatistics();
+            expectGreaterThan (stats.numBlocksDropped, (int64) 0);
+            expectLessOrEqual (stats.numBytesBuffered, maxMemoryBytes);
+        }
+
+        beginTest ("A scheduler should count hits and late blocks");
+        {
+            Random random { getRandom() };
+            const auto source = generateTestBuffer (random, 1024);
+
+            BufferingAudioReaderScheduler scheduler (thread);
+            auto* gatedReader = new GatedTestAudioFormatReader (&source);
+            BufferingAudioReader reader (gatedReader, scheduler, 1024);
+
+            AudioBuffer<float> destination (2, 512);
+            expect (! reader.read (&destination, 0, 512, 0, true, true));
+
+            gatedReader->gate.signal();
+            expect (waitFor ([&] { return scheduler.getStatistics().numBlocksLoaded > 0; }));
+            expect (reader.read (&destination, 0, 512, 256, true, true));
+
+            const auto stats = scheduler.getStatistics();
+            expectEquals (stats.numReads, (int64) 2);
+            expectEquals (stats.numHits, (int64) 1);
+            expectEquals (stats.numLateBlocks, (int64) 1);
+            expectEquals (stats.getHitRate(), 0.5);
+        }
+
+        beginTest ("A scheduler should combine reads of adjacent blocks");
+        {
+            Random random { getRandom() };
+            const auto source = generateTestBuffer (random, 8 * 32768);
+
+            BufferingAudioReaderScheduler scheduler (thread, BufferingAudioReaderScheduler::Options{}.withMaxBlocksPerRead (4));
+            BufferingAudioReader reader (new TestAudioFormatReader (&source), scheduler, 7 * 32768);
+
+            expect (waitFor ([&] { return scheduler.getStatistics().numBlocksLoaded == 8; }));
+
+            const auto stats = scheduler.getStatistics();
+            expectLessOrEqual (stats.numSourceReads, (int64) 3);
+            expectEquals (stats.numBytesBuffered, (size_t) 8 * 32768 * 2 * sizeof (float));
+        }
+
+        beginTest ("A scheduler should only load one block for a reader that's waiting for it");
+        {
+            Random random { getRandom() };
+            const auto source = generateTestBuffer (random, 8 * 32768);
+
+            BufferingAudioReaderScheduler scheduler (thread, BufferingAudioReaderScheduler::Options{}.withMaxBlocksPerRead (4));
+            BufferingAudioReader reader (new TestAudioFormatReader (&source), scheduler, 7 * 32768);
+
+            expect (waitFor ([&] { return scheduler.getStatistics().numBlocksLoaded == 8; }));
+
+            // The block under the read position is needed straight away, so it's read on its
+            // own, and then the other seven are read four at a time
+            expectEquals (scheduler.getStatistics().numSourceReads, (int64) 3);
+        }
+
+        beginTest ("A reader always gets the block under its read position, even with no budget left");
+        {
+            Random random { getRandom() };
+            const auto source = generateTestBuffer (random, 4 * 32768);
+
+            BufferingAudioReaderScheduler scheduler (thread, BufferingAudioReaderScheduler::Options{}.withMaxMemoryBytes (1024));
+            BufferingAudioReader reader (new TestAudioFormatReader (&source), scheduler, 3 * 32768);
+            reader.setReadTimeout (-1);
+
+            AudioBuffer<float> destination (2, 1000);
+            expect (reader.read (&destination, 0, 1000, 40000, true, true));
+
+            for (int channel = 0; channel < 2; ++channel)
+                for (int i = 0; i < 1000; ++i)
+                    expectEquals (destination.getSample (channel, i), source.getSample (channel, 40000 + i));
+
+            // Nothing ahead of the read position fits in the budget
+            constexpr auto bytesPerBlock = (size_t) 2 * 32768 * sizeof (float);
+            expect (waitFor ([&] { return scheduler.getStatistics().numBytesBuffered == bytesPerBlock; }));
+            Thread::sleep (50);
+            expectEquals (scheduler.getStatistics().numBytesBuffered, bytesPerBlock);
+        }
+
+        beginTest ("Reads give up and return silence once the timeout has passed");
+        {
+            Random random { getRandom() };
+            const auto source = generateTestBuffer (random, 1024);
+
+            BufferingAudioReaderScheduler scheduler (thread);
+            auto* gatedReader = new GatedTestAudioFormatReader (&source);
+            BufferingAudioReader reader (gatedReader, scheduler, 1024);
+
+            for (const auto timeout : { 0, 50 })
+            {
+                reader.setReadTimeout (timeout);
+
+                auto destination = generateTestBuffer (random, 512);
+                const auto startTime = Time::getMillisecondCounter();
+                expect (! reader.read (&destination, 0, 512, 0, true, true));
+                const auto elapsed = (int) (Time::getMillisecondCounter() - startTime);
+
+                expect (isSilent (destination));
+                expectGreaterOrEqual (elapsed, timeout);
+                expectLessThan (elapsed, timeout + 1000);
+            }
+
+            gatedReader->gate.signal();
+        }
+
+        beginTest ("Readers can be added and removed while a source is being read");
+        {
+            Random random { getRandom() };
+            const auto source = generateTestBuffer (random, 1024);
+
+            BufferingAudioReaderScheduler scheduler (thread);
+            auto* gatedReader = new GatedTestAudioFormatReader (&source);
+            BufferingAudioReader reader (gatedReader, scheduler, 1024);
+            expect (waitFor ([&] { return gatedReader->isWaiting.load(); }));
+
+            WaitableEvent finished { true };
+
+            Thread::launch ([&]
+            {
+                BufferingAudioReader otherReader (new TestAudioFormatReader (&source), scheduler, 1024);
+                finished.signal();
+            });
+
+            expect (finished.wait (5000));
+            gatedReader->gate.signal();
+            finished.wait (-1);
+        }
     }
 
 private:
+    static bool waitFor (std::function<bool()> condition)
+    {
+        for (int i = 0; i < 500; ++i)
+        {
+            if (condition())
+                return true;
+
+            Thread::sleep (10);
+        }
+
+        return false;
+    }
+
+    static void readInterleaved (std::vector<std::unique_ptr<BufferingAudioReader>>& readers,
+                                 std::vector<AudioBuffer<float>>& destinations,
+                                 std::function<void()> afterEachRound = nullptr)
+    {
+        constexpr int blockSize = 4096;
+
+        for (int readPos = 0;; readPos += blockSize)
+        {
+            auto anyRead = false;
+
+            for (size_t i = 0; i < readers.size(); ++i)
+            {
+                const auto numSamples = jmin (blockSize, destinations[i].getNumSamples() - readPos);
+
+                if (numSamples > 0)
+                {
+                    readers[i]->read (&destinations[i], readPos, numSamples, readPos, true, true);
+                    anyRead = true;
+                }
+            }
+
+            if (afterEachRound != nullptr)
+                afterEachRound();
+
+            if (! anyRead)
+                break;
+        }
+    }
+
     void read (BufferingAudioReader& reader, AudioBuffer<float>& readBuffer)
     {
         constexpr int blockSize = 1024;
@@ -35,17 +35,136 @@
 namespace juce
 {
 
+class BufferingAudioReader;
+
+//==============================================================================
+/**
+    Does the background reading for a group of BufferingAudioReaders that share a
+    thread and a memory budget.
+
+    A BufferingAudioReader that's given a TimeSliceThread of its own refills its blocks
+    in order, without any regard for other readers. When many files are streaming at
+    once, create one scheduler and pass it to all the readers instead.
+
+    On each time slice, the scheduler reads the block that will be needed soonest by
+    any of its readers. This is worked out from each reader's read position, and the
+    speed at which that position has been moving. Where possible, adjacent blocks of
+    the same reader are read with a single call to its source.
+
+    The total size of all the readers' blocks is kept within a limit by dropping the
+    blocks that won't be needed for the longest time. The only exception is the block
+    under each reader's read position, which is always loaded.
+
+    @see BufferingAudioReader
+
+    @tags{Audio}
+*/
+class JUCE_API  BufferingAudioReaderScheduler  : private TimeSliceClient
+{
+public:
+    //==============================================================================
+    /** Options for creating a BufferingAudioReaderScheduler. */
+    struct Options
+    {
+        /** The maximum number of bytes of sample data that all the readers may hold. */
+        [[nodiscard]] Options withMaxMemoryBytes (size_t newMaxMemoryBytes) const
+        {
+            return withMember (*this, &Options::maxMemoryBytes, newMaxMemoryBytes);
+        }
+
+        /** The maximum number of adjacent blocks that may be read from a source at once.
+            Larger reads mean fewer seeks, but other readers have to wait longer for them.
+        */
+        [[nodiscard]] Options withMaxBlocksPerRead (int newMaxBlocksPerRead) const
+        {
+            return withMember (*this, &Options::maxBlocksPerRead, newMaxBlocksPerRead);
+        }
+
+        size_t maxMemoryBytes = 256 * 1024 * 1024;
+        int maxBlocksPerRead = 4;
+    };
+
+    //==============================================================================
+    /** A snapshot of the scheduler's counters. */
+    struct Statistics
+    {
+        int64 numReads = 0;             /**< The number of non-empty reads from the readers. */
+        int64 numHits = 0;              /**< The number of reads whose samples were all buffered already. */
+        int64 numLateBlocks = 0;        /**< The number of times a read needed a block that hadn't been loaded yet. */
+        int64 numBlocksLoaded = 0;      /**< The number of blocks that have been read from the sources. */
+        int64 numSourceReads = 0;       /**< The number of reads from the sources, which is lower than numBlocksLoaded when reads are combined. */
+        int64 numBlocksDropped = 0;     /**< The number of loaded blocks that were dropped to stay within the memory budget. */
+        size_t numBytesBuffered = 0;    /**< The current size of all the readers' blocks. */
+
+        /** Returns the proportion of reads that didn't have to wait for any blocks. */
+        double getHitRate() const noexcept  { return numReads > 0 ? (double) numHits / (double) numReads : 1.0; }
+    };
+
+    //==============================================================================
+    /** Creates a scheduler that will do its reading on the given thread.
+
+        Make sure that the thread is running, and that it outlives the scheduler. All the
+        readers that use the scheduler must be deleted before it is.
+    */
+    BufferingAudioReaderScheduler (TimeSliceThread& timeSliceThread, const Options& options);
+
+    /** Creates a scheduler with the default Options. */
+    explicit BufferingAudioReaderScheduler (TimeSliceThread& timeSliceThread);
+
+    /** Destructor. */
+    ~BufferingAudioReaderScheduler() override;
+
+    //==============================================================================
+    /** Returns the current statistics. This can be called from any thread. */
+    Statistics getStatistics() const noexcept;
+
+    /** Resets all the counters except numBytesBuffered. */
+    void resetStatistics() noexcept;
+
+private:
+    //==============================================================================
+    friend class BufferingAudioReader;
+
+    struct Candidate;
+
+    void addReader (BufferingAudioReader&);
+    void removeReader (BufferingAudioReader&);
+
+    int useTimeSlice() override;
+    void releaseBlocksOutsideRange (BufferingAudioReader&);
+    bool makeSpaceFor (size_t numBytes, const Candidate&);
+
+    static void updateReadRate (BufferingAudioReader&, double now);
+    static double getTimeUntilNeeded (const BufferingAudioReader&, int64 position);
+
+    TimeSliceThread& thread;
+    const Options options;
+
+    CriticalSection readersLock;
+    Array<BufferingAudioReader*> readers;
+
+    // The sources are read without holding readersLock, so this is held instead while
+    // a block is being loaded for readerBeingLoaded, which is guarded by readersLock
+    CriticalSection loadLock;
+    BufferingAudioReader* readerBeingLoaded = nullptr;
+
+    std::atomic<int64> numReads { 0 }, numHits { 0 }, numLateBlocks { 0 },
+                       numBlocksLoaded { 0 }, numSourceReads { 0 }, numBlocksDropped { 0 };
+    std::atomic<size_t> numBytesBuffered { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BufferingAudioReaderScheduler)
+};
+
 //==============================================================================
 /**
     An AudioFormatReader that uses a background thread to pre-read data from
     another reader.
 
-    @see AudioFormatReader
+    @see AudioFormatReader, BufferingAudioReaderScheduler
 
     @tags{Audio}
 */
-class JUCE_API  BufferingAudioReader  : public AudioFormatReader,
-                                        private TimeSliceClient
+class JUCE_API  BufferingAudioReader  : public AudioFormatReader
 {
 public:
     /** Creates a reader.
@@ -57,11 +176,29 @@ public:
                                 Make sure that the thread you supply is running, and won't
                                 be deleted while the reader object still exists.
         @param samplesToBuffer  the total number of samples to buffer ahead.
+
+        The thread loads one block at a time, and moves straight on to the next missing
+        block, so the buffer fills up as quickly as the source can be read. (Older versions
+        paused for 1ms after each block.)
     */
     BufferingAudioReader (AudioFormatReader* sourceReader,
                           TimeSliceThread& timeSliceThread,
                           int samplesToBuffer);
 
+    /** Creates a reader that shares its background reading and memory budget with
+        the other readers using the same scheduler.
+
+        @param sourceReader     the source reader to wrap. This BufferingAudioReader
+                                takes ownership of this object and will delete it later
+                                when no longer needed
+        @param scheduler        the scheduler that will fill this reader's buffers. It
+                                mustn't be deleted while the reader object still exists.
+        @param samplesToBuffer  the total number of samples to buffer ahead.
+    */
+    BufferingAudioReader (AudioFormatReader* sourceReader,
+                          BufferingAudioReaderScheduler& scheduler,
+                          int samplesToBuffer);
+
     ~BufferingAudioReader() override;
 
     /** Sets a number of milliseconds that the reader can block for in its readSamples()
@@ -76,27 +213,38 @@ public:
                       int64 startSampleInFile, int numSamples) override;
 
 private:
+    friend class BufferingAudioReaderScheduler;
+
     struct BufferedBlock
     {
         BufferedBlock (AudioFormatReader& reader, int64 pos, int numSamples);
 
+        size_t getNumBytes() const noexcept     { return (size_t) buffer.getNumChannels() * (size_t) buffer.getNumSamples() * sizeof (float); }
+
         Range<int64> range;
         AudioBuffer<float> buffer;
         bool allSamplesRead = false;
     };
 
-    int useTimeSlice() override;
+    BufferingAudioReader (AudioFormatReader*, BufferingAudioReaderScheduler*,
+                          std::unique_ptr<BufferingAudioReaderScheduler>, int samplesToBuffer);
+
     BufferedBlock* getBlockContaining (int64 pos) const noexcept;
-    bool readNextBufferChunk();
+    Range<int64> getRangeToBuffer() const noexcept;
 
     static constexpr int samplesPerBlock = 32768;
 
     std::unique_ptr<AudioFormatReader> source;
-    TimeSliceThread& thread;
+    std::unique_ptr<BufferingAudioReaderScheduler> ownedScheduler;
+    BufferingAudioReaderScheduler& scheduler;
     std::atomic<int64> nextReadPosition { 0 };
     const int numBlocks;
     int timeoutMs = 0;
 
+    // Only used by the scheduler's thread, to estimate how fast the reader is moving
+    int64 lastScheduledPosition = -1;
+    double lastScheduledTime = 0.0, samplesPerMs = 0.0;
+
     CriticalSection lock;
     OwnedArray<BufferedBlock> blocks;
 
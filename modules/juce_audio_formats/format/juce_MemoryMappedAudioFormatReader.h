@@ -81,6 +81,42 @@ public:
     /** Touches the memory for the given sample, to force it to be loaded into active memory. */
     void touchSample (int64 sample) const noexcept;
 
+    /** Tells the OS how a range of samples in the mapped section is going to be accessed.
+
+        This doesn't block, and only affects how quickly the samples can be read. Any part
+        of the range that lies outside the mapped section is ignored.
+
+        @see MemoryMappedFile::adviseAccess
+    */
+    void adviseAccess (Range<int64> samples, MemoryMappedFile::AccessHint hint) const noexcept;
+
+    /** Asks the OS to start loading a range of samples into memory in the background.
+
+        Unlike touchSample(), this returns immediately, so it's safe to call from a thread
+        that mustn't wait for the disk. Calling this a block or two ahead of the read position
+        avoids page faults when the samples are actually read.
+    */
+    void prefetchSamples (Range<int64> samples) const noexcept    { adviseAccess (samples, MemoryMappedFile::AccessHint::willNeed); }
+
+    /** Returns true if the file's samples are stored as 32-bit floats in the machine's
+        native byte order, which means that getMappedFloatData() can return them directly.
+    */
+    bool hasNativeFloatData() const noexcept                        { return usesFloatingPointData && bitsPerSample == 32 && isNativeFloatLayout(); }
+
+    /** Returns the mapped sample data for a range of samples, without copying or converting it.
+
+        The samples are interleaved, so the span contains numChannels values for each sample
+        in the range. For a mono file, the data can be wrapped directly in an AudioBuffer or a
+        dsp::AudioBlock.
+
+        This returns an empty span if the data isn't stored as native floats (see
+        hasNativeFloatData()), if it isn't suitably aligned in the file, or if any part of
+        the range hasn't been mapped. In those cases, use read() instead.
+
+        The span is only valid until the mapped section changes.
+    */
+    Span<const float> getMappedFloatData (Range<int64> samples) const noexcept;
+
     /** Returns the samples for all channels at a given sample position.
         The result array must be large enough to hold a value for each channel
         that this reader contains.
@@ -106,6 +142,20 @@ protected:
     /** Converts a sample index to a pointer to the mapped file memory. */
     inline const void* sampleToPointer (int64 sample) const noexcept { return addBytesToPointer (map->getData(), sampleToFilePos (sample) - map->getRange().getStart()); }
 
+    /** Subclasses should return true if 32-bit float data in their files uses the machine's
+        native byte order. This enables hasNativeFloatData() and getMappedFloatData().
+    */
+    virtual bool isNativeFloatLayout() const noexcept               { return false; }
+
+    /** Used by subclasses to read native float data into separate channels.
+
+        This is a faster alternative to converting the samples with AudioData, for use when
+        hasNativeFloatData() is true. The caller must have checked that the samples are mapped,
+        but the data doesn't need to be aligned in the file.
+    */
+    void readNativeFloatSamples (int* const* destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                                 int64 startSampleInFile, int numSamples) const noexcept;
+
     /** Used by AudioFormatReader subclasses to scan for min/max ranges in interleaved data. */
     template <typename SampleType, typename Endianness>
     Range<float> scanMinAndMaxInterleaved (int channel, int64 startSampleInFile, int64 numSamples) const noexcept
@@ -0,0 +1,248 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct MemoryMappedAudioFormatReaderTests final : public UnitTest
+{
+    MemoryMappedAudioFormatReaderTests()  : UnitTest ("MemoryMappedAudioFormatReader", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        beginTest ("Native float data can be accessed without copying");
+        {
+            for (const auto numChannels : { 1, 2, 6 })
+            {
+                const TemporaryFile tempFile (".wav");
+                const auto source = writeFile (tempFile.getFile(), numChannels, 32);
+
+                std::unique_ptr<MemoryMappedAudioFormatReader> reader (WavAudioFormat().createMemoryMappedReader (tempFile.getFile()));
+                expect (reader != nullptr && reader->mapEntireFile());
+
+                if (reader == nullptr)
+                    continue;
+
+                expect (reader->hasNativeFloatData() != ByteOrder::isBigEndian());
+
+                const Range<int64> range (100, 1100);
+                const auto data = reader->getMappedFloatData (range);
+
+                if (! reader->hasNativeFloatData())
+                {
+                    expect (data.empty());
+                    continue;
+                }
+
+                expectEquals ((int) data.size(), (int) range.getLength() * numChannels);
+
+                for (int i = 0; i < (int) range.getLength(); ++i)
+                    for (int channel = 0; channel < numChannels; ++channel)
+                        expectEquals (data[(size_t) (i * numChannels + channel)], source.getSample (channel, (int) range.getStart() + i));
+            }
+        }
+
+        beginTest ("Reads match the source for all channel layouts");
+        {
+            for (const auto bitDepth : { 16, 24, 32 })
+            {
+                for (const auto numChannels : { 1, 2, 3, 6 })
+                {
+                    const TemporaryFile tempFile (".wav");
+                    const auto source = writeFile (tempFile.getFile(), numChannels, bitDepth);
+
+                    std::unique_ptr<MemoryMappedAudioFormatReader> reader (WavAudioFormat().createMemoryMappedReader (tempFile.getFile()));
+                    expect (reader != nullptr && reader->mapEntireFile());
+
+                    if (reader == nullptr)
+                        continue;
+
+                    expect (reader->hasNativeFloatData() == (bitDepth == 32 && ! ByteOrder::isBigEndian()));
+
+                    const auto tolerance = bitDepth == 32 ? 0.0f : 2.0f / (float) (1 << (bitDepth - 1));
+
+                    for (const auto& [start, length] : { std::pair { 0, 1000 }, { 3, 5 }, { 1234, 4321 }, { numSourceSamples - 7, 7 } })
+                    {
+                        AudioBuffer<float> result (numChannels, length + 2);
+                        result.clear();
+                        reader->read (&result, 1, length, start, true, true);
+
+                        expectWithinAbsoluteError (findMaxError (result, 1, source, start, length), 0.0f, tolerance);
+                        expectEquals (result.getSample (0, 0), 0.0f);
+                        expectEquals (result.getSample (0, length + 1), 0.0f);
+                    }
+                }
+            }
+        }
+
+        beginTest ("Extra and missing destination channels are handled");
+        {
+            const TemporaryFile tempFile (".wav");
+            const auto source = writeFile (tempFile.getFile(), 2, 32);
+
+            std::unique_ptr<MemoryMappedAudioFormatReader> reader (WavAudioFormat().createMemoryMappedReader (tempFile.getFile()));
+            expect (reader != nullptr && reader->mapEntireFile());
+
+            constexpr int length = 555;
+            AudioBuffer<float> result (3, length);
+
+            for (int channel = 0; channel < 3; ++channel)
+                FloatVectorOperations::fill (result.getWritePointer (channel), 1.0f, length);
+
+            int* channels[] = { nullptr, reinterpret_cast<int*> (result.getWritePointer (1)), reinterpret_cast<int*> (result.getWritePointer (2)) };
+            expect (reader->readSamples (channels, 3, 0, 10, length));
+
+            for (int i = 0; i < length; ++i)
+            {
+                expectEquals (result.getSample (0, i), 1.0f);
+                expectEquals (result.getSample (1, i), source.getSample (1, 10 + i));
+                expectEquals (result.getSample (2, i), 0.0f);
+            }
+        }
+
+        beginTest ("Float data that isn't aligned in the file is read correctly");
+        {
+            for (const auto numChannels : { 1, 2, 3 })
+            {
+                const TemporaryFile tempFile (".wav");
+                const auto source = writeFile (tempFile.getFile(), numChannels, 32);
+                expect (insertChunkBeforeData (tempFile.getFile()));
+
+                std::unique_ptr<MemoryMappedAudioFormatReader> reader (WavAudioFormat().createMemoryMappedReader (tempFile.getFile()));
+                expect (reader != nullptr && reader->mapEntireFile());
+
+                if (reader == nullptr)
+                    continue;
+
+                expect (reader->getMappedFloatData ({ 0, 100 }).empty());
+
+                AudioBuffer<float> result (numChannels, 1000);
+                reader->read (&result, 0, result.getNumSamples(), 123, true, true);
+                expectEquals (findMaxError (result, 0, source, 123, result.getNumSamples()), 0.0f);
+            }
+        }
+
+        beginTest ("Data outside the mapped section isn't returned");
+        {
+            const TemporaryFile tempFile (".wav");
+            const auto source = writeFile (tempFile.getFile(), 2, 32);
+
+            std::unique_ptr<MemoryMappedAudioFormatReader> reader (WavAudioFormat().createMemoryMappedReader (tempFile.getFile()));
+            expect (reader != nullptr && reader->mapSectionOfFile ({ 5000, 9000 }));
+
+            const auto mapped = reader->getMappedSection();
+            expect (mapped.contains (Range<int64> (5000, 9000)));
+
+            expect (reader->getMappedFloatData ({ mapped.getStart() - 1, mapped.getStart() + 10 }).empty());
+            expect (reader->getMappedFloatData ({ mapped.getEnd() - 10, mapped.getEnd() + 1 }).empty());
+
+            // Hints are clipped to the mapped section, and never change the data
+            reader->prefetchSamples ({ 0, numSourceSamples });
+            reader->adviseAccess ({ 6000, 7000 }, MemoryMappedFile::AccessHint::dontNeed);
+            reader->adviseAccess ({ 5000, 9000 }, MemoryMappedFile::AccessHint::random);
+
+            AudioBuffer<float> result (2, 3000);
+            reader->read (&result, 0, result.getNumSamples(), 5500, true, true);
+            expectEquals (findMaxError (result, 0, source, 5500, result.getNumSamples()), 0.0f);
+        }
+    }
+
+private:
+    static constexpr int numSourceSamples = 20000;
+
+    static AudioBuffer<float> writeFile (const File& file, int numChannels, int bitDepth)
+    {
+        AudioBuffer<float> buffer (numChannels, numSourceSamples);
+        Random random (0x1234 + numChannels);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSourceSamples; ++i)
+                buffer.setSample (channel, i, random.nextFloat() * 1.6f - 0.8f);
+
+        std::unique_ptr<AudioFormatWriter> writer (WavAudioFormat().createWriterFor (file.createOutputStream().release(),
+                                                                                      44100.0, (unsigned int) numChannels,
+                                                                                      bitDepth, {}, 0));
+        writer->writeFromAudioSampleBuffer (buffer, 0, numSourceSamples);
+        return buffer;
+    }
+
+    // Adds a chunk with two bytes of data before the data chunk, which moves the samples
+    // to an offset in the file that isn't a multiple of four
+    static bool insertChunkBeforeData (const File& file)
+    {
+        MemoryBlock data;
+
+        if (! file.loadFileAsData (data))
+            return false;
+
+        size_t dataChunk = 12;
+
+        for (;;)
+        {
+            if (dataChunk + 8 > data.getSize())
+                return false;
+
+            if (memcmp (data.begin() + dataChunk, "data", 4) == 0)
+                break;
+
+            dataChunk += 8 + ((ByteOrder::littleEndianInt (data.begin() + dataChunk + 4) + 1) & ~1u);
+        }
+
+        const char chunk[] = { 'j', 'u', 'n', 'k', 2, 0, 0, 0, 0, 0 };
+        data.insert (chunk, sizeof (chunk), dataChunk);
+
+        const auto riffSize = ByteOrder::littleEndianInt (data.begin() + 4) + (uint32) sizeof (chunk);
+        const auto littleEndianRiffSize = ByteOrder::swapIfBigEndian (riffSize);
+        data.copyFrom (&littleEndianRiffSize, 4, sizeof (littleEndianRiffSize));
+
+        return file.replaceWithData (data.getData(), data.getSize());
+    }
+
+    static float findMaxError (const AudioBuffer<float>& result, int resultOffset,
+                               const AudioBuffer<float>& source, int sourceOffset, int length)
+    {
+        auto maxError = 0.0f;
+
+        for (int channel = 0; channel < source.getNumChannels(); ++channel)
+            for (int i = 0; i < length; ++i)
+                maxError = jmax (maxError, std::abs (result.getSample (channel, resultOffset + i)
+                                                       - source.getSample (channel, sourceOffset + i)));
+
+        return maxError;
+    }
+};
+
+static MemoryMappedAudioFormatReaderTests memoryMappedAudioFormatReaderTests;
+
+} // namespace juce
@@ -60,15 +60,25 @@
  #include <wmsdk.h>
 #endif
 
+#if JUCE_USE_SSE_INTRINSICS
+ #include <emmintrin.h>
+#endif
+
+#if JUCE_USE_ARM_NEON
+ #include <arm_neon.h>
+#endif
+
 //==============================================================================
 #include "format/juce_AudioFormat.cpp"
 #include "format/juce_AudioFormatManager.cpp"
+#include "format/juce_AudioFormatPipeline.cpp"
 #include "format/juce_AudioFormatReader.cpp"
 #include "format/juce_AudioFormatReaderSource.cpp"
 #include "format/juce_AudioFormatWriter.cpp"
 #include "format/juce_AudioSubsectionReader.cpp"
 #include "format/juce_BufferingAudioFormatReader.cpp"
 #include "sampler/juce_Sampler.cpp"
+#include "sampler/juce_StreamingSampler.cpp"
 #include "codecs/juce_AiffAudioFormat.cpp"
 #include "codecs/juce_CoreAudioFormat.cpp"
 #include "codecs/juce_FlacAudioFormat.cpp"
@@ -85,3 +95,11 @@
 #if JUCE_WINDOWS && JUCE_USE_WINDOWS_MEDIA_FORMAT
  #include "codecs/juce_WindowsMediaAudioFormat.cpp"
 #endif
+
+#if JUCE_UNIT_TESTS
+ #include "codecs/juce_FlacAudioFormat_test.cpp"
+ #include "codecs/juce_MP3AudioFormat_test.cpp"
+ #include "format/juce_AudioFormatPipeline_test.cpp"
+ #include "format/juce_MemoryMappedAudioFormatReader_test.cpp"
+ #include "sampler/juce_StreamingSampler_test.cpp"
+#endif
@@ -125,6 +125,7 @@
 #include "format/juce_MemoryMappedAudioFormatReader.h"
 #include "format/juce_AudioFormat.h"
 #include "format/juce_AudioFormatManager.h"
+#include "format/juce_AudioFormatPipeline.h"
 #include "format/juce_AudioFormatReaderSource.h"
 #include "format/juce_AudioSubsectionReader.h"
 #include "format/juce_BufferingAudioFormatReader.h"
@@ -137,6 +138,7 @@
 #include "codecs/juce_WavAudioFormat.h"
 #include "codecs/juce_WindowsMediaAudioFormat.h"
 #include "sampler/juce_Sampler.h"
+#include "sampler/juce_StreamingSampler.h"
 
 #if JucePlugin_Enable_ARA
  #include <juce_audio_processors/juce_audio_processors.h>
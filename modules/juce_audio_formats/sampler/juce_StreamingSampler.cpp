@@ -0,0 +1,439 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+StreamingSamplerSound::StreamingSamplerSound (const String& soundName,
+                                              std::unique_ptr<AudioFormatReader> source,
+                                              const BigInteger& notes,
+                                              int midiNoteForNormalPitch,
+                                              double attackTimeSecs,
+                                              double releaseTimeSecs,
+                                              double preloadTimeSecs,
+                                              double maxSampleLengthSeconds)
+    : name (soundName),
+      reader (std::move (source)),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    if (reader == nullptr)
+    {
+        jassertfalse;
+        return;
+    }
+
+    sourceSampleRate = reader->sampleRate;
+
+    if (auto* mapped = dynamic_cast<MemoryMappedAudioFormatReader*> (reader.get()))
+    {
+        // If you map a section yourself, it needs to cover the whole part of the file that will be played
+        isMemoryMapped = ! mapped->getMappedSection().isEmpty() || mapped->mapEntireFile();
+    }
+
+    if (sourceSampleRate > 0 && reader->lengthInSamples > 0)
+    {
+        length = jmin (reader->lengthInSamples,
+                       (int64) jmin (maxSampleLengthSeconds * sourceSampleRate, (double) std::numeric_limits<int64>::max() / 2));
+
+        numPreloaded = (int) jmin (length, (int64) (preloadTimeSecs * sourceSampleRate));
+
+        // The extra sample is for the interpolation at the point where the voice switches to the stream
+        preloaded.setSize (jmin (2, (int) reader->numChannels), numPreloaded + 1);
+        readFromSource (preloaded, 0, 0, numPreloaded + 1);
+
+        params.attack  = static_cast<float> (attackTimeSecs);
+        params.release = static_cast<float> (releaseTimeSecs);
+    }
+}
+
+StreamingSamplerSound::~StreamingSamplerSound()
+{
+}
+
+bool StreamingSamplerSound::appliesToNote (int midiNoteNumber)
+{
+    return midiNotes[midiNoteNumber];
+}
+
+bool StreamingSamplerSound::appliesToChannel (int /*midiChannel*/)
+{
+    return true;
+}
+
+void StreamingSamplerSound::readFromSource (AudioBuffer<float>& destination, int destStartSample,
+                                            int64 sourceStartSample, int numSamples)
+{
+    // Memory-mapped readers don't have any state, so they can be read from several threads at once
+    if (isMemoryMapped)
+    {
+        reader->read (&destination, destStartSample, numSamples, sourceStartSample, true, true);
+        return;
+    }
+
+    const ScopedLock sl (readerLock);
+    reader->read (&destination, destStartSample, numSamples, sourceStartSample, true, true);
+}
+
+//==============================================================================
+struct SamplerDiskStreamer::Stream
+{
+    explicit Stream (int bufferSize)  : buffer (2, bufferSize) {}
+
+    AudioBuffer<float> buffer;
+
+    // Keeps the sound alive for as long as a background thread might be reading it
+    SynthesiserSound::Ptr soundHolder;
+    StreamingSamplerSound* sound = nullptr;
+
+    // Positions in the source. The voice only moves readPosition, and the background
+    // threads only move writePosition.
+    std::atomic<int64> readPosition { 0 }, writePosition { 0 };
+
+    // Set while the stream is waiting in the queue or being serviced, so that only one
+    // background thread can touch it at a time
+    std::atomic<bool> readPending { false };
+    std::atomic<bool> retired { false };
+};
+
+class SamplerDiskStreamer::IOThread final : public Thread
+{
+public:
+    IOThread (SamplerDiskStreamer& o, int index)
+        : Thread ("Sampler disk streamer " + String (index)), owner (o)
+    {
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            Stream* stream = nullptr;
+
+            if (owner.pendingReads.pop (stream))
+                owner.service (*stream);
+            else
+                owner.readsPending.wait (50);
+        }
+    }
+
+private:
+    SamplerDiskStreamer& owner;
+};
+
+SamplerDiskStreamer::SamplerDiskStreamer (int maxNumStreams, int numThreads, int bufferSizeSamples,
+                                          int maxBlockSizeToUse, double maxPitchRatioToUse)
+    : maxBlockSize (jmax (1, maxBlockSizeToUse)),
+      maxPitchRatio (jmax (1.0, maxPitchRatioToUse)),
+      bufferSize (nextPowerOfTwo (jmax (256, bufferSizeSamples, 2 * roundToInt (std::ceil (maxPitchRatio * maxBlockSize))))),
+      chunkSize (bufferSize / 4),
+      freeStreams (jmax (1, maxNumStreams)),
+      pendingReads (jmax (1, maxNumStreams))
+{
+    for (int i = 0; i < maxNumStreams; ++i)
+    {
+        streams.push_back (std::make_unique<Stream> (bufferSize));
+        freeStreams.push (streams.back().get());
+    }
+
+    for (int i = 0; i < jmax (1, numThreads); ++i)
+    {
+        threads.push_back (std::make_unique<IOThread> (*this, i));
+        threads.back()->startThread (Thread::Priority::high);
+    }
+}
+
+SamplerDiskStreamer::~SamplerDiskStreamer()
+{
+    // All the voices using this streamer must be deleted before it!
+    jassert (numActiveStreams == 0);
+
+    for (auto& thread : threads)
+        thread->signalThreadShouldExit();
+
+    for (auto& thread : threads)
+        thread->stopThread (4000);
+}
+
+void SamplerDiskStreamer::resetStatistics() noexcept
+{
+    numUnderruns = 0;
+    numSamplesRead = 0;
+}
+
+SamplerDiskStreamer::Stream* SamplerDiskStreamer::acquireStream (StreamingSamplerSound& sound) noexcept
+{
+    Stream* stream = nullptr;
+
+    if (! freeStreams.pop (stream))
+        return nullptr;
+
+    stream->soundHolder = &sound;
+    stream->sound = &sound;
+    stream->readPosition = sound.numPreloaded;
+    stream->writePosition = sound.numPreloaded;
+    stream->retired = false;
+    ++numActiveStreams;
+
+    requestRead (*stream);
+    return stream;
+}
+
+void SamplerDiskStreamer::releaseStream (Stream& stream) noexcept
+{
+    // The stream is handed back through the read queue, because a background thread
+    // might still be busy with it
+    stream.retired = true;
+    --numActiveStreams;
+
+    requestRead (stream);
+}
+
+void SamplerDiskStreamer::requestRead (Stream& stream) noexcept
+{
+    if (! stream.readPending.exchange (true))
+    {
+        [[maybe_unused]] const auto pushed = pendingReads.push (&stream);
+        jassert (pushed);
+
+        readsPending.signal();
+    }
+}
+
+void SamplerDiskStreamer::service (Stream& stream)
+{
+    const auto end = stream.sound->length + 1;
+    auto write = stream.writePosition.load();
+
+    if (! stream.retired)
+    {
+        // If the voice has overtaken the stream, the audio in between has already been
+        // skipped, so carry on from where the voice is now
+        write = jmax (write, stream.readPosition.load());
+
+        const auto numToRead = (int) jmin ((int64) chunkSize, jmin (end, stream.readPosition + bufferSize) - write);
+
+        if (numToRead > 0)
+        {
+            const auto offset = (int) (write & (bufferSize - 1));
+            const auto numBeforeWrap = jmin (numToRead, bufferSize - offset);
+
+            stream.sound->readFromSource (stream.buffer, offset, write, numBeforeWrap);
+
+            if (numBeforeWrap < numToRead)
+                stream.sound->readFromSource (stream.buffer, 0, write + numBeforeWrap, numToRead - numBeforeWrap);
+
+            write += numToRead;
+            stream.writePosition = write;
+            numSamplesRead += numToRead;
+        }
+    }
+
+    stream.readPending = false;
+
+    if (stream.retired)
+    {
+        if (! stream.readPending.exchange (true))
+            recycle (stream);
+    }
+    else if (write < end && stream.readPosition + bufferSize - write >= chunkSize)
+    {
+        requestRead (stream);
+    }
+}
+
+void SamplerDiskStreamer::recycle (Stream& stream)
+{
+    stream.sound = nullptr;
+    stream.soundHolder = nullptr;
+    stream.retired = false;
+    stream.readPending = false;
+
+    freeStreams.push (&stream);
+}
+
+//==============================================================================
+StreamingSamplerVoice::StreamingSamplerVoice (SamplerDiskStreamer& s)  : streamer (s) {}
+
+StreamingSamplerVoice::~StreamingSamplerVoice()
+{
+    releaseStream();
+}
+
+bool StreamingSamplerVoice::canPlaySound (SynthesiserSound* sound)
+{
+    return dynamic_cast<const StreamingSamplerSound*> (sound) != nullptr;
+}
+
+void StreamingSamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
+{
+    releaseStream();
+
+    if (auto* sound = dynamic_cast<StreamingSamplerSound*> (s))
+    {
+        // The streamer can't keep up with voices that play faster than this
+        pitchRatio = jmin (streamer.maxPitchRatio,
+                           std::pow (2.0, (midiNoteNumber - sound->midiRootNote) / 12.0)
+                               * sound->sourceSampleRate / getSampleRate());
+
+        sourceSamplePosition = 0.0;
+        lgain = velocity;
+        rgain = velocity;
+
+        adsr.setSampleRate (sound->sourceSampleRate);
+        adsr.setParameters (sound->params);
+
+        if (sound->length > sound->numPreloaded)
+            stream = streamer.acquireStream (*sound);
+
+        adsr.noteOn();
+    }
+    else
+    {
+        jassertfalse; // this object can only play StreamingSamplerSounds!
+    }
+}
+
+void StreamingSamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
+{
+    if (allowTailOff)
+    {
+        adsr.noteOff();
+    }
+    else
+    {
+        clearCurrentNote();
+        adsr.reset();
+        releaseStream();
+    }
+}
+
+void StreamingSamplerVoice::releaseStream() noexcept
+{
+    if (stream != nullptr)
+        streamer.releaseStream (*std::exchange (stream, nullptr));
+}
+
+void StreamingSamplerVoice::pitchWheelMoved (int /*newValue*/) {}
+void StreamingSamplerVoice::controllerMoved (int /*controllerNumber*/, int /*newValue*/) {}
+
+//==============================================================================
+void StreamingSamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    if (auto* playingSound = static_cast<StreamingSamplerSound*> (getCurrentlyPlayingSound().get()))
+    {
+        const auto numPreloaded = (int64) playingSound->numPreloaded;
+        const auto& preloaded = playingSound->preloaded;
+        const auto stereo = preloaded.getNumChannels() > 1;
+
+        // Everything before this position is either preloaded or has already been streamed
+        const auto available = stream != nullptr ? jmax (stream->writePosition.load(), numPreloaded + 1)
+                                                 : numPreloaded + 1;
+
+        const auto ringMask = (int64) streamer.bufferSize - 1;
+
+        // The streamer's buffers aren't big enough for blocks larger than this
+        jassert (stream == nullptr || numSamples <= streamer.maxBlockSize);
+
+        const auto getSample = [&] (int channel, int64 index) noexcept
+        {
+            return index <= numPreloaded ? preloaded.getSample (channel, (int) index)
+                                         : stream->buffer.getSample (channel, (int) (index & ringMask));
+        };
+
+        float* outL = outputBuffer.getWritePointer (0, startSample);
+        float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+        bool underrun = false;
+
+        while (--numSamples >= 0)
+        {
+            auto pos = (int64) sourceSamplePosition;
+            float l = 0.0f, r = 0.0f;
+
+            if (pos + 1 < available)
+            {
+                auto alpha = (float) (sourceSamplePosition - (double) pos);
+                auto invAlpha = 1.0f - alpha;
+
+                // just using a very simple linear interpolation here..
+                l = getSample (0, pos) * invAlpha + getSample (0, pos + 1) * alpha;
+                r = stereo ? getSample (1, pos) * invAlpha + getSample (1, pos + 1) * alpha
+                           : l;
+            }
+            else
+            {
+                // The stream hasn't caught up, so this sample is lost
+                underrun = true;
+            }
+
+            auto envelopeValue = adsr.getNextSample();
+
+            l *= lgain * envelopeValue;
+            r *= rgain * envelopeValue;
+
+            if (outR != nullptr)
+            {
+                *outL++ += l;
+                *outR++ += r;
+            }
+            else
+            {
+                *outL++ += (l + r) * 0.5f;
+            }
+
+            sourceSamplePosition += pitchRatio;
+
+            if (sourceSamplePosition > (double) playingSound->length || ! adsr.isActive())
+            {
+                stopNote (0.0f, false);
+                break;
+            }
+        }
+
+        if (underrun)
+            streamer.addUnderrun();
+
+        if (stream != nullptr)
+        {
+            const auto readPosition = jmax (numPreloaded, (int64) sourceSamplePosition);
+            const auto writePosition = stream->writePosition.load();
+            stream->readPosition = readPosition;
+
+            if (writePosition <= playingSound->length && readPosition + streamer.bufferSize - writePosition >= streamer.chunkSize)
+                streamer.requestRead (*stream);
+        }
+    }
+}
+
+} // namespace juce
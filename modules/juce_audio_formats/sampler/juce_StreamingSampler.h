@@ -0,0 +1,277 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class StreamingSamplerVoice;
+
+//==============================================================================
+/**
+    A SynthesiserSound that plays a sample by streaming it from disk.
+
+    Unlike SamplerSound, which loads the whole sample into memory, this only keeps
+    the first part of the sample in memory, and StreamingSamplerVoice objects read
+    the rest on demand, using a SamplerDiskStreamer. This means that very large
+    sample libraries can be played without needing to fit in RAM.
+
+    The amount of audio that gets preloaded needs to be long enough to cover the
+    time it takes the streamer to read the first chunk from disk after a note starts.
+
+    @see StreamingSamplerVoice, SamplerDiskStreamer, SamplerSound
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerSound    : public SynthesiserSound
+{
+public:
+    //==============================================================================
+    /** Creates a streaming sound from an audio reader.
+
+        @param name         a name for the sample
+        @param source       the reader to stream the audio from. The sound takes ownership
+                            of it, and it must stay valid for as long as the sound exists.
+                            If it's a MemoryMappedAudioFormatReader, the whole file will be
+                            mapped (if no section has been mapped already) and the voices
+                            can read from it concurrently; other types of reader are only
+                            used by one streaming thread at a time
+        @param midiNotes    the set of midi keys that this sound should be played on
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate
+        @param attackTimeSecs   the attack (fade-in) time, in seconds
+        @param releaseTimeSecs  the decay (fade-out) time, in seconds
+        @param preloadTimeSecs  the length of audio to keep in memory, in seconds
+        @param maxSampleLengthSeconds   a maximum length of audio to play from the source,
+                                        in seconds
+    */
+    StreamingSamplerSound (const String& name,
+                           std::unique_ptr<AudioFormatReader> source,
+                           const BigInteger& midiNotes,
+                           int midiNoteForNormalPitch,
+                           double attackTimeSecs,
+                           double releaseTimeSecs,
+                           double preloadTimeSecs,
+                           double maxSampleLengthSeconds = std::numeric_limits<double>::max());
+
+    /** Destructor. */
+    ~StreamingSamplerSound() override;
+
+    //==============================================================================
+    /** Returns the sample's name */
+    const String& getName() const noexcept                          { return name; }
+
+    /** Returns the number of samples that will be played. */
+    int64 getLengthInSamples() const noexcept                       { return length; }
+
+    /** Returns the number of samples at the start of the sound that are held in memory. */
+    int getNumPreloadedSamples() const noexcept                     { return numPreloaded; }
+
+    /** Returns the part of the sample that is held in memory. */
+    const AudioBuffer<float>& getPreloadedData() const noexcept     { return preloaded; }
+
+    //==============================================================================
+    /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
+    void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
+
+    //==============================================================================
+    bool appliesToNote (int midiNoteNumber) override;
+    bool appliesToChannel (int midiChannel) override;
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerVoice;
+    friend class SamplerDiskStreamer;
+
+    void readFromSource (AudioBuffer<float>& destination, int destStartSample, int64 sourceStartSample, int numSamples);
+
+    String name;
+    std::unique_ptr<AudioFormatReader> reader;
+    CriticalSection readerLock;
+    bool isMemoryMapped = false;
+    AudioBuffer<float> preloaded;
+    double sourceSampleRate = 0;
+    BigInteger midiNotes;
+    int64 length = 0;
+    int numPreloaded = 0, midiRootNote = 0;
+
+    ADSR::Parameters params;
+
+    JUCE_LEAK_DETECTOR (StreamingSamplerSound)
+};
+
+//==============================================================================
+/**
+    Reads the audio for StreamingSamplerVoice objects from disk, on a set of
+    background threads.
+
+    Each voice that is playing a StreamingSamplerSound borrows a stream from
+    this object, which holds a ring buffer that the background threads keep
+    topped up. The voices and the background threads only communicate through
+    lock-free queues and atomics, so the audio thread never blocks on disk I/O.
+    If a voice catches up with the data that has been read, it plays silence for
+    the missing samples and the underrun is counted, and the stream skips ahead to
+    the voice's new position rather than reading the audio that has been missed.
+
+    Create one of these, and pass it to all the StreamingSamplerVoice objects
+    in a Synthesiser. It must outlive the voices.
+
+    @see StreamingSamplerVoice, StreamingSamplerSound
+
+    @tags{Audio}
+*/
+class JUCE_API  SamplerDiskStreamer
+{
+public:
+    //==============================================================================
+    /** Creates a streamer.
+
+        @param maxNumStreams        the largest number of voices that can stream at once.
+                                    Voices that start when all the streams are in use
+                                    will only play the preloaded part of their sound
+        @param numThreads           the number of background threads to read with
+        @param bufferSizeSamples    the size of each stream's ring buffer. The threads
+                                    read in chunks of a quarter of this size
+        @param maxBlockSize         the largest number of samples that the voices will be
+                                    asked to render in one go
+        @param maxPitchRatio        the fastest rate at which a voice can play through its
+                                    sound. Notes that would play faster than this are
+                                    clamped to it. The ring buffers are made at least big
+                                    enough to hold two blocks of audio at this rate, so
+                                    that the threads can keep up
+    */
+    SamplerDiskStreamer (int maxNumStreams, int numThreads = 2, int bufferSizeSamples = 32768,
+                         int maxBlockSize = 4096, double maxPitchRatio = 4.0);
+
+    /** Destructor. */
+    ~SamplerDiskStreamer();
+
+    //==============================================================================
+    /** Returns the number of times that a voice has run out of data during a block
+        since the statistics were last reset.
+    */
+    int64 getNumUnderruns() const noexcept              { return numUnderruns.load(); }
+
+    /** Returns the number of sample frames that have been read from disk since the
+        statistics were last reset.
+    */
+    int64 getNumSamplesRead() const noexcept            { return numSamplesRead.load(); }
+
+    /** Returns the number of streams that are currently in use by voices. */
+    int getNumActiveStreams() const noexcept            { return numActiveStreams.load(); }
+
+    /** Returns the size of each stream's ring buffer, in samples. */
+    int getBufferSize() const noexcept                  { return bufferSize; }
+
+    /** Returns the fastest rate at which a voice can play through its sound. */
+    double getMaxPitchRatio() const noexcept            { return maxPitchRatio; }
+
+    /** Resets the underrun and throughput counters. */
+    void resetStatistics() noexcept;
+
+private:
+    //==============================================================================
+    friend class StreamingSamplerVoice;
+
+    struct Stream;
+    class IOThread;
+
+    Stream* acquireStream (StreamingSamplerSound&) noexcept;
+    void releaseStream (Stream&) noexcept;
+    void requestRead (Stream&) noexcept;
+    void service (Stream&);
+    void recycle (Stream&);
+    void addUnderrun() noexcept                         { ++numUnderruns; }
+
+    const int maxBlockSize;
+    const double maxPitchRatio;
+    const int bufferSize, chunkSize;
+    std::vector<std::unique_ptr<Stream>> streams;
+    MPMCQueue<Stream*> freeStreams, pendingReads;
+    WaitableEvent readsPending;
+    std::vector<std::unique_ptr<IOThread>> threads;
+    std::atomic<int64> numUnderruns { 0 }, numSamplesRead { 0 };
+    std::atomic<int> numActiveStreams { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SamplerDiskStreamer)
+};
+
+//==============================================================================
+/**
+    A SynthesiserVoice that can play a StreamingSamplerSound.
+
+    The voice plays the preloaded start of the sound straight away, and reads the
+    rest from disk using a SamplerDiskStreamer.
+
+    @see StreamingSamplerSound, SamplerDiskStreamer, SamplerVoice
+
+    @tags{Audio}
+*/
+class JUCE_API  StreamingSamplerVoice    : public SynthesiserVoice
+{
+public:
+    //==============================================================================
+    /** Creates a voice that streams its audio using the given streamer. */
+    explicit StreamingSamplerVoice (SamplerDiskStreamer& streamer);
+
+    /** Destructor. */
+    ~StreamingSamplerVoice() override;
+
+    //==============================================================================
+    bool canPlaySound (SynthesiserSound*) override;
+
+    void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int pitchWheel) override;
+    void stopNote (float velocity, bool allowTailOff) override;
+
+    void pitchWheelMoved (int newValue) override;
+    void controllerMoved (int controllerNumber, int newValue) override;
+
+    void renderNextBlock (AudioBuffer<float>&, int startSample, int numSamples) override;
+    using SynthesiserVoice::renderNextBlock;
+
+private:
+    //==============================================================================
+    void releaseStream() noexcept;
+
+    SamplerDiskStreamer& streamer;
+    SamplerDiskStreamer::Stream* stream = nullptr;
+    double pitchRatio = 0;
+    double sourceSamplePosition = 0;
+    float lgain = 0, rgain = 0;
+
+    ADSR adsr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StreamingSamplerVoice)
+};
+
+} // namespace juce
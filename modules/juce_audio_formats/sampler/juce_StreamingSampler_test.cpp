@@ -0,0 +1,330 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct StreamingSamplerTests final : public UnitTest
+{
+    StreamingSamplerTests()  : UnitTest ("StreamingSampler", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        const auto source = makeSource();
+
+        beginTest ("Streamed output matches the source");
+        {
+            const auto block = writeToBlock (source);
+            auto reader = rawToUniquePtr (WavAudioFormat().createReaderFor (new MemoryInputStream (block, false), true));
+            expect (reader != nullptr);
+
+            expectPlaysSource (std::move (reader), source);
+        }
+
+        beginTest ("Streamed output from a memory-mapped reader matches the source");
+        {
+            const auto block = writeToBlock (source);
+            TemporaryFile tempFile (".wav");
+            expect (tempFile.getFile().replaceWithData (block.getData(), block.getSize()));
+
+            std::unique_ptr<AudioFormatReader> reader (WavAudioFormat().createMemoryMappedReader (tempFile.getFile()));
+            expect (reader != nullptr);
+
+            expectPlaysSource (std::move (reader), source);
+        }
+
+        beginTest ("Voices without a stream count underruns");
+        {
+            const auto block = writeToBlock (source);
+            auto reader = rawToUniquePtr (WavAudioFormat().createReaderFor (new MemoryInputStream (block, false), true));
+
+            SamplerDiskStreamer streamer (1, 1, bufferSize, blockSize);
+
+            {
+                Synthesiser synth;
+                synth.setCurrentPlaybackSampleRate (sampleRate);
+                synth.addVoice (new StreamingSamplerVoice (streamer));
+                synth.addVoice (new StreamingSamplerVoice (streamer));
+                synth.addSound (makeSound (std::move (reader)));
+
+                synth.noteOn (1, rootNote, 1.0f);
+                synth.noteOn (2, rootNote, 1.0f);
+                expectEquals (streamer.getNumActiveStreams(), 1);
+
+                AudioBuffer<float> output (2, blockSize);
+                MidiBuffer midi;
+
+                for (int i = 0; i < 4; ++i)
+                    synth.renderNextBlock (output, midi, 0, blockSize);
+
+                expectGreaterThan (streamer.getNumUnderruns(), (int64) 0);
+
+                synth.allNotesOff (0, false);
+                expectEquals (streamer.getNumActiveStreams(), 0);
+            }
+
+            streamer.resetStatistics();
+            expectEquals (streamer.getNumUnderruns(), (int64) 0);
+        }
+
+        beginTest ("The ring buffer is big enough for the maximum pitch ratio");
+        {
+            const SamplerDiskStreamer streamer (1, 1, 256, blockSize, 8.0);
+            expectGreaterOrEqual (streamer.getBufferSize(), 2 * 8 * blockSize);
+        }
+
+        beginTest ("Notes that play faster than the maximum pitch ratio are clamped");
+        {
+            const auto maxPitchRatio = 4.0;
+            SamplerDiskStreamer streamer (1, 1, bufferSize, blockSize, maxPitchRatio);
+            expectEquals (streamer.getBufferSize(), bufferSize);
+
+            auto* reader = new GatedReader (source);
+            Synthesiser synth;
+            synth.setCurrentPlaybackSampleRate (sampleRate);
+            synth.addVoice (new StreamingSamplerVoice (streamer));
+
+            auto* sound = makeSound (rawToUniquePtr<AudioFormatReader> (reader));
+            synth.addSound (sound);
+            const auto numPreloaded = sound->getNumPreloadedSamples();
+
+            // Three octaves up would need more than the whole ring buffer in each block
+            synth.noteOn (1, rootNote + 36, 1.0f);
+
+            AudioBuffer<float> output (2, blockSize);
+            MidiBuffer midi;
+
+            for (int64 position = 0; position < sourceLength - (int64) maxPitchRatio * blockSize; position += (int64) maxPitchRatio * blockSize)
+            {
+                waitForReads (streamer, jmax ((int64) numPreloaded, position) + bufferSize - bufferSize / 4 + 1 - numPreloaded);
+                synth.renderNextBlock (output, midi, 0, blockSize);
+            }
+
+            expectEquals (streamer.getNumUnderruns(), (int64) 0);
+            synth.allNotesOff (0, false);
+        }
+
+        beginTest ("A stream that has been overtaken carries on from the voice's position");
+        {
+            SamplerDiskStreamer streamer (1, 1, bufferSize, blockSize);
+            const auto chunkSize = bufferSize / 4;
+
+            auto* reader = new GatedReader (source);
+            Synthesiser synth;
+            synth.setCurrentPlaybackSampleRate (sampleRate);
+            synth.addVoice (new StreamingSamplerVoice (streamer));
+
+            auto* sound = makeSound (rawToUniquePtr<AudioFormatReader> (reader));
+            synth.addSound (sound);
+            const auto numPreloaded = sound->getNumPreloadedSamples();
+
+            // Stall the disk so that the voice runs out of data
+            reader->open = false;
+            synth.noteOn (1, rootNote, 1.0f);
+
+            AudioBuffer<float> output (2, blockSize);
+            MidiBuffer midi;
+            const auto numBlocks = 20;
+
+            for (int tries = 0; ! reader->stalled && tries < 5000; ++tries)
+                Thread::sleep (1);
+
+            for (int i = 0; i < numBlocks; ++i)
+                synth.renderNextBlock (output, midi, 0, blockSize);
+
+            expectGreaterThan (streamer.getNumUnderruns(), (int64) 0);
+
+            // The read that was stalled finishes, and then the stream should only read the
+            // audio in front of the voice
+            reader->open = true;
+            const auto expectedRead = (int64) chunkSize + bufferSize;
+            waitForReads (streamer, expectedRead);
+            Thread::sleep (20);
+            expectEquals (streamer.getNumSamplesRead(), expectedRead);
+
+            streamer.resetStatistics();
+            output.clear();
+            synth.renderNextBlock (output, midi, 0, blockSize);
+            expectEquals (streamer.getNumUnderruns(), (int64) 0);
+
+            const auto position = numBlocks * blockSize;
+            expectGreaterThan (position, numPreloaded + chunkSize);
+
+            for (int i = 0; i < blockSize; ++i)
+            {
+                if (! exactlyEqual (output.getSample (0, i), source.getSample (0, position + i)))
+                {
+                    expect (false, "Mismatch at sample " + String (position + i));
+                    break;
+                }
+            }
+
+            synth.allNotesOff (0, false);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr int sourceLength = 20000, bufferSize = 1024, blockSize = 128, rootNote = 60;
+
+    // Reads from a buffer, but blocks while it's closed, like a stalled disk
+    struct GatedReader final : public AudioFormatReader
+    {
+        explicit GatedReader (const AudioBuffer<float>& sourceToUse)
+            : AudioFormatReader (nullptr, "Gated"), source (sourceToUse)
+        {
+            sampleRate = StreamingSamplerTests::sampleRate;
+            bitsPerSample = 32;
+            lengthInSamples = source.getNumSamples();
+            numChannels = 1;
+            usesFloatingPointData = true;
+        }
+
+        bool readSamples (int* const* destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override
+        {
+            while (! open)
+            {
+                stalled = true;
+                Thread::sleep (1);
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto index = startSampleInFile + i;
+                const auto sample = index < source.getNumSamples() ? source.getSample (0, (int) index) : 0.0f;
+
+                for (int ch = 0; ch < numDestChannels; ++ch)
+                    if (destChannels[ch] != nullptr)
+                        reinterpret_cast<float*> (destChannels[ch])[startOffsetInDestBuffer + i] = sample;
+            }
+
+            return true;
+        }
+
+        const AudioBuffer<float>& source;
+        std::atomic<bool> open { true }, stalled { false };
+    };
+
+    static void waitForReads (const SamplerDiskStreamer& streamer, int64 numSamples)
+    {
+        for (int tries = 0; streamer.getNumSamplesRead() < numSamples && tries < 5000; ++tries)
+            Thread::sleep (1);
+    }
+
+    static AudioBuffer<float> makeSource()
+    {
+        AudioBuffer<float> source (1, sourceLength);
+        Random random (0x1234);
+
+        for (int i = 0; i < sourceLength; ++i)
+            source.setSample (0, i, random.nextFloat() * 2.0f - 1.0f);
+
+        return source;
+    }
+
+    static MemoryBlock writeToBlock (const AudioBuffer<float>& source)
+    {
+        MemoryBlock block;
+
+        {
+            auto writer = rawToUniquePtr (WavAudioFormat().createWriterFor (new MemoryOutputStream (block, false),
+                                                                            sampleRate, 1, 32, {}, 0));
+            writer->writeFromAudioSampleBuffer (source, 0, source.getNumSamples());
+        }
+
+        return block;
+    }
+
+    static StreamingSamplerSound* makeSound (std::unique_ptr<AudioFormatReader> reader)
+    {
+        BigInteger notes;
+        notes.setRange (0, 128, true);
+
+        auto* sound = new StreamingSamplerSound ("test", std::move (reader), notes, rootNote, 0.0, 0.0, 0.01);
+        sound->setEnvelopeParameters ({ 0.0f, 0.0f, 1.0f, 0.0f });
+        return sound;
+    }
+
+    void expectPlaysSource (std::unique_ptr<AudioFormatReader> reader, const AudioBuffer<float>& source)
+    {
+        SamplerDiskStreamer streamer (4, 2, bufferSize, blockSize);
+        const auto chunkSize = bufferSize / 4;
+
+        Synthesiser synth;
+        synth.setCurrentPlaybackSampleRate (sampleRate);
+        synth.addVoice (new StreamingSamplerVoice (streamer));
+
+        auto* sound = makeSound (std::move (reader));
+        synth.addSound (sound);
+        const auto numPreloaded = sound->getNumPreloadedSamples();
+        expectLessThan (numPreloaded, sourceLength);
+
+        synth.noteOn (1, rootNote, 1.0f);
+
+        AudioBuffer<float> output (2, sourceLength);
+        output.clear();
+        MidiBuffer midi;
+
+        for (int position = 0; position < sourceLength; position += blockSize)
+        {
+            // Wait for the streamer to fill the ring buffer, as it would in between audio callbacks
+            const auto expectedRead = jmin ((int64) sourceLength + 1, (int64) (position + bufferSize - chunkSize + 1)) - numPreloaded;
+
+            for (int tries = 0; streamer.getNumSamplesRead() < expectedRead && tries < 5000; ++tries)
+                Thread::sleep (1);
+
+            synth.renderNextBlock (output, midi, position, jmin (blockSize, sourceLength - position));
+        }
+
+        expectEquals (streamer.getNumUnderruns(), (int64) 0);
+
+        for (int i = 0; i < sourceLength; ++i)
+        {
+            if (! exactlyEqual (output.getSample (0, i), source.getSample (0, i))
+                || ! exactlyEqual (output.getSample (1, i), source.getSample (0, i)))
+            {
+                expect (false, "Mismatch at sample " + String (i));
+                break;
+            }
+        }
+
+        synth.allNotesOff (0, false);
+        expectEquals (streamer.getNumActiveStreams(), 0);
+    }
+};
+
+static StreamingSamplerTests streamingSamplerTests;
+
+} // namespace juce
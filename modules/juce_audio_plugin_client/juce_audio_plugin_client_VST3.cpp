@@ -3633,6 +3633,7 @@ public:
         };
 
         const auto numParamsChanged = paramChanges.getParameterCount();
+        const auto wantsAutomation = pluginInstance->supportsSampleAccurateAutomation();
 
         for (Steinberg::int32 i = 0; i < numParamsChanged; ++i)
         {
@@ -3655,7 +3656,27 @@ public:
                 if (const auto change = getPointFromQueue (paramQueue, numPoints - 1))
                 {
                     if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
+                    {
+                        // The points have to be added before the parameter moves to its final value
+                        if (wantsAutomation && param->getParameterIndex() >= 0)
+                        {
+                            if (numPoints <= parameterAutomation.getNumFreePoints())
+                            {
+                                for (Steinberg::int32 point = 0; point < numPoints; ++point)
+                                {
+                                    if (const auto pointInfo = getPointFromQueue (paramQueue, point))
+                                        parameterAutomation.addPoint (*param, (int) pointInfo->offsetSamples, (float) pointInfo->value);
+                                }
+                            }
+                            else if (parameterAutomation.getNumFreePoints() > 0)
+                            {
+                                // There isn't room for all of the host's points, so ramp straight to the last one
+                                parameterAutomation.addPoint (*param, (int) change->offsetSamples, (float) change->value);
+                            }
+                        }
+
                         setValueAndNotifyIfChanged (*param, (float) change->value);
+                    }
                 }
             }
         }
@@ -3707,6 +3728,7 @@ public:
         }
 
         midiBuffer.clear();
+        parameterAutomation.clear();
 
         if (data.inputParameterChanges != nullptr)
             processParameterChanges (*data.inputParameterChanges);
@@ -3846,6 +3868,11 @@ private:
             }
             else
             {
+                if (! parameterAutomation.isEmpty())
+                    pluginInstance->setParameterAutomation (&parameterAutomation);
+
+                const ScopeGuard scope { [&] { pluginInstance->setParameterAutomation (nullptr); } };
+
                 // processBlockBypassed should only ever be called if the AudioProcessor doesn't
                 // return a valid parameter from getBypassParameter
                 if (pluginInstance->getBypassParameter() == nullptr && comPluginInstance->getBypassParameter()->getValue() >= 0.5f)
@@ -3902,6 +3929,13 @@ private:
         midiBuffer.ensureSize (2048);
         midiBuffer.clear();
 
+        // Hosts usually send a few points per parameter in each block, but they're allowed to
+        // send one for every sample. This leaves room for 16 points for every parameter, or for
+        // a point on every sample of four parameters, whichever is larger. If a block needs more
+        // than this, the parameters that don't fit only get a ramp to their last point.
+        const auto numParameters = p.getParameters().size();
+        parameterAutomation.prepare (numParameters, jmax (numParameters * 16, bufferSize * 4));
+
         bufferMapper.updateFromProcessor (p);
         bufferMapper.prepare (bufferSize);
     }
@@ -3975,6 +4009,7 @@ private:
     Vst::ProcessSetup processSetup;
 
     MidiBuffer midiBuffer;
+    ParameterAutomationBuffer parameterAutomation;
     ClientBufferMapper bufferMapper;
 
     bool active = false;
@@ -2866,6 +2866,11 @@ public:
         return (processor->canProcessSampleSize (Vst::kSample64) == kResultTrue);
     }
 
+    bool supportsSampleAccurateAutomation() const override
+    {
+        return true;
+    }
+
     //==============================================================================
     /*  Important: It is strongly recommended to use this function if you need to
         find the JUCE parameter corresponding to a particular IEditController
@@ -2969,9 +2974,40 @@ public:
         associateWith (data, buffer);
         associateWith (data, midiMessages);
 
+        const auto* automation = getParameterAutomation();
+
+        if (automation != nullptr)
+        {
+            for (auto& ramp : *automation)
+            {
+                auto& param = ramp.getParameter();
+                const auto index = param.getParameterIndex();
+
+                if (! isPositiveAndBelow (index, getParameters().size()) || getParameters().getUnchecked (index) != &param)
+                {
+                    // The automation must only refer to this plugin's own parameters!
+                    jassertfalse;
+                    continue;
+                }
+
+                const auto id = static_cast<VST3Parameter&> (param).getParamID();
+
+                for (auto& point : ramp)
+                    inputParameterChanges->set (id, point.value, (Steinberg::int32) point.sampleOffset);
+            }
+        }
+
         cachedParamValues.ifSet ([&] (Steinberg::int32 index, float value)
         {
-            inputParameterChanges->set (cachedParamValues.getParamID (index), value, 0);
+            const auto id = cachedParamValues.getParamID (index);
+
+            // Automated parameters have already had their whole ramp added to the queue
+            if (automation != nullptr)
+                if (auto* param = getParameterForID (id))
+                    if (automation->getRampFor (*param) != nullptr)
+                        return;
+
+            inputParameterChanges->set (id, value, 0);
         });
 
         processor->process (data);
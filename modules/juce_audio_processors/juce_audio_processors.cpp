@@ -200,6 +200,7 @@ private:
 
 } // namespace juce
 
+#include <juce_audio_basics/detail/juce_RealtimeRenderThreadPool.h>
 #include "utilities/juce_FlagCache.h"
 #include "format/juce_AudioPluginFormat.cpp"
 #include "format/juce_AudioPluginFormatManager.cpp"
@@ -220,6 +221,7 @@ private:
 #include "scanning/juce_PluginDirectoryScanner.cpp"
 #include "scanning/juce_PluginListComponent.cpp"
 #include "processors/juce_AudioProcessorParameterGroup.cpp"
+#include "processors/juce_ParameterAutomationBuffer.cpp"
 #include "utilities/juce_AudioProcessorParameterWithID.cpp"
 #include "utilities/juce_RangedAudioParameter.cpp"
 #include "utilities/juce_AudioParameterFloat.cpp"
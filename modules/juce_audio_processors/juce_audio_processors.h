@@ -146,6 +146,7 @@
 #include "format_types/juce_ARACommon.h"
 #include "utilities/juce_ExtensionsVisitor.h"
 #include "processors/juce_AudioProcessorParameter.h"
+#include "processors/juce_ParameterAutomationBuffer.h"
 #include "processors/juce_HostedAudioProcessorParameter.h"
 #include "processors/juce_AudioProcessorEditorHostContext.h"
 #include "processors/juce_AudioProcessorEditor.h"
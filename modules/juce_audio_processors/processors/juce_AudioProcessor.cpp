@@ -335,6 +335,14 @@ void AudioProcessor::setPlayHead (AudioPlayHead* newPlayHead)
     playHead = newPlayHead;
 }
 
+void AudioProcessor::setParameterAutomation (const ParameterAutomationBuffer* newAutomation) noexcept
+{
+    // This processor hasn't said that it can handle sample-accurate automation!
+    jassert (newAutomation == nullptr || supportsSampleAccurateAutomation());
+
+    parameterAutomation = newAutomation;
+}
+
 void AudioProcessor::addListener (AudioProcessorListener* newListener)
 {
     const ScopedLock sl (listenerLock);
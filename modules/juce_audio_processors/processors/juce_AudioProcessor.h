@@ -736,6 +736,40 @@ public:
     */
     AudioPlayHead* getPlayHead() const noexcept                 { return playHead; }
 
+    //==============================================================================
+    /** Returns true if the processor can follow sample-accurate parameter automation.
+
+        The default implementation returns false. If you override this to return true,
+        hosts and plugin wrappers that have automation with a finer resolution than a
+        whole block will make it available through getParameterAutomation() during
+        processBlock(), rather than splitting the block up or only delivering the final
+        value. The parameters themselves will still be set to their values at the end of
+        the block, so code that just reads the parameter values will carry on working.
+
+        @see getParameterAutomation, ParameterAutomationBuffer
+    */
+    virtual bool supportsSampleAccurateAutomation() const       { return false; }
+
+    /** Returns the automation that the host has supplied for the current block.
+
+        You can ONLY call this from your processBlock() method, and mustn't keep the pointer
+        beyond the current callback. If it returns nullptr, or it doesn't contain a ramp for a
+        particular parameter, then that parameter's current value applies to the whole block.
+
+        @see supportsSampleAccurateAutomation, setParameterAutomation
+    */
+    const ParameterAutomationBuffer* getParameterAutomation() const noexcept    { return parameterAutomation; }
+
+    /** Gives the processor the automation for the next block.
+
+        Hosts should call this on the audio thread before calling processBlock(), and call
+        it again with nullptr afterwards. The processor doesn't take ownership of the buffer.
+        This should only be used when supportsSampleAccurateAutomation() returns true.
+
+        @see getParameterAutomation
+    */
+    void setParameterAutomation (const ParameterAutomationBuffer* newAutomation) noexcept;
+
     //==============================================================================
     /** Returns the total number of input channels.
 
@@ -1576,6 +1610,7 @@ private:
     bool suspended = false;
     std::atomic<bool> nonRealtime { false };
     ProcessingPrecision processingPrecision = singlePrecision;
+    const ParameterAutomationBuffer* parameterAutomation = nullptr;
     CriticalSection callbackLock, listenerLock, activeEditorLock;
 
     friend class Bus;
@@ -563,8 +563,16 @@ struct GraphRenderSequence
                                     audioPlayHead,
                                     numSamples };
 
-            for (const auto& op : renderOps)
-                op->process (context);
+            if (threadPool != nullptr && parallelJob != nullptr)
+            {
+                parallelJob->start (context);
+                threadPool->perform (*parallelJob);
+            }
+            else
+            {
+                for (const auto& op : renderOps)
+                    op->process (context);
+            }
         }
 
         for (int i = 0; i < buffer.getNumChannels(); ++i)
@@ -596,7 +604,7 @@ struct GraphRenderSequence
             int index = 0;
         };
 
-        renderOps.push_back (std::make_unique<ClearOp> (index));
+        addRenderOp (std::make_unique<ClearOp> (index), {}, { Resource::audio (index) });
     }
 
     void addCopyChannelOp (int srcIndex, int dstIndex)
@@ -621,7 +629,7 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<CopyOp> (srcIndex, dstIndex));
+        addRenderOp (std::make_unique<CopyOp> (srcIndex, dstIndex), { Resource::audio (srcIndex) }, { Resource::audio (dstIndex) });
     }
 
     void addAddChannelOp (int srcIndex, int dstIndex)
@@ -646,7 +654,7 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
+        addRenderOp (std::make_unique<AddOp> (srcIndex, dstIndex), { Resource::audio (srcIndex) }, { Resource::audio (dstIndex) });
     }
 
     JUCE_END_IGNORE_WARNINGS_MSVC
@@ -671,7 +679,7 @@ struct GraphRenderSequence
             int index = 0;
         };
 
-        renderOps.push_back (std::make_unique<ClearOp> (index));
+        addRenderOp (std::make_unique<ClearOp> (index), {}, { Resource::midi (index) });
     }
 
     void addCopyMidiBufferOp (int srcIndex, int dstIndex)
@@ -696,7 +704,7 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<CopyOp> (srcIndex, dstIndex));
+        addRenderOp (std::make_unique<CopyOp> (srcIndex, dstIndex), { Resource::midi (srcIndex) }, { Resource::midi (dstIndex) });
     }
 
     void addAddMidiBufferOp (int srcIndex, int dstIndex)
@@ -721,7 +729,7 @@ struct GraphRenderSequence
             int from = 0, to = 0;
         };
 
-        renderOps.push_back (std::make_unique<AddOp> (srcIndex, dstIndex));
+        addRenderOp (std::make_unique<AddOp> (srcIndex, dstIndex), { Resource::midi (srcIndex) }, { Resource::midi (dstIndex) });
     }
 
     void addDelayChannelOp (int chan, int delaySize)
@@ -760,7 +768,7 @@ struct GraphRenderSequence
             int readIndex = 0, writeIndex;
         };
 
-        renderOps.push_back (std::make_unique<DelayChannelOp> (chan, delaySize));
+        addRenderOp (std::make_unique<DelayChannelOp> (chan, delaySize), {}, { Resource::audio (chan) });
     }
 
     void addProcessOp (const Node::Ptr& node,
@@ -791,7 +799,98 @@ struct GraphRenderSequence
             return std::make_unique<ProcessOp> (node, audioChannelsUsed, totalNumChans, midiBuffer);
         }();
 
-        renderOps.push_back (std::move (op));
+        // Nodes process their buffers in-place, so every buffer they use counts as a write
+        std::vector<Resource> writes { Resource::midi (midiBuffer) };
+
+        for (const auto& channel : audioChannelsUsed)
+            writes.push_back (Resource::audio (channel));
+
+        if (auto* ioNode = dynamic_cast<const AudioProcessorGraph::AudioGraphIOProcessor*> (node->getProcessor()))
+        {
+            if (ioNode->getType() == AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode)
+                writes.push_back (Resource::globalAudioOut());
+            else if (ioNode->getType() == AudioProcessorGraph::AudioGraphIOProcessor::midiOutputNode)
+                writes.push_back (Resource::globalMidiOut());
+        }
+
+        addRenderOp (std::move (op), {}, std::move (writes));
+    }
+
+    /*  Works out which ops must complete before each op may start, so that the ops can be
+        run in parallel while producing the same result as running them in order.
+    */
+    void createDependencyGraph()
+    {
+        const auto numOps = renderOps.size();
+
+        std::vector<std::vector<size_t>> dependents (numOps);
+        std::vector<int> numDependencies (numOps, 0);
+
+        struct ResourceState
+        {
+            std::optional<size_t> lastWriter;
+            std::vector<size_t> readersSinceLastWrite;
+        };
+
+        std::map<Resource, ResourceState> states;
+        std::vector<size_t> opDependencies;
+
+        for (size_t op = 0; op < numOps; ++op)
+        {
+            opDependencies.clear();
+            const auto& access = resourceAccesses[op];
+
+            for (const auto& resource : access.reads)
+            {
+                auto& state = states[resource];
+
+                if (state.lastWriter.has_value())
+                    opDependencies.push_back (*state.lastWriter);
+
+                state.readersSinceLastWrite.push_back (op);
+            }
+
+            for (const auto& resource : access.writes)
+            {
+                auto& state = states[resource];
+
+                if (state.lastWriter.has_value())
+                    opDependencies.push_back (*state.lastWriter);
+
+                for (const auto& reader : state.readersSinceLastWrite)
+                    if (reader != op)
+                        opDependencies.push_back (reader);
+
+                state.lastWriter = op;
+                state.readersSinceLastWrite.clear();
+            }
+
+            std::sort (opDependencies.begin(), opDependencies.end());
+            opDependencies.erase (std::unique (opDependencies.begin(), opDependencies.end()), opDependencies.end());
+
+            for (const auto& dependency : opDependencies)
+                dependents[dependency].push_back (op);
+
+            numDependencies[op] = (int) opDependencies.size();
+        }
+
+        // If the longest chain of dependencies visits every op, there's nothing to gain from
+        // running in parallel
+        std::vector<size_t> chainLength (numOps, 1);
+        size_t longestChain = 0;
+
+        for (size_t op = 0; op < numOps; ++op)
+        {
+            for (const auto& dependent : dependents[op])
+                chainLength[dependent] = jmax (chainLength[dependent], chainLength[op] + 1);
+
+            longestChain = jmax (longestChain, chainLength[op]);
+        }
+
+        if (longestChain < numOps)
+            parallelJob = std::make_unique<ParallelRenderJob> (renderOps, std::move (dependents), std::move (numDependencies));
+        else
+            parallelJob.reset();
     }
 
     void prepareBuffers (int blockSize)
@@ -826,6 +925,10 @@ struct GraphRenderSequence
     Array<MidiBuffer> midiBuffers;
     MidiBuffer midiChunk;
 
+    // If this is set, and the sequence has called createDependencyGraph(), independent ops
+    // will be spread across the threads of this pool
+    detail::RealtimeRenderThreadPool* threadPool = nullptr;
+
 private:
     //==============================================================================
     struct RenderOp
@@ -835,6 +938,137 @@ private:
         virtual void process (const Context&) = 0;
     };
 
+    //==============================================================================
+    /*  Something that a render op reads or writes. */
+    struct Resource
+    {
+        enum class Kind { audioChannel, midiBuffer, globalAudioOut, globalMidiOut };
+
+        static Resource audio (int index)   { return { Kind::audioChannel, index }; }
+        static Resource midi (int index)    { return { Kind::midiBuffer, index }; }
+        static Resource globalAudioOut()    { return { Kind::globalAudioOut, 0 }; }
+        static Resource globalMidiOut()     { return { Kind::globalMidiOut, 0 }; }
+
+        // The first audio and MIDI buffers are shared read-only silence, so they never
+        // introduce a dependency between ops
+        bool isReadOnlyEmpty() const { return (kind == Kind::audioChannel || kind == Kind::midiBuffer) && index == 0; }
+
+        bool operator< (const Resource& other) const { return std::tie (kind, index) < std::tie (other.kind, other.index); }
+
+        Kind kind;
+        int index;
+    };
+
+    struct ResourceAccess
+    {
+        std::vector<Resource> reads, writes;
+    };
+
+    void addRenderOp (std::unique_ptr<RenderOp> op, std::vector<Resource> reads, std::vector<Resource> writes)
+    {
+        const auto removeReadOnlyEmpty = [] (std::vector<Resource>& resources)
+        {
+            resources.erase (std::remove_if (resources.begin(), resources.end(), [] (const auto& r) { return r.isReadOnlyEmpty(); }),
+                             resources.end());
+        };
+
+        removeReadOnlyEmpty (reads);
+        removeReadOnlyEmpty (writes);
+
+        renderOps.push_back (std::move (op));
+        resourceAccesses.push_back ({ std::move (reads), std::move (writes) });
+    }
+
+    //==============================================================================
+    /*  Runs the render ops of a sequence, starting each op as soon as all the ops that it
+        depends on have finished.
+
+        Ops that are ready to run are appended to a fixed-size queue. Every op is queued exactly
+        once per block, so the queue never needs to wrap around or grow.
+    */
+    class ParallelRenderJob final : public detail::RealtimeRenderJob
+    {
+    public:
+        ParallelRenderJob (const std::vector<std::unique_ptr<RenderOp>>& opsIn,
+                           std::vector<std::vector<size_t>> dependentsIn,
+                           std::vector<int> numDependenciesIn)
+            : ops (opsIn),
+              dependents (std::move (dependentsIn)),
+              numDependencies (std::move (numDependenciesIn)),
+              pendingDependencies (ops.size()),
+              readyOps (ops.size())
+        {
+        }
+
+        /*  Resets the job so that it's ready to render a new block. Call from the audio thread,
+            before handing the job to the thread pool.
+        */
+        void start (const Context& c)
+        {
+            context = &c;
+            readPosition.store (0);
+            writePosition.store (0);
+            numOpsCompleted.store (0);
+
+            for (auto& op : readyOps)
+                op.store (-1, std::memory_order_relaxed);
+
+            for (size_t i = 0; i < ops.size(); ++i)
+            {
+                pendingDependencies[i].store (numDependencies[i], std::memory_order_relaxed);
+
+                if (numDependencies[i] == 0)
+                    pushReadyOp (i);
+            }
+        }
+
+        bool runNextTask() override
+        {
+            auto position = readPosition.load();
+
+            if (position >= (int) readyOps.size())
+                return false;
+
+            const auto opIndex = readyOps[(size_t) position].load (std::memory_order_acquire);
+
+            if (opIndex < 0)
+                return false;
+
+            // Another thread claimed this op first, but there may be more work to do
+            if (! readPosition.compare_exchange_strong (position, position + 1))
+                return true;
+
+            ops[(size_t) opIndex]->process (*context);
+
+            for (const auto& dependent : dependents[(size_t) opIndex])
+                if (pendingDependencies[dependent].fetch_sub (1, std::memory_order_acq_rel) == 1)
+                    pushReadyOp (dependent);
+
+            numOpsCompleted.fetch_add (1, std::memory_order_release);
+            return true;
+        }
+
+        bool isFinished() const override
+        {
+            return numOpsCompleted.load (std::memory_order_acquire) == (int) ops.size();
+        }
+
+    private:
+        void pushReadyOp (size_t opIndex)
+        {
+            const auto position = writePosition.fetch_add (1);
+            readyOps[(size_t) position].store ((int) opIndex, std::memory_order_release);
+        }
+
+        const std::vector<std::unique_ptr<RenderOp>>& ops;
+        const std::vector<std::vector<size_t>> dependents;
+        const std::vector<int> numDependencies;
+
+        std::vector<std::atomic<int>> pendingDependencies, readyOps;
+        std::atomic<int> readPosition { 0 }, writePosition { 0 }, numOpsCompleted { 0 };
+        const Context* context = nullptr;
+    };
+
     struct NodeOp : public RenderOp
     {
         NodeOp (const Node::Ptr& n,
@@ -996,6 +1230,8 @@ private:
     };
 
     std::vector<std::unique_ptr<RenderOp>> renderOps;
+    std::vector<ResourceAccess> resourceAccesses;
+    std::unique_ptr<ParallelRenderJob> parallelJob;
 };
 
 //==============================================================================
@@ -1019,11 +1255,16 @@ public:
 
     static constexpr auto midiChannelIndex = AudioProcessorGraph::midiChannelIndex;
 
+    /*  When rendering in parallel, buffers shouldn't be recycled between nodes, because that
+        would force nodes that share a buffer to run one after another.
+    */
+    enum class BufferReuse { enabled, disabled };
+
     template <typename FloatType>
-    static SequenceAndLatency build (const Nodes& n, const Connections& c)
+    static SequenceAndLatency build (const Nodes& n, const Connections& c, BufferReuse reuse)
     {
         GraphRenderSequence<FloatType> sequence;
-        const RenderSequenceBuilder builder (n, c, sequence);
+        const RenderSequenceBuilder builder (n, c, sequence, reuse);
         return { std::move (sequence), builder.totalLatency };
     }
 
@@ -1489,7 +1730,7 @@ private:
     }
 
     template <typename RenderSequence>
-    RenderSequenceBuilder (const Nodes& n, const Connections& c, RenderSequence& sequence)
+    RenderSequenceBuilder (const Nodes& n, const Connections& c, RenderSequence& sequence, BufferReuse reuse)
         : orderedNodes (createOrderedNodeList (n, c))
     {
         audioBuffers.add (AssignedBuffer::createReadOnlyEmpty()); // first buffer is read-only zeros
@@ -1500,8 +1741,12 @@ private:
         for (int i = 0; i < orderedNodes.size(); ++i)
         {
             createRenderingOpsForNode (c, reversed, sequence, *orderedNodes.getUnchecked (i), i);
-            markAnyUnusedBuffersAsFree (reversed, audioBuffers, i);
-            markAnyUnusedBuffersAsFree (reversed, midiBuffers, i);
+
+            if (reuse == BufferReuse::enabled)
+            {
+                markAnyUnusedBuffersAsFree (reversed, audioBuffers, i);
+                markAnyUnusedBuffersAsFree (reversed, midiBuffers, i);
+            }
         }
 
         sequence.numBuffersNeeded = audioBuffers.size();
@@ -1521,10 +1766,15 @@ class RenderSequence
 public:
     using AudioGraphIOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
 
-    RenderSequence (const PrepareSettings s, const Nodes& n, const Connections& c)
-        : RenderSequence (s, s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
-                                ? RenderSequenceBuilder::build<float>  (n, c)
-                                : RenderSequenceBuilder::build<double> (n, c))
+    RenderSequence (const PrepareSettings s,
+                    const Nodes& n,
+                    const Connections& c,
+                    const std::shared_ptr<detail::RealtimeRenderThreadPool>& pool)
+        : RenderSequence (s,
+                          s.precision == AudioProcessor::ProcessingPrecision::singlePrecision
+                              ? RenderSequenceBuilder::build<float>  (n, c, getBufferReuse (pool))
+                              : RenderSequenceBuilder::build<double> (n, c, getBufferReuse (pool)),
+                          pool)
     {
     }
 
@@ -1549,14 +1799,33 @@ private:
         jassertfalse;
     }
 
-    RenderSequence (const PrepareSettings s, SequenceAndLatency&& built)
-        : settings (s), sequence (std::move (built))
+    RenderSequence (const PrepareSettings s, SequenceAndLatency&& built, std::shared_ptr<detail::RealtimeRenderThreadPool> pool)
+        : settings (s), sequence (std::move (built)), threadPool (std::move (pool))
+    {
+        visitRenderSequence (*this, [&] (auto& seq)
+        {
+            seq.prepareBuffers (settings.blockSize);
+
+            if (threadPool != nullptr)
+            {
+                seq.createDependencyGraph();
+                seq.threadPool = threadPool.get();
+            }
+        });
+    }
+
+    static RenderSequenceBuilder::BufferReuse getBufferReuse (const std::shared_ptr<detail::RealtimeRenderThreadPool>& pool)
     {
-        visitRenderSequence (*this, [&] (auto& seq) { seq.prepareBuffers (settings.blockSize); });
+        return pool != nullptr ? RenderSequenceBuilder::BufferReuse::disabled
+                               : RenderSequenceBuilder::BufferReuse::enabled;
     }
 
     PrepareSettings settings;
     SequenceAndLatency sequence;
+
+    // Shared with the graph, so that the pool outlives any sequence that might still be in use
+    // on the audio thread
+    std::shared_ptr<detail::RealtimeRenderThreadPool> threadPool;
 };
 
 //==============================================================================
@@ -1585,11 +1854,11 @@ public:
 */
 class RenderSequenceSignature
 {
-    auto tie() const { return std::tie (settings, connections, nodes); }
+    auto tie() const { return std::tie (settings, connections, nodes, numRenderThreads); }
 
 public:
-    RenderSequenceSignature (const PrepareSettings s, const Nodes& n, const Connections& c)
-        : settings (s), connections (c), nodes (getNodeMap (n)) {}
+    RenderSequenceSignature (const PrepareSettings s, const Nodes& n, const Connections& c, int numThreads)
+        : settings (s), connections (c), nodes (getNodeMap (n)), numRenderThreads (numThreads) {}
 
     bool operator== (const RenderSequenceSignature& other) const { return tie() == other.tie(); }
     bool operator!= (const RenderSequenceSignature& other) const { return tie() != other.tie(); }
@@ -1616,6 +1885,7 @@ private:
     PrepareSettings settings;
     Connections connections;
     NodeMap nodes;
+    int numRenderThreads = 0;
 };
 
 //==============================================================================
@@ -1877,6 +2147,24 @@ public:
             n->getProcessor()->setNonRealtime (isProcessingNonRealtime);
     }
 
+    void setNumRenderThreads (int numThreads, UpdateKind updateKind)
+    {
+        numThreads = jmax (0, numThreads);
+
+        if (std::exchange (numRenderThreads, numThreads) != numThreads)
+            rebuild (updateKind);
+    }
+
+    int getNumRenderThreads() const noexcept { return numRenderThreads; }
+
+    void setWorkgroup (const AudioWorkgroup& newWorkgroup)
+    {
+        workgroup = newWorkgroup;
+
+        if (renderThreadPool != nullptr)
+            renderThreadPool->setWorkgroup (workgroup);
+    }
+
     template <typename Value>
     void processBlock (AudioBuffer<Value>& audio, MidiBuffer& midi, AudioPlayHead* playHead)
     {
@@ -1931,11 +2219,11 @@ private:
             for (const auto node : nodes.getNodes())
                 setParentGraph (node->getProcessor());
 
-            const RenderSequenceSignature newSignature (*newSettings, nodes, connections);
+            const RenderSequenceSignature newSignature (*newSettings, nodes, connections, numRenderThreads);
 
             if (std::exchange (lastBuiltSequence, newSignature) != newSignature)
             {
-                auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections);
+                auto sequence = std::make_unique<RenderSequence> (*newSettings, nodes, connections, getThreadPool (*newSettings));
                 owner->setLatencySamples (sequence->getLatencySamples());
                 renderSequenceExchange.set (std::move (sequence));
             }
@@ -1943,10 +2231,31 @@ private:
         else
         {
             lastBuiltSequence.reset();
+            renderThreadPool.reset();
             renderSequenceExchange.set (nullptr);
         }
     }
 
+    std::shared_ptr<detail::RealtimeRenderThreadPool> getThreadPool (const PrepareSettings& settings)
+    {
+        if (numRenderThreads == 0)
+        {
+            renderThreadPool.reset();
+            return nullptr;
+        }
+
+        if (renderThreadPool == nullptr
+            || renderThreadPool->getNumThreads() != numRenderThreads
+            || renderThreadPoolSettings != settings)
+        {
+            renderThreadPool = std::make_shared<detail::RealtimeRenderThreadPool> (numRenderThreads, settings.blockSize, settings.sampleRate);
+            renderThreadPoolSettings = settings;
+            renderThreadPool->setWorkgroup (workgroup);
+        }
+
+        return renderThreadPool;
+    }
+
     AudioProcessorGraph* owner = nullptr;
     Nodes nodes;
     Connections connections;
@@ -1954,6 +2263,10 @@ private:
     RenderSequenceExchange renderSequenceExchange;
     NodeID lastNodeID;
     std::optional<RenderSequenceSignature> lastBuiltSequence;
+    int numRenderThreads = 0;
+    std::shared_ptr<detail::RealtimeRenderThreadPool> renderThreadPool;
+    PrepareSettings renderThreadPoolSettings;
+    AudioWorkgroup workgroup;
     LockingAsyncUpdater updater { [this] { handleAsyncUpdate(); } };
 };
 
@@ -1983,6 +2296,9 @@ void AudioProcessorGraph::releaseResources()
 bool AudioProcessorGraph::removeIllegalConnections (UpdateKind updateKind)                                  { return pimpl->removeIllegalConnections (updateKind); }
 void AudioProcessorGraph::rebuild()                                                                         { return pimpl->rebuild (UpdateKind::sync); }
 void AudioProcessorGraph::reset()                                                                           { return pimpl->reset(); }
+void AudioProcessorGraph::setNumRenderThreads (int numThreads, UpdateKind updateKind)                       { return pimpl->setNumRenderThreads (numThreads, updateKind); }
+int AudioProcessorGraph::getNumRenderThreads() const noexcept                                               { return pimpl->getNumRenderThreads(); }
+void AudioProcessorGraph::audioWorkgroupContextChanged (const AudioWorkgroup& workgroup)                    { return pimpl->setWorkgroup (workgroup); }
 bool AudioProcessorGraph::canConnect (const Connection& c) const                                            { return pimpl->canConnect (c); }
 bool AudioProcessorGraph::isConnected (const Connection& c) const noexcept                                  { return pimpl->isConnected (c); }
 bool AudioProcessorGraph::isConnected (NodeID a, NodeID b) const noexcept                                   { return pimpl->isConnected (a, b); }
@@ -2303,6 +2619,73 @@ public:
             // this graph, so we just want to make sure that we finish the test without timing out.
             logMessage ("render sequence built in " + String (duration) + " ms");
         }
+
+        beginTest ("rendering with worker threads produces the same output as rendering in sequence");
+        {
+            const auto render = [] (int numRenderThreads)
+            {
+                constexpr auto numBranches = 8;
+                constexpr auto numNodesPerBranch = 3;
+                constexpr auto blockSize = 64;
+
+                AudioProcessorGraph graph;
+                graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+                graph.setNumRenderThreads (numRenderThreads);
+
+                const auto input  = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioInputNode))->nodeID;
+                const auto output = graph.addNode (std::make_unique<AudioProcessorGraph::AudioGraphIOProcessor> (AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode))->nodeID;
+
+                for (auto branch = 0; branch < numBranches; ++branch)
+                {
+                    auto previous = input;
+
+                    for (auto i = 0; i < numNodesPerBranch; ++i)
+                    {
+                        const auto gain = 0.5f + 0.1f * (float) i;
+                        const auto offset = 0.01f * (float) (branch * numNodesPerBranch + i);
+                        const auto node = graph.addNode (std::make_unique<ScaleProcessor> (gain, offset))->nodeID;
+
+                        for (auto channel = 0; channel < 2; ++channel)
+                            graph.addConnection ({ { previous, channel }, { node, channel } });
+
+                        previous = node;
+                    }
+
+                    for (auto channel = 0; channel < 2; ++channel)
+                        graph.addConnection ({ { previous, channel }, { output, channel } });
+                }
+
+                graph.prepareToPlay (44100.0, blockSize);
+
+                AudioBuffer<float> result (2, blockSize * 4);
+                MidiBuffer midi;
+                Random random (1);
+
+                for (auto start = 0; start < result.getNumSamples(); start += blockSize)
+                {
+                    AudioBuffer<float> block (result.getArrayOfWritePointers(), 2, start, blockSize);
+
+                    for (auto channel = 0; channel < 2; ++channel)
+                        for (auto i = 0; i < blockSize; ++i)
+                            block.setSample (channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+                    graph.processBlock (block, midi);
+                }
+
+                return result;
+            };
+
+            const auto expected = render (0);
+
+            for (const auto numThreads : { 1, 3 })
+            {
+                const auto actual = render (numThreads);
+
+                for (auto channel = 0; channel < expected.getNumChannels(); ++channel)
+                    for (auto i = 0; i < expected.getNumSamples(); ++i)
+                        expectWithinAbsoluteError (actual.getSample (channel, i), expected.getSample (channel, i), 1.0e-5f);
+            }
+        }
     }
 
 private:
@@ -2366,6 +2749,45 @@ private:
         MidiIn midiIn;
         MidiOut midiOut;
     };
+
+    class ScaleProcessor final : public AudioProcessor
+    {
+    public:
+        ScaleProcessor (float gainIn, float offsetIn)
+            : AudioProcessor (BasicProcessor::getStereoProperties()), gain (gainIn), offset (offsetIn) {}
+
+        const String getName() const override                         { return "Scale Processor"; }
+        double getTailLengthSeconds() const override                  { return {}; }
+        bool acceptsMidi() const override                             { return false; }
+        bool producesMidi() const override                            { return false; }
+        AudioProcessorEditor* createEditor() override                 { return {}; }
+        bool hasEditor() const override                               { return {}; }
+        int getNumPrograms() override                                 { return 1; }
+        int getCurrentProgram() override                              { return {}; }
+        void setCurrentProgram (int) override                         {}
+        const String getProgramName (int) override                    { return {}; }
+        void changeProgramName (int, const String&) override          {}
+        void getStateInformation (juce::MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override          {}
+        void prepareToPlay (double, int) override                     {}
+        void releaseResources() override                              {}
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            for (auto channel = 0; channel < buffer.getNumChannels(); ++channel)
+            {
+                auto* data = buffer.getWritePointer (channel);
+
+                for (auto i = 0; i < buffer.getNumSamples(); ++i)
+                    data[i] = data[i] * gain + offset;
+            }
+        }
+
+        using AudioProcessor::processBlock;
+
+    private:
+        float gain, offset;
+    };
 };
 
 static AudioProcessorGraphTests audioProcessorGraphTests;
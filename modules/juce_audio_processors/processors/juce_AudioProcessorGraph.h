@@ -332,6 +332,34 @@ public:
     */
     void rebuild();
 
+    //==============================================================================
+    /** Sets the number of worker threads that the graph may use to render nodes in parallel.
+
+        By default this is 0, and every node in the graph is rendered in sequence on the thread
+        that calls processBlock().
+
+        If you pass a number greater than 0, the graph will start that many real-time worker
+        threads. Nodes that don't depend on one another's output may then be processed at the
+        same time on these workers and on the thread that calls processBlock(), which will wait
+        until all nodes have been rendered before returning. Only enable this mode if all of the
+        processors in the graph are safe to call from threads other than the audio thread.
+
+        Graphs that can't benefit from parallel rendering (for example, a simple chain of
+        processors) are always rendered in sequence on the calling thread, in the same order that
+        would be used if no worker threads had been requested.
+
+        If the graph receives an AudioWorkgroup via audioWorkgroupContextChanged(), the worker
+        threads will join that workgroup.
+
+        This function should only be called from the message thread.
+
+        @see getNumRenderThreads
+    */
+    void setNumRenderThreads (int numWorkerThreads, UpdateKind = UpdateKind::sync);
+
+    /** Returns the number of worker threads requested with setNumRenderThreads(). */
+    int getNumRenderThreads() const noexcept;
+
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
         in order to use the audio that comes into and out of the graph itself.
@@ -428,6 +456,7 @@ public:
 
     void reset() override;
     void setNonRealtime (bool) noexcept override;
+    void audioWorkgroupContextChanged (const AudioWorkgroup&) override;
 
     double getTailLengthSeconds() const override;
     bool acceptsMidi() const override;
@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+float ParameterAutomationBuffer::Ramp::getEndValue() const noexcept
+{
+    return numPoints > 0 ? (*this)[numPoints - 1].value : startValue;
+}
+
+const ParameterAutomationBuffer::Point& ParameterAutomationBuffer::Ramp::operator[] (int index) const noexcept
+{
+    jassert (isPositiveAndBelow (index, numPoints));
+    return owner->points[(size_t) (firstPoint + index)];
+}
+
+const ParameterAutomationBuffer::Point* ParameterAutomationBuffer::Ramp::begin() const noexcept
+{
+    return owner->points.data() + firstPoint;
+}
+
+const ParameterAutomationBuffer::Point* ParameterAutomationBuffer::Ramp::end() const noexcept
+{
+    return begin() + numPoints;
+}
+
+float ParameterAutomationBuffer::Ramp::getValueAt (int sampleOffset) const noexcept
+{
+    sampleOffset = jmax (0, sampleOffset);
+    Point previous { 0, startValue };
+
+    for (auto& point : *this)
+    {
+        if (sampleOffset < point.sampleOffset)
+        {
+            auto step = (point.value - previous.value) / (float) (point.sampleOffset - previous.sampleOffset);
+            return previous.value + step * (float) (sampleOffset - previous.sampleOffset);
+        }
+
+        previous = point;
+    }
+
+    return previous.value;
+}
+
+void ParameterAutomationBuffer::Ramp::getValues (float* destination, int numSamples) const noexcept
+{
+    Point previous { 0, startValue };
+    int position = 0;
+
+    for (auto& point : *this)
+    {
+        if (position >= numSamples)
+            return;
+
+        auto segmentEnd = jmin (point.sampleOffset, numSamples);
+
+        if (position < segmentEnd)
+        {
+            auto step = (point.value - previous.value) / (float) (point.sampleOffset - previous.sampleOffset);
+
+            for (; position < segmentEnd; ++position)
+                destination[position] = previous.value + step * (float) (position - previous.sampleOffset);
+        }
+
+        previous = point;
+    }
+
+    if (position < numSamples)
+        FloatVectorOperations::fill (destination + position, previous.value, numSamples - position);
+}
+
+//==============================================================================
+void ParameterAutomationBuffer::prepare (int numParameters, int maxNumPoints)
+{
+    clear();
+
+    addedPoints.reserve ((size_t) maxNumPoints);
+    points.reserve ((size_t) maxNumPoints);
+    ramps.reserve ((size_t) numParameters);
+    rampIndexForParameter.assign ((size_t) numParameters, -1);
+}
+
+void ParameterAutomationBuffer::clear() noexcept
+{
+    for (auto& ramp : ramps)
+        rampIndexForParameter[(size_t) ramp.parameter->getParameterIndex()] = -1;
+
+    ramps.clear();
+    points.clear();
+    addedPoints.clear();
+    pointsAreGrouped = true;
+}
+
+void ParameterAutomationBuffer::addPoint (AudioProcessorParameter& parameter, int sampleOffset, float normalisedValue) noexcept
+{
+    const auto parameterIndex = parameter.getParameterIndex();
+
+    // The parameter must belong to an AudioProcessor!
+    jassert (parameterIndex >= 0);
+
+    if (getNumFreePoints() <= 0 || ! isPositiveAndBelow (parameterIndex, rampIndexForParameter.size()))
+    {
+        // There isn't room for this point. Make sure you call prepare() with enough space!
+        jassertfalse;
+        return;
+    }
+
+    auto& rampIndex = rampIndexForParameter[(size_t) parameterIndex];
+
+    if (rampIndex < 0)
+    {
+        rampIndex = (int) ramps.size();
+        ramps.push_back (Ramp (*this, parameter, parameter.getValue()));
+    }
+
+    auto& ramp = ramps[(size_t) rampIndex];
+
+    // The points for each parameter must be added in order!
+    jassert (ramp.numPoints == 0 || ramp.lastSampleOffset <= sampleOffset);
+
+    addedPoints.push_back ({ rampIndex, { sampleOffset, normalisedValue } });
+    ramp.lastSampleOffset = sampleOffset;
+    ++ramp.numPoints;
+    pointsAreGrouped = false;
+}
+
+int ParameterAutomationBuffer::getNumFreePoints() const noexcept
+{
+    return (int) (jmin (addedPoints.capacity(), points.capacity()) - addedPoints.size());
+}
+
+void ParameterAutomationBuffer::groupPoints() const noexcept
+{
+    if (pointsAreGrouped)
+        return;
+
+    // A counting sort by parameter, which keeps each parameter's points in the order they were added
+    auto nextPoint = 0;
+
+    for (auto& ramp : ramps)
+    {
+        ramp.firstPoint = nextPoint;
+        nextPoint += ramp.numPoints;
+        ramp.numPoints = 0;
+    }
+
+    points.resize (addedPoints.size());
+
+    for (auto& added : addedPoints)
+    {
+        auto& ramp = ramps[(size_t) added.rampIndex];
+        points[(size_t) (ramp.firstPoint + ramp.numPoints++)] = added.point;
+    }
+
+    pointsAreGrouped = true;
+}
+
+const ParameterAutomationBuffer::Ramp* ParameterAutomationBuffer::getRampFor (const AudioProcessorParameter& parameter) const noexcept
+{
+    groupPoints();
+
+    const auto parameterIndex = parameter.getParameterIndex();
+
+    if (! isPositiveAndBelow (parameterIndex, rampIndexForParameter.size()))
+        return nullptr;
+
+    const auto rampIndex = rampIndexForParameter[(size_t) parameterIndex];
+    return rampIndex >= 0 ? &ramps[(size_t) rampIndex] : nullptr;
+}
+
+} // namespace juce
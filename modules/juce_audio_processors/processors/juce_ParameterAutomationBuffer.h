@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds sample-accurate automation for the parameters of an AudioProcessor,
+    covering a single processing block.
+
+    Each automated parameter has a Ramp, which is a list of points, sorted by
+    sample offset. Between points the parameter's normalised value moves in a
+    straight line, starting from the value it had at the beginning of the block,
+    and it stays at the value of the final point until the end of the block.
+    This is the same model that VST3's IParamValueQueue uses.
+
+    Hosts fill one of these in before each block, set the parameters to their
+    final values, and pass it to AudioProcessor::setParameterAutomation() before
+    calling processBlock(). Processors that return true from
+    AudioProcessor::supportsSampleAccurateAutomation() can then retrieve it
+    with AudioProcessor::getParameterAutomation() and follow the ramps, rather
+    than only seeing the values that the parameters have at the end of the block.
+
+    For example, to drive a SmoothedValue along a ramp:
+    @code
+    int position = 0;
+
+    if (auto* ramp = automation->getRampFor (*gainParameter))
+    {
+        for (auto& point : *ramp)
+        {
+            gain.setTargetValue (gainParameter->convertFrom0to1 (point.value),
+                                 point.sampleOffset - position);
+            renderSamples (position, point.sampleOffset);
+            position = point.sampleOffset;
+        }
+    }
+
+    renderSamples (position, numSamples);
+    @endcode
+
+    @see AudioProcessor::getParameterAutomation, AudioProcessorValueTreeState::getParameterValues
+
+    @tags{Audio}
+*/
+class JUCE_API  ParameterAutomationBuffer
+{
+public:
+    //==============================================================================
+    /** A single automation point. */
+    struct Point
+    {
+        /** The position of this point within the block. */
+        int sampleOffset = 0;
+
+        /** The parameter's normalised value, in the range 0 to 1. */
+        float value = 0.0f;
+    };
+
+    //==============================================================================
+    /**
+        The automation for one parameter during the current block.
+
+        @tags{Audio}
+    */
+    class JUCE_API  Ramp
+    {
+    public:
+        /** Returns the parameter that this ramp applies to. */
+        AudioProcessorParameter& getParameter() const noexcept      { return *parameter; }
+
+        /** Returns the normalised value of the parameter at the start of the block. */
+        float getStartValue() const noexcept                        { return startValue; }
+
+        /** Returns the normalised value of the parameter at the end of the block. */
+        float getEndValue() const noexcept;
+
+        /** Returns the number of points in this ramp. */
+        int size() const noexcept                                   { return numPoints; }
+
+        /** Returns one of the points in this ramp. */
+        const Point& operator[] (int index) const noexcept;
+
+        /** Iterates the points, which are sorted by sample offset. */
+        const Point* begin() const noexcept;
+
+        /** Iterates the points, which are sorted by sample offset. */
+        const Point* end() const noexcept;
+
+        /** Returns the normalised value of the parameter at a given position in the block. */
+        float getValueAt (int sampleOffset) const noexcept;
+
+        /** Fills an array with the normalised value of the parameter at each of the
+            first numSamples samples of the block.
+        */
+        void getValues (float* destination, int numSamples) const noexcept;
+
+    private:
+        friend class ParameterAutomationBuffer;
+
+        Ramp (const ParameterAutomationBuffer& ownerIn, AudioProcessorParameter& param, float start) noexcept
+            : owner (&ownerIn), parameter (&param), startValue (start) {}
+
+        const ParameterAutomationBuffer* owner;
+        AudioProcessorParameter* parameter;
+        float startValue;
+        int firstPoint = 0, numPoints = 0, lastSampleOffset = 0;
+    };
+
+    //==============================================================================
+    /** Creates an empty buffer. */
+    ParameterAutomationBuffer() = default;
+
+    /** Allocates space for the given number of parameters and points.
+
+        This must be called before adding any points. Filling the buffer never
+        allocates, so it's safe to do on the audio thread.
+
+        @param numParameters        the number of parameters in the processor
+        @param maxNumPoints         the largest total number of points (across all
+                                    parameters) that can be added in one block
+    */
+    void prepare (int numParameters, int maxNumPoints);
+
+    /** Removes all the ramps, ready for the next block. */
+    void clear() noexcept;
+
+    /** Adds a point to a parameter's ramp.
+
+        The first time a point is added for a parameter in a block, the parameter's
+        current value is taken as the value at the start of the ramp, so you should add
+        the points before updating the parameter itself. Points for each parameter must
+        be added in sample-offset order, but points for different parameters can be
+        interleaved.
+
+        If the buffer is already holding as many points as were passed to prepare(), or
+        the parameter's index is beyond the number of parameters passed to prepare(), the
+        point is dropped. If the points come from somewhere you don't control, such as a
+        host, use getNumFreePoints() to check that there's room for them first.
+
+        Add all of the points for a block before reading any of the ramps.
+    */
+    void addPoint (AudioProcessorParameter& parameter, int sampleOffset, float normalisedValue) noexcept;
+
+    //==============================================================================
+    /** Returns true if there's no automation in the buffer. */
+    bool isEmpty() const noexcept                                   { return ramps.empty(); }
+
+    /** Returns the number of points that can still be added in this block. */
+    int getNumFreePoints() const noexcept;
+
+    /** Returns the number of parameters that are automated in this block. */
+    int getNumRamps() const noexcept                                { return (int) ramps.size(); }
+
+    /** Returns the ramp for a parameter, or nullptr if it isn't automated in this block. */
+    const Ramp* getRampFor (const AudioProcessorParameter& parameter) const noexcept;
+
+    /** Iterates the ramps. */
+    auto begin() const noexcept                                     { groupPoints(); return ramps.cbegin(); }
+
+    /** Iterates the ramps. */
+    auto end() const noexcept                                       { groupPoints(); return ramps.cend(); }
+
+private:
+    //==============================================================================
+    struct AddedPoint
+    {
+        int rampIndex;
+        Point point;
+    };
+
+    // Points are appended to addedPoints as they arrive, and then copied into points,
+    // grouped by parameter, the first time that the ramps are read
+    std::vector<AddedPoint> addedPoints;
+    mutable std::vector<Point> points;
+    mutable std::vector<Ramp> ramps;
+    mutable bool pointsAreGrouped = true;
+    std::vector<int> rampIndexForParameter;
+
+    void groupPoints() const noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterAutomationBuffer)
+};
+
+} // namespace juce
@@ -386,6 +386,34 @@ std::atomic<float>* AudioProcessorValueTreeState::getRawParameterValue (StringRe
     return nullptr;
 }
 
+void AudioProcessorValueTreeState::getParameterValues (StringRef paramID, float* destination, int numSamples) const noexcept
+{
+    auto* adapter = getParameterAdapter (paramID);
+
+    if (adapter == nullptr)
+    {
+        jassertfalse;
+        return;
+    }
+
+    auto& param = adapter->getParameter();
+
+    if (auto* automation = processor.getParameterAutomation())
+    {
+        if (auto* ramp = automation->getRampFor (param))
+        {
+            ramp->getValues (destination, numSamples);
+
+            for (int i = 0; i < numSamples; ++i)
+                destination[i] = param.convertFrom0to1 (destination[i]);
+
+            return;
+        }
+    }
+
+    FloatVectorOperations::fill (destination, adapter->getRawDenormalisedValue().load(), numSamples);
+}
+
 ValueTree AudioProcessorValueTreeState::copyState()
 {
     ScopedLock lock (valueTreeChanging);
@@ -515,6 +543,12 @@ AudioProcessorValueTreeState::ButtonAttachment::ButtonAttachment (AudioProcessor
 //==============================================================================
 #if JUCE_UNIT_TESTS
 
+#if JUCE_ENABLE_ALLOCATION_HOOKS
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE const UnitTestAllocationChecker checker (*this)
+#else
+#define JUCE_FAIL_ON_ALLOCATION_IN_SCOPE
+#endif
+
 struct ParameterAdapterTests final : public UnitTest
 {
     ParameterAdapterTests()
@@ -642,6 +676,7 @@ private:
         void changeProgramName (int, const String&) override {}
         void getStateInformation (MemoryBlock&) override {}
         void setStateInformation (const void*, int) override {}
+        bool supportsSampleAccurateAutomation() const override { return true; }
 
         AudioProcessorValueTreeState state { *this, nullptr };
     };
@@ -986,6 +1021,165 @@ public:
             expectEquals (listener.value, newValue);
             expectEquals (listener.id, String (key));
         }
+
+        beginTest ("Automation ramps interpolate between their points");
+        {
+            TestAudioProcessor proc (std::make_unique<AudioParameterFloat> ("a", "", NormalisableRange<float> (0.0f, 1.0f), 0.0f));
+            auto& param = *proc.getParameters()[0];
+
+            ParameterAutomationBuffer automation;
+            automation.prepare (1, 8);
+            automation.addPoint (param, 4, 1.0f);
+            automation.addPoint (param, 6, 0.5f);
+
+            auto* ramp = automation.getRampFor (param);
+            expect (ramp != nullptr);
+            expectEquals (ramp->size(), 2);
+            expectEquals (ramp->getStartValue(), 0.0f);
+            expectEquals (ramp->getEndValue(), 0.5f);
+
+            float values[8];
+            ramp->getValues (values, numElementsInArray (values));
+
+            const float expected[] { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f, 0.75f, 0.5f, 0.5f };
+
+            for (int i = 0; i < numElementsInArray (values); ++i)
+            {
+                expectEquals (values[i], expected[i]);
+                expectEquals (ramp->getValueAt (i), expected[i]);
+            }
+
+            automation.clear();
+            expect (automation.isEmpty());
+            expect (automation.getRampFor (param) == nullptr);
+        }
+
+        beginTest ("Automation points for different parameters can be interleaved");
+        {
+            ParameterLayout layout;
+            layout.add (std::make_unique<AudioParameterFloat> ("a", "", NormalisableRange<float> (0.0f, 1.0f), 0.0f),
+                        std::make_unique<AudioParameterFloat> ("b", "", NormalisableRange<float> (0.0f, 1.0f), 1.0f));
+            TestAudioProcessor proc (std::move (layout));
+            auto& a = *proc.getParameters()[0];
+            auto& b = *proc.getParameters()[1];
+
+            ParameterAutomationBuffer automation;
+            automation.prepare (2, 8);
+            automation.addPoint (a, 0, 0.1f);
+            automation.addPoint (b, 1, 0.9f);
+            automation.addPoint (a, 2, 0.2f);
+            automation.addPoint (b, 3, 0.8f);
+            automation.addPoint (a, 4, 0.3f);
+
+            expectEquals (automation.getNumRamps(), 2);
+
+            const auto getOffsetsAndValues = [] (const ParameterAutomationBuffer::Ramp& ramp)
+            {
+                std::vector<std::pair<int, float>> result;
+
+                for (auto& point : ramp)
+                    result.emplace_back (point.sampleOffset, point.value);
+
+                return result;
+            };
+
+            expect (getOffsetsAndValues (*automation.getRampFor (a)) == std::vector<std::pair<int, float>> { { 0, 0.1f }, { 2, 0.2f }, { 4, 0.3f } });
+            expect (getOffsetsAndValues (*automation.getRampFor (b)) == std::vector<std::pair<int, float>> { { 1, 0.9f }, { 3, 0.8f } });
+            expectEquals (automation.getRampFor (b)->getStartValue(), 1.0f);
+        }
+
+        beginTest ("Automation buffers can be filled without allocating");
+        {
+            ParameterLayout layout;
+            layout.add (std::make_unique<AudioParameterFloat> ("a", "", NormalisableRange<float> (0.0f, 1.0f), 0.0f),
+                        std::make_unique<AudioParameterFloat> ("b", "", NormalisableRange<float> (0.0f, 1.0f), 0.0f),
+                        std::make_unique<AudioParameterFloat> ("c", "", NormalisableRange<float> (0.0f, 1.0f), 0.0f));
+            TestAudioProcessor proc (std::move (layout));
+            const auto& params = proc.getParameters();
+
+            ParameterAutomationBuffer automation;
+            automation.prepare (params.size(), 60);
+
+            std::array<bool, 3> rampsAreInOrder {};
+
+            {
+                JUCE_FAIL_ON_ALLOCATION_IN_SCOPE;
+
+                for (int i = 0; i < 60; ++i)
+                    automation.addPoint (*params[i % 3], i, (float) i / 60.0f);
+
+                for (size_t p = 0; p < rampsAreInOrder.size(); ++p)
+                {
+                    auto* ramp = automation.getRampFor (*params[(int) p]);
+                    auto expectedOffset = (int) p;
+                    rampsAreInOrder[p] = ramp != nullptr && ramp->size() == 20;
+
+                    if (ramp != nullptr)
+                    {
+                        for (auto& point : *ramp)
+                        {
+                            rampsAreInOrder[p] = rampsAreInOrder[p] && point.sampleOffset == expectedOffset;
+                            expectedOffset += 3;
+                        }
+                    }
+                }
+            }
+
+            for (auto inOrder : rampsAreInOrder)
+                expect (inOrder);
+        }
+
+        beginTest ("Automation buffers report how many more points they can hold");
+        {
+            TestAudioProcessor proc (std::make_unique<AudioParameterFloat> ("a", "", NormalisableRange<float> (0.0f, 1.0f), 0.0f));
+            auto& param = *proc.getParameters()[0];
+
+            ParameterAutomationBuffer automation;
+            expectEquals (automation.getNumFreePoints(), 0);
+
+            automation.prepare (1, 4);
+            expectEquals (automation.getNumFreePoints(), 4);
+
+            for (int i = 0; i < 4; ++i)
+                automation.addPoint (param, i, 0.5f);
+
+            expectEquals (automation.getNumFreePoints(), 0);
+
+            automation.clear();
+            expectEquals (automation.getNumFreePoints(), 4);
+        }
+
+        beginTest ("getParameterValues follows the automation for the current block");
+        {
+            const auto key = "id";
+            TestAudioProcessor proc (std::make_unique<AudioParameterFloat> (key, "", NormalisableRange<float> (0.0f, 10.0f), 0.0f));
+            auto& param = *proc.getParameters()[0];
+
+            float values[4];
+            proc.state.getParameterValues (key, values, numElementsInArray (values));
+
+            for (auto v : values)
+                expectEquals (v, 0.0f);
+
+            ParameterAutomationBuffer automation;
+            automation.prepare (1, 8);
+            automation.addPoint (param, 2, 1.0f);
+            param.setValueNotifyingHost (1.0f);
+
+            proc.setParameterAutomation (&automation);
+            proc.state.getParameterValues (key, values, numElementsInArray (values));
+            proc.setParameterAutomation (nullptr);
+
+            const float expected[] { 0.0f, 5.0f, 10.0f, 10.0f };
+
+            for (int i = 0; i < numElementsInArray (values); ++i)
+                expectEquals (values[i], expected[i]);
+
+            proc.state.getParameterValues (key, values, numElementsInArray (values));
+
+            for (auto v : values)
+                expectEquals (v, 10.0f);
+        }
     }
     JUCE_END_IGNORE_WARNINGS_MSVC
 };
@@ -345,6 +345,17 @@ public:
     */
     std::atomic<float>* getRawParameterValue (StringRef parameterID) const noexcept;
 
+    /** Fills an array with the denormalised value of a parameter at each sample of the
+        current block.
+
+        Call this from processBlock(). If the host has provided sample-accurate automation
+        for the parameter (see AudioProcessor::getParameterAutomation()), the values follow
+        its ramp; otherwise every sample is set to the parameter's current value.
+
+        @see ParameterAutomationBuffer
+    */
+    void getParameterValues (StringRef parameterID, float* destination, int numSamples) const noexcept;
+
     //==============================================================================
     /** A listener class that can be attached to an AudioProcessorValueTreeState.
         Use AudioProcessorValueTreeState::addParameterListener() to register a callback.
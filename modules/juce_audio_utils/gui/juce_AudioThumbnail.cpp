@@ -88,6 +88,23 @@ struct AudioThumbnail::MinMaxValue
     inline void read (InputStream& input)      { input.read (values, 2); }
     inline void write (OutputStream& output)   { output.write (values, 2); }
 
+    /** Returns a value that covers the combined range of a set of values. */
+    static MinMaxValue combine (const MinMaxValue* source, int numValues) noexcept
+    {
+        int8 mx = -128;
+        int8 mn = 127;
+
+        for (int i = 0; i < numValues; ++i)
+        {
+            mn = jmin (mn, source[i].getMinValue());
+            mx = jmax (mx, source[i].getMaxValue());
+        }
+
+        MinMaxValue result;
+        result.set (mn, mx);
+        return result;
+    }
+
 private:
     int8 values[2];
 };
@@ -358,23 +375,54 @@ public:
         return data.size();
     }
 
+    /*  Finds the range of the thumb samples from startSample to endSample inclusive.
+
+        Rather than scanning the whole range, this uses the largest aligned blocks from the
+        decimated levels that fit inside it, so the time taken only grows with the logarithm
+        of the range's length.
+    */
     void getMinMax (int startSample, int endSample, MinMaxValue& result) const noexcept
     {
         if (startSample >= 0)
         {
-            endSample = jmin (endSample, data.size() - 1);
+            auto start = startSample;
+            auto end = jmin (endSample, data.size() - 1) + 1;
 
             int8 mx = -128;
             int8 mn = 127;
 
-            while (startSample <= endSample)
+            auto addRange = [&] (const MinMaxValue* values, int rangeStart, int rangeEnd)
+            {
+                if (rangeStart < rangeEnd)
+                {
+                    auto v = MinMaxValue::combine (values + rangeStart, rangeEnd - rangeStart);
+                    mn = jmin (mn, v.getMinValue());
+                    mx = jmax (mx, v.getMaxValue());
+                }
+            };
+
+            for (size_t level = 0; start < end; ++level)
             {
-                auto& v = data.getReference (startSample);
+                auto* values = getLevelData (level);
+
+                if (level < levels.size())
+                {
+                    auto firstWholeBlock = (start + decimationFactor - 1) / decimationFactor;
+                    auto endOfWholeBlocks = end / decimationFactor;
 
-                if (v.getMinValue() < mn)  mn = v.getMinValue();
-                if (v.getMaxValue() > mx)  mx = v.getMaxValue();
+                    if (firstWholeBlock < endOfWholeBlocks)
+                    {
+                        addRange (values, start, firstWholeBlock * decimationFactor);
+                        addRange (values, endOfWholeBlocks * decimationFactor, end);
 
-                ++startSample;
+                        start = firstWholeBlock;
+                        end = endOfWholeBlocks;
+                        continue;
+                    }
+                }
+
+                addRange (values, start, end);
+                break;
             }
 
             if (mn <= mx)
@@ -398,6 +446,15 @@ public:
 
         for (int i = 0; i < numValues; ++i)
             dest[i] = values[i];
+
+        updateLevels (startIndex, numValues);
+    }
+
+    /*  Recalculates all the decimated levels, after the data has been changed directly. */
+    void rebuildLevels()
+    {
+        resetPeak();
+        updateLevels (0, data.size());
     }
 
     void resetPeak() noexcept
@@ -409,28 +466,130 @@ public:
     {
         if (peakLevel < 0)
         {
-            for (auto& s : data)
-            {
-                auto peak = s.getPeak();
+            auto topLevel = levels.size();
+            auto* values = getLevelData (topLevel);
 
-                if (peak > peakLevel)
-                    peakLevel = peak;
-            }
+            for (int i = 0; i < getLevelSize (topLevel); ++i)
+                peakLevel = jmax (peakLevel, values[i].getPeak());
         }
 
         return peakLevel;
     }
 
+    //==============================================================================
+    // Each level holds the combined range of every decimationFactor values in the level below
+    static constexpr int decimationFactor = 8;
+
+    size_t getNumLevels() const noexcept                { return levels.size() + 1; }
+
+    void writeLevels (OutputStream& output) const
+    {
+        for (size_t level = 0; level < getNumLevels(); ++level)
+            output.write (getLevelData (level), (size_t) getLevelSize (level) * sizeof (MinMaxValue));
+    }
+
+    /*  Reads data that was written by writeLevels(). If it was written with a different
+        layout of levels, only the full-resolution data is used, and the rest is recalculated.
+    */
+    bool readLevels (InputStream& input, size_t numStoredLevels, int storedDecimationFactor)
+    {
+        auto readLevel = [&input] (MinMaxValue* dest, int numValues)
+        {
+            auto numBytes = (int) ((size_t) numValues * sizeof (MinMaxValue));
+            return input.read (dest, numBytes) == numBytes;
+        };
+
+        if (numStoredLevels == getNumLevels() && storedDecimationFactor == decimationFactor)
+        {
+            for (size_t level = 0; level < getNumLevels(); ++level)
+                if (! readLevel (getLevelData (level), getLevelSize (level)))
+                    return false;
+
+            resetPeak();
+            return true;
+        }
+
+        if (! readLevel (data.getRawDataPointer(), data.size()))
+            return false;
+
+        for (size_t level = 1, size = (size_t) data.size(); level < numStoredLevels; ++level)
+        {
+            size = (size + (size_t) storedDecimationFactor - 1) / (size_t) storedDecimationFactor;
+            input.skipNextBytes ((int64) (size * sizeof (MinMaxValue)));
+        }
+
+        rebuildLevels();
+        return true;
+    }
+
 private:
+    static_assert (sizeof (MinMaxValue) == 2, "The thumbnail file format relies on this being two bytes");
+
     Array<MinMaxValue> data;
+    std::vector<std::vector<MinMaxValue>> levels;
     int peakLevel = -1;
 
+    MinMaxValue* getLevelData (size_t level) noexcept
+    {
+        return level == 0 ? data.getRawDataPointer() : levels[level - 1].data();
+    }
+
+    const MinMaxValue* getLevelData (size_t level) const noexcept
+    {
+        return level == 0 ? data.getRawDataPointer() : levels[level - 1].data();
+    }
+
+    int getLevelSize (size_t level) const noexcept
+    {
+        return level == 0 ? data.size() : (int) levels[level - 1].size();
+    }
+
+    void updateLevels (int startIndex, int numValues)
+    {
+        for (size_t level = 0; level < levels.size() && numValues > 0; ++level)
+        {
+            auto* source = getLevelData (level);
+            auto sourceSize = getLevelSize (level);
+
+            auto first = startIndex / decimationFactor;
+            auto last = (startIndex + numValues - 1) / decimationFactor;
+
+            for (int i = first; i <= last; ++i)
+            {
+                auto childStart = i * decimationFactor;
+                levels[level][(size_t) i] = MinMaxValue::combine (source + childStart,
+                                                                  jmin (decimationFactor, sourceSize - childStart));
+            }
+
+            startIndex = first;
+            numValues = last - first + 1;
+        }
+    }
+
     void ensureSize (int thumbSamples)
     {
         auto extraNeeded = thumbSamples - data.size();
 
         if (extraNeeded > 0)
+        {
+            auto oldSize = data.size();
             data.insertMultiple (-1, MinMaxValue(), extraNeeded);
+
+            size_t level = 0;
+
+            for (auto size = data.size(); size > decimationFactor; ++level)
+            {
+                size = (size + decimationFactor - 1) / decimationFactor;
+
+                if (level == levels.size())
+                    levels.emplace_back();
+
+                levels[level].resize ((size_t) size);
+            }
+
+            // The last block of each level may now include some of the new values
+            updateLevels (oldSize, extraNeeded);
+        }
     }
 };
 
@@ -659,16 +818,59 @@ void AudioThumbnail::createChannels (const int length)
 }
 
 //==============================================================================
-bool AudioThumbnail::loadFrom (InputStream& rawInput)
+bool AudioThumbnail::loadFrom (InputStream& input)
 {
-    BufferedInputStream input (rawInput, 4096);
+    char magic[4] = {};
 
-    if (input.readByte() != 'j' || input.readByte() != 'a' || input.readByte() != 't' || input.readByte() != 'm')
+    if (input.read (magic, 4) != 4 || magic[0] != 'j' || magic[1] != 'a' || magic[2] != 't')
+        return false;
+
+    if (magic[3] == 'm')
+        return loadLegacyFormat (input);
+
+    if (magic[3] != 'p')
         return false;
 
     const ScopedLock sl (lock);
     clearChannelData();
 
+    samplesPerThumbSample = input.readInt();
+    totalSamples = input.readInt64();             // Total number of source samples.
+    numSamplesFinished = input.readInt64();       // Number of valid source samples that have been read into the thumbnail.
+    int32 numThumbnailSamples = input.readInt();  // Number of samples in the thumbnail data.
+    numChannels = input.readInt();                // Number of audio channels.
+    sampleRate = input.readDouble();              // Source sample rate.
+    auto numLevels = input.readInt();             // Number of levels stored for each channel.
+    auto decimationFactor = input.readInt();      // Number of values combined into each value of the next level.
+    input.skipNextBytes (8);                      // (reserved)
+
+    if (samplesPerThumbSample <= 0 || numThumbnailSamples < 0 || numChannels < 0 || numLevels <= 0 || decimationFactor <= 1)
+    {
+        clearChannelData();
+        return false;
+    }
+
+    createChannels (numThumbnailSamples);
+
+    for (auto* channel : channels)
+    {
+        if (! channel->readLevels (input, (size_t) numLevels, decimationFactor))
+        {
+            clearChannelData();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool AudioThumbnail::loadLegacyFormat (InputStream& rawInput)
+{
+    BufferedInputStream input (rawInput, 4096);
+
+    const ScopedLock sl (lock);
+    clearChannelData();
+
     samplesPerThumbSample = input.readInt();
     totalSamples = input.readInt64();             // Total number of source samples.
     numSamplesFinished = input.readInt64();       // Number of valid source samples that have been read into the thumbnail.
@@ -683,6 +885,9 @@ bool AudioThumbnail::loadFrom (InputStream& rawInput)
         for (int chan = 0; chan < numChannels; ++chan)
             channels.getUnchecked (chan)->getData (i)->read (input);
 
+    for (auto* channel : channels)
+        channel->rebuildLevels();
+
     return true;
 }
 
@@ -707,6 +912,29 @@ void AudioThumbnail::saveTo (OutputStream& output) const
             channels.getUnchecked (chan)->getData (i)->write (output);
 }
 
+void AudioThumbnail::saveWithLevelsTo (OutputStream& output) const
+{
+    const ScopedLock sl (lock);
+
+    const int numThumbnailSamples = channels.size() == 0 ? 0 : channels.getUnchecked (0)->getSize();
+    const int numLevels = channels.size() == 0 ? 1 : (int) channels.getUnchecked (0)->getNumLevels();
+
+    // Each channel's levels are stored one after another, so that they can be loaded in bulk
+    output.write ("jatp", 4);
+    output.writeInt (samplesPerThumbSample);
+    output.writeInt64 (totalSamples);
+    output.writeInt64 (numSamplesFinished);
+    output.writeInt (numThumbnailSamples);
+    output.writeInt (numChannels);
+    output.writeDouble (sampleRate);
+    output.writeInt (numLevels);
+    output.writeInt (ThumbData::decimationFactor);
+    output.writeInt64 (0);
+
+    for (auto* channel : channels)
+        channel->writeLevels (output);
+}
+
 //==============================================================================
 bool AudioThumbnail::setDataSource (LevelDataSource* newSource)
 {
@@ -136,18 +136,30 @@ public:
     /** Reloads the low res thumbnail data from an input stream.
 
         This is not an audio file stream! It takes a stream of thumbnail data that would
-        previously have been created by the saveTo() method.
+        previously have been created by the saveTo() method. Data written by older versions
+        of this class can also be loaded.
         @see saveTo
     */
     bool loadFrom (InputStream& input) override;
 
     /** Saves the low res thumbnail data to an output stream.
 
-        The data that is written can later be reloaded using loadFrom().
-        @see loadFrom
+        The data that is written can later be reloaded using loadFrom(), and can also be
+        read by older versions of this class.
+        @see loadFrom, saveWithLevelsTo
     */
     void saveTo (OutputStream& output) const override;
 
+    /** Saves the low res thumbnail data to an output stream, in a format that's quicker to load.
+
+        As well as the low res data, this writes the pre-calculated ranges that are used when
+        drawing zoomed-out views, so that these don't need to be rebuilt when it's loaded.
+        The data can be reloaded using loadFrom(), but older versions of this class can't
+        read it, so use saveTo() for anything that might be opened by an older version.
+        @see loadFrom, saveTo
+    */
+    void saveWithLevelsTo (OutputStream& output) const;
+
     //==============================================================================
     /** Returns the number of channels in the file. */
     int getNumChannels() const noexcept override;
@@ -233,6 +245,7 @@ private:
     CriticalSection lock;
 
     void clearChannelData();
+    bool loadLegacyFormat (InputStream&);
     bool setDataSource (LevelDataSource* newSource);
     void setLevels (const MinMaxValue* const* values, int thumbIndex, int numChans, int numValues);
     void createChannels (int length);
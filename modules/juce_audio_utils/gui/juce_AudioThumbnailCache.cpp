@@ -82,11 +82,8 @@ AudioThumbnailCache::~AudioThumbnailCache()
 
 AudioThumbnailCache::ThumbnailCacheEntry* AudioThumbnailCache::findThumbFor (const int64 hash) const
 {
-    for (int i = thumbs.size(); --i >= 0;)
-        if (thumbs.getUnchecked (i)->hash == hash)
-            return thumbs.getUnchecked (i);
-
-    return nullptr;
+    const auto iter = thumbsByHash.find (hash);
+    return iter != thumbsByHash.end() ? iter->second : nullptr;
 }
 
 int AudioThumbnailCache::findOldestThumb() const
@@ -135,9 +132,17 @@ void AudioThumbnailCache::storeThumb (const AudioThumbnailBase& thumb,
         te = new ThumbnailCacheEntry (hashCode);
 
         if (thumbs.size() < maxNumThumbsToStore)
+        {
             thumbs.add (te);
+        }
         else
-            thumbs.set (findOldestThumb(), te);
+        {
+            const auto oldest = findOldestThumb();
+            thumbsByHash.erase (thumbs.getUnchecked (oldest)->hash);
+            thumbs.set (oldest, te);
+        }
+
+        thumbsByHash[hashCode] = te;
     }
 
     {
@@ -151,12 +156,14 @@ void AudioThumbnailCache::storeThumb (const AudioThumbnailBase& thumb,
 void AudioThumbnailCache::clear()
 {
     const ScopedLock sl (lock);
+    thumbsByHash.clear();
     thumbs.clear();
 }
 
 void AudioThumbnailCache::removeThumb (const int64 hashCode)
 {
     const ScopedLock sl (lock);
+    thumbsByHash.erase (hashCode);
 
     for (int i = thumbs.size(); --i >= 0;)
         if (thumbs.getUnchecked (i)->hash == hashCode)
@@ -178,7 +185,10 @@ bool AudioThumbnailCache::readFromStream (InputStream& source)
     int numThumbnails = jmin (maxNumThumbsToStore, source.readInt());
 
     while (--numThumbnails >= 0 && ! source.isExhausted())
-        thumbs.add (new ThumbnailCacheEntry (source));
+    {
+        auto* te = thumbs.add (new ThumbnailCacheEntry (source));
+        thumbsByHash[te->hash] = te;
+    }
 
     return true;
 }
@@ -194,13 +204,68 @@ void AudioThumbnailCache::writeToStream (OutputStream& out)
         thumbs.getUnchecked (i)->write (out);
 }
 
-void AudioThumbnailCache::saveNewlyFinishedThumbnail (const AudioThumbnailBase&, int64)
+//==============================================================================
+void AudioThumbnailCache::setCacheDirectory (const File& directory)
+{
+    const ScopedLock sl (lock);
+    cacheDirectory = directory;
+}
+
+File AudioThumbnailCache::getCacheDirectory() const
+{
+    const ScopedLock sl (lock);
+    return cacheDirectory;
+}
+
+File AudioThumbnailCache::getFileForThumb (const int64 hash) const
 {
+    if (cacheDirectory == File())
+        return {};
+
+    return cacheDirectory.getChildFile (String::toHexString (hash)).withFileExtension ("thumb");
 }
 
-bool AudioThumbnailCache::loadNewThumb (AudioThumbnailBase&, int64)
+void AudioThumbnailCache::saveNewlyFinishedThumbnail (const AudioThumbnailBase& thumb, int64 hashCode)
 {
-    return false;
+    const ScopedLock sl (lock);
+    const auto file = getFileForThumb (hashCode);
+
+    if (file == File() || ! cacheDirectory.createDirectory())
+        return;
+
+    TemporaryFile temp (file);
+
+    {
+        FileOutputStream out (temp.getFile());
+
+        if (! out.openedOk())
+            return;
+
+        // These files are only read by this class, so they can use the format that loads quickest
+        if (auto* audioThumbnail = dynamic_cast<const AudioThumbnail*> (&thumb))
+            audioThumbnail->saveWithLevelsTo (out);
+        else
+            thumb.saveTo (out);
+    }
+
+    temp.overwriteTargetFileWithTemporary();
+}
+
+bool AudioThumbnailCache::loadNewThumb (AudioThumbnailBase& thumb, int64 hashCode)
+{
+    const ScopedLock sl (lock);
+    const auto file = getFileForThumb (hashCode);
+
+    if (! file.existsAsFile())
+        return false;
+
+    MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() == nullptr)
+        return false;
+
+    MemoryInputStream in (mappedFile.getData(), mappedFile.getSize(), false);
+    return thumb.loadFrom (in);
 }
 
 } // namespace juce
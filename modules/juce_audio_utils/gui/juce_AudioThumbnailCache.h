@@ -98,14 +98,40 @@ public:
     /** Returns the thread that client thumbnails can use. */
     TimeSliceThread& getTimeSliceThread() noexcept      { return thread; }
 
+    //==============================================================================
+    /** Sets a directory in which finished thumbnails will be saved.
+
+        When a thumbnail has finished loading, its data is written to a file in this
+        directory, named after its hash code. If a thumbnail isn't in the in-memory
+        cache, the cache will look for its file here before re-scanning the audio.
+        The files are memory-mapped when they're loaded, so this is very quick, even
+        for very long recordings. AudioThumbnails are written using
+        AudioThumbnail::saveWithLevelsTo(), so older versions of JUCE can't read them.
+
+        Pass a default-constructed File to stop using a directory. This has no effect
+        if you override saveNewlyFinishedThumbnail() and loadNewThumb().
+    */
+    void setCacheDirectory (const File& directory);
+
+    /** Returns the directory set by setCacheDirectory(). */
+    File getCacheDirectory() const;
+
 protected:
     /** This can be overridden to provide a custom callback for saving thumbnails
         once they have finished being loaded.
+
+        The default implementation writes the thumbnail to the cache directory, if
+        one has been set.
+        @see setCacheDirectory
     */
     virtual void saveNewlyFinishedThumbnail (const AudioThumbnailBase&, int64 hashCode);
 
     /** This can be overridden to provide a custom callback for loading thumbnails
         from pre-saved files to save the cache the trouble of having to create them.
+
+        The default implementation looks for the thumbnail in the cache directory, if
+        one has been set.
+        @see setCacheDirectory
     */
     virtual bool loadNewThumb (AudioThumbnailBase&, int64 hashCode);
 
@@ -115,11 +141,14 @@ private:
 
     class ThumbnailCacheEntry;
     OwnedArray<ThumbnailCacheEntry> thumbs;
+    std::unordered_map<int64, ThumbnailCacheEntry*> thumbsByHash;
     CriticalSection lock;
     int maxNumThumbsToStore;
+    File cacheDirectory;
 
     ThumbnailCacheEntry* findThumbFor (int64 hash) const;
     int findOldestThumb() const;
+    File getFileForThumb (int64 hash) const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioThumbnailCache)
 };
@@ -0,0 +1,212 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+class AudioThumbnailTests final : public UnitTest
+{
+public:
+    AudioThumbnailTests()  : UnitTest ("AudioThumbnail", UnitTestCategories::audio)  {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        const auto levels = makeLevels (random);
+
+        beginTest ("Ranges match a scan of every thumbnail sample");
+        {
+            Thumbnail thumbnail;
+            thumbnail.fill (levels);
+            expectMatchesLevels (thumbnail.thumb, levels, random);
+        }
+
+        beginTest ("saveTo() writes data that older versions can read");
+        {
+            Thumbnail thumbnail;
+            thumbnail.fill (levels);
+
+            MemoryOutputStream out;
+            thumbnail.thumb.saveTo (out);
+            expect (getMagic (out.getMemoryBlock()) == "jatm");
+
+            Thumbnail loaded;
+            MemoryInputStream in (out.getMemoryBlock(), true);
+            expect (loaded.thumb.loadFrom (in));
+            expectMatchesLevels (loaded.thumb, levels, random);
+        }
+
+        beginTest ("Data saved with its levels can be reloaded");
+        {
+            Thumbnail thumbnail;
+            thumbnail.fill (levels);
+
+            MemoryOutputStream out;
+            thumbnail.thumb.saveWithLevelsTo (out);
+            expect (getMagic (out.getMemoryBlock()) == "jatp");
+
+            Thumbnail loaded;
+            MemoryInputStream in (out.getMemoryBlock(), true);
+            expect (loaded.thumb.loadFrom (in));
+            expect (loaded.thumb.isFullyLoaded());
+            expectEquals (loaded.thumb.getNumChannels(), 1);
+            expectEquals (loaded.thumb.getTotalLength(), thumbnail.thumb.getTotalLength());
+            expectMatchesLevels (loaded.thumb, levels, random);
+        }
+
+        beginTest ("Data written by older versions can be loaded");
+        {
+            MemoryOutputStream out;
+            out.write ("jatm", 4);
+            out.writeInt (1);                       // samples per thumbnail sample
+            out.writeInt64 (numLevels);             // total samples
+            out.writeInt64 (numLevels);             // samples finished
+            out.writeInt (numLevels);               // thumbnail samples
+            out.writeInt (1);                       // channels
+            out.writeInt ((int) sampleRate);
+            out.writeInt64 (0);
+            out.writeInt64 (0);
+
+            for (auto level : levels)
+            {
+                out.writeByte ((char) level);
+                out.writeByte ((char) (level + 1));
+            }
+
+            Thumbnail loaded;
+            MemoryInputStream in (out.getMemoryBlock(), true);
+            expect (loaded.thumb.loadFrom (in));
+            expect (loaded.thumb.isFullyLoaded());
+            expectMatchesLevels (loaded.thumb, levels, random);
+        }
+
+        beginTest ("Thumbnails can be reloaded from the cache directory");
+        {
+            const auto directory = File::getSpecialLocation (File::tempDirectory).getNonexistentChildFile ("thumbnails", {});
+            const auto hash = (int64) 0x12345678;
+
+            {
+                Thumbnail thumbnail;
+                thumbnail.cache.setCacheDirectory (directory);
+                thumbnail.fill (levels);
+                thumbnail.cache.storeThumb (thumbnail.thumb, hash);
+            }
+
+            expectEquals (directory.getNumberOfChildFiles (File::findFiles), 1);
+
+            {
+                Thumbnail loaded;
+                loaded.cache.setCacheDirectory (directory);
+                expect (loaded.cache.loadThumb (loaded.thumb, hash));
+                expectMatchesLevels (loaded.thumb, levels, random);
+
+                expect (! loaded.cache.loadThumb (loaded.thumb, hash + 1));
+            }
+
+            expect (directory.deleteRecursively());
+        }
+    }
+
+private:
+    // Each source sample becomes one thumbnail sample, and the rate makes the times exact
+    static constexpr int numLevels = 5000;
+    static constexpr double sampleRate = 1024.0;
+
+    struct Thumbnail
+    {
+        void fill (const std::vector<int>& levelsToUse)
+        {
+            AudioBuffer<float> buffer (1, (int) levelsToUse.size());
+
+            for (size_t i = 0; i < levelsToUse.size(); ++i)
+                buffer.setSample (0, (int) i, (float) levelsToUse[i] / 127.0f);
+
+            thumb.reset (1, sampleRate, buffer.getNumSamples());
+            thumb.addBlock (0, buffer, 0, buffer.getNumSamples());
+        }
+
+        AudioFormatManager formatManager;
+        AudioThumbnailCache cache { 4 };
+        AudioThumbnail thumb { 1, formatManager, cache };
+    };
+
+    // Each level is stored as the range from the level to one above it
+    static std::vector<int> makeLevels (Random& random)
+    {
+        std::vector<int> result ((size_t) numLevels);
+
+        for (auto& level : result)
+            level = random.nextInt ({ -127, 127 });
+
+        return result;
+    }
+
+    static String getMagic (const MemoryBlock& block)
+    {
+        return block.getSize() >= 4 ? String (static_cast<const char*> (block.getData()), 4) : String();
+    }
+
+    void expectMatchesLevels (AudioThumbnail& thumb, const std::vector<int>& levels, Random& random)
+    {
+        for (int i = 0; i < 500; ++i)
+        {
+            // Mostly long ranges, which use the decimated levels, and some short ones
+            const auto start = random.nextInt (numLevels);
+            const auto maxLength = i % 4 == 0 ? 20 : numLevels;
+            const auto end = jmin (numLevels - 1, start + random.nextInt (maxLength));
+
+            int expectedMin = 127, expectedMax = -128;
+
+            for (auto j = start; j <= end; ++j)
+            {
+                expectedMin = jmin (expectedMin, levels[(size_t) j]);
+                expectedMax = jmax (expectedMax, levels[(size_t) j] + 1);
+            }
+
+            float minValue = 0.0f, maxValue = 0.0f;
+            thumb.getApproximateMinMax (start / sampleRate, end / sampleRate, 0, minValue, maxValue);
+
+            if (! exactlyEqual (minValue, (float) expectedMin / 128.0f) || ! exactlyEqual (maxValue, (float) expectedMax / 128.0f))
+            {
+                expect (false, "Mismatch for the range " + String (start) + " to " + String (end));
+                return;
+            }
+        }
+    }
+};
+
+static AudioThumbnailTests audioThumbnailTests;
+
+} // namespace juce
@@ -113,3 +113,7 @@
  #endif
 
 #endif
+
+#if JUCE_UNIT_TESTS
+ #include "gui/juce_AudioThumbnail_test.cpp"
+#endif
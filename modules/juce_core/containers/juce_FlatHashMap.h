@@ -0,0 +1,837 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Generates the 64-bit hashes used by FlatHashMap and FlatHashSet.
+
+    Strings are hashed from the bytes of their text, so a String, a StringRef, an
+    Identifier or a string literal containing the same text will all produce the same
+    hash. This is what lets a map with String keys be searched with a StringRef or a
+    literal without creating a temporary String. Integers, enums and pointers are
+    multiplied by a large odd constant, which spreads keys that are close together
+    across the whole range of hashes.
+
+    Note that a char pointer is treated as a null-terminated string rather than as an
+    address.
+
+    To use your own key types, write a class with a generateHash() function for each
+    type of key that you'll look up, e.g.
+    @code
+    struct MyHashGenerator
+    {
+        uint64 generateHash (const MyKeyType& key) const noexcept
+        {
+            return DefaultFlatHashFunctions::generateHash (key.getId());
+        }
+    };
+    @endcode
+
+    @see FlatHashMap, FlatHashSet
+
+    @tags{Core}
+*/
+struct DefaultFlatHashFunctions
+{
+    /** Generates a hash from a block of memory. */
+    static uint64 generateHash (const void* data, size_t numBytes) noexcept
+    {
+        auto* bytes = static_cast<const uint8*> (data);
+        auto hash = (uint64) numBytes * multiplier;
+
+        for (; numBytes >= 8; bytes += 8, numBytes -= 8)
+            hash = addBlock (hash, readUnaligned<uint64> (bytes));
+
+        if (numBytes > 0)
+        {
+            uint64 block = 0;
+
+            for (size_t i = 0; i < numBytes; ++i)
+                block |= (uint64) bytes[i] << (8 * i);
+
+            hash = addBlock (hash, block);
+        }
+
+        return mix (hash);
+    }
+
+    /** Generates a hash from a string. */
+    static uint64 generateHash (StringRef key) noexcept         { return generateHash (key.text.getAddress(), key.text.sizeInBytes() - 1); }
+    /** Generates a hash from a string. */
+    static uint64 generateHash (const String& key) noexcept     { return generateHash (StringRef (key)); }
+
+    /** Generates a hash from an integer or an enum. */
+    template <typename IntegerType, std::enable_if_t<std::is_integral_v<IntegerType> || std::is_enum_v<IntegerType>, int> = 0>
+    static uint64 generateHash (IntegerType key) noexcept       { return (uint64) key * multiplier; }
+
+    /** Generates a hash from a pointer, or from the text of a null-terminated char string. */
+    template <typename ObjectType>
+    static uint64 generateHash (ObjectType* key) noexcept
+    {
+        if constexpr (std::is_same_v<std::remove_cv_t<ObjectType>, char>)
+            return generateHash (StringRef (key));
+        else
+            return (uint64) (pointer_sized_uint) key * multiplier;
+    }
+
+private:
+    static constexpr uint64 multiplier = 0x9e3779b97f4a7c15ull;
+
+    static constexpr uint64 addBlock (uint64 hash, uint64 block) noexcept
+    {
+        hash += block * 0xc2b2ae3d27d4eb4full;
+        return ((hash << 31) | (hash >> 33)) * multiplier;
+    }
+
+    static constexpr uint64 mix (uint64 x) noexcept
+    {
+        x = (x ^ (x >> 33)) * 0xff51afd7ed558ccdull;
+        x = (x ^ (x >> 33)) * 0xc4ceb9fe1a85ec53ull;
+        return x ^ (x >> 33);
+    }
+};
+
+#ifndef DOXYGEN
+namespace detail
+{
+    /*  The open-addressing table shared by FlatHashMap and FlatHashSet.
+
+        Items are stored directly in the slots of a single array whose size is a power of
+        two, and collisions are resolved with Robin Hood linear probing: each cluster is
+        kept sorted by the slot that its items hash to, so a search can stop as soon as it
+        reaches an item that is closer to its own home slot than the key being searched for
+        would be. Removing an item shifts the rest of its cluster back by one, so no
+        tombstones are needed.
+
+        Each slot also stores 32 bits of its item's hash, which avoids most key comparisons
+        during a search and means that the keys never need to be hashed again when the
+        table grows.
+    */
+    template <typename ItemType, class KeyOfItem, class HashFunctionType>
+    class FlatHashTable
+    {
+    public:
+        explicit FlatHashTable (HashFunctionType h)  : hashFunction (std::move (h)) {}
+
+        FlatHashTable (const FlatHashTable& other)
+            : hashFunction (other.hashFunction)
+        {
+            reserve (other.numItems);
+
+            for (int i = 0; i < other.numSlots; ++i)
+                if (other.slots[i].distance != 0)
+                    insertUnique (other.slots[i].hash, ItemType (other.slots[i].getItem()));
+        }
+
+        FlatHashTable (FlatHashTable&& other) noexcept
+            : hashFunction (other.hashFunction)
+        {
+            swapWith (other);
+        }
+
+        FlatHashTable& operator= (const FlatHashTable& other)
+        {
+            auto copy (other);
+            swapWith (copy);
+            return *this;
+        }
+
+        FlatHashTable& operator= (FlatHashTable&& other) noexcept
+        {
+            auto moved (std::move (other));
+            swapWith (moved);
+            return *this;
+        }
+
+        ~FlatHashTable()
+        {
+            clear();
+        }
+
+        void swapWith (FlatHashTable& other) noexcept
+        {
+            std::swap (hashFunction, other.hashFunction);
+            slots.swapWith (other.slots);
+            std::swap (numSlots, other.numSlots);
+            std::swap (numItems, other.numItems);
+        }
+
+        int size() const noexcept                       { return numItems; }
+        int getNumSlots() const noexcept                { return numSlots; }
+
+        ItemType& getItem (int index) noexcept              { return slots[index].getItem(); }
+        const ItemType& getItem (int index) const noexcept  { return slots[index].getItem(); }
+
+        int getNextIndex (int index) const noexcept
+        {
+            while (index < numSlots && slots[index].distance == 0)
+                ++index;
+
+            return index;
+        }
+
+        void clear() noexcept
+        {
+            for (int i = 0; i < numSlots; ++i)
+            {
+                if (slots[i].distance != 0)
+                {
+                    slots[i].getItem().~ItemType();
+                    slots[i].distance = 0;
+                }
+            }
+
+            numItems = 0;
+        }
+
+        void reserve (int numItemsToHold)
+        {
+            if (numItemsToHold > getMaxNumItems (numSlots))
+                resize (getNumSlotsNeeded (numItemsToHold));
+        }
+
+        void rehash (int minNumSlots)
+        {
+            resize (jmax (minNumSlots > 0 ? nextPowerOfTwo (jmax (8, minNumSlots)) : 0,
+                          getNumSlotsNeeded (numItems)));
+        }
+
+        template <typename Key>
+        int findIndex (const Key& key) const
+        {
+            return numItems > 0 ? findIndex (key, getHash (key)) : -1;
+        }
+
+        /*  Returns the index of the item that matches the key, and false; or if there isn't
+            one, adds the item returned by createItem and returns its index, and true.
+        */
+        template <typename Key, typename CreateItemFn>
+        std::pair<int, bool> findOrInsert (const Key& key, CreateItemFn&& createItem)
+        {
+            const auto hash = getHash (key);
+
+            if (numItems > 0)
+                if (auto index = findIndex (key, hash); index >= 0)
+                    return { index, false };
+
+            ItemType newItem (createItem());
+
+            if (numItems >= getMaxNumItems (numSlots))
+                resize (getNumSlotsNeeded (numItems + 1));
+
+            return { insertUnique (hash, std::move (newItem)), true };
+        }
+
+        void removeAt (int index) noexcept
+        {
+            const auto mask = (uint32) numSlots - 1;
+            auto i = (uint32) index;
+
+            slots[i].getItem().~ItemType();
+
+            for (;;)
+            {
+                const auto next = (i + 1) & mask;
+
+                if (slots[next].distance <= 1)
+                    break;
+
+                slots[i].moveFrom (slots[next], -1);
+                i = next;
+            }
+
+            slots[i].distance = 0;
+            --numItems;
+        }
+
+        template <typename PredicateFn>
+        int removeIf (PredicateFn&& shouldRemove)
+        {
+            if (numItems == 0)
+                return 0;
+
+            // Removing an item can only pull back items from later in its cluster, so by
+            // starting just after an empty slot, every item is still visited exactly once.
+            const auto mask = (uint32) numSlots - 1;
+            uint32 start = 0;
+
+            while (slots[start].distance != 0)
+                ++start;
+
+            int numRemoved = 0;
+
+            for (auto i = (start + 1) & mask; i != start;)
+            {
+                if (slots[i].distance != 0 && shouldRemove (slots[i].getItem()))
+                {
+                    removeAt ((int) i);
+                    ++numRemoved;
+                }
+                else
+                {
+                    i = (i + 1) & mask;
+                }
+            }
+
+            return numRemoved;
+        }
+
+    private:
+        struct Slot
+        {
+            ItemType& getItem() noexcept                { return *std::launder (reinterpret_cast<ItemType*> (storage)); }
+            const ItemType& getItem() const noexcept    { return *std::launder (reinterpret_cast<const ItemType*> (storage)); }
+
+            // Moves the item from another slot into this empty one, and adjusts its
+            // distance to suit its new position.
+            void moveFrom (Slot& other, int distanceChange) noexcept
+            {
+                new (storage) ItemType (std::move (other.getItem()));
+                other.getItem().~ItemType();
+                distance = (uint32) ((int) other.distance + distanceChange);
+                hash = other.hash;
+            }
+
+            uint32 distance;  // 0 for an empty slot, otherwise 1 + the distance from the item's home slot
+            uint32 hash;
+            alignas (ItemType) std::byte storage[sizeof (ItemType)];
+        };
+
+        HashFunctionType hashFunction;
+        HeapBlock<Slot> slots;
+        int numSlots = 0, numItems = 0;
+
+        static int getMaxNumItems (int slotsAvailable) noexcept     { return slotsAvailable - slotsAvailable / 8; }
+
+        static int getNumSlotsNeeded (int numItemsToHold) noexcept
+        {
+            if (numItemsToHold <= 0)
+                return 0;
+
+            int n = 8;
+
+            while (getMaxNumItems (n) < numItemsToHold)
+                n *= 2;
+
+            return n;
+        }
+
+        template <typename Key>
+        uint32 getHash (const Key& key) const noexcept
+        {
+            const auto hash = hashFunction.generateHash (key);
+            return (uint32) (hash ^ (hash >> 32));
+        }
+
+        template <typename Key>
+        int findIndex (const Key& key, uint32 hash) const
+        {
+            const auto mask = (uint32) numSlots - 1;
+
+            for (uint32 i = hash & mask, distance = 1;; i = (i + 1) & mask, ++distance)
+            {
+                const auto& slot = slots[i];
+
+                if (slot.distance < distance)
+                    return -1;
+
+                if (slot.hash == hash && KeyOfItem::get (slot.getItem()) == key)
+                    return (int) i;
+            }
+        }
+
+        int insertUnique (uint32 hash, ItemType&& newItem)
+        {
+            const auto mask = (uint32) numSlots - 1;
+            auto index = hash & mask;
+            uint32 distance = 1;
+
+            while (slots[index].distance >= distance)
+            {
+                index = (index + 1) & mask;
+                ++distance;
+            }
+
+            if (slots[index].distance != 0)
+            {
+                // Shift the rest of the cluster along to make room, which keeps it sorted
+                auto i = index;
+
+                while (slots[i].distance != 0)
+                    i = (i + 1) & mask;
+
+                while (i != index)
+                {
+                    const auto previous = (i - 1) & mask;
+                    slots[i].moveFrom (slots[previous], 1);
+                    i = previous;
+                }
+            }
+
+            new (slots[index].storage) ItemType (std::move (newItem));
+            slots[index].distance = distance;
+            slots[index].hash = hash;
+            ++numItems;
+            return (int) index;
+        }
+
+        void resize (int newNumSlots)
+        {
+            if (newNumSlots == numSlots)
+                return;
+
+            HeapBlock<Slot> oldSlots;
+            oldSlots.swapWith (slots);
+            const auto oldNumSlots = std::exchange (numSlots, newNumSlots);
+            numItems = 0;
+
+            if (newNumSlots > 0)
+                slots.calloc ((size_t) newNumSlots);
+
+            for (int i = 0; i < oldNumSlots; ++i)
+            {
+                if (oldSlots[i].distance != 0)
+                {
+                    insertUnique (oldSlots[i].hash, std::move (oldSlots[i].getItem()));
+                    oldSlots[i].getItem().~ItemType();
+                }
+            }
+        }
+    };
+} // namespace detail
+#endif
+
+//==============================================================================
+/**
+    Holds a set of mappings between some key/value pairs, in a single flat array.
+
+    This does the same job as HashMap, but rather than allocating each item separately
+    and chaining items that share a slot, it keeps all of its items in one array and
+    resolves collisions with Robin Hood open addressing. Adding an item only allocates
+    when the table grows, and a lookup normally touches a single cache line.
+
+    The hash functions produce 64-bit values, and any type of key that the hash function
+    can hash and that can be compared with the map's KeyType can be used to look up an
+    item. With the DefaultFlatHashFunctions, this means that a map with String keys can
+    be searched with a StringRef or a string literal without creating a temporary String:
+    @code
+    FlatHashMap<String, int> map;
+    map.set ("one", 1);
+    map.set ("two", 2);
+
+    DBG (map["two"]); // prints "2"
+
+    if (auto* value = map.find (StringRef ("one")))
+        *value = 3;
+
+    for (auto item : map)
+        DBG (item.key << " -> " << item.value);
+    @endcode
+
+    Adding or removing items may move the other items around, so pointers to values
+    and iterators shouldn't be kept across any call that modifies the map. The order
+    in which items are iterated bears no resemblance to the order in which they were
+    added.
+
+    Like the other containers, this class isn't thread-safe. Any number of threads may
+    call its const methods at the same time, but if any thread could be modifying it,
+    all access must be protected with a lock.
+
+    @see HashMap, FlatHashSet, DefaultFlatHashFunctions
+
+    @tags{Core}
+*/
+template <typename KeyType,
+          typename ValueType,
+          class HashFunctionType = DefaultFlatHashFunctions>
+class FlatHashMap
+{
+    struct Item
+    {
+        KeyType key;
+        ValueType value;
+    };
+
+    struct KeyOfItem
+    {
+        static const KeyType& get (const Item& item) noexcept   { return item.key; }
+    };
+
+    using Table = detail::FlatHashTable<Item, KeyOfItem, HashFunctionType>;
+
+public:
+    //==============================================================================
+    /** Creates an empty map.
+        No memory is allocated until the first item is added, or reserve() is called.
+    */
+    explicit FlatHashMap (HashFunctionType hashFunction = HashFunctionType())
+        : table (std::move (hashFunction))
+    {}
+
+    //==============================================================================
+    /** Returns the number of items in the map. */
+    int size() const noexcept                           { return table.size(); }
+
+    /** Returns true if the map is empty. */
+    bool isEmpty() const noexcept                       { return table.size() == 0; }
+
+    /** Removes all the items from the map.
+        This doesn't release the map's storage, see rehash().
+    */
+    void clear() noexcept                               { table.clear(); }
+
+    /** Makes sure that the map can hold the given number of items without growing. */
+    void reserve (int numItemsToHold)                   { table.reserve (numItemsToHold); }
+
+    /** Rebuilds the table with at least the given number of slots.
+        The number of slots will be rounded up to a power of two, and up to however many
+        are needed to hold the current items, so rehash (0) will release as much storage
+        as possible.
+        @see getNumSlots
+    */
+    void rehash (int minNumSlots)                       { table.rehash (minNumSlots); }
+
+    /** Returns the number of slots in the table.
+        The table grows when more than 7/8 of its slots are in use.
+    */
+    int getNumSlots() const noexcept                    { return table.getNumSlots(); }
+
+    //==============================================================================
+    /** Returns true if the map contains an item with the given key. */
+    template <typename Key>
+    bool contains (const Key& keyToLookFor) const       { return table.findIndex (keyToLookFor) >= 0; }
+
+    /** Returns a pointer to the value for the given key, or nullptr if the map doesn't
+        contain the key.
+        The pointer will only remain valid until the map is next modified.
+    */
+    template <typename Key>
+    ValueType* find (const Key& keyToLookFor)
+    {
+        const auto index = table.findIndex (keyToLookFor);
+        return index >= 0 ? &table.getItem (index).value : nullptr;
+    }
+
+    /** Returns a pointer to the value for the given key, or nullptr if the map doesn't
+        contain the key.
+        The pointer will only remain valid until the map is next modified.
+    */
+    template <typename Key>
+    const ValueType* find (const Key& keyToLookFor) const
+    {
+        const auto index = table.findIndex (keyToLookFor);
+        return index >= 0 ? &table.getItem (index).value : nullptr;
+    }
+
+    /** Returns the value for a given key.
+        If the map doesn't contain the key, a default instance of the value type is returned.
+    */
+    template <typename Key>
+    ValueType operator[] (const Key& keyToLookFor) const
+    {
+        if (auto* value = find (keyToLookFor))
+            return *value;
+
+        return ValueType();
+    }
+
+    /** Returns a reference to the value for a given key.
+        If the map doesn't contain the key, a default instance of the value type is added
+        to the map first. The reference will only remain valid until the map is next modified.
+    */
+    template <typename Key>
+    ValueType& getReference (const Key& keyToLookFor)
+    {
+        const auto index = table.findOrInsert (keyToLookFor, [&] { return Item { KeyType (keyToLookFor), ValueType() }; }).first;
+        return table.getItem (index).value;
+    }
+
+    /** Adds or replaces an item in the map. */
+    template <typename Key>
+    void set (const Key& key, ValueType newValue)
+    {
+        const auto [index, added] = table.findOrInsert (key, [&] { return Item { KeyType (key), std::move (newValue) }; });
+
+        if (! added)
+            table.getItem (index).value = std::move (newValue);
+    }
+
+    /** Removes the item with the given key, returning true if there was one. */
+    template <typename Key>
+    bool remove (const Key& keyToRemove)
+    {
+        const auto index = table.findIndex (keyToRemove);
+
+        if (index < 0)
+            return false;
+
+        table.removeAt (index);
+        return true;
+    }
+
+    /** Removes all the items for which the predicate returns true, and returns the number
+        that were removed.
+        The predicate is called once for each item, as shouldRemove (const KeyType&, ValueType&).
+    */
+    template <typename PredicateFn>
+    int removeIf (PredicateFn&& shouldRemove)
+    {
+        return table.removeIf ([&] (Item& item) { return shouldRemove (std::as_const (item.key), item.value); });
+    }
+
+    /** Efficiently swaps the contents of two maps. */
+    void swapWith (FlatHashMap& other) noexcept         { table.swapWith (other.table); }
+
+    //==============================================================================
+    /** Iterates the items in a FlatHashMap.
+        Dereferencing one of these gives an object with key and value members, which are
+        references to the item in the map.
+    */
+    template <bool isConst>
+    class IteratorBase
+    {
+        using TableType = std::conditional_t<isConst, const Table, Table>;
+
+    public:
+        struct Reference
+        {
+            const KeyType& key;
+            std::conditional_t<isConst, const ValueType&, ValueType&> value;
+        };
+
+        IteratorBase (TableType& t, int startIndex) noexcept
+            : table (&t), index (t.getNextIndex (startIndex))
+        {}
+
+        Reference operator*() const noexcept
+        {
+            auto& item = table->getItem (index);
+            return { item.key, item.value };
+        }
+
+        IteratorBase& operator++() noexcept
+        {
+            index = table->getNextIndex (index + 1);
+            return *this;
+        }
+
+        bool operator== (const IteratorBase& other) const noexcept  { return index == other.index; }
+        bool operator!= (const IteratorBase& other) const noexcept  { return index != other.index; }
+
+    private:
+        TableType* table;
+        int index;
+    };
+
+    using Iterator      = IteratorBase<false>;
+    using ConstIterator = IteratorBase<true>;
+
+    /** Returns an iterator to the first item in the map. */
+    Iterator begin() noexcept                           { return { table, 0 }; }
+    /** Returns an iterator to the end of the map. */
+    Iterator end() noexcept                             { return { table, table.getNumSlots() }; }
+    /** Returns an iterator to the first item in the map. */
+    ConstIterator begin() const noexcept                { return { table, 0 }; }
+    /** Returns an iterator to the end of the map. */
+    ConstIterator end() const noexcept                  { return { table, table.getNumSlots() }; }
+
+private:
+    //==============================================================================
+    Table table;
+
+    JUCE_LEAK_DETECTOR (FlatHashMap)
+};
+
+//==============================================================================
+/**
+    Holds a set of unique keys, in a single flat array.
+
+    This uses the same open-addressing table as FlatHashMap, so the same rules apply:
+    keys can be looked up with any type that the hash function can hash and that can be
+    compared with the set's KeyType, and adding or removing keys may move the others.
+
+    @code
+    FlatHashSet<String> names;
+    names.add ("apple");
+
+    jassert (names.contains (StringRef ("apple")));
+    @endcode
+
+    @see FlatHashMap, SortedSet, DefaultFlatHashFunctions
+
+    @tags{Core}
+*/
+template <typename KeyType,
+          class HashFunctionType = DefaultFlatHashFunctions>
+class FlatHashSet
+{
+    struct KeyOfItem
+    {
+        static const KeyType& get (const KeyType& item) noexcept    { return item; }
+    };
+
+    using Table = detail::FlatHashTable<KeyType, KeyOfItem, HashFunctionType>;
+
+public:
+    //==============================================================================
+    /** Creates an empty set.
+        No memory is allocated until the first key is added, or reserve() is called.
+    */
+    explicit FlatHashSet (HashFunctionType hashFunction = HashFunctionType())
+        : table (std::move (hashFunction))
+    {}
+
+    //==============================================================================
+    /** Returns the number of keys in the set. */
+    int size() const noexcept                           { return table.size(); }
+
+    /** Returns true if the set is empty. */
+    bool isEmpty() const noexcept                       { return table.size() == 0; }
+
+    /** Removes all the keys from the set.
+        This doesn't release the set's storage, see rehash().
+    */
+    void clear() noexcept                               { table.clear(); }
+
+    /** Makes sure that the set can hold the given number of keys without growing. */
+    void reserve (int numKeysToHold)                    { table.reserve (numKeysToHold); }
+
+    /** Rebuilds the table with at least the given number of slots.
+        @see FlatHashMap::rehash
+    */
+    void rehash (int minNumSlots)                       { table.rehash (minNumSlots); }
+
+    /** Returns the number of slots in the table. */
+    int getNumSlots() const noexcept                    { return table.getNumSlots(); }
+
+    //==============================================================================
+    /** Returns true if the set contains the given key. */
+    template <typename Key>
+    bool contains (const Key& keyToLookFor) const       { return table.findIndex (keyToLookFor) >= 0; }
+
+    /** Returns a pointer to the key in the set that matches the one given, or nullptr if
+        there isn't one.
+        The pointer will only remain valid until the set is next modified.
+    */
+    template <typename Key>
+    const KeyType* find (const Key& keyToLookFor) const
+    {
+        const auto index = table.findIndex (keyToLookFor);
+        return index >= 0 ? &table.getItem (index) : nullptr;
+    }
+
+    /** Adds a key to the set, returning false if it was already there. */
+    template <typename Key>
+    bool add (const Key& newKey)
+    {
+        return table.findOrInsert (newKey, [&] { return KeyType (newKey); }).second;
+    }
+
+    /** Returns the key in the set that matches the one given, adding it first if it
+        isn't already there.
+        The reference will only remain valid until the set is next modified.
+    */
+    template <typename Key>
+    const KeyType& findOrAdd (const Key& key)
+    {
+        return table.getItem (table.findOrInsert (key, [&] { return KeyType (key); }).first);
+    }
+
+    /** Removes a key from the set, returning true if it was there. */
+    template <typename Key>
+    bool remove (const Key& keyToRemove)
+    {
+        const auto index = table.findIndex (keyToRemove);
+
+        if (index < 0)
+            return false;
+
+        table.removeAt (index);
+        return true;
+    }
+
+    /** Removes all the keys for which the predicate returns true, and returns the number
+        that were removed.
+        The predicate is called once for each key, as shouldRemove (const KeyType&).
+    */
+    template <typename PredicateFn>
+    int removeIf (PredicateFn&& shouldRemove)
+    {
+        return table.removeIf ([&] (const KeyType& key) { return shouldRemove (key); });
+    }
+
+    /** Efficiently swaps the contents of two sets. */
+    void swapWith (FlatHashSet& other) noexcept         { table.swapWith (other.table); }
+
+    //==============================================================================
+    /** Iterates the keys in a FlatHashSet. */
+    class Iterator
+    {
+    public:
+        Iterator (const Table& t, int startIndex) noexcept
+            : table (&t), index (t.getNextIndex (startIndex))
+        {}
+
+        const KeyType& operator*() const noexcept   { return table->getItem (index); }
+
+        Iterator& operator++() noexcept
+        {
+            index = table->getNextIndex (index + 1);
+            return *this;
+        }
+
+        bool operator== (const Iterator& other) const noexcept  { return index == other.index; }
+        bool operator!= (const Iterator& other) const noexcept  { return index != other.index; }
+
+    private:
+        const Table* table;
+        int index;
+    };
+
+    /** Returns an iterator to the first key in the set. */
+    Iterator begin() const noexcept                     { return { table, 0 }; }
+    /** Returns an iterator to the end of the set. */
+    Iterator end() const noexcept                       { return { table, table.getNumSlots() }; }
+
+private:
+    //==============================================================================
+    Table table;
+
+    JUCE_LEAK_DETECTOR (FlatHashSet)
+};
+
+} // namespace juce
@@ -0,0 +1,346 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class FlatHashMapTests final : public UnitTest
+{
+public:
+    FlatHashMapTests()
+        : UnitTest ("FlatHashMap", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Random operations match std::map");
+        {
+            checkRandomOperations<int, DefaultFlatHashFunctions> (random, [] (Random& r) { return r.nextInt (2000) - 1000; });
+            checkRandomOperations<String, DefaultFlatHashFunctions> (random, [] (Random& r) { return String (r.nextInt (2000)); });
+        }
+
+        beginTest ("Clusters that wrap around the end of the table are handled");
+        {
+            // This hash puts every key into one of a few slots, so every item is part
+            // of a long cluster, and many of those will wrap around.
+            checkRandomOperations<int, CollidingHash> (random, [] (Random& r) { return r.nextInt (200); });
+        }
+
+        beginTest ("String keys can be found without creating a String");
+        {
+            FlatHashMap<String, int> map;
+            map.set ("apple", 1);
+            map.set (String ("banana"), 2);
+            map.set (Identifier ("cherry").toString(), 3);
+
+            expectEquals (map.size(), 3);
+            expectEquals (map["apple"], 1);
+            expectEquals (map[StringRef ("banana")], 2);
+            expectEquals (map[Identifier ("cherry").toString()], 3);
+            expectEquals (map[String ("cherry")], 3);
+            expectEquals (map["durian"], 0);
+            expect (map.find ("durian") == nullptr);
+            expect (! map.contains (StringRef ("Apple")));
+
+            char key[] = "apple";
+            expect (map.contains (static_cast<char*> (key)));
+
+            map.getReference (StringRef ("apple")) += 10;
+            expectEquals (map["apple"], 11);
+            expect (map.remove (StringRef ("banana")));
+            expect (! map.remove ("banana"));
+            expectEquals (map.size(), 2);
+        }
+
+        beginTest ("Equal strings produce equal hashes");
+        {
+            const auto text = String (CharPointer_UTF8 ("h\xc3\xa9llo, this is a longer string"));
+
+            expectEquals (DefaultFlatHashFunctions::generateHash (text),
+                          DefaultFlatHashFunctions::generateHash (StringRef (text)));
+            expectEquals (DefaultFlatHashFunctions::generateHash (text),
+                          DefaultFlatHashFunctions::generateHash (text.toRawUTF8()));
+            expect (DefaultFlatHashFunctions::generateHash (text)
+                      != DefaultFlatHashFunctions::generateHash (text.dropLastCharacters (1)));
+            expectEquals (DefaultFlatHashFunctions::generateHash ((int64) -5),
+                          DefaultFlatHashFunctions::generateHash (-5));
+        }
+
+        beginTest ("reserve() and rehash() control the number of slots");
+        {
+            FlatHashMap<int, int> map;
+            expectEquals (map.getNumSlots(), 0);
+
+            map.reserve (1000);
+            const auto numSlots = map.getNumSlots();
+            expect (isPowerOfTwo (numSlots));
+            expectGreaterOrEqual (numSlots, 1000);
+
+            for (int i = 0; i < 1000; ++i)
+                map.set (i, i);
+
+            expectEquals (map.getNumSlots(), numSlots);
+
+            map.set (1000, 1000);
+            map.set (1001, 1001);
+
+            for (int i = 0; i < 1000; ++i)
+                map.remove (i);
+
+            map.rehash (0);
+            expectEquals (map.getNumSlots(), 8);
+            expectEquals (map[1001], 1001);
+
+            map.rehash (100);
+            expectEquals (map.getNumSlots(), 128);
+            expectEquals (map[1000], 1000);
+
+            map.clear();
+            expectEquals (map.getNumSlots(), 128);
+            map.rehash (0);
+            expectEquals (map.getNumSlots(), 0);
+        }
+
+        beginTest ("removeIf() visits every item once");
+        {
+            FlatHashMap<int, int, CollidingHash> map;
+
+            for (int i = 0; i < 100; ++i)
+                map.set (i, 0);
+
+            const auto numRemoved = map.removeIf ([] (int key, int& numVisits)
+            {
+                ++numVisits;
+                return key % 3 == 0;
+            });
+
+            expectEquals (numRemoved, 34);
+            expectEquals (map.size(), 66);
+
+            for (auto item : map)
+            {
+                expect (item.key % 3 != 0);
+                expectEquals (item.value, 1);
+            }
+        }
+
+        beginTest ("Maps can be copied, moved and swapped");
+        {
+            FlatHashMap<String, String> a;
+
+            for (int i = 0; i < 50; ++i)
+                a.set (String (i), "value " + String (i));
+
+            auto b = a;
+            b.set ("extra", "value");
+            expectEquals (a.size(), 50);
+            expectEquals (b.size(), 51);
+            expectEquals (b["49"], String ("value 49"));
+
+            auto c = std::move (b);
+            expectEquals (c.size(), 51);
+
+            FlatHashMap<String, String> d;
+            d.set ("d", "d");
+            d.swapWith (c);
+            expectEquals (d.size(), 51);
+            expectEquals (c.size(), 1);
+            expectEquals (c["d"], String ("d"));
+
+            c = a;
+            expectEquals (c.size(), 50);
+            expect (! c.contains ("d"));
+        }
+
+        beginTest ("Values are constructed and destroyed correctly");
+        {
+            {
+                FlatHashMap<int, Counted> map;
+
+                for (int i = 0; i < 500; ++i)
+                    map.getReference (i);
+
+                expectEquals (Counted::numLive, 500);
+
+                for (int i = 0; i < 500; i += 2)
+                    map.remove (i);
+
+                expectEquals (Counted::numLive, 250);
+
+                auto copy = map;
+                expectEquals (Counted::numLive, 500);
+
+                map.clear();
+                expectEquals (Counted::numLive, 250);
+            }
+
+            expectEquals (Counted::numLive, 0);
+        }
+
+        beginTest ("FlatHashSet");
+        {
+            FlatHashSet<String> set;
+            expect (set.add ("one"));
+            expect (! set.add (StringRef ("one")));
+            expect (set.add (String ("two")));
+            expectEquals (set.size(), 2);
+
+            const auto& stored = set.findOrAdd (StringRef ("one"));
+            expect (stored.getCharPointer() == set.find ("one")->getCharPointer());
+            expectEquals (set.findOrAdd ("three"), String ("three"));
+            expectEquals (set.size(), 3);
+
+            StringArray keys;
+
+            for (auto& key : set)
+                keys.add (key);
+
+            keys.sort (false);
+            expectEquals (keys.joinIntoString (","), String ("one,three,two"));
+
+            expectEquals (set.removeIf ([] (const String& s) { return s.startsWith ("t"); }), 2);
+            expect (set.remove ("one"));
+            expect (set.isEmpty());
+            expect (set.find ("one") == nullptr);
+        }
+
+        beginTest ("StringPool returns shared strings");
+        {
+            StringPool pool;
+            const String text ("pooled");
+
+            const auto a = pool.getPooledString (text);
+            const auto b = pool.getPooledString ("pooled");
+            const auto c = pool.getPooledString (StringRef (text));
+            const auto d = pool.getPooledString (text.getCharPointer(), text.getCharPointer() + 6);
+            const auto e = pool.getPooledString (text.getCharPointer(), text.getCharPointer() + 4);
+
+            expect (a.getCharPointer() == b.getCharPointer());
+            expect (a.getCharPointer() == c.getCharPointer());
+            expect (a.getCharPointer() == d.getCharPointer());
+            expectEquals (e, String ("pool"));
+            expect (a.getCharPointer() != e.getCharPointer());
+            expect (pool.getPooledString (String()).isEmpty());
+
+            for (int i = 0; i < 1000; ++i)
+                pool.getPooledString (String (i));
+
+            pool.garbageCollect();
+            expect (pool.getPooledString ("pooled").getCharPointer() == a.getCharPointer());
+
+            expect (Identifier ("pooled") == Identifier (text));
+        }
+    }
+
+private:
+    struct CollidingHash
+    {
+        static uint64 generateHash (int key) noexcept      { return (uint64) (key % 5) + 3; }
+    };
+
+    struct Counted
+    {
+        Counted()                   { ++numLive; }
+        Counted (const Counted&)    { ++numLive; }
+        Counted (Counted&&)         { ++numLive; }
+        ~Counted()                  { --numLive; }
+
+        Counted& operator= (const Counted&) = default;
+        Counted& operator= (Counted&&) = default;
+
+        static inline int numLive = 0;
+    };
+
+    template <typename KeyType, typename HashFunctionType, typename KeyFn>
+    void checkRandomOperations (Random& random, KeyFn&& createKey)
+    {
+        FlatHashMap<KeyType, int, HashFunctionType> map;
+        std::map<KeyType, int> expected;
+
+        for (int i = 0; i < 10000; ++i)
+        {
+            const KeyType key = createKey (random);
+            const auto value = random.nextInt();
+
+            switch (random.nextInt (4))
+            {
+                case 0:
+                case 1:
+                    map.set (key, value);
+                    expected[key] = value;
+                    break;
+
+                case 2:
+                    expect (map.remove (key) == (expected.erase (key) != 0));
+                    break;
+
+                case 3:
+                    map.getReference (key) += value;
+                    expected[key] += value;
+                    break;
+
+                default:
+                    jassertfalse;
+                    break;
+            }
+
+            expectEquals (map.size(), (int) expected.size());
+            expect (map.contains (key) == (expected.count (key) != 0));
+        }
+
+        for (const auto& [key, value] : expected)
+        {
+            if (auto* found = map.find (key))
+                expectEquals (*found, value);
+            else
+                expect (false, "missing key");
+        }
+
+        int numIterated = 0;
+
+        for (auto item : map)
+        {
+            expectEquals (item.value, expected[item.key]);
+            ++numIterated;
+        }
+
+        expectEquals (numIterated, (int) expected.size());
+    }
+};
+
+static FlatHashMapTests flatHashMapTests;
+
+} // namespace juce
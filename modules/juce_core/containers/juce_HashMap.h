@@ -103,8 +103,11 @@ struct DefaultHashFunctions
         DBG (i.getKey() << " -> " << i.getValue());
     @endcode
 
+    Each item is allocated separately, so for large maps, or maps that are searched
+    frequently, a FlatHashMap will usually be faster.
+
     @tparam HashFunctionType The class of hash function, which must be copy-constructible.
-    @see CriticalSection, DefaultHashFunctions, NamedValueSet, SortedSet
+    @see CriticalSection, DefaultHashFunctions, FlatHashMap, NamedValueSet, SortedSet
 
     @tags{Core}
 */
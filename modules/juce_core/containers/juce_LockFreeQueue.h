@@ -0,0 +1,482 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#ifndef DOXYGEN
+namespace detail
+{
+    /*  Indices that are written by different threads are kept at least this far apart,
+        so that they don't end up sharing a cache line.
+    */
+    constexpr size_t lockFreeQueueCacheLineSize = 64;
+
+    /*  Uninitialised storage for the elements of a queue. */
+    template <typename Type, typename Slot>
+    class LockFreeQueueStorage
+    {
+    public:
+        explicit LockFreeQueueStorage (int minCapacity)
+            : capacity ((size_t) nextPowerOfTwo (jmax (1, minCapacity))),
+              slots (new Slot[capacity])
+        {}
+
+        Slot& getSlot (size_t index) const noexcept        { return slots[index & (capacity - 1)]; }
+
+        template <typename... Args>
+        static void construct (Slot& slot, Args&&... args)
+        {
+            new (slot.storage) Type (std::forward<Args> (args)...);
+        }
+
+        static void moveOut (Slot& slot, Type& destination) noexcept
+        {
+            auto* item = std::launder (reinterpret_cast<Type*> (slot.storage));
+            destination = std::move (*item);
+            item->~Type();
+        }
+
+        static void destroy (Slot& slot) noexcept
+        {
+            std::launder (reinterpret_cast<Type*> (slot.storage))->~Type();
+        }
+
+        const size_t capacity;
+
+    private:
+        std::unique_ptr<Slot[]> slots;
+    };
+
+    template <typename Type>
+    struct PlainQueueSlot
+    {
+        alignas (Type) std::byte storage[sizeof (Type)];
+    };
+
+    template <typename Type>
+    struct SequencedQueueSlot
+    {
+        std::atomic<size_t> sequence { 0 };
+        alignas (Type) std::byte storage[sizeof (Type)];
+    };
+} // namespace detail
+#endif
+
+//==============================================================================
+/**
+    A bounded, typed, lock-free FIFO queue for passing objects from one thread to
+    another.
+
+    Exactly one thread may push items into the queue, and exactly one (other)
+    thread may pop items from it. Both sides are wait-free, and the queue never
+    allocates after it has been constructed, so it's suitable for use on the
+    audio thread.
+
+    Unlike AbstractFifo, which only hands out index ranges, this class owns the
+    storage for its items, and constructs and destroys them itself. Items can be
+    pushed and popped one at a time, or in batches using a Span, which only needs
+    to synchronise with the other thread once for the whole batch.
+
+    The capacity will be rounded up to the next power of two. The Type must be
+    nothrow-move-constructible and nothrow-move-assignable, and the constructors
+    used to push items must not throw.
+
+    @see MPSCQueue, MPMCQueue, AbstractFifo
+
+    @tags{Core}
+*/
+template <typename Type>
+class SPSCQueue
+{
+public:
+    static_assert (std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_move_assignable_v<Type>,
+                   "Queue items must be nothrow-movable");
+
+    /** Creates a queue that can hold at least minCapacity items. */
+    explicit SPSCQueue (int minCapacity)
+        : storage (minCapacity)
+    {}
+
+    /** Destructor. Any items left in the queue will be destroyed. */
+    ~SPSCQueue()
+    {
+        for (auto i = readIndex.load(); i != writeIndex.load(); ++i)
+            Storage::destroy (storage.getSlot (i));
+    }
+
+    //==============================================================================
+    /** Constructs a new item at the back of the queue, returning false if the queue
+        was full. This must only be called by the producer thread.
+    */
+    template <typename... Args>
+    bool emplace (Args&&... args)
+    {
+        const auto write = writeIndex.load (std::memory_order_relaxed);
+
+        if (getFreeSpaceForProducer (write, 1) == 0)
+            return false;
+
+        Storage::construct (storage.getSlot (write), std::forward<Args> (args)...);
+        writeIndex.store (write + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Copies an item to the back of the queue, returning false if the queue was full.
+        This must only be called by the producer thread.
+    */
+    bool push (const Type& item)                    { return emplace (item); }
+
+    /** Moves an item to the back of the queue, returning false if the queue was full.
+        This must only be called by the producer thread.
+    */
+    bool push (Type&& item)                         { return emplace (std::move (item)); }
+
+    /** Copies as many of the given items as will fit to the back of the queue, and
+        returns the number that were pushed. This must only be called by the producer
+        thread.
+    */
+    size_t push (Span<const Type> items)
+    {
+        const auto write = writeIndex.load (std::memory_order_relaxed);
+        const auto numToPush = jmin (items.size(), getFreeSpaceForProducer (write, items.size()));
+
+        for (size_t i = 0; i < numToPush; ++i)
+            Storage::construct (storage.getSlot (write + i), items[i]);
+
+        writeIndex.store (write + numToPush, std::memory_order_release);
+        return numToPush;
+    }
+
+    /** Moves the item at the front of the queue into result, returning false if the
+        queue was empty. This must only be called by the consumer thread.
+    */
+    bool pop (Type& result) noexcept
+    {
+        const auto read = readIndex.load (std::memory_order_relaxed);
+
+        if (getNumReadyForConsumer (read, 1) == 0)
+            return false;
+
+        Storage::moveOut (storage.getSlot (read), result);
+        readIndex.store (read + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Moves as many items as are available, up to the size of the destination, from
+        the front of the queue, and returns the number that were popped. This must only
+        be called by the consumer thread.
+    */
+    size_t pop (Span<Type> destination) noexcept
+    {
+        const auto read = readIndex.load (std::memory_order_relaxed);
+        const auto numToPop = jmin (destination.size(), getNumReadyForConsumer (read, destination.size()));
+
+        for (size_t i = 0; i < numToPop; ++i)
+            Storage::moveOut (storage.getSlot (read + i), destination[i]);
+
+        readIndex.store (read + numToPop, std::memory_order_release);
+        return numToPop;
+    }
+
+    //==============================================================================
+    /** Returns the number of items in the queue.
+        If the queue is in use on other threads, this is only a snapshot.
+    */
+    size_t getNumReady() const noexcept     { return writeIndex.load() - readIndex.load(); }
+
+    /** Returns the number of items that could be pushed.
+        If the queue is in use on other threads, this is only a snapshot.
+    */
+    size_t getFreeSpace() const noexcept    { return getCapacity() - getNumReady(); }
+
+    /** Returns the maximum number of items that the queue can hold. */
+    size_t getCapacity() const noexcept     { return storage.capacity; }
+
+private:
+    //==============================================================================
+    using Storage = detail::LockFreeQueueStorage<Type, detail::PlainQueueSlot<Type>>;
+
+    // Each side keeps a copy of the other side's index, and only reloads it (which is
+    // relatively expensive, as the other thread will be writing to it) when the copy
+    // suggests that there isn't enough room or data.
+    size_t getFreeSpaceForProducer (size_t write, size_t numWanted) noexcept
+    {
+        if (getCapacity() - (write - cachedReadIndex) < numWanted)
+            cachedReadIndex = readIndex.load (std::memory_order_acquire);
+
+        return getCapacity() - (write - cachedReadIndex);
+    }
+
+    size_t getNumReadyForConsumer (size_t read, size_t numWanted) noexcept
+    {
+        if (cachedWriteIndex - read < numWanted)
+            cachedWriteIndex = writeIndex.load (std::memory_order_acquire);
+
+        return cachedWriteIndex - read;
+    }
+
+    Storage storage;
+
+    alignas (detail::lockFreeQueueCacheLineSize) std::atomic<size_t> writeIndex { 0 };
+    size_t cachedReadIndex = 0;
+
+    alignas (detail::lockFreeQueueCacheLineSize) std::atomic<size_t> readIndex { 0 };
+    size_t cachedWriteIndex = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (SPSCQueue)
+};
+
+//==============================================================================
+/**
+    A bounded, typed, lock-free FIFO queue which may be pushed to from several
+    threads at once.
+
+    If allowMultipleConsumers is true, items may also be popped from several
+    threads at once. Otherwise only a single thread may pop from the queue, which
+    makes popping a little cheaper. You'll normally want to use one of the aliases
+    MPMCQueue or MPSCQueue rather than using this class directly.
+
+    The queue never allocates or blocks after it has been constructed, so it's
+    suitable for use on the audio thread. Items are stored in slots that each
+    carry a sequence number, so a thread only has to claim its place in the
+    queue with a single compare-and-swap, after which it can construct or move
+    its item without any further contention. The batched push() and pop()
+    functions claim a whole range of slots at once.
+
+    Note that a thread that is pre-empted after claiming a slot, but before it
+    has finished constructing or moving the item, will hold up threads on the
+    other side of the queue that are waiting for that particular slot. This is
+    true of all queues of this kind.
+
+    The capacity will be rounded up to the next power of two. The Type must be
+    nothrow-move-constructible and nothrow-move-assignable, and the constructors
+    used to push items must not throw.
+
+    @see SPSCQueue, MPMCQueue, MPSCQueue
+
+    @tags{Core}
+*/
+template <typename Type, bool allowMultipleConsumers>
+class MultiProducerQueue
+{
+public:
+    static_assert (std::is_nothrow_move_constructible_v<Type> && std::is_nothrow_move_assignable_v<Type>,
+                   "Queue items must be nothrow-movable");
+
+    /** Creates a queue that can hold at least minCapacity items.
+
+        The capacity is always at least two, because with a single slot the sequence
+        numbers can't distinguish a full queue from an empty one.
+    */
+    explicit MultiProducerQueue (int minCapacity)
+        : storage (jmax (2, minCapacity))
+    {
+        for (size_t i = 0; i < storage.capacity; ++i)
+            storage.getSlot (i).sequence.store (i, std::memory_order_relaxed);
+    }
+
+    /** Destructor. Any items left in the queue will be destroyed. */
+    ~MultiProducerQueue()
+    {
+        for (auto i = readIndex.load(); i != writeIndex.load(); ++i)
+            Storage::destroy (storage.getSlot (i));
+    }
+
+    //==============================================================================
+    /** Constructs a new item at the back of the queue, returning false if the queue
+        was full.
+    */
+    template <typename... Args>
+    bool emplace (Args&&... args)
+    {
+        const auto write = claim (writeIndex, 1, 0);
+
+        if (write.second == 0)
+            return false;
+
+        auto& slot = storage.getSlot (write.first);
+        Storage::construct (slot, std::forward<Args> (args)...);
+        slot.sequence.store (write.first + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Copies an item to the back of the queue, returning false if the queue was full. */
+    bool push (const Type& item)                    { return emplace (item); }
+
+    /** Moves an item to the back of the queue, returning false if the queue was full. */
+    bool push (Type&& item)                         { return emplace (std::move (item)); }
+
+    /** Copies as many of the given items as will fit to the back of the queue, and
+        returns the number that were pushed. The items will be adjacent in the queue,
+        even if other threads are pushing at the same time.
+    */
+    size_t push (Span<const Type> items)
+    {
+        const auto write = claim (writeIndex, items.size(), 0);
+
+        for (size_t i = 0; i < write.second; ++i)
+        {
+            auto& slot = storage.getSlot (write.first + i);
+            Storage::construct (slot, items[i]);
+            slot.sequence.store (write.first + i + 1, std::memory_order_release);
+        }
+
+        return write.second;
+    }
+
+    /** Moves the item at the front of the queue into result, returning false if the
+        queue was empty.
+    */
+    bool pop (Type& result) noexcept
+    {
+        return pop (Span<Type> (&result, 1)) != 0;
+    }
+
+    /** Moves as many items as are available, up to the size of the destination, from
+        the front of the queue, and returns the number that were popped.
+    */
+    size_t pop (Span<Type> destination) noexcept
+    {
+        const auto read = claim (readIndex, destination.size(), 1);
+
+        for (size_t i = 0; i < read.second; ++i)
+        {
+            auto& slot = storage.getSlot (read.first + i);
+            Storage::moveOut (slot, destination[i]);
+            slot.sequence.store (read.first + i + storage.capacity, std::memory_order_release);
+        }
+
+        return read.second;
+    }
+
+    //==============================================================================
+    /** Returns the number of items in the queue.
+        If the queue is in use on other threads, this is only a snapshot.
+    */
+    size_t getNumReady() const noexcept
+    {
+        const auto read = readIndex.load();
+        const auto write = writeIndex.load();
+        return write > read ? jmin (write - read, getCapacity()) : 0;
+    }
+
+    /** Returns the number of items that could be pushed.
+        If the queue is in use on other threads, this is only a snapshot.
+    */
+    size_t getFreeSpace() const noexcept    { return getCapacity() - getNumReady(); }
+
+    /** Returns the maximum number of items that the queue can hold. */
+    size_t getCapacity() const noexcept     { return storage.capacity; }
+
+private:
+    //==============================================================================
+    using Storage = detail::LockFreeQueueStorage<Type, detail::SequencedQueueSlot<Type>>;
+
+    /*  A slot is ready to be written at index i when its sequence number is i, and ready
+        to be read when its sequence number is i + 1. This finds up to maxNum consecutive
+        ready slots starting at the current index, and claims them by advancing the index.
+        Returns the first claimed index and the number of slots claimed.
+    */
+    std::pair<size_t, size_t> claim (std::atomic<size_t>& index, size_t maxNum, size_t readyOffset) noexcept
+    {
+        const auto isShared = readyOffset == 0 || allowMultipleConsumers;
+        auto start = index.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            size_t num = 0;
+
+            while (num < maxNum
+                   && storage.getSlot (start + num).sequence.load (std::memory_order_acquire) == start + num + readyOffset)
+            {
+                ++num;
+            }
+
+            if (num == 0)
+            {
+                if (maxNum == 0)
+                    return { start, 0 };
+
+                const auto sequence = storage.getSlot (start).sequence.load (std::memory_order_acquire);
+
+                // The slot hasn't been released by the other side yet, so the queue is full or empty
+                if ((std::ptrdiff_t) (sequence - (start + readyOffset)) < 0)
+                    return { start, 0 };
+
+                // Another thread has claimed this slot, so try again from the new position
+                start = index.load (std::memory_order_relaxed);
+                continue;
+            }
+
+            if (! isShared)
+            {
+                index.store (start + num, std::memory_order_relaxed);
+                return { start, num };
+            }
+
+            if (index.compare_exchange_weak (start, start + num, std::memory_order_relaxed))
+                return { start, num };
+        }
+    }
+
+    Storage storage;
+
+    alignas (detail::lockFreeQueueCacheLineSize) std::atomic<size_t> writeIndex { 0 };
+    alignas (detail::lockFreeQueueCacheLineSize) std::atomic<size_t> readIndex { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (MultiProducerQueue)
+};
+
+/** A bounded, lock-free queue which may be pushed to and popped from by any number
+    of threads at once.
+
+    @see MultiProducerQueue, SPSCQueue
+
+    @tags{Core}
+*/
+template <typename Type>
+using MPMCQueue = MultiProducerQueue<Type, true>;
+
+/** A bounded, lock-free queue which may be pushed to by any number of threads at
+    once, but only popped from by a single thread.
+
+    @see MultiProducerQueue, SPSCQueue
+
+    @tags{Core}
+*/
+template <typename Type>
+using MPSCQueue = MultiProducerQueue<Type, false>;
+
+} // namespace juce
@@ -0,0 +1,255 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class LockFreeQueueTests final : public UnitTest
+{
+public:
+    LockFreeQueueTests()
+        : UnitTest ("Lock-free Queue", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        runTestsForQueue<SPSCQueue> ("SPSCQueue", 1, 1);
+        runTestsForQueue<MPSCQueue> ("MPSCQueue", 4, 1);
+        runTestsForQueue<MPMCQueue> ("MPMCQueue", 4, 4);
+    }
+
+private:
+    //==============================================================================
+    template <template <typename> class Queue>
+    void runTestsForQueue (const String& queueName, int numProducers, int numConsumers)
+    {
+        beginTest (queueName + ": capacity is rounded up to a power of two");
+        {
+            expect (Queue<int> (1).getCapacity() == (numProducers > 1 ? 2 : 1));
+            expect (Queue<int> (5).getCapacity() == 8);
+            expect (Queue<int> (64).getCapacity() == 64);
+        }
+
+        beginTest (queueName + ": a queue created with a capacity of one doesn't overwrite unread items");
+        {
+            Queue<int> queue (1);
+            const auto capacity = (int) queue.getCapacity();
+            int result = 0;
+
+            for (int i = 0; i < capacity; ++i)
+                expect (queue.push (i));
+
+            expect (! queue.push (capacity));
+
+            for (int i = 0; i < capacity; ++i)
+            {
+                expect (queue.pop (result));
+                expect (result == i);
+            }
+
+            expect (! queue.pop (result));
+        }
+
+        beginTest (queueName + ": items are popped in the order in which they were pushed");
+        {
+            Queue<int> queue (16);
+            int result = 0;
+
+            expect (! queue.pop (result));
+
+            for (int i = 0; i < 16; ++i)
+                expect (queue.push (i));
+
+            expect (! queue.push (16));
+            expect (queue.getNumReady() == 16);
+            expect (queue.getFreeSpace() == 0);
+
+            for (int i = 0; i < 16; ++i)
+            {
+                expect (queue.pop (result));
+                expect (result == i);
+            }
+
+            expect (! queue.pop (result));
+            expect (queue.getNumReady() == 0);
+        }
+
+        beginTest (queueName + ": batched pushes and pops behave like a deque");
+        {
+            Queue<int> queue (32);
+            std::deque<int> reference;
+            std::vector<int> items, popped (40);
+            auto random = getRandom();
+            auto next = 0;
+
+            for (int iteration = 0; iteration < 1000; ++iteration)
+            {
+                items.resize ((size_t) random.nextInt (40));
+                std::iota (items.begin(), items.end(), next);
+
+                const auto numPushed = queue.push (Span<const int> (items));
+                expect (numPushed == jmin (items.size(), (size_t) 32 - reference.size()));
+                reference.insert (reference.end(), items.begin(), items.begin() + (std::ptrdiff_t) numPushed);
+                next += (int) numPushed;
+
+                const auto numPopped = queue.pop (Span<int> (popped.data(), (size_t) random.nextInt (40)));
+                expect (numPopped <= reference.size());
+
+                for (size_t i = 0; i < numPopped; ++i)
+                {
+                    expect (popped[i] == reference.front());
+                    reference.pop_front();
+                }
+
+                expect (queue.getNumReady() == reference.size());
+            }
+        }
+
+        beginTest (queueName + ": items are destroyed");
+        {
+            auto item = std::make_shared<int> (0);
+
+            {
+                Queue<std::shared_ptr<int>> queue (8);
+
+                for (int i = 0; i < 5; ++i)
+                    queue.push (item);
+
+                expect (item.use_count() == 6);
+
+                std::shared_ptr<int> result;
+                expect (queue.pop (result));
+                expect (result == item);
+                result = nullptr;
+                expect (item.use_count() == 5);
+
+                std::vector<std::shared_ptr<int>> batch (2);
+                expect (queue.pop (Span<std::shared_ptr<int>> (batch)) == 2);
+                batch.clear();
+                expect (item.use_count() == 3);
+            }
+
+            expect (item.use_count() == 1);
+        }
+
+        beginTest (queueName + ": items are passed between threads without being lost or reordered");
+        {
+            testConcurrentAccess<Queue> (numProducers, numConsumers);
+        }
+    }
+
+    /*  Each producer pushes an increasing sequence of numbers, tagged with its index. Every
+        consumer must see each producer's numbers in increasing order, and between them the
+        consumers must see every number exactly once.
+    */
+    template <template <typename> class Queue>
+    void testConcurrentAccess (int numProducers, int numConsumers)
+    {
+        constexpr int64 itemsPerProducer = 100000;
+        constexpr int64 producerShift = 32;
+
+        Queue<int64> queue (256);
+        std::atomic<int64> totalPopped { 0 };
+        std::atomic<bool> orderingFailed { false };
+        std::vector<int64> sums ((size_t) numConsumers, 0);
+        std::vector<std::thread> threads;
+
+        for (int producer = 0; producer < numProducers; ++producer)
+        {
+            threads.emplace_back ([&queue, producer]
+            {
+                std::vector<int64> batch;
+                int64 next = 0;
+                Random random (producer);
+
+                while (next < itemsPerProducer)
+                {
+                    batch.clear();
+
+                    for (auto n = random.nextInt (8); n >= 0 && next + (int64) batch.size() < itemsPerProducer; --n)
+                        batch.push_back (((int64) producer << producerShift) + next + (int64) batch.size());
+
+                    next += (int64) queue.push (Span<const int64> (batch));
+
+                    if (batch.size() > 0 && queue.getFreeSpace() == 0)
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        for (int consumer = 0; consumer < numConsumers; ++consumer)
+        {
+            threads.emplace_back ([&, consumer]
+            {
+                std::vector<int64> lastSeen ((size_t) numProducers, -1);
+                std::array<int64, 8> batch;
+                const auto totalItems = itemsPerProducer * numProducers;
+
+                while (totalPopped.load() < totalItems)
+                {
+                    const auto numPopped = queue.pop (Span<int64> (batch));
+
+                    for (size_t i = 0; i < numPopped; ++i)
+                    {
+                        const auto producer = (size_t) (batch[i] >> producerShift);
+                        const auto value = batch[i] & ((1ll << producerShift) - 1);
+
+                        if (value <= lastSeen[producer])
+                            orderingFailed = true;
+
+                        lastSeen[producer] = value;
+                        sums[(size_t) consumer] += value;
+                    }
+
+                    totalPopped += (int64) numPopped;
+
+                    if (numPopped == 0)
+                        std::this_thread::yield();
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+            thread.join();
+
+        expect (! orderingFailed);
+        expect (totalPopped == itemsPerProducer * numProducers);
+        expect (std::accumulate (sums.begin(), sums.end(), (int64) 0) == numProducers * (itemsPerProducer * (itemsPerProducer - 1) / 2));
+        expect (queue.getNumReady() == 0);
+    }
+};
+
+static LockFreeQueueTests lockFreeQueueTests;
+
+} // namespace juce
@@ -67,35 +67,56 @@ bool NamedValueSet::NamedValue::operator== (const NamedValue& other) const noexc
 bool NamedValueSet::NamedValue::operator!= (const NamedValue& other) const noexcept   { return ! operator== (other); }
 
 //==============================================================================
+/*  Sets larger than this also keep an index from each name to the position of its
+    value. Below it, a linear search of the names is just as fast.
+*/
+static constexpr int minNumValuesForIndex = 32;
+
+// Identifiers are pooled, so the address of a name's text identifies it uniquely
+static const void* getIndexKey (const Identifier& name) noexcept    { return name.getCharPointer().getAddress(); }
+
 NamedValueSet::NamedValueSet() noexcept {}
 NamedValueSet::~NamedValueSet() noexcept {}
 
-NamedValueSet::NamedValueSet (const NamedValueSet& other)  : values (other.values) {}
+NamedValueSet::NamedValueSet (const NamedValueSet& other)
+   : values (other.values),
+     nameIndex (other.nameIndex != nullptr ? std::make_unique<Index> (*other.nameIndex) : nullptr)
+{}
 
 NamedValueSet::NamedValueSet (NamedValueSet&& other) noexcept
-   : values (std::move (other.values)) {}
+   : values (std::move (other.values)),
+     nameIndex (std::move (other.nameIndex))
+{}
 
 NamedValueSet::NamedValueSet (std::initializer_list<NamedValue> list)
    : values (std::move (list))
 {
+    if (values.size() > minNumValuesForIndex)
+        rebuildIndex();
 }
 
 NamedValueSet& NamedValueSet::operator= (const NamedValueSet& other)
 {
     clear();
     values = other.values;
+
+    if (other.nameIndex != nullptr)
+        nameIndex = std::make_unique<Index> (*other.nameIndex);
+
     return *this;
 }
 
 NamedValueSet& NamedValueSet::operator= (NamedValueSet&& other) noexcept
 {
     other.values.swapWith (values);
+    std::swap (other.nameIndex, nameIndex);
     return *this;
 }
 
 void NamedValueSet::clear()
 {
     values.clear();
+    nameIndex.reset();
 }
 
 bool NamedValueSet::operator== (const NamedValueSet& other) const noexcept
@@ -161,15 +182,17 @@ var NamedValueSet::getWithDefault (const Identifier& name, const var& defaultRet
 
 var* NamedValueSet::getVarPointer (const Identifier& name) noexcept
 {
-    for (auto& i : values)
-        if (i.name == name)
-            return &(i.value);
-
-    return {};
+    return const_cast<var*> (std::as_const (*this).getVarPointer (name));
 }
 
 const var* NamedValueSet::getVarPointer (const Identifier& name) const noexcept
 {
+    if (nameIndex != nullptr)
+    {
+        auto* i = nameIndex->find (getIndexKey (name));
+        return i != nullptr ? &(values.getReference (*i).value) : nullptr;
+    }
+
     for (auto& i : values)
         if (i.name == name)
             return &(i.value);
@@ -188,7 +211,7 @@ bool NamedValueSet::set (const Identifier& name, var&& newValue)
         return true;
     }
 
-    values.add ({ name, std::move (newValue) });
+    addValue ({ name, std::move (newValue) });
     return true;
 }
 
@@ -203,7 +226,7 @@ bool NamedValueSet::set (const Identifier& name, const var& newValue)
         return true;
     }
 
-    values.add ({ name, newValue });
+    addValue ({ name, newValue });
     return true;
 }
 
@@ -214,6 +237,12 @@ bool NamedValueSet::contains (const Identifier& name) const noexcept
 
 int NamedValueSet::indexOf (const Identifier& name) const noexcept
 {
+    if (nameIndex != nullptr)
+    {
+        auto* i = nameIndex->find (getIndexKey (name));
+        return i != nullptr ? *i : -1;
+    }
+
     auto numValues = values.size();
 
     for (int i = 0; i < numValues; ++i)
@@ -225,18 +254,75 @@ int NamedValueSet::indexOf (const Identifier& name) const noexcept
 
 bool NamedValueSet::remove (const Identifier& name)
 {
-    auto numValues = values.size();
+    auto i = indexOf (name);
 
-    for (int i = 0; i < numValues; ++i)
+    if (i < 0)
+        return false;
+
+    values.remove (i);
+
+    if (nameIndex != nullptr)
+        updateIndexAfterRemoving (name, i);
+
+    return true;
+}
+
+void NamedValueSet::addValue (NamedValue&& newValue)
+{
+    values.add (std::move (newValue));
+
+    if (nameIndex != nullptr)
+        nameIndex->set (getIndexKey (values.getLast().name), values.size() - 1);
+    else if (values.size() > minNumValuesForIndex)
+        rebuildIndex();
+}
+
+void NamedValueSet::updateIndexAfterRemoving (const Identifier& removedName, int removedIndex)
+{
+    // Only drop the index once the set has shrunk well below the size at which it was
+    // built, so that a set that hovers around that size doesn't keep rebuilding it.
+    if (values.size() <= minNumValuesForIndex / 2)
     {
-        if (values.getReference (i).name == name)
+        nameIndex.reset();
+        return;
+    }
+
+    nameIndex->remove (getIndexKey (removedName));
+
+    for (int i = removedIndex; i < values.size(); ++i)
+    {
+        auto key = getIndexKey (values.getReference (i).name);
+
+        if (auto* position = nameIndex->find (key))
         {
-            values.remove (i);
-            return true;
+            if (*position == i + 1)
+                *position = i;
+        }
+        else
+        {
+            // A duplicate of the removed name, which is now the first one in the set
+            nameIndex->set (key, i);
         }
     }
+}
+
+void NamedValueSet::rebuildIndex()
+{
+    if (nameIndex == nullptr)
+        nameIndex = std::make_unique<Index>();
+    else
+        nameIndex->clear();
+
+    nameIndex->reserve (values.size());
+
+    for (int i = 0; i < values.size(); ++i)
+    {
+        auto key = getIndexKey (values.getReference (i).name);
 
-    return false;
+        // If a set contains duplicate names, lookups return the first
+        if (! nameIndex->contains (key))
+            nameIndex->set (key, i);
+    }
 }
 
 Identifier NamedValueSet::getName (const int index) const noexcept
@@ -276,6 +362,7 @@ const var* NamedValueSet::getVarPointerAt (int index) const noexcept
 void NamedValueSet::setFromXmlAttributes (const XmlElement& xml)
 {
     values.clearQuick();
+    nameIndex.reset();
 
     for (auto* att = xml.attributes.get(); att != nullptr; att = att->nextListItem)
     {
@@ -292,6 +379,9 @@ void NamedValueSet::setFromXmlAttributes (const XmlElement& xml)
 
         values.add ({ att->name, var (att->value) });
     }
+
+    if (values.size() > minNumValuesForIndex)
+        rebuildIndex();
 }
 
 void NamedValueSet::copyToXmlAttributes (XmlElement& xml) const
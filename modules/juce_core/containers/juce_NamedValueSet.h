@@ -41,6 +41,11 @@ namespace juce
     This can be used as a basic structure to hold a set of var object, which can
     be retrieved by using their identifier.
 
+    The values are kept in the order in which they were added. Small sets are
+    searched linearly, but once a set grows beyond a few dozen values it also keeps
+    a hashed index of their names, so looking up a value stays fast however many
+    there are.
+
     @tags{Core}
 */
 class JUCE_API  NamedValueSet
@@ -191,7 +196,14 @@ public:
 
 private:
     //==============================================================================
+    using Index = FlatHashMap<const void*, int>;
+
     Array<NamedValue> values;
+    std::unique_ptr<Index> nameIndex;
+
+    void addValue (NamedValue&&);
+    void updateIndexAfterRemoving (const Identifier&, int);
+    void rebuildIndex();
 };
 
 } // namespace juce
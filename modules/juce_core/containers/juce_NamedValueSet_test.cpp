@@ -0,0 +1,245 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class NamedValueSetTests final : public UnitTest
+{
+public:
+    NamedValueSetTests()
+        : UnitTest ("NamedValueSet", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest ("Random operations on small and large sets match a linear search");
+        {
+            for (auto numNames : { 8, 40, 400 })
+                checkRandomOperations (random, numNames);
+        }
+
+        beginTest ("Values are kept in the order they were added");
+        {
+            NamedValueSet set;
+
+            for (int i = 0; i < 100; ++i)
+                set.set (getName (i), i);
+
+            set.remove (getName (10));
+            set.remove (getName (50));
+            set.set (getName (10), 10);
+
+            expectEquals (set.size(), 99);
+            expectEquals (set.indexOf (getName (0)), 0);
+            expectEquals (set.indexOf (getName (11)), 10);
+            expectEquals (set.indexOf (getName (51)), 49);
+            expectEquals (set.indexOf (getName (10)), 98);
+            expectEquals (set.indexOf (getName (50)), -1);
+            expect (set.getName (98) == getName (10));
+        }
+
+        beginTest ("Sets can shrink and grow past the size at which they are indexed");
+        {
+            NamedValueSet set;
+
+            for (int round = 0; round < 3; ++round)
+            {
+                for (int i = 0; i < 100; ++i)
+                    set.set (getName (i), i + round);
+
+                for (int i = 0; i < 95; ++i)
+                    expect (set.remove (getName (i)));
+
+                for (int i = 95; i < 100; ++i)
+                    expectEquals ((int) set[getName (i)], i + round);
+
+                expectEquals (set.size(), 5);
+            }
+        }
+
+        beginTest ("The first of any duplicate names is found");
+        {
+            // Reading a binary attribute called "base64:x" adds a value called "x", so this
+            // is one of the ways a set can end up with duplicate names.
+            XmlElement xml ("TEST");
+
+            for (int i = 0; i < 50; ++i)
+                xml.setAttribute (getName (i), i);
+
+            xml.setAttribute ("base64:" + getName (3).toString(), MemoryBlock ("abc", 3).toBase64Encoding());
+
+            NamedValueSet set;
+            set.setFromXmlAttributes (xml);
+
+            expectEquals (set.size(), 51);
+            expectEquals ((int) set[getName (3)], 3);
+            expectEquals (set.indexOf (getName (7)), 7);
+
+            expect (set.remove (getName (3)));
+            expect (set[getName (3)].isBinaryData());
+            expectEquals (set.indexOf (getName (3)), 49);
+            expectEquals (set.indexOf (getName (7)), 6);
+
+            expect (set.remove (getName (0)));
+            expectEquals (set.indexOf (getName (3)), 48);
+            expectEquals (set.indexOf (getName (49)), 47);
+        }
+
+        beginTest ("Copies and moved sets can still be searched");
+        {
+            NamedValueSet original;
+
+            for (int i = 0; i < 100; ++i)
+                original.set (getName (i), String (i));
+
+            NamedValueSet copy (original);
+            expect (copy == original);
+            copy.set (getName (100), "extra");
+            expect (copy != original);
+            expectEquals (copy[getName (99)].toString(), String ("99"));
+
+            NamedValueSet assigned;
+            assigned.set (getName (0), "replaced");
+            assigned = original;
+            expect (assigned == original);
+            expectEquals (assigned.indexOf (getName (42)), 42);
+
+            NamedValueSet moved (std::move (copy));
+            expectEquals (moved[getName (100)].toString(), String ("extra"));
+
+            NamedValueSet moveAssigned;
+            moveAssigned = std::move (moved);
+            expectEquals (moveAssigned.indexOf (getName (100)), 100);
+
+            NamedValueSet reversed;
+
+            for (int i = 100; --i >= 0;)
+                reversed.set (getName (i), String (i));
+
+            expect (reversed == original);
+        }
+
+        beginTest ("Large sets can be read from XML attributes");
+        {
+            XmlElement xml ("TEST");
+
+            for (int i = 0; i < 100; ++i)
+                xml.setAttribute (getName (i), i);
+
+            NamedValueSet set;
+            set.set ("unrelated", 1);
+            set.setFromXmlAttributes (xml);
+
+            expectEquals (set.size(), 100);
+            expect (! set.contains ("unrelated"));
+            expectEquals ((int) set[getName (64)], 64);
+            expectEquals (set.indexOf (getName (99)), 99);
+        }
+    }
+
+private:
+    static Identifier getName (int i)
+    {
+        return "name" + String (i);
+    }
+
+    void checkRandomOperations (Random& random, int numNames)
+    {
+        NamedValueSet set;
+        std::vector<std::pair<Identifier, int>> expected;
+
+        const auto find = [&] (const Identifier& id)
+        {
+            return std::find_if (expected.begin(), expected.end(), [&] (const auto& p) { return p.first == id; });
+        };
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            const auto id = getName (random.nextInt (numNames));
+            const auto value = random.nextInt (10);
+            const auto existing = find (id);
+
+            if (random.nextInt (3) == 0)
+            {
+                expect (set.remove (id) == (existing != expected.end()));
+
+                if (existing != expected.end())
+                    expected.erase (existing);
+            }
+            else
+            {
+                const auto changed = existing == expected.end() || existing->second != value;
+                expect (set.set (id, value) == changed);
+
+                if (existing == expected.end())
+                    expected.emplace_back (id, value);
+                else
+                    existing->second = value;
+            }
+
+            expectEquals (set.size(), (int) expected.size());
+        }
+
+        for (int i = 0; i < numNames; ++i)
+        {
+            const auto id = getName (i);
+            const auto existing = find (id);
+            const auto expectedIndex = existing != expected.end() ? (int) std::distance (expected.begin(), existing) : -1;
+
+            expectEquals (set.indexOf (id), expectedIndex);
+            expect (set.contains (id) == (expectedIndex >= 0));
+
+            if (expectedIndex >= 0)
+                expectEquals ((int) set[id], existing->second);
+            else
+                expect (set[id].isVoid());
+        }
+
+        int position = 0;
+
+        for (auto& item : set)
+        {
+            expect (item.name == expected[(size_t) position].first);
+            expectEquals ((int) item.value, expected[(size_t) position].second);
+            ++position;
+        }
+    }
+};
+
+static NamedValueSetTests namedValueSetTests;
+
+} // namespace juce
@@ -108,6 +108,29 @@ public:
     /** Returns the section of the file at which the mapped memory represents. */
     Range<int64> getRange() const noexcept      { return range; }
 
+    //==============================================================================
+    /** Hints that can be passed to adviseAccess(). */
+    enum class AccessHint
+    {
+        normal,         /**< Undoes any previous sequential or random hint. */
+        sequential,     /**< The memory will be read in order, so the OS can read ahead aggressively. */
+        random,         /**< The memory will be read in a random order, so reading ahead is wasteful. */
+        willNeed,       /**< The memory will be needed soon, so the OS should start loading it in the background. */
+        dontNeed        /**< The memory won't be needed for a while, so the OS can drop it from physical memory. */
+    };
+
+    /** Tells the OS how a section of the mapped memory is going to be used.
+
+        The range is given in bytes from the start of the file, and is clipped to the
+        range that's actually mapped. The call doesn't block, and the OS is free to
+        ignore the hint, so it never affects the contents of the memory - only the
+        speed at which it can be accessed.
+
+        On Windows, only willNeed and dontNeed have any effect. Avoid using dontNeed on
+        an exclusive read-write mapping, as some systems will discard unsaved changes.
+    */
+    void adviseAccess (Range<int64> fileRange, AccessHint hint) const noexcept;
+
 private:
     //==============================================================================
     void* address = nullptr;
@@ -43,7 +43,11 @@ namespace juce
     functions allow you to parse JSON into a var object, and to convert a var
     object to JSON-formatted text.
 
-    @see var
+    To read very large documents, or to read a document without creating a var
+    for every value in it, use a JSONEventParser. Similarly, a JSONWriter can write
+    a document directly to a stream.
+
+    @see var, JSONEventParser, JSONWriter
 
     @tags{Core}
 */
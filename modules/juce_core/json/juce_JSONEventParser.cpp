@@ -0,0 +1,1081 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+#if JUCE_INTEL && (JUCE_64BIT || defined (__SSE2__) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2))
+ #define JUCE_JSON_USE_SSE2 1
+#elif JUCE_ARM && JUCE_64BIT && defined (__ARM_NEON)
+ #define JUCE_JSON_USE_NEON 1
+#endif
+
+namespace JSONEventParserHelpers
+{
+    //==============================================================================
+    inline int findLowestSetBit (uint64 n) noexcept
+    {
+        jassert (n != 0);
+
+       #if JUCE_GCC || JUCE_CLANG
+        return __builtin_ctzll (n);
+       #elif JUCE_MSVC && JUCE_64BIT
+        unsigned long lowest;
+        _BitScanForward64 (&lowest, n);
+        return (int) lowest;
+       #else
+        int bit = 0;
+
+        while ((n & 1) == 0)
+        {
+            n >>= 1;
+            ++bit;
+        }
+
+        return bit;
+       #endif
+    }
+
+    /*  Returns a mask in which each bit is the XOR of that bit and all the bits below
+        it, which turns a mask of quote characters into a mask of the bytes in strings.
+    */
+    inline uint64 prefixXor (uint64 n) noexcept
+    {
+        n ^= n << 1;
+        n ^= n << 2;
+        n ^= n << 4;
+        n ^= n << 8;
+        n ^= n << 16;
+        n ^= n << 32;
+        return n;
+    }
+
+    inline bool isWhitespace (uint8 c) noexcept   { return c == ' ' || (c >= 9 && c <= 13); }
+    inline bool isDigit (uint8 c) noexcept        { return c >= '0' && c <= '9'; }
+
+    inline bool isEndOfValue (uint8 c) noexcept
+    {
+        return isWhitespace (c) || c == ',' || c == '}' || c == ']';
+    }
+
+    //==============================================================================
+    /*  Rounds an integer to the nearest double, where sticky is true if some non-zero
+        bits have already been discarded from below it.
+    */
+   #if defined (__SIZEOF_INT128__)
+    using UInt128 = unsigned __int128;
+
+    inline double roundToDouble (UInt128 n, bool sticky) noexcept
+    {
+        const auto high = (uint64) (n >> 64);
+        const auto numBits = high != 0 ? 128 - __builtin_clzll (high)
+                                       : 64 - __builtin_clzll ((uint64) n | 1);
+
+        if (numBits <= 53)
+        {
+            jassert (! sticky);
+            return (double) (uint64) n;
+        }
+
+        const auto shift = numBits - 53;
+        auto mantissa = (uint64) (n >> shift);
+        const auto remainder = n & ((((UInt128) 1) << shift) - 1);
+        const auto half = ((UInt128) 1) << (shift - 1);
+
+        if (remainder > half || (remainder == half && (sticky || (mantissa & 1) != 0)))
+            ++mantissa;
+
+        return std::ldexp ((double) mantissa, shift);
+    }
+   #endif
+
+    /*  Tries to convert significand * 10^exponent to the nearest double, returning false if
+        the exponent is out of the range that can be handled exactly.
+    */
+    inline bool convertDecimal (uint64 significand, int exponent, double& result) noexcept
+    {
+        // When both the significand and the power of ten can be represented exactly as doubles,
+        // a single multiplication or division gives the correctly rounded result
+        if (significand <= ((uint64) 1 << 53) && exponent >= -22 && exponent <= 22)
+        {
+            static constexpr double powersOfTen[] { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+            result = exponent < 0 ? (double) significand / powersOfTen[-exponent]
+                                  : (double) significand * powersOfTen[exponent];
+            return true;
+        }
+
+       #if defined (__SIZEOF_INT128__)
+        // Otherwise, 10^exponent is split into 5^exponent, which fits into 64 bits for these
+        // exponents, and a power of two, which can be applied exactly afterwards
+        if (significand == 0 || exponent < -27 || exponent > 27)
+            return false;
+
+        static constexpr auto powersOfFive = []
+        {
+            std::array<uint64, 28> powers {};
+            powers[0] = 1;
+
+            for (size_t i = 1; i < powers.size(); ++i)
+                powers[i] = powers[i - 1] * 5;
+
+            return powers;
+        }();
+
+        if (exponent > 0)
+        {
+            result = std::ldexp (roundToDouble ((UInt128) significand * powersOfFive[(size_t) exponent], false), exponent);
+            return true;
+        }
+
+        // Shifting the numerator up by 64 bits more than the divisor leaves at least 64 bits
+        // in the quotient, and the remainder tells us whether anything was lost below that
+        const auto divisor = powersOfFive[(size_t) -exponent];
+        const auto shift = 64 + (64 - __builtin_clzll (divisor)) - (64 - __builtin_clzll (significand));
+        const auto numerator = (UInt128) significand << shift;
+
+        result = std::ldexp (roundToDouble (numerator / divisor, (numerator % divisor) != 0), exponent - shift);
+        return true;
+       #else
+        return false;
+       #endif
+    }
+
+    //==============================================================================
+    /*  The bytes of a 64-byte block that belong to each character class. */
+    struct BlockMasks
+    {
+        uint64 quotes = 0, backslashes = 0, operators = 0, whitespace = 0;
+    };
+
+   #if JUCE_JSON_USE_SSE2
+    inline BlockMasks classifyBlock (const uint8* data) noexcept
+    {
+        BlockMasks masks;
+
+        for (int i = 0; i < 4; ++i)
+        {
+            const auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (data + i * 16));
+            const auto shift = i * 16;
+
+            // '[' and ']' are 0x20 below '{' and '}'
+            const auto lower = _mm_or_si128 (v, _mm_set1_epi8 (0x20));
+            const auto operators = _mm_or_si128 (_mm_or_si128 (_mm_cmpeq_epi8 (lower, _mm_set1_epi8 ('{')),
+                                                               _mm_cmpeq_epi8 (lower, _mm_set1_epi8 ('}'))),
+                                                 _mm_or_si128 (_mm_cmpeq_epi8 (v, _mm_set1_epi8 (':')),
+                                                               _mm_cmpeq_epi8 (v, _mm_set1_epi8 (','))));
+
+            const auto controlOffset = _mm_sub_epi8 (v, _mm_set1_epi8 (9));
+            const auto whitespace = _mm_or_si128 (_mm_cmpeq_epi8 (v, _mm_set1_epi8 (' ')),
+                                                  _mm_cmpeq_epi8 (_mm_min_epu8 (controlOffset, _mm_set1_epi8 (4)), controlOffset));
+
+            masks.quotes      |= (uint64) (uint32) _mm_movemask_epi8 (_mm_cmpeq_epi8 (v, _mm_set1_epi8 ('"')))  << shift;
+            masks.backslashes |= (uint64) (uint32) _mm_movemask_epi8 (_mm_cmpeq_epi8 (v, _mm_set1_epi8 ('\\'))) << shift;
+            masks.operators   |= (uint64) (uint32) _mm_movemask_epi8 (operators)  << shift;
+            masks.whitespace  |= (uint64) (uint32) _mm_movemask_epi8 (whitespace) << shift;
+        }
+
+        return masks;
+    }
+
+    /*  Returns a bitmask of the quotes and backslashes in the next 16 bytes, and adds
+        any bytes outside the ASCII range to nonAscii.
+    */
+    inline uint32 findStringSpecials (const uint8* data, uint32& nonAscii) noexcept
+    {
+        const auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (data));
+        nonAscii |= (uint32) _mm_movemask_epi8 (v);
+        return (uint32) _mm_movemask_epi8 (_mm_or_si128 (_mm_cmpeq_epi8 (v, _mm_set1_epi8 ('"')),
+                                                         _mm_cmpeq_epi8 (v, _mm_set1_epi8 ('\\'))));
+    }
+   #elif JUCE_JSON_USE_NEON
+    inline uint64 toBitmask (uint8x16_t a, uint8x16_t b, uint8x16_t c, uint8x16_t d) noexcept
+    {
+        static const uint8 bitValues[] { 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                                         0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+        const auto bits = vld1q_u8 (bitValues);
+
+        const auto ab = vpaddq_u8 (vandq_u8 (a, bits), vandq_u8 (b, bits));
+        const auto cd = vpaddq_u8 (vandq_u8 (c, bits), vandq_u8 (d, bits));
+        auto sum = vpaddq_u8 (ab, cd);
+        sum = vpaddq_u8 (sum, sum);
+        return vgetq_lane_u64 (vreinterpretq_u64_u8 (sum), 0);
+    }
+
+    inline BlockMasks classifyBlock (const uint8* data) noexcept
+    {
+        uint8x16_t quotes[4], backslashes[4], operators[4], whitespace[4];
+
+        for (int i = 0; i < 4; ++i)
+        {
+            const auto v = vld1q_u8 (data + i * 16);
+            const auto lower = vorrq_u8 (v, vdupq_n_u8 (0x20));
+
+            quotes[i]      = vceqq_u8 (v, vdupq_n_u8 ('"'));
+            backslashes[i] = vceqq_u8 (v, vdupq_n_u8 ('\\'));
+            operators[i]   = vorrq_u8 (vorrq_u8 (vceqq_u8 (lower, vdupq_n_u8 ('{')), vceqq_u8 (lower, vdupq_n_u8 ('}'))),
+                                       vorrq_u8 (vceqq_u8 (v, vdupq_n_u8 (':')), vceqq_u8 (v, vdupq_n_u8 (','))));
+            whitespace[i]  = vorrq_u8 (vceqq_u8 (v, vdupq_n_u8 (' ')),
+                                       vcleq_u8 (vsubq_u8 (v, vdupq_n_u8 (9)), vdupq_n_u8 (4)));
+        }
+
+        BlockMasks masks;
+        masks.quotes      = toBitmask (quotes[0], quotes[1], quotes[2], quotes[3]);
+        masks.backslashes = toBitmask (backslashes[0], backslashes[1], backslashes[2], backslashes[3]);
+        masks.operators   = toBitmask (operators[0], operators[1], operators[2], operators[3]);
+        masks.whitespace  = toBitmask (whitespace[0], whitespace[1], whitespace[2], whitespace[3]);
+        return masks;
+    }
+
+    inline uint32 findStringSpecials (const uint8* data, uint32& nonAscii) noexcept
+    {
+        const auto v = vld1q_u8 (data);
+        const auto specials = vorrq_u8 (vceqq_u8 (v, vdupq_n_u8 ('"')), vceqq_u8 (v, vdupq_n_u8 ('\\')));
+
+        nonAscii |= vmaxvq_u8 (v) >= 0x80 ? 1u : 0u;
+
+        // Narrowing each 16-bit lane by 4 bits leaves one nibble per byte
+        const auto nibbles = vget_lane_u64 (vreinterpret_u64_u8 (vshrn_n_u16 (vreinterpretq_u16_u8 (specials), 4)), 0);
+
+        if (nibbles == 0)
+            return 0;
+
+        return 1u << (findLowestSetBit (nibbles) / 4);
+    }
+   #else
+    inline BlockMasks classifyBlock (const uint8* data) noexcept
+    {
+        BlockMasks masks;
+
+        for (int i = 0; i < 64; ++i)
+        {
+            const auto c = data[i];
+            const auto bit = (uint64) 1 << i;
+
+            switch (c)
+            {
+                case '"':   masks.quotes |= bit; break;
+                case '\\':  masks.backslashes |= bit; break;
+                case '{': case '}': case '[': case ']': case ':': case ',':  masks.operators |= bit; break;
+                default:    if (isWhitespace (c)) masks.whitespace |= bit; break;
+            }
+        }
+
+        return masks;
+    }
+
+    inline uint32 findStringSpecials (const uint8* data, uint32& nonAscii) noexcept
+    {
+        for (uint32 i = 0; i < 16; ++i)
+        {
+            nonAscii |= data[i] & 0x80;
+
+            if (data[i] == '"' || data[i] == '\\')
+                return 1u << i;
+        }
+
+        return 0;
+    }
+   #endif
+
+    //==============================================================================
+    /*  The first stage of the parser, which finds the positions of the structural
+        characters, opening quotes and the first characters of other values, skipping
+        anything inside strings.
+
+        The text is scanned in batches, so that the index only ever covers a small
+        window of the document.
+    */
+    class StructuralScanner
+    {
+    public:
+        StructuralScanner (const uint8* textToScan, size_t numBytes, std::vector<size_t>& indexStorage)
+            : text (textToScan), size (numBytes), index (indexStorage)
+        {
+            index.resize (blocksPerBatch * 64);
+        }
+
+        /* Returns the position of the next structural character, or the size of the text. */
+        size_t next()
+        {
+            if (readPosition == numIndexed && ! refill())
+                return size;
+
+            return index[readPosition++];
+        }
+
+    private:
+        static constexpr size_t blocksPerBatch = 128;
+
+        bool refill()
+        {
+            readPosition = numIndexed = 0;
+
+            while (numIndexed == 0 && scanPosition < size)
+            {
+                for (size_t i = 0; i < blocksPerBatch && scanPosition < size; ++i)
+                {
+                    if (size - scanPosition >= 64)
+                    {
+                        scanBlock (text + scanPosition);
+                    }
+                    else
+                    {
+                        // The last partial block is padded with whitespace, which can't add any structurals
+                        uint8 lastBlock[64];
+                        std::fill (std::begin (lastBlock), std::end (lastBlock), (uint8) ' ');
+                        std::copy (text + scanPosition, text + size, lastBlock);
+                        scanBlock (lastBlock);
+                    }
+
+                    scanPosition += 64;
+                }
+            }
+
+            return numIndexed > 0;
+        }
+
+        void scanBlock (const uint8* block) noexcept
+        {
+            const auto masks = classifyBlock (block);
+
+            const auto quotes = masks.quotes & ~findEscapedCharacters (masks.backslashes);
+            const auto inString = prefixXor (quotes) ^ previousInString;
+            previousInString = (uint64) ((int64) inString >> 63);
+
+            // The opening quote of a string is inside it, and the closing quote is outside
+            const auto outsideStrings = ~(inString | quotes);
+            const auto scalars = ~(masks.operators | masks.whitespace | quotes) & outsideStrings;
+            const auto scalarStarts = scalars & ~((scalars << 1) | previousEndsWithScalar);
+            previousEndsWithScalar = scalars >> 63;
+
+            auto structurals = (masks.operators & outsideStrings) | (quotes & inString) | scalarStarts;
+
+            while (structurals != 0)
+            {
+                index[numIndexed++] = scanPosition + (size_t) findLowestSetBit (structurals);
+                structurals &= structurals - 1;
+            }
+        }
+
+        /*  Returns a mask of the characters that follow an unescaped backslash. Backslashes
+            are rare enough in real documents that walking through them one at a time is
+            quicker than doing the carry arithmetic for every block.
+        */
+        uint64 findEscapedCharacters (uint64 backslashes) noexcept
+        {
+            auto escaped = previousEndsWithBackslash;
+            auto escapes = backslashes & ~escaped;
+            previousEndsWithBackslash = 0;
+
+            while (escapes != 0)
+            {
+                const auto backslash = escapes & (~escapes + 1);
+
+                if (backslash == ((uint64) 1 << 63))
+                {
+                    previousEndsWithBackslash = 1;
+                    break;
+                }
+
+                escaped |= backslash << 1;
+                escapes &= ~(backslash | (backslash << 1));
+            }
+
+            return escaped;
+        }
+
+        const uint8* const text;
+        const size_t size;
+        std::vector<size_t>& index;
+        size_t readPosition = 0, numIndexed = 0, scanPosition = 0;
+        uint64 previousInString = 0, previousEndsWithBackslash = 0, previousEndsWithScalar = 0;
+    };
+
+    //==============================================================================
+    /*  The second stage of the parser, which walks through the structural index and
+        passes each item to a Handler.
+    */
+    template <typename Handler>
+    class StructuralParser
+    {
+    public:
+        StructuralParser (const uint8* textToParse, size_t numBytes,
+                          std::vector<size_t>& indexStorage, std::vector<char>& stringStorage,
+                          Handler& h)
+            : text (textToParse), size (numBytes), scanner (textToParse, numBytes, indexStorage),
+              strings (stringStorage), handler (h)
+        {
+            if (strings.size() < 256)
+                strings.resize (256);
+        }
+
+        Result parse()
+        {
+            try
+            {
+                const auto start = scanner.next();
+
+                if (start == size)
+                    throwError ("Expected a value", start);
+
+                parseValue (start);
+
+                const auto end = scanner.next();
+
+                if (end != size)
+                    throwError ("Unexpected text after the end of the document", end);
+            }
+            catch (const ErrorException& e)
+            {
+                return Result::fail (getErrorDescription (e));
+            }
+
+            return Result::ok();
+        }
+
+    private:
+        struct ErrorException
+        {
+            const char* message;
+            size_t position;
+        };
+
+        [[noreturn]] static void throwError (const char* message, size_t position)
+        {
+            throw ErrorException { message, position };
+        }
+
+        String getErrorDescription (const ErrorException& e) const
+        {
+            int line = 1, column = 1;
+
+            for (size_t i = 0; i < e.position && i < size; ++i)
+            {
+                // Count characters rather than bytes, skipping UTF-8 continuation bytes
+                if ((text[i] & 0xc0) == 0x80)
+                    continue;
+
+                ++column;
+                if (text[i] == '\n')  { column = 1; ++line; }
+            }
+
+            return String (line) + ":" + String (column) + ": error: " + e.message;
+        }
+
+        uint8 charAt (size_t position) const noexcept
+        {
+            return position < size ? text[position] : (uint8) 0;
+        }
+
+        size_t nextStructural()
+        {
+            const auto position = scanner.next();
+
+            if (position == size)
+                throwError ("Unexpected end of input", position);
+
+            return position;
+        }
+
+        //==============================================================================
+        void parseValue (size_t position)
+        {
+            switch (text[position])
+            {
+                case '{':   parseObject(); return;
+                case '[':   parseArray(); return;
+                case '"':   parseStringValue (position); return;
+                case 't':   parseLiteral (position, "true");  handler.boolean (true);  return;
+                case 'f':   parseLiteral (position, "false"); handler.boolean (false); return;
+                case 'n':   parseLiteral (position, "null");  handler.null(); return;
+
+                case '-':
+                case '0': case '1': case '2': case '3': case '4':
+                case '5': case '6': case '7': case '8': case '9':
+                    parseNumber (position);
+                    return;
+
+                default:
+                    throwError ("Syntax error", position);
+            }
+        }
+
+        void parseObject()
+        {
+            handler.objectStart();
+            auto position = nextStructural();
+
+            if (text[position] != '}')
+            {
+                for (;;)
+                {
+                    if (text[position] != '"')
+                        throwError ("Expected a property name in double-quotes", position);
+
+                    const auto* name = parseString (position);
+
+                    if (! handler.key (name, stringLength))
+                        throwError ("Invalid property name", position);
+
+                    position = nextStructural();
+
+                    if (text[position] != ':')
+                        throwError ("Expected ':'", position);
+
+                    parseValue (nextStructural());
+                    position = nextStructural();
+
+                    if (text[position] == '}')
+                        break;
+
+                    if (text[position] != ',')
+                        throwError ("Expected ',' or '}'", position);
+
+                    position = nextStructural();
+                }
+            }
+
+            handler.objectEnd();
+        }
+
+        void parseArray()
+        {
+            handler.arrayStart();
+            auto position = nextStructural();
+
+            if (text[position] != ']')
+            {
+                for (;;)
+                {
+                    parseValue (position);
+                    position = nextStructural();
+
+                    if (text[position] == ']')
+                        break;
+
+                    if (text[position] != ',')
+                        throwError ("Expected ',' or ']'", position);
+
+                    position = nextStructural();
+                }
+            }
+
+            handler.arrayEnd();
+        }
+
+        void parseStringValue (size_t position)
+        {
+            const auto* value = parseString (position);
+            handler.string (value, stringLength);
+        }
+
+        void parseLiteral (size_t position, const char* literal)
+        {
+            const auto length = std::strlen (literal);
+
+            if (size - position < length
+                 || std::memcmp (text + position, literal, length) != 0
+                 || ! (position + length == size || isEndOfValue (text[position + length])))
+                throwError ("Syntax error", position);
+        }
+
+        //==============================================================================
+        void parseNumber (size_t start)
+        {
+            auto position = start;
+            const auto isNegative = charAt (position) == '-';
+
+            if (isNegative)
+                ++position;
+
+            const auto digitsStart = position;
+            uint64 significand = 0;
+            int numSignificantDigits = 0, numFractionDigits = 0, exponent = 0;
+            bool isInteger = true;
+
+            const auto readDigits = [&] (bool isFraction)
+            {
+                const auto firstDigit = position;
+
+                for (; isDigit (charAt (position)); ++position)
+                {
+                    const auto digit = (uint64) (text[position] - '0');
+
+                    if (numSignificantDigits > 0 || digit != 0)
+                        ++numSignificantDigits;
+
+                    // Anything longer than 19 digits is left to readDoubleValue()
+                    if (numSignificantDigits <= 19)
+                        significand = significand * 10 + digit;
+
+                    if (isFraction)
+                    {
+                        ++numFractionDigits;
+                        --exponent;
+                    }
+                }
+
+                if (position == firstDigit)
+                    throwError ("Syntax error in number", position);
+            };
+
+            if (charAt (position) == '0')
+                ++position;
+            else
+                readDigits (false);
+
+            const auto numIntegerDigits = numSignificantDigits;
+
+            if (charAt (position) == '.')
+            {
+                isInteger = false;
+                ++position;
+                readDigits (true);
+            }
+
+            if (charAt (position) == 'e' || charAt (position) == 'E')
+            {
+                isInteger = false;
+                ++position;
+
+                const auto isNegativeExponent = charAt (position) == '-';
+
+                if (isNegativeExponent || charAt (position) == '+')
+                    ++position;
+
+                if (! isDigit (charAt (position)))
+                    throwError ("Syntax error in number", position);
+
+                int explicitExponent = 0;
+
+                for (; isDigit (charAt (position)); ++position)
+                    explicitExponent = jmin (explicitExponent * 10 + (text[position] - '0'), 100000);
+
+                exponent += isNegativeExponent ? -explicitExponent : explicitExponent;
+            }
+
+            if (position < size && ! isEndOfValue (text[position]))
+                throwError ("Syntax error in number", position);
+
+            if (isInteger && numSignificantDigits <= 19 && significand <= (uint64) std::numeric_limits<int64>::max())
+            {
+                handler.integer (isNegative ? -(int64) significand : (int64) significand);
+                return;
+            }
+
+            // readDoubleValue() keeps 18 digits, counting any zeros after the decimal point, so
+            // for anything shorter than that it gives the correctly rounded result too
+            double value;
+
+            if (numIntegerDigits + numFractionDigits <= 18 && convertDecimal (significand, exponent, value))
+            {
+                handler.floatingPoint (isNegative ? -value : value);
+                return;
+            }
+
+            // The text may not be null-terminated, so the number is copied before it's converted
+            const auto length = position - digitsStart;
+            HeapBlock<char> longNumber;
+            char shortNumber[64];
+            auto* number = shortNumber;
+
+            if (length >= sizeof (shortNumber))
+            {
+                longNumber.malloc (length + 1);
+                number = longNumber.get();
+            }
+
+            std::memcpy (number, text + digitsStart, length);
+            number[length] = 0;
+
+            CharPointer_UTF8 numberText (number);
+            value = CharacterFunctions::readDoubleValue (numberText);
+            handler.floatingPoint (isNegative ? -value : value);
+        }
+
+        //==============================================================================
+        /*  Unescapes the string starting at the given quote into the string buffer, and
+            returns a pointer to its null-terminated contents.
+        */
+        const char* parseString (size_t quotePosition)
+        {
+            auto position = quotePosition + 1;
+            size_t length = 0;
+            uint32 nonAscii = 0;
+
+            for (;;)
+            {
+                ensureStringSpace (length + 16);
+
+                // The vectorised search copies 16 bytes at a time until it finds a quote or backslash
+                while (size - position >= 16)
+                {
+                    std::memcpy (strings.data() + length, text + position, 16);
+                    const auto specials = findStringSpecials (text + position, nonAscii);
+
+                    if (specials != 0)
+                    {
+                        const auto offset = (size_t) findLowestSetBit (specials);
+                        position += offset;
+                        length += offset;
+                        break;
+                    }
+
+                    position += 16;
+                    length += 16;
+                    ensureStringSpace (length + 16);
+                }
+
+                while (position < size && text[position] != '"' && text[position] != '\\')
+                {
+                    nonAscii |= text[position] & 0x80;
+                    strings[length++] = (char) text[position++];
+                    ensureStringSpace (length + 16);
+                }
+
+                if (position >= size)
+                    throwError ("Unexpected EOF in string constant", quotePosition);
+
+                if (text[position++] == '"')
+                    break;
+
+                length = parseEscapeSequence (position, length);
+            }
+
+            strings[length] = 0;
+            stringLength = length;
+
+            if (nonAscii != 0 && ! CharPointer_UTF8::isValidString (strings.data(), (int) length))
+                throwError ("Invalid UTF-8 in string constant", quotePosition);
+
+            return strings.data();
+        }
+
+        size_t parseEscapeSequence (size_t& position, size_t length)
+        {
+            const auto escapePosition = position - 1;
+
+            switch (charAt (position++))
+            {
+                case '"':   strings[length++] = '"';  return length;
+                case '\\':  strings[length++] = '\\'; return length;
+                case '/':   strings[length++] = '/';  return length;
+                case 'b':   strings[length++] = '\b'; return length;
+                case 'f':   strings[length++] = '\f'; return length;
+                case 'n':   strings[length++] = '\n'; return length;
+                case 'r':   strings[length++] = '\r'; return length;
+                case 't':   strings[length++] = '\t'; return length;
+                case 'u':   break;
+                default:    throwError ("Invalid escape sequence", escapePosition);
+            }
+
+            auto codePoint = (juce_wchar) parseCodeUnit (position);
+
+            if (CharacterFunctions::isHighSurrogate (codePoint))
+            {
+                if (charAt (position) != '\\' || charAt (position + 1) != 'u')
+                    throwError ("Expected UTF-16 low surrogate", position);
+
+                position += 2;
+                const auto lowSurrogate = (juce_wchar) parseCodeUnit (position);
+
+                if (! CharacterFunctions::isLowSurrogate (lowSurrogate))
+                    throwError ("Expected UTF-16 low surrogate", position - 6);
+
+                codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (lowSurrogate - 0xdc00);
+            }
+            else if (! CharacterFunctions::isNonSurrogateCodePoint (codePoint))
+            {
+                throwError ("Invalid UTF-16 escape sequence", escapePosition);
+            }
+
+            if (codePoint == 0)
+                throwError ("Null characters are not supported in strings", escapePosition);
+
+            CharPointer_UTF8 dest (strings.data() + length);
+            dest.write (codePoint);
+            return (size_t) (dest.getAddress() - strings.data());
+        }
+
+        uint32 parseCodeUnit (size_t& position)
+        {
+            uint32 codeUnit = 0;
+
+            for (int i = 0; i < 4; ++i)
+            {
+                const auto digitValue = CharacterFunctions::getHexDigitValue ((juce_wchar) charAt (position));
+
+                if (digitValue < 0)
+                    throwError ("Invalid hex character", position);
+
+                codeUnit = (codeUnit << 4) | (uint32) digitValue;
+                ++position;
+            }
+
+            return codeUnit;
+        }
+
+        void ensureStringSpace (size_t numBytesNeeded)
+        {
+            if (strings.size() < numBytesNeeded)
+                strings.resize (jmax (numBytesNeeded, strings.size() * 2));
+        }
+
+        //==============================================================================
+        const uint8* const text;
+        const size_t size;
+        StructuralScanner scanner;
+        std::vector<char>& strings;
+        size_t stringLength = 0;
+        Handler& handler;
+    };
+
+    //==============================================================================
+    struct ListenerHandler
+    {
+        void objectStart()                      { listener.objectStarted(); }
+        void objectEnd()                        { listener.objectEnded(); }
+        void arrayStart()                       { listener.arrayStarted(); }
+        void arrayEnd()                         { listener.arrayEnded(); }
+        bool key (const char* s, size_t)        { listener.propertyName (CharPointer_UTF8 (s)); return true; }
+        void string (const char* s, size_t)     { listener.stringValue (CharPointer_UTF8 (s)); }
+        void integer (int64 value)              { listener.intValue (value); }
+        void floatingPoint (double value)       { listener.doubleValue (value); }
+        void boolean (bool value)               { listener.boolValue (value); }
+        void null()                             { listener.nullValue(); }
+
+        JSONEventParser::Listener& listener;
+    };
+
+    //==============================================================================
+    /*  Builds a var with the same structure as the one that JSON::parse() creates. */
+    class VarBuilder
+    {
+    public:
+        void objectStart()
+        {
+            auto* object = new DynamicObject();
+            stack.push_back ({ var (object), nullptr, &object->getProperties(), {} });
+        }
+
+        void arrayStart()
+        {
+            var array { Array<var>() };
+            auto* values = array.getArray();
+            stack.push_back ({ std::move (array), values, nullptr, {} });
+        }
+
+        void objectEnd()                        { endContainer(); }
+        void arrayEnd()                         { endContainer(); }
+
+        bool key (const char* s, size_t length)
+        {
+            if (length == 0)
+                return false;
+
+            stack.back().propertyName = getIdentifier (s, length);
+            return true;
+        }
+
+        void string (const char* s, size_t length)
+        {
+            add (length > 0 ? var (String (CharPointer_UTF8 (s), CharPointer_UTF8 (s + length))) : var (String()));
+        }
+
+        // Matches the choice of int or int64 that JSON::parse() makes
+        void integer (int64 value)
+        {
+            const auto magnitude = value < 0 ? (uint64) 0 - (uint64) value : (uint64) value;
+            add ((magnitude >> 31) != 0 ? var (value) : var ((int) value));
+        }
+
+        void floatingPoint (double value)       { add (var (value)); }
+        void boolean (bool value)               { add (var (value)); }
+        void null()                             { add (var()); }
+
+        var result;
+
+    private:
+        struct Container
+        {
+            var value;
+            Array<var>* array;
+            NamedValueSet* properties;
+            Identifier propertyName;
+        };
+
+        struct CachedIdentifier
+        {
+            uint32 hash = 0;
+            size_t length = 0;
+            Identifier identifier;
+        };
+
+        void add (var&& value)
+        {
+            if (stack.empty())
+            {
+                result = std::move (value);
+                return;
+            }
+
+            auto& container = stack.back();
+
+            if (container.array != nullptr)
+                container.array->add (std::move (value));
+            else
+                container.properties->set (container.propertyName, std::move (value));
+        }
+
+        void endContainer()
+        {
+            auto value = std::move (stack.back().value);
+            stack.pop_back();
+            add (std::move (value));
+        }
+
+        /*  Documents tend to repeat the same few property names many times, so the most
+            recent Identifiers are cached to avoid looking each one up in the StringPool.
+        */
+        Identifier getIdentifier (const char* s, size_t length)
+        {
+            uint32 hash = 2166136261u;
+
+            for (size_t i = 0; i < length; ++i)
+                hash = (hash ^ (uint8) s[i]) * 16777619u;
+
+            auto& cached = identifierCache[hash & (identifierCache.size() - 1)];
+
+            if (cached.hash != hash
+                 || cached.length != length
+                 || std::memcmp (cached.identifier.getCharPointer().getAddress(), s, length) != 0)
+            {
+                cached.hash = hash;
+                cached.length = length;
+                cached.identifier = Identifier (CharPointer_UTF8 (s), CharPointer_UTF8 (s + length));
+            }
+
+            return cached.identifier;
+        }
+
+        std::vector<Container> stack;
+        std::array<CachedIdentifier, 256> identifierCache;
+    };
+
+    //==============================================================================
+    template <typename Handler>
+    Result parse (const void* data, size_t numBytes, std::vector<size_t>& index,
+                  std::vector<char>& strings, Handler& handler)
+    {
+        auto* text = static_cast<const uint8*> (data);
+
+        if (numBytes >= 3 && CharPointer_UTF8::isByteOrderMark (text))
+        {
+            text += 3;
+            numBytes -= 3;
+        }
+
+        return StructuralParser<Handler> (text, numBytes, index, strings, handler).parse();
+    }
+
+    template <typename Handler>
+    Result parseFile (const File& file, std::vector<size_t>& index, std::vector<char>& strings, Handler& handler)
+    {
+        if (file.getSize() == 0)
+            return parse (nullptr, 0, index, strings, handler);
+
+        MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+        if (mappedFile.getData() == nullptr)
+            return Result::fail ("Couldn't open " + file.getFullPathName());
+
+        return parse (mappedFile.getData(), mappedFile.getSize(), index, strings, handler);
+    }
+}
+
+//==============================================================================
+JSONEventParser::JSONEventParser() = default;
+JSONEventParser::~JSONEventParser() = default;
+
+Result JSONEventParser::parse (const void* data, size_t numBytes, Listener& listener)
+{
+    JSONEventParserHelpers::ListenerHandler handler { listener };
+    return JSONEventParserHelpers::parse (data, numBytes, structuralIndex, stringBuffer, handler);
+}
+
+Result JSONEventParser::parse (const String& text, Listener& listener)
+{
+    return parse (text.toRawUTF8(), text.getNumBytesAsUTF8(), listener);
+}
+
+Result JSONEventParser::parse (const File& file, Listener& listener)
+{
+    JSONEventParserHelpers::ListenerHandler handler { listener };
+    return JSONEventParserHelpers::parseFile (file, structuralIndex, stringBuffer, handler);
+}
+
+Result JSONEventParser::parse (const void* data, size_t numBytes, var& result)
+{
+    JSONEventParserHelpers::VarBuilder builder;
+    const auto r = JSONEventParserHelpers::parse (data, numBytes, structuralIndex, stringBuffer, builder);
+
+    if (r.wasOk())
+        result = std::move (builder.result);
+
+    return r;
+}
+
+Result JSONEventParser::parse (const String& text, var& result)
+{
+    return parse (text.toRawUTF8(), text.getNumBytesAsUTF8(), result);
+}
+
+Result JSONEventParser::parse (const File& file, var& result)
+{
+    JSONEventParserHelpers::VarBuilder builder;
+    const auto r = JSONEventParserHelpers::parseFile (file, structuralIndex, stringBuffer, builder);
+
+    if (r.wasOk())
+        result = std::move (builder.result);
+
+    return r;
+}
+
+#undef JUCE_JSON_USE_SSE2
+#undef JUCE_JSON_USE_NEON
+
+} // namespace juce
@@ -0,0 +1,164 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A fast parser for large JSON documents, which can either report what it finds to
+    a Listener, or build a var in the same form as JSON::parse().
+
+    Parsing happens in two stages. The first scans the text in 64-byte blocks, using
+    SSE2 or NEON where available, and builds an index of the structural characters,
+    the starts of strings and the starts of other values, ignoring anything inside
+    string literals. The second stage walks this index instead of the raw text. Only
+    the index for a small window of the text is kept at any time, so the memory used
+    doesn't depend on the size of the document.
+
+    Strings are unescaped into a buffer owned by the parser and passed to the Listener
+    as null-terminated StringRefs, so no String objects are created unless you create
+    them. These StringRefs are only valid until the callback returns.
+
+    The parser accepts standard JSON text (RFC 8259) encoded as UTF-8, with any type
+    of value at the top level. Unlike JSON::parse(), it doesn't allow single-quoted
+    strings, trailing commas, non-standard escape sequences, or anything other than
+    whitespace after the end of the top-level value. Strings may not contain a null
+    character.
+
+    A JSONEventParser keeps its buffers between calls to parse(), so if you parse a
+    lot of documents, reusing the same object will avoid some allocations.
+
+    @see JSON
+
+    @tags{Core}
+*/
+class JUCE_API  JSONEventParser
+{
+public:
+    //==============================================================================
+    JSONEventParser();
+
+    /** Destructor. */
+    ~JSONEventParser();
+
+    //==============================================================================
+    /**
+        Receives callbacks from a JSONEventParser as it works through a document.
+
+        The default implementations do nothing, so you only need to override the
+        callbacks you're interested in.
+    */
+    class JUCE_API  Listener
+    {
+    public:
+        /** Destructor. */
+        virtual ~Listener() = default;
+
+        /** Called at the opening brace of an object. */
+        virtual void objectStarted() {}
+
+        /** Called at the closing brace of an object. */
+        virtual void objectEnded() {}
+
+        /** Called at the opening bracket of an array. */
+        virtual void arrayStarted() {}
+
+        /** Called at the closing bracket of an array. */
+        virtual void arrayEnded() {}
+
+        /** Called with the name of a property inside an object, before the callback for its value. */
+        virtual void propertyName (StringRef) {}
+
+        /** Called for a string value. */
+        virtual void stringValue (StringRef) {}
+
+        /** Called for a number without a fractional part or exponent, which fits into an int64. */
+        virtual void intValue (int64) {}
+
+        /** Called for any other number. */
+        virtual void doubleValue (double) {}
+
+        /** Called for a true or false value. */
+        virtual void boolValue (bool) {}
+
+        /** Called for a null value. */
+        virtual void nullValue() {}
+    };
+
+    //==============================================================================
+    /** Parses a block of UTF-8 JSON text, calling the listener for each item found.
+
+        The data doesn't need to be null-terminated. A UTF-8 byte-order mark at the start
+        is skipped. If the text isn't valid, parsing stops at the first error, and the
+        result will contain its line and column.
+    */
+    Result parse (const void* utf8Data, size_t numBytes, Listener& listener);
+
+    /** Parses a string of JSON text, calling the listener for each item found. */
+    Result parse (const String& text, Listener& listener);
+
+    /** Parses a file containing UTF-8 JSON text, calling the listener for each item found.
+        The file is memory-mapped rather than being loaded into a String.
+    */
+    Result parse (const File& file, Listener& listener);
+
+    //==============================================================================
+    /** Parses a block of UTF-8 JSON text into a var.
+
+        The result has the same structure as one created by JSON::parse(), but property
+        names are looked up in a small cache rather than creating a new Identifier for
+        each one, and strings are created without any intermediate copies.
+
+        If parsing fails, the result parameter is left unchanged.
+    */
+    Result parse (const void* utf8Data, size_t numBytes, var& result);
+
+    /** Parses a string of JSON text into a var. */
+    Result parse (const String& text, var& result);
+
+    /** Parses a file containing UTF-8 JSON text into a var.
+        The file is memory-mapped rather than being loaded into a String.
+    */
+    Result parse (const File& file, var& result);
+
+private:
+    //==============================================================================
+    std::vector<size_t> structuralIndex;
+    std::vector<char> stringBuffer;
+
+    JUCE_DECLARE_NON_COPYABLE (JSONEventParser)
+};
+
+} // namespace juce
@@ -0,0 +1,316 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class JSONEventParserTests final : public UnitTest
+{
+public:
+    JSONEventParserTests()
+        : UnitTest ("JSONEventParser", UnitTestCategories::json)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Strict documents produce the same var as JSON::parse");
+        {
+            auto r = getRandom();
+            JSONEventParser parser;
+
+            for (int i = 0; i < 100; ++i)
+            {
+                const auto text = JSON::toString (createRandomContainer (r, 0), r.nextBool());
+                expectSameAsJSONParse (parser, text);
+            }
+        }
+
+        beginTest ("Documents larger than one scanning batch");
+        {
+            auto r = getRandom();
+            Array<var> items;
+
+            for (int i = 0; i < 2000; ++i)
+                items.add (createRandomContainer (r, 2));
+
+            const auto text = JSON::toString (items, false);
+            expectGreaterThan (text.getNumBytesAsUTF8(), (size_t) 100000);
+
+            JSONEventParser parser;
+            expectSameAsJSONParse (parser, text);
+
+            TemporaryFile temp;
+            expect (temp.getFile().replaceWithText (text));
+
+            var fromFile;
+            expect (parser.parse (temp.getFile(), fromFile).wasOk());
+            expect (JSONUtils::deepEqual (fromFile, JSON::parse (text)));
+        }
+
+        beginTest ("Listener receives events in document order");
+        {
+            EventRecorder recorder;
+            const auto result = JSONEventParser().parse (String (R"({ "a": [1, -2.5, "x"], "b": { "c": true, "d": null }, "e": false })"), recorder);
+
+            expect (result.wasOk());
+            expectEquals (recorder.events.joinIntoString (" "),
+                          String ("{ name:a [ int:1 double:-2.5 string:x ] name:b { name:c bool:1 name:d null } name:e bool:0 }"));
+        }
+
+        beginTest ("Any value is allowed at the top level");
+        {
+            expectEquals (parseToVar ("  42 ").toString(), String ("42"));
+            expectEquals (parseToVar ("\"abc\"").toString(), String ("abc"));
+            expect (parseToVar ("true") == var (true));
+            expect (parseToVar ("null").isVoid());
+        }
+
+        beginTest ("Escape sequences and UTF-8");
+        {
+            expectEquals (parseToVar (R"(["a\"b\\c\/d\b\f\n\r\t"])")[0].toString(), String ("a\"b\\c/d\b\f\n\r\t"));
+            expectEquals (parseToVar (R"(["\u00e9\u20ac\ud83d\ude00"])")[0].toString(),
+                          String (CharPointer_UTF8 ("\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80")));
+            expectEquals (parseToVar (CharPointer_UTF8 ("[\"\xc3\xa9\"]"))[0].toString(), String (CharPointer_UTF8 ("\xc3\xa9")));
+            expectEquals (parseToVar (R"({"\u00e9": 1})").getDynamicObject()->getProperties().getName (0).toString(),
+                          String (CharPointer_UTF8 ("\xc3\xa9")));
+        }
+
+        beginTest ("Quotes and backslashes at block boundaries");
+        {
+            for (int offset = 0; offset < 140; ++offset)
+            {
+                const auto padding = String::repeatedString ("x", offset);
+
+                for (const auto* escapes : { R"(\")", R"(\\)", R"(\\\")", R"(\\\\)" })
+                {
+                    const auto content = padding + escapes + "]";
+                    const auto text = "[\"" + content + "\", [\"" + padding + "\"]]";
+                    const auto parsed = parseToVar (text);
+
+                    expect (parsed.size() == 2, text);
+                    expectEquals (parsed[0].toString(), JSON::fromString ("\"" + content + "\"").toString());
+                    expectEquals (parsed[1][0].toString(), padding);
+                }
+            }
+        }
+
+        beginTest ("Numbers");
+        {
+            expect (parseToVar ("[1234]")[0].isInt());
+            expect (parseToVar ("[-2147483647]")[0].isInt());
+            expect (parseToVar ("[-2147483648]")[0].isInt64());
+            expect (parseToVar ("[12345678901234]")[0].isInt64());
+            expect (parseToVar ("[1.123e3]")[0].isDouble());
+            expect (parseToVar ("[0]")[0].isInt());
+
+            expectEquals ((int64) parseToVar ("[9223372036854775807]")[0], std::numeric_limits<int64>::max());
+            expectEquals ((int64) parseToVar ("[-9223372036854775807]")[0], -std::numeric_limits<int64>::max());
+            expect (parseToVar ("[9223372036854775808]")[0].isDouble());
+            expect (parseToVar ("[123456789012345678901234567890]")[0].isDouble());
+
+            expectEquals ((double) parseToVar ("[-1.5e-3]")[0], -1.5e-3);
+            expectEquals ((double) parseToVar ("[0.25]")[0], 0.25);
+            expectEquals ((double) parseToVar ("[2E+2]")[0], 200.0);
+
+            auto r = getRandom();
+            JSONEventParser parser;
+
+            for (int i = 0; i < 5000; ++i)
+            {
+                String digits;
+
+                for (int d = 1 + r.nextInt (20); --d >= 0;)
+                    digits << String::charToString ((juce_wchar) ('0' + r.nextInt (10)));
+
+                // JSON::parse() doesn't handle integers that are too big for an int64
+                const auto pointPosition = r.nextInt (jmin (digits.length(), 18));
+                auto text = "[" + digits.substring (0, pointPosition + 1).trimCharactersAtStart ("0");
+
+                if (text == "[")
+                    text << "0";
+
+                if (pointPosition + 1 < digits.length())
+                    text << "." << digits.substring (pointPosition + 1);
+
+                if (r.nextBool())
+                    text << "e" << String (r.nextInt ({ -40, 40 }));
+
+                text << "]";
+
+                var result;
+                expect (parser.parse (text, result).wasOk(), text);
+                expect (exactlyEqual ((double) result[0], (double) JSON::parse (text)[0]), text);
+            }
+        }
+
+        beginTest ("Text doesn't need to be null-terminated");
+        {
+            const char text[] = "[1,23]456";
+            JSONEventParser parser;
+            var result;
+
+            expect (parser.parse (text, 6, result).wasOk());
+            expectEquals ((int) result[1], 23);
+
+            expect (parser.parse (text + 3, 2, result).wasOk());
+            expectEquals ((int) result, 23);
+
+            expect (parser.parse (text, 5, result).failed());
+        }
+
+        beginTest ("Invalid documents are rejected");
+        {
+            for (const auto* text : { "", "   ", "[1,]", "{\"a\":1,}", "['a']", "[1] x", "[01]", "[1.]", "[.5]", "[-]",
+                                      "[1e]", "[\"abc]", "[tru]", "[truex]", "[\"\\x\"]", "[\"\\u12\"]", "[\"\\ud800\"]",
+                                      "[\"\\udc00\"]", "[\"\\u0000\"]", "[1 2]", "{\"a\" 1}", "{\"a\":1 \"b\":2}", "{1:2}",
+                                      "[}", "{\"a\"}", "[\"\xc3\"]", "{\"a\":[1}" })
+            {
+                var result { "unchanged" };
+                expect (JSONEventParser().parse (text, std::strlen (text), result).failed(), String (CharPointer_UTF8 (text)));
+                expectEquals (result.toString(), String ("unchanged"));
+            }
+
+            // Empty property names are valid JSON, but can't be used as Identifiers
+            EventRecorder recorder;
+            expect (JSONEventParser().parse (String (R"({"": 1})"), recorder).wasOk());
+
+            var result;
+            expectEquals (JSONEventParser().parse (String (R"({"": 1})"), result).getErrorMessage(),
+                          String ("1:2: error: Invalid property name"));
+        }
+
+        beginTest ("Errors report the line and column");
+        {
+            var result;
+            expectEquals (JSONEventParser().parse (String ("{\n  \"a\": 1,\n  \"b\" 2\n}"), result).getErrorMessage(),
+                          String ("3:7: error: Expected ':'"));
+            expectEquals (JSONEventParser().parse (String ("[1,\n  [2, 3"), result).getErrorMessage(),
+                          String ("2:8: error: Unexpected end of input"));
+        }
+    }
+
+private:
+    struct EventRecorder final : public JSONEventParser::Listener
+    {
+        void objectStarted() override               { events.add ("{"); }
+        void objectEnded() override                 { events.add ("}"); }
+        void arrayStarted() override                { events.add ("["); }
+        void arrayEnded() override                  { events.add ("]"); }
+        void propertyName (StringRef name) override { events.add ("name:" + String (name)); }
+        void stringValue (StringRef value) override { events.add ("string:" + String (value)); }
+        void intValue (int64 value) override        { events.add ("int:" + String (value)); }
+        void doubleValue (double value) override    { events.add ("double:" + String (value)); }
+        void boolValue (bool value) override        { events.add ("bool:" + String ((int) value)); }
+        void nullValue() override                   { events.add ("null"); }
+
+        StringArray events;
+    };
+
+    var parseToVar (const String& text)
+    {
+        var result;
+        const auto r = JSONEventParser().parse (text, result);
+        expect (r.wasOk(), text + ": " + r.getErrorMessage());
+        return result;
+    }
+
+    void expectSameAsJSONParse (JSONEventParser& parser, const String& text)
+    {
+        var result;
+        const auto r = parser.parse (text, result);
+        expect (r.wasOk(), r.getErrorMessage());
+
+        const auto expected = JSON::parse (text);
+        expect (JSONUtils::deepEqual (result, expected));
+        expectEquals (JSON::toString (result), JSON::toString (expected));
+    }
+
+    static String createRandomString (Random& r)
+    {
+        String s;
+
+        for (int i = r.nextInt (40); --i >= 0;)
+        {
+            switch (r.nextInt (4))
+            {
+                case 0:     s << String::charToString ((juce_wchar) (1 + r.nextInt (0x7f))); break;
+                case 1:     s << String::charToString ((juce_wchar) (0x80 + r.nextInt (0xd000))); break;
+                case 2:     s << String::charToString ((juce_wchar) (0x10000 + r.nextInt (0x10000))); break;
+                default:    s << (r.nextBool() ? "\"" : "\\"); break;
+            }
+        }
+
+        return s;
+    }
+
+    static var createRandomValue (Random& r, int depth)
+    {
+        switch (r.nextInt (depth > 3 ? 7 : 9))
+        {
+            case 0:     return {};
+            case 1:     return r.nextInt();
+            case 2:     return r.nextInt64();
+            case 3:     return r.nextBool();
+            case 4:     return (r.nextDouble() - 0.5) * std::pow (10.0, r.nextInt ({ -20, 20 }));
+            case 5:
+            case 6:     return createRandomString (r);
+            default:    return createRandomContainer (r, depth + 1);
+        }
+    }
+
+    static var createRandomContainer (Random& r, int depth)
+    {
+        if (r.nextBool())
+        {
+            Array<var> values;
+
+            for (int i = r.nextInt (20); --i >= 0;)
+                values.add (createRandomValue (r, depth));
+
+            return values;
+        }
+
+        auto* object = new DynamicObject();
+
+        for (int i = r.nextInt (20); --i >= 0;)
+            object->setProperty ("p" + String (r.nextInt (30)) + createRandomString (r).substring (0, 3),
+                                 createRandomValue (r, depth));
+
+        return var (object);
+    }
+};
+
+static JSONEventParserTests jsonEventParserTests;
+
+} // namespace juce
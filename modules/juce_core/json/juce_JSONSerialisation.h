@@ -101,6 +101,22 @@ public:
         return Visitor::convert (t, options);
     }
 
+    /** Attempts to convert the argument to JSON, writing it directly to a JSONWriter without
+        creating any intermediate var objects.
+
+        The output is the same as passing the result of the other convert() function to
+        JSONWriter::writeVar(), except that if a type saves several values with the same name, all
+        of them will be written.
+
+        This will return true if conversion succeeds. If conversion fails, some of the output may
+        already have been written, so you may want to write to a temporary stream first.
+    */
+    template <typename T>
+    static bool convert (const T& t, JSONWriter& writer, const Options& options = {})
+    {
+        return WriterVisitor::convert (t, writer, options);
+    }
+
 private:
     class Visitor
     {
@@ -250,6 +266,165 @@ private:
         std::optional<var> value;
         bool versionIncluded = true;
     };
+
+    class WriterVisitor
+    {
+    public:
+        template <typename T>
+        static bool convert (const T& t, JSONWriter& writer, const Options& options)
+        {
+            constexpr auto fallbackVersion = detail::ForwardingSerialisationTraits<T>::marshallingVersion;
+            const auto versionToUse = options.getExplicitVersion()
+                                             .value_or (fallbackVersion);
+
+            if (versionToUse > fallbackVersion)
+            {
+                // The requested explicit version is higher than the declared version of the type.
+                return false;
+            }
+
+            WriterVisitor visitor { writer, versionToUse, options.getVersionIncluded() };
+            detail::doSave (visitor, t);
+            return visitor.finish();
+        }
+
+        std::optional<int> getVersion() const { return version; }
+
+        template <typename... Ts>
+        void operator() (Ts&&... ts)
+        {
+            (visit (std::forward<Ts> (ts)), ...);
+        }
+
+    private:
+        enum class State
+        {
+            empty,
+            primitive,
+            array,
+            object,
+            failed
+        };
+
+        WriterVisitor (JSONWriter& w, const std::optional<int>& explicitVersion, bool includeVersion)
+            : writer (w), version (explicitVersion), versionIncluded (includeVersion)
+        {
+            if (! (version.has_value() && includeVersion))
+                return;
+
+            writer.beginObject();
+            writer.writeName ("__version__");
+            writer.writeInt (*version);
+            state = State::object;
+        }
+
+        template <typename T>
+        void visit (const T& t)
+        {
+            if constexpr (std::is_integral_v<T>)
+                push ([&] { writer.writeInt ((int64) t); return true; });
+            else if constexpr (std::is_floating_point_v<T>)
+                push ([&] { writer.writeDouble ((double) t); return true; });
+            else
+                push ([&] { return convert (t); });
+        }
+
+        template <typename T>
+        void visit (const Named<T>& named)
+        {
+            if (state == State::failed)
+                return;
+
+            if (state == State::empty)
+            {
+                writer.beginObject();
+                state = State::object;
+            }
+
+            if (state != State::object)
+            {
+                // Serialisation failure! This may be caused by archiving a primitive or
+                // SerialisationSize, and then attempting to archive a named pair to the same
+                // archive instance.
+                // When using named pairs, *all* items serialised with a particular archiver must be
+                // named pairs.
+                jassertfalse;
+
+                state = State::failed;
+                return;
+            }
+
+            writer.writeName (named.name.data(), named.name.size());
+
+            if (! convert (named.value))
+                state = State::failed;
+        }
+
+        template <typename T>
+        void visit (const SerialisationSize<T>&)
+        {
+            if (state == State::empty)
+            {
+                writer.beginArray();
+                state = State::array;
+                return;
+            }
+
+            push ([&] { writer.beginArray(); writer.endArray(); return true; });
+        }
+
+        void visit (const bool& t)
+        {
+            push ([&] { writer.writeBool (t); return true; });
+        }
+
+        void visit (const String& t)
+        {
+            push ([&] { writer.writeString (t); return true; });
+        }
+
+        void visit (const var& t)
+        {
+            push ([&] { writer.writeVar (t); return true; });
+        }
+
+        template <typename T>
+        bool convert (const T& t)
+        {
+            return convert (t, writer, Options{}.withVersionIncluded (versionIncluded));
+        }
+
+        template <typename WriteValue>
+        void push (WriteValue&& writeValue)
+        {
+            if (state == State::empty)
+                state = State::primitive;
+            else if (state != State::array)
+                state = State::failed;
+
+            if (state != State::failed && ! writeValue())
+                state = State::failed;
+        }
+
+        bool finish()
+        {
+            switch (state)
+            {
+                case State::empty:      writer.writeNull(); return true;
+                case State::primitive:  return true;
+                case State::array:      writer.endArray(); return true;
+                case State::object:     writer.endObject(); return true;
+                case State::failed:     return false;
+            }
+
+            return false;
+        }
+
+        JSONWriter& writer;
+        std::optional<int> version;
+        bool versionIncluded = true;
+        State state = State::empty;
+    };
 };
 
 //==============================================================================
@@ -509,6 +509,47 @@ public:
                              JSONUtils::makeObject ({ { "eventId", 404 }, { "payload", payload } }));
         }
 
+        beginTest ("ToVar with a JSONWriter");
+        {
+            expectStreamedMatchesVar (false);
+            expectStreamedMatchesVar (1);
+            expectStreamedMatchesVar (5.0f);
+            expectStreamedMatchesVar (String ("hello world"));
+            expectStreamedMatchesVar (std::vector<int> { 1, 2, 3 });
+            expectStreamedMatchesVar (std::vector<std::vector<int>> { {}, { 1 }, {} });
+            expectStreamedMatchesVar (TypeWithExternalUnifiedSerialisation { 7,
+                                                                             "hello world",
+                                                                             { 5, 6, 7 },
+                                                                             { { "foo", 4 }, { "bar", 5 } } });
+            expectStreamedMatchesVar (TypeWithInternalUnifiedSerialisation { 7.89, 4.321f, "custom string", { "foo", "bar", "baz" } });
+            expectStreamedMatchesVar (TypeWithExternalSplitSerialisation { "string", { 1, 2, 3 } });
+            expectStreamedMatchesVar (TypeWithInternalSplitSerialisation { "string", { 16, 32, 48 } });
+            expectStreamedMatchesVar (TypeWithRawVarFirst { 200, "success", JSONUtils::makeObject ({ { "status", 123.456 } }) });
+            expectStreamedMatchesVar (TypeWithInnerVar { 404, JSONUtils::makeObject ({ { "foo", 1 }, { "bar", 2 } }) });
+
+            for (const auto& options : { ToVar::Options{},
+                                         ToVar::Options{}.withVersionIncluded (false),
+                                         ToVar::Options{}.withExplicitVersion (1),
+                                         ToVar::Options{}.withExplicitVersion (std::nullopt) })
+            {
+                expectStreamedMatchesVar (TypeWithVersionedSerialisation { 1, 2, 3, 4 }, options);
+            }
+
+            const auto streamingFails = [] (const auto& t, const ToVar::Options& options = {})
+            {
+                MemoryOutputStream stream;
+                JSONWriter writer (stream);
+                return ! ToVar::convert (t, writer, options);
+            };
+
+            expect (streamingFails (TypeWithVersionedSerialisation { 1, 2, 3, 4 }, ToVar::Options{}.withExplicitVersion (4)));
+            expect (streamingFails (TypeWithBrokenObjectSerialisation { 1, 2 }));
+            expect (streamingFails (TypeWithBrokenPrimitiveSerialisation { 1, 2 }));
+            expect (streamingFails (TypeWithBrokenArraySerialisation {}));
+            expect (streamingFails (TypeWithBrokenNestedSerialisation {}));
+            expect (streamingFails (TypeWithBrokenDynamicSerialisation { std::vector<TypeWithBrokenObjectSerialisation> (10) }));
+        }
+
         beginTest ("FromVar");
         {
             expect (FromVar::convert<bool> (JSON::fromString ("false")) == false);
@@ -607,6 +648,33 @@ public:
     }
 
 private:
+    template <typename T>
+    void expectStreamedMatchesVar (const T& t, const ToVar::Options& options = {})
+    {
+        const auto converted = ToVar::convert (t, options);
+        expect (converted.has_value());
+
+        for (auto spacing : { JSON::Spacing::none, JSON::Spacing::multiLine })
+        {
+            const auto format = JSON::FormatOptions{}.withSpacing (spacing);
+
+            MemoryOutputStream expected, streamed;
+
+            {
+                JSONWriter writer (expected, format);
+                writer.writeVar (converted.value_or (var()));
+            }
+
+            {
+                JSONWriter writer (streamed, format);
+                expect (ToVar::convert (t, writer, options));
+                expectEquals (writer.getDepth(), 0);
+            }
+
+            expectEquals (streamed.toString(), expected.toString());
+        }
+    }
+
     void expectDeepEqual (const std::optional<var>& a, const std::optional<var>& b)
     {
         const auto text = a.has_value() && b.has_value()
@@ -0,0 +1,748 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace JSONWriterHelpers
+{
+    //==============================================================================
+    // Shortest round-trip double formatting, using the Grisu2 algorithm described in
+    // "Printing Floating-Point Numbers Quickly and Accurately with Integers" (Loitsch, 2010),
+    // with the boundary handling from "Printing Floating-Point Numbers: A Faster, Always
+    // Correct Method" (Andrysco, Jhala & Lerner, 2016). The digits produced always read back
+    // as the original value, and are the shortest possible for almost every input.
+    struct DiyFp
+    {
+        uint64 f;
+        int e;
+
+        static DiyFp sub (DiyFp x, DiyFp y) noexcept
+        {
+            jassert (x.e == y.e && x.f >= y.f);
+            return { x.f - y.f, x.e };
+        }
+
+        // Returns the upper 64 bits of the product, rounded
+        static DiyFp mul (DiyFp x, DiyFp y) noexcept
+        {
+            const auto xLo = x.f & 0xffffffffu, xHi = x.f >> 32;
+            const auto yLo = y.f & 0xffffffffu, yHi = y.f >> 32;
+
+            const auto p0 = xLo * yLo;
+            const auto p1 = xLo * yHi;
+            const auto p2 = xHi * yLo;
+            const auto p3 = xHi * yHi;
+
+            auto q = (p0 >> 32) + (p1 & 0xffffffffu) + (p2 & 0xffffffffu);
+            q += (uint64) 1 << 31;
+
+            return { p3 + (p2 >> 32) + (p1 >> 32) + (q >> 32), x.e + y.e + 64 };
+        }
+
+        static DiyFp normalise (DiyFp x) noexcept
+        {
+            jassert (x.f != 0);
+
+            while ((x.f >> 63) == 0)
+            {
+                x.f <<= 1;
+                --x.e;
+            }
+
+            return x;
+        }
+
+        static DiyFp normaliseTo (DiyFp x, int targetExponent) noexcept
+        {
+            const auto delta = x.e - targetExponent;
+            jassert (delta >= 0 && ((x.f << delta) >> delta) == x.f);
+            return { x.f << delta, targetExponent };
+        }
+    };
+
+    struct Boundaries
+    {
+        DiyFp w, minus, plus;
+    };
+
+    static Boundaries computeBoundaries (double value) noexcept
+    {
+        constexpr int precision = 53;
+        constexpr int bias = 1023 + precision - 1;
+        constexpr int minExponent = 1 - bias;
+        constexpr uint64 hiddenBit = (uint64) 1 << (precision - 1);
+
+        uint64 bits;
+        std::memcpy (&bits, &value, sizeof (bits));
+
+        const auto biasedExponent = (int) (bits >> (precision - 1)) & 0x7ff;
+        const auto fraction = bits & (hiddenBit - 1);
+
+        const auto v = biasedExponent == 0 ? DiyFp { fraction, minExponent }
+                                           : DiyFp { fraction + hiddenBit, biasedExponent - bias };
+
+        // The gap to the next lower value is half as big when the fraction is zero
+        const auto lowerBoundaryIsCloser = fraction == 0 && biasedExponent > 1;
+
+        const auto plus = DiyFp::normalise ({ 2 * v.f + 1, v.e - 1 });
+        const auto minus = lowerBoundaryIsCloser ? DiyFp { 4 * v.f - 1, v.e - 2 }
+                                                 : DiyFp { 2 * v.f - 1, v.e - 1 };
+
+        return { DiyFp::normalise (v), DiyFp::normaliseTo (minus, plus.e), plus };
+    }
+
+    struct CachedPower
+    {
+        uint64 f;
+        int e, k;
+    };
+
+    // The exponent of the scaled value must lie in [alpha, gamma] so that its integral
+    // part fits into 32 bits.
+    constexpr int alpha = -60;
+    constexpr int gamma = -32;
+
+    static CachedPower getCachedPowerForBinaryExponent (int e) noexcept
+    {
+        // Normalised approximations of 10^k for k in [-300, 324], in steps of 8
+        static constexpr CachedPower cachedPowers[] =
+        {
+            { 0xab70fe17c79ac6caull, -1060, -300 }, { 0xff77b1fcbebcdc4full, -1034, -292 },
+            { 0xbe5691ef416bd60cull, -1007, -284 }, { 0x8dd01fad907ffc3cull,  -980, -276 },
+            { 0xd3515c2831559a83ull,  -954, -268 }, { 0x9d71ac8fada6c9b5ull,  -927, -260 },
+            { 0xea9c227723ee8bcbull,  -901, -252 }, { 0xaecc49914078536dull,  -874, -244 },
+            { 0x823c12795db6ce57ull,  -847, -236 }, { 0xc21094364dfb5637ull,  -821, -228 },
+            { 0x9096ea6f3848984full,  -794, -220 }, { 0xd77485cb25823ac7ull,  -768, -212 },
+            { 0xa086cfcd97bf97f4ull,  -741, -204 }, { 0xef340a98172aace5ull,  -715, -196 },
+            { 0xb23867fb2a35b28eull,  -688, -188 }, { 0x84c8d4dfd2c63f3bull,  -661, -180 },
+            { 0xc5dd44271ad3cdbaull,  -635, -172 }, { 0x936b9fcebb25c996ull,  -608, -164 },
+            { 0xdbac6c247d62a584ull,  -582, -156 }, { 0xa3ab66580d5fdaf6ull,  -555, -148 },
+            { 0xf3e2f893dec3f126ull,  -529, -140 }, { 0xb5b5ada8aaff80b8ull,  -502, -132 },
+            { 0x87625f056c7c4a8bull,  -475, -124 }, { 0xc9bcff6034c13053ull,  -449, -116 },
+            { 0x964e858c91ba2655ull,  -422, -108 }, { 0xdff9772470297ebdull,  -396, -100 },
+            { 0xa6dfbd9fb8e5b88full,  -369,  -92 }, { 0xf8a95fcf88747d94ull,  -343,  -84 },
+            { 0xb94470938fa89bcfull,  -316,  -76 }, { 0x8a08f0f8bf0f156bull,  -289,  -68 },
+            { 0xcdb02555653131b6ull,  -263,  -60 }, { 0x993fe2c6d07b7facull,  -236,  -52 },
+            { 0xe45c10c42a2b3b06ull,  -210,  -44 }, { 0xaa242499697392d3ull,  -183,  -36 },
+            { 0xfd87b5f28300ca0eull,  -157,  -28 }, { 0xbce5086492111aebull,  -130,  -20 },
+            { 0x8cbccc096f5088ccull,  -103,  -12 }, { 0xd1b71758e219652cull,   -77,   -4 },
+            { 0x9c40000000000000ull,   -50,    4 }, { 0xe8d4a51000000000ull,   -24,   12 },
+            { 0xad78ebc5ac620000ull,     3,   20 }, { 0x813f3978f8940984ull,    30,   28 },
+            { 0xc097ce7bc90715b3ull,    56,   36 }, { 0x8f7e32ce7bea5c70ull,    83,   44 },
+            { 0xd5d238a4abe98068ull,   109,   52 }, { 0x9f4f2726179a2245ull,   136,   60 },
+            { 0xed63a231d4c4fb27ull,   162,   68 }, { 0xb0de65388cc8ada8ull,   189,   76 },
+            { 0x83c7088e1aab65dbull,   216,   84 }, { 0xc45d1df942711d9aull,   242,   92 },
+            { 0x924d692ca61be758ull,   269,  100 }, { 0xda01ee641a708deaull,   295,  108 },
+            { 0xa26da3999aef774aull,   322,  116 }, { 0xf209787bb47d6b85ull,   348,  124 },
+            { 0xb454e4a179dd1877ull,   375,  132 }, { 0x865b86925b9bc5c2ull,   402,  140 },
+            { 0xc83553c5c8965d3dull,   428,  148 }, { 0x952ab45cfa97a0b3ull,   455,  156 },
+            { 0xde469fbd99a05fe3ull,   481,  164 }, { 0xa59bc234db398c25ull,   508,  172 },
+            { 0xf6c69a72a3989f5cull,   534,  180 }, { 0xb7dcbf5354e9beceull,   561,  188 },
+            { 0x88fcf317f22241e2ull,   588,  196 }, { 0xcc20ce9bd35c78a5ull,   614,  204 },
+            { 0x98165af37b2153dfull,   641,  212 }, { 0xe2a0b5dc971f303aull,   667,  220 },
+            { 0xa8d9d1535ce3b396ull,   694,  228 }, { 0xfb9b7cd9a4a7443cull,   720,  236 },
+            { 0xbb764c4ca7a44410ull,   747,  244 }, { 0x8bab8eefb6409c1aull,   774,  252 },
+            { 0xd01fef10a657842cull,   800,  260 }, { 0x9b10a4e5e9913129ull,   827,  268 },
+            { 0xe7109bfba19c0c9dull,   853,  276 }, { 0xac2820d9623bf429ull,   880,  284 },
+            { 0x80444b5e7aa7cf85ull,   907,  292 }, { 0xbf21e44003acdd2dull,   933,  300 },
+            { 0x8e679c2f5e44ff8full,   960,  308 }, { 0xd433179d9c8cb841ull,   986,  316 },
+            { 0x9e19db92b4e31ba9ull,  1013,  324 },
+        };
+
+        constexpr int minDecimalExponent = -300;
+        constexpr int decimalStep = 8;
+
+        const auto f = alpha - e - 1;
+        const auto k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+        const auto index = (-minDecimalExponent + k + (decimalStep - 1)) / decimalStep;
+
+        jassert (isPositiveAndBelow (index, (int) numElementsInArray (cachedPowers)));
+
+        const auto cached = cachedPowers[index];
+        jassert (alpha <= cached.e + e + 64 && cached.e + e + 64 <= gamma);
+        return cached;
+    }
+
+    static int findLargestPow10 (uint32 n, uint32& pow10) noexcept
+    {
+        if (n >= 1000000000) { pow10 = 1000000000; return 10; }
+        if (n >= 100000000)  { pow10 = 100000000;  return 9; }
+        if (n >= 10000000)   { pow10 = 10000000;   return 8; }
+        if (n >= 1000000)    { pow10 = 1000000;    return 7; }
+        if (n >= 100000)     { pow10 = 100000;     return 6; }
+        if (n >= 10000)      { pow10 = 10000;      return 5; }
+        if (n >= 1000)       { pow10 = 1000;       return 4; }
+        if (n >= 100)        { pow10 = 100;        return 3; }
+        if (n >= 10)         { pow10 = 10;         return 2; }
+
+        pow10 = 1;
+        return 1;
+    }
+
+    static void roundWeed (char* digits, int numDigits, uint64 dist, uint64 delta, uint64 rest, uint64 tenK) noexcept
+    {
+        // Moves the last digit towards the exact value while the result stays inside the
+        // rounding interval.
+        while (rest < dist
+               && delta - rest >= tenK
+               && (rest + tenK < dist || dist - rest > rest + tenK - dist))
+        {
+            --digits[numDigits - 1];
+            rest += tenK;
+        }
+    }
+
+    static int generateDigits (char* digits, int& decimalExponent, DiyFp minus, DiyFp w, DiyFp plus) noexcept
+    {
+        auto delta = DiyFp::sub (plus, minus).f;
+        auto dist  = DiyFp::sub (plus, w).f;
+
+        const DiyFp one { (uint64) 1 << -plus.e, plus.e };
+
+        auto p1 = (uint32) (plus.f >> -one.e);
+        auto p2 = plus.f & (one.f - 1);
+
+        uint32 pow10 = 0;
+        auto n = findLargestPow10 (p1, pow10);
+        int numDigits = 0;
+
+        while (n > 0)
+        {
+            const auto d = p1 / pow10;
+            p1 %= pow10;
+            digits[numDigits++] = (char) ('0' + d);
+            --n;
+
+            const auto rest = ((uint64) p1 << -one.e) + p2;
+
+            if (rest <= delta)
+            {
+                decimalExponent += n;
+                roundWeed (digits, numDigits, dist, delta, rest, (uint64) pow10 << -one.e);
+                return numDigits;
+            }
+
+            pow10 /= 10;
+        }
+
+        int m = 0;
+
+        for (;;)
+        {
+            p2 *= 10;
+            const auto d = p2 >> -one.e;
+            p2 &= one.f - 1;
+            digits[numDigits++] = (char) ('0' + d);
+            ++m;
+
+            delta *= 10;
+            dist  *= 10;
+
+            if (p2 <= delta)
+                break;
+        }
+
+        decimalExponent -= m;
+        roundWeed (digits, numDigits, dist, delta, p2, one.f);
+        return numDigits;
+    }
+
+    // Writes the digits of a finite, positive value, and sets decimalExponent so that the
+    // value is digits * 10^decimalExponent.
+    static int getShortestDigits (double value, char* digits, int& decimalExponent) noexcept
+    {
+        const auto b = computeBoundaries (value);
+        const auto cached = getCachedPowerForBinaryExponent (b.plus.e);
+        const DiyFp c { cached.f, cached.e };
+
+        const auto w      = DiyFp::mul (b.w, c);
+        const auto wMinus = DiyFp::mul (b.minus, c);
+        const auto wPlus  = DiyFp::mul (b.plus, c);
+
+        // Shrink the interval by one unit on each side to allow for the error in the products
+        decimalExponent = -cached.k;
+        return generateDigits (digits, decimalExponent, { wMinus.f + 1, wMinus.e }, w, { wPlus.f - 1, wPlus.e });
+    }
+
+    //==============================================================================
+    static constexpr char digitPairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    // Writes the digits backwards from the end of a buffer, returning the start.
+    static char* writeUnsigned (uint64 n, char* end) noexcept
+    {
+        while (n >= 100)
+        {
+            const auto pair = (size_t) (n % 100) * 2;
+            n /= 100;
+            *--end = digitPairs[pair + 1];
+            *--end = digitPairs[pair];
+        }
+
+        if (n >= 10)
+        {
+            const auto pair = (size_t) n * 2;
+            *--end = digitPairs[pair + 1];
+            *--end = digitPairs[pair];
+        }
+        else
+        {
+            *--end = (char) ('0' + n);
+        }
+
+        return end;
+    }
+
+    static char* writeExponent (int exponent, char* dest) noexcept
+    {
+        *dest++ = 'e';
+
+        if (exponent < 0)
+        {
+            *dest++ = '-';
+            exponent = -exponent;
+        }
+
+        char buffer[4];
+        auto* end = buffer + numElementsInArray (buffer);
+        auto* start = writeUnsigned ((uint64) exponent, end);
+        std::memcpy (dest, start, (size_t) (end - start));
+        return dest + (end - start);
+    }
+
+    //==============================================================================
+    static bool isSafeStringByte (uint8 c) noexcept
+    {
+        return c >= 0x20 && c != '"' && c != '\\';
+    }
+}
+
+//==============================================================================
+int JSONWriter::formatDouble (double value, char* buffer) noexcept
+{
+    using namespace JSONWriterHelpers;
+
+    jassert (juce_isfinite (value));
+
+    auto* dest = buffer;
+
+    if (std::signbit (value))
+    {
+        *dest++ = '-';
+        value = -value;
+    }
+
+    if (exactlyEqual (value, 0.0))
+    {
+        std::memcpy (dest, "0.0", 3);
+        return (int) (dest + 3 - buffer);
+    }
+
+    char digits[20];
+    int decimalExponent = 0;
+    const auto numDigits = getShortestDigits (value, digits, decimalExponent);
+
+    // The position of the decimal point relative to the first digit
+    const auto point = numDigits + decimalExponent;
+
+    // Use the same thresholds as JSON::writeToStream() for switching to scientific notation,
+    // i.e. anything at or below 1.0e-5, or at or above 1.0e6.
+    const auto isOneEMinus5 = point == -4 && numDigits == 1 && digits[0] == '1';
+
+    if (point > 6 || point < -4 || isOneEMinus5)
+    {
+        *dest++ = digits[0];
+        *dest++ = '.';
+
+        if (numDigits > 1)
+        {
+            std::memcpy (dest, digits + 1, (size_t) numDigits - 1);
+            dest += numDigits - 1;
+        }
+        else
+        {
+            *dest++ = '0';
+        }
+
+        dest = writeExponent (point - 1, dest);
+    }
+    else if (point >= numDigits)
+    {
+        std::memcpy (dest, digits, (size_t) numDigits);
+        dest += numDigits;
+        std::memset (dest, '0', (size_t) (point - numDigits));
+        dest += point - numDigits;
+        *dest++ = '.';
+        *dest++ = '0';
+    }
+    else if (point > 0)
+    {
+        std::memcpy (dest, digits, (size_t) point);
+        dest += point;
+        *dest++ = '.';
+        std::memcpy (dest, digits + point, (size_t) (numDigits - point));
+        dest += numDigits - point;
+    }
+    else
+    {
+        *dest++ = '0';
+        *dest++ = '.';
+        std::memset (dest, '0', (size_t) -point);
+        dest += -point;
+        std::memcpy (dest, digits, (size_t) numDigits);
+        dest += numDigits;
+    }
+
+    return (int) (dest - buffer);
+}
+
+//==============================================================================
+JSONWriter::JSONWriter (OutputStream& destination, const JSON::FormatOptions& formatOptions)
+    : output (destination), format (formatOptions)
+{
+}
+
+void JSONWriter::writeIndent (int depth)
+{
+    output.writeRepeatedByte (' ', (size_t) (format.getIndentLevel() + depth * JSONFormatter::indentSize));
+}
+
+void JSONWriter::writeSeparator (Level& level)
+{
+    if (level.numItems++ > 0)
+    {
+        output.writeByte (',');
+
+        switch (format.getSpacing())
+        {
+            case JSON::Spacing::none: break;
+            case JSON::Spacing::singleLine: output.writeByte (' '); break;
+            case JSON::Spacing::multiLine: output << newLine; break;
+        }
+    }
+    else if (format.getSpacing() == JSON::Spacing::multiLine && ! level.isObject)
+    {
+        // Objects always start with a newline, but arrays only need one when they're not empty
+        output << newLine;
+    }
+
+    if (format.getSpacing() == JSON::Spacing::multiLine)
+        writeIndent ((int) levels.size());
+}
+
+void JSONWriter::beginValue()
+{
+    if (levels.empty())
+        return;
+
+    auto& level = levels.back();
+
+    if (level.isObject)
+    {
+        // Each value inside an object must be preceded by a call to writeName()!
+        jassert (nameWritten);
+        nameWritten = false;
+        return;
+    }
+
+    writeSeparator (level);
+}
+
+//==============================================================================
+void JSONWriter::beginObject()
+{
+    beginValue();
+    output.writeByte ('{');
+
+    if (format.getSpacing() == JSON::Spacing::multiLine)
+        output << newLine;
+
+    levels.push_back ({ true, 0 });
+}
+
+void JSONWriter::endObject()
+{
+    // This must match a previous call to beginObject(), and the last name must have been given a value
+    jassert (! levels.empty() && levels.back().isObject && ! nameWritten);
+
+    if (levels.empty())
+        return;
+
+    const auto numItems = levels.back().numItems;
+    levels.pop_back();
+
+    if (format.getSpacing() == JSON::Spacing::multiLine)
+    {
+        if (numItems > 0)
+            output << newLine;
+
+        writeIndent ((int) levels.size());
+    }
+
+    output.writeByte ('}');
+}
+
+void JSONWriter::beginArray()
+{
+    beginValue();
+    output.writeByte ('[');
+    levels.push_back ({ false, 0 });
+}
+
+void JSONWriter::endArray()
+{
+    // This must match a previous call to beginArray()
+    jassert (! levels.empty() && ! levels.back().isObject);
+
+    if (levels.empty())
+        return;
+
+    const auto numItems = levels.back().numItems;
+    levels.pop_back();
+
+    if (format.getSpacing() == JSON::Spacing::multiLine && numItems > 0)
+    {
+        output << newLine;
+        writeIndent ((int) levels.size());
+    }
+
+    output.writeByte (']');
+}
+
+void JSONWriter::writeName (StringRef name)
+{
+    writeName (name.text.getAddress(), name.text.sizeInBytes() - 1);
+}
+
+void JSONWriter::writeName (const char* utf8, size_t numBytes)
+{
+    // Names can only be written inside an object, and each name must be followed by a value
+    jassert (! levels.empty() && levels.back().isObject && ! nameWritten);
+
+    if (! levels.empty())
+        writeSeparator (levels.back());
+
+    output.writeByte ('"');
+    writeEscaped (utf8, numBytes);
+    output.write (format.getSpacing() != JSON::Spacing::none ? "\": " : "\":",
+                  format.getSpacing() != JSON::Spacing::none ? 3 : 2);
+
+    nameWritten = true;
+}
+
+//==============================================================================
+void JSONWriter::writeEscaped (const char* utf8, size_t numBytes)
+{
+    if (format.getEncoding() == JSON::Encoding::ascii)
+    {
+        JSONFormatter::writeString (output, String (CharPointer_UTF8 (utf8), CharPointer_UTF8 (utf8 + numBytes)).getCharPointer(), format.getEncoding());
+        return;
+    }
+
+    const auto* end = utf8 + numBytes;
+
+    while (utf8 < end)
+    {
+        auto* safeEnd = utf8;
+
+        while (safeEnd < end && JSONWriterHelpers::isSafeStringByte ((uint8) *safeEnd))
+            ++safeEnd;
+
+        if (safeEnd != utf8)
+        {
+            writeRaw (utf8, (size_t) (safeEnd - utf8));
+            utf8 = safeEnd;
+
+            if (utf8 == end)
+                break;
+        }
+
+        const auto c = (uint8) *utf8++;
+
+        switch (c)
+        {
+            case '\"': writeRaw ("\\\"", 2); break;
+            case '\\': writeRaw ("\\\\", 2); break;
+            case '\b': writeRaw ("\\b", 2);  break;
+            case '\f': writeRaw ("\\f", 2);  break;
+            case '\t': writeRaw ("\\t", 2);  break;
+            case '\r': writeRaw ("\\r", 2);  break;
+            case '\n': writeRaw ("\\n", 2);  break;
+
+            default:
+            {
+                const char escaped[] = { '\\', 'u', '0', '0', "0123456789abcdef"[c >> 4], "0123456789abcdef"[c & 15] };
+                writeRaw (escaped, sizeof (escaped));
+                break;
+            }
+        }
+    }
+}
+
+void JSONWriter::writeString (StringRef value)
+{
+    writeString (value.text.getAddress(), value.text.sizeInBytes() - 1);
+}
+
+void JSONWriter::writeString (const char* utf8, size_t numBytes)
+{
+    beginValue();
+    output.writeByte ('"');
+    writeEscaped (utf8, numBytes);
+    output.writeByte ('"');
+}
+
+void JSONWriter::writeInt (int64 value)
+{
+    beginValue();
+
+    char buffer[24];
+    auto* end = buffer + numElementsInArray (buffer);
+    const auto magnitude = value < 0 ? (uint64) 0 - (uint64) value : (uint64) value;
+    auto* start = JSONWriterHelpers::writeUnsigned (magnitude, end);
+
+    if (value < 0)
+        *--start = '-';
+
+    writeRaw (start, (size_t) (end - start));
+}
+
+void JSONWriter::writeDouble (double value)
+{
+    if (! juce_isfinite (value))
+    {
+        writeNull();
+        return;
+    }
+
+    beginValue();
+
+    char buffer[32];
+    writeRaw (buffer, (size_t) formatDouble (value, buffer));
+}
+
+void JSONWriter::writeBool (bool value)
+{
+    beginValue();
+
+    if (value)
+        writeRaw ("true", 4);
+    else
+        writeRaw ("false", 5);
+}
+
+void JSONWriter::writeNull()
+{
+    beginValue();
+    writeRaw ("null", 4);
+}
+
+void JSONWriter::writeVar (const var& value)
+{
+    if (value.isString())
+    {
+        writeString (value.toString());
+    }
+    else if (value.isVoid())
+    {
+        writeNull();
+    }
+    else if (value.isUndefined())
+    {
+        beginValue();
+        writeRaw ("undefined", 9);
+    }
+    else if (value.isBool())
+    {
+        writeBool (static_cast<bool> (value));
+    }
+    else if (value.isInt() || value.isInt64())
+    {
+        writeInt (static_cast<int64> (value));
+    }
+    else if (value.isDouble())
+    {
+        writeDouble (static_cast<double> (value));
+    }
+    else if (auto* array = value.getArray())
+    {
+        beginArray();
+
+        for (auto& element : *array)
+            writeVar (element);
+
+        endArray();
+    }
+    else if (auto* object = value.getDynamicObject())
+    {
+        if (typeid (*object) == typeid (DynamicObject))
+        {
+            beginObject();
+
+            for (auto& property : object->getProperties())
+            {
+                writeName (property.name.toString());
+                writeVar (property.value);
+            }
+
+            endObject();
+        }
+        else
+        {
+            // Custom object types may override writeAsJSON(), so let them write themselves
+            beginValue();
+            object->writeAsJSON (output, format.withIndentLevel (format.getIndentLevel() + (int) levels.size() * JSONFormatter::indentSize));
+        }
+    }
+    else
+    {
+        // Can't convert these other types of object to JSON!
+        jassert (! (value.isObject() || value.isMethod() || value.isBinaryData()));
+
+        beginValue();
+        output << value.toString();
+    }
+}
+
+} // namespace juce
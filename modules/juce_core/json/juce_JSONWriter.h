@@ -0,0 +1,161 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Writes JSON directly to an OutputStream, one item at a time.
+
+    This lets you produce a JSON document without first building a var to represent
+    it, which is much faster when writing a large number of records.
+
+    The output uses the same layout as JSON::writeToStream() for the given
+    JSON::FormatOptions. Doubles are written using the shortest sequence of digits
+    that reads back as the same value, so the maximum number of decimal places in
+    the options is ignored. Like JSON::writeToStream(), non-finite doubles are
+    written as null, and doubles with no fractional part are written with a trailing
+    ".0" so that they're read back as doubles.
+
+    @code
+    JSONWriter writer (stream);
+    writer.beginObject();
+    writer.writeName ("name");
+    writer.writeString ("example");
+    writer.writeName ("values");
+    writer.beginArray();
+
+    for (auto v : values)
+        writer.writeDouble (v);
+
+    writer.endArray();
+    writer.endObject();
+    @endcode
+
+    The writer checks (with assertions) that calls are made in a sensible order, e.g.
+    that each value inside an object is preceded by a name, but it's up to you to make
+    sure that every object and array is ended.
+
+    @see JSON, JSONEventParser, ToVar
+
+    @tags{Core}
+*/
+class JUCE_API  JSONWriter
+{
+public:
+    //==============================================================================
+    /** Creates a writer which will write to the given stream. The stream must outlive
+        the writer. By default the output is as compact as possible.
+    */
+    explicit JSONWriter (OutputStream& destination,
+                         const JSON::FormatOptions& formatOptions = JSON::FormatOptions{}.withSpacing (JSON::Spacing::none));
+
+    //==============================================================================
+    /** Starts a new object. */
+    void beginObject();
+
+    /** Ends the object that was most recently started. */
+    void endObject();
+
+    /** Starts a new array. */
+    void beginArray();
+
+    /** Ends the array that was most recently started. */
+    void endArray();
+
+    /** Writes the name of the next property inside an object. */
+    void writeName (StringRef name);
+
+    /** Writes the name of the next property inside an object, from a block of UTF-8 data
+        which doesn't need to be null-terminated.
+    */
+    void writeName (const char* utf8, size_t numBytes);
+
+    //==============================================================================
+    /** Writes a string value. */
+    void writeString (StringRef value);
+
+    /** Writes a string value from a block of UTF-8 data which doesn't need to be null-terminated. */
+    void writeString (const char* utf8, size_t numBytes);
+
+    /** Writes an integer value. */
+    void writeInt (int64 value);
+
+    /** Writes a floating-point value. */
+    void writeDouble (double value);
+
+    /** Writes true or false. */
+    void writeBool (bool value);
+
+    /** Writes null. */
+    void writeNull();
+
+    /** Writes a var, in the same way as JSON::writeToStream(). */
+    void writeVar (const var& value);
+
+    //==============================================================================
+    /** Returns the number of objects and arrays which have been started but not ended. */
+    int getDepth() const noexcept                   { return (int) levels.size(); }
+
+    /** Writes the shortest decimal representation of a finite double that reads back as the
+        same value, in the format used by JSONWriter, and returns the number of characters written.
+
+        The buffer must have space for at least 32 characters. No null terminator is added.
+    */
+    static int formatDouble (double value, char* buffer) noexcept;
+
+private:
+    //==============================================================================
+    struct Level
+    {
+        bool isObject = false;
+        int numItems = 0;
+    };
+
+    void writeSeparator (Level&);
+    void writeIndent (int depth);
+    void beginValue();
+    void writeEscaped (const char* utf8, size_t numBytes);
+    void writeRaw (const char* text, size_t numBytes)     { output.write (text, numBytes); }
+
+    OutputStream& output;
+    JSON::FormatOptions format;
+    std::vector<Level> levels;
+    bool nameWritten = false;
+
+    JUCE_DECLARE_NON_COPYABLE (JSONWriter)
+};
+
+} // namespace juce
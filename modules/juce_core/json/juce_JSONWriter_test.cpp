@@ -0,0 +1,262 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class JSONWriterTests final : public UnitTest
+{
+public:
+    JSONWriterTests()
+        : UnitTest ("JSONWriter", UnitTestCategories::json)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Output matches JSON::writeToStream for every format");
+        {
+            auto r = getRandom();
+
+            for (int i = 0; i < 50; ++i)
+            {
+                const auto v = createRandomContainer (r, 0);
+
+                for (auto spacing : { JSON::Spacing::none, JSON::Spacing::singleLine, JSON::Spacing::multiLine })
+                    for (auto encoding : { JSON::Encoding::utf8, JSON::Encoding::ascii })
+                        for (auto indent : { 0, 4 })
+                            expectSameAsJSONToString (v, JSON::FormatOptions{}.withSpacing (spacing)
+                                                                             .withEncoding (encoding)
+                                                                             .withIndentLevel (indent));
+            }
+
+            for (const auto& v : { var(), var (Array<var>{}), var (new DynamicObject), var (Array<var> { Array<var>{}, var (new DynamicObject) }) })
+                for (auto spacing : { JSON::Spacing::none, JSON::Spacing::singleLine, JSON::Spacing::multiLine })
+                    expectSameAsJSONToString (v, JSON::FormatOptions{}.withSpacing (spacing));
+        }
+
+        beginTest ("Items can be written one at a time");
+        {
+            MemoryOutputStream stream;
+            JSONWriter writer (stream);
+
+            writer.beginObject();
+            writer.writeName ("a");
+            writer.beginArray();
+            writer.writeInt (1);
+            writer.writeDouble (2.5);
+            writer.writeString ("x");
+            writer.writeBool (true);
+            writer.writeNull();
+            writer.beginObject();
+            writer.endObject();
+            writer.endArray();
+            writer.writeName ("b\"c", 3);
+            writer.writeString ("d\ne", 3);
+            writer.endObject();
+
+            expectEquals (writer.getDepth(), 0);
+            expectEquals (stream.toString(), String (R"({"a":[1,2.5,"x",true,null,{}],"b\"c":"d\ne"})"));
+        }
+
+        beginTest ("Integers");
+        {
+            for (auto n : { (int64) 0, (int64) 7, (int64) -7, (int64) 10, (int64) 99, (int64) 100, (int64) -12345,
+                            (int64) 1234567890123, std::numeric_limits<int64>::max(), std::numeric_limits<int64>::min() })
+            {
+                expectEquals (writeToString ([n] (auto& w) { w.writeInt (n); }), String (n));
+            }
+        }
+
+        beginTest ("Strings are escaped");
+        {
+            expectEquals (writeToString ([] (auto& w) { w.writeString ("a\"b\\c/d\b\f\n\r\t\x01\x1f"); }),
+                          String (R"("a\"b\\c/d\b\f\n\r\t\u0001\u001f")"));
+            expectEquals (writeToString ([] (auto& w) { w.writeString ("a\0b", 3); }),
+                          String (R"("a\u0000b")"));
+
+            const auto* utf8 = "\xc3\xa9\xf0\x9f\x98\x80";
+            expectEquals (writeToString ([=] (auto& w) { w.writeString (CharPointer_UTF8 (utf8)); }),
+                          "\"" + String (CharPointer_UTF8 (utf8)) + "\"");
+            expectEquals (writeToString ([=] (auto& w) { w.writeString (CharPointer_UTF8 (utf8)); },
+                                         JSON::FormatOptions{}.withEncoding (JSON::Encoding::ascii)),
+                          String (R"("\u00e9\ud83d\ude00")"));
+        }
+
+        beginTest ("Doubles use the shortest representation");
+        {
+            const std::pair<double, const char*> tests[]
+            {
+                { 0.0,                      "0.0" },
+                { -0.0,                     "-0.0" },
+                { 1.0,                      "1.0" },
+                { 1.1,                      "1.1" },
+                { 0.1,                      "0.1" },
+                { 0.3,                      "0.3" },
+                { 0.1 + 0.2,                "0.30000000000000004" },
+                { 1.01,                     "1.01" },
+                { 0.76378,                  "0.76378" },
+                { -10.0,                    "-10.0" },
+                { 10.01,                    "10.01" },
+                { 0.0123,                   "0.0123" },
+                { -3.7e-27,                 "-3.7e-27" },
+                { 1e+40,                    "1.0e40" },
+                { -12345678901234567.0,     "-1.2345678901234568e16" },
+                { 192000.0,                 "192000.0" },
+                { 999999.0,                 "999999.0" },
+                { 1000000.0,                "1.0e6" },
+                { 1234567.0,                "1.234567e6" },
+                { 0.00006,                  "0.00006" },
+                { 0.00001,                  "1.0e-5" },
+                { 0.000006,                 "6.0e-6" },
+                { 5e-324,                   "5.0e-324" },
+                { 1.7976931348623157e308,   "1.7976931348623157e308" },
+                { 2.2250738585072014e-308,  "2.2250738585072014e-308" },
+            };
+
+            for (const auto& [value, expected] : tests)
+                expectEquals (writeToString ([value = value] (auto& w) { w.writeDouble (value); }), String (expected));
+
+            expectEquals (writeToString ([] (auto& w) { w.writeDouble (std::numeric_limits<double>::quiet_NaN()); }), String ("null"));
+            expectEquals (writeToString ([] (auto& w) { w.writeDouble (std::numeric_limits<double>::infinity()); }), String ("null"));
+        }
+
+        beginTest ("Doubles read back as the same value");
+        {
+            auto r = getRandom();
+
+            for (int i = 0; i < 100000; ++i)
+            {
+                const auto bits = (uint64) r.nextInt64();
+                double value;
+                std::memcpy (&value, &bits, sizeof (value));
+
+                if (! juce_isfinite (value))
+                    continue;
+
+                expectRoundTrip (value);
+            }
+
+            for (int i = 0; i < 10000; ++i)
+                expectRoundTrip ((r.nextDouble() - 0.5) * std::pow (10.0, r.nextInt ({ -20, 20 })));
+
+            for (int i = 1; i < 1000; ++i)
+                expectRoundTrip (i / 100.0);
+        }
+    }
+
+private:
+    template <typename Fn>
+    static String writeToString (Fn&& fn, const JSON::FormatOptions& format = JSON::FormatOptions{}.withSpacing (JSON::Spacing::none))
+    {
+        MemoryOutputStream stream;
+        JSONWriter writer (stream, format);
+        fn (writer);
+        return stream.toString();
+    }
+
+    void expectSameAsJSONToString (const var& v, const JSON::FormatOptions& format)
+    {
+        expectEquals (writeToString ([&] (auto& w) { w.writeVar (v); }, format),
+                      JSON::toString (v, format));
+    }
+
+    void expectRoundTrip (double value)
+    {
+        char buffer[32];
+        const auto length = JSONWriter::formatDouble (value, buffer);
+        expect (isPositiveAndBelow (length, (int) numElementsInArray (buffer)));
+
+        const std::string text (buffer, (size_t) length);
+        const auto parsed = std::strtod (text.c_str(), nullptr);
+
+        if (! exactlyEqual (parsed, value))
+            expect (false, String (text) + " read back as " + String (parsed, 17));
+
+        // The shortest representation never needs more than 17 significant digits
+        expectLessOrEqual (length, 25);
+    }
+
+    static String createRandomString (Random& r)
+    {
+        const juce_wchar specials[] = { '"', '\\', '\n', '\t', 1, 0x1f, 0xe9, 0x20ac, 0x1f600 };
+        String s;
+
+        for (int i = r.nextInt (12); --i >= 0;)
+            s << String::charToString (r.nextInt (3) == 0 ? specials[r.nextInt ((int) numElementsInArray (specials))]
+                                                          : (juce_wchar) r.nextInt ({ 32, 127 }));
+
+        return s;
+    }
+
+    // Doubles are left out, because JSON::writeToStream uses a different number format
+    static var createRandomPrimitive (Random& r)
+    {
+        switch (r.nextInt (5))
+        {
+            case 0:  return {};
+            case 1:  return r.nextBool();
+            case 2:  return r.nextInt();
+            case 3:  return r.nextInt64();
+            default: return createRandomString (r);
+        }
+    }
+
+    static var createRandomContainer (Random& r, int depth)
+    {
+        const auto numItems = r.nextInt (6);
+
+        if (r.nextBool())
+        {
+            Array<var> array;
+
+            for (int i = 0; i < numItems; ++i)
+                array.add (depth < 3 && r.nextInt (3) == 0 ? createRandomContainer (r, depth + 1) : createRandomPrimitive (r));
+
+            return array;
+        }
+
+        auto* object = new DynamicObject();
+        var result (object);
+
+        for (int i = 0; i < numItems; ++i)
+            object->setProperty ("p" + String (i) + createRandomString (r),
+                                 depth < 3 && r.nextInt (3) == 0 ? createRandomContainer (r, depth + 1) : createRandomPrimitive (r));
+
+        return result;
+    }
+};
+
+static JSONWriterTests jsonWriterTests;
+
+} // namespace juce
@@ -53,6 +53,12 @@
 #include <locale>
 #include <thread>
 
+#if JUCE_INTEL
+ #include <emmintrin.h>
+#elif JUCE_ARM && defined (__ARM_NEON)
+ #include <arm_neon.h>
+#endif
+
 #if ! (JUCE_ANDROID || JUCE_BSD)
  #include <sys/timeb.h>
  #include <cwctype>
@@ -192,9 +198,12 @@
 #include "containers/juce_Variant.cpp"
 #include "json/juce_JSON.cpp"
 #include "json/juce_JSONUtils.cpp"
+#include "json/juce_JSONEventParser.cpp"
+#include "json/juce_JSONWriter.cpp"
 #include "containers/juce_DynamicObject.cpp"
 #include "xml/juce_XmlDocument.cpp"
 #include "xml/juce_XmlElement.cpp"
+#include "xml/juce_XmlStreamReader.cpp"
 #include "zip/juce_GZIPDecompressorInputStream.cpp"
 #include "zip/juce_GZIPCompressorOutputStream.cpp"
 #include "zip/juce_ZipFile.cpp"
@@ -287,13 +296,19 @@
 //==============================================================================
 #if JUCE_UNIT_TESTS
  #include "containers/juce_HashMap_test.cpp"
+ #include "containers/juce_FlatHashMap_test.cpp"
+ #include "containers/juce_NamedValueSet_test.cpp"
  #include "containers/juce_Optional_test.cpp"
  #include "containers/juce_Enumerate_test.cpp"
  #include "containers/juce_ListenerList_test.cpp"
+ #include "containers/juce_LockFreeQueue_test.cpp"
  #include "maths/juce_MathsFunctions_test.cpp"
  #include "misc/juce_EnumHelpers_test.cpp"
  #include "containers/juce_FixedSizeFunction_test.cpp"
  #include "json/juce_JSONSerialisation_test.cpp"
+ #include "json/juce_JSONEventParser_test.cpp"
+ #include "json/juce_JSONWriter_test.cpp"
+ #include "xml/juce_XmlStreamReader_test.cpp"
  #include "memory/juce_SharedResourcePointer_test.cpp"
  #include "text/juce_CharPointer_UTF8_test.cpp"
  #include "text/juce_CharPointer_UTF16_test.cpp"
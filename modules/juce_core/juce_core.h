@@ -286,6 +286,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "containers/juce_AbstractFifo.h"
 #include "containers/juce_SingleThreadedAbstractFifo.h"
 #include "text/juce_NewLine.h"
+#include "containers/juce_FlatHashMap.h"
 #include "text/juce_StringPool.h"
 #include "text/juce_Identifier.h"
 #include "text/juce_StringArray.h"
@@ -297,6 +298,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "text/juce_Base64.h"
 #include "misc/juce_Functional.h"
 #include "containers/juce_Span.h"
+#include "containers/juce_LockFreeQueue.h"
 #include "misc/juce_Result.h"
 #include "misc/juce_Uuid.h"
 #include "misc/juce_ConsoleApplication.h"
@@ -328,6 +330,8 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "streams/juce_FileInputSource.h"
 #include "logging/juce_FileLogger.h"
 #include "json/juce_JSONUtils.h"
+#include "json/juce_JSONEventParser.h"
+#include "json/juce_JSONWriter.h"
 #include "serialisation/juce_Serialisation.h"
 #include "json/juce_JSONSerialisation.h"
 #include "maths/juce_BigInteger.h"
@@ -360,6 +364,7 @@ JUCE_END_IGNORE_WARNINGS_MSVC
 #include "unit_tests/juce_UnitTest.h"
 #include "xml/juce_XmlDocument.h"
 #include "xml/juce_XmlElement.h"
+#include "xml/juce_XmlStreamReader.h"
 #include "zip/juce_GZIPCompressorOutputStream.h"
 #include "zip/juce_GZIPDecompressorInputStream.h"
 #include "zip/juce_ZipFile.h"
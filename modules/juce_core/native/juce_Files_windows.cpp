@@ -531,6 +531,28 @@ void MemoryMappedFile::openInternal (const File& file, AccessMode mode, bool exc
     }
 }
 
+void MemoryMappedFile::adviseAccess (Range<int64> fileRange, AccessHint hint) const noexcept
+{
+    fileRange = fileRange.getIntersectionWith (range);
+
+    if (address == nullptr || fileRange.isEmpty())
+        return;
+
+    auto* start = addBytesToPointer (address, fileRange.getStart() - range.getStart());
+    auto length = (SIZE_T) fileRange.getLength();
+
+    if (hint == AccessHint::willNeed)
+    {
+        WIN32_MEMORY_RANGE_ENTRY entry { start, length };
+        PrefetchVirtualMemory (GetCurrentProcess(), 1, &entry, 0);
+    }
+    else if (hint == AccessHint::dontNeed)
+    {
+        // Unlocking pages that aren't locked removes them from the working set
+        VirtualUnlock (start, length);
+    }
+}
+
 MemoryMappedFile::~MemoryMappedFile()
 {
     if (address != nullptr)
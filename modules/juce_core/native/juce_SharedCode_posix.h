@@ -610,6 +610,37 @@ void MemoryMappedFile::openInternal (const File& file, AccessMode mode, bool exc
     }
 }
 
+void MemoryMappedFile::adviseAccess (Range<int64> fileRange, AccessHint hint) const noexcept
+{
+    fileRange = fileRange.getIntersectionWith (range);
+
+    if (address == nullptr || fileRange.isEmpty())
+        return;
+
+    // madvise needs a page-aligned address, and the mapping itself always starts on a page boundary
+    auto pageSize = (int64) sysconf (_SC_PAGE_SIZE);
+    auto start = fileRange.getStart() - range.getStart();
+    start -= start % pageSize;
+
+    auto advice = [hint]
+    {
+        switch (hint)
+        {
+            case AccessHint::sequential:    return MADV_SEQUENTIAL;
+            case AccessHint::random:        return MADV_RANDOM;
+            case AccessHint::willNeed:      return MADV_WILLNEED;
+            case AccessHint::dontNeed:      return MADV_DONTNEED;
+            case AccessHint::normal:        break;
+        }
+
+        return MADV_NORMAL;
+    }();
+
+    madvise (addBytesToPointer (address, start),
+             (size_t) (fileRange.getEnd() - range.getStart() - start),
+             advice);
+}
+
 MemoryMappedFile::~MemoryMappedFile()
 {
     if (address != nullptr)
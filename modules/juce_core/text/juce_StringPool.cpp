@@ -41,72 +41,28 @@ static const uint32 garbageCollectionInterval = 30000;
 
 StringPool::StringPool() noexcept  : lastGarbageCollectionTime (0) {}
 
-struct StartEndString
+struct StringPool::StartEndString
 {
     StartEndString (String::CharPointerType s, String::CharPointerType e) noexcept : start (s), end (e) {}
     operator String() const   { return String (start, end); }
 
-    String::CharPointerType start, end;
-};
-
-static int compareStrings (const String& s1, const String& s2) noexcept     { return s1.compare (s2); }
-static int compareStrings (CharPointer_UTF8 s1, const String& s2) noexcept  { return s1.compare (s2.getCharPointer()); }
-
-static int compareStrings (const StartEndString& string1, const String& string2) noexcept
-{
-    String::CharPointerType s1 (string1.start), s2 (string2.getCharPointer());
+    size_t getNumBytes() const noexcept   { return (size_t) (end.getAddress() - start.getAddress()); }
 
-    for (;;)
+    friend bool operator== (const String& s, const StartEndString& other) noexcept
     {
-        const int c1 = s1 < string1.end ? (int) s1.getAndAdvance() : 0;
-        const int c2 = (int) s2.getAndAdvance();
-        const int diff = c1 - c2;
+        const auto numBytes = other.getNumBytes();
+        const auto text = s.getCharPointer();
 
-        if (diff != 0)  return diff < 0 ? -1 : 1;
-        if (c1 == 0)    break;
+        return text.sizeInBytes() == numBytes + sizeof (String::CharPointerType::CharType)
+                && memcmp (text.getAddress(), other.start.getAddress(), numBytes) == 0;
     }
 
-    return 0;
-}
+    String::CharPointerType start, end;
+};
 
-template <typename NewStringType>
-static String addPooledString (Array<String>& strings, const NewStringType& newString)
+uint64 StringPool::PooledStringHash::generateHash (const StartEndString& s) noexcept
 {
-    int start = 0;
-    int end = strings.size();
-
-    while (start < end)
-    {
-        const String& startString = strings.getReference (start);
-        const int startComp = compareStrings (newString, startString);
-
-        if (startComp == 0)
-            return startString;
-
-        const int halfway = (start + end) / 2;
-
-        if (halfway == start)
-        {
-            if (startComp > 0)
-                ++start;
-
-            break;
-        }
-
-        const String& halfwayString = strings.getReference (halfway);
-        const int halfwayComp = compareStrings (newString, halfwayString);
-
-        if (halfwayComp == 0)
-            return halfwayString;
-
-        if (halfwayComp > 0)
-            start = halfway;
-        else
-            end = halfway;
-    }
-
-    strings.insert (start, newString);
-    return strings.getReference (start);
+    return DefaultFlatHashFunctions::generateHash (s.start.getAddress(), s.getNumBytes());
 }
 
 String StringPool::getPooledString (const char* const newString)
@@ -116,7 +72,7 @@ String StringPool::getPooledString (const char* const newString)
 
     const ScopedLock sl (lock);
     garbageCollectIfNeeded();
-    return addPooledString (strings, CharPointer_UTF8 (newString));
+    return strings.findOrAdd (StringRef (newString));
 }
 
 String StringPool::getPooledString (String::CharPointerType start, String::CharPointerType end)
@@ -126,7 +82,7 @@ String StringPool::getPooledString (String::CharPointerType start, String::CharP
 
     const ScopedLock sl (lock);
     garbageCollectIfNeeded();
-    return addPooledString (strings, StartEndString (start, end));
+    return strings.findOrAdd (StartEndString (start, end));
 }
 
 String StringPool::getPooledString (StringRef newString)
@@ -136,7 +92,7 @@ String StringPool::getPooledString (StringRef newString)
 
     const ScopedLock sl (lock);
     garbageCollectIfNeeded();
-    return addPooledString (strings, newString.text);
+    return strings.findOrAdd (newString);
 }
 
 String StringPool::getPooledString (const String& newString)
@@ -146,7 +102,7 @@ String StringPool::getPooledString (const String& newString)
 
     const ScopedLock sl (lock);
     garbageCollectIfNeeded();
-    return addPooledString (strings, newString);
+    return strings.findOrAdd (newString);
 }
 
 void StringPool::garbageCollectIfNeeded()
@@ -160,9 +116,13 @@ void StringPool::garbageCollect()
 {
     const ScopedLock sl (lock);
 
-    for (int i = strings.size(); --i >= 0;)
-        if (strings.getReference (i).getReferenceCount() == 1)
-            strings.remove (i);
+    const auto numStrings = strings.size();
+    const auto numRemoved = strings.removeIf ([] (const String& s) { return s.getReferenceCount() == 1; });
+
+    // Removing items never shrinks the table, so give back its storage when most of the
+    // strings have gone, rather than keeping it at the size of the largest burst forever
+    if (numRemoved > numStrings / 2)
+        strings.rehash (0);
 
     lastGarbageCollectionTime = Time::getApproximateMillisecondCounter();
 }
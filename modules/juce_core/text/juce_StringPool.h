@@ -87,7 +87,15 @@ public:
     static StringPool& getGlobalPool() noexcept;
 
 private:
-    Array<String> strings;
+    struct StartEndString;
+
+    struct PooledStringHash  : public DefaultFlatHashFunctions
+    {
+        using DefaultFlatHashFunctions::generateHash;
+        static uint64 generateHash (const StartEndString&) noexcept;
+    };
+
+    FlatHashSet<String, PooledStringHash> strings;
     CriticalSection lock;
     uint32 lastGarbageCollectionTime;
 
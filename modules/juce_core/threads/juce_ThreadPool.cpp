@@ -35,10 +35,111 @@
 namespace juce
 {
 
+/*  A bounded work-stealing deque, as described by Chase and Lev, based on the version in
+    "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al, 2013). The stores
+    to bottom are releases rather than relaxed stores after a fence, which is equivalent but
+    can be understood by ThreadSanitizer.
+
+    Only the thread that owns the queue may call push() and pop(), which work at the bottom
+    of the queue. Any thread may call steal(), which takes the task at the top.
+*/
+struct ThreadPool::TaskQueue
+{
+    bool push (Task* task) noexcept
+    {
+        const auto b = bottom.load (std::memory_order_relaxed);
+        const auto t = top.load (std::memory_order_acquire);
+
+        if (b - t >= capacity)
+            return false;
+
+        slots[(size_t) (b & (capacity - 1))].store (task, std::memory_order_relaxed);
+        bottom.store (b + 1, std::memory_order_release);
+        return true;
+    }
+
+    Task* pop() noexcept
+    {
+        const auto b = bottom.load (std::memory_order_relaxed) - 1;
+        bottom.store (b, std::memory_order_release);
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+        auto t = top.load (std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            bottom.store (b + 1, std::memory_order_release);
+            return nullptr;
+        }
+
+        auto* task = slots[(size_t) (b & (capacity - 1))].load (std::memory_order_relaxed);
+
+        if (t == b)
+        {
+            // This is the last task, so race any thieves for it
+            if (! top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                task = nullptr;
+
+            bottom.store (b + 1, std::memory_order_release);
+        }
+
+        return task;
+    }
+
+    Task* steal() noexcept
+    {
+        auto t = top.load (std::memory_order_acquire);
+        std::atomic_thread_fence (std::memory_order_seq_cst);
+        const auto b = bottom.load (std::memory_order_acquire);
+
+        if (t >= b)
+            return nullptr;
+
+        auto* task = slots[(size_t) (t & (capacity - 1))].load (std::memory_order_relaxed);
+
+        if (! top.compare_exchange_strong (t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+
+        return task;
+    }
+
+    bool isEmpty() const noexcept
+    {
+        return bottom.load() <= top.load();
+    }
+
+    static constexpr int64 capacity = 4096;
+
+    alignas (detail::lockFreeQueueCacheLineSize) std::atomic<int64> top { 0 };
+    alignas (detail::lockFreeQueueCacheLineSize) std::atomic<int64> bottom { 0 };
+    alignas (detail::lockFreeQueueCacheLineSize) std::array<std::atomic<Task*>, (size_t) capacity> slots {};
+};
+
+//==============================================================================
+struct ThreadPoolTaskGroup::State
+{
+    void taskFinished()
+    {
+        if (--numPendingTasks == 0)
+            finished.signal();
+    }
+
+    std::atomic<int> numPendingTasks { 0 };
+    WaitableEvent finished;
+};
+
+struct ThreadPool::Task
+{
+    std::function<void()> function;
+    std::shared_ptr<ThreadPoolTaskGroup::State> group;
+    Task* next = nullptr;
+};
+
+//==============================================================================
 struct ThreadPool::ThreadPoolThread final : public Thread
 {
-    ThreadPoolThread (ThreadPool& p, const Options& options)
+    ThreadPoolThread (ThreadPool& p, const Options& options, int threadIndex)
        : Thread { options.threadName, options.threadStackSizeBytes },
+         index { threadIndex },
          pool { p }
     {
     }
@@ -47,13 +148,16 @@ struct ThreadPool::ThreadPoolThread final : public Thread
     {
         while (! threadShouldExit())
         {
-            if (! pool.runNextJob (*this))
-                wait (500);
+            if (! (pool.runNextTask (*this) || pool.runNextJob (*this)))
+                pool.sleepUntilWoken (*this);
         }
     }
 
     std::atomic<ThreadPoolJob*> currentJob { nullptr };
+    std::atomic<bool> isSleeping { false };
+    TaskQueue tasks;
 
+    const int index;
     ThreadPool& pool;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ThreadPoolThread)
@@ -107,12 +211,13 @@ ThreadPoolJob* ThreadPoolJob::getCurrentThreadPoolJob()
 
 //==============================================================================
 ThreadPool::ThreadPool (const Options& options)
+    : jobScheduling (options.jobScheduling)
 {
     // not much point having a pool without any threads!
     jassert (options.numberOfThreads > 0);
 
     for (int i = jmax (1, options.numberOfThreads); --i >= 0;)
-        threads.add (new ThreadPoolThread (*this, options));
+        threads.add (new ThreadPoolThread (*this, options, threads.size()));
 
     for (auto* t : threads)
         t->startThread (options.desiredThreadPriority);
@@ -131,6 +236,9 @@ ThreadPool::~ThreadPool()
 {
     removeAllJobs (true, 5000);
     stopThreads();
+
+    // Tasks may have been added by jobs that were still running
+    removeQueuedTasks();
 }
 
 void ThreadPool::stopThreads()
@@ -179,6 +287,12 @@ void ThreadPool::addJob (std::function<ThreadPoolJob::JobStatus()> jobToRun)
 
 void ThreadPool::addJob (std::function<void()> jobToRun)
 {
+    if (jobScheduling == Options::JobScheduling::workStealing)
+    {
+        addTask (new Task { std::move (jobToRun), nullptr });
+        return;
+    }
+
     struct LambdaJobWrapper final : public ThreadPoolJob
     {
         LambdaJobWrapper (std::function<void()> j) : ThreadPoolJob ("lambda"), job (std::move (j)) {}
@@ -193,7 +307,7 @@ void ThreadPool::addJob (std::function<void()> jobToRun)
 int ThreadPool::getNumJobs() const noexcept
 {
     const ScopedLock sl (lock);
-    return jobs.size();
+    return jobs.size() + numTasks.load();
 }
 
 int ThreadPool::getNumThreads() const noexcept
@@ -281,6 +395,9 @@ bool ThreadPool::removeAllJobs (bool interruptRunningJobs, int timeOutMs,
 {
     Array<ThreadPoolJob*> jobsToWaitFor;
 
+    if (selectedJobsToRemove == nullptr)
+        removeQueuedTasks();
+
     {
         OwnedArray<ThreadPoolJob> deletionList;
 
@@ -322,7 +439,7 @@ bool ThreadPool::removeAllJobs (bool interruptRunningJobs, int timeOutMs,
                 jobsToWaitFor.remove (i);
         }
 
-        if (jobsToWaitFor.size() == 0)
+        if (jobsToWaitFor.size() == 0 && (selectedJobsToRemove != nullptr || numTasks.load() == 0))
             break;
 
         if (timeOutMs >= 0 && Time::getMillisecondCounter() >= start + (uint32) timeOutMs)
@@ -434,4 +551,440 @@ void ThreadPool::addToDeleteList (OwnedArray<ThreadPoolJob>& deletionList, Threa
         deletionList.add (job);
 }
 
+//==============================================================================
+void ThreadPool::addTask (Task* task)
+{
+    ++numTasks;
+
+    auto* thread = getCurrentPoolThread();
+
+    if (thread == nullptr || ! thread->tasks.push (task))
+        addSubmittedTasks (task, task);
+
+    wakeSleepingThreads (1);
+}
+
+void ThreadPool::addSubmittedTasks (Task* first, Task* last)
+{
+    auto* head = submittedTasks.load (std::memory_order_relaxed);
+
+    do
+    {
+        last->next = head;
+    }
+    while (! submittedTasks.compare_exchange_weak (head, first, std::memory_order_release, std::memory_order_relaxed));
+}
+
+ThreadPool::Task* ThreadPool::takeNextTask (ThreadPoolThread& thread)
+{
+    if (auto* task = thread.tasks.pop())
+        return task;
+
+    if (submittedTasks.load (std::memory_order_relaxed) != nullptr)
+    {
+        if (auto* submitted = submittedTasks.exchange (nullptr, std::memory_order_acquire))
+        {
+            // The submitted list is newest-first, so reverse it before taking the oldest
+            Task* oldest = nullptr;
+
+            while (submitted != nullptr)
+            {
+                auto* next = submitted->next;
+                submitted->next = oldest;
+                oldest = submitted;
+                submitted = next;
+            }
+
+            // Move the rest into this thread's queue, where idle threads can steal them
+            auto* rest = std::exchange (oldest->next, nullptr);
+            int numMoved = 0;
+
+            for (; rest != nullptr; ++numMoved)
+            {
+                auto* next = rest->next;
+
+                if (! thread.tasks.push (rest))
+                {
+                    auto* last = rest;
+
+                    while (last->next != nullptr)
+                        last = last->next;
+
+                    addSubmittedTasks (rest, last);
+                    break;
+                }
+
+                rest = next;
+            }
+
+            wakeSleepingThreads (numMoved);
+            return oldest;
+        }
+    }
+
+    for (int i = 1; i < threads.size(); ++i)
+        if (auto* task = threads.getUnchecked ((thread.index + i) % threads.size())->tasks.steal())
+            return task;
+
+    return nullptr;
+}
+
+bool ThreadPool::runNextTask (ThreadPoolThread& thread)
+{
+    if (auto* task = takeNextTask (thread))
+    {
+        try
+        {
+            task->function();
+        }
+        catch (...)
+        {
+            jassertfalse; // Your task mustn't throw any exceptions!
+        }
+
+        finishTask (task);
+        return true;
+    }
+
+    return false;
+}
+
+void ThreadPool::finishTask (Task* task)
+{
+    auto group = std::move (task->group);
+    delete task;
+
+    if (group != nullptr)
+        group->taskFinished();
+
+    --numTasks;
+}
+
+bool ThreadPool::hasQueuedTasks() const noexcept
+{
+    if (submittedTasks.load() != nullptr)
+        return true;
+
+    for (auto* t : threads)
+        if (! t->tasks.isEmpty())
+            return true;
+
+    return false;
+}
+
+void ThreadPool::removeQueuedTasks()
+{
+    for (auto* task = submittedTasks.exchange (nullptr, std::memory_order_acquire); task != nullptr;)
+        finishTask (std::exchange (task, task->next));
+
+    for (auto* t : threads)
+        while (! t->tasks.isEmpty())
+            if (auto* task = t->tasks.steal())
+                finishTask (task);
+}
+
+void ThreadPool::wakeSleepingThreads (int maxNumToWake)
+{
+    // Pairs with the fence in sleepUntilWoken(), so that either a thread that's about to
+    // sleep will see the new tasks, or we'll see that it's sleeping
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+
+    for (auto* t : threads)
+    {
+        if (maxNumToWake <= 0 || numSleepingThreads.load() == 0)
+            return;
+
+        if (t->isSleeping.load() && t->isSleeping.exchange (false))
+        {
+            --numSleepingThreads;
+            --maxNumToWake;
+            t->notify();
+        }
+    }
+}
+
+void ThreadPool::sleepUntilWoken (ThreadPoolThread& thread)
+{
+    thread.isSleeping = true;
+    ++numSleepingThreads;
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+
+    if (! hasQueuedTasks())
+        thread.wait (500);
+
+    if (thread.isSleeping.exchange (false))
+        --numSleepingThreads;
+}
+
+ThreadPool::ThreadPoolThread* ThreadPool::getCurrentPoolThread() const
+{
+    if (auto* t = dynamic_cast<ThreadPoolThread*> (Thread::getCurrentThread()))
+        if (&t->pool == this)
+            return t;
+
+    return nullptr;
+}
+
+//==============================================================================
+void ThreadPool::parallelFor (Range<int> range, int grainSize, const std::function<void (Range<int>)>& body)
+{
+    if (range.isEmpty())
+        return;
+
+    const auto numThreads = getNumThreads();
+
+    if (grainSize <= 0)
+        grainSize = jmax (1, range.getLength() / (numThreads * 8));
+
+    const auto numChunks = (int) (((int64) range.getLength() + grainSize - 1) / grainSize);
+
+    if (numChunks == 1)
+    {
+        body (range);
+        return;
+    }
+
+    // The helper tasks share ownership of this, because they may not start until after the
+    // caller has processed every chunk and returned. They only use the body after claiming
+    // a chunk, and the caller waits for every claimed chunk to finish.
+    struct Chunks
+    {
+        Chunks (Range<int> r, int grain, int num, const std::function<void (Range<int>)>& b)
+            : range (r), grainSize (grain), numChunks (num), body (b) {}
+
+        void processChunks()
+        {
+            for (;;)
+            {
+                const auto chunk = nextChunk++;
+
+                if (chunk >= numChunks)
+                    return;
+
+                const auto start = range.getStart() + chunk * grainSize;
+                body ({ start, (int) jmin ((int64) range.getEnd(), (int64) start + grainSize) });
+
+                if (++numChunksDone == numChunks)
+                    allDone.signal();
+            }
+        }
+
+        const Range<int> range;
+        const int grainSize, numChunks;
+        const std::function<void (Range<int>)>& body;
+        std::atomic<int> nextChunk { 0 }, numChunksDone { 0 };
+        WaitableEvent allDone;
+    };
+
+    auto chunks = std::make_shared<Chunks> (range, grainSize, numChunks, body);
+
+    for (int i = jmin (numChunks - 1, numThreads); --i >= 0;)
+        addTask (new Task { [chunks] { chunks->processChunks(); }, nullptr });
+
+    chunks->processChunks();
+
+    while (chunks->numChunksDone.load() < numChunks)
+        chunks->allDone.wait (-1);
+}
+
+//==============================================================================
+ThreadPoolTaskGroup::ThreadPoolTaskGroup (ThreadPool& p)
+    : pool (p), state (std::make_shared<State>())
+{
+}
+
+ThreadPoolTaskGroup::~ThreadPoolTaskGroup()
+{
+    wait();
+}
+
+void ThreadPoolTaskGroup::run (std::function<void()> task)
+{
+    ++state->numPendingTasks;
+    pool.addTask (new ThreadPool::Task { std::move (task), state });
+}
+
+void ThreadPoolTaskGroup::wait()
+{
+    auto* thread = pool.getCurrentPoolThread();
+
+    while (! isFinished())
+    {
+        // A pool thread runs other tasks rather than blocking, because the tasks that
+        // it's waiting for may be queued behind it
+        if (thread != nullptr)
+        {
+            if (! pool.runNextTask (*thread))
+                state->finished.wait (1);
+        }
+        else
+        {
+            state->finished.wait (-1);
+        }
+    }
+}
+
+bool ThreadPoolTaskGroup::isFinished() const noexcept
+{
+    return state->numPendingTasks.load() == 0;
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ThreadPoolTests final : public UnitTest
+{
+public:
+    ThreadPoolTests()
+        : UnitTest ("ThreadPool", UnitTestCategories::threads) {}
+
+    void runTest() override
+    {
+        using JobScheduling = ThreadPoolOptions::JobScheduling;
+
+        for (const auto scheduling : { JobScheduling::sharedQueue, JobScheduling::workStealing })
+        {
+            const auto suffix = String (scheduling == JobScheduling::sharedQueue ? " (shared queue)" : " (work stealing)");
+
+            beginTest ("Lambda jobs are all run" + suffix);
+            {
+                ThreadPool pool { ThreadPoolOptions{}.withNumberOfThreads (4).withJobScheduling (scheduling) };
+                std::atomic<int> numRun { 0 };
+                constexpr int numJobs = 2000;
+
+                for (int i = 0; i < numJobs; ++i)
+                    pool.addJob ([&numRun] { ++numRun; });
+
+                expect (waitUntil ([&] { return pool.getNumJobs() == 0; }));
+                expectEquals (numRun.load(), numJobs);
+            }
+
+            beginTest ("Task groups wait for all their tasks" + suffix);
+            {
+                ThreadPool pool { ThreadPoolOptions{}.withNumberOfThreads (3).withJobScheduling (scheduling) };
+                std::vector<int> results (1000, 0);
+
+                ThreadPoolTaskGroup group (pool);
+
+                for (size_t i = 0; i < results.size(); ++i)
+                    group.run ([&results, i] { results[i] = (int) i * 2; });
+
+                group.wait();
+                expect (group.isFinished());
+
+                for (size_t i = 0; i < results.size(); ++i)
+                    expectEquals (results[i], (int) i * 2);
+            }
+        }
+
+        beginTest ("Nested task groups don't deadlock");
+        {
+            ThreadPool pool { ThreadPoolOptions{}.withNumberOfThreads (2) };
+            std::atomic<int> numRun { 0 };
+
+            {
+                ThreadPoolTaskGroup outer (pool);
+
+                for (int i = 0; i < 8; ++i)
+                {
+                    outer.run ([&]
+                    {
+                        ThreadPoolTaskGroup inner (pool);
+
+                        for (int j = 0; j < 16; ++j)
+                            inner.run ([&numRun] { ++numRun; });
+                    });
+                }
+            }
+
+            expectEquals (numRun.load(), 8 * 16);
+        }
+
+        beginTest ("parallelFor visits each index once");
+        {
+            ThreadPool pool { ThreadPoolOptions{}.withNumberOfThreads (4) };
+
+            for (const auto grainSize : { 0, 1, 7, 1000, 5000 })
+            {
+                std::vector<std::atomic<int>> visits (1000);
+
+                pool.parallelFor ({ 0, (int) visits.size() }, grainSize, [&] (Range<int> chunk)
+                {
+                    for (auto i = chunk.getStart(); i < chunk.getEnd(); ++i)
+                        ++visits[(size_t) i];
+                });
+
+                expect (std::all_of (visits.begin(), visits.end(), [] (auto& v) { return v.load() == 1; }));
+            }
+
+            std::atomic<int> sum { 0 };
+            pool.parallelFor (-50, 50, [&] (int i) { sum += i; });
+            expectEquals (sum.load(), -50);
+
+            pool.parallelFor (10, 10, [&] (int) { expect (false); });
+        }
+
+        beginTest ("parallelFor can be nested");
+        {
+            ThreadPool pool { ThreadPoolOptions{}.withNumberOfThreads (2) };
+            std::atomic<int> numRun { 0 };
+
+            pool.parallelFor (0, 16, [&] (int)
+            {
+                pool.parallelFor (0, 64, [&] (int) { ++numRun; });
+            });
+
+            expectEquals (numRun.load(), 16 * 64);
+        }
+
+        beginTest ("removeAllJobs discards tasks that haven't started");
+        {
+            ThreadPool pool { ThreadPoolOptions{}.withNumberOfThreads (1).withJobScheduling (JobScheduling::workStealing) };
+            WaitableEvent started, release;
+            std::atomic<int> numRun { 0 };
+
+            pool.addJob ([&] { started.signal(); release.wait (-1); });
+            expect (started.wait (10000));
+
+            ThreadPoolTaskGroup group (pool);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                pool.addJob ([&numRun] { ++numRun; });
+                group.run ([&numRun] { ++numRun; });
+            }
+
+            expectEquals (pool.getNumJobs(), 201);
+            expect (! pool.removeAllJobs (false, 0));
+            expect (group.isFinished());
+
+            release.signal();
+            expect (pool.removeAllJobs (false, 10000));
+            expectEquals (pool.getNumJobs(), 0);
+            expectEquals (numRun.load(), 0);
+        }
+    }
+
+private:
+    template <typename Predicate>
+    static bool waitUntil (Predicate&& predicate)
+    {
+        const auto start = Time::getMillisecondCounter();
+
+        while (! predicate())
+        {
+            if (Time::getMillisecondCounter() - start > 10000)
+                return false;
+
+            Thread::sleep (1);
+        }
+
+        return true;
+    }
+};
+
+static ThreadPoolTests threadPoolTests;
+
+#endif
+
 } // namespace juce
@@ -165,6 +165,21 @@ private:
 */
 struct ThreadPoolOptions
 {
+    /** The ways in which a pool can schedule jobs that are added as lambdas.
+        @see withJobScheduling
+    */
+    enum class JobScheduling
+    {
+        sharedQueue,    /**< Lambdas are wrapped in ThreadPoolJob objects and held in the same
+                             list as any other job, so they can be queried and removed by the
+                             methods of ThreadPool that take a ThreadPoolJob. */
+
+        workStealing    /**< Lambdas are held in a queue owned by each thread, and idle threads
+                             take work from busy ones. A lambda can be added without taking
+                             a lock, and threads don't contend for a shared list, which makes
+                             this much faster when adding a large number of small jobs. */
+    };
+
     /** The name to give each thread in the pool. */
     [[nodiscard]] ThreadPoolOptions withThreadName (String newThreadName) const
     {
@@ -191,10 +206,23 @@ struct ThreadPoolOptions
         return withMember (*this, &ThreadPoolOptions::desiredThreadPriority, newDesiredThreadPriority);
     }
 
+    /** How the pool schedules jobs added with ThreadPool::addJob (std::function<void()>).
+
+        This doesn't affect ThreadPoolJob objects, or lambdas that return a
+        ThreadPoolJob::JobStatus, which are always held in the pool's shared list.
+
+        @see JobScheduling
+    */
+    [[nodiscard]] ThreadPoolOptions withJobScheduling (JobScheduling newJobScheduling) const
+    {
+        return withMember (*this, &ThreadPoolOptions::jobScheduling, newJobScheduling);
+    }
+
     String threadName { "Pool" };
     int numberOfThreads { SystemStats::getNumCpus() };
     size_t threadStackSizeBytes { Thread::osDefaultStackSize };
     Thread::Priority desiredThreadPriority { Thread::Priority::normal };
+    JobScheduling jobScheduling { JobScheduling::sharedQueue };
 };
 
 
@@ -296,10 +324,50 @@ public:
     void addJob (std::function<ThreadPoolJob::JobStatus()> job);
 
     /** Adds a lambda function to be called as a job.
-        This will create an internal ThreadPoolJob object to encapsulate and call the lambda.
+
+        If the pool was created with ThreadPoolOptions::JobScheduling::sharedQueue, this will
+        create an internal ThreadPoolJob object to encapsulate and call the lambda.
+
+        With ThreadPoolOptions::JobScheduling::workStealing, the lambda is added to a
+        queue without taking a lock. Lambdas added this way aren't visible to getJob(),
+        contains() or getNamesOfAllJobs(), and can't be interrupted, but they are counted
+        by getNumJobs(), and removeAllJobs() will discard any that haven't started yet
+        if it's called without a JobSelector.
     */
     void addJob (std::function<void()> job);
 
+    //==============================================================================
+    /** Calls a function for consecutive chunks of a range of indices, spreading the chunks
+        across the pool's threads, and returns when all of them have been processed.
+
+        The calling thread processes chunks too, so this won't wait for a busy pool to
+        become free, and it's safe to call from inside a job that's running on this pool.
+        The function may be called concurrently from several threads.
+
+        @param range        the range of indices to process
+        @param grainSize    the number of indices in each chunk. If this is zero or less, a
+                            size will be chosen that gives each thread several chunks
+        @param body         the function to call for each chunk
+        @see ThreadPoolTaskGroup
+    */
+    void parallelFor (Range<int> range, int grainSize, const std::function<void (Range<int>)>& body);
+
+    /** Calls a function for each index from startIndex up to (but not including) endIndex,
+        spreading the calls across the pool's threads, and returns when they have all finished.
+
+        The calling thread takes part in the work. See the other version of parallelFor()
+        for details.
+    */
+    template <typename Callback>
+    void parallelFor (int startIndex, int endIndex, Callback&& callback)
+    {
+        parallelFor ({ startIndex, endIndex }, 0, [&callback] (Range<int> chunk)
+        {
+            for (auto i = chunk.getStart(); i < chunk.getEnd(); ++i)
+                callback (i);
+        });
+    }
+
     /** Tries to remove a job from the pool.
 
         If the job isn't yet running, this will simply remove it. If it is running, it
@@ -336,7 +404,9 @@ public:
                         int timeOutMilliseconds,
                         JobSelector* selectedJobsToRemove = nullptr);
 
-    /** Returns the number of jobs currently running or queued. */
+    /** Returns the number of jobs currently running or queued, including any lambdas
+        and ThreadPoolTaskGroup tasks that are held in the work-stealing queues.
+    */
     int getNumJobs() const noexcept;
 
     /** Returns the number of threads assigned to this thread pool. */
@@ -384,17 +454,35 @@ private:
     Array<ThreadPoolJob*> jobs;
 
     struct ThreadPoolThread;
+    struct Task;
+    struct TaskQueue;
     friend class ThreadPoolJob;
+    friend class ThreadPoolTaskGroup;
     OwnedArray<ThreadPoolThread> threads;
 
     CriticalSection lock;
     WaitableEvent jobFinishedSignal;
 
+    const Options::JobScheduling jobScheduling;
+    std::atomic<Task*> submittedTasks { nullptr };
+    std::atomic<int> numTasks { 0 }, numSleepingThreads { 0 };
+
     bool runNextJob (ThreadPoolThread&);
     ThreadPoolJob* pickNextJobToRun();
     void addToDeleteList (OwnedArray<ThreadPoolJob>&, ThreadPoolJob*) const;
     void stopThreads();
 
+    void addTask (Task*);
+    void addSubmittedTasks (Task* first, Task* last);
+    Task* takeNextTask (ThreadPoolThread&);
+    bool runNextTask (ThreadPoolThread&);
+    void finishTask (Task*);
+    bool hasQueuedTasks() const noexcept;
+    void removeQueuedTasks();
+    void wakeSleepingThreads (int maxNumToWake);
+    ThreadPoolThread* getCurrentPoolThread() const;
+    void sleepUntilWoken (ThreadPoolThread&);
+
     // Note that this method has changed, and no longer has a parameter to indicate
     // whether the jobs should be deleted - see the new method for details.
     void removeAllJobs (bool, int, bool);
@@ -402,4 +490,60 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ThreadPool)
 };
 
+//==============================================================================
+/**
+    Runs a set of lambdas on a ThreadPool, and lets you wait until they have all finished.
+
+    @code
+    ThreadPoolTaskGroup group (pool);
+
+    for (auto& file : filesToAnalyse)
+        group.run ([&file] { analyse (file); });
+
+    group.wait();
+    @endcode
+
+    The tasks are always held in the pool's work-stealing queues, whichever
+    ThreadPoolOptions::JobScheduling the pool was created with. When wait() is called
+    from one of the pool's own threads, that thread runs queued tasks while it waits
+    rather than blocking, so groups can be used from inside other tasks.
+
+    @see ThreadPool::parallelFor
+
+    @tags{Core}
+*/
+class JUCE_API  ThreadPoolTaskGroup
+{
+public:
+    /** Creates an empty group of tasks that will run on the given pool. */
+    explicit ThreadPoolTaskGroup (ThreadPool& pool);
+
+    /** Destructor. This will wait for any tasks that haven't finished yet. */
+    ~ThreadPoolTaskGroup();
+
+    /** Adds a task to the group. It will be run by the next thread in the pool that's free.
+        Tasks mustn't throw exceptions.
+    */
+    void run (std::function<void()> task);
+
+    /** Waits until every task that has been added to the group has finished.
+
+        Tasks that are discarded by ThreadPool::removeAllJobs() before they start are
+        treated as finished.
+    */
+    void wait();
+
+    /** Returns true if none of the tasks in the group are queued or running. */
+    bool isFinished() const noexcept;
+
+private:
+    struct State;
+    friend class ThreadPool;
+
+    ThreadPool& pool;
+    std::shared_ptr<State> state;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ThreadPoolTaskGroup)
+};
+
 } // namespace juce
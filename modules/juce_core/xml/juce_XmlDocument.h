@@ -68,7 +68,10 @@ namespace juce
     }
     @endcode
 
-    @see XmlElement
+    To read a very large document without building a tree for the whole of it, use
+    an XmlStreamReader instead.
+
+    @see XmlElement, XmlStreamReader
 
     @tags{Core}
 */
@@ -0,0 +1,762 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+namespace XmlStreamReaderHelpers
+{
+    constexpr size_t initialBufferSize = 65536;
+    constexpr size_t minimumReadSize = 32768;
+    constexpr auto notFound = std::numeric_limits<size_t>::max();
+
+    static bool isWhitespace (char c) noexcept
+    {
+        return c == ' ' || (c >= 9 && c <= 13);
+    }
+
+    static bool isIdentifierByte (char c) noexcept
+    {
+        return (uint8) c >= 0x80 || XmlIdentifierChars::isIdentifierChar ((juce_wchar) (uint8) c);
+    }
+
+    static char* skipWhitespace (char* p) noexcept
+    {
+        while (isWhitespace (*p))
+            ++p;
+
+        return p;
+    }
+
+    static char* findEndOfName (char* p) noexcept
+    {
+        while (isIdentifierByte (*p))
+            ++p;
+
+        return p;
+    }
+
+    // Stops at the first mismatch, so this can't read past the null at the end of the data
+    static bool startsWith (const char* text, const char* prefix) noexcept
+    {
+        for (; *prefix != 0; ++text, ++prefix)
+            if (*text != *prefix)
+                return false;
+
+        return true;
+    }
+
+    static bool startsWithIgnoreCase (const char* text, const char* prefix) noexcept
+    {
+        for (; *prefix != 0; ++text, ++prefix)
+            if (CharacterFunctions::toLowerCase ((juce_wchar) (uint8) *text) != (juce_wchar) *prefix)
+                return false;
+
+        return true;
+    }
+
+    // Replaces the entity at 'source' with the character it represents, and returns the
+    // position to continue writing at. The decoded character is never longer than the entity,
+    // so this can be done in place. Unknown entities are copied unchanged.
+    static char* decodeEntity (char*& source, char* dest) noexcept
+    {
+        jassert (*source == '&');
+
+        struct NamedEntity { const char* name; char character; };
+
+        static constexpr NamedEntity namedEntities[] { { "amp;", '&' }, { "quot;", '"' }, { "apos;", '\'' },
+                                                       { "lt;", '<' },  { "gt;", '>' } };
+
+        for (const auto& entity : namedEntities)
+        {
+            if (startsWithIgnoreCase (source + 1, entity.name))
+            {
+                source += 1 + std::strlen (entity.name);
+                *dest++ = entity.character;
+                return dest;
+            }
+        }
+
+        if (source[1] == '#')
+        {
+            const auto isHex = source[2] == 'x' || source[2] == 'X';
+            auto* p = source + (isHex ? 3 : 2);
+            uint32 charCode = 0;
+            int numDigits = 0;
+
+            for (; numDigits <= 8; ++p, ++numDigits)
+            {
+                const auto digit = isHex ? CharacterFunctions::getHexDigitValue ((juce_wchar) (uint8) *p)
+                                         : (*p >= '0' && *p <= '9' ? *p - '0' : -1);
+
+                if (digit < 0)
+                    break;
+
+                charCode = charCode * (isHex ? 16u : 10u) + (uint32) digit;
+            }
+
+            if (*p == ';' && numDigits > 0 && numDigits <= 8)
+            {
+                source = p + 1;
+
+                if (charCode == 0 || charCode > 0x10ffff)
+                    return dest;
+
+                CharPointer_UTF8 utf8 (dest);
+                utf8.write ((juce_wchar) charCode);
+                return utf8.getAddress();
+            }
+        }
+
+        *dest++ = *source++;
+        return dest;
+    }
+}
+
+//==============================================================================
+XmlStreamReader::XmlStreamReader (InputStream& sourceStream)
+    : XmlStreamReader (&sourceStream, false)
+{
+}
+
+XmlStreamReader::XmlStreamReader (InputStream* sourceStream, bool deleteSourceWhenDestroyed)
+    : source (sourceStream, deleteSourceWhenDestroyed),
+      buffer (XmlStreamReaderHelpers::initialBufferSize + 1),
+      bufferSize (XmlStreamReaderHelpers::initialBufferSize + 1)
+{
+    jassert (source != nullptr);
+    buffer[0] = 0;
+}
+
+XmlStreamReader::~XmlStreamReader() = default;
+
+//==============================================================================
+bool XmlStreamReader::readMoreData()
+{
+    using namespace XmlStreamReaderHelpers;
+
+    if (sourceExhausted)
+        return false;
+
+    // Everything before the current token has been consumed
+    if (tokenStart > 0)
+    {
+        std::memmove (buffer, buffer + tokenStart, dataEnd - tokenStart);
+        dataEnd -= tokenStart;
+        tokenStart = 0;
+    }
+
+    if (bufferSize - 1 - dataEnd < minimumReadSize)
+    {
+        bufferSize = (bufferSize - 1) * 2 + 1;
+        buffer.realloc (bufferSize);
+    }
+
+    const auto numRead = source->read (buffer + dataEnd, (int) jmin (bufferSize - 1 - dataEnd, (size_t) std::numeric_limits<int>::max()));
+
+    if (numRead <= 0)
+    {
+        sourceExhausted = true;
+        buffer[dataEnd] = 0;
+        return false;
+    }
+
+    dataEnd += (size_t) numRead;
+    buffer[dataEnd] = 0;
+    return true;
+}
+
+bool XmlStreamReader::ensureAvailable (size_t offset)
+{
+    while (tokenStart + offset >= dataEnd)
+        if (! readMoreData())
+            return false;
+
+    return true;
+}
+
+size_t XmlStreamReader::find (char c, size_t from)
+{
+    for (;;)
+    {
+        const auto available = dataEnd - tokenStart;
+
+        if (from < available)
+        {
+            if (auto* found = std::memchr (at (from), c, available - from))
+                return (size_t) (static_cast<const char*> (found) - at (0));
+
+            from = available;
+        }
+
+        if (! readMoreData())
+            return XmlStreamReaderHelpers::notFound;
+    }
+}
+
+size_t XmlStreamReader::find (const char* sequence, size_t from)
+{
+    const auto length = std::strlen (sequence);
+
+    for (;;)
+    {
+        const auto start = find (sequence[0], from);
+
+        if (start == XmlStreamReaderHelpers::notFound || ! ensureAvailable (start + length - 1))
+            return XmlStreamReaderHelpers::notFound;
+
+        if (std::memcmp (at (start), sequence, length) == 0)
+            return start;
+
+        from = start + 1;
+    }
+}
+
+XmlStreamReader::Event XmlStreamReader::setError (const String& message)
+{
+    lastError = message;
+    return event = Event::error;
+}
+
+//==============================================================================
+XmlStreamReader::Event XmlStreamReader::next()
+{
+    if (event == Event::endOfDocument || event == Event::error)
+        return event;
+
+    if (pendingSelfClose)
+    {
+        pendingSelfClose = false;
+        numAttributes = 0;
+        return event = Event::endElement;
+    }
+
+    if (restoreOpenBracket)
+    {
+        *at (0) = '<';
+        restoreOpenBracket = false;
+    }
+
+    if (event == Event::endElement)
+        --depth;
+
+    numAttributes = 0;
+    name = StringRef();
+    text = StringRef();
+
+    if (event == Event::none)
+        return readPrologue();
+
+    if (depth == 0)
+        return event = Event::endOfDocument;
+
+    for (;;)
+    {
+        size_t offset = 0;
+
+        if (! skipWhitespaceAndComments (offset))
+            return setError ("unmatched tags");
+
+        if (*at (offset) == '<')
+        {
+            ensureAvailable (offset + 8);
+            tokenStart += offset;
+
+            if (*at (1) == '/')
+                return readEndElement();
+
+            if (XmlStreamReaderHelpers::startsWith (at (1), "![CDATA["))
+                return readCData();
+
+            return readStartElement();
+        }
+
+        // Like XmlDocument, text that comes before a tag keeps any leading whitespace and comments
+        const auto result = readText();
+
+        if (result != Event::none)
+            return result;
+    }
+}
+
+bool XmlStreamReader::skipWhitespaceAndComments (size_t& offset)
+{
+    for (;;)
+    {
+        if (! ensureAvailable (offset))
+            return false;
+
+        const auto c = *at (offset);
+
+        if (XmlStreamReaderHelpers::isWhitespace (c))
+        {
+            ++offset;
+            continue;
+        }
+
+        if (c != '<')
+            return true;
+
+        ensureAvailable (offset + 3);
+
+        const char* closingSequence = nullptr;
+
+        if (XmlStreamReaderHelpers::startsWith (at (offset), "<!--"))
+            closingSequence = "-->";
+        else if (at (offset)[1] == '?')
+            closingSequence = "?>";
+        else
+            return true;
+
+        const auto end = find (closingSequence, offset + 2);
+
+        if (end == XmlStreamReaderHelpers::notFound)
+            return false;
+
+        offset = end + std::strlen (closingSequence);
+    }
+}
+
+XmlStreamReader::Event XmlStreamReader::readPrologue()
+{
+    ensureAvailable (2);
+
+    if ((uint8) at (0)[0] == 0xfe || (uint8) at (0)[0] == 0xff)
+        return setError ("only UTF-8 documents are supported");
+
+    if (CharPointer_UTF8::isByteOrderMark (at (0)))
+        tokenStart += 3;
+
+    for (;;)
+    {
+        size_t offset = 0;
+
+        if (! skipWhitespaceAndComments (offset))
+            return setError ("not enough input");
+
+        ensureAvailable (offset + 9);
+
+        if (! XmlStreamReaderHelpers::startsWith (at (offset), "<!DOCTYPE"))
+        {
+            tokenStart += offset;
+            break;
+        }
+
+        // The DTD is skipped, so any entities that it declares won't be expanded
+        offset += 9;
+
+        for (int nesting = 1; nesting > 0; ++offset)
+        {
+            if (! ensureAvailable (offset))
+                return setError ("malformed DTD");
+
+            if (*at (offset) == '<')
+                ++nesting;
+            else if (*at (offset) == '>')
+                --nesting;
+        }
+
+        tokenStart += offset;
+    }
+
+    if (*at (0) != '<')
+        return setError ("expected the document element");
+
+    return readStartElement();
+}
+
+//==============================================================================
+XmlStreamReader::Event XmlStreamReader::readStartElement()
+{
+    using namespace XmlStreamReaderHelpers;
+
+    // Find the end of the tag first, so that the whole tag is in the buffer
+    size_t end = 1;
+
+    for (char quote = 0;; ++end)
+    {
+        if (! ensureAvailable (end))
+            return setError ("unexpected end of input");
+
+        const auto c = *at (end);
+
+        if (quote != 0)
+        {
+            if (c == quote)
+                quote = 0;
+        }
+        else if (c == '"' || c == '\'')
+        {
+            quote = c;
+        }
+        else if (c == '>')
+        {
+            break;
+        }
+    }
+
+    // Allow for a gap after the '<', like XmlDocument
+    auto* nameStart = skipWhitespace (at (1));
+    auto* nameEnd = findEndOfName (nameStart);
+
+    if (nameEnd == nameStart)
+        return setError ("tag name missing");
+
+    auto* p = nameEnd;
+    bool isEmptyElement = false;
+
+    for (;;)
+    {
+        p = skipWhitespace (p);
+
+        if (*p == '/' && p[1] == '>')
+        {
+            isEmptyElement = true;
+            break;
+        }
+
+        if (*p == '>')
+            break;
+
+        if (! isIdentifierByte (*p))
+            return setError ("illegal character found in " + String (CharPointer_UTF8 (nameStart), CharPointer_UTF8 (nameEnd))
+                               + ": '" + String::charToString ((juce_wchar) (uint8) *p) + "'");
+
+        auto* attributeName = p;
+        auto* attributeNameEnd = findEndOfName (p);
+        p = skipWhitespace (attributeNameEnd);
+
+        if (*p != '=')
+            return setError ("expected '=' after attribute '"
+                               + String (CharPointer_UTF8 (attributeName), CharPointer_UTF8 (attributeNameEnd)) + "'");
+
+        p = skipWhitespace (p + 1);
+        const auto quote = *p;
+
+        if (quote != '"' && quote != '\'')
+            return setError ("expected a quoted value for attribute '"
+                               + String (CharPointer_UTF8 (attributeName), CharPointer_UTF8 (attributeNameEnd)) + "'");
+
+        // The end of the tag was found by matching quotes, so the closing quote must be there
+        auto* valueStart = ++p;
+        auto* dest = valueStart;
+
+        while (*p != quote)
+        {
+            if (*p == '&')
+                dest = decodeEntity (p, dest);
+            else
+                *dest++ = *p++;
+        }
+
+        *dest = 0;
+        *attributeNameEnd = 0;
+        ++p;
+
+        if ((size_t) numAttributes == attributes.size())
+            attributes.push_back ({});
+
+        attributes[(size_t) numAttributes++] = { attributeName, valueStart };
+    }
+
+    *nameEnd = 0;
+    name = StringRef (CharPointer_UTF8 (nameStart));
+
+    ++depth;
+    pendingSelfClose = isEmptyElement;
+    tokenStart += end + 1;
+    return event = Event::startElement;
+}
+
+XmlStreamReader::Event XmlStreamReader::readEndElement()
+{
+    using namespace XmlStreamReaderHelpers;
+
+    const auto end = find ('>', 2);
+
+    if (end == notFound)
+        return setError ("unmatched tags");
+
+    auto* nameStart = skipWhitespace (at (2));
+    *findEndOfName (nameStart) = 0;
+    name = StringRef (CharPointer_UTF8 (nameStart));
+
+    tokenStart += end + 1;
+    return event = Event::endElement;
+}
+
+XmlStreamReader::Event XmlStreamReader::readCData()
+{
+    const auto end = find ("]]>", 9);
+
+    if (end == XmlStreamReaderHelpers::notFound)
+        return setError ("unterminated CDATA section");
+
+    *at (end) = 0;
+    text = StringRef (CharPointer_UTF8 (at (9)));
+
+    tokenStart += end + 3;
+    return event = Event::text;
+}
+
+XmlStreamReader::Event XmlStreamReader::readText()
+{
+    using namespace XmlStreamReaderHelpers;
+
+    // Find the end of the text first, which is the next tag that isn't a comment
+    size_t end = 0;
+
+    for (;;)
+    {
+        end = find ('<', end);
+
+        if (end == notFound)
+            return setError ("unmatched tags");
+
+        ensureAvailable (end + 3);
+
+        if (! startsWith (at (end), "<!--"))
+            break;
+
+        end = find ("-->", end + 4);
+
+        if (end == notFound)
+            return setError ("unterminated comment");
+
+        end += 3;
+    }
+
+    // Now remove comments, replace entities and normalise line endings in place
+    auto* src = at (0);
+    auto* const endOfText = at (end);
+    auto* dest = at (0);
+    bool hasContent = ! ignoreEmptyTextElements;
+
+    while (src < endOfText)
+    {
+        const auto c = *src;
+
+        if (c == '<')
+        {
+            // This must be a comment, which was found to be terminated above
+            src += 4;
+
+            while (! startsWith (src, "-->"))
+                ++src;
+
+            src += 3;
+        }
+        else if (c == '&')
+        {
+            auto* decodeStart = dest;
+            dest = decodeEntity (src, dest);
+
+            for (auto* d = decodeStart; d < dest; ++d)
+                hasContent = hasContent || ! isWhitespace (*d);
+        }
+        else if (c == '\r')
+        {
+            *dest++ = '\n';
+            src += src[1] == '\n' ? 2 : 1;
+        }
+        else
+        {
+            hasContent = hasContent || ! isWhitespace (c);
+            *dest++ = c;
+            ++src;
+        }
+    }
+
+    if (! hasContent)
+    {
+        tokenStart += end;
+        return Event::none;
+    }
+
+    // The terminator may overwrite the '<' that starts the next tag, which is put back by next()
+    *dest = 0;
+    restoreOpenBracket = dest == endOfText;
+    text = StringRef (CharPointer_UTF8 (at (0)));
+
+    tokenStart += end;
+    return event = Event::text;
+}
+
+//==============================================================================
+StringRef XmlStreamReader::getAttributeName (int index) const noexcept
+{
+    if (isPositiveAndBelow (index, numAttributes))
+        return StringRef (CharPointer_UTF8 (attributes[(size_t) index].name));
+
+    return {};
+}
+
+StringRef XmlStreamReader::getAttributeValue (int index) const noexcept
+{
+    if (isPositiveAndBelow (index, numAttributes))
+        return StringRef (CharPointer_UTF8 (attributes[(size_t) index].value));
+
+    return {};
+}
+
+bool XmlStreamReader::hasAttribute (StringRef attributeName) const noexcept
+{
+    for (int i = 0; i < numAttributes; ++i)
+        if (getAttributeName (i) == attributeName)
+            return true;
+
+    return false;
+}
+
+StringRef XmlStreamReader::getAttributeValue (StringRef attributeName) const noexcept
+{
+    for (int i = 0; i < numAttributes; ++i)
+        if (getAttributeName (i) == attributeName)
+            return getAttributeValue (i);
+
+    return {};
+}
+
+//==============================================================================
+Identifier XmlStreamReader::getCachedName (const char* utf8)
+{
+    // Most documents only use a few different names, so this avoids looking them all up in the StringPool
+    uint32 hash = 2166136261u;
+
+    for (auto* p = utf8; *p != 0; ++p)
+        hash = (hash ^ (uint8) *p) * 16777619u;
+
+    auto& cached = nameCache[hash & (nameCache.size() - 1)];
+
+    if (cached.hash != hash || cached.name.toString() != StringRef (CharPointer_UTF8 (utf8)))
+        cached = { hash, Identifier (String (CharPointer_UTF8 (utf8))) };
+
+    return cached.name;
+}
+
+XmlElement* XmlStreamReader::createElement()
+{
+    auto* element = new XmlElement (getCachedName (name.text.getAddress()));
+    LinkedListPointer<XmlElement::XmlAttributeNode>::Appender attributeAppender (element->attributes);
+
+    for (int i = 0; i < numAttributes; ++i)
+        attributeAppender.append (new XmlElement::XmlAttributeNode (getCachedName (attributes[(size_t) i].name),
+                                                                    String (CharPointer_UTF8 (attributes[(size_t) i].value))));
+
+    return element;
+}
+
+bool XmlStreamReader::readChildElements (XmlElement& parent)
+{
+    LinkedListPointer<XmlElement>::Appender childAppender (parent.firstChildElement);
+
+    for (;;)
+    {
+        switch (next())
+        {
+            case Event::startElement:
+            {
+                auto* child = createElement();
+                childAppender.append (child);
+
+                if (! readChildElements (*child))
+                    return false;
+
+                break;
+            }
+
+            case Event::text:
+                childAppender.append (XmlElement::createTextElement (String (text.text)));
+                break;
+
+            case Event::endElement:
+                return true;
+
+            case Event::none:
+            case Event::endOfDocument:
+            case Event::error:
+                return false;
+        }
+    }
+}
+
+std::unique_ptr<XmlElement> XmlStreamReader::readElement()
+{
+    // The reader must be positioned at the start of an element!
+    jassert (event == Event::startElement);
+
+    if (event != Event::startElement)
+        return {};
+
+    std::unique_ptr<XmlElement> element (createElement());
+
+    if (! readChildElements (*element))
+        return {};
+
+    return element;
+}
+
+bool XmlStreamReader::skipElement()
+{
+    // The reader must be positioned at the start of an element!
+    jassert (event == Event::startElement);
+
+    if (event != Event::startElement)
+        return false;
+
+    const auto elementDepth = depth;
+
+    for (;;)
+    {
+        switch (next())
+        {
+            case Event::endElement:
+                if (depth == elementDepth)
+                    return true;
+
+                break;
+
+            case Event::startElement:
+            case Event::text:
+                break;
+
+            case Event::none:
+            case Event::endOfDocument:
+            case Event::error:
+                return false;
+        }
+    }
+}
+
+} // namespace juce
@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Reads an XML document from a stream, one item at a time.
+
+    XmlDocument always builds an XmlElement tree for the whole document, which can
+    take a long time and a lot of memory for very large files. An XmlStreamReader
+    instead reads the document incrementally, and each call to next() moves on to
+    the next start tag, end tag or block of text. Only a small part of the document is
+    held in memory at any time.
+
+    Names, attribute values and text are returned as StringRefs that point directly
+    into the reader's buffer, so reading them doesn't allocate any memory. They're only
+    valid until the next call to next(), so copy them into a String if you need to keep
+    them for longer. When you find an element that you want to keep, readElement() will
+    turn it into an XmlElement.
+
+    @code
+    FileInputStream stream (file);
+    XmlStreamReader reader (stream);
+
+    while (reader.next() == XmlStreamReader::Event::startElement)
+    {
+        if (reader.getName() == StringRef ("TRACK"))
+            tracks.add (reader.readElement().release());
+    }
+
+    if (reader.getEvent() == XmlStreamReader::Event::error)
+        DBG (reader.getLastError());
+    @endcode
+
+    The reader handles the same syntax as XmlDocument, except that the DTD is skipped
+    rather than parsed, so references to entities declared in it are left in the text
+    unchanged. Comments and processing instructions are skipped. The input must be
+    UTF-8 (or ASCII).
+
+    @see XmlDocument, XmlElement
+
+    @tags{Core}
+*/
+class JUCE_API  XmlStreamReader
+{
+public:
+    //==============================================================================
+    /** Creates a reader which will read from the given stream. The stream must stay
+        valid for the lifetime of the reader.
+    */
+    explicit XmlStreamReader (InputStream& sourceStream);
+
+    /** Creates a reader which will read from the given stream, and may take ownership
+        of it.
+    */
+    XmlStreamReader (InputStream* sourceStream, bool deleteSourceWhenDestroyed);
+
+    /** Destructor. */
+    ~XmlStreamReader();
+
+    //==============================================================================
+    /** The kinds of item that the reader can be positioned at. */
+    enum class Event
+    {
+        none,               ///< next() hasn't been called yet
+        startElement,       ///< An opening tag. Use getName() and the attribute methods to find out more.
+        endElement,         ///< A closing tag. Empty elements like <TAG/> produce a startElement followed by an endElement.
+        text,               ///< A block of text, or a CDATA section. Use getText() to read it.
+        endOfDocument,      ///< The outer element has been closed. Anything after it is ignored.
+        error               ///< The document was malformed. Use getLastError() to find out why.
+    };
+
+    /** Moves on to the next item in the document, and returns its type.
+
+        Once the end of the document or an error has been reached, this will keep
+        returning the same result.
+    */
+    Event next();
+
+    /** Returns the type of the item that the reader is currently positioned at. */
+    Event getEvent() const noexcept                     { return event; }
+
+    /** Returns the number of elements that are open at the current position. For a
+        startElement or endElement this includes the element itself, so the outer element
+        has a depth of 1, its child elements have a depth of 2, etc.
+    */
+    int getDepth() const noexcept                       { return depth; }
+
+    //==============================================================================
+    /** Returns the tag name of the current startElement or endElement. */
+    StringRef getName() const noexcept                  { return name; }
+
+    /** Returns the number of attributes of the current startElement. */
+    int getNumAttributes() const noexcept               { return numAttributes; }
+
+    /** Returns the name of one of the current element's attributes. */
+    StringRef getAttributeName (int index) const noexcept;
+
+    /** Returns the value of one of the current element's attributes, with any entities
+        already replaced.
+    */
+    StringRef getAttributeValue (int index) const noexcept;
+
+    /** Returns true if the current element has an attribute with the given name. */
+    bool hasAttribute (StringRef attributeName) const noexcept;
+
+    /** Returns the value of the current element's attribute with the given name, or an
+        empty string if there isn't one.
+    */
+    StringRef getAttributeValue (StringRef attributeName) const noexcept;
+
+    /** Returns the content of the current text item, with any entities already replaced. */
+    StringRef getText() const noexcept                  { return text; }
+
+    //==============================================================================
+    /** Reads the current startElement and everything inside it into an XmlElement.
+
+        When this returns, the reader is positioned at the element's endElement. This
+        returns nullptr if the reader isn't positioned at a startElement, or if the
+        document is malformed before the end of the element.
+    */
+    std::unique_ptr<XmlElement> readElement();
+
+    /** Skips over everything inside the current startElement, leaving the reader
+        positioned at its endElement.
+        Returns false if the document is malformed before the end of the element.
+    */
+    bool skipElement();
+
+    //==============================================================================
+    /** Returns the reason for the last error, or an empty string if there wasn't one. */
+    const String& getLastError() const noexcept         { return lastError; }
+
+    /** Sets a flag to change the treatment of empty text elements.
+
+        If this is true (the default state), text that contains only whitespace is
+        skipped, like XmlDocument::setEmptyTextElementsIgnored().
+    */
+    void setEmptyTextElementsIgnored (bool shouldBeIgnored) noexcept    { ignoreEmptyTextElements = shouldBeIgnored; }
+
+private:
+    //==============================================================================
+    struct Attribute
+    {
+        const char* name;
+        const char* value;
+    };
+
+    struct CachedName
+    {
+        uint32 hash = 0;
+        Identifier name;
+    };
+
+    OptionalScopedPointer<InputStream> source;
+    HeapBlock<char> buffer;
+    size_t bufferSize = 0, tokenStart = 0, dataEnd = 0;
+    bool sourceExhausted = false, pendingSelfClose = false, restoreOpenBracket = false;
+    bool ignoreEmptyTextElements = true;
+
+    Event event = Event::none;
+    int depth = 0, numAttributes = 0;
+    std::vector<Attribute> attributes;
+    std::array<CachedName, 256> nameCache;
+    StringRef name, text;
+    String lastError;
+
+    char* at (size_t offset) const noexcept             { return buffer + tokenStart + offset; }
+    bool readMoreData();
+    bool ensureAvailable (size_t offset);
+    size_t find (char c, size_t from);
+    size_t find (const char* sequence, size_t from);
+
+    Event setError (const String&);
+    Event readPrologue();
+    bool skipWhitespaceAndComments (size_t& offset);
+    Event readStartElement();
+    Event readEndElement();
+    Event readText();
+    Event readCData();
+    Identifier getCachedName (const char* utf8);
+    XmlElement* createElement();
+    bool readChildElements (XmlElement&);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (XmlStreamReader)
+};
+
+} // namespace juce
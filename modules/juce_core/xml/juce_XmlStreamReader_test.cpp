@@ -0,0 +1,345 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class XmlStreamReaderTests final : public UnitTest
+{
+public:
+    XmlStreamReaderTests()
+        : UnitTest ("XmlStreamReader", UnitTestCategories::xml)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Events are produced in document order");
+        {
+            expectEquals (getEvents (R"(<?xml version="1.0"?><a x="1" y='two'><b/>text<c>more</c></a>)"),
+                          String ("<a x=1 y=two> <b> </b> [text] <c> [more] </c> </a> end"));
+
+            expectEquals (getEvents ("<a><b><c/></b></a>", true), String ("1<a> 2<b> 3<c> 3</c> 2</b> 1</a> end"));
+        }
+
+        beginTest ("Attribute lookup");
+        {
+            const auto* text = R"(<a first="1" second="&lt;2&gt;"/>)";
+            MemoryInputStream stream (text, std::strlen (text), false);
+            XmlStreamReader reader (stream);
+
+            expect (reader.next() == XmlStreamReader::Event::startElement);
+            expectEquals (reader.getNumAttributes(), 2);
+            expect (reader.hasAttribute ("second"));
+            expect (! reader.hasAttribute ("third"));
+            expectEquals (String (reader.getAttributeValue ("second").text), String ("<2>"));
+            expectEquals (String (reader.getAttributeValue ("third").text), String());
+            expectEquals (String (reader.getAttributeName (0).text), String ("first"));
+            expectEquals (String (reader.getAttributeName (2).text), String());
+        }
+
+        beginTest ("Text handling");
+        {
+            expectEquals (getEvents ("<a>x &amp; &#65;&#x42; &apos;&quot;</a>"), String ("<a> [x & AB '\"] </a> end"));
+            expectEquals (getEvents ("<a>one<!-- comment <b> -->two</a>"), String ("<a> [onetwo] </a> end"));
+            expectEquals (getEvents ("<a><![CDATA[<b>&amp;</b>]]></a>"), String ("<a> [<b>&amp;</b>] </a> end"));
+            expectEquals (getEvents ("<a>line\r\nbreak\rhere</a>"), String ("<a> [line\nbreak\nhere] </a> end"));
+            expectEquals (getEvents ("<a>&unknown; &#xzz;</a>"), String ("<a> [&unknown; &#xzz;] </a> end"));
+            expectEquals (getEvents ("<a> <b/> x </a>"), String ("<a> <b> </b> [ x ] </a> end"));
+
+            // Like XmlDocument, whitespace right before a tag is never reported
+            const auto* whitespace = "<a> &#32; <b> </b></a>";
+            expectEquals (getEvents (whitespace), String ("<a> <b> </b> </a> end"));
+
+            MemoryInputStream stream (whitespace, std::strlen (whitespace), false);
+            XmlStreamReader reader (stream);
+            reader.setEmptyTextElementsIgnored (false);
+            expectEquals (getEvents (reader), String ("<a> [   ] <b> </b> </a> end"));
+        }
+
+        beginTest ("The prologue is skipped");
+        {
+            const auto text = "\xef\xbb\xbf<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                              "<!-- comment -->\n"
+                              "<!DOCTYPE a [ <!ENTITY e \"x\"> ]>\n"
+                              "<a/> trailing junk";
+            expectEquals (getEvents (text), String ("<a> </a> end"));
+        }
+
+        beginTest ("Errors are reported");
+        {
+            expectError ("", "not enough input");
+            expectError ("  <!-- ", "not enough input");
+            expectError ("text", "expected the document element");
+            expectError ("<a><b></b>", "unmatched tags");
+            expectError ("<a>text", "unmatched tags");
+            expectError ("<a><![CDATA[ </a>", "unterminated CDATA section");
+            expectError ("<a>x<!-- </a>", "unterminated comment");
+            expectError ("<a x></a>", "expected '=' after attribute 'x'");
+            expectError ("<a x=1></a>", "expected a quoted value for attribute 'x'");
+            expectError ("<a><></a>", "tag name missing");
+            expectError ("<a x=\"1\"", "unexpected end of input");
+        }
+
+        beginTest ("Elements read from a stream match XmlDocument");
+        {
+            auto r = getRandom();
+            auto wrappedFormat = XmlElement::TextFormat().withoutHeader();
+            wrappedFormat.lineWrapLength = 10;
+
+            for (int i = 0; i < 100; ++i)
+            {
+                const auto element = createRandomElement (r, 0);
+
+                expectSameAsXmlDocument (element->toString(), 1 + r.nextInt (100));
+                expectSameAsXmlDocument (element->toString (wrappedFormat), 1 + r.nextInt (100));
+            }
+        }
+
+        beginTest ("Documents larger than the buffer");
+        {
+            auto r = getRandom();
+            XmlElement root ("ROOT");
+
+            for (int i = 0; i < 2000; ++i)
+                root.addChildElement (createRandomElement (r, 1).release());
+
+            root.addChildElement (XmlElement::createTextElement (String::repeatedString ("long text ", 20000)));
+
+            const auto text = root.toString();
+            expectGreaterThan (text.getNumBytesAsUTF8(), (size_t) 500000);
+            expectSameAsXmlDocument (text, 100000);
+        }
+
+        beginTest ("Selected elements can be read or skipped");
+        {
+            XmlElement root ("SESSION");
+
+            for (int i = 0; i < 100; ++i)
+            {
+                auto* child = root.createNewChildElement (i % 3 == 0 ? "TRACK" : "OTHER");
+                child->setAttribute ("index", i);
+                child->createNewChildElement ("CLIP")->setAttribute ("name", "clip" + String (i));
+            }
+
+            MemoryOutputStream text;
+            root.writeTo (text);
+
+            MemoryInputStream stream (text.getData(), text.getDataSize(), false);
+            XmlStreamReader reader (stream);
+
+            expect (reader.next() == XmlStreamReader::Event::startElement);
+            OwnedArray<XmlElement> tracks;
+
+            while (reader.next() == XmlStreamReader::Event::startElement)
+            {
+                if (reader.getName() == StringRef ("TRACK"))
+                {
+                    tracks.add (reader.readElement().release());
+                    expect (reader.getEvent() == XmlStreamReader::Event::endElement);
+                }
+                else
+                {
+                    expect (reader.skipElement());
+                }
+            }
+
+            expect (reader.getEvent() == XmlStreamReader::Event::endElement);
+            expect (reader.next() == XmlStreamReader::Event::endOfDocument);
+
+            expectEquals (tracks.size(), 34);
+
+            for (int i = 0; i < tracks.size(); ++i)
+                expect (tracks[i]->isEquivalentTo (root.getChildElement (i * 3), false));
+        }
+    }
+
+private:
+    // Returns a few bytes at a time, to exercise the reader's buffering
+    struct ChunkedInputStream final : public InputStream
+    {
+        ChunkedInputStream (const MemoryBlock& d, int maxChunk) : data (d), maxChunkSize (maxChunk) {}
+
+        int64 getTotalLength() override         { return (int64) data.getSize(); }
+        bool isExhausted() override             { return position >= data.getSize(); }
+        int64 getPosition() override            { return (int64) position; }
+        bool setPosition (int64) override       { return false; }
+
+        int read (void* dest, int numBytes) override
+        {
+            const auto num = jmin ((size_t) jmin (numBytes, maxChunkSize), data.getSize() - position);
+            std::memcpy (dest, static_cast<const char*> (data.getData()) + position, num);
+            position += num;
+            return (int) num;
+        }
+
+        const MemoryBlock& data;
+        int maxChunkSize;
+        size_t position = 0;
+    };
+
+    static String getEvents (XmlStreamReader& reader, bool includeDepth = false)
+    {
+        StringArray events;
+
+        for (;;)
+        {
+            const auto event = reader.next();
+            const auto depth = includeDepth ? String (reader.getDepth()) : String();
+
+            switch (event)
+            {
+                case XmlStreamReader::Event::startElement:
+                {
+                    auto s = depth + "<" + String (reader.getName().text);
+
+                    for (int i = 0; i < reader.getNumAttributes(); ++i)
+                        s << " " << String (reader.getAttributeName (i).text) << "=" << String (reader.getAttributeValue (i).text);
+
+                    events.add (s + ">");
+                    break;
+                }
+
+                case XmlStreamReader::Event::endElement:    events.add (depth + "</" + String (reader.getName().text) + ">"); break;
+                case XmlStreamReader::Event::text:          events.add ("[" + String (reader.getText().text) + "]"); break;
+                case XmlStreamReader::Event::endOfDocument: events.add ("end"); return events.joinIntoString (" ");
+                case XmlStreamReader::Event::error:         events.add ("error: " + reader.getLastError()); return events.joinIntoString (" ");
+                case XmlStreamReader::Event::none:          jassertfalse; return {};
+            }
+        }
+    }
+
+    static String getEvents (const char* text, bool includeDepth = false)
+    {
+        MemoryInputStream stream (text, std::strlen (text), false);
+        XmlStreamReader reader (stream);
+        return getEvents (reader, includeDepth);
+    }
+
+    void expectError (const char* text, const String& error)
+    {
+        MemoryInputStream stream (text, std::strlen (text), false);
+        XmlStreamReader reader (stream);
+
+        while (reader.next() != XmlStreamReader::Event::error)
+        {
+            if (reader.getEvent() == XmlStreamReader::Event::endOfDocument)
+            {
+                expect (false, String ("no error for: ") + text);
+                return;
+            }
+        }
+
+        expectEquals (reader.getLastError(), error);
+        expect (reader.next() == XmlStreamReader::Event::error);
+    }
+
+    void expectSameAsXmlDocument (const String& text, int maxChunkSize)
+    {
+        const auto expected = parseXML (text);
+        expect (expected != nullptr);
+
+        MemoryBlock data (text.toRawUTF8(), text.getNumBytesAsUTF8());
+        ChunkedInputStream stream (data, maxChunkSize);
+        XmlStreamReader reader (stream);
+
+        expect (reader.next() == XmlStreamReader::Event::startElement);
+        const auto element = reader.readElement();
+        expect (element != nullptr && expected != nullptr && isIdentical (*element, *expected));
+        expect (reader.next() == XmlStreamReader::Event::endOfDocument);
+    }
+
+    // Unlike XmlElement::isEquivalentTo, this also checks the order of the attributes and text
+    static bool isIdentical (const XmlElement& a, const XmlElement& b)
+    {
+        if (a.getTagName() != b.getTagName() || a.getNumAttributes() != b.getNumAttributes() || a.getNumChildElements() != b.getNumChildElements())
+            return false;
+
+        for (int i = 0; i < a.getNumAttributes(); ++i)
+            if (a.getAttributeName (i) != b.getAttributeName (i) || a.getAttributeValue (i) != b.getAttributeValue (i))
+                return false;
+
+        for (int i = 0; i < a.getNumChildElements(); ++i)
+            if (! isIdentical (*a.getChildElement (i), *b.getChildElement (i)))
+                return false;
+
+        return true;
+    }
+
+    static String createRandomText (Random& r)
+    {
+        const char* pieces[] = { "abc", " ", "<", ">", "&", "\"", "'", "\n", "x y", "\xc3\xa9", "\xe2\x82\xac", "123" };
+        String s;
+
+        for (int i = r.nextInt (8); --i >= 0;)
+            s << String (CharPointer_UTF8 (pieces[r.nextInt ((int) numElementsInArray (pieces))]));
+
+        return s;
+    }
+
+    static std::unique_ptr<XmlElement> createRandomElement (Random& r, int depth)
+    {
+        auto element = std::make_unique<XmlElement> ("E" + String (r.nextInt (20)));
+
+        for (int i = r.nextInt (4); --i >= 0;)
+            element->setAttribute ("a" + String (i), createRandomText (r));
+
+        if (depth < 4)
+        {
+            for (int i = r.nextInt (5); --i >= 0;)
+            {
+                if (r.nextInt (3) == 0)
+                {
+                    const auto text = createRandomText (r);
+
+                    // Adjacent text elements would be merged when they're read back
+                    const auto numChildren = element->getNumChildElements();
+
+                    if (text.containsNonWhitespaceChars()
+                         && (numChildren == 0 || ! element->getChildElement (numChildren - 1)->isTextElement()))
+                        element->addTextElement ("t" + text);
+                }
+                else
+                {
+                    element->addChildElement (createRandomElement (r, depth + 1).release());
+                }
+            }
+        }
+
+        return element;
+    }
+};
+
+static XmlStreamReaderTests xmlStreamReaderTests;
+
+} // namespace juce
@@ -155,7 +155,8 @@ ConvolutionMessageQueue& ConvolutionMessageQueue::operator= (ConvolutionMessageQ
 //==============================================================================
 struct ConvolutionEngine
 {
-    ConvolutionEngine (const float* samples,
+    ConvolutionEngine (const float* const* samples,
+                       size_t numChannels,
                        size_t numSamples,
                        size_t maxBlockSize)
         : blockSize ((size_t) nextPowerOfTwo ((int) maxBlockSize)),
@@ -163,15 +164,15 @@ struct ConvolutionEngine
           fftObject (std::make_unique<FFT> (roundToInt (std::log2 (fftSize)))),
           numSegments (numSamples / (fftSize - blockSize) + 1u),
           numInputSegments ((blockSize > 128 ? numSegments : 3 * numSegments)),
-          bufferInput      (1, static_cast<int> (fftSize)),
-          bufferOutput     (1, static_cast<int> (fftSize * 2)),
-          bufferTempOutput (1, static_cast<int> (fftSize * 2)),
-          bufferOverlap    (1, static_cast<int> (fftSize))
+          bufferInput      ((int) numChannels, static_cast<int> (fftSize)),
+          bufferOutput     ((int) numChannels, static_cast<int> (fftSize * 2)),
+          bufferTempOutput ((int) numChannels, static_cast<int> (fftSize * 2)),
+          bufferOverlap    ((int) numChannels, static_cast<int> (fftSize))
     {
         bufferOutput.clear();
 
-        auto updateSegmentsIfNecessary = [this] (size_t numSegmentsToUpdate,
-                                                 std::vector<AudioBuffer<float>>& segments)
+        auto updateSegmentsIfNecessary = [this, numChannels] (size_t numSegmentsToUpdate,
+                                                              std::vector<AudioBuffer<float>>& segments)
         {
             if (numSegmentsToUpdate == 0
                 || numSegmentsToUpdate != (size_t) segments.size()
@@ -180,7 +181,7 @@ struct ConvolutionEngine
                 segments.clear();
 
                 for (size_t i = 0; i < numSegmentsToUpdate; ++i)
-                    segments.push_back ({ 1, static_cast<int> (fftSize * 2) });
+                    segments.push_back ({ (int) numChannels, static_cast<int> (fftSize * 2) });
             }
         };
 
@@ -194,17 +195,22 @@ struct ConvolutionEngine
         {
             buf.clear();
 
-            auto* impulseResponse = buf.getWritePointer (0);
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto* impulseResponse = buf.getWritePointer ((int) channel);
 
-            if (&buf == &buffersImpulseSegments.front())
-                impulseResponse[0] = 1.0f;
+                if (&buf == &buffersImpulseSegments.front())
+                    impulseResponse[0] = 1.0f;
 
-            FloatVectorOperations::copy (impulseResponse,
-                                         samples + currentPtr,
-                                         static_cast<int> (jmin (fftSize - blockSize, numSamples - currentPtr)));
+                FloatVectorOperations::copy (impulseResponse,
+                                             samples[channel] + currentPtr,
+                                             static_cast<int> (jmin (fftSize - blockSize, numSamples - currentPtr)));
+            }
 
-            FFTTempObject->performRealOnlyForwardTransform (impulseResponse);
-            prepareForConvolution (impulseResponse);
+            FFTTempObject->performRealOnlyForwardTransform (AudioBlock<float> (buf));
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+                prepareForConvolution (buf.getWritePointer ((int) channel));
 
             currentPtr += (fftSize - blockSize);
         }
@@ -226,79 +232,57 @@ struct ConvolutionEngine
         inputDataPos = 0;
     }
 
-    void processSamples (const float* input, float* output, size_t numSamples)
+    size_t getNumChannels() const noexcept    { return (size_t) bufferInput.getNumChannels(); }
+
+    void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
     {
         // Overlap-add, zero latency convolution algorithm with uniform partitioning
+        const auto numChannels = jmin (getNumChannels(), input.getNumChannels(), output.getNumChannels());
+        const auto numSamples  = jmin (input.getNumSamples(), output.getNumSamples());
         size_t numSamplesProcessed = 0;
 
-        auto indexStep = numInputSegments / numSegments;
-
-        auto* inputData      = bufferInput.getWritePointer (0);
-        auto* outputTempData = bufferTempOutput.getWritePointer (0);
-        auto* outputData     = bufferOutput.getWritePointer (0);
-        auto* overlapData    = bufferOverlap.getWritePointer (0);
-
         while (numSamplesProcessed < numSamples)
         {
             const bool inputDataWasEmpty = (inputDataPos == 0);
             auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, blockSize - inputDataPos);
 
-            FloatVectorOperations::copy (inputData + inputDataPos, input + numSamplesProcessed, static_cast<int> (numSamplesToProcess));
-
-            auto* inputSegmentData = buffersInputSegments[currentSegment].getWritePointer (0);
-            FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
+            for (size_t channel = 0; channel < numChannels; ++channel)
+                FloatVectorOperations::copy (bufferInput.getWritePointer ((int) channel) + inputDataPos,
+                                             input.getChannelPointer (channel) + numSamplesProcessed,
+                                             static_cast<int> (numSamplesToProcess));
 
-            fftObject->performRealOnlyForwardTransform (inputSegmentData);
-            prepareForConvolution (inputSegmentData);
+            convolveCurrentSegment (numChannels, inputDataWasEmpty);
 
-            // Complex multiplication
-            if (inputDataWasEmpty)
+            for (size_t channel = 0; channel < numChannels; ++channel)
             {
-                FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
-
-                auto index = currentSegment;
-
-                for (size_t i = 1; i < numSegments; ++i)
-                {
-                    index += indexStep;
-
-                    if (index >= numInputSegments)
-                        index -= numInputSegments;
-
-                    convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
-                                                        buffersImpulseSegments[i].getWritePointer (0),
-                                                        outputTempData);
-                }
+                // Add overlap
+                FloatVectorOperations::add (output.getChannelPointer (channel) + numSamplesProcessed,
+                                            bufferOutput.getReadPointer ((int) channel, (int) inputDataPos),
+                                            bufferOverlap.getReadPointer ((int) channel, (int) inputDataPos),
+                                            (int) numSamplesToProcess);
             }
 
-            FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
-
-            convolutionProcessingAndAccumulate (inputSegmentData,
-                                                buffersImpulseSegments.front().getWritePointer (0),
-                                                outputData);
-
-            updateSymmetricFrequencyDomainData (outputData);
-            fftObject->performRealOnlyInverseTransform (outputData);
-
-            // Add overlap
-            FloatVectorOperations::add (&output[numSamplesProcessed], &outputData[inputDataPos], &overlapData[inputDataPos], (int) numSamplesToProcess);
-
             // Input buffer full => Next block
             inputDataPos += numSamplesToProcess;
 
             if (inputDataPos == blockSize)
             {
-                // Input buffer is empty again now
-                FloatVectorOperations::fill (inputData, 0.0f, static_cast<int> (fftSize));
+                for (size_t channel = 0; channel < numChannels; ++channel)
+                {
+                    auto* outputData  = bufferOutput.getWritePointer ((int) channel);
+                    auto* overlapData = bufferOverlap.getWritePointer ((int) channel);
 
-                inputDataPos = 0;
+                    // Input buffer is empty again now
+                    FloatVectorOperations::fill (bufferInput.getWritePointer ((int) channel), 0.0f, static_cast<int> (fftSize));
 
-                // Extra step for segSize > blockSize
-                FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (fftSize - 2 * blockSize));
+                    // Extra step for segSize > blockSize
+                    FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (fftSize - 2 * blockSize));
 
-                // Save the overlap
-                FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (fftSize - blockSize));
+                    // Save the overlap
+                    FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (fftSize - blockSize));
+                }
 
+                inputDataPos = 0;
                 currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
             }
 
@@ -306,25 +290,27 @@ struct ConvolutionEngine
         }
     }
 
-    void processSamplesWithAddedLatency (const float* input, float* output, size_t numSamples)
+    void processSamplesWithAddedLatency (const AudioBlock<const float>& input, AudioBlock<float>& output)
     {
         // Overlap-add, zero latency convolution algorithm with uniform partitioning
+        const auto numChannels = jmin (getNumChannels(), input.getNumChannels(), output.getNumChannels());
+        const auto numSamples  = jmin (input.getNumSamples(), output.getNumSamples());
         size_t numSamplesProcessed = 0;
 
-        auto indexStep = numInputSegments / numSegments;
-
-        auto* inputData      = bufferInput.getWritePointer (0);
-        auto* outputTempData = bufferTempOutput.getWritePointer (0);
-        auto* outputData     = bufferOutput.getWritePointer (0);
-        auto* overlapData    = bufferOverlap.getWritePointer (0);
-
         while (numSamplesProcessed < numSamples)
         {
             auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed, blockSize - inputDataPos);
 
-            FloatVectorOperations::copy (inputData + inputDataPos, input + numSamplesProcessed, static_cast<int> (numSamplesToProcess));
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                FloatVectorOperations::copy (bufferInput.getWritePointer ((int) channel) + inputDataPos,
+                                             input.getChannelPointer (channel) + numSamplesProcessed,
+                                             static_cast<int> (numSamplesToProcess));
 
-            FloatVectorOperations::copy (output + numSamplesProcessed, outputData + inputDataPos, static_cast<int> (numSamplesToProcess));
+                FloatVectorOperations::copy (output.getChannelPointer (channel) + numSamplesProcessed,
+                                             bufferOutput.getReadPointer ((int) channel, (int) inputDataPos),
+                                             static_cast<int> (numSamplesToProcess));
+            }
 
             numSamplesProcessed += numSamplesToProcess;
             inputDataPos += numSamplesToProcess;
@@ -332,14 +318,89 @@ struct ConvolutionEngine
             // processing itself when needed (with latency)
             if (inputDataPos == blockSize)
             {
-                // Copy input data in input segment
-                auto* inputSegmentData = buffersInputSegments[currentSegment].getWritePointer (0);
-                FloatVectorOperations::copy (inputSegmentData, inputData, static_cast<int> (fftSize));
+                processFullBlock (numChannels);
+                inputDataPos = 0;
+            }
+        }
+    }
 
-                fftObject->performRealOnlyForwardTransform (inputSegmentData);
-                prepareForConvolution (inputSegmentData);
+    // Convolves exactly one block of input, and returns the matching block of output straight
+    // away rather than during the next call, as processSamplesWithAddedLatency() would. The
+    // output is therefore delayed by one block less.
+    void processBlock (const AudioBlock<const float>& input, AudioBlock<float>& output)
+    {
+        jassert (inputDataPos == 0 && input.getNumSamples() == blockSize && output.getNumSamples() == blockSize);
+
+        const auto numChannels = jmin (getNumChannels(), input.getNumChannels(), output.getNumChannels());
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            FloatVectorOperations::copy (bufferInput.getWritePointer ((int) channel),
+                                         input.getChannelPointer (channel),
+                                         static_cast<int> (blockSize));
+
+        processFullBlock (numChannels);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            FloatVectorOperations::copy (output.getChannelPointer (channel),
+                                         bufferOutput.getReadPointer ((int) channel),
+                                         static_cast<int> (blockSize));
+    }
+
+    // Once a whole block of input has been collected, leaves the next block of output at the
+    // start of bufferOutput, ready to be read back.
+    void processFullBlock (size_t numChannels)
+    {
+        convolveCurrentSegment (numChannels, true);
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            auto* outputData  = bufferOutput.getWritePointer ((int) channel);
+            auto* overlapData = bufferOverlap.getWritePointer ((int) channel);
+
+            // Add overlap
+            FloatVectorOperations::add (outputData, overlapData, static_cast<int> (blockSize));
+
+            // Input buffer is empty again now
+            FloatVectorOperations::fill (bufferInput.getWritePointer ((int) channel), 0.0f, static_cast<int> (fftSize));
+
+            // Extra step for segSize > blockSize
+            FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (fftSize - 2 * blockSize));
+
+            // Save the overlap
+            FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (fftSize - blockSize));
+        }
+
+        currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
+    }
+
+    // Transforms the current input of every channel, multiplies it with the IR segments, and
+    // leaves the time domain result in bufferOutput. All of the channels are passed to the FFT
+    // together, so that engines which can transform several channels at once are able to.
+    void convolveCurrentSegment (size_t numChannels, bool updateOlderSegments)
+    {
+        auto& inputSegment = buffersInputSegments[currentSegment];
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+            FloatVectorOperations::copy (inputSegment.getWritePointer ((int) channel),
+                                         bufferInput.getReadPointer ((int) channel),
+                                         static_cast<int> (fftSize));
+
+        fftObject->performRealOnlyForwardTransform (AudioBlock<float> (inputSegment).getSubsetChannelBlock (0, numChannels));
 
-                // Complex multiplication
+        const auto indexStep = numInputSegments / numSegments;
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            const auto ch = (int) channel;
+            auto* inputSegmentData = inputSegment.getWritePointer (ch);
+            auto* outputTempData   = bufferTempOutput.getWritePointer (ch);
+            auto* outputData       = bufferOutput.getWritePointer (ch);
+
+            prepareForConvolution (inputSegmentData);
+
+            // Complex multiplication
+            if (updateOlderSegments)
+            {
                 FloatVectorOperations::fill (outputTempData, 0, static_cast<int> (fftSize + 1));
 
                 auto index = currentSegment;
@@ -351,37 +412,22 @@ struct ConvolutionEngine
                     if (index >= numInputSegments)
                         index -= numInputSegments;
 
-                    convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (0),
-                                                        buffersImpulseSegments[i].getWritePointer (0),
+                    convolutionProcessingAndAccumulate (buffersInputSegments[index].getWritePointer (ch),
+                                                        buffersImpulseSegments[i].getWritePointer (ch),
                                                         outputTempData);
                 }
+            }
 
-                FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
-
-                convolutionProcessingAndAccumulate (inputSegmentData,
-                                                    buffersImpulseSegments.front().getWritePointer (0),
-                                                    outputData);
-
-                updateSymmetricFrequencyDomainData (outputData);
-                fftObject->performRealOnlyInverseTransform (outputData);
-
-                // Add overlap
-                FloatVectorOperations::add (outputData, overlapData, static_cast<int> (blockSize));
-
-                // Input buffer is empty again now
-                FloatVectorOperations::fill (inputData, 0.0f, static_cast<int> (fftSize));
-
-                // Extra step for segSize > blockSize
-                FloatVectorOperations::add (&(outputData[blockSize]), &(overlapData[blockSize]), static_cast<int> (fftSize - 2 * blockSize));
-
-                // Save the overlap
-                FloatVectorOperations::copy (overlapData, &(outputData[blockSize]), static_cast<int> (fftSize - blockSize));
+            FloatVectorOperations::copy (outputData, outputTempData, static_cast<int> (fftSize + 1));
 
-                currentSegment = (currentSegment > 0) ? (currentSegment - 1) : (numInputSegments - 1);
+            convolutionProcessingAndAccumulate (inputSegmentData,
+                                                buffersImpulseSegments.front().getWritePointer (ch),
+                                                outputData);
 
-                inputDataPos = 0;
-            }
+            updateSymmetricFrequencyDomainData (outputData);
         }
+
+        fftObject->performRealOnlyInverseTransform (AudioBlock<float> (bufferOutput).getSubsetChannelBlock (0, numChannels));
     }
 
     // After each FFT, this function is called to allow convolution to be performed with only 4 SIMD functions calls.
@@ -446,6 +492,229 @@ struct ConvolutionEngine
     std::vector<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
 };
 
+//==============================================================================
+// One stage of a non-uniformly partitioned tail. Each block of input is convolved on a
+// background thread while the following block is being collected, so the output of a
+// stage is two blocks late. The IR of the stage is padded with silence to line this delay
+// up with the stage's position in the full IR.
+class ConvolutionTailStage
+{
+public:
+    ConvolutionTailStage (const AudioBuffer<float>& ir,
+                          int numChannels,
+                          int offset,
+                          int length,
+                          int padding,
+                          int partitionSize)
+        : blockSize ((size_t) partitionSize)
+    {
+        AudioBuffer<float> padded (numChannels, padding + length);
+        padded.clear();
+
+        for (int i = 0; i < numChannels; ++i)
+            padded.copyFrom (i, padding, ir, jmin (ir.getNumChannels() - 1, i), offset, length);
+
+        engine = std::make_unique<ConvolutionEngine> (padded.getArrayOfReadPointers(),
+                                                      (size_t) numChannels,
+                                                      (size_t) padded.getNumSamples(),
+                                                      blockSize);
+
+        for (auto* buffers : { &inputs, &outputs })
+            for (auto& buffer : *buffers)
+                buffer.setSize (numChannels, partitionSize);
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        waitForJob();
+        state = JobState::idle;
+        engine->reset();
+
+        for (auto* buffers : { &inputs, &outputs })
+            for (auto& buffer : *buffers)
+                buffer.clear();
+
+        position = 0;
+        current = 0;
+    }
+
+    // Adds the output of this stage to the output block, and returns true if a new block of
+    // input was passed on to the background thread.
+    bool processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output) noexcept
+    {
+        const auto numChannels = jmin ((size_t) inputs[0].getNumChannels(), input.getNumChannels(), output.getNumChannels());
+        const auto numSamples = jmin (input.getNumSamples(), output.getNumSamples());
+        auto startedJob = false;
+
+        for (size_t done = 0; done < numSamples;)
+        {
+            const auto numToProcess = jmin (numSamples - done, blockSize - position);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                const auto ch = (int) channel;
+
+                FloatVectorOperations::copy (inputs[current].getWritePointer (ch, (int) position),
+                                             input.getChannelPointer (channel) + done,
+                                             (int) numToProcess);
+
+                FloatVectorOperations::add (output.getChannelPointer (channel) + done,
+                                            outputs[current].getReadPointer (ch, (int) position),
+                                            (int) numToProcess);
+            }
+
+            done += numToProcess;
+            position += numToProcess;
+
+            if (position == blockSize)
+            {
+                // The output of the previous job is played back during the next block. If
+                // the background thread hasn't finished it, the audio thread runs it or waits
+                // for it here, which can cost as much as the whole partition.
+                waitForJob();
+
+                current ^= 1;
+                position = 0;
+                state.store (JobState::pending, std::memory_order_release);
+                startedJob = true;
+            }
+        }
+
+        return startedJob;
+    }
+
+    // May be called from either the audio thread or the background thread
+    void runPendingJob() noexcept
+    {
+        auto expected = JobState::pending;
+
+        if (! state.compare_exchange_strong (expected, JobState::running, std::memory_order_acquire))
+            return;
+
+        // The audio thread won't touch these buffers again until the job is done
+        const AudioBlock<const float> jobInput (inputs[current ^ 1]);
+        AudioBlock<float> jobOutput (outputs[current ^ 1]);
+        engine->processBlock (jobInput, jobOutput);
+
+        state.store (JobState::done, std::memory_order_release);
+    }
+
+private:
+    enum class JobState { idle, pending, running, done };
+
+    void waitForJob() noexcept
+    {
+        // If the background thread hasn't got round to the job yet, it's quickest to do it here
+        runPendingJob();
+
+        while (state.load (std::memory_order_acquire) == JobState::running)
+            Thread::yield();
+    }
+
+    const size_t blockSize;
+    std::unique_ptr<ConvolutionEngine> engine;
+    std::array<AudioBuffer<float>, 2> inputs, outputs;
+    size_t position = 0;
+    int current = 0;
+    std::atomic<JobState> state { JobState::idle };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConvolutionTailStage)
+};
+
+// Convolves everything after the head of an IR, using partitions that grow in size further
+// into the IR. Only the cheap work of collecting input and mixing in output happens on the
+// audio thread; the FFTs are done on a background thread, which has a whole partition's
+// worth of time to finish each one. Nothing guarantees that it does, though: if it falls
+// behind, the audio thread runs the job itself or waits for it, so it runs with real-time
+// priority to make that unlikely.
+class BackgroundConvolutionTail final : private Thread
+{
+public:
+    BackgroundConvolutionTail (const AudioBuffer<float>& ir,
+                               int numChannels,
+                               int headSize,
+                               int latency,
+                               int maxBlockSize,
+                               double sampleRate)
+        : Thread (SystemStats::getJUCEVersion() + ": Convolution tail processor")
+    {
+        // The first stage uses the largest partition that can still produce output in time
+        auto partitionSize = 1;
+
+        while (partitionSize * 4 <= headSize + latency)
+            partitionSize *= 2;
+
+        for (auto start = headSize; start < ir.getNumSamples();)
+        {
+            const auto nextPartitionSize = partitionSize * partitionGrowth;
+            const auto end = nextPartitionSize > maxPartitionSize ? ir.getNumSamples()
+                                                                  : jmin (ir.getNumSamples(), 2 * nextPartitionSize - latency);
+
+            stages.push_back (std::make_unique<ConvolutionTailStage> (ir,
+                                                                      numChannels,
+                                                                      start,
+                                                                      end - start,
+                                                                      start + latency - 2 * partitionSize,
+                                                                      partitionSize));
+            start = end;
+            partitionSize = nextPartitionSize;
+        }
+
+        const auto options = RealtimeOptions{}.withApproximateAudioProcessingTime (maxBlockSize, sampleRate)
+                                              .withPeriodMs (1000.0 * maxBlockSize / sampleRate);
+
+        if (! startRealtimeThread (options))
+            startThread (Priority::highest);
+    }
+
+    ~BackgroundConvolutionTail() override
+    {
+        signalThreadShouldExit();
+        notify();
+        stopThread (-1);
+    }
+
+    void reset()
+    {
+        for (auto& stage : stages)
+            stage->reset();
+    }
+
+    // Adds the output of the tail to the output block
+    void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
+    {
+        auto startedJob = false;
+
+        for (auto& stage : stages)
+            startedJob = stage->processSamples (input, output) || startedJob;
+
+        if (startedJob)
+            notify();
+    }
+
+private:
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            // The stages with the smallest partitions have the earliest deadlines
+            for (auto& stage : stages)
+                stage->runPendingJob();
+
+            wait (-1);
+        }
+    }
+
+    static constexpr int partitionGrowth = 4;
+    static constexpr int maxPartitionSize = 16384;
+
+    std::vector<std::unique_ptr<ConvolutionTailStage>> stages;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BackgroundConvolutionTail)
+};
+
 //==============================================================================
 class MultichannelEngine
 {
@@ -453,85 +722,93 @@ public:
     MultichannelEngine (const AudioBuffer<float>& buf,
                         int maxBlockSize,
                         int maxBufferSize,
+                        double sampleRate,
                         Convolution::NonUniform headSizeIn,
                         bool isZeroDelayIn)
-        : tailBuffer (1, maxBlockSize),
+        : tailBuffer (numChannels, maxBlockSize),
           latency (isZeroDelayIn ? 0 : maxBufferSize),
           irSize (buf.getNumSamples()),
           blockSize (maxBlockSize),
           isZeroDelay (isZeroDelayIn)
     {
-        constexpr auto numChannels = 2;
-
-        const auto makeEngine = [&] (int channel, int offset, int length, uint32 thisBlockSize)
+        const auto makeEngine = [&] (int offset, int length, uint32 thisBlockSize)
         {
-            return std::make_unique<ConvolutionEngine> (buf.getReadPointer (jmin (buf.getNumChannels() - 1, channel), offset),
+            const float* channels[numChannels];
+
+            for (int i = 0; i < numChannels; ++i)
+                channels[i] = buf.getReadPointer (jmin (buf.getNumChannels() - 1, i), offset);
+
+            return std::make_unique<ConvolutionEngine> (channels,
+                                                        (size_t) numChannels,
                                                         length,
                                                         static_cast<size_t> (thisBlockSize));
         };
 
         if (headSizeIn.headSizeInSamples == 0)
         {
-            for (int i = 0; i < numChannels; ++i)
-                head.emplace_back (makeEngine (i, 0, buf.getNumSamples(), static_cast<uint32> (maxBufferSize)));
+            head = makeEngine (0, buf.getNumSamples(), static_cast<uint32> (maxBufferSize));
         }
         else
         {
             const auto size = jmin (buf.getNumSamples(), headSizeIn.headSizeInSamples);
 
-            for (int i = 0; i < numChannels; ++i)
-                head.emplace_back (makeEngine (i, 0, size, static_cast<uint32> (maxBufferSize)));
+            head = makeEngine (0, size, static_cast<uint32> (maxBufferSize));
 
             const auto tailBufferSize = static_cast<uint32> (headSizeIn.headSizeInSamples + (isZeroDelay ? 0 : maxBufferSize));
 
             if (size != buf.getNumSamples())
-                for (int i = 0; i < numChannels; ++i)
-                    tail.emplace_back (makeEngine (i, size, buf.getNumSamples() - size, tailBufferSize));
+            {
+                if (headSizeIn.processTailInBackground)
+                    backgroundTail = std::make_unique<BackgroundConvolutionTail> (buf, numChannels, size, latency, maxBlockSize, sampleRate);
+                else
+                    tail = makeEngine (size, buf.getNumSamples() - size, tailBufferSize);
+            }
         }
     }
 
     void reset()
     {
-        for (const auto& e : head)
-            e->reset();
+        head->reset();
 
-        for (const auto& e : tail)
-            e->reset();
+        if (tail != nullptr)
+            tail->reset();
+
+        if (backgroundTail != nullptr)
+            backgroundTail->reset();
     }
 
     void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
     {
-        const auto numChannels = jmin (head.size(), input.getNumChannels(), output.getNumChannels());
-        const auto numSamples  = jmin (input.getNumSamples(), output.getNumSamples());
+        const auto numChannelsToProcess = jmin (head->getNumChannels(), input.getNumChannels(), output.getNumChannels());
+        const auto numSamples = jmin (input.getNumSamples(), output.getNumSamples());
 
-        const AudioBlock<float> fullTailBlock (tailBuffer);
-        const auto tailBlock = fullTailBlock.getSubBlock (0, (size_t) numSamples);
+        const auto in  = input .getSubsetChannelBlock (0, numChannelsToProcess).getSubBlock (0, numSamples);
+        auto       out = output.getSubsetChannelBlock (0, numChannelsToProcess).getSubBlock (0, numSamples);
 
-        const auto isUniform = tail.empty();
+        auto tailBlock = AudioBlock<float> (tailBuffer).getSubsetChannelBlock (0, numChannelsToProcess)
+                                                       .getSubBlock (0, numSamples);
 
-        for (size_t channel = 0; channel < numChannels; ++channel)
+        if (tail != nullptr)
         {
-            if (! isUniform)
-                tail[channel]->processSamplesWithAddedLatency (input.getChannelPointer (channel),
-                                                               tailBlock.getChannelPointer (0),
-                                                               numSamples);
-
-            if (isZeroDelay)
-                head[channel]->processSamples (input.getChannelPointer (channel),
-                                               output.getChannelPointer (channel),
-                                               numSamples);
-            else
-                head[channel]->processSamplesWithAddedLatency (input.getChannelPointer (channel),
-                                                               output.getChannelPointer (channel),
-                                                               numSamples);
-
-            if (! isUniform)
-                output.getSingleChannelBlock (channel) += tailBlock;
+            tail->processSamplesWithAddedLatency (in, tailBlock);
         }
+        else if (backgroundTail != nullptr)
+        {
+            tailBlock.clear();
+            backgroundTail->processSamples (in, tailBlock);
+        }
+
+        if (isZeroDelay)
+            head->processSamples (in, out);
+        else
+            head->processSamplesWithAddedLatency (in, out);
+
+        if (tail != nullptr || backgroundTail != nullptr)
+            out += tailBlock;
 
         const auto numOutputChannels = output.getNumChannels();
 
-        for (auto i = numChannels; i < numOutputChannels; ++i)
+        for (auto i = numChannelsToProcess; i < numOutputChannels; ++i)
             output.getSingleChannelBlock (i).copyFrom (output.getSingleChannelBlock (0));
     }
 
@@ -540,7 +817,10 @@ public:
     int getBlockSize() const noexcept  { return blockSize; }
 
 private:
-    std::vector<std::unique_ptr<ConvolutionEngine>> head, tail;
+    static constexpr int numChannels = 2;
+
+    std::unique_ptr<ConvolutionEngine> head, tail;
+    std::unique_ptr<BackgroundConvolutionTail> backgroundTail;
     AudioBuffer<float> tailBuffer;
 
     const int latency;
@@ -740,7 +1020,8 @@ public:
     ConvolutionEngineFactory (Convolution::Latency requiredLatency,
                               Convolution::NonUniform requiredHeadSize)
         : latency  { (requiredLatency.latencyInSamples   <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredLatency.latencyInSamples)) },
-          headSize { (requiredHeadSize.headSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.headSizeInSamples)) },
+          headSize { (requiredHeadSize.headSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.headSizeInSamples)),
+                     requiredHeadSize.processTailInBackground },
           shouldBeZeroLatency (requiredLatency.latencyInSamples == 0)
     {}
 
@@ -798,6 +1079,7 @@ private:
         return std::make_unique<MultichannelEngine> (resampled,
                                                      processSpec.maximumBlockSize,
                                                      maxBufferSize,
+                                                     processSpec.sampleRate,
                                                      headSize,
                                                      shouldBeZeroLatency);
     }
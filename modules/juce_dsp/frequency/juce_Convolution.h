@@ -138,7 +138,29 @@ public:
     explicit Convolution (const Latency& requiredLatency);
 
     /** Contains configuration information for a non-uniform convolution. */
-    struct NonUniform { int headSizeInSamples; };
+    struct NonUniform
+    {
+        int headSizeInSamples;
+
+        /** If this is true, the part of the IR after the head is split into several
+            stages, with partitions that grow larger further into the IR, and these
+            are processed on a background thread. Only the head is processed on the
+            audio thread.
+
+            The output is identical either way, but the background thread isn't guaranteed
+            to keep up. It runs with real-time priority, and usually finishes each block of
+            the tail long before the result is needed. If it hasn't started on a block by
+            then, the audio thread will process that block itself, and if it's still working
+            on one, the audio thread will wait for it to finish. Either way, the audio thread
+            may occasionally spend as long on a block as it would without this option, for
+            a tail partition of up to 16384 samples.
+
+            For the background thread to be of any use, the head size should be at
+            least twice the maximum block size. This mode is recommended for long IRs,
+            such as reverberation IRs lasting several seconds.
+        */
+        bool processTailInBackground = false;
+    };
 
     /** Initialises an object for performing convolution in the frequency domain
         using a non-uniform partitioned algorithm.
@@ -148,7 +170,8 @@ public:
         (recommended for reverberation IRs).
 
         @param requiredHeadSize       the head IR size for two stage non-uniform
-                                      partitioned convolution
+                                      partitioned convolution, and whether the
+                                      tail should be processed on a background thread
      */
     explicit Convolution (const NonUniform& requiredHeadSize);
 
@@ -555,6 +555,23 @@ public:
             }
         }
 
+        beginTest ("Non-uniform convolutions with a background tail work");
+        {
+            const auto ramp = makeStereoRamp (static_cast<int> (spec.maximumBlockSize) * 40);
+
+            for (auto headSize : { spec.maximumBlockSize / 2, spec.maximumBlockSize * 2, spec.maximumBlockSize * 5 })
+            {
+                testConvolution (spec,
+                                 Convolution::NonUniform { static_cast<int> (headSize), true },
+                                 ramp,
+                                 spec.sampleRate,
+                                 Convolution::Stereo::yes,
+                                 Convolution::Trim::yes,
+                                 Convolution::Normalise::no,
+                                 ramp);
+            }
+        }
+
         beginTest ("Convolutions with latency work");
         {
             const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 8);
@@ -41,6 +41,18 @@ struct FFT::Instance
     virtual void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept = 0;
     virtual void performRealOnlyForwardTransform (float*, bool) const noexcept = 0;
     virtual void performRealOnlyInverseTransform (float*) const noexcept = 0;
+
+    virtual void performRealOnlyForwardTransforms (float* const* channels, size_t numChannels, bool onlyNonNegative) const noexcept
+    {
+        for (size_t i = 0; i < numChannels; ++i)
+            performRealOnlyForwardTransform (channels[i], onlyNonNegative);
+    }
+
+    virtual void performRealOnlyInverseTransforms (float* const* channels, size_t numChannels) const noexcept
+    {
+        for (size_t i = 0; i < numChannels; ++i)
+            performRealOnlyInverseTransform (channels[i]);
+    }
 };
 
 struct FFT::Engine
@@ -438,6 +450,599 @@ struct FFTFallback final : public FFT::Instance
 
 FFT::EngineImpl<FFTFallback> fftFallback;
 
+//==============================================================================
+//==============================================================================
+template <typename Lane> struct FFTLaneOps;
+
+template <>
+struct FFTLaneOps<float>
+{
+    static constexpr int width = 1;
+
+    static forcedinline float load (const float* src) noexcept         { return *src; }
+    static forcedinline void store (float* dest, float v) noexcept     { *dest = v; }
+};
+
+#if JUCE_USE_SIMD
+template <>
+struct FFTLaneOps<SIMDRegister<float>>
+{
+    using Lane = SIMDRegister<float>;
+    static constexpr int width = (int) Lane::SIMDNumElements;
+
+    static forcedinline Lane load (const float* src) noexcept          { return Lane::fromRawArray (src); }
+    static forcedinline void store (float* dest, Lane v) noexcept      { v.copyToRawArray (dest); }
+};
+#endif
+
+/*  A mixed-radix Stockham autosort FFT, which handles any size that's a product of 2, 3 and 5.
+
+    While it's being transformed, the data is held as separate arrays of real and imaginary parts.
+    Each pass reads from one pair of arrays and writes to the other, so the output comes out in
+    natural order without needing a bit-reversal step. Once the stride between the inputs of a
+    butterfly is a multiple of the SIMD register width, whole registers of butterflies are computed
+    at once, which is the case for all but the first pass or two of a typical power-of-two transform.
+
+    The real-only transforms of even sizes are done by packing the input into a complex transform of
+    half the size, and then untangling the result.
+*/
+struct FFTMixedRadix final : public FFT::Instance
+{
+    // a higher priority than the fallback, but lower than any of the platform's libraries
+    static constexpr int priority = 0;
+
+   #if JUCE_USE_SIMD
+    using VectorLane = SIMDRegister<float>;
+   #else
+    using VectorLane = float;
+   #endif
+
+    static constexpr int vectorWidth = FFTLaneOps<VectorLane>::width;
+
+    static FFTMixedRadix* create (int order)
+    {
+        return createWithSize (1 << order);
+    }
+
+    static FFTMixedRadix* createWithSize (int numPoints)
+    {
+        if (! isSupportedSize (numPoints))
+            return nullptr;
+
+        return new FFTMixedRadix (numPoints);
+    }
+
+    static bool isSupportedSize (int numPoints) noexcept
+    {
+        if (numPoints <= 0)
+            return false;
+
+        for (auto radix : { 2, 3, 5 })
+            while (numPoints % radix == 0)
+                numPoints /= radix;
+
+        return numPoints == 1;
+    }
+
+    explicit FFTMixedRadix (int numPoints)
+        : size (numPoints),
+          complexPlan (numPoints),
+          realPlan ((numPoints & 1) == 0 ? numPoints / 2 : 1)
+    {
+        // each buffer must also be able to hold a half-size transform for every lane of a register
+        const auto paddedSize = (size_t) ((size + vectorWidth - 1) / vectorWidth * vectorWidth);
+        const auto bufferSize = jmax (paddedSize, (size_t) (size / 2 * vectorWidth));
+        scratchSpace.calloc (bufferSize * 4 + (size_t) vectorWidth);
+
+       #if JUCE_USE_SIMD
+        auto* scratch = VectorLane::getNextSIMDAlignedPtr (scratchSpace.getData());
+       #else
+        auto* scratch = scratchSpace.getData();
+       #endif
+
+        for (auto& buffer : buffers)
+        {
+            buffer = scratch;
+            scratch += bufferSize;
+        }
+
+        if ((size & 1) == 0)
+        {
+            const auto half = size / 2;
+            realTwiddlesRe.resize ((size_t) half + 1);
+            realTwiddlesIm.resize ((size_t) half + 1);
+
+            for (int k = 0; k <= half; ++k)
+            {
+                const auto phase = -MathConstants<double>::twoPi * k / size;
+                realTwiddlesRe[(size_t) k] = (float) std::cos (phase);
+                realTwiddlesIm[(size_t) k] = (float) std::sin (phase);
+            }
+        }
+    }
+
+    //==============================================================================
+    void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
+    {
+        if (size == 1)
+        {
+            *output = *input;
+            return;
+        }
+
+        const SpinLock::ScopedLockType sl (processLock);
+
+        auto* re = buffers[0];
+        auto* im = buffers[1];
+
+        // An inverse transform is the forward transform of the input with its real and
+        // imaginary parts swapped over, followed by swapping them back again.
+        if (inverse)
+            std::swap (re, im);
+
+        for (int i = 0; i < size; ++i)
+        {
+            re[i] = input[i].real();
+            im[i] = input[i].imag();
+        }
+
+        auto result = complexPlan.perform (buffers);
+        const auto scale = inverse ? 1.0f / (float) size : 1.0f;
+
+        if (inverse)
+            std::swap (result.re, result.im);
+
+        for (int i = 0; i < size; ++i)
+            output[i] = { result.re[i] * scale, result.im[i] * scale };
+    }
+
+    void performRealOnlyForwardTransform (float* d, bool onlyCalculateNonNegativeFrequencies) const noexcept override
+    {
+        if (size == 1)
+            return;
+
+        const SpinLock::ScopedLockType sl (processLock);
+
+        if ((size & 1) != 0)
+        {
+            auto* out = reinterpret_cast<Complex<float>*> (d);
+
+            for (int i = 0; i < size; ++i)
+            {
+                buffers[0][i] = d[i];
+                buffers[1][i] = 0.0f;
+            }
+
+            const auto result = complexPlan.perform (buffers);
+
+            for (int i = 0; i < size; ++i)
+                out[i] = { result.re[i], result.im[i] };
+
+            return;
+        }
+
+        packRealInput (d, { buffers[0], buffers[1] }, 1);
+        unpackRealSpectrum (realPlan.perform (buffers), 1, d, onlyCalculateNonNegativeFrequencies);
+    }
+
+    void performRealOnlyInverseTransform (float* d) const noexcept override
+    {
+        if (size == 1)
+            return;
+
+        const SpinLock::ScopedLockType sl (processLock);
+
+        if ((size & 1) != 0)
+        {
+            const auto* in = reinterpret_cast<const Complex<float>*> (d);
+
+            // swapped real and imaginary parts, as in perform()
+            for (int k = 0; k < size; ++k)
+            {
+                const auto value = k <= size / 2 ? in[k] : std::conj (in[size - k]);
+                buffers[1][k] = value.real();
+                buffers[0][k] = value.imag();
+            }
+
+            const auto result = complexPlan.perform (buffers);
+            const auto scale = 1.0f / (float) size;
+
+            for (int i = 0; i < size; ++i)
+                d[i] = result.im[i] * scale;
+
+            return;
+        }
+
+        packRealSpectrum (d, { buffers[0], buffers[1] }, 1);
+        unpackRealOutput (realPlan.perform (buffers), 1, d);
+    }
+
+    /*  With several channels to transform, groups of them are interleaved so that each one
+        occupies a lane of a SIMD register. Every pass can then be vectorised (rather than only
+        the ones with a wide enough stride), and each twiddle factor is loaded once per group
+        of channels rather than once per channel. A group that would leave half of the lanes
+        empty is quicker to transform one channel at a time.
+    */
+    void performRealOnlyForwardTransforms (float* const* channels, size_t numChannels,
+                                           bool onlyCalculateNonNegativeFrequencies) const noexcept override
+    {
+        const auto numBatched = getNumChannelsToBatch (numChannels);
+
+        if (numBatched > 0)
+        {
+            const SpinLock::ScopedLockType sl (processLock);
+
+            for (size_t first = 0; first < numBatched; first += (size_t) vectorWidth)
+            {
+                const auto numInGroup = (int) jmin ((size_t) vectorWidth, numBatched - first);
+
+                for (int lane = 0; lane < vectorWidth; ++lane)
+                {
+                    const SplitComplex dest { buffers[0] + lane, buffers[1] + lane };
+
+                    if (lane < numInGroup)
+                        packRealInput (channels[first + (size_t) lane], dest, vectorWidth);
+                    else
+                        clearLane (dest, size / 2);
+                }
+
+                const auto z = realPlan.perform (buffers, vectorWidth);
+
+                for (int lane = 0; lane < numInGroup; ++lane)
+                    unpackRealSpectrum ({ z.re + lane, z.im + lane }, vectorWidth,
+                                        channels[first + (size_t) lane], onlyCalculateNonNegativeFrequencies);
+            }
+        }
+
+        Instance::performRealOnlyForwardTransforms (channels + numBatched, numChannels - numBatched,
+                                                    onlyCalculateNonNegativeFrequencies);
+    }
+
+    void performRealOnlyInverseTransforms (float* const* channels, size_t numChannels) const noexcept override
+    {
+        const auto numBatched = getNumChannelsToBatch (numChannels);
+
+        if (numBatched > 0)
+        {
+            const SpinLock::ScopedLockType sl (processLock);
+
+            for (size_t first = 0; first < numBatched; first += (size_t) vectorWidth)
+            {
+                const auto numInGroup = (int) jmin ((size_t) vectorWidth, numBatched - first);
+
+                for (int lane = 0; lane < vectorWidth; ++lane)
+                {
+                    const SplitComplex dest { buffers[0] + lane, buffers[1] + lane };
+
+                    if (lane < numInGroup)
+                        packRealSpectrum (channels[first + (size_t) lane], dest, vectorWidth);
+                    else
+                        clearLane (dest, size / 2);
+                }
+
+                const auto z = realPlan.perform (buffers, vectorWidth);
+
+                for (int lane = 0; lane < numInGroup; ++lane)
+                    unpackRealOutput ({ z.re + lane, z.im + lane }, vectorWidth, channels[first + (size_t) lane]);
+            }
+        }
+
+        Instance::performRealOnlyInverseTransforms (channels + numBatched, numChannels - numBatched);
+    }
+
+private:
+    //==============================================================================
+    struct SplitComplex
+    {
+        float* re;
+        float* im;
+    };
+
+    struct Pass
+    {
+        int radix, m, stride;
+        std::vector<float> twiddlesRe, twiddlesIm;
+    };
+
+    struct Plan
+    {
+        explicit Plan (int numPoints)
+        {
+            std::vector<int> radices;
+
+            for (; numPoints % 4 == 0; numPoints /= 4)   radices.push_back (4);
+            for (; numPoints % 2 == 0; numPoints /= 2)   radices.push_back (2);
+            for (; numPoints % 3 == 0; numPoints /= 3)   radices.push_back (3);
+            for (; numPoints % 5 == 0; numPoints /= 5)   radices.push_back (5);
+
+            jassert (numPoints == 1);
+
+            auto length = 1;
+
+            for (auto radix : radices)
+                length *= radix;
+
+            auto stride = 1;
+
+            for (auto radix : radices)
+            {
+                Pass pass { radix, length / radix, stride, {}, {} };
+                pass.twiddlesRe.resize ((size_t) ((radix - 1) * pass.m));
+                pass.twiddlesIm.resize (pass.twiddlesRe.size());
+
+                for (int k = 1; k < radix; ++k)
+                {
+                    for (int p = 0; p < pass.m; ++p)
+                    {
+                        const auto phase = -MathConstants<double>::twoPi * (p * k) / length;
+                        const auto index = (size_t) ((k - 1) * pass.m + p);
+                        pass.twiddlesRe[index] = (float) std::cos (phase);
+                        pass.twiddlesIm[index] = (float) std::sin (phase);
+                    }
+                }
+
+                passes.push_back (std::move (pass));
+                length /= radix;
+                stride *= radix;
+            }
+        }
+
+        /*  Transforms the data in buffers[0] and buffers[1], using buffers[2] and buffers[3] as
+            workspace, and returns whichever pair of buffers the result ends up in.
+
+            If numLanes is greater than one, the buffers hold that many interleaved transforms,
+            which are all performed at once.
+        */
+        SplitComplex perform (float* const* buffers, int numLanes = 1) const noexcept
+        {
+            jassert (numLanes == 1 || numLanes == vectorWidth);
+
+            SplitComplex src { buffers[0], buffers[1] }, dst { buffers[2], buffers[3] };
+
+            for (auto& pass : passes)
+            {
+                if (numLanes > 1 || pass.stride % vectorWidth == 0)
+                    performPass<VectorLane> (pass, src, dst, numLanes);
+                else
+                    performPass<float> (pass, src, dst, 1);
+
+                std::swap (src, dst);
+            }
+
+            return src;
+        }
+
+        std::vector<Pass> passes;
+    };
+
+    //==============================================================================
+    size_t getNumChannelsToBatch (size_t numChannels) const noexcept
+    {
+        if (vectorWidth == 1 || size == 1 || (size & 1) != 0)
+            return 0;
+
+        const auto width = (size_t) vectorWidth;
+        const auto remainder = numChannels % width;
+
+        return numChannels - (remainder * 2 > width ? 0 : remainder);
+    }
+
+    static void clearLane (SplitComplex dest, int numElements) noexcept
+    {
+        for (int i = 0; i < numElements; ++i)
+        {
+            dest.re[i * vectorWidth] = 0.0f;
+            dest.im[i * vectorWidth] = 0.0f;
+        }
+    }
+
+    // treats the even and odd samples as the real and imaginary parts of a half-size transform
+    void packRealInput (const float* d, SplitComplex dest, int elementStride) const noexcept
+    {
+        for (int i = 0; i < size / 2; ++i)
+        {
+            dest.re[i * elementStride] = d[2 * i];
+            dest.im[i * elementStride] = d[2 * i + 1];
+        }
+    }
+
+    void unpackRealSpectrum (SplitComplex z, int elementStride, float* d, bool onlyCalculateNonNegativeFrequencies) const noexcept
+    {
+        auto* out = reinterpret_cast<Complex<float>*> (d);
+        const auto half = size / 2;
+
+        for (int k = 0; k <= half; ++k)
+        {
+            const auto a = (k == half ? 0 : k) * elementStride;
+            const auto b = (k == 0 ? 0 : half - k) * elementStride;
+
+            // even = (z[k] + conj (z[half - k])) / 2, odd = (z[k] - conj (z[half - k])) / 2i
+            const auto evenRe = 0.5f * (z.re[a] + z.re[b]);
+            const auto evenIm = 0.5f * (z.im[a] - z.im[b]);
+            const auto oddRe  = 0.5f * (z.im[a] + z.im[b]);
+            const auto oddIm  = 0.5f * (z.re[b] - z.re[a]);
+
+            const auto wr = realTwiddlesRe[(size_t) k];
+            const auto wi = realTwiddlesIm[(size_t) k];
+
+            out[k] = { evenRe + oddRe * wr - oddIm * wi,
+                       evenIm + oddRe * wi + oddIm * wr };
+        }
+
+        if (! onlyCalculateNonNegativeFrequencies)
+            for (int k = half + 1; k < size; ++k)
+                out[k] = std::conj (out[size - k]);
+    }
+
+    void packRealSpectrum (const float* d, SplitComplex dest, int elementStride) const noexcept
+    {
+        const auto* in = reinterpret_cast<const Complex<float>*> (d);
+        const auto half = size / 2;
+
+        for (int k = 0; k < half; ++k)
+        {
+            const auto xk = in[k];
+            const auto xc = in[half - k];
+            const auto wr = realTwiddlesRe[(size_t) k];
+            const auto wi = realTwiddlesIm[(size_t) k];
+
+            // even = x[k] + conj (x[half - k]), odd = (x[k] - conj (x[half - k])) * conj (w)
+            const auto evenRe = xk.real() + xc.real();
+            const auto evenIm = xk.imag() - xc.imag();
+            const auto diffRe = xk.real() - xc.real();
+            const auto diffIm = xk.imag() + xc.imag();
+            const auto oddRe  = diffRe * wr + diffIm * wi;
+            const auto oddIm  = diffIm * wr - diffRe * wi;
+
+            // even + i * odd, with the real and imaginary parts swapped for the inverse
+            dest.im[k * elementStride] = evenRe - oddIm;
+            dest.re[k * elementStride] = evenIm + oddRe;
+        }
+    }
+
+    void unpackRealOutput (SplitComplex z, int elementStride, float* d) const noexcept
+    {
+        const auto half = size / 2;
+        const auto scale = 0.5f / (float) half;
+
+        for (int i = 0; i < half; ++i)
+        {
+            d[2 * i]     = z.im[i * elementStride] * scale;
+            d[2 * i + 1] = z.re[i * elementStride] * scale;
+        }
+    }
+
+    //==============================================================================
+    template <typename Lane>
+    static void performPass (const Pass& pass, SplitComplex src, SplitComplex dst, int numLanes) noexcept
+    {
+        switch (pass.radix)
+        {
+            case 2:  performRadixPass<Lane, 2> (pass, src, dst, numLanes); break;
+            case 3:  performRadixPass<Lane, 3> (pass, src, dst, numLanes); break;
+            case 4:  performRadixPass<Lane, 4> (pass, src, dst, numLanes); break;
+            case 5:  performRadixPass<Lane, 5> (pass, src, dst, numLanes); break;
+            default: jassertfalse; break;
+        }
+    }
+
+    template <typename Lane, int radix>
+    static void performRadixPass (const Pass& pass, SplitComplex src, SplitComplex dst, int numLanes) noexcept
+    {
+        using Ops = FFTLaneOps<Lane>;
+
+        // with interleaved transforms, each element is numLanes floats wide
+        const auto m = pass.m;
+        const auto stride = pass.stride * numLanes;
+
+        for (int p = 0; p < m; ++p)
+        {
+            Lane wr[radix], wi[radix];
+
+            for (int k = 1; k < radix; ++k)
+            {
+                wr[k] = pass.twiddlesRe[(size_t) ((k - 1) * m + p)];
+                wi[k] = pass.twiddlesIm[(size_t) ((k - 1) * m + p)];
+            }
+
+            for (int q = 0; q < stride; q += Ops::width)
+            {
+                Lane ar[radix], ai[radix], yr[radix], yi[radix];
+
+                for (int j = 0; j < radix; ++j)
+                {
+                    const auto index = q + stride * (p + j * m);
+                    ar[j] = Ops::load (src.re + index);
+                    ai[j] = Ops::load (src.im + index);
+                }
+
+                butterfly<radix> (ar, ai, yr, yi);
+
+                const auto outIndex = q + stride * radix * p;
+                Ops::store (dst.re + outIndex, yr[0]);
+                Ops::store (dst.im + outIndex, yi[0]);
+
+                for (int k = 1; k < radix; ++k)
+                {
+                    Ops::store (dst.re + outIndex + stride * k, yr[k] * wr[k] - yi[k] * wi[k]);
+                    Ops::store (dst.im + outIndex + stride * k, yr[k] * wi[k] + yi[k] * wr[k]);
+                }
+            }
+        }
+    }
+
+    // A forward DFT of the given radix
+    template <int radix, typename Lane>
+    static forcedinline void butterfly (const Lane* ar, const Lane* ai, Lane* yr, Lane* yi) noexcept
+    {
+        if constexpr (radix == 2)
+        {
+            yr[0] = ar[0] + ar[1];   yi[0] = ai[0] + ai[1];
+            yr[1] = ar[0] - ar[1];   yi[1] = ai[0] - ai[1];
+        }
+        else if constexpr (radix == 3)
+        {
+            const auto sin60 = (float) (std::sqrt (3.0) * 0.5);
+
+            const auto sr = ar[1] + ar[2], si = ai[1] + ai[2];
+            const auto dr = ar[1] - ar[2], di = ai[1] - ai[2];
+            const auto tr = ar[0] - sr * 0.5f, ti = ai[0] - si * 0.5f;
+
+            yr[0] = ar[0] + sr;         yi[0] = ai[0] + si;
+            yr[1] = tr + di * sin60;    yi[1] = ti - dr * sin60;
+            yr[2] = tr - di * sin60;    yi[2] = ti + dr * sin60;
+        }
+        else if constexpr (radix == 4)
+        {
+            const auto s0r = ar[0] + ar[2], s0i = ai[0] + ai[2];
+            const auto d0r = ar[0] - ar[2], d0i = ai[0] - ai[2];
+            const auto s1r = ar[1] + ar[3], s1i = ai[1] + ai[3];
+            const auto d1r = ar[1] - ar[3], d1i = ai[1] - ai[3];
+
+            yr[0] = s0r + s1r;   yi[0] = s0i + s1i;
+            yr[1] = d0r + d1i;   yi[1] = d0i - d1r;
+            yr[2] = s0r - s1r;   yi[2] = s0i - s1i;
+            yr[3] = d0r - d1i;   yi[3] = d0i + d1r;
+        }
+        else if constexpr (radix == 5)
+        {
+            const auto c1 = (float) std::cos (MathConstants<double>::twoPi / 5.0);
+            const auto c2 = (float) std::cos (MathConstants<double>::twoPi * 2.0 / 5.0);
+            const auto s1 = (float) std::sin (MathConstants<double>::twoPi / 5.0);
+            const auto s2 = (float) std::sin (MathConstants<double>::twoPi * 2.0 / 5.0);
+
+            const auto b1r = ar[1] + ar[4], b1i = ai[1] + ai[4];
+            const auto b2r = ar[2] + ar[3], b2i = ai[2] + ai[3];
+            const auto d1r = ar[1] - ar[4], d1i = ai[1] - ai[4];
+            const auto d2r = ar[2] - ar[3], d2i = ai[2] - ai[3];
+
+            const auto t1r = ar[0] + b1r * c1 + b2r * c2, t1i = ai[0] + b1i * c1 + b2i * c2;
+            const auto t2r = ar[0] + b1r * c2 + b2r * c1, t2i = ai[0] + b1i * c2 + b2i * c1;
+            const auto u1r = d1r * s1 + d2r * s2,         u1i = d1i * s1 + d2i * s2;
+            const auto u2r = d1r * s2 - d2r * s1,         u2i = d1i * s2 - d2i * s1;
+
+            yr[0] = ar[0] + b1r + b2r;   yi[0] = ai[0] + b1i + b2i;
+            yr[1] = t1r + u1i;           yi[1] = t1i - u1r;
+            yr[2] = t2r + u2i;           yi[2] = t2i - u2r;
+            yr[3] = t2r - u2i;           yi[3] = t2i + u2r;
+            yr[4] = t1r - u1i;           yi[4] = t1i + u1r;
+        }
+    }
+
+    //==============================================================================
+    const int size;
+    const Plan complexPlan, realPlan;
+    std::vector<float> realTwiddlesRe, realTwiddlesIm;
+
+    SpinLock processLock;
+    HeapBlock<float> scratchSpace;
+    float* buffers[4];
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FFTMixedRadix)
+};
+
+FFT::EngineImpl<FFTMixedRadix> fftMixedRadix;
+
 //==============================================================================
 //==============================================================================
 #if (JUCE_MAC || JUCE_IOS) && JUCE_USE_VDSP_FRAMEWORK
@@ -964,6 +1569,28 @@ FFT::FFT (int order)
 {
 }
 
+FFT::FFT (std::unique_ptr<Instance> instance, int numPoints)
+    : engine (std::move (instance)),
+      size (numPoints)
+{
+}
+
+FFT FFT::withSize (int numPoints)
+{
+    // The number of points must be a product of the factors 2, 3 and 5!
+    jassert (isSupportedSize (numPoints));
+
+    if (isPowerOfTwo (numPoints))
+        return FFT (findHighestSetBit ((uint32) numPoints));
+
+    return FFT (rawToUniquePtr<Instance> (FFTMixedRadix::createWithSize (numPoints)), numPoints);
+}
+
+bool FFT::isSupportedSize (int numPoints) noexcept
+{
+    return FFTMixedRadix::isSupportedSize (numPoints);
+}
+
 FFT::FFT (FFT&&) noexcept = default;
 
 FFT& FFT::operator= (FFT&&) noexcept = default;
@@ -988,6 +1615,44 @@ void FFT::performRealOnlyInverseTransform (float* inputOutputData) const noexcep
         engine->performRealOnlyInverseTransform (inputOutputData);
 }
 
+template <typename Fn>
+static void forEachChannelGroup (const AudioBlock<float>& block, [[maybe_unused]] int fftSize, Fn&& fn)
+{
+    // Each channel needs room for a full set of complex coefficients
+    jassert (block.getNumSamples() >= (size_t) fftSize * 2);
+
+    constexpr size_t maxChannelsPerGroup = 32;
+    float* channels[maxChannelsPerGroup];
+
+    for (size_t first = 0; first < block.getNumChannels(); first += maxChannelsPerGroup)
+    {
+        const auto numInGroup = jmin (maxChannelsPerGroup, block.getNumChannels() - first);
+
+        for (size_t i = 0; i < numInGroup; ++i)
+            channels[i] = block.getChannelPointer (first + i);
+
+        fn (channels, numInGroup);
+    }
+}
+
+void FFT::performRealOnlyForwardTransform (const AudioBlock<float>& block, bool ignoreNegativeFreqs) const noexcept
+{
+    if (engine != nullptr)
+        forEachChannelGroup (block, size, [&] (float* const* channels, size_t numChannels)
+        {
+            engine->performRealOnlyForwardTransforms (channels, numChannels, ignoreNegativeFreqs);
+        });
+}
+
+void FFT::performRealOnlyInverseTransform (const AudioBlock<float>& block) const noexcept
+{
+    if (engine != nullptr)
+        forEachChannelGroup (block, size, [&] (float* const* channels, size_t numChannels)
+        {
+            engine->performRealOnlyInverseTransforms (channels, numChannels);
+        });
+}
+
 void FFT::performFrequencyOnlyForwardTransform (float* inputOutputData, bool ignoreNegativeFreqs) const noexcept
 {
     if (size == 1)
@@ -38,9 +38,9 @@ namespace juce::dsp
 /**
     Performs a fast fourier transform.
 
-    This is only a simple low-footprint implementation and isn't tuned for speed - it may
-    be useful for simple applications where one of the more complex FFT libraries would be
-    overkill. (But in the future it may end up becoming optimised of course...)
+    If a platform FFT library (e.g. vDSP, IPP, MKL or FFTW) is available, it will be used.
+    Otherwise, JUCE's built-in engine is a SIMD-optimised mixed-radix implementation, which
+    can also handle sizes that aren't powers of two - see withSize().
 
     The FFT class itself contains lookup tables, so there's some overhead in creating
     one, you should create and cache an FFT object for each size/direction of transform
@@ -57,6 +57,21 @@ public:
     */
     FFT (int order);
 
+    /** Creates an object for performing forward and inverse FFTs on a number of points
+        which needn't be a power of two.
+
+        The number of points must be a product of the factors 2, 3 and 5, e.g. 480,
+        960 or 1920. Power-of-two sizes will use the best engine available on the
+        platform, in the same way as the FFT (int order) constructor does, and other
+        sizes will use JUCE's built-in mixed-radix engine.
+
+        @see isSupportedSize
+    */
+    static FFT withSize (int numPoints);
+
+    /** Returns true if withSize() is able to create an FFT with this number of points. */
+    static bool isSupportedSize (int numPoints) noexcept;
+
     /** Move constructor. */
     FFT (FFT&&) noexcept;
 
@@ -79,9 +94,8 @@ public:
         it may not be necessary to calculate them for your particular application.
         You can use onlyCalculateNonNegativeFrequencies to let the FFT
         engine know that you do not plan on using them. Note that this is only a
-        hint: some FFT engines (currently only the Fallback engine), will still
-        calculate the negative frequencies even if onlyCalculateNonNegativeFrequencies
-        is true.
+        hint: some FFT engines will still calculate the negative frequencies even if
+        onlyCalculateNonNegativeFrequencies is true.
 
         The size of the array passed in must be 2 * getSize(), and the first half
         should contain your raw input sample data. On return, if
@@ -103,6 +117,27 @@ public:
     */
     void performRealOnlyInverseTransform (float* inputOutputData) const noexcept;
 
+    /** Performs an in-place forward transform on each channel of a block of real data.
+
+        The result is the same as calling performRealOnlyForwardTransform() on each channel
+        in turn, but some engines are able to transform several channels at once, which can
+        be considerably faster than transforming them one by one.
+
+        Each channel of the block must contain 2 * getSize() samples, laid out in the same
+        way as the array passed to performRealOnlyForwardTransform().
+    */
+    void performRealOnlyForwardTransform (const AudioBlock<float>& inputOutputData,
+                                          bool onlyCalculateNonNegativeFrequencies = false) const noexcept;
+
+    /** Performs an in-place inverse transform on each channel of a block of data created
+        by performRealOnlyForwardTransform().
+
+        The result is the same as calling performRealOnlyInverseTransform() on each channel
+        in turn, but some engines are able to transform several channels at once. Each channel
+        of the block must contain 2 * getSize() samples.
+    */
+    void performRealOnlyInverseTransform (const AudioBlock<float>& inputOutputData) const noexcept;
+
     /** Takes an array and simply transforms it to the magnitude frequency response
         spectrum. This may be handy for things like frequency displays or analysis.
         The size of the array passed in must be 2 * getSize().
@@ -128,6 +163,8 @@ private:
     //==============================================================================
     struct Engine;
 
+    FFT (std::unique_ptr<Instance>, int numPoints);
+
     std::unique_ptr<Instance> engine;
     int size;
 
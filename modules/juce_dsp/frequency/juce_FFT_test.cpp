@@ -203,6 +203,92 @@ struct FFTUnitTest final : public UnitTest
         }
     };
 
+    struct MixedRadixTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (size_t n : { 3, 5, 6, 9, 10, 12, 15, 20, 24, 30, 45, 48, 60, 96, 100, 120 })
+            {
+                u.expect (FFT::isSupportedSize ((int) n));
+
+                auto fft = FFT::withSize ((int) n);
+                u.expect (fft.getSize() == (int) n);
+
+                HeapBlock<Complex<float>> input (n), output (n), reference (n);
+
+                fillRandom (random, input.getData(), n);
+                performReferenceFourier (input.getData(), reference.getData(), n, false);
+
+                fft.perform (input.getData(), output.getData(), false);
+                u.expect (checkArrayIsSimilar (output.getData(), reference.getData(), n));
+
+                fft.perform (reference.getData(), output.getData(), true);
+                u.expect (checkArrayIsSimilar (output.getData(), input.getData(), n));
+
+                HeapBlock<float> realInput (n);
+                fillRandom (random, realInput.getData(), n);
+                performReferenceFourier (realInput.getData(), reference.getData(), n, false);
+
+                zeromem (output.getData(), n * sizeof (Complex<float>));
+                memcpy (reinterpret_cast<float*> (output.getData()), realInput.getData(), n * sizeof (float));
+
+                fft.performRealOnlyForwardTransform ((float*) output.getData());
+                u.expect (checkArrayIsSimilar (reference.getData(), output.getData(), n));
+
+                fft.performRealOnlyInverseTransform ((float*) output.getData());
+                u.expect (checkArrayIsSimilar ((float*) output.getData(), realInput.getData(), n));
+            }
+
+            for (auto n : { 0, 7, 14, 22, 49 })
+                u.expect (! FFT::isSupportedSize (n));
+        }
+    };
+
+    struct MultichannelTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (91273);
+
+            for (auto n : { 1, 2, 4, 16, 256, 1024, 6, 12, 15, 30, 120 })
+            {
+                auto fft = FFT::withSize (n);
+                const auto numSamples = (size_t) n * 2;
+
+                for (int numChannels : { 1, 2, 3, 5, 8, 9 })
+                {
+                    AudioBuffer<float> batched (numChannels, (int) numSamples), separate (numChannels, (int) numSamples);
+
+                    for (int ch = 0; ch < numChannels; ++ch)
+                    {
+                        batched.clear (ch, 0, (int) numSamples);
+                        fillRandom (random, batched.getWritePointer (ch), (size_t) n);
+                    }
+
+                    separate.makeCopyOf (batched);
+
+                    fft.performRealOnlyForwardTransform (AudioBlock<float> (batched));
+
+                    for (int ch = 0; ch < numChannels; ++ch)
+                    {
+                        fft.performRealOnlyForwardTransform (separate.getWritePointer (ch));
+                        u.expect (checkArrayIsSimilar (batched.getWritePointer (ch), separate.getWritePointer (ch), numSamples));
+                    }
+
+                    fft.performRealOnlyInverseTransform (AudioBlock<float> (batched));
+
+                    for (int ch = 0; ch < numChannels; ++ch)
+                    {
+                        fft.performRealOnlyInverseTransform (separate.getWritePointer (ch));
+                        u.expect (checkArrayIsSimilar (batched.getWritePointer (ch), separate.getWritePointer (ch), (size_t) n));
+                    }
+                }
+            }
+        }
+    };
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -216,6 +302,8 @@ struct FFTUnitTest final : public UnitTest
         runTestForAllTypes<RealTest> ("Real input numbers Test");
         runTestForAllTypes<FrequencyOnlyTest> ("Frequency only Test");
         runTestForAllTypes<ComplexTest> ("Complex input numbers Test");
+        runTestForAllTypes<MixedRadixTest> ("Mixed radix sizes Test");
+        runTestForAllTypes<MultichannelTest> ("Multichannel Test");
     }
 };
 
@@ -265,12 +265,14 @@ namespace util
 #include "processors/juce_ProcessorDuplicator.h"
 #include "processors/juce_IIRFilter.h"
 #include "processors/juce_IIRFilter_Impl.h"
+#include "processors/juce_IIRMultichannelFilter.h"
 #include "processors/juce_FIRFilter.h"
 #include "processors/juce_StateVariableFilter.h"
 #include "processors/juce_FirstOrderTPTFilter.h"
 #include "processors/juce_Panner.h"
 #include "processors/juce_DelayLine.h"
 #include "processors/juce_Oversampling.h"
+#include "processors/juce_SampleRateConverter.h"
 #include "processors/juce_BallisticsFilter.h"
 #include "processors/juce_LinkwitzRileyFilter.h"
 #include "processors/juce_DryWetMixer.h"
@@ -0,0 +1,289 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp::IIR
+{
+
+template <typename SampleType>
+MultichannelFilter<SampleType>::MultichannelFilter (CoefficientsPtr coefficientsToUse)
+{
+    sections.add (std::move (coefficientsToUse));
+}
+
+template <typename SampleType>
+MultichannelFilter<SampleType>::MultichannelFilter (const ReferenceCountedArray<Coefficients<SampleType>>& sectionsToUse)
+    : sections (sectionsToUse)
+{
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultichannelFilter<SampleType>::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.numChannels > 0);
+
+    numChannels = spec.numChannels;
+
+    if (scratch == nullptr)
+    {
+        scratchMemory.malloc ((chunkSize * maxGroupsPerPass + 1) * sizeof (Lanes));
+        scratch = reinterpret_cast<Lanes*> (snapPointerToAlignment (scratchMemory.getData(), sizeof (Lanes)));
+    }
+
+    reset();
+}
+
+template <typename SampleType>
+void MultichannelFilter<SampleType>::reset()
+{
+    sectionOrders.resize ((size_t) sections.size());
+    stateSizePerGroup = 0;
+
+    for (int i = 0; i < sections.size(); ++i)
+    {
+        sectionOrders[(size_t) i] = sections.getUnchecked (i)->getFilterOrder();
+        stateSizePerGroup += sectionOrders[(size_t) i];
+    }
+
+    const auto numStates = getNumStates();
+
+    if (numStates > numStatesAllocated)
+    {
+        stateMemory.malloc ((numStates + 1) * sizeof (Lanes));
+        state = reinterpret_cast<Lanes*> (snapPointerToAlignment (stateMemory.getData(), sizeof (Lanes)));
+        numStatesAllocated = numStates;
+    }
+
+    std::fill (state, state + numStates, Lanes (0));
+}
+
+template <typename SampleType>
+void MultichannelFilter<SampleType>::snapToZero() noexcept
+{
+    auto* values = reinterpret_cast<SampleType*> (state);
+
+    for (size_t i = 0; i < getNumStates() * numLanes; ++i)
+        util::snapToZero (values[i]);
+}
+
+template <typename SampleType>
+size_t MultichannelFilter<SampleType>::getNumStates() const noexcept
+{
+    return stateSizePerGroup * ((numChannels + numLanes - 1) / numLanes);
+}
+
+template <typename SampleType>
+void MultichannelFilter<SampleType>::check()
+{
+    auto changed = (size_t) sections.size() != sectionOrders.size();
+
+    for (int i = 0; i < sections.size() && ! changed; ++i)
+        changed = sections.getUnchecked (i)->getFilterOrder() != sectionOrders[(size_t) i];
+
+    if (changed)
+        reset();
+}
+
+//==============================================================================
+template <typename SampleType>
+void MultichannelFilter<SampleType>::processBlock (const AudioBlock<const SampleType>& input,
+                                                   const AudioBlock<SampleType>& output) noexcept
+{
+    // You must call prepare() before processing, with at least as many channels as the block
+    jassert (scratch != nullptr);
+    jassert (input.getNumChannels() <= numChannels);
+
+    check();
+
+    const auto numChannelsToProcess = jmin (numChannels, input.getNumChannels());
+    const auto numSamples = input.getNumSamples();
+    auto* interleaved = reinterpret_cast<SampleType*> (scratch);
+
+    for (size_t firstChannel = 0; firstChannel < numChannelsToProcess; firstChannel += numLanes * maxGroupsPerPass)
+    {
+        const auto numChannelsInPass = jmin (numLanes * maxGroupsPerPass, numChannelsToProcess - firstChannel);
+        const auto numGroups = (numChannelsInPass + numLanes - 1) / numLanes;
+        const auto width = numGroups * numLanes;
+        auto* groupState = state + (firstChannel / numLanes) * stateSizePerGroup;
+
+        for (size_t start = 0; start < numSamples; start += chunkSize)
+        {
+            const auto num = jmin (chunkSize, numSamples - start);
+
+            for (size_t channel = 0; channel < width; ++channel)
+            {
+                if (channel < numChannelsInPass)
+                {
+                    const auto* src = input.getChannelPointer (firstChannel + channel) + start;
+
+                    for (size_t i = 0; i < num; ++i)
+                        interleaved[i * width + channel] = src[i];
+                }
+                else
+                {
+                    for (size_t i = 0; i < num; ++i)
+                        interleaved[i * width + channel] = 0;
+                }
+            }
+
+            auto* sectionState = groupState;
+
+            for (int i = 0; i < sections.size(); ++i)
+            {
+                const auto* coefficients = sections.getUnchecked (i)->getRawCoefficients();
+                const auto order = sectionOrders[(size_t) i];
+
+                if (numGroups == 2)
+                    processSection<2> (coefficients, order, sectionState, stateSizePerGroup, scratch, num);
+                else
+                    processSection<1> (coefficients, order, sectionState, stateSizePerGroup, scratch, num);
+
+                sectionState += order;
+            }
+
+            for (size_t channel = 0; channel < numChannelsInPass; ++channel)
+            {
+                auto* dst = output.getChannelPointer (firstChannel + channel) + start;
+
+                for (size_t i = 0; i < num; ++i)
+                    dst[i] = interleaved[i * width + channel];
+            }
+        }
+    }
+}
+
+template <typename SampleType>
+template <size_t numGroups>
+void MultichannelFilter<SampleType>::processSection (const SampleType* c, size_t order,
+                                                     Lanes* s, size_t stateStride,
+                                                     Lanes* samples, size_t numSamples) noexcept
+{
+    // The samples of each group are interleaved, so that the filters of different groups
+    // can run in parallel while each one waits for its previous output.
+    switch (order)
+    {
+        case 0:
+        {
+            const Lanes b0 (c[0]);
+
+            for (size_t i = 0; i < numSamples * numGroups; ++i)
+                samples[i] = samples[i] * b0;
+        }
+        break;
+
+        case 1:
+        {
+            const Lanes b0 (c[0]), b1 (c[1]), a1 (c[2]);
+            Lanes lv1[numGroups];
+
+            for (size_t g = 0; g < numGroups; ++g)
+                lv1[g] = s[g * stateStride];
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                for (size_t g = 0; g < numGroups; ++g)
+                {
+                    const auto input = samples[i * numGroups + g];
+                    const auto output = (input * b0) + lv1[g];
+                    samples[i * numGroups + g] = output;
+
+                    lv1[g] = (input * b1) - (output * a1);
+                }
+            }
+
+            for (size_t g = 0; g < numGroups; ++g)
+                s[g * stateStride] = lv1[g];
+        }
+        break;
+
+        case 2:
+        {
+            const Lanes b0 (c[0]), b1 (c[1]), b2 (c[2]), a1 (c[3]), a2 (c[4]);
+            Lanes lv1[numGroups], lv2[numGroups];
+
+            for (size_t g = 0; g < numGroups; ++g)
+            {
+                lv1[g] = s[g * stateStride];
+                lv2[g] = s[g * stateStride + 1];
+            }
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                for (size_t g = 0; g < numGroups; ++g)
+                {
+                    const auto input = samples[i * numGroups + g];
+                    const auto output = (input * b0) + lv1[g];
+                    samples[i * numGroups + g] = output;
+
+                    lv1[g] = (input * b1) - (output * a1) + lv2[g];
+                    lv2[g] = (input * b2) - (output * a2);
+                }
+            }
+
+            for (size_t g = 0; g < numGroups; ++g)
+            {
+                s[g * stateStride]     = lv1[g];
+                s[g * stateStride + 1] = lv2[g];
+            }
+        }
+        break;
+
+        default:
+        {
+            for (size_t g = 0; g < numGroups; ++g)
+            {
+                auto* gs = s + g * stateStride;
+
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    const auto input = samples[i * numGroups + g];
+                    const auto output = (input * Lanes (c[0])) + gs[0];
+                    samples[i * numGroups + g] = output;
+
+                    for (size_t j = 0; j < order - 1; ++j)
+                        gs[j] = (input * Lanes (c[j + 1])) - (output * Lanes (c[order + j + 1])) + gs[j + 1];
+
+                    gs[order - 1] = (input * Lanes (c[order])) - (output * Lanes (c[order * 2]));
+                }
+            }
+        }
+        break;
+    }
+}
+
+//==============================================================================
+template class MultichannelFilter<float>;
+template class MultichannelFilter<double>;
+
+} // namespace juce::dsp::IIR
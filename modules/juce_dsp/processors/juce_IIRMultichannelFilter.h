@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp::IIR
+{
+
+/**
+    Applies a cascade of IIR filter sections to any number of channels, processing
+    several channels at once with SIMD instructions.
+
+    The state of each channel is held in one lane of a SIMDRegister, and channels are
+    filtered in groups that fill a register, so a build using SSE or NEON processes four
+    float channels in lockstep, and an AVX2 build processes eight. All the channels share
+    the same coefficients, so this can replace a ProcessorDuplicator of Filter objects
+    (or of a chain of them) when every channel needs the same filter.
+
+    The sections are applied one after another, using the same Transposed Direct Form II
+    structure as Filter. The arrays of second order sections returned by the high order
+    designs in FilterDesign can be used directly:
+
+    @code
+    IIR::MultichannelFilter<float> filter (FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod (1000.0f, 48000.0, 8));
+    filter.prepare (spec);
+    filter.process (ProcessContextReplacing<float> (block));
+    @endcode
+
+    @see Filter, ProcessorDuplicator, FilterDesign
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class MultichannelFilter
+{
+public:
+    static_assert (std::is_floating_point_v<SampleType>,
+                   "MultichannelFilter only supports float and double samples");
+
+    /** A typedef for a ref-counted pointer to the coefficients object */
+    using CoefficientsPtr = typename Coefficients<SampleType>::Ptr;
+
+    //==============================================================================
+    /** Creates a filter without any sections, which will pass its input through unchanged. */
+    MultichannelFilter() = default;
+
+    /** Creates a filter with a single section. */
+    explicit MultichannelFilter (CoefficientsPtr coefficientsToUse);
+
+    /** Creates a filter from a cascade of sections. */
+    explicit MultichannelFilter (const ReferenceCountedArray<Coefficients<SampleType>>& sectionsToUse);
+
+    //==============================================================================
+    /** The sections of the filter, which are applied in order.
+
+        It's up to the caller to ensure that these are modified in a thread-safe way.
+        If you change the number of sections, or the order of any of them, you should call
+        reset() before processing again, otherwise process() will have to do it for you,
+        which will allocate.
+    */
+    ReferenceCountedArray<Coefficients<SampleType>> sections;
+
+    //==============================================================================
+    /** Called before processing starts, to allocate the state for the given number of channels. */
+    void prepare (const ProcessSpec&);
+
+    /** Resets the state of every channel, ready to start a new stream of data. */
+    void reset();
+
+    /** Processes a block of samples.
+        The block mustn't have more channels than the number passed to prepare().
+    */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        static_assert (std::is_same_v<typename ProcessContext::SampleType, SampleType>,
+                       "The sample-type of the filter must match the sample-type supplied to this process callback");
+
+        const auto& inputBlock = context.getInputBlock();
+        auto& outputBlock      = context.getOutputBlock();
+
+        jassert (inputBlock.getNumChannels() == outputBlock.getNumChannels());
+        jassert (inputBlock.getNumSamples()  == outputBlock.getNumSamples());
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom (inputBlock);
+
+            return;
+        }
+
+        processBlock (inputBlock, outputBlock);
+
+       #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+        snapToZero();
+       #endif
+    }
+
+    /** Ensure that the state variables are rounded to zero if the state
+        variables are denormals.
+    */
+    void snapToZero() noexcept;
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using Lanes = SIMDRegister<SampleType>;
+   #else
+    using Lanes = SampleType;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (Lanes) / sizeof (SampleType);
+
+    // Channels are copied into a scratch buffer in chunks of this many samples, which
+    // keeps the buffer small enough to stay in the cache between sections.
+    static constexpr size_t chunkSize = 256;
+
+    // Two groups of channels are filtered together when possible, to hide the latency
+    // of the feedback path.
+    static constexpr size_t maxGroupsPerPass = 2;
+
+    void processBlock (const AudioBlock<const SampleType>&, const AudioBlock<SampleType>&) noexcept;
+    void check();
+    size_t getNumStates() const noexcept;
+
+    template <size_t numGroups>
+    static void processSection (const SampleType* coefficients, size_t order,
+                                Lanes* sectionState, size_t stateStride,
+                                Lanes* samples, size_t numSamples) noexcept;
+
+    //==============================================================================
+    HeapBlock<char> stateMemory, scratchMemory;
+    Lanes* state = nullptr;
+    Lanes* scratch = nullptr;
+    std::vector<size_t> sectionOrders;
+    size_t numChannels = 0, stateSizePerGroup = 0, numStatesAllocated = 0;
+};
+
+} // namespace juce::dsp::IIR
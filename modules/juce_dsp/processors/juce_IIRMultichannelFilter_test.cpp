@@ -0,0 +1,171 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp::IIR
+{
+
+class MultichannelFilterTest final : public UnitTest
+{
+public:
+    MultichannelFilterTest()
+        : UnitTest ("IIR Multichannel Filter", UnitTestCategories::dsp)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Matches a chain of mono filters on every channel");
+        {
+            runMatchesMonoFiltersTest<float>();
+            runMatchesMonoFiltersTest<double>();
+        }
+
+        beginTest ("Processes non-replacing contexts, and copies the input when bypassed");
+        {
+            auto random = getRandom();
+            const auto sections = FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod (200.0f, 44100.0, 4);
+
+            MultichannelFilter<float> filter (sections);
+            filter.prepare ({ 44100.0, 512, 6 });
+
+            AudioBuffer<float> input (6, 512), output (6, 512), expected (6, 512);
+            fillRandom (random, input);
+            expected.makeCopyOf (input);
+
+            AudioBlock<const float> inputBlock (input);
+            AudioBlock<float> outputBlock (output), expectedBlock (expected);
+
+            ProcessContextNonReplacing<float> bypassedContext (inputBlock, outputBlock);
+            bypassedContext.isBypassed = true;
+            filter.process (bypassedContext);
+            expect (buffersAreSimilar (output, input, 0.0));
+
+            MultichannelFilter<float> reference (sections);
+            reference.prepare ({ 44100.0, 512, 6 });
+            reference.process (ProcessContextReplacing<float> (expectedBlock));
+
+            filter.process (ProcessContextNonReplacing<float> (inputBlock, outputBlock));
+            expect (buffersAreSimilar (output, expected, 0.0));
+        }
+
+        beginTest ("Changing the sections resets the state");
+        {
+            auto random = getRandom();
+            MultichannelFilter<float> filter (Coefficients<float>::makeLowPass (44100.0, 1000.0f));
+            filter.prepare ({ 44100.0, 256, 3 });
+
+            AudioBuffer<float> buffer (3, 256);
+            fillRandom (random, buffer);
+            AudioBlock<float> block (buffer);
+            filter.process (ProcessContextReplacing<float> (block));
+
+            filter.sections.add (Coefficients<float>::makeFirstOrderHighPass (44100.0, 100.0f));
+            filter.process (ProcessContextReplacing<float> (block));
+
+            // After a reset, silence in should produce silence out
+            buffer.clear();
+            filter.reset();
+            filter.process (ProcessContextReplacing<float> (block));
+            expectEquals (buffer.getMagnitude (0, 256), 0.0f);
+        }
+    }
+
+private:
+    template <typename SampleType>
+    void runMatchesMonoFiltersTest()
+    {
+        auto random = getRandom();
+        const auto tolerance = std::is_same_v<SampleType, float> ? 1.0e-5 : 1.0e-12;
+
+        // An odd order design includes a first order section
+        const auto sections = FilterDesign<SampleType>::designIIRLowpassHighOrderButterworthMethod ((SampleType) 2000, 48000.0, 7);
+
+        for (const auto numChannels : { 1, 3, 4, 5, 8, 9, 17 })
+        {
+            for (const auto blockSize : { 1, 64, 300, 1024 })
+            {
+                const ProcessSpec spec { 48000.0, (uint32) blockSize, (uint32) numChannels };
+
+                MultichannelFilter<SampleType> filter (sections);
+                filter.prepare (spec);
+
+                std::vector<ProcessorDuplicator<Filter<SampleType>, Coefficients<SampleType>>> references;
+
+                for (auto* section : sections)
+                {
+                    references.emplace_back (section);
+                    references.back().prepare (spec);
+                }
+
+                AudioBuffer<SampleType> buffer (numChannels, blockSize), expected (numChannels, blockSize);
+
+                for (int block = 0; block < 4; ++block)
+                {
+                    fillRandom (random, buffer);
+                    expected.makeCopyOf (buffer);
+
+                    AudioBlock<SampleType> audioBlock (buffer), expectedBlock (expected);
+                    filter.process (ProcessContextReplacing<SampleType> (audioBlock));
+
+                    for (auto& reference : references)
+                        reference.process (ProcessContextReplacing<SampleType> (expectedBlock));
+
+                    expect (buffersAreSimilar (buffer, expected, tolerance));
+                }
+            }
+        }
+    }
+
+    template <typename SampleType>
+    static void fillRandom (Random& random, AudioBuffer<SampleType>& buffer)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample (ch, i, (SampleType) (2.0 * random.nextDouble() - 1.0));
+    }
+
+    template <typename SampleType>
+    static bool buffersAreSimilar (const AudioBuffer<SampleType>& a, const AudioBuffer<SampleType>& b, double tolerance)
+    {
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                if (std::abs ((double) a.getSample (ch, i) - (double) b.getSample (ch, i)) > tolerance)
+                    return false;
+
+        return true;
+    }
+};
+
+static MultichannelFilterTest multichannelFilterTest;
+
+} // namespace juce::dsp::IIR
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+SampleRateConverter::SampleRateConverter (double targetRate, Quality quality)
+    : resampler (quality), targetSampleRate (targetRate)
+{
+    jassert (targetSampleRate > 0);
+}
+
+void SampleRateConverter::setTargetSampleRate (double newTargetSampleRate)
+{
+    jassert (newTargetSampleRate > 0);
+
+    targetSampleRate = newTargetSampleRate;
+    resampler.setResamplingRatio (sampleRate / targetSampleRate);
+}
+
+void SampleRateConverter::setQuality (Quality newQuality)
+{
+    resampler.setQuality (newQuality);
+}
+
+void SampleRateConverter::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.sampleRate > 0 && spec.numChannels > 0);
+
+    sampleRate = spec.sampleRate;
+    maximumBlockSize = (int) spec.maximumBlockSize;
+
+    resampler.prepare ((int) spec.numChannels, maximumBlockSize, sampleRate / targetSampleRate);
+
+    // Large enough for the look-ahead of the longest filter that the resampler might use
+    silence.setSize ((int) spec.numChannels, 512);
+    silence.clear();
+
+    inputPointers.resize (spec.numChannels);
+    outputPointers.resize (spec.numChannels);
+}
+
+void SampleRateConverter::reset()
+{
+    resampler.reset();
+}
+
+int SampleRateConverter::getMaximumNumOutputSamples() const noexcept
+{
+    auto maxInput = jmax (maximumBlockSize, resampler.getLatencyInInputSamples());
+    return (int) std::ceil (maxInput / resampler.getResamplingRatio()) + 1;
+}
+
+//==============================================================================
+int SampleRateConverter::process (const AudioBlock<const float>& input, AudioBlock<float>& output) noexcept
+{
+    jassert (input.getNumChannels() == inputPointers.size());
+    jassert ((int) input.getNumSamples() <= maximumBlockSize);
+
+    for (size_t i = 0; i < inputPointers.size(); ++i)
+        inputPointers[i] = input.getChannelPointer (i);
+
+    return processPointers ((int) input.getNumSamples(), output);
+}
+
+int SampleRateConverter::flush (AudioBlock<float>& output) noexcept
+{
+    for (size_t i = 0; i < inputPointers.size(); ++i)
+        inputPointers[i] = silence.getReadPointer ((int) i);
+
+    return processPointers (jmin (silence.getNumSamples(), resampler.getLatencyInInputSamples()), output);
+}
+
+int SampleRateConverter::processPointers (int numInputSamples, AudioBlock<float>& output) noexcept
+{
+    jassert (output.getNumChannels() == outputPointers.size());
+
+    for (size_t i = 0; i < outputPointers.size(); ++i)
+        outputPointers[i] = output.getChannelPointer (i);
+
+    // The resampler was prepared for blocks of this size, so it won't need to allocate here
+    return resampler.process (inputPointers.data(), numInputSamples,
+                              outputPointers.data(), (int) output.getNumSamples());
+}
+
+} // namespace juce::dsp
@@ -0,0 +1,129 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE framework.
+   Copyright (c) Raw Material Software Limited
+
+   JUCE is an open source framework subject to commercial or open source
+   licensing.
+
+   By downloading, installing, or using the JUCE framework, or combining the
+   JUCE framework with any other source code, object code, content or any other
+   copyrightable work, you agree to the terms of the JUCE End User Licence
+   Agreement, and all incorporated terms including the JUCE Privacy Policy and
+   the JUCE Website Terms of Service, as applicable, which will bind you. If you
+   do not agree to the terms of these agreements, we will not license the JUCE
+   framework to you, and you must discontinue the installation or download
+   process and cease use of the JUCE framework.
+
+   JUCE End User Licence Agreement: https://juce.com/legal/juce-8-licence/
+   JUCE Privacy Policy: https://juce.com/juce-privacy-policy
+   JUCE Website Terms of Service: https://juce.com/juce-website-terms-of-service/
+
+   Or:
+
+   You may also use this code under the terms of the AGPLv3:
+   https://www.gnu.org/licenses/agpl-3.0.en.html
+
+   THE JUCE FRAMEWORK IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL
+   WARRANTIES, WHETHER EXPRESSED OR IMPLIED, INCLUDING WARRANTY OF
+   MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE, ARE DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce::dsp
+{
+
+/**
+    Converts blocks of audio from one sample rate to another, using a
+    PolyphaseResampler.
+
+    Because the output runs at a different rate to the input, this doesn't take a
+    ProcessContext like most processors - each call to process() consumes a whole
+    input block, and writes however many output samples that block produced.
+
+    The output is time-aligned with the input, so the first few calls won't produce
+    as many samples as you might expect while the resampler's look-ahead fills up.
+    When converting a finite signal, call flush() at the end to retrieve the tail.
+
+    @see PolyphaseResampler, Oversampling
+
+    @tags{DSP}
+*/
+class JUCE_API  SampleRateConverter
+{
+public:
+    //==============================================================================
+    using Quality = PolyphaseResampler::Quality;
+
+    /** Creates a converter that will produce audio at the given rate. */
+    explicit SampleRateConverter (double targetSampleRate = 48000.0, Quality quality = Quality::normal);
+
+    //==============================================================================
+    /** Changes the sample rate of the output.
+
+        If the converter has been prepared and the new rate down-samples by a different
+        ratio, this designs a new anti-aliasing filter, which allocates and takes a while,
+        so it shouldn't be called on the audio thread. Changing between rates that are at
+        or above the input rate is cheap. See PolyphaseResampler::setResamplingRatio().
+    */
+    void setTargetSampleRate (double newTargetSampleRate);
+
+    /** Returns the sample rate of the output. */
+    double getTargetSampleRate() const noexcept             { return targetSampleRate; }
+
+    /** Changes the quality preset. This allocates, and resets the converter. */
+    void setQuality (Quality newQuality);
+
+    /** Returns the quality preset. */
+    Quality getQuality() const noexcept                     { return resampler.getQuality(); }
+
+    //==============================================================================
+    /** Initialises the converter. The spec's sample rate is the rate of the input. */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the converter's history. */
+    void reset();
+
+    /** Returns the number of input samples of look-ahead that the converter needs. */
+    int getLatencyInSamples() const noexcept                { return resampler.getLatencyInInputSamples(); }
+
+    /** Returns the largest number of samples that process() can produce from an input
+        block of the maximum size that was passed to prepare().
+    */
+    int getMaximumNumOutputSamples() const noexcept;
+
+    //==============================================================================
+    /** Converts a block of audio.
+
+        The input must have the number of channels that was passed to prepare(), and no
+        more samples than the maximum block size. The output block must have at least
+        getMaximumNumOutputSamples() samples.
+
+        @returns the number of samples that were written to the output block
+    */
+    int process (const AudioBlock<const float>& input, AudioBlock<float>& output) noexcept;
+
+    /** Feeds the converter with silence to retrieve the samples that are still waiting
+        for look-ahead at the end of a signal.
+
+        @returns the number of samples that were written to the output block
+    */
+    int flush (AudioBlock<float>& output) noexcept;
+
+private:
+    //==============================================================================
+    PolyphaseResampler resampler;
+    double targetSampleRate, sampleRate = 44100.0;
+    int maximumBlockSize = 0;
+    AudioBuffer<float> silence;
+    std::vector<const float*> inputPointers;
+    std::vector<float*> outputPointers;
+
+    int processPointers (int numInputSamples, AudioBlock<float>& output) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleRateConverter)
+};
+
+} // namespace juce::dsp